@@ -0,0 +1,72 @@
+/*!
+ * \file
+ *
+ * A tiny benchmarking harness for the morphologica microbenchmarks. No dependency on
+ * google-benchmark or anything else - just steady_clock, iteration-count calibration and
+ * optimizer barriers. Each benchmark program prints one "name ... ns/op" line per kernel,
+ * so runs are easy to diff between morphologica versions.
+ *
+ * \author Seb James
+ * \date August 2026
+ */
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <iostream>
+#include <iomanip>
+#include <cstdint>
+#include <algorithm>
+
+namespace morph {
+    namespace bench {
+
+        //! An optimizer barrier: make the compiler believe \a value is used, so the
+        //! computation that produced it cannot be elided
+        template<typename T>
+        inline void do_not_optimize (const T& value)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            asm volatile ("" : : "r,m"(value) : "memory");
+#else
+            volatile const T* sink = &value;
+            static_cast<void>(sink);
+#endif
+        }
+
+        /*!
+         * Time one call of \a fn, calibrating the iteration count so that the measured
+         * loop runs for about \a target_s seconds. Prints an aligned "name ns/op
+         * (iters)" line and returns the ns/op figure (so a caller can also apply its own
+         * thresholds). fn should do one unit of the work being measured and use
+         * do_not_optimize on its result.
+         */
+        template<typename F>
+        inline double run (const std::string& name, F&& fn, const double target_s = 0.2)
+        {
+            using sc = std::chrono::steady_clock;
+            std::uint64_t iters = 1;
+            double elapsed = 0.0;
+            for (;;) {
+                sc::time_point t0 = sc::now();
+                for (std::uint64_t i = 0; i < iters; ++i) { fn(); }
+                elapsed = std::chrono::duration<double>(sc::now() - t0).count();
+                if (elapsed >= target_s || iters >= (std::uint64_t{1} << 40)) { break; }
+                // Grow towards the target, but at most 16x at a time so a mis-measured
+                // first pass can't produce a pathological iteration count
+                std::uint64_t next = iters * 16u;
+                if (elapsed > 0.0) {
+                    double scaled = static_cast<double>(iters) * (1.25 * target_s / elapsed);
+                    next = std::min (next, static_cast<std::uint64_t>(scaled) + 1u);
+                }
+                iters = std::max (iters + 1u, next);
+            }
+            double ns_per_op = 1e9 * elapsed / static_cast<double>(iters);
+            std::cout << std::left << std::setw(44) << name
+                      << std::right << std::setw(12) << std::fixed << std::setprecision(2) << ns_per_op
+                      << " ns/op  (" << iters << " iters)\n";
+            return ns_per_op;
+        }
+
+    } // namespace bench
+} // namespace morph
@@ -0,0 +1,131 @@
+/*
+ * Grid-construction and boundary benchmark. tests/profileGrid.cpp times one scenario ad
+ * hoc; this program covers the startup costs systematically - HexGrid, CartGrid and Grid
+ * construction across sizes, HexGrid::setBoundary with the SVG boundaries of varying
+ * complexity in tests/ (via ReadCurves), and save_snapshot/load_snapshot round trips -
+ * and emits one CSV row per measurement on stdout, for diffing between versions.
+ *
+ * Usage: benchGrid [path-to-tests-dir]   (default ../../tests, as for the ctests)
+ */
+#include <morph/HexGrid.h>
+#include <morph/CartGrid.h>
+#include <morph/Grid.h>
+#include <morph/ReadCurves.h>
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <string>
+
+// Run fn() reps times and return the fastest wall-clock duration in ms
+static double time_best_ms (const std::function<void()>& fn, const unsigned int reps = 3)
+{
+    using sc = std::chrono::steady_clock;
+    double best = 0.0;
+    for (unsigned int r = 0; r < reps; ++r) {
+        sc::time_point t0 = sc::now();
+        fn();
+        double ms = std::chrono::duration<double, std::milli>(sc::now() - t0).count();
+        if (r == 0 || ms < best) { best = ms; }
+    }
+    return best;
+}
+
+static void row (const std::string& task, const std::string& detail, const std::size_t n, const double ms)
+{
+    std::cout << task << "," << detail << "," << n << "," << ms << "\n";
+}
+
+int main (int argc, char** argv)
+{
+    std::string testsdir = argc > 1 ? argv[1] : "../../tests";
+
+    std::cout << "task,detail,n,ms\n";
+
+    // HexGrid construction and parametric boundaries across hex spacings. Smaller d
+    // means more hexes over the same 3x3 span.
+    for (float d : { 0.02f, 0.01f, 0.005f }) {
+        std::string dd = "d=" + std::to_string (d);
+        std::size_t nhex = 0;
+        double ms = time_best_ms ([d, &nhex] {
+            morph::HexGrid hg (d, 3.0f, 0.0f);
+            nhex = hg.num();
+        });
+        row ("hexgrid_construct", dd, nhex, ms);
+
+        ms = time_best_ms ([d, &nhex] {
+            morph::HexGrid hg (d, 3.0f, 0.0f);
+            hg.setCircularBoundary (1.0f);
+            nhex = hg.num();
+        });
+        row ("hexgrid_circular_boundary", dd, nhex, ms);
+
+        ms = time_best_ms ([d, &nhex] {
+            morph::HexGrid hg (d, 3.0f, 0.0f);
+            hg.setEllipticalBoundary (1.2f, 0.8f);
+            nhex = hg.num();
+        });
+        row ("hexgrid_elliptical_boundary", dd, nhex, ms);
+    }
+
+    // SVG boundaries of increasing path complexity, applied at a fixed hex spacing.
+    // ReadCurves parses the file; setBoundary walks the Bezier path around the grid.
+    for (const std::string& svg : { std::string("ellipse.svg"), std::string("trial.svg"),
+                                    std::string("whiskerbarrels_withcentres.svg") }) {
+        std::string svgpath = testsdir + "/" + svg;
+        try {
+            double ms_read = time_best_ms ([&svgpath] {
+                morph::ReadCurves r (svgpath);
+            });
+            morph::ReadCurves r (svgpath);
+            std::size_t nhex = 0;
+            double ms_bound = time_best_ms ([&r, &nhex] {
+                morph::HexGrid hg (0.01f, 3.0f, 0.0f);
+                hg.setBoundary (r.getCorticalPath());
+                nhex = hg.num();
+            });
+            row ("svg_readcurves", svg, 0, ms_read);
+            row ("hexgrid_svg_boundary", svg, nhex, ms_bound);
+        } catch (const std::exception& e) {
+            std::cerr << "Skipping " << svgpath << ": " << e.what() << std::endl;
+        }
+    }
+
+    // Snapshot save/load round trip for a boundary-carrying HexGrid
+    {
+        morph::HexGrid hg (0.005f, 3.0f, 0.0f);
+        hg.setCircularBoundary (1.0f);
+        const std::string snappath = "./benchGrid_snapshot.bin";
+        double ms = time_best_ms ([&hg, &snappath] { hg.save_snapshot (snappath); });
+        row ("hexgrid_save_snapshot", "d=0.005", hg.num(), ms);
+        ms = time_best_ms ([&snappath] {
+            morph::HexGrid hg2 (0.005f, 3.0f, 0.0f);
+            hg2.load_snapshot (snappath);
+        });
+        row ("hexgrid_load_snapshot", "d=0.005", hg.num(), ms);
+        std::remove (snappath.c_str());
+    }
+
+    // Rectangular grids. CartGrid builds a list<Rect> plus d_ vectors; Grid computes
+    // everything into vvecs up front.
+    constexpr morph::vec<float, 2> spacing = { 1.0f, 1.0f };
+    constexpr morph::vec<float, 2> zero = { 0.0f, 0.0f };
+    for (unsigned int nside : { 256u, 1024u, 2048u }) {
+        std::string dd = "Nside=" + std::to_string (nside);
+        double ms = time_best_ms ([nside, &spacing, &zero] {
+            morph::Grid<unsigned int, float> g (nside, nside, spacing, zero);
+        });
+        row ("grid_construct", dd, static_cast<std::size_t>(nside) * nside, ms);
+
+        ms = time_best_ms ([nside, &spacing, &zero] {
+            morph::CartGrid cg (spacing[0], spacing[1], zero[0], zero[1],
+                                (nside - 1) * spacing[0], (nside - 1) * spacing[1], 0.0f,
+                                morph::GridDomainShape::Rectangle, morph::GridDomainWrap::None);
+            cg.setBoundaryOnOuterEdge();
+        });
+        row ("cartgrid_construct", dd, static_cast<std::size_t>(nside) * nside, ms);
+    }
+
+    return 0;
+}
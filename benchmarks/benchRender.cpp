@@ -0,0 +1,142 @@
+/*
+ * Rendering benchmark: build parameterized synthetic scenes (an N-hex HexGridVisual, an
+ * M-point ScatterVisual and K GraphVisuals with labelled axes), render them headlessly
+ * (EGL, no display server needed) for a fixed number of frames and report per-phase
+ * timings - vertex generation, upload/first-frame and steady-state draw - as one JSON
+ * object per run on stdout. Diff the numbers between morphologica versions.
+ *
+ * Usage: benchRender [-hex N] [-scatter M] [-graphs K] [-frames F] [-w W] [-h H]
+ */
+#include <morph/VisualHeadless.h>
+#include <morph/HexGrid.h>
+#include <morph/HexGridVisual.h>
+#include <morph/ScatterVisual.h>
+#include <morph/GraphVisual.h>
+#include <morph/vvec.h>
+#include <morph/vec.h>
+#include <morph/mathconst.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+#include <memory>
+
+int main (int argc, char** argv)
+{
+    using sc = std::chrono::steady_clock;
+
+    // Scene parameters, overridable from the command line
+    unsigned int n_hex_target = 100000u;
+    unsigned int n_scatter = 50000u;
+    unsigned int n_graphs = 8u;
+    unsigned int n_frames = 200u;
+    int width = 1024;
+    int height = 768;
+    for (int a = 1; a + 1 < argc; a += 2) {
+        std::string k (argv[a]);
+        int val = std::atoi (argv[a + 1]);
+        if (k == "-hex") { n_hex_target = val; }
+        else if (k == "-scatter") { n_scatter = val; }
+        else if (k == "-graphs") { n_graphs = val; }
+        else if (k == "-frames") { n_frames = val; }
+        else if (k == "-w") { width = val; }
+        else if (k == "-h") { height = val; }
+    }
+
+    morph::VisualHeadless<> v (width, height, "benchRender", false);
+    v.profile_frames = true;
+
+    // A HexGrid of approximately n_hex_target hexes. A hex of spacing d occupies
+    // (sqrt(3)/2) d^2, so a disc of radius d * sqrt (n * sqrt(3) / (2 pi)) holds ~n hexes.
+    constexpr float d = 0.01f;
+    float radius = d * std::sqrt (n_hex_target * morph::mathconst<float>::sqrt_of_3
+                                  / (2.0f * morph::mathconst<float>::pi));
+    morph::HexGrid hg (d, 4.0f * radius, 0.0f);
+    hg.setCircularBoundary (radius);
+    morph::vvec<float> hexdata (hg.num());
+    for (unsigned int i = 0; i < hg.num(); ++i) {
+        hexdata[i] = std::sin (20.0f * hg.d_x[i]) * std::cos (20.0f * hg.d_y[i]);
+    }
+    auto hgv = std::make_unique<morph::HexGridVisual<float>> (&hg, morph::vec<float, 3>{ 0, 0, 0 });
+    v.bindmodel (hgv);
+    hgv->setScalarData (&hexdata);
+    hgv->name = "hexgrid";
+    hgv->finalize(); // vertex generation, timed into vertex_init_ms
+    auto hgvp = v.addVisualModel (hgv);
+
+    // An M-point scatter on a spiral
+    morph::vvec<morph::vec<float, 3>> coords (n_scatter);
+    morph::vvec<float> sdata (n_scatter);
+    for (unsigned int i = 0; i < n_scatter; ++i) {
+        float t = static_cast<float>(i) / n_scatter;
+        float ang = 60.0f * morph::mathconst<float>::pi * t;
+        coords[i] = { t * std::cos (ang), t * std::sin (ang), 0.2f + 0.5f * t };
+        sdata[i] = t;
+    }
+    auto sv = std::make_unique<morph::ScatterVisual<float>> (morph::vec<float, 3>{ 0, 0, 0.5f });
+    v.bindmodel (sv);
+    sv->setDataCoords (&coords);
+    sv->setScalarData (&sdata);
+    sv->radiusFixed = 0.004f;
+    sv->name = "scatter";
+    sv->finalize();
+    auto svp = v.addVisualModel (sv);
+
+    // K graphs with labelled axes (which exercises the text pipeline)
+    morph::vvec<float> gx;
+    gx.linspace (-1.0f, 1.0f, 256);
+    std::vector<morph::GraphVisual<float>*> gvps;
+    for (unsigned int g = 0; g < n_graphs; ++g) {
+        auto gv = std::make_unique<morph::GraphVisual<float>> (morph::vec<float, 3>{ 1.5f + 1.2f * (g % 4), 1.2f * (g / 4), 0.0f });
+        v.bindmodel (gv);
+        gv->xlabel = "x (graph " + std::to_string (g) + ")";
+        gv->ylabel = "f(x)";
+        gv->setdata (gx, (gx * (1.0f + g)).sin(), "sin " + std::to_string (g));
+        gv->name = "graph" + std::to_string (g);
+        gv->finalize();
+        gvps.push_back (v.addVisualModel (gv));
+    }
+
+    // First render does the vertex buffer uploads (postVertexInit) as well as the draw
+    sc::time_point t0 = sc::now();
+    v.render();
+    double first_frame_ms = std::chrono::duration<double, std::milli>(sc::now() - t0).count();
+
+    // Steady-state frames
+    double frame_ms_sum = 0.0;
+    t0 = sc::now();
+    for (unsigned int f = 0; f < n_frames; ++f) {
+        v.render();
+        frame_ms_sum += v.profiling.frame_cpu_ms;
+    }
+    double wall_ms = std::chrono::duration<double, std::milli>(sc::now() - t0).count();
+
+    // Report as a single JSON object. The per-model gpu_ms figures come from
+    // GL_TIME_ELAPSED queries (one frame stale, which matters not at all here).
+    std::stringstream ss;
+    ss << "{\"benchmark\":\"render\",\"width\":" << width << ",\"height\":" << height
+       << ",\"hexes\":" << hg.num() << ",\"scatter\":" << n_scatter << ",\"graphs\":" << n_graphs
+       << ",\"frames\":" << n_frames
+       << ",\"first_frame_ms\":" << first_frame_ms
+       << ",\"frame_cpu_ms_mean\":" << (frame_ms_sum / n_frames)
+       << ",\"wall_ms\":" << wall_ms
+       << ",\"fps\":" << (1000.0 * n_frames / wall_ms)
+       << ",\"models\":[";
+    for (std::size_t i = 0; i < v.profiling.models.size(); ++i) {
+        const auto& m = v.profiling.models[i];
+        ss << (i ? "," : "") << "{\"name\":\"" << m.name << "\",\"vertex_init_ms\":" << m.vertex_init_ms
+           << ",\"cpu_ms\":" << m.cpu_ms << ",\"gpu_ms\":" << m.gpu_ms << "}";
+    }
+    ss << "]}";
+    std::cout << ss.str() << std::endl;
+
+    // Keep the model pointers alive to this point (they're owned by v; these are observers)
+    static_cast<void>(hgvp);
+    static_cast<void>(svp);
+    static_cast<void>(gvps);
+
+    return 0;
+}
@@ -0,0 +1,79 @@
+/*
+ * Microbenchmarks for the fixed-size math layer: vec dot and cross products, mat44
+ * multiplication, quaternion rotation (single and batch) and scale::transform.
+ */
+#include "bench.h"
+#include <morph/vec.h>
+#include <morph/vvec.h>
+#include <morph/mat44.h>
+#include <morph/quaternion.h>
+#include <morph/scale.h>
+#include <morph/mathconst.h>
+#include <string>
+#include <vector>
+
+int main()
+{
+    // An array of vectors to stream through the vec kernels, so we measure throughput
+    // rather than a single register-resident operation
+    constexpr unsigned int nv = 4096u;
+    std::vector<morph::vec<float, 3>> vs (nv);
+    for (unsigned int i = 0; i < nv; ++i) {
+        vs[i] = { 0.1f + i * 0.001f, 0.2f + i * 0.002f, 0.3f - i * 0.001f };
+    }
+    std::vector<morph::vec<float, 3>> out (nv);
+
+    morph::bench::run ("vec<float,3> dot x" + std::to_string (nv), [&vs] {
+        float acc = 0.0f;
+        for (unsigned int i = 1; i < nv; ++i) { acc += vs[i - 1].dot (vs[i]); }
+        morph::bench::do_not_optimize (acc);
+    });
+    morph::bench::run ("vec<float,3> cross x" + std::to_string (nv), [&vs, &out] {
+        for (unsigned int i = 1; i < nv; ++i) { out[i] = vs[i - 1].cross (vs[i]); }
+        morph::bench::do_not_optimize (out[nv - 1]);
+    });
+
+    // mat44
+    morph::mat44<float> m1;
+    m1.rotate (morph::vec<float, 3>{ 0, 0, 1 }, morph::mathconst<float>::pi_over_4);
+    m1.translate (morph::vec<float, 3>{ 1, 2, 3 });
+    morph::mat44<float> m2;
+    m2.rotate (morph::vec<float, 3>{ 0, 1, 0 }, morph::mathconst<float>::pi_over_3);
+    morph::vec<float, 4> v4 = { 1.0f, 2.0f, 3.0f, 1.0f };
+
+    morph::bench::run ("mat44<float> * mat44<float>", [&m1, &m2] {
+        morph::mat44<float> m3 = m1 * m2;
+        morph::bench::do_not_optimize (m3.mat[0]);
+    });
+    morph::bench::run ("mat44<float> * vec<float,4>", [&m1, &v4] {
+        morph::vec<float, 4> r = m1 * v4;
+        morph::bench::do_not_optimize (r[0]);
+    });
+
+    // quaternion rotation
+    morph::quaternion<float> q (morph::vec<float, 3>{ 0, 0, 1 }, morph::mathconst<float>::pi_over_4);
+    morph::bench::run ("quaternion<float> * vec<float,3> x" + std::to_string (nv), [&q, &vs, &out] {
+        for (unsigned int i = 0; i < nv; ++i) { out[i] = q * vs[i]; }
+        morph::bench::do_not_optimize (out[nv - 1]);
+    });
+    morph::bench::run ("quaternion<float> rotate_batch x" + std::to_string (nv), [&q, &vs, &out] {
+        q.rotate_batch (vs.data(), out.data(), nv);
+        morph::bench::do_not_optimize (out[nv - 1]);
+    });
+
+    // scale::transform across sizes
+    for (unsigned int n : { 1024u, 16384u, 262144u }) {
+        morph::vvec<float> data (n);
+        data.linspace (-5.0f, 12.0f);
+        morph::vvec<float> scaled (n);
+        morph::scale<float> sc;
+        sc.do_autoscale = true;
+        sc.transform (data, scaled); // first call computes the autoscale params
+        morph::bench::run ("scale<float>::transform/" + std::to_string (n), [&sc, &data, &scaled] {
+            sc.transform (data, scaled);
+            morph::bench::do_not_optimize (scaled[0]);
+        });
+    }
+
+    return 0;
+}
@@ -0,0 +1,60 @@
+/*
+ * Microbenchmarks for morph::vvec hot kernels: elementwise arithmetic, reductions and
+ * convolution, each across a spread of sizes.
+ */
+#include "bench.h"
+#include <morph/vvec.h>
+#include <string>
+
+int main()
+{
+    constexpr unsigned int sizes[] = { 64u, 1024u, 16384u, 262144u };
+    const morph::vvec<float> kernel = { 0.05f, 0.1f, 0.2f, 0.3f, 0.2f, 0.1f, 0.05f };
+
+    for (unsigned int n : sizes) {
+        morph::vvec<float> a (n);
+        morph::vvec<float> b (n);
+        a.linspace (0.0f, 1.0f);
+        b.linspace (1.0f, 2.0f);
+        std::string sz = "/" + std::to_string (n);
+
+        morph::bench::run ("vvec<float> a + b" + sz, [&a, &b] {
+            morph::vvec<float> c = a + b;
+            morph::bench::do_not_optimize (c[0]);
+        });
+        morph::bench::run ("vvec<float> a * b" + sz, [&a, &b] {
+            morph::vvec<float> c = a * b;
+            morph::bench::do_not_optimize (c[0]);
+        });
+        morph::bench::run ("vvec<float> a += b (in place)" + sz, [&a, &b] {
+            a += b;
+            morph::bench::do_not_optimize (a[0]);
+        });
+        morph::bench::run ("vvec<float> a * 1.0001f" + sz, [&a] {
+            morph::vvec<float> c = a * 1.0001f;
+            morph::bench::do_not_optimize (c[0]);
+        });
+        morph::bench::run ("vvec<float> sum()" + sz, [&a] {
+            float s = a.sum();
+            morph::bench::do_not_optimize (s);
+        });
+        morph::bench::run ("vvec<float> max()" + sz, [&a] {
+            float m = a.max();
+            morph::bench::do_not_optimize (m);
+        });
+        morph::bench::run ("vvec<float> mean()" + sz, [&a] {
+            float m = a.mean();
+            morph::bench::do_not_optimize (m);
+        });
+        morph::bench::run ("vvec<float> length()" + sz, [&a] {
+            float l = a.length();
+            morph::bench::do_not_optimize (l);
+        });
+        morph::bench::run ("vvec<float> convolve (7-tap)" + sz, [&a, &kernel] {
+            morph::vvec<float> c = a.convolve (kernel);
+            morph::bench::do_not_optimize (c[0]);
+        });
+    }
+
+    return 0;
+}
@@ -0,0 +1,75 @@
+/*
+ * GPU-resident heat equation stepping on a morph::Grid with morph::gl::grid_compute.
+ *
+ * The grid's state and neighbour table are uploaded to SSBOs once, then grid_heat.glsl
+ * is dispatched for many steps with no CPU readback between them. The state is only
+ * copied back (sync_for_display) when we want to inspect it - here, to print its range
+ * after each batch of steps. In a visualisation program you would hand the result of
+ * sync_for_display() to GridVisual::updateData instead.
+ */
+
+// You have to include the GL headers manually so that you will be sure you have the
+// right ones. See shadercompute.cpp for the details.
+#include <GL/gl.h>
+
+#include <iostream>
+#include <morph/Grid.h>
+#include <morph/vvec.h>
+#include <morph/gl/compute_manager.h>
+#include <morph/gl/grid_compute.h>
+
+namespace my {
+
+    // Specify OpenGL version 4.5 (4.3 is min for compute)
+    struct compute_manager : public morph::gl::compute_manager<morph::gl::version_4_5>
+    {
+        static constexpr unsigned int gridside = 256;
+        static constexpr unsigned int steps_per_batch = 1000;
+
+        compute_manager()
+        {
+            this->init();
+
+            // A hot square in the middle of the Grid as the initial condition
+            morph::vvec<float> initial_state (this->grid.n(), 0.0f);
+            for (unsigned int i = 0; i < this->grid.n(); ++i) {
+                if (this->grid.row (i) > gridside / 3 && this->grid.row (i) < 2 * gridside / 3
+                    && this->grid.col (i) > gridside / 3 && this->grid.col (i) < 2 * gridside / 3) {
+                    initial_state[i] = 1.0f;
+                }
+            }
+            this->heat.init (this->grid, initial_state);
+            this->heat.step_program.use();
+            this->heat.step_program.set_uniform<float> ("D_dt", 0.2f);
+        }
+
+        // The shader is loaded into the grid_compute's step_program
+        void load_shaders() final
+        {
+            std::vector<morph::gl::ShaderInfo> shaders = {
+                {GL_COMPUTE_SHADER, "../examples/gl_compute/grid_heat.glsl", morph::gl::nonCompilingComputeShader, 0 }
+            };
+            this->heat.step_program.load_shaders (shaders);
+        }
+
+        // Each compute() call runs a batch of steps entirely on the GPU, then syncs once
+        void compute() final
+        {
+            this->measure_compute();
+            this->heat.step (steps_per_batch);
+            morph::range<float> r = this->heat.sync_for_display().range();
+            std::cout << "After " << steps_per_batch << " more steps, state range is " << r << std::endl;
+        }
+
+        //! A square Grid of gridside x gridside elements
+        morph::Grid<unsigned int, float> grid = morph::Grid<unsigned int, float> (gridside, gridside, {0.01f, 0.01f});
+        morph::gl::grid_compute<morph::gl::version_4_5, float> heat;
+    };
+} // namespace my
+
+int main()
+{
+    my::compute_manager c;
+    for (unsigned int batch = 0; batch < 10; ++batch) { c.compute(); }
+    return 0;
+}
@@ -0,0 +1,33 @@
+#version 450 core
+
+// One explicit-Euler step of the heat equation over a morph::Grid, driven by
+// morph::gl::grid_compute. The buffer bindings and local_size_x match the layout
+// documented in morph/gl/grid_compute.h.
+
+layout (local_size_x = 64) in;
+
+layout (std430, binding = 0) buffer StateIn  { float state_in[]; };
+layout (std430, binding = 1) buffer StateOut { float state_out[]; };
+layout (std430, binding = 2) readonly buffer Nbr { int nbr[]; };
+
+// Diffusion constant times dt, set from the C++ side with set_uniform
+uniform float D_dt;
+
+void main()
+{
+    uint i = gl_GlobalInvocationID.x;
+    if (i >= state_in.length()) { return; }
+
+    // Four-point Laplacian from the precomputed neighbour table (east, north,
+    // west, south; -1 where there is no neighbour)
+    float nbr_sum = 0.0;
+    float nbr_count = 0.0;
+    for (uint j = 0u; j < 4u; j++) {
+        int nb = nbr[4u * i + j];
+        if (nb >= 0) {
+            nbr_sum += state_in[nb];
+            nbr_count += 1.0;
+        }
+    }
+    state_out[i] = state_in[i] + D_dt * (nbr_sum - nbr_count * state_in[i]);
+}
@@ -0,0 +1,183 @@
+/*!
+ * \file
+ *
+ * Allocation-tracking instrumentation for morphologica's hot containers. Allocation
+ * storms (vvec temporaries in maths code, vertex vector growth during VisualModel
+ * builds) usually only show up under an external heap profiler; this header makes
+ * cheap per-subsystem allocation counts available at runtime instead.
+ *
+ * The counters and the counting_allocator are always available. Compile with
+ * -DMORPH_ALLOC_STATS to plug the counting allocator into morph::vvec element storage
+ * and into the CPU-side vertex position/normal/colour/index buffers of the
+ * VisualModels, after which morph::AllocationStats::get() and ::dump() report live
+ * figures. Without the define, vvec and the vertex buffers use std::allocator and
+ * there is zero overhead. A render loop investigating per-frame churn can call
+ *
+ *\code{.cpp}
+ * morph::AllocationStats::dump();  // one line per subsystem
+ * morph::AllocationStats::reset(); // start the next frame's counts from zero
+ *\endcode
+ *
+ * after each v.render().
+ *
+ * \author Seb James
+ * \date August 2026
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace morph {
+
+    //! The subsystems for which allocations are counted separately
+    enum class alloc_subsys : unsigned int
+    {
+        vvec_storage,   //!< morph::vvec element storage (MORPH_ALLOC_STATS builds)
+        vertex_buffers, //!< CPU-side VisualModel vertex/index buffers (MORPH_ALLOC_STATS builds)
+        client,         //!< for client code's own counting_allocator instantiations
+        n               //!< the number of subsystems; not itself a subsystem
+    };
+
+    //! Allocation counters for one subsystem. All members are atomics, so counts may
+    //! be recorded from any thread (e.g. threaded vertex init).
+    struct alloc_counters
+    {
+        std::atomic<std::uint64_t> n_allocs = 0u;      //!< number of allocate() calls
+        std::atomic<std::uint64_t> n_deallocs = 0u;    //!< number of deallocate() calls
+        std::atomic<std::uint64_t> bytes_total = 0u;   //!< sum of all bytes ever allocated
+        std::atomic<std::uint64_t> bytes_current = 0u; //!< bytes currently allocated
+        std::atomic<std::uint64_t> bytes_peak = 0u;    //!< high-water mark of bytes_current
+
+        void record_alloc (const std::size_t bytes)
+        {
+            this->n_allocs += 1u;
+            this->bytes_total += bytes;
+            std::uint64_t cur = (this->bytes_current += bytes);
+            // Raise the peak with a CAS loop, as another thread may be raising it too
+            std::uint64_t pk = this->bytes_peak.load();
+            while (cur > pk && !this->bytes_peak.compare_exchange_weak (pk, cur)) {}
+        }
+
+        void record_dealloc (const std::size_t bytes)
+        {
+            this->n_deallocs += 1u;
+            this->bytes_current -= bytes;
+        }
+
+        //! Zero every counter (including the peak)
+        void reset()
+        {
+            this->n_allocs = 0u;
+            this->n_deallocs = 0u;
+            this->bytes_total = 0u;
+            this->bytes_current = 0u;
+            this->bytes_peak = 0u;
+        }
+    };
+
+    //! A static registry of per-subsystem allocation counters
+    struct AllocationStats
+    {
+        //! Access the counters for subsystem \a s
+        static alloc_counters& get (const alloc_subsys s)
+        {
+            return AllocationStats::counters()[static_cast<unsigned int>(s)];
+        }
+
+        //! A short, fixed name for each subsystem, used by dump()
+        static constexpr const char* name (const alloc_subsys s)
+        {
+            switch (s) {
+            case alloc_subsys::vvec_storage: return "vvec_storage";
+            case alloc_subsys::vertex_buffers: return "vertex_buffers";
+            case alloc_subsys::client: return "client";
+            default: return "unknown";
+            }
+        }
+
+        //! Write one line per subsystem to \a os: allocs/deallocs, total and current
+        //! bytes and the peak
+        static void dump (std::ostream& os = std::cout)
+        {
+            for (unsigned int i = 0; i < static_cast<unsigned int>(alloc_subsys::n); ++i) {
+                const alloc_counters& c = AllocationStats::counters()[i];
+                os << "allocstats," << AllocationStats::name (static_cast<alloc_subsys>(i))
+                   << ",allocs=" << c.n_allocs.load() << ",deallocs=" << c.n_deallocs.load()
+                   << ",bytes_total=" << c.bytes_total.load()
+                   << ",bytes_current=" << c.bytes_current.load()
+                   << ",bytes_peak=" << c.bytes_peak.load() << "\n";
+            }
+        }
+
+        //! Zero the counters of every subsystem
+        static void reset()
+        {
+            for (auto& c : AllocationStats::counters()) { c.reset(); }
+        }
+
+    private:
+        static std::array<alloc_counters, static_cast<unsigned int>(alloc_subsys::n)>& counters()
+        {
+            static std::array<alloc_counters, static_cast<unsigned int>(alloc_subsys::n)> ctrs;
+            return ctrs;
+        }
+    };
+
+    /*!
+     * A minimal allocator which counts its allocations into
+     * AllocationStats::get(subsys) and forwards the actual memory management to
+     * std::allocator. Stateless; all instances compare equal, so containers can be
+     * swapped and moved freely.
+     */
+    template <typename T, alloc_subsys subsys = alloc_subsys::client>
+    struct counting_allocator
+    {
+        using value_type = T;
+
+        counting_allocator() = default;
+        template <typename U>
+        constexpr counting_allocator (const counting_allocator<U, subsys>&) noexcept {}
+
+        T* allocate (const std::size_t n)
+        {
+            AllocationStats::get (subsys).record_alloc (n * sizeof(T));
+            return std::allocator<T>{}.allocate (n);
+        }
+
+        void deallocate (T* p, const std::size_t n) noexcept
+        {
+            AllocationStats::get (subsys).record_dealloc (n * sizeof(T));
+            std::allocator<T>{}.deallocate (p, n);
+        }
+
+        template <typename U> struct rebind { using other = counting_allocator<U, subsys>; };
+
+        template <typename U>
+        friend constexpr bool operator== (const counting_allocator&, const counting_allocator<U, subsys>&) noexcept { return true; }
+        template <typename U>
+        friend constexpr bool operator!= (const counting_allocator&, const counting_allocator<U, subsys>&) noexcept { return false; }
+    };
+
+    /*
+     * The allocators that morph::vvec and the VisualModel vertex buffers actually use:
+     * counting in a MORPH_ALLOC_STATS build, plain std::allocator otherwise.
+     */
+#ifdef MORPH_ALLOC_STATS
+    template <typename T> using vvec_allocator = morph::counting_allocator<T, morph::alloc_subsys::vvec_storage>;
+    template <typename T> using vertex_buffer_allocator = morph::counting_allocator<T, morph::alloc_subsys::vertex_buffers>;
+#else
+    template <typename T> using vvec_allocator = std::allocator<T>;
+    template <typename T> using vertex_buffer_allocator = std::allocator<T>;
+#endif
+
+    //! The std::vector type used for the CPU-side vertex and index buffers of the
+    //! VisualModels. Identical to std::vector<T> unless MORPH_ALLOC_STATS is defined.
+    template <typename T> using vertex_buffer_t = std::vector<T, morph::vertex_buffer_allocator<T>>;
+
+} // namespace morph
@@ -13,6 +13,7 @@
 #include <vector>
 #include <string>
 #include <iostream>
+#include <unordered_map>
 #include <morph/MathAlgo.h>
 #include <morph/vvec.h>
 #include <morph/vec.h>
@@ -102,6 +103,15 @@ namespace morph {
         bool display_temperatures = true;
         // Display info on reannealing?
         bool display_reanneal = true;
+        //! If true, consult a memoization cache before asking the client to compute
+        //! f(x_cand). Useful when the objective is expensive (seconds or more) and the
+        //! dynamics revisit parameter sets - on a cache hit, state goes straight to
+        //! NeedToStep and the stored objective value is placed in f_x_cand.
+        bool enable_memoization = false;
+        //! The memoization cache quantizes each parameter to this fraction of its
+        //! range [Ai, Bi] before hashing, so parameter sets which differ by less than
+        //! memo_resolution * (Bi - Ai) in every dimension share a cache entry.
+        T memo_resolution = T{1e-6};
 
     public: // Parameter vectors and objective fn results need to be client-accessible.
 
@@ -153,6 +163,10 @@ namespace morph {
 
         //! Absolute count of number of calls to ::step().
         unsigned int steps = 0;
+        //! Number of candidate objective values served from the memoization cache.
+        unsigned int memo_hits = 0;
+        //! Number of candidates which were not in the memoization cache.
+        unsigned int memo_misses = 0;
         //! A history of all accepted parameters evaluated
         morph::vvec<morph::vvec<T>> param_hist_accepted;
         //! For each entry in param_hist, record also its objective function value.
@@ -289,6 +303,11 @@ namespace morph {
         {
             ++this->steps;
 
+            // If the client has just computed f(x_cand), store it in the memoization cache.
+            if (this->enable_memoization == true && this->state == Anneal_State::NeedToCompute) {
+                this->memo_insert (this->x_cand, this->f_x_cand);
+            }
+
             if (this->stop_check()) {
                 this->state = Anneal_State::ReadyToStop;
                 return;
@@ -310,11 +329,21 @@ namespace morph {
                 // flag so that client code will compute a set of objective functions to
                 // allow Anneal::complete_reanneal() to complete the reannealing.
                 this->state = Anneal_State::NeedToComputeSet;
+            } else if (this->enable_memoization == true && this->memo_lookup (this->x_cand, this->f_x_cand)) {
+                // The new candidate's objective was served from the cache; no need to
+                // ask the client to compute it.
+                ++this->memo_hits;
+                this->state = Anneal_State::NeedToStep;
             } else {
+                if (this->enable_memoization == true) { ++this->memo_misses; }
                 this->state = Anneal_State::NeedToCompute;
             }
         }
 
+        //! The number of distinct (to memo_resolution) parameter sets held in the
+        //! memoization cache.
+        std::size_t memo_entries() const { return this->memo_cache.size(); }
+
         //! Save optimization info/history into an HDF5 file. Save the optimization
         //! parameters too, along with the temperature histories.
         void save (const std::string& path) const
@@ -342,6 +371,8 @@ namespace morph {
             data.add_val ("/num_generated_best", this->num_generated_best);
             data.add_val ("/num_accepted", this->num_accepted);
             data.add_val ("/num_accepted_best", this->num_accepted_best);
+            data.add_val ("/memo_hits", this->memo_hits);
+            data.add_val ("/memo_misses", this->memo_misses);
 
             data.add_val ("/D", this->D);
             data.add_contained_vals ("/T_0", this->T_0);
@@ -368,6 +399,47 @@ namespace morph {
 
     protected: // Internal algorithm methods.
 
+        //! Hash for the quantized parameter-vector keys of the memoization cache.
+        struct memo_key_hash
+        {
+            std::size_t operator() (const std::vector<long long>& key) const
+            {
+                std::size_t h = key.size();
+                for (auto q : key) {
+                    h ^= std::hash<long long>{}(q) + std::size_t{0x9e3779b9} + (h << 6) + (h >> 2);
+                }
+                return h;
+            }
+        };
+        //! The memoization cache. Maps quantized parameter vectors to objective values.
+        std::unordered_map<std::vector<long long>, T, memo_key_hash> memo_cache;
+
+        //! Quantize a parameter set to memo_resolution fractions of each parameter's range.
+        std::vector<long long> memo_quantize (const morph::vvec<T>& params) const
+        {
+            std::vector<long long> key (this->D, 0);
+            for (unsigned int i = 0; i < this->D; ++i) {
+                T qstep = this->rdelta[i] * this->memo_resolution;
+                key[i] = qstep > T{0} ? std::llround ((params[i] - this->range_min[i]) / qstep) : 0;
+            }
+            return key;
+        }
+
+        //! If params has a cached objective value, place it in f_out and return true.
+        bool memo_lookup (const morph::vvec<T>& params, T& f_out) const
+        {
+            auto it = this->memo_cache.find (this->memo_quantize (params));
+            if (it == this->memo_cache.end()) { return false; }
+            f_out = it->second;
+            return true;
+        }
+
+        //! Cache the objective value f_val for the parameter set params.
+        void memo_insert (const morph::vvec<T>& params, const T f_val)
+        {
+            this->memo_cache[this->memo_quantize (params)] = f_val;
+        }
+
         //! Generate delta parameter near to x_start, for cost tangent estimation
         morph::vvec<T> generate_delta_parameter (const morph::vvec<T>& x_start) const
         {
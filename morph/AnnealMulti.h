@@ -0,0 +1,260 @@
+/*
+ * Parallel tempering (replica exchange) extension of the Adaptive Simulated
+ * Annealing implementation in morph/Anneal.h. Runs K annealing chains at staggered
+ * temperatures and presents all K candidate parameter sets as a batch each
+ * iteration, so that client code can evaluate expensive objectives concurrently.
+ *
+ * Author: Seb James
+ * Date: August 2026
+ */
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <iostream>
+#include <morph/vvec.h>
+#include <morph/vec.h>
+#include <morph/Anneal.h>
+#include <morph/Random.h>
+
+namespace morph {
+
+    /*!
+     * A multi-chain, parallel tempering annealer. This composes K morph::Anneal
+     * chains. Chain 0 is the 'coldest' and anneals exactly as a single Anneal would;
+     * each subsequent chain has its generation and acceptance temperatures scaled up
+     * by a factor of ladder_ratio, so hotter chains take larger steps and accept
+     * worse candidates more readily. Every exchange_every steps, adjacent pairs of
+     * chains may swap their current states with the usual replica exchange
+     * probability, letting good solutions found by the exploratory hot chains
+     * migrate down to the cold chain.
+     *
+     * The client loop mirrors that of morph::Anneal, but the objective is computed
+     * for a *batch* of K parameter sets per iteration - one per chain - so the
+     * evaluations (expensive simulations, perhaps) can be farmed out across threads
+     * or processes by the client:
+     *
+     *    morph::AnnealMulti<double> anneal (x0, ranges, 8);
+     *    anneal.init();
+     *    while (anneal.state != morph::Anneal_State::ReadyToStop) {
+     *        if (anneal.state == morph::Anneal_State::NeedToCompute) {
+     *            // Compute in parallel, if desired:
+     *            for (unsigned int i = 0; i < anneal.n_chains(); ++i) {
+     *                anneal.f_x_set[i] = objective (anneal.x_set[i]);
+     *            }
+     *        } else { throw std::runtime_error ("Unexpected state"); }
+     *        anneal.step();
+     *    }
+     *    // Result in anneal.x_best_overall(), anneal.f_x_best_overall()
+     *
+     * Reannealing (which needs extra, unbatchable objective evaluations mid-step) is
+     * disabled in the chains; the temperature ladder and state exchange take over
+     * its role of keeping the search from freezing into a local minimum.
+     *
+     * \tparam T The type for the numbers in the algorithm. Expected to be floating
+     * point, so float or double.
+     *
+     * \tparam debug Set true to show some text output
+     */
+    template <typename T, bool debug = false>
+    class AnnealMulti
+    {
+        //! A thin wrapper whose only job is to make it possible for AnnealMulti to
+        //! re-generate a chain's candidate after a replica exchange has replaced the
+        //! chain's current state (generate_next is protected in Anneal).
+        struct Chain : public Anneal<T, debug>
+        {
+            Chain (const morph::vvec<T>& initial_params,
+                   const morph::vvec<morph::vec<T,2>>& param_ranges)
+                : Anneal<T, debug> (initial_params, param_ranges) {}
+            //! Generate a fresh candidate around the (possibly just-exchanged) current state
+            void regenerate() { this->generate_next(); }
+        };
+
+    public: // Parameters to be adjusted by user before calling AnnealMulti::init()
+
+        //! The factor by which each chain's temperatures exceed those of the chain
+        //! below it on the ladder. Chain i runs at ladder_ratio^i times the base
+        //! temperature.
+        T ladder_ratio = T{2};
+        //! Attempt replica exchanges between adjacent chains every exchange_every steps.
+        unsigned int exchange_every = 10;
+        //! Display information about replica exchanges?
+        bool display_exchanges = false;
+        //! As morph::Anneal::downhill; applied to every chain in init().
+        bool downhill = true;
+
+    public: // The batch interface and statistics.
+
+        //! The K candidate parameter sets, one per chain, refreshed on each step.
+        morph::vvec<morph::vvec<T>> x_set;
+        //! The objective function values for x_set; to be filled by the client
+        //! before each call to step(). The entry for a finished chain is ignored.
+        morph::vvec<T> f_x_set;
+        //! The chains. chains[0] is the coldest. Public for parameter tweaking
+        //! (between construction and init()) and for statistics.
+        std::vector<Chain> chains;
+        //! The number of replica exchanges attempted.
+        unsigned int num_exchanges_attempted = 0;
+        //! The number of replica exchanges accepted.
+        unsigned int num_exchanges_accepted = 0;
+        //! Absolute count of the number of calls to ::step().
+        unsigned int steps = 0;
+        //! The state tells client code what it needs to do next (NeedToInit,
+        //! NeedToCompute or ReadyToStop).
+        Anneal_State state = Anneal_State::Unknown;
+
+    public: // User-accessible methods.
+
+        //! The constructor requires initial parameters, parameter ranges and the
+        //! number of chains.
+        AnnealMulti (const morph::vvec<T>& initial_params,
+                     const morph::vvec<morph::vec<T,2>>& param_ranges,
+                     const unsigned int n_chains)
+        {
+            if (n_chains == 0) { throw std::runtime_error ("AnnealMulti: n_chains must be >0"); }
+            this->chains.reserve (n_chains);
+            for (unsigned int i = 0; i < n_chains; ++i) {
+                this->chains.push_back (Chain (initial_params, param_ranges));
+            }
+            this->state = Anneal_State::NeedToInit;
+        }
+
+        //! After constructing, then setting parameters (either here or on the
+        //! individual chains), the user must call init.
+        void init()
+        {
+            const unsigned int K = this->chains.size();
+            T tscale = T{1};
+            for (unsigned int i = 0; i < K; ++i) {
+                Chain& ch = this->chains[i];
+                ch.downhill = this->downhill;
+                // Reannealing requires extra objective evaluations which don't fit
+                // the batch interface; the temperature ladder takes over its role.
+                ch.enable_reanneal = false;
+                // K lines of temperature output per step would be unreadable.
+                ch.display_temperatures = false;
+                ch.init();
+                // Stagger the chain's temperatures up the ladder. Scaling both the
+                // initial and current temperatures preserves each chain's cooling
+                // schedule; only the scale differs between chains.
+                ch.T_0 *= tscale;
+                ch.T_k *= tscale;
+                ch.T_cost_0 *= tscale;
+                ch.T_cost *= tscale;
+                tscale *= this->ladder_ratio;
+            }
+            this->finished.resize (K, false);
+            this->x_set.resize (K);
+            this->f_x_set.resize (K, T{0});
+            for (unsigned int i = 0; i < K; ++i) { this->x_set[i] = this->chains[i].x_cand; }
+            this->state = Anneal_State::NeedToCompute;
+        }
+
+        //! The number of chains, K.
+        unsigned int n_chains() const { return this->chains.size(); }
+
+        //! Advance every chain by one step, attempt replica exchanges periodically,
+        //! and refresh x_set with the next batch of candidates.
+        void step()
+        {
+            ++this->steps;
+            const unsigned int K = this->chains.size();
+
+            // Pass the batch objectives in and step each unfinished chain
+            for (unsigned int i = 0; i < K; ++i) {
+                if (this->finished[i]) { continue; }
+                this->chains[i].f_x_cand = this->f_x_set[i];
+                this->chains[i].step();
+                if (this->chains[i].state == Anneal_State::ReadyToStop) {
+                    this->finished[i] = true;
+                }
+            }
+
+            // Periodically attempt to exchange the current states of adjacent chains
+            if (this->exchange_every > 0 && (this->steps % this->exchange_every) == 0) {
+                this->exchange_states();
+            }
+
+            // Refresh the batch of candidates. A finished chain's entry just repeats
+            // its best parameters; its objective value is not used again.
+            bool all_finished = true;
+            for (unsigned int i = 0; i < K; ++i) {
+                if (this->finished[i]) {
+                    this->x_set[i] = this->chains[i].x_best;
+                } else {
+                    this->x_set[i] = this->chains[i].x_cand;
+                    all_finished = false;
+                }
+            }
+            this->state = all_finished ? Anneal_State::ReadyToStop : Anneal_State::NeedToCompute;
+        }
+
+        //! The best parameters found by any chain.
+        morph::vvec<T> x_best_overall() const { return this->chains[this->best_chain()].x_best; }
+
+        //! The best objective value found by any chain.
+        T f_x_best_overall() const { return this->chains[this->best_chain()].f_x_best; }
+
+        //! The index of the chain holding the best parameters.
+        unsigned int best_chain() const
+        {
+            unsigned int bi = 0;
+            for (unsigned int i = 1; i < this->chains.size(); ++i) {
+                if ((this->downhill == true && this->chains[i].f_x_best < this->chains[bi].f_x_best)
+                    || (this->downhill == false && this->chains[i].f_x_best > this->chains[bi].f_x_best)) {
+                    bi = i;
+                }
+            }
+            return bi;
+        }
+
+    protected: // Internal algorithm methods.
+
+        //! Attempt a replica exchange between each adjacent pair of chains. The
+        //! exchange probability is the standard parallel tempering acceptance,
+        //! p = min(1, exp((1/T_i - 1/T_j)(E_i - E_j))), computed with each chain's
+        //! acceptance temperature. On acceptance, the chains swap their current
+        //! states (x, f_x) and regenerate their candidates about the new states.
+        void exchange_states()
+        {
+            for (unsigned int i = 0; i + 1 < this->chains.size(); ++i) {
+                if (this->finished[i] || this->finished[i+1]) { continue; }
+                Chain& ci = this->chains[i];
+                Chain& cj = this->chains[i+1];
+                ++this->num_exchanges_attempted;
+
+                constexpr T eps = std::numeric_limits<T>::epsilon();
+                T Ti = ci.T_cost.mean() + eps;
+                T Tj = cj.T_cost.mean() + eps;
+                // Energies; negated for an ascent so that the acceptance rule is unchanged
+                T Ei = this->downhill ? ci.f_x : -ci.f_x;
+                T Ej = this->downhill ? cj.f_x : -cj.f_x;
+                T p = std::exp ((T{1}/Ti - T{1}/Tj) * (Ei - Ej));
+                p = std::min (T{1}, p);
+
+                if (p >= this->rng_u.get()) {
+                    ++this->num_exchanges_accepted;
+                    std::swap (ci.x, cj.x);
+                    std::swap (ci.f_x, cj.f_x);
+                    // The chains' candidates were generated about the pre-exchange
+                    // states, so regenerate them about the new ones
+                    ci.regenerate();
+                    cj.regenerate();
+                    if (this->display_exchanges) {
+                        std::cout << "Replica exchange between chains " << i << " and " << (i+1)
+                                  << " (f_x now " << ci.f_x << " / " << cj.f_x << ")\n";
+                    }
+                }
+            }
+        }
+
+        //! Which chains have reached their stopping condition?
+        std::vector<bool> finished;
+        //! The random number generator used in the exchange acceptance test.
+        morph::RandUniform<T> rng_u;
+    };
+
+} // namespace morph
@@ -10,6 +10,7 @@
 #include <utility>
 #include <vector>
 #include <array>
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <sstream>
@@ -705,13 +706,16 @@ namespace morph
         BezCoord<Flt> computePointMatrix (Flt t) const
         {
             this->checkt(t);
-            int mp = this->order+1;
-            arma::Mat<Flt> T(1, mp, arma::fill::ones);// First element is one anyway
-            for (int i = 1; i < mp; ++i) {
-                T(i) = std::pow (t, static_cast<double>(i));
+            // The row vector T would be (1, t, t^2, ... t^order); rather than
+            // constructing it (and the product T * MC) as arma matrices on every call,
+            // accumulate a running power of t against the cached MC coefficients.
+            morph::vec<Flt, 2> _bp = { static_cast<Flt>(this->MC(0,0)), static_cast<Flt>(this->MC(0,1)) };
+            Flt tp = Flt{1};
+            for (unsigned int i = 1; i <= this->order; ++i) {
+                tp *= t;
+                _bp[0] += tp * static_cast<Flt>(this->MC(i,0));
+                _bp[1] += tp * static_cast<Flt>(this->MC(i,1));
             }
-            arma::Mat<Flt> bp = T * this->MC;
-            morph::vec<Flt, 2> _bp = {static_cast<Flt>(bp(0)), static_cast<Flt>(bp(1))};
             return BezCoord<Flt> (t, _bp);
         }
 
@@ -760,6 +764,81 @@ namespace morph
             }
         }
 
+        /*!
+         * Build (or rebuild) the arc-length lookup table, which caches the cumulative
+         * arc length of the curve at n+1 parameter values equally spaced in t. Once
+         * built, computePointAtLength answers arc-length queries with a single bracket
+         * lookup rather than a binary search over computePoint calls. The table is
+         * built lazily by the methods which need it, so calling this directly is only
+         * necessary to choose a non-default resolution. The table is invalidated if
+         * the curve's controls or scale change.
+         */
+        void buildArcLengthLUT (unsigned int n = 256) const
+        {
+            if (n == 0) {
+                throw std::runtime_error ("buildArcLengthLUT: n must be >0");
+            }
+            this->lut_n = n;
+            this->lut_len.resize (n + 1u);
+            this->lut_len[0] = Flt{0};
+            morph::vec<Flt, 2> last = this->computePoint (Flt{0}).coord;
+            for (unsigned int i = 1; i <= n; ++i) {
+                morph::vec<Flt, 2> next = this->computePoint (i/static_cast<Flt>(n)).coord;
+                this->lut_len[i] = this->lut_len[i-1] + (next - last).length();
+                last = next;
+            }
+        }
+
+        /*!
+         * The arc length of the whole curve, as approximated by the arc-length lookup
+         * table (cf. the private computeLength, which sums afresh on each call).
+         */
+        Flt arcLength() const
+        {
+            this->ensureArcLengthLUT();
+            return this->lut_len.back();
+        }
+
+        /*!
+         * Compute the point which lies arc length l along the curve from its starting
+         * point. The parameter value is found by bracketing l in the arc-length lookup
+         * table and interpolating t linearly within the bracketing interval, so each
+         * query costs one binary search of the table plus one computePoint - there's no
+         * iterative subdivision. l is clamped to the range [0, arcLength()].
+         */
+        BezCoord<Flt> computePointAtLength (Flt l) const
+        {
+            this->ensureArcLengthLUT();
+            if (l <= Flt{0}) { return this->computePoint (Flt{0}); }
+            if (l >= this->lut_len.back()) { return this->computePoint (Flt{1}); }
+            // lut_len is cumulative and so non-decreasing; find the first entry >= l.
+            auto li = std::lower_bound (this->lut_len.begin(), this->lut_len.end(), l);
+            std::size_t i = static_cast<std::size_t>(li - this->lut_len.begin()); // >=1 as lut_len[0] is 0
+            Flt seg = this->lut_len[i] - this->lut_len[i-1];
+            Flt frac = seg > Flt{0} ? (l - this->lut_len[i-1]) / seg : Flt{0};
+            Flt t = (static_cast<Flt>(i-1) + frac) / static_cast<Flt>(this->lut_n);
+            return this->computePoint (t);
+        }
+
+        /*!
+         * Bulk sampling. Compute n points which are equally spaced in arc length along
+         * the curve, from its start (arc length 0) to its end (arc length arcLength()),
+         * writing the coordinates into the caller-allocated buffer buf, which must have
+         * space for at least n elements. Uses the arc-length lookup table, so this is a
+         * much cheaper way to resample a curve evenly than repeated computePoint (t, l)
+         * calls.
+         */
+        void computePointsAtLengths (morph::vec<Flt, 2>* buf, unsigned int n) const
+        {
+            if (n == 0) { return; }
+            this->ensureArcLengthLUT();
+            Flt total = this->lut_len.back();
+            buf[0] = this->computePoint (Flt{0}).coord;
+            for (unsigned int i = 1; i < n; ++i) {
+                buf[i] = this->computePointAtLength (total * i/static_cast<Flt>(n-1)).coord;
+            }
+        }
+
         //! Compute the unit tangent and unit normal at t.
         std::pair<BezCoord<Flt>, BezCoord<Flt>> computeTangentNormal (const Flt t) const
         {
@@ -829,6 +908,7 @@ namespace morph
         {
             this->scale = s;
             this->linlengthscaled = this->scale * this->linlength;
+            this->lut_len.clear(); // The arc-length LUT holds scaled lengths
         }
 
         //! A setter for the length threshold.
@@ -891,6 +971,7 @@ namespace morph
             this->linlength = std::sqrt ((C(order,0)-C(0,0)) * (C(order,0) - C(0,0))
                                          + (C(order,1)-C(0,1)) * (C(order,1) - C(0,1)));
             this->linlengthscaled = this->scale * this->linlength;
+            this->lut_len.clear(); // Controls have (or may have) changed
             this->matrixSetup();
         }
 
@@ -1146,6 +1227,13 @@ namespace morph
             return b2;
         }
 
+        //! Build the arc-length lookup table at the default resolution, if it has not
+        //! been built (or has been invalidated by a change to the curve).
+        void ensureArcLengthLUT() const
+        {
+            if (this->lut_len.empty()) { this->buildArcLengthLUT(); }
+        }
+
         //! Test that t is in range [0,1]. Throw exception otherwise.
         void checkt (Flt t) const
         {
@@ -1184,6 +1272,17 @@ namespace morph
          */
         Flt linlengthscaled = Flt{0};
 
+        /*!
+         * The arc-length lookup table: lut_len[i] is the cumulative arc length of the
+         * curve (in scaled units) at t = i/lut_n. Empty until built by
+         * buildArcLengthLUT (or lazily via ensureArcLengthLUT); cleared whenever the
+         * curve changes. mutable, as it is a cache which const query methods may build.
+         */
+        mutable std::vector<Flt> lut_len;
+
+        //! The number of intervals in the arc-length lookup table.
+        mutable unsigned int lut_n = 0;
+
         /*!
          * The order of the Bezier curve. The value of the highest power of t. Thus 3 is
          * a cubic Bezier, 2 is a quadratic Bezier, etc. Note that 0th order Bezier
@@ -190,11 +190,14 @@ namespace morph
             }
             this->points.push_back (startPt);
 
-            // Make cp a complete set of points for the current curve *including
-            // the point in the curve for t=0*
-            std::pair<BezCoord<Flt>, BezCoord<Flt>> tn0 = this->curves.front().computeTangentNormal(Flt{0});
-            this->tangents.push_back (tn0.first);
-            this->normals.push_back (tn0.second);
+            /*
+             * Phase one: walk the curves gathering points. This is inherently serial - how far
+             * into each curve the first step lands (firstl) depends on how much of the previous
+             * step remained at the end of the preceding curve. Note which curve generated each
+             * point, for phase two.
+             */
+            std::vector<const BezCurve<Flt>*> pcurves; // The curve that generated each of this->points
+            pcurves.push_back (&this->curves.front());
 
             typename std::list<BezCurve<Flt>>::const_iterator i = this->curves.begin();
             // Don't forget to set the scaling factor in each
@@ -214,15 +217,27 @@ namespace morph
                     }
                 }
                 this->points.insert (this->points.end(), cp.begin(), cp.end());
-
-                // Now compute tangents and normals
-                for (BezCoord<Flt> bp : cp) {
-                    std::pair<BezCoord<Flt>, BezCoord<Flt>> tn = i->computeTangentNormal(bp.t());
-                    this->tangents.push_back (tn.first);
-                    this->normals.push_back (tn.second);
-                }
+                pcurves.insert (pcurves.end(), cp.size(), &(*i));
                 ++i;
             }
+
+            /*
+             * Phase two: tangents and normals. Each is computed from one point's t value alone,
+             * so all the points of all the curves can be processed concurrently - this is the
+             * bulk of the arithmetic when sampling a many-curved path.
+             */
+            const int n_points = static_cast<int>(this->points.size());
+            this->tangents.resize (n_points);
+            this->normals.resize (n_points);
+            std::pair<BezCoord<Flt>, BezCoord<Flt>> tn0 = this->curves.front().computeTangentNormal (Flt{0});
+            this->tangents[0] = tn0.first;
+            this->normals[0] = tn0.second;
+#pragma omp parallel for
+            for (int pi = 1; pi < n_points; ++pi) {
+                std::pair<BezCoord<Flt>, BezCoord<Flt>> tn = pcurves[pi]->computeTangentNormal (this->points[pi].t());
+                this->tangents[pi] = tn.first;
+                this->normals[pi] = tn.second;
+            }
         }
 
         // Getters
@@ -0,0 +1,178 @@
+/*!
+ * \file
+ *
+ * \brief morph::CameraPath, a keyframed scene rotation/translation path for scripted
+ * camera fly-throughs
+ *
+ * Add keyframes (a time, a scene rotation and a scene translation), then compile()
+ * precomputes interpolation tables - Catmull-Rom through the translations and
+ * spherical linear interpolation between the rotations, batched per segment with
+ * quaternion::slerp_batch. After that, eval() is a table lookup and a lerp: O(1)
+ * per frame, with none of the per-frame trigonometry in the render loop.
+ * morph::Visual can advance a CameraPath itself; see VisualBase::playCameraPath.
+ *
+ * \author Seb James
+ * \date August 2026
+ */
+#pragma once
+
+#include <morph/vec.h>
+#include <morph/quaternion.h>
+#include <vector>
+#include <algorithm>
+#include <span>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+
+namespace morph {
+
+    class CameraPath
+    {
+    public:
+        //! One keyframe: at time \a t (seconds from the start of the path) the scene
+        //! has rotation \a rotn and translation \a trans
+        struct keyframe
+        {
+            float t = 0.0f;
+            morph::quaternion<float> rotn;
+            morph::vec<float, 3> trans = { 0.0f, 0.0f, 0.0f };
+        };
+
+        //! Append a keyframe. Keyframes may be added in any time order; compile()
+        //! sorts them. Adding a keyframe invalidates any compiled tables.
+        void addKeyframe (const float t, const morph::quaternion<float>& rotn, const morph::vec<float, 3>& trans)
+        {
+            if (t < 0.0f) { throw std::runtime_error ("CameraPath::addKeyframe: time must be >= 0"); }
+            this->keyframes.push_back ({ t, rotn, trans });
+            this->rot_table.clear();
+            this->trans_table.clear();
+        }
+
+        //! Discard keyframes and tables
+        void reset()
+        {
+            this->keyframes.clear();
+            this->rot_table.clear();
+            this->trans_table.clear();
+        }
+
+        //! The time of the last keyframe (0 if there are none)
+        float duration() const { return this->keyframes.empty() ? 0.0f : this->keyframes.back().t; }
+
+        //! True when compile() has been run on the current keyframes
+        bool compiled() const { return this->rot_table.empty() == false; }
+
+        /*!
+         * Precompute the interpolation tables at \a samples_per_second. Rotations are
+         * slerped along each keyframe segment with quaternion::slerp_batch, so the
+         * inter-quaternion angles are derived once per segment; translations follow a
+         * Catmull-Rom spline through the keyframe positions. Needs at least two
+         * keyframes. For a seamless loop, make the last keyframe match the first.
+         */
+        void compile (const unsigned int samples_per_second = 120)
+        {
+            if (this->keyframes.size() < 2u) {
+                throw std::runtime_error ("CameraPath::compile: need at least 2 keyframes");
+            }
+            if (samples_per_second == 0u) {
+                throw std::runtime_error ("CameraPath::compile: samples_per_second must be > 0");
+            }
+            std::stable_sort (this->keyframes.begin(), this->keyframes.end(),
+                              [] (const keyframe& a, const keyframe& b) { return a.t < b.t; });
+            const float T = this->keyframes.back().t - this->keyframes.front().t;
+            if (T <= 0.0f) { throw std::runtime_error ("CameraPath::compile: keyframes span no time"); }
+
+            const std::size_t n = static_cast<std::size_t>(std::ceil (T * samples_per_second)) + 1u;
+            this->table_dt = T / static_cast<float>(n - 1u);
+            this->rot_table.resize (n);
+            this->trans_table.resize (n);
+
+            const float t0 = this->keyframes.front().t;
+            std::size_t i = 0; // table index; advances monotonically through the segments
+            for (std::size_t k = 0; k + 1u < this->keyframes.size(); ++k) {
+                const keyframe& ka = this->keyframes[k];
+                const keyframe& kb = this->keyframes[k + 1u];
+                const float seg = kb.t - ka.t;
+                if (seg <= 0.0f) { continue; } // coincident keyframes; kb wins via the next segment
+                // The run of table samples [i, i_end] lying within this segment
+                std::size_t i_end = i;
+                while (i_end + 1u < n && t0 + static_cast<float>(i_end + 1u) * this->table_dt <= kb.t) { ++i_end; }
+                if (k + 2u == this->keyframes.size()) { i_end = n - 1u; } // last segment takes the remainder
+
+                // Rotations: move the segment endpoints to the first/last sample times,
+                // then slerp_batch fills the run with evenly spaced interpolants
+                const float u_first = (static_cast<float>(i) * this->table_dt - (ka.t - t0)) / seg;
+                const float u_last = (static_cast<float>(i_end) * this->table_dt - (ka.t - t0)) / seg;
+                const morph::quaternion<float> qa = ka.rotn.slerp (kb.rotn, std::clamp (u_first, 0.0f, 1.0f));
+                const morph::quaternion<float> qb = ka.rotn.slerp (kb.rotn, std::clamp (u_last, 0.0f, 1.0f));
+                qa.slerp_batch (qb, std::span<morph::quaternion<float>>(this->rot_table.data() + i, i_end - i + 1u));
+
+                // Translations: Catmull-Rom. Tangents from the neighbouring keyframes
+                // (clamped at the ends), scaled for the non-uniform keyframe spacing
+                const morph::vec<float, 3>& pa = ka.trans;
+                const morph::vec<float, 3>& pb = kb.trans;
+                const morph::vec<float, 3>& p_prev = k > 0 ? this->keyframes[k - 1u].trans : pa;
+                const morph::vec<float, 3>& p_next = k + 2u < this->keyframes.size() ? this->keyframes[k + 2u].trans : pb;
+                const float t_prev = k > 0 ? this->keyframes[k - 1u].t : ka.t - seg;
+                const float t_next = k + 2u < this->keyframes.size() ? this->keyframes[k + 2u].t : kb.t + seg;
+                const morph::vec<float, 3> ma = (pb - p_prev) * (seg / (kb.t - t_prev));
+                const morph::vec<float, 3> mb = (p_next - pa) * (seg / (t_next - ka.t));
+                for (std::size_t j = i; j <= i_end; ++j) {
+                    const float u = std::clamp ((static_cast<float>(j) * this->table_dt - (ka.t - t0)) / seg, 0.0f, 1.0f);
+                    const float u2 = u * u;
+                    const float u3 = u2 * u;
+                    this->trans_table[j] = pa * (2.0f * u3 - 3.0f * u2 + 1.0f) + ma * (u3 - 2.0f * u2 + u)
+                        + pb * (-2.0f * u3 + 3.0f * u2) + mb * (u3 - u2);
+                }
+                i = i_end;
+                if (i == n - 1u) { break; }
+            }
+        }
+
+        /*!
+         * The pose at time \a t seconds along the path, written into \a rotn and \a
+         * trans. \a t beyond the end is wrapped if \a wrap is true, clamped
+         * otherwise. O(1): a table index and one lerp (nlerp for the rotation).
+         * Throws if compile() has not been run.
+         */
+        void eval (float t, morph::quaternion<float>& rotn, morph::vec<float, 3>& trans, const bool wrap = false) const
+        {
+            if (this->compiled() == false) { throw std::runtime_error ("CameraPath::eval: compile() the path first"); }
+            const std::size_t n = this->rot_table.size();
+            const float T = static_cast<float>(n - 1u) * this->table_dt;
+            t -= this->keyframes.front().t;
+            if (wrap == true) {
+                t = std::fmod (t, T);
+                if (t < 0.0f) { t += T; }
+            } else {
+                t = std::clamp (t, 0.0f, T);
+            }
+            const float s = t / this->table_dt;
+            const std::size_t i = std::min (static_cast<std::size_t>(s), n - 2u);
+            const float u = s - static_cast<float>(i);
+
+            trans = this->trans_table[i] * (1.0f - u) + this->trans_table[i + 1u] * u;
+            // Adjacent table entries are sub-degree apart, so nlerp is indistinguishable
+            // from slerp here and costs no trigonometry
+            const morph::quaternion<float>& qa = this->rot_table[i];
+            morph::quaternion<float> qb = this->rot_table[i + 1u];
+            if (qa.w * qb.w + qa.x * qb.x + qa.y * qb.y + qa.z * qb.z < 0.0f) {
+                qb = morph::quaternion<float>(-qb.w, -qb.x, -qb.y, -qb.z);
+            }
+            rotn = morph::quaternion<float>(qa.w + (qb.w - qa.w) * u, qa.x + (qb.x - qa.x) * u,
+                                            qa.y + (qb.y - qa.y) * u, qa.z + (qb.z - qa.z) * u);
+            rotn.renormalize();
+        }
+
+    private:
+        std::vector<keyframe> keyframes;
+        //! The precomputed rotation samples, table_dt apart in time
+        std::vector<morph::quaternion<float>> rot_table;
+        //! The precomputed translation samples
+        std::vector<morph::vec<float, 3>> trans_table;
+        //! Seconds between table samples
+        float table_dt = 0.0f;
+    };
+
+} // namespace morph
@@ -22,6 +22,7 @@
 #include <morph/vvec.h>
 #include <morph/scale.h>
 #include <morph/range.h>
+#include <morph/snapshot.h>
 
 // If the CartGrid::save and CartGrid::load methods are required, define
 // CARTGRID_COMPILE_LOAD_AND_SAVE. A link to libhdf5 will be required in your program.
@@ -41,6 +42,8 @@
 #include <vector>
 #include <stdexcept>
 #include <limits>
+#include <span>
+#include <algorithm>
 
 namespace morph {
 
@@ -591,6 +594,150 @@ namespace morph {
         }
 #endif // CARTGRID_COMPILE_LOAD_AND_SAVE
 
+        /*!
+         * Save this CartGrid into a flat binary snapshot at \a path. Unlike save(),
+         * which requires HDF5 and serializes the full list<Rect>, this writes only the
+         * scalars and the d_* vectors, as raw, contiguous arrays in the shared
+         * morph::snapshot format (versioned header, named sections, per-section
+         * CRC-32C). load_snapshot() maps the file and bulk-copies the arrays in place.
+         */
+        void save_snapshot (const std::string& path) const
+        {
+            morph::snapshot::writer w (path, cg_snapshot_tag, cg_snapshot_version);
+
+            w.add_value ("d", this->d);
+            w.add_value ("v", this->v);
+            w.add_value ("x_span", this->x_span);
+            w.add_value ("y_span", this->y_span);
+            w.add_value ("z", this->z);
+            w.add_value ("d_gb_horz", this->d_growthbuffer_horz);
+            w.add_value ("d_gb_vert", this->d_growthbuffer_vert);
+            w.add_value ("bcentroid", this->boundaryCentroid);
+            w.add_value ("w_px", this->w_px);
+            w.add_value ("h_px", this->h_px);
+            w.add_value ("x_minmax", this->x_minmax);
+            w.add_value ("y_minmax", this->y_minmax);
+            w.add_value ("xi_minmax", this->xi_minmax);
+            w.add_value ("yi_minmax", this->yi_minmax);
+            std::uint32_t shape = static_cast<std::uint32_t>(this->domainShape);
+            w.add_value ("domainShape", shape);
+            std::uint8_t reduced = this->gridReduced ? 1 : 0;
+            w.add_value ("gridReduced", reduced);
+
+            w.add_array ("d_x", this->d_x);
+            w.add_array ("d_y", this->d_y);
+            w.add_array ("d_xi", this->d_xi);
+            w.add_array ("d_yi", this->d_yi);
+            w.add_array ("d_ne", this->d_ne);
+            w.add_array ("d_nne", this->d_nne);
+            w.add_array ("d_nn", this->d_nn);
+            w.add_array ("d_nnw", this->d_nnw);
+            w.add_array ("d_nw", this->d_nw);
+            w.add_array ("d_nsw", this->d_nsw);
+            w.add_array ("d_ns", this->d_ns);
+            w.add_array ("d_nse", this->d_nse);
+            w.add_array ("d_flags", this->d_flags);
+            w.add_array ("d_distToBdry", this->d_distToBoundary);
+
+            w.finish();
+        }
+
+        /*!
+         * Populate this CartGrid from a binary snapshot written by save_snapshot(). The
+         * file is memory mapped (morph::snapshot::reader) and the d_* vectors filled by
+         * bulk copies from the map, with no list<Rect> reconstruction; rects is left
+         * empty and is materialized lazily (see materialize_rects()) only if a
+         * list-based method is called. Throws std::runtime_error if the file is
+         * missing, isn't a CartGrid snapshot, has the wrong version or fails its
+         * checksums.
+         */
+        void load_snapshot (const std::string& path)
+        {
+            morph::snapshot::reader r (path, cg_snapshot_tag, cg_snapshot_version);
+
+            r.value ("d", this->d);
+            r.value ("v", this->v);
+            r.value ("x_span", this->x_span);
+            r.value ("y_span", this->y_span);
+            r.value ("z", this->z);
+            r.value ("d_gb_horz", this->d_growthbuffer_horz);
+            r.value ("d_gb_vert", this->d_growthbuffer_vert);
+            r.value ("bcentroid", this->boundaryCentroid);
+            r.value ("w_px", this->w_px);
+            r.value ("h_px", this->h_px);
+            r.value ("x_minmax", this->x_minmax);
+            r.value ("y_minmax", this->y_minmax);
+            r.value ("xi_minmax", this->xi_minmax);
+            r.value ("yi_minmax", this->yi_minmax);
+            std::uint32_t shape = 0;
+            r.value ("domainShape", shape);
+            this->domainShape = static_cast<morph::GridDomainShape>(shape);
+            std::uint8_t reduced = 0;
+            r.value ("gridReduced", reduced);
+            this->gridReduced = reduced > 0;
+
+            r.fill ("d_x", this->d_x);
+            r.fill ("d_y", this->d_y);
+            r.fill ("d_xi", this->d_xi);
+            r.fill ("d_yi", this->d_yi);
+            r.fill ("d_ne", this->d_ne);
+            r.fill ("d_nne", this->d_nne);
+            r.fill ("d_nn", this->d_nn);
+            r.fill ("d_nnw", this->d_nnw);
+            r.fill ("d_nw", this->d_nw);
+            r.fill ("d_nsw", this->d_nsw);
+            r.fill ("d_ns", this->d_ns);
+            r.fill ("d_nse", this->d_nse);
+            r.fill ("d_flags", this->d_flags);
+            r.fill ("d_distToBdry", this->d_distToBoundary);
+
+            // The flat arrays are the grid; the list representation, if needed, is
+            // materialized on demand
+            this->rects.clear();
+            this->vrects.clear();
+        }
+
+        /*!
+         * Build the list<Rect> rects representation (and vrects) from the d_* vectors.
+         * This is required after load_snapshot(), which does not create rects up
+         * front. Rect flags, neighbour iterators and distToBoundary are all restored
+         * from the flat arrays. A no-op if rects is already populated.
+         */
+        void materialize_rects()
+        {
+            if (!this->rects.empty() || this->d_x.empty()) { return; }
+
+            unsigned int nrect = this->d_x.size();
+            std::vector<std::list<morph::Rect>::iterator> rectits (nrect);
+            for (unsigned int i = 0; i < nrect; ++i) {
+                this->rects.emplace_back (i, this->d, this->v, this->d_xi[i], this->d_yi[i]);
+                std::list<morph::Rect>::iterator ri = this->rects.end(); --ri;
+                ri->di = i;
+                ri->distToBoundary = this->d_distToBoundary.empty() ? -1.0f : this->d_distToBoundary[i];
+                // Neighbour flags are reinstated by set_ne and friends, below
+                ri->setFlag (this->d_flags[i] & ~static_cast<unsigned int>(RECT_HAS_NEIGHB_ALL));
+                this->vrects.push_back (&(*ri));
+                rectits[i] = ri;
+            }
+            for (unsigned int i = 0; i < nrect; ++i) {
+                std::list<morph::Rect>::iterator ri = rectits[i];
+                if (this->d_ne[i] > -1) { ri->set_ne (rectits[this->d_ne[i]]); }
+                if (this->d_nne[i] > -1) { ri->set_nne (rectits[this->d_nne[i]]); }
+                if (this->d_nn[i] > -1) { ri->set_nn (rectits[this->d_nn[i]]); }
+                if (this->d_nnw[i] > -1) { ri->set_nnw (rectits[this->d_nnw[i]]); }
+                if (this->d_nw[i] > -1) { ri->set_nw (rectits[this->d_nw[i]]); }
+                if (this->d_nsw[i] > -1) { ri->set_nsw (rectits[this->d_nsw[i]]); }
+                if (this->d_ns[i] > -1) { ri->set_ns (rectits[this->d_ns[i]]); }
+                if (this->d_nse[i] > -1) { ri->set_nse (rectits[this->d_nse[i]]); }
+            }
+        }
+
+        //! Materialize rects from the d_ vectors if it is needed, but not yet built
+        void ensure_rects()
+        {
+            if (this->rects.empty() && !this->d_x.empty()) { this->materialize_rects(); }
+        }
+
         //! Default constructor creates symmetric grid centered about 0,0.
         CartGrid(): d(1.0f), v(1.0f), x_span(1.0f), y_span(1.0f), z(0.0f) {}
 
@@ -713,6 +860,7 @@ namespace morph {
          */
         void setBoundary (const std::list<Rect>& pRects)
         {
+            this->ensure_rects();
             this->boundaryCentroid = this->computeCentroid (pRects);
 
             std::list<morph::Rect>::iterator bpoint = this->rects.begin();
@@ -800,6 +948,7 @@ namespace morph {
          */
         void setBoundary (std::vector<BezCoord<float>>& bpoints, bool loffset = true)
         {
+            this->ensure_rects();
             this->boundaryCentroid = morph::BezCurvePath<float>::getCentroid (bpoints);
 
             auto bpi = bpoints.begin();
@@ -1145,7 +1294,11 @@ namespace morph {
          *
          * return The number of rects in the grid.
          */
-        unsigned int num() const { return this->rects.size(); }
+        unsigned int num() const
+        {
+            // After load_snapshot(), rects may be empty while the d_ vectors hold the grid
+            return this->rects.empty() ? static_cast<unsigned int>(this->d_x.size()) : this->rects.size();
+        }
 
         /*!
          * \brief Obtain the vector index of the last Rect in rects.
@@ -1523,6 +1676,7 @@ namespace morph {
         template<typename T>
         void oncentre_offsurround (const std::vector<T>& data, std::vector<T>& result)
         {
+            this->ensure_rects();
             if (result.size() != this->rects.size()) {
                 throw std::runtime_error ("The result vector is not the same size as the CartGrid.");
             }
@@ -1554,6 +1708,7 @@ namespace morph {
         template<typename T, bool onlysum=false>
         void boxfilter (const std::vector<T>& data, std::vector<T>& result, unsigned int boxside)
         {
+            this->ensure_rects();
             if (result.size() != this->rects.size()) {
                 throw std::runtime_error ("The result vector is not the same size as the CartGrid.");
             }
@@ -1651,6 +1806,41 @@ namespace morph {
             morph::MathAlgo::boxfilter_2d<T, boxside, onlysum> (data, result, this->w_px);
         }
 
+        /*!
+         * Apply the 5-point stencil function \a fn to \a data, writing into \a
+         * result. The function is called as fn (centre, east, west, north, south) for
+         * each element. This iterates the flat d_ne/d_nw/d_nn/d_ns neighbour index
+         * arrays rather than traversing the std::list<Rect> via pointers, so the inner
+         * loop is cache-friendly and parallelises well. Where a neighbour is absent
+         * (d_n* == -1) the centre value is passed in its place, giving zero-gradient
+         * behaviour at the grid edge. Requires that the d_ vectors have been populated
+         * (setBoundary/setBoundaryOnOuterEdge do this).
+         */
+        template<typename Ctnr, typename Func>
+        void stencil_apply (const Ctnr& data, Ctnr& result, Func fn) const
+        {
+            int nrect = static_cast<int>(this->d_x.size());
+            if (nrect == 0) {
+                throw std::runtime_error ("stencil_apply: The d_ vectors have not been populated (call setBoundary first).");
+            }
+            if (static_cast<int>(data.size()) != nrect || static_cast<int>(result.size()) != nrect) {
+                throw std::runtime_error ("stencil_apply: data and result vectors must be the same size as the CartGrid.");
+            }
+            if (&data == &result) {
+                throw std::runtime_error ("stencil_apply: Pass in separate memory for the result.");
+            }
+#pragma omp parallel for
+            for (int i = 0; i < nrect; ++i) {
+                const int e = this->d_ne[i];
+                const int w = this->d_nw[i];
+                const int n = this->d_nn[i];
+                const int s = this->d_ns[i];
+                result[i] = fn (data[i],
+                                e >= 0 ? data[e] : data[i], w >= 0 ? data[w] : data[i],
+                                n >= 0 ? data[n] : data[i], s >= 0 ? data[s] : data[i]);
+            }
+        }
+
         /*!
          * Using this CartGrid as the domain, convolve the domain data \a data with the
          * kernel data \a kerneldata, which exists on another CartGrid, \a
@@ -2651,10 +2841,221 @@ namespace morph {
          */
         bool gridReduced = false;
 
+        //! Content tag identifying a morph::snapshot file written by save_snapshot()
+        static constexpr std::uint32_t cg_snapshot_tag = morph::crc32 ("CartGrid");
+        //! Version of the save_snapshot() section layout
+        static constexpr std::uint32_t cg_snapshot_version = 1;
+
     public:
         // Min/max x and y to record size of domain. Populate during init.
         morph::range<float> x_minmax;
         morph::range<float> y_minmax;
     };
 
+    //! How cartconv_plan treats kernel taps that fall outside the domain in a
+    //! non-wrapped direction: contribute nothing (zero padding, which matches
+    //! CartGrid::convolve) or re-read the nearest edge cell (zero-gradient clamp,
+    //! which matches CartGrid::stencil_apply).
+    enum class cartconv_boundary
+    {
+        zero,
+        clamp
+    };
+
+    /*!
+     * \brief A precomputed convolution plan for rectangular CartGrid data
+     *
+     * CartGrid::convolve walks neighbour pointers from every rect to every kernel
+     * rect on every call, and any index-based rewrite still needs a per-tap
+     * out-of-bounds branch in the inner loop. For a rectangular CartGrid this plan
+     * splits the work instead: interior cells - those whose whole kernel footprint is
+     * inside the domain - are processed with a branch-free multiply-accumulate over
+     * precomputed linear offsets (OpenMP parallel across rows, simd across taps), and
+     * the remaining edge rows/columns are handled in separate loops which apply the
+     * boundary condition: wrapping in directions the CartGrid's GridDomainWrap wraps,
+     * and \a bmode (zero padding or zero-gradient clamp) in the others.
+     *
+     * The plan depends only on the geometry of the two grids, so one plan serves any
+     * number of apply() calls. The domain CartGrid must be a full rectangle (the
+     * default GridDomainShape::Rectangle with the boundary on the outer edge; not a
+     * grid reduced to a curved boundary) and, as for CartGrid::convolve, the kernel
+     * grid must share the domain's element spacing.
+     */
+    struct cartconv_plan
+    {
+        cartconv_plan (const CartGrid& domain, const CartGrid& kernelgrid,
+                       const cartconv_boundary bmode = cartconv_boundary::zero)
+            : boundary_mode (bmode)
+        {
+            if (kernelgrid.getd() != domain.getd() || kernelgrid.getv() != domain.getv()) {
+                throw std::runtime_error ("cartconv_plan: kernel CartGrid must have the same d and v as the domain CartGrid.");
+            }
+
+            // Establish the domain's integer extent from the rect xi/yi indices and
+            // check it is a full, raster-ordered rectangle
+            morph::range<int> xr;
+            morph::range<int> yr;
+            xr.search_init();
+            yr.search_init();
+            for (const morph::Rect& r : domain.rects) {
+                xr.update (r.xi);
+                yr.update (r.yi);
+            }
+            this->w = 1 + xr.max - xr.min;
+            this->h = 1 + yr.max - yr.min;
+            this->n = domain.num();
+            if (static_cast<unsigned int>(this->w) * static_cast<unsigned int>(this->h) != this->n) {
+                throw std::runtime_error ("cartconv_plan: the domain CartGrid is not a full rectangle.");
+            }
+            for (const morph::Rect& r : domain.rects) {
+                unsigned int raster = static_cast<unsigned int>(r.yi - yr.min) * this->w + (r.xi - xr.min);
+                if (raster != r.vi) {
+                    throw std::runtime_error ("cartconv_plan: the domain CartGrid is not raster-ordered.");
+                }
+            }
+
+            this->wrap_x = (domain.domainWrap == GridDomainWrap::Horizontal || domain.domainWrap == GridDomainWrap::Both);
+            this->wrap_y = (domain.domainWrap == GridDomainWrap::Vertical || domain.domainWrap == GridDomainWrap::Both);
+
+            // The kernel taps: x/y offsets in elements, linear offset for the interior
+            // loop, and the index of each tap's value in kerneldata
+            this->k = kernelgrid.num();
+            this->kdx.resize (this->k);
+            this->kdy.resize (this->k);
+            this->koff.resize (this->k);
+            this->kvi.resize (this->k);
+            unsigned int kk = 0;
+            for (const morph::Rect& kr : kernelgrid.rects) {
+                this->kdx[kk] = kr.xi;
+                this->kdy[kk] = kr.yi;
+                this->koff[kk] = kr.yi * this->w + kr.xi;
+                this->kvi[kk] = kr.vi;
+                // Track the kernel's reach in each direction to size the edge bands
+                this->reach_w = std::max (this->reach_w, -kr.xi);
+                this->reach_e = std::max (this->reach_e, kr.xi);
+                this->reach_s = std::max (this->reach_s, -kr.yi);
+                this->reach_n = std::max (this->reach_n, kr.yi);
+                ++kk;
+            }
+        }
+
+        /*!
+         * Convolve \a data with \a kerneldata, writing into \a result. Sizes must
+         * match the plan (kerneldata: kernel grid size; data/result: domain grid
+         * size).
+         */
+        template<typename T>
+        void apply (std::span<const T> kerneldata, std::span<const T> data, std::span<T> result) const
+        {
+            if (result.size() != this->n || data.size() != this->n) {
+                throw std::runtime_error ("cartconv_plan::apply: data/result size does not match the domain grid.");
+            }
+            if (kerneldata.size() != this->k) {
+                throw std::runtime_error ("cartconv_plan::apply: kerneldata size does not match the kernel grid.");
+            }
+            if (data.data() == result.data()) {
+                throw std::runtime_error ("cartconv_plan::apply: Pass in separate memory for the result.");
+            }
+
+            // Gather the kernel into plan order once, so the inner loops read it sequentially
+            std::vector<T> kord (this->k);
+            for (unsigned int kk = 0; kk < this->k; ++kk) { kord[kk] = kerneldata[this->kvi[kk]]; }
+
+            // The interior: cells whose whole kernel footprint is inside the domain.
+            // In a wrapped direction every cell counts as interior-able, but the
+            // linear offset can't express the wrap, so wrapped cells near the edge go
+            // to the edge loops too.
+            const int x0 = this->reach_w;
+            const int x1 = this->w - this->reach_e; // exclusive
+            const int y0 = this->reach_s;
+            const int y1 = this->h - this->reach_n; // exclusive
+            const int kn = static_cast<int>(this->k);
+            const T* dp = data.data();
+            const T* kp = kord.data();
+            const int* op = this->koff.data();
+#pragma omp parallel for schedule(static)
+            for (int y = y0; y < y1; ++y) {
+                const int rowbase = y * this->w;
+                for (int x = x0; x < x1; ++x) {
+                    const T* cell = dp + rowbase + x;
+                    T sum = T{0};
+#pragma omp simd reduction(+:sum)
+                    for (int j = 0; j < kn; ++j) { sum += cell[op[j]] * kp[j]; }
+                    result[rowbase + x] = sum;
+                }
+            }
+
+            // The edge bands: top and bottom rows, then the left/right columns of the
+            // interior rows
+            const int lx = std::min (x0, this->w);       // left band end
+            const int rx = std::max (x1, lx);            // right band start
+            for (int y = 0; y < this->h; ++y) {
+                if (y >= y0 && y < y1) {
+                    for (int x = 0; x < lx; ++x) { result[y * this->w + x] = this->edge_cell (dp, kp, x, y); }
+                    for (int x = rx; x < this->w; ++x) { result[y * this->w + x] = this->edge_cell (dp, kp, x, y); }
+                } else {
+                    for (int x = 0; x < this->w; ++x) { result[y * this->w + x] = this->edge_cell (dp, kp, x, y); }
+                }
+            }
+        }
+
+        //! The boundary treatment for non-wrapped directions
+        cartconv_boundary boundary_mode = cartconv_boundary::zero;
+
+    private:
+        //! Convolve a single cell at (\a x, \a y), applying wrap/clamp/zero treatment
+        //! to each kernel tap as it is processed
+        template<typename T>
+        T edge_cell (const T* dp, const T* kp, const int x, const int y) const
+        {
+            T sum = T{0};
+            for (unsigned int j = 0; j < this->k; ++j) {
+                int sx = x + this->kdx[j];
+                int sy = y + this->kdy[j];
+                if (sx < 0 || sx >= this->w) {
+                    if (this->wrap_x) {
+                        sx -= this->w * static_cast<int>(std::floor (static_cast<float>(sx) / this->w));
+                    } else if (this->boundary_mode == cartconv_boundary::clamp) {
+                        sx = sx < 0 ? 0 : this->w - 1;
+                    } else {
+                        continue; // zero padding: no contribution
+                    }
+                }
+                if (sy < 0 || sy >= this->h) {
+                    if (this->wrap_y) {
+                        sy -= this->h * static_cast<int>(std::floor (static_cast<float>(sy) / this->h));
+                    } else if (this->boundary_mode == cartconv_boundary::clamp) {
+                        sy = sy < 0 ? 0 : this->h - 1;
+                    } else {
+                        continue;
+                    }
+                }
+                sum += dp[sy * this->w + sx] * kp[j];
+            }
+            return sum;
+        }
+
+        //! Domain width/height in elements and total cell count
+        int w = 0;
+        int h = 0;
+        unsigned int n = 0u;
+        //! Whether the domain wraps horizontally/vertically (from its GridDomainWrap)
+        bool wrap_x = false;
+        bool wrap_y = false;
+        //! The number of kernel taps
+        unsigned int k = 0u;
+        //! Per-tap x and y offsets in elements
+        std::vector<int> kdx;
+        std::vector<int> kdy;
+        //! Per-tap linear offsets (kdy * w + kdx) for the interior loop
+        std::vector<int> koff;
+        //! The index of each tap's value within kerneldata
+        std::vector<unsigned int> kvi;
+        //! How far the kernel reaches west/east/south/north of its centre, in elements
+        int reach_w = 0;
+        int reach_e = 0;
+        int reach_s = 0;
+        int reach_n = 0;
+    };
+
 } // namespace morph
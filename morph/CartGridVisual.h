@@ -9,6 +9,8 @@
 #include <iostream>
 #include <vector>
 #include <array>
+#include <algorithm>
+#include <cmath>
 
 #define R_NE(hi) (this->cg->d_ne[hi])
 #define R_HAS_NE(hi) (this->cg->d_ne[hi] == -1 ? false : true)
@@ -64,6 +66,133 @@ namespace morph {
             // Note: VisualModel::finalize() should be called before rendering
         }
 
+        //! Predict the build's vertex count so that finalize()/reinit() can reserve the
+        //! vertex containers once. Triangles mode generates one vertex per rect;
+        //! RectInterp generates 5 (a centre and four corners).
+        std::size_t predict_vertex_count() const override
+        {
+            std::size_t nrect = this->cg == nullptr ? 0 : this->cg->num();
+            return this->cartVisMode == CartVisMode::Triangles ? nrect : 5u * nrect;
+        }
+
+        //! Assign per-vertex element ids for the picking pass (see VisualBase::pick).
+        //! Each rect's vertices take the rect's d_ index; any vertices beyond the data
+        //! region carry no id and pick as element -1.
+        void fillPickIDs() override
+        {
+            std::size_t vpr = this->cartVisMode == CartVisMode::Triangles ? 1u : 5u;
+            std::size_t n_data_verts = (this->cg == nullptr ? 0u : this->cg->num()) * vpr;
+            std::size_t nverts = this->vertexPositions.size() / 3u;
+            if (n_data_verts == 0u || n_data_verts > nverts) { this->pickIDs.clear(); return; }
+            this->pickIDs.assign (nverts, this->pick_id_none);
+            for (std::size_t v = 0; v < n_data_verts; ++v) {
+                this->pickIDs[v] = static_cast<float>(v / vpr);
+            }
+        }
+
+        //! The d_ indices of rects whose data has changed since the last updateData. See markRectDirty.
+        std::vector<unsigned int> dirtyRects;
+
+        //! Mark the rect with d_ index \a ri as having changed data. If any rects have been
+        //! marked dirty when updateData is next called, only their sub-ranges of the
+        //! position/colour buffers are recomputed and re-uploaded (glBufferSubData), rather
+        //! than the whole lot. A win when a small fraction of the field changes per frame.
+        void markRectDirty (unsigned int ri) { this->dirtyRects.push_back (ri); }
+
+        //! Override the updateData method to take the incremental path when rects have
+        //! been marked dirty with markRectDirty(). That path is only possible in
+        //! Triangles mode (one vertex per rect) and once a full build has been done (so
+        //! that autoscaling has run and the vertex containers are populated).
+        void updateData (const std::vector<T>* _data) override
+        {
+            this->scalarData = _data;
+            this->refresh();
+        }
+
+        //! Re-read the currently bound/set scalar data and update the model. Called by
+        //! updateData, and directly by client code which has mutated memory bound with
+        //! bindScalarData().
+        void refresh() override
+        {
+            if (!this->dirtyRects.empty()) {
+                if (this->cartVisMode == CartVisMode::Triangles
+                    && this->dcopy.size() == this->cg->num()
+                    && this->vertexColors.size() >= 3u * this->cg->num()) {
+                    this->updateDirtyRects();
+                    return;
+                }
+                this->dirtyRects.clear(); // Can't update incrementally; fall through to a full update
+            }
+            VisualDataModel<T, glver>::reinit();
+        }
+
+        /*!
+         * Update only the colours of the model from \a _data. The vertex positions and
+         * indices are left alone, so this works in both CartVisModes (one vertex per rect
+         * in Triangles mode; five in RectInterp mode) and re-uploads only the colour VBO
+         * (reinit_colour_buffer). Scaling is NOT re-autoscaled; colours remain comparable
+         * with those from the last full build. Falls back to a full updateData if no full
+         * build has yet been done.
+         */
+        void updateColours (const std::vector<T>* _data) override
+        {
+            unsigned int nrect = this->cg->num();
+            unsigned int vtx_per_rect = this->cartVisMode == CartVisMode::Triangles ? 1u : 5u;
+            if (this->dcolour.size() != nrect || this->vertexColors.size() < 3u * vtx_per_rect * nrect) {
+                this->updateData (_data); // No full build yet
+                return;
+            }
+            this->scalarData = _data;
+            std::span<const T> sdata = this->scalarDataSpan();
+            for (unsigned int ri = 0; ri < nrect; ++ri) {
+                this->dcolour[ri] = this->colourScale.transform_one (sdata[ri]);
+                std::array<float, 3> clr = this->setColour (ri);
+                for (unsigned int v = 0; v < vtx_per_rect; ++v) {
+                    unsigned int b = 3u * (ri * vtx_per_rect + v);
+                    this->vertexColors[b] = clr[0];
+                    this->vertexColors[b + 1] = clr[1];
+                    this->vertexColors[b + 2] = clr[2];
+                }
+            }
+            this->reinit_colour_buffer();
+        }
+
+        /*!
+         * The incremental update path. For each rect marked with markRectDirty(), recompute
+         * the scaled z position and colour from the current scalarData and poke them into
+         * vertexPositions/vertexColors, then upload just the contiguous runs of dirty rects
+         * with glBufferSubData (via reinit_buffers_region).
+         */
+        void updateDirtyRects()
+        {
+            std::span<const T> sdata = this->scalarDataSpan();
+            for (unsigned int ri : this->dirtyRects) {
+                if (ri >= this->dcopy.size() || ri >= sdata.size()) { continue; }
+                float zval = this->zScale.transform_one (sdata[ri]);
+                if (std::isnan (zval)) { zval = this->zScale.transform_one (T{0}); }
+                this->dcopy[ri] = zval;
+                this->dcolour[ri] = this->colourScale.transform_one (sdata[ri]);
+                this->vertexPositions[ri * 3 + 2] = this->dcopy[ri];
+                std::array<float, 3> clr = this->setColour (ri);
+                this->vertexColors[ri * 3] = clr[0];
+                this->vertexColors[ri * 3 + 1] = clr[1];
+                this->vertexColors[ri * 3 + 2] = clr[2];
+            }
+            // Coalesce the dirty indices into contiguous runs; one glBufferSubData per run
+            std::sort (this->dirtyRects.begin(), this->dirtyRects.end());
+            unsigned int run_start = this->dirtyRects[0];
+            unsigned int run_end = run_start;
+            for (std::size_t i = 1; i < this->dirtyRects.size(); ++i) {
+                unsigned int ri = this->dirtyRects[i];
+                if (ri <= run_end + 1) { run_end = std::max (run_end, ri); continue; }
+                this->reinit_buffers_region (run_start, run_end - run_start + 1);
+                run_start = ri;
+                run_end = ri;
+            }
+            this->reinit_buffers_region (run_start, run_end - run_start + 1);
+            this->dirtyRects.clear();
+        }
+
         //! Do the computations to initialize the vertices that will represent the HexGrid.
         void initializeVertices()
         {
@@ -118,11 +247,12 @@ namespace morph {
             this->idx = 0;
             unsigned int nrect = this->cg->num();
 
-            if (this->scalarData != nullptr) {
-                this->dcopy.resize (this->scalarData->size());
-                this->zScale.transform (*(this->scalarData), dcopy);
-                this->dcolour.resize (this->scalarData->size());
-                this->colourScale.transform (*(this->scalarData), dcolour);
+            std::span<const T> sdata = this->scalarDataSpan();
+            if (sdata.empty() == false) {
+                this->dcopy.resize (sdata.size());
+                this->zScale.transform (sdata.data(), dcopy.data(), sdata.size());
+                this->dcolour.resize (sdata.size());
+                this->colourScale.transform (sdata.data(), dcolour.data(), sdata.size());
             } else if (this->vectorData != nullptr) {
                 this->dcopy.resize (this->vectorData->size());
                 this->dcolour.resize (this->vectorData->size());
@@ -186,11 +316,12 @@ namespace morph {
             unsigned int nrect = this->cg->num();
             this->idx = 0;
 
-            if (this->scalarData != nullptr) {
-                this->dcopy.resize (this->scalarData->size());
-                this->zScale.transform (*(this->scalarData), dcopy);
-                this->dcolour.resize (this->scalarData->size());
-                this->colourScale.transform (*(this->scalarData), dcolour);
+            std::span<const T> sdata = this->scalarDataSpan();
+            if (sdata.empty() == false) {
+                this->dcopy.resize (sdata.size());
+                this->zScale.transform (sdata.data(), dcopy.data(), sdata.size());
+                this->dcolour.resize (sdata.size());
+                this->colourScale.transform (sdata.data(), dcolour.data(), sdata.size());
             } else if (this->vectorData != nullptr) {
                 this->dcopy.resize (this->vectorData->size());
                 this->dcolour.resize (this->vectorData->size());
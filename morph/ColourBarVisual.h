@@ -75,7 +75,9 @@ namespace morph {
             this->drawTicks();
             this->drawTickLabels();
             this->drawAxisLabel();
-            this->fillFrameWithColour();
+            // When the gradient is drawn on the GPU (see TexturedColourBarVisual) only
+            // the frame, tick and label geometry goes into the vertex buffers
+            if (this->gradient_on_gpu == false) { this->fillFrameWithColour(); }
         }
 
         //! Based on axis scaling, compute tick positions
@@ -385,6 +387,12 @@ namespace morph {
         std::string label = "";
         //! The number of segments to make in the colourmap
         unsigned int numsegs = 256;
+        /*!
+         * When true, fillFrameWithColour is not called and a subclass paints the
+         * gradient as a single quad which samples the ColourMap's look-up-table
+         * texture in a fragment shader. See morph::TexturedColourBarVisual.
+         */
+        bool gradient_on_gpu = false;
     protected:
         //! tick label height
         float ticklabelheight = 0.0f;
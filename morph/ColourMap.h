@@ -9,6 +9,8 @@
 #include <stdexcept>
 #include <cmath>
 #include <cstdint>
+#include <vector>
+#include <array>
 #include <morph/tools.h>
 #include <morph/vec.h>
 #include <morph/mathconst.h>
@@ -531,6 +533,8 @@ namespace morph {
     private:
         //! Type of map
         ColourMapType type = ColourMapType::Plasma;
+        //! When non-empty, the scalar convert() indexes this look-up table (see enableLut)
+        std::vector<std::array<float, 3>> lut;
         //! The hue (range 0 to 1.0f) as used in HSV colour values for Monochrome maps.
         float hue = 0.0f;
         //! The saturation
@@ -1857,13 +1861,13 @@ namespace morph {
             return ColourMap<T>::hsv2rgb (hsv);
         }
 
-        //! Convert the scalar datum into an RGB (or BGR) colour
-        std::array<float, 3> convert (T _datum) const
+        //! Convert T \a _datum into a float in the range [0,1] (with a suitable scaling as
+        //! necessary - range_max applies for integral T) ready for the colour conversion. NaN
+        //! float/double data passes through as NaN.
+        float normalize_datum (const T _datum) const
         {
             float datum = 0.0f;
 
-            // Convert T into a suitable value (with a suitable scaling as necessary) to
-            // make the conversion to array<float,3> colour.
             if constexpr (std::is_same<std::decay_t<T>, double>::value == true) {
                 // Copy, enforce range
                 datum = _datum > T{1} ? 1.0f : static_cast<float>(_datum);
@@ -1885,14 +1889,127 @@ namespace morph {
             } else {
                 throw std::runtime_error ("Unhandled ColourMap data type.");
             }
+            return datum;
+        }
 
-            std::array<float, 3> c = {0.0f, 0.0f, 0.0f};
+        //! Convert the scalar datum into an RGB (or BGR) colour
+        std::array<float, 3> convert (T _datum) const
+        {
+            // Convert T into a suitable value (with a suitable scaling as necessary) to
+            // make the conversion to array<float,3> colour.
+            float datum = this->normalize_datum (_datum);
 
             // Check for nan and return a 'nan' colour for the colour map
             if constexpr (std::is_same<std::decay_t<T>, double>::value == true
                           || std::is_same<std::decay_t<T>, float>::value == true) {
-                if (std::isnan(datum) == true) { c = ColourMap<T>::nanColour(this->type); return c; }
+                if (std::isnan(datum) == true) { return ColourMap<T>::nanColour(this->type); }
+            }
+
+            if (this->lut.empty() == false) {
+                // LUT-accelerated path; a single table index per datum (see enableLut)
+                std::size_t li = static_cast<std::size_t>(std::round (datum * static_cast<float>(this->lut.size() - 1)));
+                return this->lut[li];
+            }
+
+            return this->convert_core (datum);
+        }
+
+        /*!
+         * Sample the scalar colour map evenly into a look-up table of \a n RGB entries, with
+         * lut[0] the colour for datum 0 and lut[n-1] the colour for datum 1. The table is suitable
+         * for uploading as a 1D GL texture for colour mapping in a shader (as TexturedGridVisual
+         * does) or for fast repeated CPU mapping via enableLut().
+         */
+        std::vector<std::array<float, 3>> makeLut (const unsigned int n = 256) const
+        {
+            std::vector<std::array<float, 3>> l (n < 2u ? 2u : n);
+            for (std::size_t i = 0; i < l.size(); ++i) {
+                l[i] = this->convert_core (static_cast<float>(i) / static_cast<float>(l.size() - 1));
+            }
+            return l;
+        }
+
+        /*!
+         * Make the scalar convert() index a precomputed look-up table of \a n entries instead of
+         * running the colour map computation for every datum. For the table-interpolating and
+         * computed maps this turns per-element colour updates (GridVisual::reinitColours on every
+         * updateData, for example) into a single table index per element, at the cost of
+         * quantizing the map to n levels. Call enableLut() again after changing the map's type,
+         * hue or similar; it re-samples the map as currently configured.
+         */
+        void enableLut (const unsigned int n = 256)
+        {
+            this->lut.clear(); // so that makeLut samples the map, not a previous lut
+            this->lut = this->makeLut (n);
+        }
+
+        //! Revert the scalar convert() to computing colours directly from the map
+        void disableLut() { this->lut.clear(); }
+
+        /*!
+         * Convert the \a n scalar data at \a in into RGB triplets written to \a rgb_out, which
+         * must have room for 3n floats. Equivalent to n calls of the scalar convert(), but the
+         * colour map dispatch is hoisted out of the loop: the map is sampled once into a
+         * look-up table (the table installed with enableLut() is reused if present), after
+         * which each element costs one normalization and one table index. NaN elements get the
+         * map's nanColour.
+         */
+        void convert_array (const T* in, float* rgb_out, const std::size_t n) const
+        {
+            std::vector<std::array<float, 3>> sampled;
+            if (this->lut.empty() == true) { sampled = this->makeLut(); }
+            const std::vector<std::array<float, 3>>& tbl = this->lut.empty() ? sampled : this->lut;
+            const float tmax = static_cast<float>(tbl.size() - 1);
+            for (std::size_t i = 0; i < n; ++i) {
+                float datum = this->normalize_datum (in[i]);
+                if constexpr (std::is_same<std::decay_t<T>, double>::value == true
+                              || std::is_same<std::decay_t<T>, float>::value == true) {
+                    if (std::isnan (datum) == true) {
+                        std::array<float, 3> nc = ColourMap<T>::nanColour (this->type);
+                        rgb_out[3u * i] = nc[0];
+                        rgb_out[3u * i + 1u] = nc[1];
+                        rgb_out[3u * i + 2u] = nc[2];
+                        continue;
+                    }
+                }
+                const std::array<float, 3>& c = tbl[static_cast<std::size_t>(std::round (datum * tmax))];
+                rgb_out[3u * i] = c[0];
+                rgb_out[3u * i + 1u] = c[1];
+                rgb_out[3u * i + 2u] = c[2];
+            }
+        }
+
+        //! Parallel (OpenMP) version of convert_array() for large arrays
+        void convert_array_par (const T* in, float* rgb_out, const std::size_t n) const
+        {
+            std::vector<std::array<float, 3>> sampled;
+            if (this->lut.empty() == true) { sampled = this->makeLut(); }
+            const std::vector<std::array<float, 3>>& tbl = this->lut.empty() ? sampled : this->lut;
+            const float tmax = static_cast<float>(tbl.size() - 1);
+#pragma omp parallel for
+            for (std::size_t i = 0; i < n; ++i) {
+                float datum = this->normalize_datum (in[i]);
+                if constexpr (std::is_same<std::decay_t<T>, double>::value == true
+                              || std::is_same<std::decay_t<T>, float>::value == true) {
+                    if (std::isnan (datum) == true) {
+                        std::array<float, 3> nc = ColourMap<T>::nanColour (this->type);
+                        rgb_out[3u * i] = nc[0];
+                        rgb_out[3u * i + 1u] = nc[1];
+                        rgb_out[3u * i + 2u] = nc[2];
+                        continue;
+                    }
+                }
+                const std::array<float, 3>& c = tbl[static_cast<std::size_t>(std::round (datum * tmax))];
+                rgb_out[3u * i] = c[0];
+                rgb_out[3u * i + 1u] = c[1];
+                rgb_out[3u * i + 2u] = c[2];
             }
+        }
+
+        //! The scalar colour conversion. \a datum must already be normalized into the range [0,1].
+        std::array<float, 3> convert_core (const float datum) const
+        {
+            std::array<float, 3> c = {0.0f, 0.0f, 0.0f};
 
             switch (this->type) {
             case ColourMapType::Jet:
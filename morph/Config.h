@@ -13,16 +13,28 @@
 #include <morph/vvec.h>
 #include <morph/vec.h>
 #include <list>
+#include <vector>
 #include <fstream>
 #include <sstream>
 #include <string>
 #include <iostream>
 #include <stdexcept>
+#include <cstdint>
 #ifndef _MSC_VER
 # include <morph/Process.h>
 #endif
 
 namespace morph {
+
+    //! On-disk formats understood by morph::Config. The binary formats parse much faster than
+    //! text JSON, which matters when many short jobs each read a large, shared config.
+    enum class ConfigFormat
+    {
+        json,    // Text JSON (the default)
+        cbor,    // Binary CBOR; chosen for files ending '.cbor'
+        msgpack  // Binary MessagePack; chosen for files ending '.msgpack' or '.mpk'
+    };
+
 #ifndef _MSC_VER
     //! Callbacks class extends ProcessCallbacks
     class ConfigProcessCallbacks : public ProcessCallbacks
@@ -54,28 +66,73 @@ namespace morph {
         //! Default constructor, when config should be a class member. Call init() before use.
         Config(){}
 
-        //! Constructor which takes the path to the file that contains the JSON.
+        //! Constructor which takes the path to the file that contains the JSON (or, going by
+        //! the file extension, binary CBOR/MessagePack).
         Config (const std::string& configfile) { this->init (configfile); }
 
+        //! Constructor with a lazy-parsing option; see init (configfile, lazy_parse).
+        Config (const std::string& configfile, const bool lazy_parse) { this->init (configfile, lazy_parse); }
+
         //! Perform config file initialization.
-        void init (const std::string& configfile)
+        void init (const std::string& configfile) { this->init (configfile, false); }
+
+        /*!
+         * Perform config file initialization. The on-disk format is deduced from the extension
+         * of \a configfile (see morph::ConfigFormat). If \a lazy_parse is true, init() only
+         * slurps the file's bytes; the parse is deferred until the first access of the content
+         * (a getter, setter, write() or str()). A job which reads just a parameter or two (or
+         * none at all) then avoids paying the full parse cost up front.
+         */
+        void init (const std::string& configfile, const bool lazy_parse)
         {
             this->thefile = configfile;
-            std::stringstream ess;
-            // Test for existence of the JSON file.
-            std::ifstream jsonfile_test;
-            jsonfile_test.open (configfile, std::ios::in);
-            if (jsonfile_test.is_open()) {
-                // File exists, should parse it
-                jsonfile_test.close();
-                // Parse the JSON
-                std::ifstream jsonfile (configfile, std::ifstream::binary);
-                jsonfile >> this->root;
-                // JSON is open and parsed
+            this->format = Config::formatForPath (configfile);
+            // Test for existence of the config file.
+            std::ifstream cfile (configfile, std::ifstream::binary);
+            if (cfile.is_open()) {
+                // File exists; slurp its bytes, then parse now or on first access
+                std::stringstream ss;
+                ss << cfile.rdbuf();
+                this->raw = ss.str();
+                this->parse_pending = true;
+                if (lazy_parse == false) { this->ensure_parsed(); }
+                // Config is open (and, unless lazy, parsed)
                 this->ready = true;
             } // else We are creating a new Config, with no pre-existing content
         }
 
+        //! Return the ConfigFormat implied by the extension of \a path
+        static ConfigFormat formatForPath (const std::string& path)
+        {
+            ConfigFormat cf = ConfigFormat::json;
+            auto endswith = [&path] (const std::string& ending) {
+                return path.size() >= ending.size()
+                       && path.compare (path.size() - ending.size(), ending.size(), ending) == 0;
+            };
+            if (endswith (".cbor")) {
+                cf = ConfigFormat::cbor;
+            } else if (endswith (".msgpack") || endswith (".mpk")) {
+                cf = ConfigFormat::msgpack;
+            }
+            return cf;
+        }
+
+        /*!
+         * Convert the config file \a infile into \a outfile, with the format of each deduced
+         * from its extension. Intended for preparing a binary copy of a large, text JSON
+         * config, which each job of a parameter sweep can then load quickly:
+         *   morph::Config::convert ("params.json", "params.cbor");
+         */
+        static void convert (const std::string& infile, const std::string& outfile)
+        {
+            Config c (infile);
+            if (c.ready == false) {
+                throw std::runtime_error ("Config::convert: Failed to read '" + infile + "'");
+            }
+            c.write (outfile);
+            if (c.emsg.empty() == false) { throw std::runtime_error ("Config::convert: " + c.emsg); }
+        }
+
 #ifndef _MSC_VER
         /*!
          * Launch git sub-processes to determine info about the current
@@ -88,6 +145,7 @@ namespace morph {
          */
         void insertGitInfo (const std::string& codedir)
         {
+            this->ensure_parsed();
             ProcessData pD;
             ConfigProcessCallbacks cb(&pD);
             Process p;
@@ -219,11 +277,13 @@ namespace morph {
 
         void write() { this->write (this->thefile); }
 
-        //! Write out the JSON to a different file.
+        //! Write out the config to a different file; text JSON or binary, deduced from the
+        //! extension of \a outfile.
         void write (const std::string& outfile)
         {
+            this->ensure_parsed();
             std::ofstream configout;
-            configout.open (outfile.c_str(), std::ios::out|std::ios::trunc);
+            configout.open (outfile.c_str(), std::ios::out|std::ios::trunc|std::ios::binary);
             if (configout.is_open()) {
                 // Make a copy of root
                 nlohmann::json combined = this->root;
@@ -232,8 +292,17 @@ namespace morph {
                     nlohmann::json co(this->config_overrides);
                     combined["config_overrides"] = co;
                 }
-                // Write out.
-                configout << std::setw(4) << combined << std::endl;
+                // Write out in the format implied by outfile's extension
+                ConfigFormat of = Config::formatForPath (outfile);
+                if (of == ConfigFormat::cbor) {
+                    std::vector<std::uint8_t> buf = nlohmann::json::to_cbor (combined);
+                    configout.write (reinterpret_cast<const char*>(buf.data()), buf.size());
+                } else if (of == ConfigFormat::msgpack) {
+                    std::vector<std::uint8_t> buf = nlohmann::json::to_msgpack (combined);
+                    configout.write (reinterpret_cast<const char*>(buf.data()), buf.size());
+                } else {
+                    configout << std::setw(4) << combined << std::endl;
+                }
                 configout.close();
             } else {
                 this->emsg = "Failed to open file '" + outfile + "' for writing";
@@ -243,6 +312,7 @@ namespace morph {
         //! Output the config as a string of text
         std::string str() const
         {
+            this->ensure_parsed();
             std::stringstream ss;
             if (!config_overrides.empty()) {
                 nlohmann::json combined = this->root;
@@ -323,12 +393,14 @@ namespace morph {
                 return rtn;
 
             } else {
+                this->ensure_parsed();
                 return this->root.contains(thing) ? this->root[thing].get<T>() : defaultval;
             }
         }
         // get as a json object
         nlohmann::json get (const std::string& thingname) const
         {
+            this->ensure_parsed();
             nlohmann::json rtn;
             if (this->root.contains(thingname)) {
                 rtn = this->root[thingname];
@@ -363,6 +435,7 @@ namespace morph {
         // getArray is the same as get()
         nlohmann::json getArray (const std::string& arrayname) const
         {
+            this->ensure_parsed();
             nlohmann::json rtn;
             if (this->root.contains(arrayname)) {
                 rtn = this->root[arrayname];
@@ -373,6 +446,7 @@ namespace morph {
         template <typename T>
         morph::vvec<T> getvvec (const std::string& arrayname) const
         {
+            this->ensure_parsed();
             nlohmann::json ar;
             if (this->root.contains(arrayname)) { ar = this->root[arrayname]; }
             morph::vvec<T> rtn (ar.size(), T{0});
@@ -385,6 +459,7 @@ namespace morph {
         template <typename T, std::size_t N>
         morph::vec<T, N> getvec (const std::string& arrayname) const
         {
+            this->ensure_parsed();
             nlohmann::json ar;
             if (this->root.contains(arrayname)) { ar = this->root[arrayname]; }
             morph::vec<T, N> rtn = {T{0}};
@@ -398,9 +473,28 @@ namespace morph {
 
         // Setters
         template <typename T>
-        void set (const std::string& thing, T value) { this->root[thing] = value; }
+        void set (const std::string& thing, T value) { this->ensure_parsed(); this->root[thing] = value; }
         template <typename T>
-        void setArray (const std::string& thing, const std::vector<T>& values) { this->root[thing] = values; }
+        void setArray (const std::string& thing, const std::vector<T>& values) { this->ensure_parsed(); this->root[thing] = values; }
+
+        /*!
+         * Parse the slurped file content into this->root, if that parse is still
+         * pending. Called by the getters and setters, so client code only needs to call this
+         * itself before accessing this->root directly on a lazily init()ed Config.
+         */
+        void ensure_parsed() const
+        {
+            if (this->parse_pending == false) { return; }
+            this->parse_pending = false;
+            if (this->format == ConfigFormat::cbor) {
+                this->root = nlohmann::json::from_cbor (this->raw);
+            } else if (this->format == ConfigFormat::msgpack) {
+                this->root = nlohmann::json::from_msgpack (this->raw);
+            } else {
+                this->root = nlohmann::json::parse (this->raw);
+            }
+            this->raw.clear();
+        }
 
         //! Set true when json has been initialised (i.e. thefile has been read)
         bool ready = false;
@@ -408,10 +502,21 @@ namespace morph {
         //! Any error message is here.
         std::string emsg = "";
 
-        // The root object which is set up in the constructor
-        nlohmann::json root;
+        //! The root object which is set up in the constructor (call ensure_parsed() before
+        //! direct access if you constructed with lazy_parse == true). mutable, because with
+        //! lazy parsing, the (logically const) getters may have to populate it.
+        mutable nlohmann::json root;
 
         // The file that holds the JSON
         std::string thefile = "";
+
+        //! The on-disk format of thefile, deduced from its extension in init()
+        ConfigFormat format = ConfigFormat::json;
+
+    private:
+        //! The raw bytes of thefile, held until ensure_parsed() runs (lazy parsing)
+        mutable std::string raw = "";
+        //! True after init() has slurped the file but before it has been parsed
+        mutable bool parse_pending = false;
     };
 } // namespace
@@ -40,16 +40,45 @@ namespace morph {
             if (conf == nullptr) { return; }
             if (!conf->ready) { return; }
 
-            morph::vec<float> toffset = {0,0,0};
+            // All the key: value lines go into a single VisualTextModel as one multi-line
+            // block, so the whole readout is one geometry buffer and one draw call, rather
+            // than one of each per entry
+            if (this->setContext != nullptr) { this->setContext (this->parentVis); }
+            auto tmup = this->makeVisualTextModel (this->tfeatures);
+            tmup->line_spacing = this->line_spacing;
+            tmup->setupText (this->makeText(), this->mv_offset, this->tfeatures.colour);
+            this->vtm = tmup.get();
+            this->texts.push_back (std::move (tmup));
+            if (this->releaseContext != nullptr) { this->releaseContext (this->parentVis); }
+        }
 
-            // No op, but add text labels for parameters in the config
+        /*!
+         * Re-read the config values and update the text block. Only those lines whose
+         * values have changed are laid out again (see VisualTextModel::updateText), so
+         * calling this every frame costs little when most values are static. Does nothing
+         * at all if no value has changed.
+         */
+        void updateText()
+        {
+            if (this->vtm == nullptr || conf == nullptr || !conf->ready) { return; }
+            if (this->setContext != nullptr) { this->setContext (this->parentVis); }
+            if (this->vtm->updateText (this->makeText()) == true) {
+                if (this->parentVis != nullptr) { this->parentVis->signal_needs_render(); }
+            }
+            if (this->releaseContext != nullptr) { this->releaseContext (this->parentVis); }
+        }
+
+        //! Build the text block from the config: one "key: value" line per key
+        std::string makeText() const
+        {
+            std::string block;
             for (auto key : this->keys) {
                 // For now get value in float format
                 float value = conf->get<float>(key, 0.0f);
-                std::string lbl = key + std::string(": ") + std::to_string(value);
-                morph::TextGeometry geom = this->addLabel (lbl, toffset, this->tfeatures);
-                toffset[1] -= line_spacing * geom.height();
+                if (!block.empty()) { block += "\n"; }
+                block += key + std::string(": ") + std::to_string(value);
             }
+            return block;
         }
 
         // You must define the things you want to visualize from the Config. You
@@ -62,8 +91,13 @@ namespace morph {
         // How to format the text
         morph::TextFeatures tfeatures;
 
-        // Spacing between lines of output
+        // Spacing between lines of output, in multiples of the height of an 'h' (this is
+        // passed through to the VisualTextModel that renders the block)
         float line_spacing = 1.5f;
+
+    protected:
+        //! The single text model holding the whole block of key: value lines
+        morph::VisualTextModel<glver>* vtm = nullptr;
     };
 
 } // namespace morph
@@ -6,6 +6,8 @@
 #include <morph/scale.h>
 #include <morph/ColourMap.h>
 #include <array>
+#include <vector>
+#include <utility>
 
 namespace morph {
 
@@ -44,6 +46,12 @@ namespace morph {
         //! Initialize vertex buffer objects and vertex array object.
         void initializeVertices()
         {
+            if (!this->lod_iterations.empty()) {
+                // LOD is enabled; start out at the finest level unless setLod was already called
+                if (this->lod_active < 0) { this->lod_active = static_cast<int>(this->lod_iterations.size()) - 1; }
+                this->iterations = this->lod_iterations[this->lod_active];
+            }
+
             this->vertexPositions.clear();
             this->vertexNormals.clear();
             this->vertexColors.clear();
@@ -81,6 +89,64 @@ namespace morph {
             }
         }
 
+        /*!
+         * Switch to level of detail \a level (an index into lod_iterations). The mesh for each
+         * level is tessellated once, on first use, and cached thereafter, so that per-frame LOD
+         * switching costs only a buffer re-upload. Does nothing unless lod_iterations has been
+         * populated (before finalize()) to enable LOD.
+         */
+        void setLod (unsigned int level)
+        {
+            if (this->lod_iterations.empty()) { return; }
+            if (level >= this->lod_iterations.size()) { level = static_cast<unsigned int>(this->lod_iterations.size()) - 1u; }
+            if (this->lod_meshes.empty()) { this->lod_meshes.resize (this->lod_iterations.size()); }
+            if (this->lod_active >= 0 && level == static_cast<unsigned int>(this->lod_active)) { return; }
+
+            // Stash the currently active mesh so that we can return to it without re-tessellating
+            if (this->lod_active >= 0) {
+                lod_mesh& cur = this->lod_meshes[this->lod_active];
+                cur.positions = std::move (this->vertexPositions);
+                cur.normals = std::move (this->vertexNormals);
+                cur.colors = std::move (this->vertexColors);
+                cur.idx = std::move (this->indices);
+                cur.n_verts = this->n_verts;
+                cur.n_faces = this->n_faces;
+                cur.built = true;
+            }
+
+            lod_mesh& next = this->lod_meshes[level];
+            this->lod_active = static_cast<int>(level);
+            if (next.built == true) {
+                this->vertexPositions = std::move (next.positions);
+                this->vertexNormals = std::move (next.normals);
+                this->vertexColors = std::move (next.colors);
+                this->indices = std::move (next.idx);
+                this->n_verts = next.n_verts;
+                this->n_faces = next.n_faces;
+                this->iterations = this->lod_iterations[level];
+                next.built = false;
+            } else {
+                this->initializeVertices(); // tessellates at lod_iterations[lod_active]
+            }
+            this->reinit_buffers();
+        }
+
+        //! Choose a LOD level from the approximate on-screen diameter of the geodesic in pixels,
+        //! by comparison with lod_pixel_thresholds. Level i+1 is used once px exceeds threshold i.
+        unsigned int lodForPixelSize (const float px) const
+        {
+            unsigned int level = 0;
+            for (auto t : this->lod_pixel_thresholds) { if (px > t) { ++level; } }
+            if (!this->lod_iterations.empty() && level >= this->lod_iterations.size()) {
+                level = static_cast<unsigned int>(this->lod_iterations.size()) - 1u;
+            }
+            return level;
+        }
+
+        //! Per-frame LOD selection helper: set the level appropriate to an on-screen diameter of
+        //! \a px pixels (as computed by client code from the scene trackball/camera distance).
+        void setLodForPixelSize (const float px) { this->setLod (this->lodForPixelSize (px)); }
+
         morph::vvec<morph::vec<float>> cart_centres;
         morph::vvec<morph::vec<float>> sph_centres;
         void vertexPositionsToFaces()
@@ -192,10 +258,39 @@ namespace morph {
         morph::scale<T, float> colourScale;
         //! The number of iterations in the geodesic sphere. Set before finalize() to change from the default.
         int iterations = 2;
+        /*!
+         * Level of detail support. Fill this with subdivision iteration counts, coarse to fine
+         * (e.g. {0, 1, 2, 3}; 0 is the bare icosahedron) *before* finalize() to enable LOD, then
+         * call setLod()/setLodForPixelSize() to switch levels. Each level's mesh is tessellated
+         * once and cached, so switching is cheap. Note that data-driven face/vertex colours apply
+         * to the level that was current when they were set; LOD is intended for the many-geodesics
+         * use case where each sphere has a uniform colour. Leave empty (the default) for the
+         * usual single-mesh behaviour.
+         */
+        morph::vvec<int> lod_iterations;
+        //! On-screen diameters (in pixels) at which lodForPixelSize steps up a level.
+        morph::vvec<float> lod_pixel_thresholds = { 20.0f, 80.0f, 320.0f };
         //! This may be filled with the number of vertices in the geodesic
         int n_verts = 0;
         //! This may be filled with the number of faces in the geodesic
         int n_faces = 0;
+
+    protected:
+        //! A cached, tessellated mesh for one level of detail
+        struct lod_mesh
+        {
+            morph::vertex_buffer_t<float> positions;
+            morph::vertex_buffer_t<float> normals;
+            morph::vertex_buffer_t<float> colors;
+            morph::vertex_buffer_t<GLuint> idx;
+            int n_verts = 0;
+            int n_faces = 0;
+            bool built = false;
+        };
+        //! Cached meshes, one per entry in lod_iterations
+        std::vector<lod_mesh> lod_meshes;
+        //! The currently active LOD level, or -1 before the first build
+        int lod_active = -1;
     };
 
 } // namespace morph
@@ -14,10 +14,12 @@
 #include <sstream>
 #include <memory>
 #include <cstdint>
+#include <limits>
 #include <morph/mathconst.h>
 #include <morph/tools.h>
 #include <morph/scale.h>
 #include <morph/range.h>
+#include <morph/windowed_range.h>
 #include <morph/vec.h>
 #include <morph/vvec.h>
 #include <morph/quaternion.h>
@@ -110,24 +112,73 @@ namespace morph {
             unsigned int oldsz = this->graphDataCoords[didx]->size();
             (this->graphDataCoords[didx])->resize (oldsz+1);
             this->graphDataCoords[didx].get()->at(oldsz) = morph::vec<float>{ static_cast<float>(a), static_cast<float>(o), float{0} };
+
+            // In ring mode, evict the oldest points in a block once the stored series
+            // reaches twice the capacity. Evicting a block (rather than one point per
+            // append) keeps append amortized O(1) and memory bounded at 2x
+            // ring_capacity; the rebuild below then re-tessellates from the trimmed
+            // series, so the vertex buffers are bounded too.
+            bool ring_trimmed = false;
+            if (this->ring_capacity > 0) {
+                if (this->datastyles[didx].axisside == morph::axisside::left) {
+                    if (this->ord1.size() >= 2u * this->ring_capacity) {
+                        this->ord1.erase (this->ord1.begin(), this->ord1.end() - this->ring_capacity);
+                        this->absc1.erase (this->absc1.begin(), this->absc1.end() - this->ring_capacity);
+                        ring_trimmed = true;
+                    }
+                } else {
+                    if (this->ord2.size() >= 2u * this->ring_capacity) {
+                        this->ord2.erase (this->ord2.begin(), this->ord2.end() - this->ring_capacity);
+                        this->absc2.erase (this->absc2.begin(), this->absc2.end() - this->ring_capacity);
+                        ring_trimmed = true;
+                    }
+                }
+            }
+
             int redraw_plot = 0;
             morph::range<Flt> xrange = this->datarange_x;
             morph::range<Flt> yrange = this->datarange_y;
             morph::range<Flt> y2range = this->datarange_y2;
             // check x axis
-            if (this->auto_rescale_x) { redraw_plot += xrange.update (_abscissa) ? 1 : 0; }
+            if (this->auto_rescale_x) {
+                if (this->rescale_window > 0) {
+                    // Rescale to fit the last rescale_window points; the windowed_range
+                    // tracker makes this amortized O(1) per append
+                    this->wr_x.window = this->rescale_window;
+                    this->wr_x.push (_abscissa);
+                    morph::range<Flt> wr = this->wr_x.range();
+                    if (wr.min != xrange.min || wr.max != xrange.max) { xrange = wr; ++redraw_plot; }
+                } else {
+                    redraw_plot += xrange.update (_abscissa) ? 1 : 0;
+                }
+            }
 
             // check y axis
             if (this->auto_rescale_y) {
                 if (this->datastyles[didx].axisside == morph::axisside::left) {
-                    redraw_plot += yrange.update (this->ord1.back()) ? 1 : 0;
+                    if (this->rescale_window > 0) {
+                        this->wr_y.window = this->rescale_window;
+                        this->wr_y.push (this->ord1.back());
+                        morph::range<Flt> wr = this->wr_y.range();
+                        if (wr.min != yrange.min || wr.max != yrange.max) { yrange = wr; ++redraw_plot; }
+                    } else {
+                        redraw_plot += yrange.update (this->ord1.back()) ? 1 : 0;
+                    }
                 } else {
-                    redraw_plot += y2range.update (this->ord2.back()) ? 1 : 0;
+                    if (this->rescale_window > 0) {
+                        this->wr_y2.window = this->rescale_window;
+                        this->wr_y2.push (this->ord2.back());
+                        morph::range<Flt> wr = this->wr_y2.range();
+                        if (wr.min != y2range.min || wr.max != y2range.max) { y2range = wr; ++redraw_plot; }
+                    } else {
+                        redraw_plot += y2range.update (this->ord2.back()) ? 1 : 0;
+                    }
                 }
             }
 
-            // update graph if necessary
-            if (redraw_plot > 0) {
+            // update graph if necessary (a ring eviction also requires a rebuild, to
+            // drop the evicted points' vertices)
+            if (redraw_plot > 0 || ring_trimmed == true) {
                 this->clear_graph_data();
 
                 // setdata or this function will re-add these
@@ -152,8 +203,18 @@ namespace morph {
                 }
             }
 
-            VisualModel<glver>::clear(); // Get rid of the vertices.
-            this->initializeVertices(); // Re-build
+            // In incremental mode, leave the existing vertices alone unless the axes
+            // changed; render() will tessellate and upload just the appended data.
+            if (this->incremental_append == false || redraw_plot > 0 || ring_trimmed == true) {
+                // Get rid of the vertices, but keep the texts; initializeVertices
+                // re-uses the tick labels if the rescale left the tick set unchanged
+                this->vertexPositions.clear();
+                this->vertexNormals.clear();
+                this->vertexColors.clear();
+                this->indices.clear();
+                this->idx = 0u;
+                this->initializeVertices(); // Re-build
+            }
         }
 
         //! Before calling the base class's render method, check if we have any pending data
@@ -162,8 +223,17 @@ namespace morph {
             if (this->pendingAppended == true) {
                 // After adding to graphDataCoords, we have to create the new OpenGL
                 // vertices (CPU side) and update the OpenGL buffers.
-                this->drawAppendedData();
-                this->reinit_buffers();
+                if (this->incremental_append == true) {
+                    // Tessellate only the appended markers/line segments and upload
+                    // only the new tail of each buffer
+                    unsigned int start_vertex = static_cast<unsigned int>(this->vertexPositions.size() / 3u);
+                    unsigned int start_index = static_cast<unsigned int>(this->indices.size());
+                    this->drawAppendedData();
+                    this->reinit_buffers_appended (start_vertex, start_index);
+                } else {
+                    this->drawAppendedData();
+                    this->reinit_buffers();
+                }
                 this->pendingAppended = false;
             }
             // Now do the usual drawing stuff from VisualModel:
@@ -198,9 +268,6 @@ namespace morph {
                 return;
             }
 
-            // Ensure the vector at data_idx has enough capacity for the updated data
-            this->graphDataCoords[data_idx]->resize (dsize);
-
             // Are we auto-rescaling the x axis?
             if (this->auto_rescale_x) {
                 this->abscissa_scale.reset();
@@ -257,12 +324,13 @@ namespace morph {
             }
 
             // Now sd and ad can be used to construct dataCoords x/y. They are used to
-            // set the position of each datum into dataCoords
-            for (unsigned int i = 0; i < dsize; ++i) {
-                this->graphDataCoords[data_idx].get()->at(i) = morph::vec<float>{ static_cast<float>(ad[i]), static_cast<float>(sd[i]), float{0} };
-            }
+            // set the position of each datum into dataCoords. fillDataCoords applies
+            // the min/max envelope reduction if the dataset exceeds lod_threshold, so
+            // zooming (narrowing datarange_x, then calling update) refines the envelope.
+            this->fillDataCoords (data_idx, ad, sd);
 
-            this->clearTexts(); // VisualModel::clearTexts()
+            // Note: no unconditional clearTexts() here; initializeVertices (via reinit)
+            // re-uses the existing tick and axis labels when the tick set is unchanged
             this->reinit();
         }
 
@@ -495,8 +563,67 @@ namespace morph {
 
                 // Now sd and ad can be used to construct dataCoords x/y. They are used to
                 // set the position of each datum into dataCoords
+                this->fillDataCoords (didx, ad, sd);
+            }
+        }
+
+        /*!
+         * Fill graphDataCoords[didx] from the model-space x coords \a ad and y coords
+         * \a sd, reducing to a min/max envelope (see lod_threshold) if the dataset is
+         * large enough to warrant it.
+         */
+        template <typename Ctnr1, typename Ctnr2>
+        void fillDataCoords (const unsigned int didx, const Ctnr1& ad, const Ctnr2& sd)
+        {
+            const uint64_t dsize = ad.size();
+            std::vector<morph::vec<float>>& coords = *this->graphDataCoords[didx];
+
+            if (this->lod_threshold > 0 && dsize > this->lod_threshold && this->lod_bins > 1u) {
+                // Reduce to a per-column min/max envelope (classic waveform decimation)
+                const unsigned int nbins = this->lod_bins;
+                std::vector<float> bmin (nbins, std::numeric_limits<float>::max());
+                std::vector<float> bmax (nbins, std::numeric_limits<float>::lowest());
+                const float binw = this->width / static_cast<float>(nbins);
+#pragma omp parallel
+                {
+                    // Each thread reduces into its own envelope, merged at the end
+                    std::vector<float> lmin (nbins, std::numeric_limits<float>::max());
+                    std::vector<float> lmax (nbins, std::numeric_limits<float>::lowest());
+#pragma omp for nowait
+                    for (int64_t i = 0; i < static_cast<int64_t>(dsize); ++i) {
+                        const float x = static_cast<float>(ad[i]);
+                        // Points off the x axis would not be drawn anyway, so leave
+                        // them out of the envelope
+                        if (x < 0.0f || x > this->width) { continue; }
+                        unsigned int b = static_cast<unsigned int>(x / binw);
+                        if (b >= nbins) { b = nbins - 1u; }
+                        const float y = static_cast<float>(sd[i]);
+                        lmin[b] = y < lmin[b] ? y : lmin[b];
+                        lmax[b] = y > lmax[b] ? y : lmax[b];
+                    }
+#pragma omp critical (graphvisual_lod_merge)
+                    {
+                        for (unsigned int b = 0; b < nbins; ++b) {
+                            bmin[b] = lmin[b] < bmin[b] ? lmin[b] : bmin[b];
+                            bmax[b] = lmax[b] > bmax[b] ? lmax[b] : bmax[b];
+                        }
+                    }
+                }
+                // Two points per non-empty column, ordered (min, max), make a zig-zag
+                // polyline covering the same pixels as the full trace
+                coords.clear();
+                coords.reserve (2u * nbins);
+                for (unsigned int b = 0; b < nbins; ++b) {
+                    if (bmin[b] > bmax[b]) { continue; } // empty column
+                    const float xc = (static_cast<float>(b) + 0.5f) * binw;
+                    coords.push_back (morph::vec<float>{ xc, bmin[b], 0.0f });
+                    if (bmax[b] != bmin[b]) { coords.push_back (morph::vec<float>{ xc, bmax[b], 0.0f }); }
+                }
+
+            } else {
+                coords.resize (dsize);
                 for (uint64_t i = 0; i < dsize; ++i) {
-                    this->graphDataCoords[didx].get()->at(i) = morph::vec<float>{ static_cast<float>(ad[i]), static_cast<float>(sd[i]), float{0} };
+                    coords[i] = morph::vec<float>{ static_cast<float>(ad[i]), static_cast<float>(sd[i]), float{0} };
                 }
             }
         }
@@ -1102,16 +1229,98 @@ namespace morph {
         //! Is there pending appended data that needs to be converted into OpenGL shapes?
         bool pendingAppended = false;
 
+        /*!
+         * Collect the tick values and positions (and the graph dimensions) into a single
+         * vector for change detection. The axis frame geometry and the tick/axis/legend
+         * labels depend only on these values, so when this signature is unchanged across
+         * a rescale, drawAxes can replay its cached tessellation and initializeVertices
+         * can keep the existing label text models.
+         */
+        std::vector<float> makeTickSignature() const
+        {
+            std::vector<float> sig;
+            sig.reserve (2u * (this->xticks.size() + this->yticks.size() + this->yticks2.size()) + 5u);
+            sig.push_back (static_cast<float>(this->xticks.size()));
+            for (auto t : this->xticks) { sig.push_back (static_cast<float>(t)); }
+            for (auto t : this->xtick_posns) { sig.push_back (static_cast<float>(t)); }
+            sig.push_back (static_cast<float>(this->yticks.size()));
+            for (auto t : this->yticks) { sig.push_back (static_cast<float>(t)); }
+            for (auto t : this->ytick_posns) { sig.push_back (static_cast<float>(t)); }
+            sig.push_back (static_cast<float>(this->yticks2.size()));
+            for (auto t : this->yticks2) { sig.push_back (static_cast<float>(t)); }
+            for (auto t : this->ytick_posns2) { sig.push_back (static_cast<float>(t)); }
+            sig.push_back (this->width);
+            sig.push_back (this->height);
+            return sig;
+        }
+
+        //! Collect the axis labels and the legend's data labels into a single string,
+        //! so that a changed label forces the label text models to be rebuilt even when
+        //! the tick set is unchanged
+        std::string makeLabelSignature() const
+        {
+            std::string sig = this->xlabel + "/" + this->ylabel + "/" + this->ylabel2;
+            for (const auto& ds : this->datastyles) { sig += "/" + ds.datalabel; }
+            return sig;
+        }
+
+        //! The tick signature (see makeTickSignature) for which the tick/axis/legend
+        //! label text models were last built. Empty until the first build.
+        std::vector<float> drawn_tick_signature;
+        //! The label signature (see makeLabelSignature) at the last label build
+        std::string drawn_label_signature;
+
+        //! The key (tick signature, plus the origin position for the cross axis styles)
+        //! and the cached tessellation for the axis frame, re-used by drawAxes when the
+        //! key is unchanged
+        std::vector<float> axes_cache_key;
+        std::vector<float> axes_cache_positions;
+        std::vector<float> axes_cache_normals;
+        std::vector<float> axes_cache_colors;
+        std::vector<GLuint> axes_cache_indices;
+
         //! Compute stuff for a graph
+        //! Predict the build's vertex count so that finalize()/reinit() can reserve the
+        //! vertex containers once. Each data point gets a marker (a circle marker is a
+        //! 21 vertex polygon) and a line segment (a few more vertices, especially with
+        //! rounded ends); the axes, ticks and legend get a fixed allowance.
+        std::size_t predict_vertex_count() const override
+        {
+            std::size_t npoints = 0;
+            for (unsigned int dsi = 0; dsi < this->graphDataCoords.size(); ++dsi) {
+                if (this->graphDataCoords[dsi] != nullptr) { npoints += this->graphDataCoords[dsi]->size(); }
+            }
+            return npoints * 32u + 512u;
+        }
+
         void initializeVertices()
         {
             // The indices index
             this->idx = 0;
-            this->drawAxes();
+            this->drawAxes(); // populates the tick positions (and may re-use cached frame geometry)
+
+            // If the tick set (values and positions) is unchanged since the labels were
+            // last built - and those labels have not been cleared - then the tick, axis
+            // and legend labels are all still correct and their VisualTextModels can be
+            // re-used, skipping the most expensive part of an axis rebuild.
+            std::vector<float> tick_sig = this->makeTickSignature();
+            std::string label_sig = this->makeLabelSignature();
+            const bool rebuild_texts = this->drawn_tick_signature.empty()
+                                       || this->texts.empty()
+                                       || tick_sig != this->drawn_tick_signature
+                                       || label_sig != this->drawn_label_signature;
+            if (rebuild_texts == true && this->drawn_tick_signature.empty() == false && this->texts.empty() == false) {
+                this->clearTexts();
+            }
+
             this->drawData();
-            if (this->legend == true) { this->drawLegend(); }
-            this->drawTickLabels(); // from which we can store the tick label widths
-            this->drawAxisLabels();
+            if (this->legend == true) { this->drawLegend (rebuild_texts); }
+            if (rebuild_texts == true) {
+                this->drawTickLabels(); // from which we can store the tick label widths
+                this->drawAxisLabels();
+                this->drawn_tick_signature = tick_sig;
+                this->drawn_label_signature = label_sig;
+            }
         }
 
         //! Is the passed in coordinate within the graph axes (in the x/y sense, ignoring z)?
@@ -1202,7 +1411,13 @@ namespace morph {
 
                     for (unsigned int i = coords_start; i < coords_end; ++i) {
                         if (this->within_axes ((*this->graphDataCoords[dsi])[i])) {
-                            this->marker ((*this->graphDataCoords[dsi])[i], this->datastyles[dsi]);
+                            if (this->markers_on_gpu == true) {
+                                // A subclass draws the markers instanced (see
+                                // InstancedGraphVisual); record the instance only
+                                this->appendMarkerInstance (dsi, (*this->graphDataCoords[dsi])[i]);
+                            } else {
+                                this->marker ((*this->graphDataCoords[dsi])[i], this->datastyles[dsi]);
+                            }
                         } // else marker is outside graph axes so don't draw it
                     }
                 }
@@ -1284,6 +1499,10 @@ namespace morph {
         //! Draw markers and lines for data points that are being appended to a graph
         void drawAppendedData()
         {
+            // A dataset may have been added (by append) since drawData last ran
+            if (this->coords_lengths.size() < this->graphDataCoords.size()) {
+                this->coords_lengths.resize (this->graphDataCoords.size(), 0u);
+            }
             for (unsigned int dsi = 0; dsi < this->graphDataCoords.size(); ++dsi) {
                 // Start is old end:
                 unsigned int coords_start = this->coords_lengths[dsi];
@@ -1306,8 +1525,11 @@ namespace morph {
             }
         }
 
-        //! Draw the graph legend, above the graph, rather than inside it (so much simpler!)
-        void drawLegend()
+        //! Draw the graph legend, above the graph, rather than inside it (so much
+        //! simpler!). If \a rebuild_texts is false, the existing legend text models are
+        //! being kept (see initializeVertices), so only the marker/line geometry is
+        //! drawn here.
+        void drawLegend (const bool rebuild_texts = true)
         {
             unsigned int num_legends_max = static_cast<unsigned int>(this->graphDataCoords.size());
 
@@ -1324,6 +1546,7 @@ namespace morph {
             float text_advance = 0.0f;
             int num_legends = 0;
             morph::TextFeatures tf(this->fontsize, this->fontres, false, morph::colour::black, this->font);
+            std::unique_ptr<morph::VisualTextModel<glver>> tmplbl = nullptr;
             for (unsigned int dsi = 0; dsi < num_legends_max; ++dsi) {
                 // If no label, then draw no legend. Thus the effective num_legends may be smaller
                 // than num_legends_max.
@@ -1331,16 +1554,23 @@ namespace morph {
                 // Legend text. If all is well, this will be pushed onto the texts attribute and
                 // deleted when the model is deconstructed.
 
-                auto ltp = this->makeVisualTextModel (tf);
-                geom.push_back (ltp->getTextGeometry (this->datastyles[dsi].datalabel));
+                if (rebuild_texts == true) {
+                    auto ltp = this->makeVisualTextModel (tf);
+                    geom.push_back (ltp->getTextGeometry (this->datastyles[dsi].datalabel));
+                    legtexts[dsi] = std::move(ltp);
+                } else {
+                    // The existing legend text models are being kept; a temporary model
+                    // serves for the layout geometry
+                    if (tmplbl == nullptr) { tmplbl = this->makeVisualTextModel (tf); }
+                    geom.push_back (tmplbl->getTextGeometry (this->datastyles[dsi].datalabel));
+                }
                 if (geom.back().total_advance > text_advance) { text_advance = geom.back().total_advance; }
-                legtexts[dsi] = std::move(ltp);
                 ds_indices.push_back (dsi);
                 ++num_legends;
             }
 
             // If there are no legend texts to show, then clean up and return
-            if (text_advance == 0.0f && !legtexts.empty()) {
+            if (text_advance == 0.0f && num_legends > 0) {
                 legtexts.clear();
                 return;
             }
@@ -1392,8 +1622,10 @@ namespace morph {
                         this->marker (lpos, this->datastyles[dsi]);
                     }
                 }
-                legtexts[dsi]->setupText (this->datastyles[dsi].datalabel, lpos+toffset+this->mv_offset, this->axiscolour);
-                this->texts.push_back (std::move(legtexts[dsi]));
+                if (rebuild_texts == true) {
+                    legtexts[dsi]->setupText (this->datastyles[dsi].datalabel, lpos+toffset+this->mv_offset, this->axiscolour);
+                    this->texts.push_back (std::move(legtexts[dsi]));
+                }
             }
         }
 
@@ -1611,6 +1843,46 @@ namespace morph {
             // First, ensure that this->xtick_posns/xticks and this->ytick_posns/yticks are populated
             this->computeTickPositions();
 
+            // The axis frame and tick geometry is fully determined by the tick set, the
+            // graph dimensions and (for the cross styles) the position of the data
+            // origin. If none of these changed since the last build, append the cached
+            // tessellation instead of re-computing all the flat lines.
+            std::vector<float> axes_key = this->makeTickSignature();
+            if (this->axisstyle == axisstyle::cross || this->axisstyle == axisstyle::boxcross) {
+                axes_key.push_back (this->abscissa_scale.transform_one (0));
+                axes_key.push_back (this->ord1_scale.transform_one (0));
+            }
+
+            if (this->idx == 0 && axes_key == this->axes_cache_key && this->axes_cache_indices.empty() == false) {
+                this->vertexPositions.insert (this->vertexPositions.end(),
+                                              this->axes_cache_positions.begin(), this->axes_cache_positions.end());
+                this->vertexNormals.insert (this->vertexNormals.end(),
+                                            this->axes_cache_normals.begin(), this->axes_cache_normals.end());
+                this->vertexColors.insert (this->vertexColors.end(),
+                                           this->axes_cache_colors.begin(), this->axes_cache_colors.end());
+                this->indices.insert (this->indices.end(),
+                                      this->axes_cache_indices.begin(), this->axes_cache_indices.end());
+                this->idx += static_cast<GLuint>(this->axes_cache_positions.size() / 3u);
+                return;
+            }
+
+            // drawAxes is normally the first drawing call of a build, so its output is a
+            // prefix of the vertex containers (with indices counting from 0) and can be
+            // cached for replay. If idx is non-zero, just draw without caching.
+            const bool cacheable = (this->idx == 0);
+            this->drawAxesGeometry();
+            if (cacheable == true) {
+                this->axes_cache_positions.assign (this->vertexPositions.begin(), this->vertexPositions.end());
+                this->axes_cache_normals.assign (this->vertexNormals.begin(), this->vertexNormals.end());
+                this->axes_cache_colors.assign (this->vertexColors.begin(), this->vertexColors.end());
+                this->axes_cache_indices.assign (this->indices.begin(), this->indices.end());
+                this->axes_cache_key = std::move (axes_key);
+            }
+        }
+
+        //! Tessellate the axis frame and the ticks (see drawAxes, which caches the result)
+        void drawAxesGeometry()
+        {
             if (this->axisstyle == axisstyle::cross) { return this->drawCrossAxes(); }
 
             if (this->axisstyle == axisstyle::box
@@ -1806,6 +2078,22 @@ namespace morph {
         }
 
         //! Generate vertices for a marker of the given style at location p
+        /*!
+         * When true, polygonal data markers are not tessellated into the vertex
+         * buffers; instead each marker is handed to appendMarkerInstance() and a
+         * subclass renders them instanced (one unit mesh per markerstyle, drawn once
+         * per datum). See morph::InstancedGraphVisual. Bar and quiver markers are
+         * unaffected.
+         */
+        bool markers_on_gpu = false;
+
+        //! Hook for instanced-marker subclasses: called (instead of marker()) for each
+        //! polygonal data marker when markers_on_gpu is true. A no-op here.
+        virtual void appendMarkerInstance (unsigned int dsi, const morph::vec<float>& p)
+        {
+            if constexpr (gv_debug) { std::cout << "appendMarkerInstance (dsi=" << dsi << ", p=" << p << ") no-op\n"; }
+        }
+
         void marker (morph::vec<float>& p, const morph::DatasetStyle& style)
         {
             switch (style.markerstyle) {
@@ -2026,6 +2314,50 @@ namespace morph {
         bool auto_rescale_y = false;
         //! in the update function, it fits the scale with the range of the data (/!\ will scope only on the last datasets per y axis)
         bool auto_rescale_fit = false;
+        /*!
+         * If true, append() takes a true incremental path: existing markers and lines
+         * are left alone, only the appended data is tessellated and only the new tail
+         * of each vertex buffer is uploaded (reinit_buffers_appended). A full rebuild
+         * happens only when an auto-rescale actually changes the axes. Intended for
+         * high-rate telemetry graphs, where re-tessellating the history on every
+         * append costs a core.
+         */
+        bool incremental_append = false;
+        /*!
+         * If non-zero, append() auto-rescales the axes to fit the most recent
+         * rescale_window appended points, rather than only ever growing the axis range
+         * as new extrema arrive. The windowed min/max is maintained with
+         * morph::windowed_range, so each append costs amortized O(1), not O(window).
+         * Intended for scrolling data. Applies to whichever of auto_rescale_x and
+         * auto_rescale_y are set.
+         */
+        unsigned int rescale_window = 0;
+        /*!
+         * If non-zero, append() keeps only the most recent ring_capacity points of each
+         * dataset, evicting the oldest - a bounded-memory mode for plotting 'the last N
+         * samples' from a long-running telemetry stream. Eviction happens in blocks of
+         * ring_capacity points (so memory is bounded at twice the capacity and append
+         * stays amortized O(1)); between evictions, incremental_append tessellates and
+         * uploads only the appended tail. Combine with auto_rescale_x and
+         * rescale_window for a scrolling monitor.
+         */
+        unsigned int ring_capacity = 0;
+        /*!
+         * If non-zero, a dataset with more than lod_threshold points is plotted as a
+         * per-column min/max envelope (classic waveform decimation) of lod_bins columns
+         * instead of one marker and line segment per datum, so a multi-million sample
+         * trace tessellates in milliseconds. The envelope is a zig-zag polyline visiting
+         * each column's minimum and maximum, which fills the same pixels as the full
+         * trace wherever there are many points per column; use a lines-only
+         * DatasetStyle for the cleanest result. To zoom, narrow datarange_x (setlimits)
+         * and call update(): the reduction re-runs over the points that remain in view,
+         * refining the envelope until the in-view count drops below lod_threshold and
+         * the raw data is plotted.
+         */
+        std::size_t lod_threshold = 0;
+        //! The number of envelope columns used when decimating (should be of the order
+        //! of the number of pixels the graph's width spans)
+        unsigned int lod_bins = 1024;
         //! Current DatasetStyle for ord1
         morph::DatasetStyle ds_ord1;
         //! DatasetStyle for ord2
@@ -2113,6 +2445,11 @@ namespace morph {
         //! between the min/max and the axes? Can be 0.0f;
         float dataaxisdist = 0.04f;
 
+        //! Windowed range trackers used by append() when rescale_window > 0
+        morph::windowed_range<Flt> wr_x;
+        morph::windowed_range<Flt> wr_y;
+        morph::windowed_range<Flt> wr_y2;
+
         //! Temporary storage for the max height of the xtick labels
         float xtick_label_height = 0.0f;
         //! Temporary storage for the max width of the ytick labels
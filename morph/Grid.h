@@ -19,6 +19,7 @@
 #include <morph/vec.h>
 #include <morph/vvec.h>
 #include <morph/GridFeatures.h>
+#include <morph/snapshot.h>
 
 namespace morph {
 
@@ -170,7 +171,7 @@ namespace morph {
             return w_h;
         }
 
-        //! Return whether ordering is row-major (true) or column-major (false)
+        //! Return whether ordering is row-major (true) or column-major/morton (false)
         bool rowmaj() const
         {
             return (this->order == morph::GridOrder::bottomleft_to_topright
@@ -221,6 +222,16 @@ namespace morph {
                     }
                     ss << "\n";
                 }
+            } else if (order == morph::GridOrder::morton) {
+                ss << "Morton (Z-order curve) grid order:\n";
+                for (I _r = this->h; _r > 0; _r--) {
+                    I r = _r-1;
+                    for (I c = I{0}; c < this->w; ++c) {
+                        I i = static_cast<I>(morph::morton::encode (c, r));
+                        ss << i << this->coord(i) << "\t";
+                    }
+                    ss << "\n";
+                }
             }
 
             return ss.str();
@@ -271,8 +282,19 @@ namespace morph {
                 }
             }
 
+            if (this->order == morph::GridOrder::morton) {
+                // A plain bit-interleave only fills indices 0 to n-1 without holes on a
+                // square, power-of-two-sided grid
+                if (this->w != this->h || (this->w & (this->w - I{1})) != I{0}) {
+                    throw std::runtime_error ("GridOrder::morton requires a square grid whose side is a power of two");
+                }
+            }
+
             this->v_c.resize (this->n());
             for (I i = 0; i < this->n(); ++i) { this->v_c[i] = this->coord (i); }
+
+            // If the precomputed neighbour table was in use, it is now stale; rebuild it
+            if (!this->v_nbr.empty()) { this->build_neighbour_table(); }
         }
 
         //! Indexing the grid will return a memorized vec location.
@@ -307,6 +329,8 @@ namespace morph {
             } else if (order == morph::GridOrder::bottomleft_to_topright_colmaj
                        || order == morph::GridOrder::topleft_to_bottomright_colmaj) {
                 index = this->h * xyi[0] + xyi[1];
+            } else if (order == morph::GridOrder::morton) {
+                index = static_cast<I>(morph::morton::encode (xyi[0], xyi[1]));
             }
 
             if (index >= this->w * this->h || index < I{0}) {
@@ -345,6 +369,10 @@ namespace morph {
                 loc[I{0}] += this->dx[I{0}] * (index / this->h);
                 loc[I{1}] -= this->dx[I{1}] * (index % this->h);
 
+            } else if (order == morph::GridOrder::morton) {
+                loc[I{0}] += this->dx[I{0}] * static_cast<I>(morph::morton::decode_x (index));
+                loc[I{1}] += this->dx[I{1}] * static_cast<I>(morph::morton::decode_y (index));
+
             } // else user will just get the offset coordinate
 
             return loc;
@@ -358,8 +386,14 @@ namespace morph {
             if (c == (w - I{1}) && (wrap == GridDomainWrap::None || wrap == GridDomainWrap::Vertical)) {
                 return std::numeric_limits<I>::max();
             } else if (c == (w - I{1}) && (wrap == GridDomainWrap::Horizontal || wrap == GridDomainWrap::Both)) {
+                if (order == morph::GridOrder::morton) {
+                    return static_cast<I>(morph::morton::encode (I{0}, this->row (index)));
+                }
                 return index - (this->rowmaj() ? (w - I{1}) : (h * (w-I{1})));
             } else {
+                if (order == morph::GridOrder::morton) {
+                    return static_cast<I>(morph::morton::encode (c + I{1}, this->row (index)));
+                }
                 return index + (this->rowmaj() ? I{1} : h);
             }
         }
@@ -382,8 +416,14 @@ namespace morph {
             if (c == 0 && (wrap == GridDomainWrap::None || wrap == GridDomainWrap::Vertical)) {
                 return std::numeric_limits<I>::max();
             } else if (c == 0 && (wrap == GridDomainWrap::Horizontal || wrap == GridDomainWrap::Both)) {
+                if (order == morph::GridOrder::morton) {
+                    return static_cast<I>(morph::morton::encode (w - I{1}, this->row (index)));
+                }
                 return index + (this->rowmaj() ? (w - I{1}) : (h * (w-I{1})));
             } else {
+                if (order == morph::GridOrder::morton) {
+                    return static_cast<I>(morph::morton::encode (c - I{1}, this->row (index)));
+                }
                 return index - (this->rowmaj() ? I{1} : h);
             }
         }
@@ -442,6 +482,16 @@ namespace morph {
                 } else {
                     return index - I{1};
                 }
+
+            } else if (order == morph::GridOrder::morton) {
+
+                if (r == (h - I{1}) && (wrap == GridDomainWrap::None || wrap == GridDomainWrap::Horizontal)) {
+                    return std::numeric_limits<I>::max();
+                } else if (r == (h - I{1}) && (wrap == GridDomainWrap::Vertical || wrap == GridDomainWrap::Both)) {
+                    return static_cast<I>(morph::morton::encode (this->col (index), I{0}));
+                } else {
+                    return static_cast<I>(morph::morton::encode (this->col (index), r + I{1}));
+                }
             } // else: Unknown order (should not occur)
 
             return std::numeric_limits<I>::max();
@@ -502,6 +552,16 @@ namespace morph {
                 } else {
                     return index + I{1};
                 }
+
+            } else if (order == morph::GridOrder::morton) {
+
+                if (r == I{0} && (wrap == GridDomainWrap::None || wrap == GridDomainWrap::Horizontal)) {
+                    return std::numeric_limits<I>::max();
+                } else if (r == I{0} && (wrap == GridDomainWrap::Vertical || wrap == GridDomainWrap::Both)) {
+                    return static_cast<I>(morph::morton::encode (this->col (index), h - I{1}));
+                } else {
+                    return static_cast<I>(morph::morton::encode (this->col (index), r - I{1}));
+                }
             }
 
             return std::numeric_limits<I>::max();
@@ -569,6 +629,57 @@ namespace morph {
             return idx < this->n() ? (*this)[idx] : morph::vec<C, 2>{std::numeric_limits<C>::max(), std::numeric_limits<C>::max()};
         }
 
+        /*!
+         * Build the optional precomputed neighbour table, v_nbr. This is an n() x 4
+         * contiguous array holding, for each element, the indices of its east, north,
+         * west and south neighbours (std::numeric_limits<I>::max() where there is no
+         * neighbour). The index_ne/index_nn/... functions re-do their wrap and order
+         * branching on every call; building the table resolves all of that once, so
+         * that stencil kernels (Laplacians and the like) become straight array
+         * lookups. The table is rebuilt if the grid parameters change (init() takes
+         * care of this) and is used by stencil_apply().
+         */
+        void build_neighbour_table()
+        {
+            this->v_nbr.resize (4 * this->n());
+            for (I i = I{0}; i < this->n(); ++i) {
+                this->v_nbr[4 * i] = this->index_ne (i);
+                this->v_nbr[4 * i + I{1}] = this->index_nn (i);
+                this->v_nbr[4 * i + I{2}] = this->index_nw (i);
+                this->v_nbr[4 * i + I{3}] = this->index_ns (i);
+            }
+        }
+
+        /*!
+         * Run the function \a func over all elements of the grid, OpenMP
+         * parallelized. \a func is called as func (index, nbrs), where nbrs points at
+         * the element's four entries in the precomputed neighbour table, in the order
+         * east, north, west, south; absent neighbours hold
+         * std::numeric_limits<I>::max(). The neighbour table is built on first use.
+         *
+         * Example - a Laplacian over data held in a vvec:
+         * \code
+         * grid.stencil_apply ([&] (unsigned int i, const unsigned int* nb) {
+         *     float sum = 0.0f;
+         *     unsigned int cnt = 0;
+         *     for (int j = 0; j < 4; ++j) {
+         *         if (nb[j] != std::numeric_limits<unsigned int>::max()) { sum += f[nb[j]]; ++cnt; }
+         *     }
+         *     lap[i] = sum - cnt * f[i];
+         * });
+         * \endcode
+         */
+        template<typename F>
+        void stencil_apply (F&& func)
+        {
+            if (this->v_nbr.empty()) { this->build_neighbour_table(); }
+            const long int nn = static_cast<long int>(this->n());
+#pragma omp parallel for
+            for (long int i = 0; i < nn; ++i) {
+                func (static_cast<I>(i), this->v_nbr.data() + 4 * i);
+            }
+        }
+
         /*!
          * Return the distance from the centre of the left element column to the centre of the
          * right element column
@@ -601,18 +712,24 @@ namespace morph {
         C xmax() const {
             if (this->rowmaj() == true) {
                 return (*this)[w-I{1}][I{0}];
+            } else if (order == GridOrder::morton) {
+                return (*this)[static_cast<I>(morph::morton::encode (w-I{1}, I{0}))][I{0}];
             } // else colmaj
             return (*this)[(w*h)-I{1}][I{0}];
         }
         C ymin() const {
             if (this->rowmaj() == true) {
                 return order == GridOrder::bottomleft_to_topright ? (*this)[I{0}][I{1}] : (*this)[w * (h-I{1})][I{1}];
+            } else if (order == GridOrder::morton) {
+                return (*this)[I{0}][I{1}]; // morton counts from the bottom left
             } // else colmaj
             return order == GridOrder::bottomleft_to_topright_colmaj ? (*this)[I{0}][I{1}] : (*this)[h-I{1}][I{1}];
         }
         C ymax() const {
             if (this->rowmaj() == true) {
                 return order == GridOrder::bottomleft_to_topright ? (*this)[w * (h-I{1})][I{1}] : (*this)[I{0}][I{1}];
+            } else if (order == GridOrder::morton) {
+                return (*this)[static_cast<I>(morph::morton::encode (I{0}, h-I{1}))][I{1}];
             } // else colmaj
             return order == GridOrder::bottomleft_to_topright_colmaj ? (*this)[h-I{1}][I{1}] : (*this)[I{0}][I{1}];
         }
@@ -630,6 +747,8 @@ namespace morph {
             if (order == GridOrder::bottomleft_to_topright || order == GridOrder::topleft_to_bottomright) {
                 // abscissae is just the first width values.
                 for (I i = I{0}; i < w; ++i) { abscissae[i] = v_c[i][0]; }
+            } else if (order == GridOrder::morton) {
+                for (I i = I{0}; i < w; ++i) { abscissae[i] = v_c[static_cast<I>(morph::morton::encode (i, I{0}))][0]; }
             } else {
                 // For column major, we have to skip each row
                 for (I i = I{0}; i < w; ++i) { abscissae[i] = v_c[i*h][0]; }
@@ -643,6 +762,8 @@ namespace morph {
             morph::vvec<C> ordinates (h, C{0});
             if (order == GridOrder::bottomleft_to_topright || order == GridOrder::topleft_to_bottomright) {
                 for (I i = I{0}; i < h; ++i) { ordinates[i] = v_c[i*w][1]; }
+            } else if (order == GridOrder::morton) {
+                for (I i = I{0}; i < h; ++i) { ordinates[i] = v_c[static_cast<I>(morph::morton::encode (I{0}, i))][1]; }
             } else {
                 // For column major, ordinates is just the first height values
                 for (I i = I{0}; i < h; ++i) { ordinates[i] = v_c[i][1]; }
@@ -654,6 +775,8 @@ namespace morph {
         I row (const I index) const {
             if (this->rowmaj() == true) {
                 return index < this->n() ? index / w : std::numeric_limits<I>::max();
+            } else if (this->order == morph::GridOrder::morton) {
+                return index < this->n() ? static_cast<I>(morph::morton::decode_y (index)) : std::numeric_limits<I>::max();
             } // else colmaj
             return index < this->n() ? index % h : std::numeric_limits<I>::max();
         }
@@ -662,6 +785,8 @@ namespace morph {
         I col (const I index) const {
             if (this->rowmaj() == true) {
                 return index < this->n() ? index % w : std::numeric_limits<I>::max();
+            } else if (this->order == morph::GridOrder::morton) {
+                return index < this->n() ? static_cast<I>(morph::morton::decode_x (index)) : std::numeric_limits<I>::max();
             } // else colmaj
             return index < this->n() ? index / h : std::numeric_limits<I>::max();
         }
@@ -729,6 +854,9 @@ namespace morph {
             I new_row = this->row_after_y_shift (ind, delta[1]);
             if (new_row == std::numeric_limits<I>::max()) { return std::numeric_limits<I>::max(); }
 
+            if (order == morph::GridOrder::morton) {
+                return static_cast<I>(morph::morton::encode (new_col, new_row));
+            }
             return this->rowmaj() ? new_row * this->w + new_col : new_col * this->h + new_row;
         }
 
@@ -881,9 +1009,151 @@ namespace morph {
             }
         }
 
+        //! Return the 1D index of the element at column \a c, row \a r (storage rows/cols, as
+        //! returned by col() and row()). Returns the max for I if (c, r) is off the grid.
+        I index_of (const I c, const I r) const
+        {
+            if (c >= this->w || r >= this->h) { return std::numeric_limits<I>::max(); }
+            if (order == morph::GridOrder::morton) { return static_cast<I>(morph::morton::encode (c, r)); }
+            return this->rowmaj() == true ? r * this->w + c : c * this->h + r;
+        }
+
+        /*!
+         * A lightweight view of a rectangular sub-region of the Grid: columns [x0, x0 + vw)
+         * and rows [y0, y0 + vh), in the storage sense of col() and row(). The view holds no
+         * data; it converts view-local indices to grid indices and runs loops over only the
+         * viewed elements, so a zoomed-in recolour or a localized computation touches vw * vh
+         * elements, however large the parent grid. Obtain one from Grid::subgrid().
+         */
+        struct subgrid_view
+        {
+            Grid<I, C>* grid = nullptr;
+            //! The first column and row of the view
+            I x0 = I{0};
+            I y0 = I{0};
+            //! The width and height of the view in elements
+            I vw = I{0};
+            I vh = I{0};
+
+            //! The number of elements in the view
+            I n() const { return this->vw * this->vh; }
+
+            //! Convert a view-local index (row-major within the view) into a grid index
+            I index (const I vi) const
+            {
+                return this->grid->index_of (this->x0 + (vi % this->vw), this->y0 + (vi / this->vw));
+            }
+
+            //! Run \a func (called as func (grid_index)) over the viewed elements, OpenMP
+            //! parallelized across view rows
+            template<typename F>
+            void for_each (F&& func) const
+            {
+                const long int nvh = static_cast<long int>(this->vh);
+#pragma omp parallel for
+                for (long int r = 0; r < nvh; ++r) {
+                    for (I c = I{0}; c < this->vw; ++c) {
+                        func (this->grid->index_of (this->x0 + c, this->y0 + static_cast<I>(r)));
+                    }
+                }
+            }
+
+            /*!
+             * As Grid::stencil_apply, but over only the viewed elements: \a func is called as
+             * func (grid_index, nbrs) with nbrs pointing at the element's four entries in the
+             * grid's neighbour table (east, north, west, south; absent neighbours hold the max
+             * for I). Neighbours may lie outside the view - the stencil sees the true grid
+             * neighbourhood. The neighbour table is built on first use.
+             */
+            template<typename F>
+            void stencil_apply (F&& func) const
+            {
+                if (this->grid->v_nbr.empty()) { this->grid->build_neighbour_table(); }
+                const long int nvh = static_cast<long int>(this->vh);
+#pragma omp parallel for
+                for (long int r = 0; r < nvh; ++r) {
+                    for (I c = I{0}; c < this->vw; ++c) {
+                        I gi = this->grid->index_of (this->x0 + c, this->y0 + static_cast<I>(r));
+                        func (gi, this->grid->v_nbr.data() + 4 * gi);
+                    }
+                }
+            }
+        };
+
+        //! Return a subgrid_view of columns [x0, x0 + vw) and rows [y0, y0 + vh). The extents
+        //! are clipped to the grid, so a view requested around a zoom region near an edge is
+        //! simply smaller.
+        subgrid_view subgrid (const I x0, const I y0, const I vw, const I vh)
+        {
+            subgrid_view sv;
+            sv.grid = this;
+            sv.x0 = x0 < this->w ? x0 : this->w;
+            sv.y0 = y0 < this->h ? y0 : this->h;
+            sv.vw = sv.x0 + vw > this->w ? this->w - sv.x0 : vw;
+            sv.vh = sv.y0 + vh > this->h ? this->h - sv.y0 : vh;
+            return sv;
+        }
+
+        /*!
+         * Save this Grid into a flat binary snapshot at \a path, in the shared
+         * morph::snapshot format (versioned header, named sections, per-section
+         * CRC-32C): the grid parameters, the coordinates v_c and, if it has been
+         * built, the neighbour table v_nbr, all as raw contiguous arrays.
+         */
+        void save_snapshot (const std::string& path) const
+        {
+            morph::snapshot::writer sw (path, grid_snapshot_tag, grid_snapshot_version);
+            sw.add_value ("w", this->w);
+            sw.add_value ("h", this->h);
+            sw.add_value ("dx", this->dx);
+            sw.add_value ("offset", this->offset);
+            std::uint32_t wrp = static_cast<std::uint32_t>(this->wrap);
+            sw.add_value ("wrap", wrp);
+            std::uint32_t ord = static_cast<std::uint32_t>(this->order);
+            sw.add_value ("order", ord);
+            sw.add_array ("v_c", this->v_c);
+            if (!this->v_nbr.empty()) { sw.add_array ("v_nbr", this->v_nbr); }
+            sw.finish();
+        }
+
+        /*!
+         * Populate this Grid from a binary snapshot written by save_snapshot(). The
+         * file is memory mapped (morph::snapshot::reader) and v_c (and v_nbr, if it
+         * was saved) bulk-copied from the map; neither the coordinates nor the
+         * neighbour table are recomputed. Throws std::runtime_error if the file is
+         * missing, isn't a Grid snapshot, has the wrong version or fails its
+         * checksums.
+         */
+        void load_snapshot (const std::string& path)
+        {
+            morph::snapshot::reader sr (path, grid_snapshot_tag, grid_snapshot_version);
+            sr.value ("w", this->w);
+            sr.value ("h", this->h);
+            sr.value ("dx", this->dx);
+            sr.value ("offset", this->offset);
+            std::uint32_t wrp = 0;
+            sr.value ("wrap", wrp);
+            this->wrap = static_cast<GridDomainWrap>(wrp);
+            std::uint32_t ord = 0;
+            sr.value ("order", ord);
+            this->order = static_cast<GridOrder>(ord);
+            sr.fill ("v_c", this->v_c);
+            if (sr.has ("v_nbr")) { sr.fill ("v_nbr", this->v_nbr); } else { this->v_nbr.clear(); }
+        }
+
+        //! Content tag identifying a morph::snapshot file written by save_snapshot()
+        static constexpr std::uint32_t grid_snapshot_tag = morph::crc32 ("Grid");
+        //! Version of the save_snapshot() section layout
+        static constexpr std::uint32_t grid_snapshot_version = 1;
+
         //! This vector structure contains the coords for this grid. Note that it is public and so
         //! acccessible by client code
         morph::vvec<morph::vec<C, 2>> v_c;
+
+        //! The optional precomputed neighbour table, n() x 4, in the order east, north, west,
+        //! south for each element. Empty until build_neighbour_table() (or stencil_apply()) is
+        //! called. Public so that client code can drive its own loops from the table.
+        morph::vvec<I> v_nbr;
     };
 
 } // namespace morph
@@ -0,0 +1,188 @@
+/*!
+ * \file
+ *
+ * \brief A multiresolution data pyramid for morph::Grid
+ *
+ * Holds a stack of successively box-reduced (2x2 mean) copies of a data field defined
+ * on a morph::Grid, along with a matching coarser Grid for each level. A GridVisual can
+ * then draw the level whose pixel size matches the on-screen resolution (see
+ * GridVisual::setPyramid), making the cost of browsing a large field proportional to
+ * what is visible rather than to the field size. The reductions are OpenMP-parallel and
+ * can be refreshed incrementally for a changed sub-region.
+ *
+ * \author Seb James
+ * \date August 2026
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <morph/Grid.h>
+#include <morph/vec.h>
+
+namespace morph {
+
+    /*!
+     * A pyramid of box-reduced levels over a data field on a morph::Grid.
+     *
+     * Level 0 is the caller's Grid and data (referenced, not copied); each further
+     * level halves the width and height (rounding up, with edge cells averaging
+     * whatever fine cells they cover) and doubles dx, with the offset adjusted so that
+     * each coarse pixel sits at the centroid of the fine pixels it averages. All Grid
+     * orders except morton are supported.
+     *
+     * When the underlying data changes, call refresh() to recompute every level, or
+     * refresh_region() to recompute only the cells that cover a changed rectangle.
+     *
+     * \tparam T The type of the data
+     * \tparam I The Grid's index type
+     * \tparam C The Grid's coordinate type
+     */
+    template <typename T, typename I = unsigned int, typename C = float>
+    struct GridPyramid
+    {
+        /*!
+         * Construct over \a _base and its data \a _data (whose lifetimes must exceed
+         * this object's). Levels are added until one is 1x1, or until \a max_levels
+         * levels exist (0 means no limit). All reduced levels are computed.
+         */
+        GridPyramid (const morph::Grid<I, C>* _base, std::span<const T> _data, const unsigned int max_levels = 0)
+            : base (_base)
+            , basedata (_data)
+        {
+            if (_base == nullptr) {
+                throw std::runtime_error ("GridPyramid: base grid is nullptr");
+            }
+            if (_base->get_order() == morph::GridOrder::morton) {
+                throw std::runtime_error ("GridPyramid: morton order is not supported");
+            }
+            if (_data.size() != static_cast<std::size_t>(_base->n())) {
+                throw std::runtime_error ("GridPyramid: data size does not match the grid");
+            }
+
+            I w = this->base->get_w();
+            I h = this->base->get_h();
+            morph::vec<C, 2> dx = this->base->get_dx();
+            morph::vec<C, 2> off = this->base->get_offset();
+            // In the topleft_to_bottomright orders, the y coordinate decreases with the
+            // row index, so the half-pixel centroid shift is downwards
+            const bool ydown = (this->base->get_order() == morph::GridOrder::topleft_to_bottomright
+                                || this->base->get_order() == morph::GridOrder::topleft_to_bottomright_colmaj);
+
+            while ((w > I{1} || h > I{1})
+                   && (max_levels == 0 || this->grids.size() + 1u < max_levels)) {
+                off[0] += dx[0] / C{2};
+                off[1] += (ydown == true ? -dx[1] : dx[1]) / C{2};
+                dx *= C{2};
+                w = (w + I{1}) / I{2};
+                h = (h + I{1}) / I{2};
+                this->grids.push_back (std::make_unique<morph::Grid<I, C>> (w, h, dx, off,
+                                                                            this->base->get_wrap(),
+                                                                            this->base->get_order()));
+                this->datas.emplace_back (static_cast<std::size_t>(w) * h, T{0});
+            }
+
+            this->refresh();
+        }
+
+        //! The number of levels, including level 0 (the base grid and data)
+        unsigned int n_levels() const { return static_cast<unsigned int>(this->grids.size()) + 1u; }
+
+        //! The Grid for level \a l. Level 0 is the base grid.
+        const morph::Grid<I, C>* grid (const unsigned int l) const
+        {
+            if (l >= this->n_levels()) { throw std::runtime_error ("GridPyramid: no such level"); }
+            return l == 0 ? this->base : this->grids[l - 1].get();
+        }
+
+        //! The data for level \a l. Level 0 is the base data.
+        std::span<const T> data (const unsigned int l) const
+        {
+            if (l >= this->n_levels()) { throw std::runtime_error ("GridPyramid: no such level"); }
+            return l == 0 ? this->basedata : std::span<const T> (this->datas[l - 1]);
+        }
+
+        //! Recompute every reduced level from the base data
+        void refresh()
+        {
+            for (unsigned int l = 1; l < this->n_levels(); ++l) {
+                this->reduce_level (l, I{0}, I{0},
+                                    this->grid (l)->get_w() - I{1}, this->grid (l)->get_h() - I{1});
+            }
+        }
+
+        /*!
+         * Recompute only the cells covering the base-grid rectangle of \a wr x \a hr
+         * pixels whose lowest-index corner is (\a x0, \a y0). At each level, the
+         * affected rectangle halves, so a small change costs O(log n) cell updates
+         * rather than a full rebuild.
+         */
+        void refresh_region (I x0, I y0, I wr, I hr)
+        {
+            if (wr == I{0} || hr == I{0}) { return; }
+            I x1 = x0 + wr - I{1};
+            I y1 = y0 + hr - I{1};
+            for (unsigned int l = 1; l < this->n_levels(); ++l) {
+                x0 /= I{2};
+                y0 /= I{2};
+                x1 /= I{2};
+                y1 /= I{2};
+                const I xmax = this->grid (l)->get_w() - I{1};
+                const I ymax = this->grid (l)->get_h() - I{1};
+                this->reduce_level (l, std::min (x0, xmax), std::min (y0, ymax),
+                                    std::min (x1, xmax), std::min (y1, ymax));
+            }
+        }
+
+    private:
+        //! The storage index of cell (x, y) in a w x h grid of the base grid's order
+        std::size_t cell_index (const morph::Grid<I, C>* g, const I x, const I y) const
+        {
+            return g->rowmaj() == true
+                ? static_cast<std::size_t>(y) * g->get_w() + x
+                : static_cast<std::size_t>(x) * g->get_h() + y;
+        }
+
+        //! Box-reduce level \a l - 1 into level \a l for the inclusive coarse-cell
+        //! range (x0, y0) to (x1, y1). Each coarse cell is the mean of the (up to) 2x2
+        //! fine cells it covers.
+        void reduce_level (const unsigned int l, const I x0, const I y0, const I x1, const I y1)
+        {
+            const morph::Grid<I, C>* gf = this->grid (l - 1);
+            const morph::Grid<I, C>* gc = this->grid (l);
+            std::span<const T> fine = this->data (l - 1);
+            std::vector<T>& coarse = this->datas[l - 1];
+            const I wf = gf->get_w();
+            const I hf = gf->get_h();
+#pragma omp parallel for
+            for (I y = y0; y <= y1; ++y) {
+                for (I x = x0; x <= x1; ++x) {
+                    T sum = T{0};
+                    unsigned int n = 0;
+                    for (I yf = y * I{2}; yf <= y * I{2} + I{1} && yf < hf; ++yf) {
+                        for (I xf = x * I{2}; xf <= x * I{2} + I{1} && xf < wf; ++xf) {
+                            sum += fine[this->cell_index (gf, xf, yf)];
+                            ++n;
+                        }
+                    }
+                    coarse[this->cell_index (gc, x, y)] = sum / static_cast<T>(n);
+                }
+            }
+        }
+
+        //! The base grid (level 0), not owned
+        const morph::Grid<I, C>* base = nullptr;
+        //! The base data (level 0), not owned
+        std::span<const T> basedata;
+        //! The reduced grids, coarsest last
+        std::vector<std::unique_ptr<morph::Grid<I, C>>> grids;
+        //! The reduced data, matching this->grids
+        std::vector<std::vector<T>> datas;
+    };
+
+} // namespace morph
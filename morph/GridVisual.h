@@ -4,8 +4,11 @@
 #include <morph/VisualDataModel.h>
 #include <morph/Grid.h>
 #include <morph/GridFeatures.h>
+#include <morph/GridPyramid.h>
+#include <morph/mathconst.h>
 #include <morph/vec.h>
 #include <morph/flags.h>
+#include <cmath>
 #include <iostream>
 #include <vector>
 #include <array>
@@ -65,6 +68,80 @@ namespace morph {
             // Note: VisualModel::finalize() should be called before rendering
         }
 
+        //! Update just the colours from new scalar data (for example, if you are visualizing the
+        //! grid flat, so that the z relief cannot have changed). See reinitColours.
+        void updateColours (const std::vector<T>* _data) override
+        {
+            this->scalarData = _data;
+            this->reinitColours();
+        }
+
+        /*!
+         * Enable mipmap-style level of detail from the data pyramid \a py, whose base
+         * grid must be the Grid this GridVisual was constructed with. Each frame,
+         * render() picks the pyramid level whose pixels project to about lod_px screen
+         * pixels and draws that level's grid and data, refining one level per frame on
+         * zoom-in - so drawing a huge field costs what is visible, not the field size.
+         * While a pyramid is set, update the data through the pyramid (refresh() or
+         * refresh_region()) and then call reinit(). Pass nullptr to go back to drawing
+         * the full-resolution data.
+         */
+        void setPyramid (const morph::GridPyramid<T, I, C>* py)
+        {
+            if (py == nullptr) {
+                // Back to full resolution
+                if (this->pyramid != nullptr) {
+                    this->grid = this->pyramid->grid (0);
+                    this->bindScalarData (this->pyramid->data (0));
+                }
+                this->pyramid = nullptr;
+                this->lod_level = -1;
+                return;
+            }
+            // Start at the coarsest level - the first build is then instant even for a
+            // huge field - and let render() refine towards the right level
+            this->pyramid = py;
+            this->lod_level = static_cast<int>(py->n_levels()) - 1;
+            this->grid = py->grid (this->lod_level);
+            this->bindScalarData (py->data (this->lod_level));
+        }
+
+        //! The pyramid level currently drawn (0 is full resolution; -1 if no pyramid is set)
+        int get_lod_level() const { return this->pyramid == nullptr ? -1 : this->lod_level; }
+
+        //! Render, first selecting the pyramid level to draw if a pyramid has been set
+        void render()
+        {
+            if (this->pyramid != nullptr) { this->lod_update(); }
+            morph::VisualModel<glver>::render();
+        }
+
+        //! The target on-screen size of one drawn pixel, in screen pixels, when a
+        //! pyramid is set. The level is refined until pixels project no smaller than this.
+        float lod_px = 2.0f;
+
+        //! Assign per-vertex element ids for the picking pass (see VisualBase::pick).
+        //! Each pixel's vertices take the pixel's index within the grid; any vertices
+        //! beyond the data region (borders etc.) carry no id and pick as element -1.
+        void fillPickIDs() override
+        {
+            std::size_t vpp = 0;
+            switch (this->gridVisMode) {
+            case GridVisMode::Triangles: { vpp = 1u; break; }
+            case GridVisMode::Columns: { vpp = 13u; break; }
+            case GridVisMode::Pixels:
+            case GridVisMode::RectInterp:
+            default: { vpp = 5u; break; }
+            }
+            std::size_t n_data_verts = (this->grid == nullptr ? 0u : static_cast<std::size_t>(this->grid->n())) * vpp;
+            std::size_t nverts = this->vertexPositions.size() / 3u;
+            if (n_data_verts == 0u || n_data_verts > nverts) { this->pickIDs.clear(); return; }
+            this->pickIDs.assign (nverts, this->pick_id_none);
+            for (std::size_t v = 0; v < n_data_verts; ++v) {
+                this->pickIDs[v] = static_cast<float>(v / vpp);
+            }
+        }
+
         // If you only need to change the colours in your GridVisual (for example, if you are
         // visualizing it flat), then it is about 4 times faster to only update the colours.
         void reinitColours()
@@ -100,7 +177,7 @@ namespace morph {
             }
 
             // now sub-call the scalar or vector reinit colours function
-            if (this->scalarData != nullptr) {
+            if (this->scalarDataSpan().empty() == false) {
                 this->reinitColoursScalar (n_data, n_cvertices_per_datum);
             } else if (this->vectorData != nullptr) {
                 this->reinitColoursVector (n_data, n_cvertices_per_datum);
@@ -347,16 +424,17 @@ namespace morph {
             if (this->grid == nullptr) {
                 throw std::runtime_error ("GridVisual error: grid is a nullptr");
             }
-            if (this->scalarData != nullptr) {
+            std::span<const T> sdata = this->scalarDataSpan();
+            if (sdata.empty() == false) {
                 // Check scalar data has same size as Grid
-                if (this->scalarData->size() != static_cast<std::size_t>(this->grid->n())) {
+                if (sdata.size() != static_cast<std::size_t>(this->grid->n())) {
                     throw std::runtime_error ("GridVisual error: grid size does not match scalarData size");
                 }
 
-                this->dcopy.resize (this->scalarData->size());
-                this->zScale.transform (*(this->scalarData), dcopy);
-                this->dcolour.resize (this->scalarData->size());
-                this->colourScale.transform (*(this->scalarData), dcolour);
+                this->dcopy.resize (sdata.size());
+                this->zScale.transform (sdata.data(), dcopy.data(), sdata.size());
+                this->dcolour.resize (sdata.size());
+                this->colourScale.transform (sdata.data(), dcolour.data(), sdata.size());
 
             } else if (this->vectorData != nullptr) {
 
@@ -562,6 +640,26 @@ namespace morph {
                     }
                 }
 
+            } else if (this->grid->get_order() == morph::GridOrder::morton) {
+                // Morton order: element index and storage position are related by bit
+                // interleave, so go through the Grid's row/col and neighbour API. Each
+                // element that is not on the top row or right column hosts two triangles.
+                ind_idx = i0;
+                const I nn = static_cast<I>(this->grid->n());
+                for (I ii = 0; ii < nn; ++ii) {
+                    if (this->grid->col (ii) >= ci_sz || this->grid->row (ii) >= ri_sz) { continue; }
+                    const I i_ne = this->grid->index_ne (ii);
+                    const I i_nn = this->grid->index_nn (ii);
+                    const I i_nne = this->grid->index_nne (ii);
+                    // Triangle 1
+                    this->indices[ind_idx++] = (ii);
+                    this->indices[ind_idx++] = (i_nne);
+                    this->indices[ind_idx++] = (i_ne);
+                    // Triangle 2
+                    this->indices[ind_idx++] = (ii);
+                    this->indices[ind_idx++] = (i_nn);
+                    this->indices[ind_idx++] = (i_nne);
+                }
             } else {
                 throw std::runtime_error ("morph::GridVisual: Unhandled morph::GridOrder");
             }
@@ -1154,8 +1252,9 @@ namespace morph {
         void reinitColoursScalar (const std::size_t n_data, const std::size_t n_cvertices_per_datum)
         {
             if (this->colourScale.do_autoscale == true) { this->colourScale.reset(); }
-            this->dcolour.resize (this->scalarData->size());
-            this->colourScale.transform (*(this->scalarData), dcolour);
+            std::span<const T> sdata = this->scalarDataSpan();
+            this->dcolour.resize (sdata.size());
+            this->colourScale.transform (sdata.data(), dcolour.data(), sdata.size());
 
             // Replace elements of vertexColors
             for (std::size_t i = 0u; i < n_data; ++i) {
@@ -1223,6 +1322,44 @@ namespace morph {
             return clr;
         }
 
+        //! Choose the pyramid level from the projected size of a full-resolution pixel
+        //! and rebuild the model if the level changes. Refinement (towards level 0)
+        //! steps one level per frame; coarsening happens at once.
+        void lod_update()
+        {
+            // Eye-space distance from the camera to the model origin
+            const morph::vec<float, 4> ctr = this->scenematrix * this->viewmatrix * morph::vec<float, 4>{ 0.0f, 0.0f, 0.0f, 1.0f };
+            float fov = 30.0f;
+            float znear = 0.001f;
+            int win_h = 480;
+            if (this->parentVis != nullptr) {
+                fov = this->parentVis->fov;
+                znear = this->parentVis->zNear;
+                win_h = this->parentVis->get_winsize()[1];
+            }
+            const float dist = std::max (std::sqrt (ctr[0] * ctr[0] + ctr[1] * ctr[1] + ctr[2] * ctr[2]), znear);
+            const float px_per_unit = static_cast<float>(win_h)
+                / (2.0f * dist * std::tan (fov * 0.5f * morph::mathconst<float>::deg2rad));
+
+            // The on-screen size of a full-resolution pixel; each level doubles it.
+            // Coarsen while pixels would project smaller than lod_px.
+            const float base_px = this->pyramid->grid (0)->get_dx()[0] * px_per_unit;
+            const int n_lev = static_cast<int>(this->pyramid->n_levels());
+            int target = 0;
+            while (target < n_lev - 1 && base_px * static_cast<float>(1 << target) < this->lod_px) { ++target; }
+
+            if (target == this->lod_level) { return; }
+            this->lod_level = (target < this->lod_level) ? this->lod_level - 1 : target;
+            this->grid = this->pyramid->grid (this->lod_level);
+            this->bindScalarData (this->pyramid->data (this->lod_level));
+            morph::VisualModel<glver>::reinit();
+        }
+
+        //! The data pyramid to draw from, if level-of-detail selection is enabled (see setPyramid)
+        const morph::GridPyramid<T, I, C>* pyramid = nullptr;
+        //! The pyramid level currently drawn; -1 when no pyramid is set
+        int lod_level = -1;
+
         //! The morph::Grid<> to visualize
         const morph::Grid<I, C>* grid;
 
@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <stdexcept>
 #include <morph/vec.h>
 #include <morph/vvec.h>
 #include <morph/GridFeatures.h>
@@ -355,6 +357,79 @@ namespace morph {
         //! Return the coordinates of the centre of the grid
         constexpr morph::vec<C, 2> centre() const { return morph::vec<C, 2>({ xmax() - xmin(), ymax() - ymin() }) * 0.5f; }
 
+        /*!
+         * Constexpr-resolved neighbour offsets, valid for *interior* elements (those whose row is
+         * neither the first nor the last and whose column is neither the first nor the last). For
+         * these elements no wrap or boundary logic is needed; the neighbour index is just
+         * index + interior_offset_*. Exposed for user stencil code; stencil_apply() uses them for
+         * its interior fast path.
+         */
+        static constexpr std::ptrdiff_t interior_offset_ne = std::ptrdiff_t{1};
+        static constexpr std::ptrdiff_t interior_offset_nw = -std::ptrdiff_t{1};
+        static constexpr std::ptrdiff_t interior_offset_nn = (order == morph::GridOrder::bottomleft_to_topright)
+                                                             ? static_cast<std::ptrdiff_t>(w) : -static_cast<std::ptrdiff_t>(w);
+        static constexpr std::ptrdiff_t interior_offset_ns = -interior_offset_nn;
+
+        /*!
+         * Apply the 5-point stencil function \a fn to every element of \a data, writing into \a
+         * result (which must be separate memory of the same size). \a fn is called as
+         * fn (centre, east, west, north, south) and returns the new value for the element.
+         *
+         * Interior elements are processed in a loop with the constexpr interior_offset_* neighbour
+         * offsets and no wrap/boundary branches at all, so the compiler can unroll and vectorize
+         * it; only the 2w + 2h - 4 edge elements take the branchy index_n*() path (on which the
+         * wrap template argument resolves via if constexpr). Where an edge element has no
+         * neighbour in some direction, the centre element's value is passed for that neighbour
+         * (the zero-gradient boundary condition, which makes a Laplacian stencil no-flux).
+         */
+        template <typename Ctnr, typename Func>
+        void stencil_apply (const Ctnr& data, Ctnr& result, Func fn) const
+        {
+            if (data.size() < n || result.size() < n) {
+                throw std::runtime_error ("Gridct::stencil_apply: data and result must have Gridct::n elements");
+            }
+            if (&data == &result) {
+                throw std::runtime_error ("Gridct::stencil_apply: pass in separate memory for the result");
+            }
+
+            // The branch-free interior (empty if the grid is less than 3 elements wide or high)
+            if constexpr (w > 2 && h > 2) {
+                for (I r = 1; r < h - 1; ++r) {
+                    const std::ptrdiff_t rowstart = static_cast<std::ptrdiff_t>(r) * w;
+                    for (std::ptrdiff_t i = rowstart + 1; i < rowstart + w - 1; ++i) {
+                        result[i] = fn (data[i],
+                                        data[i + interior_offset_ne], data[i + interior_offset_nw],
+                                        data[i + interior_offset_nn], data[i + interior_offset_ns]);
+                    }
+                }
+            }
+
+            // The edge elements, with wrap resolved by the index_n*() methods
+            auto apply_edge = [this, &data, &result, &fn] (const I i)
+            {
+                const I e = this->index_ne (i);
+                const I _w = this->index_nw (i);
+                const I _n = this->index_nn (i);
+                const I s = this->index_ns (i);
+                result[i] = fn (data[i],
+                                e < n ? data[e] : data[i], _w < n ? data[_w] : data[i],
+                                _n < n ? data[_n] : data[i], s < n ? data[s] : data[i]);
+            };
+            if constexpr (w > 2 && h > 2) {
+                for (I c = 0; c < w; ++c) {
+                    apply_edge (c);                 // first row
+                    apply_edge (w * (h - 1) + c);   // last row
+                }
+                for (I r = 1; r < h - 1; ++r) {
+                    apply_edge (w * r);             // first column
+                    apply_edge (w * r + (w - 1));   // last column
+                }
+            } else {
+                // Degenerate grid; every element is an edge element
+                for (I i = 0; i < n; ++i) { apply_edge (i); }
+            }
+        }
+
         //! Return the row for the index
         constexpr I row (const I index) const { return index < n ? index / w : std::numeric_limits<I>::max(); }
 
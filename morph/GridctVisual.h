@@ -45,6 +45,15 @@ namespace morph {
             // Note: VisualModel::finalize() should be called before rendering
         }
 
+        //! The number of grid elements, known at compile time
+        static constexpr std::size_t n_elements = static_cast<std::size_t>(w) * static_cast<std::size_t>(h);
+        //! Vertex float-count (x/y/z per vertex) and index count for GridVisMode::Triangles
+        static constexpr std::size_t tris_vertex_floats = 3u * n_elements;
+        static constexpr std::size_t tris_index_count = 6u * (static_cast<std::size_t>(w) - 1u) * (static_cast<std::size_t>(h) - 1u);
+        //! Vertex float-count and index count for GridVisMode::RectInterp (5 vertices, 4 triangles per rect)
+        static constexpr std::size_t rect_vertex_floats = 15u * n_elements;
+        static constexpr std::size_t rect_index_count = 12u * n_elements;
+
         //! Do the computations to initialize the vertices that will represent the HexGrid.
         void initializeVertices()
         {
@@ -54,12 +63,22 @@ namespace morph {
             switch (this->gridVisMode) {
             case GridVisMode::Triangles:
             {
+                // The buffer sizes are compile-time constants, so make each buffer's
+                // single, exact allocation before filling
+                this->vertexPositions.reserve (tris_vertex_floats);
+                this->vertexNormals.reserve (tris_vertex_floats);
+                this->vertexColors.reserve (tris_vertex_floats);
+                this->indices.reserve (tris_index_count);
                 this->initializeVerticesTris();
                 break;
             }
             case GridVisMode::RectInterp:
             default:
             {
+                this->vertexPositions.reserve (rect_vertex_floats);
+                this->vertexNormals.reserve (rect_vertex_floats);
+                this->vertexColors.reserve (rect_vertex_floats);
+                this->indices.reserve (rect_index_count);
                 this->initializeVerticesRectsInterpolated();
                 break;
             }
@@ -91,33 +110,13 @@ namespace morph {
         //! Initialize as a minimal, triangled surface
         void initializeVerticesTris()
         {
+            // The Grid's order is a template parameter, so unsupported orders fail at compile time
+            static_assert (order == morph::GridOrder::bottomleft_to_topright
+                           || order == morph::GridOrder::topleft_to_bottomright,
+                           "morph::GridctVisual: Unhandled morph::GridOrder");
             this->idx = 0;
 
-            if (this->scalarData != nullptr) {
-                this->dcopy.resize (this->scalarData->size());
-                this->zScale.transform (*(this->scalarData), dcopy);
-                this->dcolour.resize (this->scalarData->size());
-                this->colourScale.transform (*(this->scalarData), dcolour);
-            } else if (this->vectorData != nullptr) {
-                this->dcopy.resize (this->vectorData->size());
-                this->dcolour.resize (this->vectorData->size());
-                this->dcolour2.resize (this->vectorData->size());
-                this->dcolour3.resize (this->vectorData->size());
-                std::vector<float> veclens(dcopy);
-                for (unsigned int i = 0; i < this->vectorData->size(); ++i) {
-                    veclens[i] = (*this->vectorData)[i].length();
-                    this->dcolour[i] = (*this->vectorData)[i][0];
-                    this->dcolour2[i] = (*this->vectorData)[i][1];
-                    // Could also extract a third colour for Trichrome vs Duochrome
-                    this->dcolour3[i] = (*this->vectorData)[i][2];
-                }
-                this->zScale.transform (veclens, this->dcopy);
-                if (this->cm.getType() != morph::ColourMapType::RGB) {
-                    this->colourScale.transform (this->dcolour, this->dcolour);
-                    this->colourScale2.transform (this->dcolour2, this->dcolour2);
-                    this->colourScale3.transform (this->dcolour3, this->dcolour3);
-                }
-            }
+            this->stageData();
 
             for (unsigned int ri = 0; ri < this->grid->n; ++ri) {
                 std::array<float, 3> clr = this->setColour (ri);
@@ -127,38 +126,38 @@ namespace morph {
                 this->vertex_push (0.0f, 0.0f, 1.0f, this->vertexNormals);
             }
 
-            // Build indices row by row.
-            auto dims = this->grid->get_dims();
-            if (this->grid->get_order() == morph::GridOrder::bottomleft_to_topright) {
-                for (unsigned int ri = 0; ri < dims[1]-1; ++ri) {
-                    for (unsigned int ci = 0; ci < dims[0]-1; ++ci) {
+            // Build indices row by row. The dimensions w/h and the order are template
+            // parameters, so the order branch resolves at compile time and the loop
+            // bounds are constants, which lets the compiler unroll these loops fully
+            // for small fixed grids.
+            if constexpr (order == morph::GridOrder::bottomleft_to_topright) {
+                for (unsigned int ri = 0; ri < h-1; ++ri) {
+                    for (unsigned int ci = 0; ci < w-1; ++ci) {
                         // Triangle 1
-                        unsigned int ii = ri * dims[0] + ci;
+                        unsigned int ii = ri * w + ci;
                         this->indices.push_back (ii);
-                        this->indices.push_back (ii + dims[0] + 1); // NNE
-                        this->indices.push_back (ii + 1);           // NE
+                        this->indices.push_back (ii + w + 1); // NNE
+                        this->indices.push_back (ii + 1);     // NE
                         // Triangle 2
                         this->indices.push_back (ii);
-                        this->indices.push_back (ii + dims[0]);     // NN
-                        this->indices.push_back (ii + dims[0] + 1); // NNE
+                        this->indices.push_back (ii + w);     // NN
+                        this->indices.push_back (ii + w + 1); // NNE
                     }
                 }
-            } else if (this->grid->get_order() == morph::GridOrder::topleft_to_bottomright) {
-                for (unsigned int ri = 0; ri < dims[1]-1; ++ri) {
-                    for (unsigned int ci = 0; ci < dims[0]-1; ++ci) {
+            } else { // topleft_to_bottomright (the static_assert above excludes the rest)
+                for (unsigned int ri = 0; ri < h-1; ++ri) {
+                    for (unsigned int ci = 0; ci < w-1; ++ci) {
                         // Triangle 1
-                        unsigned int ii = ri * dims[0] + ci;
+                        unsigned int ii = ri * w + ci;
                         this->indices.push_back (ii);
                         this->indices.push_back (ii + 1);
-                        this->indices.push_back (ii + dims[0] + 1); // NSE
+                        this->indices.push_back (ii + w + 1); // NSE
                         // Triangle 2
                         this->indices.push_back (ii);
-                        this->indices.push_back (ii + dims[0] + 1); // NSE
-                        this->indices.push_back (ii + dims[0]);     // NS
+                        this->indices.push_back (ii + w + 1); // NSE
+                        this->indices.push_back (ii + w);     // NS
                     }
                 }
-            } else {
-                throw std::runtime_error ("morph::GridctVisual: Unhandled morph::GridOrder");
             }
 
             this->idx += this->grid->n;
@@ -174,38 +173,8 @@ namespace morph {
 
             this->idx = 0;
 
-            if (this->scalarData != nullptr) {
-                this->dcopy.resize (this->scalarData->size());
-                this->zScale.transform (*(this->scalarData), dcopy);
-                this->dcolour.resize (this->scalarData->size());
-                this->colourScale.transform (*(this->scalarData), dcolour);
-            } else if (this->vectorData != nullptr) {
-                this->dcopy.resize (this->vectorData->size());
-                this->dcolour.resize (this->vectorData->size());
-                this->dcolour2.resize (this->vectorData->size());
-                this->dcolour3.resize (this->vectorData->size());
-                std::vector<float> veclens(dcopy);
-                for (unsigned int i = 0; i < this->vectorData->size(); ++i) {
-                    veclens[i] = (*this->vectorData)[i].length();
-                    this->dcolour[i] = (*this->vectorData)[i][0];
-                    this->dcolour2[i] = (*this->vectorData)[i][1];
-                    // Could also extract a third colour for Trichrome vs Duochrome (or for raw RGB signal)
-                    this->dcolour3[i] = (*this->vectorData)[i][2];
-                }
-                this->zScale.transform (veclens, this->dcopy);
+            this->stageData();
 
-                // Handle case where this->cm.getType() == morph::ColourMapType::RGB and there is
-                // exactly one colour. ColourMapType::RGB assumes R/G/B data all in range 0->1
-                // ALREADY and therefore they don't need to be re-scaled with this->colourScale.
-                if (this->cm.getType() != morph::ColourMapType::RGB) {
-                    this->colourScale.transform (this->dcolour, this->dcolour);
-                    // Dual axis colour maps like Duochrome and HSV will need to use colourScale2 to
-                    // transform their second colour/axis,
-                    this->colourScale2.transform (this->dcolour2, this->dcolour2);
-                    // Similarly for Triple axis maps
-                    this->colourScale3.transform (this->dcolour3, this->dcolour3);
-                } // else assume dcolour/dcolour2/dcolour3 are all in range 0->1 (or 0-255) already
-            }
             float datumC = 0.0f;   // datum at the centre
             float datumNE = 0.0f;  // datum at the hex to the east.
             float datumNNE = 0.0f;
@@ -367,6 +336,47 @@ namespace morph {
         float border_thickness_fixed = 0.0f;
 
     protected:
+        /*!
+         * Scale the scalar (or vector) data into the fixed-size staging arrays dcopy
+         * (z position) and dcolour/dcolour2/dcolour3 (colour axes). The staging arrays
+         * are std::arrays sized from the Gridct template parameters, so this involves
+         * no allocation; the array overload of scale::transform is used throughout.
+         */
+        void stageData()
+        {
+            if (this->scalarData != nullptr) {
+                if (this->scalarData->size() < n_elements) {
+                    throw std::runtime_error ("morph::GridctVisual: scalarData is smaller than the Gridct");
+                }
+                this->zScale.transform (this->scalarData->data(), this->dcopy.data(), n_elements);
+                this->colourScale.transform (this->scalarData->data(), this->dcolour.data(), n_elements);
+            } else if (this->vectorData != nullptr) {
+                if (this->vectorData->size() < n_elements) {
+                    throw std::runtime_error ("morph::GridctVisual: vectorData is smaller than the Gridct");
+                }
+                for (std::size_t i = 0; i < n_elements; ++i) {
+                    this->dcopy[i] = (*this->vectorData)[i].length(); // then scaled in place below
+                    this->dcolour[i] = (*this->vectorData)[i][0];
+                    this->dcolour2[i] = (*this->vectorData)[i][1];
+                    // Could also extract a third colour for Trichrome vs Duochrome (or for raw RGB signal)
+                    this->dcolour3[i] = (*this->vectorData)[i][2];
+                }
+                this->zScale.transform (this->dcopy.data(), this->dcopy.data(), n_elements);
+
+                // Handle case where this->cm.getType() == morph::ColourMapType::RGB and there is
+                // exactly one colour. ColourMapType::RGB assumes R/G/B data all in range 0->1
+                // ALREADY and therefore they don't need to be re-scaled with this->colourScale.
+                if (this->cm.getType() != morph::ColourMapType::RGB) {
+                    this->colourScale.transform (this->dcolour.data(), this->dcolour.data(), n_elements);
+                    // Dual axis colour maps like Duochrome and HSV will need to use colourScale2 to
+                    // transform their second colour/axis,
+                    this->colourScale2.transform (this->dcolour2.data(), this->dcolour2.data(), n_elements);
+                    // Similarly for Triple axis maps
+                    this->colourScale3.transform (this->dcolour3.data(), this->dcolour3.data(), n_elements);
+                } // else assume dcolour/dcolour2/dcolour3 are all in range 0->1 (or 0-255) already
+            }
+        }
+
         //! An overridable function to set the colour of rect ri
         std::array<float, 3> setColour (unsigned int ri)
         {
@@ -391,12 +401,14 @@ namespace morph {
         //! The morph::Gridct to visualize
         const morph::Gridct<I, C, w, h, dx, offset, memory_coords, wrap, order>* grid;
 
-        //! A copy of the scalarData which can be transformed suitably to be the z value of the surface
-        std::vector<float> dcopy;
+        //! A copy of the scalarData which can be transformed suitably to be the z value of the
+        //! surface. With the grid dimensions known at compile time, the staging copies are
+        //! fixed-size arrays - no allocation occurs when (re)initializing the vertices.
+        std::array<float, n_elements> dcopy;
         //! A copy of the scalarData (or first field of vectorData), scaled to be a colour value
-        std::vector<float> dcolour;
-        std::vector<float> dcolour2;
-        std::vector<float> dcolour3;
+        std::array<float, n_elements> dcolour;
+        std::array<float, n_elements> dcolour2;
+        std::array<float, n_elements> dcolour3;
 
         // A centering offset to make sure that the Cartgrid is centred on
         // this->mv_offset. This is computed so that you *add* centering_offset to each
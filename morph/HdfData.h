@@ -14,6 +14,7 @@
 #include <hdf5.h>
 #include <vector>
 #include <array>
+#include <span>
 #include <list>
 #include <string>
 #include <utility>
@@ -21,8 +22,14 @@
 #include <cstddef>
 #include <sstream>
 #include <stdexcept>
+#include <map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
 #include <morph/vec.h>
 #include <morph/vvec.h>
+#include <morph/profile.h>
 #include <morph/tools.h>
 
 #ifdef _MSC_VER
@@ -57,6 +64,33 @@ namespace morph {
         ReadWrite
     };
 
+    /*!
+     * Options controlling the dataset creation property list that HdfData uses when it creates
+     * datasets. The defaults give the historical behaviour: contiguous, uncompressed storage.
+     * Set deflate_level > 0 (before calling the add_* methods) to get chunked, deflate
+     * (gzip) compressed datasets, which makes an enormous difference to the file size and write
+     * time of large, compressible payloads such as float fields.
+     */
+    struct DatasetOptions
+    {
+        /*!
+         * Deflate (gzip) compression level, 0-9. 0 (the default) means no compression and, if
+         * chunk_elements is also 0, contiguous storage. Level 1 is fast and is usually most of
+         * the win for float field data; levels above ~4 cost time for little extra compression.
+         */
+        unsigned int deflate_level = 0;
+        //! If true, apply the byte-shuffle filter before deflate. Shuffling groups the bytes of
+        //! the floats by significance, which typically improves compression of numeric data.
+        bool shuffle = true;
+        /*!
+         * The chunk extent, in elements, along the first (slowest varying) dimension; any
+         * further dimensions are chunked at their full extent. 0 means choose automatically
+         * (chunks of about 1 MiB). Chunking is required by HDF5 for compression; if the dataset
+         * is smaller than one chunk, the chunk is shrunk to fit.
+         */
+        hsize_t chunk_elements = 0;
+    };
+
     /*!
      * Very simple data access class, wrapping around the HDF5 C API. Operates either in
      * write mode (the default) or read mode. Choose which when constructing.
@@ -88,9 +122,113 @@ namespace morph {
          * case, create it and if that fails, open it. When opening for writing, this
          * call should be followed by a call to check_dataset_space_1_dim/2_dims
          */
+        /*!
+         * Build a dataset creation property list from this->dataset_options, for the dataset
+         * described by dtype_id/space_id. Returns H5P_DEFAULT (with nothing to close) when the
+         * options are at their contiguous/uncompressed defaults or the dataspace cannot be
+         * chunked (it is scalar, or has a zero-sized dimension).
+         */
+        hid_t make_dcpl (hid_t dtype_id, hid_t space_id) const
+        {
+            if (this->dataset_options.deflate_level == 0 && this->dataset_options.chunk_elements == 0) {
+                return H5P_DEFAULT;
+            }
+            hsize_t dims[H5S_MAX_RANK] = {0};
+            int ndims = H5Sget_simple_extent_dims (space_id, dims, nullptr);
+            if (ndims < 1) { return H5P_DEFAULT; }
+
+            hsize_t chunk_dims[H5S_MAX_RANK] = {0};
+            // Trailing dimensions are chunked at full extent; count their elements
+            hsize_t row_elements = 1;
+            for (int i = 1; i < ndims; ++i) {
+                chunk_dims[i] = dims[i];
+                row_elements *= dims[i];
+            }
+            hsize_t c0 = this->dataset_options.chunk_elements;
+            if (c0 == 0) {
+                // Aim for chunks of about 1 MiB
+                std::size_t tsz = H5Tget_size (dtype_id);
+                if (tsz == 0) { tsz = 4; }
+                c0 = (hsize_t{1} << 20) / (tsz * row_elements);
+                if (c0 == 0) { c0 = 1; }
+            }
+            chunk_dims[0] = dims[0] < c0 ? dims[0] : c0;
+            // A zero-sized dimension can't be chunked
+            for (int i = 0; i < ndims; ++i) { if (chunk_dims[i] == 0) { return H5P_DEFAULT; } }
+
+            hid_t dcpl_id = H5Pcreate (H5P_DATASET_CREATE);
+            if (dcpl_id < 0) { return H5P_DEFAULT; }
+            H5Pset_chunk (dcpl_id, ndims, chunk_dims);
+            if (this->dataset_options.deflate_level > 0) {
+                if (this->dataset_options.shuffle == true) { H5Pset_shuffle (dcpl_id); }
+                H5Pset_deflate (dcpl_id, this->dataset_options.deflate_level);
+            }
+            return dcpl_id;
+        }
+
+        //! The little-endian file datatype in which to store elements of type T
+        template <typename T>
+        hid_t file_dtype() const
+        {
+            if constexpr (std::is_same<std::decay_t<T>, double>::value == true) {
+                return H5T_IEEE_F64LE;
+            } else if constexpr (std::is_same<std::decay_t<T>, float>::value == true) {
+                return H5T_IEEE_F32LE;
+            } else if constexpr (std::is_same<std::decay_t<T>, int>::value == true) {
+                return H5T_STD_I32LE;
+            } else if constexpr (std::is_same<std::decay_t<T>, unsigned int>::value == true) {
+                return H5T_STD_U32LE;
+            } else if constexpr (std::is_same<std::decay_t<T>, short>::value == true) {
+                return H5T_STD_I16LE;
+            } else if constexpr (std::is_same<std::decay_t<T>, unsigned short>::value == true) {
+                return H5T_STD_U16LE;
+            } else if constexpr (std::is_same<std::decay_t<T>, long long int>::value == true) {
+                return H5T_STD_I64LE;
+            } else if constexpr (std::is_same<std::decay_t<T>, unsigned long long int>::value == true) {
+                return H5T_STD_U64LE;
+            } else if constexpr (std::is_same<std::decay_t<T>, char>::value == true) {
+                return H5T_STD_I8LE;
+            } else if constexpr (std::is_same<std::decay_t<T>, unsigned char>::value == true) {
+                return H5T_STD_U8LE;
+            } else {
+                []<bool flag = false>() { static_assert(flag, "HdfData::file_dtype: unsupported type"); }();
+            }
+        }
+
+        //! The in-memory (native) datatype for elements of type T
+        template <typename T>
+        hid_t mem_dtype() const
+        {
+            if constexpr (std::is_same<std::decay_t<T>, double>::value == true) {
+                return H5T_NATIVE_DOUBLE;
+            } else if constexpr (std::is_same<std::decay_t<T>, float>::value == true) {
+                return H5T_NATIVE_FLOAT;
+            } else if constexpr (std::is_same<std::decay_t<T>, int>::value == true) {
+                return H5T_NATIVE_INT;
+            } else if constexpr (std::is_same<std::decay_t<T>, unsigned int>::value == true) {
+                return H5T_NATIVE_UINT;
+            } else if constexpr (std::is_same<std::decay_t<T>, short>::value == true) {
+                return H5T_NATIVE_SHORT;
+            } else if constexpr (std::is_same<std::decay_t<T>, unsigned short>::value == true) {
+                return H5T_NATIVE_USHORT;
+            } else if constexpr (std::is_same<std::decay_t<T>, long long int>::value == true) {
+                return H5T_NATIVE_LLONG;
+            } else if constexpr (std::is_same<std::decay_t<T>, unsigned long long int>::value == true) {
+                return H5T_NATIVE_ULLONG;
+            } else if constexpr (std::is_same<std::decay_t<T>, char>::value == true) {
+                return H5T_NATIVE_CHAR;
+            } else if constexpr (std::is_same<std::decay_t<T>, unsigned char>::value == true) {
+                return H5T_NATIVE_UCHAR;
+            } else {
+                []<bool flag = false>() { static_assert(flag, "HdfData::mem_dtype: unsupported type"); }();
+            }
+        }
+
         hid_t open_dataset (const char* path, hid_t dtype_id, hid_t space_id)
         {
-            hid_t dataset_id = H5Dcreate2 (this->file_id, path, dtype_id, space_id, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+            hid_t dcpl_id = this->make_dcpl (dtype_id, space_id);
+            hid_t dataset_id = H5Dcreate2 (this->file_id, path, dtype_id, space_id, H5P_DEFAULT, dcpl_id, H5P_DEFAULT);
+            if (dcpl_id != H5P_DEFAULT) { H5Pclose (dcpl_id); }
             if (this->file_access == FileAccess::ReadWrite) {
                 if (dataset_id < 0) {
                     dataset_id = H5Dopen2 (this->file_id, path, H5P_DEFAULT);
@@ -102,6 +240,39 @@ namespace morph {
             return dataset_id;
         }
 
+        /*!
+         * Open the dataset at \a path for reading. With cache_read_handles set, the
+         * handle from a previous open of the same path is returned instead of
+         * H5Dopen2-ing again - the H5Dopen2/H5Dclose metadata work is what dominates
+         * when re-reading many small datasets - and stays open until the file is
+         * closed. Every read path opens through here and closes through
+         * close_dataset_read, so the flag can be toggled at any time.
+         */
+        hid_t open_dataset_read (const char* path)
+        {
+            if (this->cache_read_handles == true) {
+                auto cached = this->read_handle_cache.find (path);
+                if (cached != this->read_handle_cache.end()) { return cached->second; }
+            }
+            hid_t dataset_id = H5Dopen2 (this->file_id, path, H5P_DEFAULT);
+            if (this->cache_read_handles == true && dataset_id >= 0) {
+                this->read_handle_cache.emplace (path, dataset_id);
+            }
+            return dataset_id;
+        }
+
+        //! Close a handle obtained from open_dataset_read - unless it is cached, in
+        //! which case it stays open for the next read of the same path
+        void close_dataset_read (const hid_t dataset_id)
+        {
+            if (this->cache_read_handles == true) { return; } // closed by close_read_handle_cache
+            herr_t status = H5Dclose (dataset_id);
+            this->handle_error (status, "Error. status after H5Dclose: ");
+        }
+
+        //! The cached read handles, keyed by dataset path. See open_dataset_read.
+        std::map<std::string, hid_t> read_handle_cache;
+
         /*!
          * Check the 2D dataspace enclosed within the dataset. If one ALREADY exists,
          * make sure its size will support the saving of data of size dim0 by dim1. If
@@ -231,6 +402,43 @@ namespace morph {
             this->init (fname, _file_access, show_hdf_internal_errors);
         }
 
+#ifdef H5_HAVE_PARALLEL
+        /*!
+         * Construct against one file shared by all the ranks of \a comm, using MPI-IO
+         * (H5Pset_fapl_mpio) file access. Collective: every rank of the communicator must
+         * construct with the same fname and access mode. One shared file receiving
+         * coordinated writes (see add_contained_vals_collective) replaces the
+         * one-file-per-rank pattern and its thousands of small uncoordinated writes.
+         *
+         * Only available when libhdf5 was built with parallel support (H5_HAVE_PARALLEL);
+         * pairs with the decomposition in morph/HexGridMpi.h.
+         */
+        HdfData (const std::string fname, MPI_Comm comm,
+                 const FileAccess _file_access = FileAccess::TruncateWrite,
+                 const bool show_hdf_internal_errors = false)
+        {
+            this->file_access = _file_access;
+            hid_t fapl_id = H5Pcreate (H5P_FILE_ACCESS);
+            H5Pset_fapl_mpio (fapl_id, comm, MPI_INFO_NULL);
+            if (this->file_access == FileAccess::ReadOnly) {
+                this->file_id = H5Fopen (fname.c_str(), H5F_ACC_RDONLY, fapl_id);
+            } else if (this->file_access == FileAccess::ReadWrite) {
+                this->file_id = H5Fopen (fname.c_str(), H5F_ACC_RDWR, fapl_id);
+            } else {
+                this->file_id = H5Fcreate (fname.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, fapl_id);
+            }
+            H5Pclose (fapl_id);
+            if ((int)this->file_id < 0) {
+                std::stringstream ee;
+                ee << "Error opening parallel HDF5 file '" << fname << "'";
+                throw std::runtime_error (ee.str());
+            }
+            if (show_hdf_internal_errors == false) {
+                H5Eset_auto (H5E_DEFAULT, NULL, NULL);
+            }
+        }
+#endif // H5_HAVE_PARALLEL
+
     private:
         void init (const std::string fname,
                    const FileAccess _file_access,
@@ -260,13 +468,32 @@ namespace morph {
         }
 
     public:
-        //! Deconstruct, closing the file_id
+        //! Deconstruct, closing any cached read handles and then the file_id
         ~HdfData()
         {
+            this->close_read_handle_cache();
             herr_t status = H5Fclose (this->file_id);
             if (status) { std::cerr << "Error closing HDF5 file; status: " << status << std::endl; }
         }
 
+        /*!
+         * Cache dataset handles on the read paths. When a program re-reads the same
+         * paths (polling a growing log, or a read-modify loop), set this true to pay
+         * the H5Dopen2 metadata cost once per path rather than once per read. The
+         * cached handles live until the HdfData is destructed (or
+         * close_read_handle_cache() is called), so leave this false (the default,
+         * with behaviour as before) if you read a great many *distinct* paths just
+         * once each and want each handle released immediately.
+         */
+        bool cache_read_handles = false;
+
+        //! Close all cached read handles (they re-open, and re-cache, on next use)
+        void close_read_handle_cache()
+        {
+            for (auto& cached : this->read_handle_cache) { H5Dclose (cached.second); }
+            this->read_handle_cache.clear();
+        }
+
         /*!
          * When reading a field in a file that doesn't exist, client code could want the
          * library to either gracefully handle its missing-ness and carry on -
@@ -280,6 +507,288 @@ namespace morph {
          */
         ReadErrorAction read_error_action = ReadErrorAction::Info;
 
+        /*!
+         * Options applied when this HdfData creates a dataset: chunk shape, deflate compression
+         * level and the shuffle filter. The defaults give contiguous, uncompressed datasets as
+         * before. Set (say) dataset_options.deflate_level = 1 after construction to get
+         * compressed output from all subsequent add_* calls; options can be changed between
+         * calls to use different settings for different datasets.
+         */
+        DatasetOptions dataset_options;
+
+        /*!
+         * Append one row of \a ncols elements to the 2D dataset at \a path, creating the dataset
+         * on first use with unlimited maximum rows. This is the standard HDF5 pattern for
+         * logging a state vector per timestep: one chunked dataset extended with H5Dset_extent
+         * and written with a hyperslab per step, rather than thousands of individually-named
+         * datasets. The dataset is chunked (several rows per chunk, about 1 MiB, adjustable via
+         * dataset_options.chunk_elements) and dataset_options' compression settings apply. Every
+         * append must present the same ncols; rows are stored in the element's own width (float
+         * rows as 32 bit floats).
+         */
+        template <typename T>
+        void append_row (const char* path, const T* vals, const hsize_t ncols)
+        {
+            static_assert (std::is_arithmetic<std::decay_t<T>>::value == true,
+                           "HdfData::append_row: element type must be arithmetic");
+            if (ncols == 0) { throw std::runtime_error ("HdfData::append_row: ncols must be > 0"); }
+            this->process_groups (path);
+
+            hid_t dataset_id = -1;
+            if (H5Lexists (this->file_id, path, H5P_DEFAULT) > 0) {
+                dataset_id = H5Dopen2 (this->file_id, path, H5P_DEFAULT);
+            }
+            if (dataset_id < 0) {
+                // Create a 0 x ncols dataset with unlimited maximum rows. Extendable datasets
+                // must be chunked; aim for chunks of about 1 MiB unless told otherwise.
+                hsize_t dims[2] = { 0, ncols };
+                hsize_t maxdims[2] = { H5S_UNLIMITED, ncols };
+                hid_t space_id = H5Screate_simple (2, dims, maxdims);
+                hsize_t chunk_rows = this->dataset_options.chunk_elements;
+                if (chunk_rows == 0) {
+                    chunk_rows = (hsize_t{1} << 20) / (sizeof(T) * ncols);
+                    if (chunk_rows == 0) { chunk_rows = 1; }
+                }
+                hsize_t chunk_dims[2] = { chunk_rows, ncols };
+                hid_t dcpl_id = H5Pcreate (H5P_DATASET_CREATE);
+                H5Pset_chunk (dcpl_id, 2, chunk_dims);
+                if (this->dataset_options.deflate_level > 0) {
+                    if (this->dataset_options.shuffle == true) { H5Pset_shuffle (dcpl_id); }
+                    H5Pset_deflate (dcpl_id, this->dataset_options.deflate_level);
+                }
+                dataset_id = H5Dcreate2 (this->file_id, path, this->file_dtype<T>(), space_id,
+                                         H5P_DEFAULT, dcpl_id, H5P_DEFAULT);
+                H5Pclose (dcpl_id);
+                H5Sclose (space_id);
+                if (dataset_id < 0) {
+                    throw std::runtime_error ("HdfData::append_row: Failed to create extendable dataset");
+                }
+            }
+
+            // How many rows does the dataset hold so far?
+            hid_t fspace_id = H5Dget_space (dataset_id);
+            hsize_t dims[2] = { 0, 0 };
+            int ndims = H5Sget_simple_extent_dims (fspace_id, dims, nullptr);
+            H5Sclose (fspace_id);
+            if (ndims != 2 || dims[1] != ncols) {
+                std::stringstream ee;
+                ee << "HdfData::append_row: dataset " << path << " is not 2D with " << ncols << " columns";
+                throw std::runtime_error (ee.str());
+            }
+
+            // Extend by one row and write vals into it via a hyperslab selection
+            hsize_t newdims[2] = { dims[0] + 1, ncols };
+            herr_t status = H5Dset_extent (dataset_id, newdims);
+            this->handle_error (status, "Error. status after H5Dset_extent: ");
+            fspace_id = H5Dget_space (dataset_id);
+            hsize_t start[2] = { dims[0], 0 };
+            hsize_t count[2] = { 1, ncols };
+            H5Sselect_hyperslab (fspace_id, H5S_SELECT_SET, start, nullptr, count, nullptr);
+            hid_t mspace_id = H5Screate_simple (2, count, nullptr);
+            status = H5Dwrite (dataset_id, this->mem_dtype<T>(), mspace_id, fspace_id, H5P_DEFAULT, vals);
+            this->handle_error (status, "Error. status after H5Dwrite: ");
+            H5Sclose (mspace_id);
+            H5Sclose (fspace_id);
+            status = H5Dclose (dataset_id);
+            this->handle_error (status, "Error. status after H5Dclose: ");
+        }
+
+        //! append_row for any contiguous container (vector, vvec, array) of arithmetic elements
+        template <typename Container>
+        void append_row (const char* path, const Container& vals)
+        {
+            this->append_row (path, vals.data(), static_cast<hsize_t>(vals.size()));
+        }
+
+        /*
+         * Zero-copy writes and reads. These overloads take a bare pointer (or std::span) to
+         * arithmetic data, for use when the values live in arena-allocated or memory-mapped
+         * buffers that the owning-container overloads would force a copy of. Data is stored at
+         * the element's own width (float as 32 bit float), as for append_row.
+         */
+
+        //! Write \a n values of arithmetic type T from the memory at \a vals as a 1D dataset
+        template <typename T>
+        void add_contained_vals (const char* path, const T* vals, const hsize_t n)
+        {
+            MORPH_PROFILE_SCOPE ("HdfData::add_contained_vals");
+            static_assert (std::is_arithmetic<std::decay_t<T>>::value == true,
+                           "HdfData::add_contained_vals(ptr): element type must be arithmetic");
+            this->process_groups (path);
+            hsize_t dim_singleparam[1] = { n };
+            hid_t dataspace_id = H5Screate_simple (1, dim_singleparam, NULL);
+            hid_t dataset_id = this->open_dataset (path, this->file_dtype<T>(), dataspace_id);
+            this->check_dataset_space_1_dim (dataset_id, n);
+            herr_t status = H5Dwrite (dataset_id, this->mem_dtype<T>(), H5S_ALL, H5S_ALL, H5P_DEFAULT, vals);
+            this->handle_error (status, "Error. status after H5Dwrite: ");
+            status = H5Dclose (dataset_id);
+            this->handle_error (status, "Error. status after H5Dclose: ");
+            status = H5Sclose (dataspace_id);
+            this->handle_error (status, "Error. status after H5Sclose: ");
+        }
+
+        //! Write a dim0 x dim1, row-major 2D dataset from the memory at \a vals
+        template <typename T>
+        void add_contained_vals (const char* path, const T* vals, const hsize_t dim0, const hsize_t dim1)
+        {
+            MORPH_PROFILE_SCOPE ("HdfData::add_contained_vals");
+            static_assert (std::is_arithmetic<std::decay_t<T>>::value == true,
+                           "HdfData::add_contained_vals(ptr): element type must be arithmetic");
+            this->process_groups (path);
+            hsize_t dims[2] = { dim0, dim1 };
+            hid_t dataspace_id = H5Screate_simple (2, dims, NULL);
+            hid_t dataset_id = this->open_dataset (path, this->file_dtype<T>(), dataspace_id);
+            this->check_dataset_space_2_dims (dataset_id, dim0, dim1);
+            herr_t status = H5Dwrite (dataset_id, this->mem_dtype<T>(), H5S_ALL, H5S_ALL, H5P_DEFAULT, vals);
+            this->handle_error (status, "Error. status after H5Dwrite: ");
+            status = H5Dclose (dataset_id);
+            this->handle_error (status, "Error. status after H5Dclose: ");
+            status = H5Sclose (dataspace_id);
+            this->handle_error (status, "Error. status after H5Sclose: ");
+        }
+
+        //! Write the span \a vals as a 1D dataset
+        template <typename T>
+        void add_contained_vals (const char* path, const std::span<T> vals)
+        {
+            this->add_contained_vals (path, vals.data(), static_cast<hsize_t>(vals.size()));
+        }
+
+#ifdef H5_HAVE_PARALLEL
+        /*!
+         * Collective distributed write into one shared dataset. Every rank of the
+         * communicator that the file was opened on (see the MPI_Comm constructor) must call
+         * with the same \a path and \a global_n; each rank contributes its \a local_n values
+         * at element offset \a offset of the 1D dataset, written as one per-rank hyperslab
+         * in a collective (H5FD_MPIO_COLLECTIVE) H5Dwrite, which lets MPI-IO aggregate all
+         * the ranks' data into coordinated large writes. A rank with no data to contribute
+         * must still call, with local_n of 0. The ranks' extents would normally come from a
+         * morph::HexGridMpi decomposition, but need not tile the dataset - unwritten
+         * elements simply hold the fill value.
+         */
+        template <typename T>
+        void add_contained_vals_collective (const char* path, const T* vals,
+                                            const hsize_t local_n, const hsize_t global_n,
+                                            const hsize_t offset)
+        {
+            static_assert (std::is_arithmetic<std::decay_t<T>>::value == true,
+                           "HdfData::add_contained_vals_collective: element type must be arithmetic");
+            this->process_groups (path);
+            hsize_t dims[1] = { global_n };
+            hid_t filespace_id = H5Screate_simple (1, dims, NULL);
+            hid_t dataset_id = this->open_dataset (path, this->file_dtype<T>(), filespace_id);
+            this->check_dataset_space_1_dim (dataset_id, global_n);
+            // Select this rank's hyperslab of the file dataspace
+            if (local_n > 0) {
+                hsize_t start[1] = { offset };
+                hsize_t count[1] = { local_n };
+                H5Sselect_hyperslab (filespace_id, H5S_SELECT_SET, start, NULL, count, NULL);
+            } else {
+                H5Sselect_none (filespace_id);
+            }
+            hsize_t memdims[1] = { local_n };
+            hid_t memspace_id = H5Screate_simple (1, memdims, NULL);
+            if (local_n == 0) { H5Sselect_none (memspace_id); }
+            // Collective transfer: all ranks' hyperslabs coalesce into large writes
+            hid_t dxpl_id = H5Pcreate (H5P_DATASET_XFER);
+            H5Pset_dxpl_mpio (dxpl_id, H5FD_MPIO_COLLECTIVE);
+            herr_t status = H5Dwrite (dataset_id, this->mem_dtype<T>(), memspace_id, filespace_id, dxpl_id, vals);
+            this->handle_error (status, "Error. status after collective H5Dwrite: ");
+            H5Pclose (dxpl_id);
+            status = H5Sclose (memspace_id);
+            this->handle_error (status, "Error. status after H5Sclose: ");
+            status = H5Dclose (dataset_id);
+            this->handle_error (status, "Error. status after H5Dclose: ");
+            status = H5Sclose (filespace_id);
+            this->handle_error (status, "Error. status after H5Sclose: ");
+        }
+
+        //! Collective write of this rank's owned values of the full-length field \a vals,
+        //! taking the owned index list from \a dom. The owned indices of a HexGridMpi strip
+        //! decomposition are not generally contiguous, so the values are packed to a
+        //! contiguous buffer and written as one hyperslab per rank at the rank's block
+        //! offset; the dataset then holds the field in decomposition order (ranks'
+        //! blocks concatenated), alongside which client code can store the permutation.
+        template <typename T, typename Dom>
+        void add_contained_vals_collective (const char* path, const std::vector<T>& vals, const Dom& dom)
+        {
+            std::vector<T> packed (dom.owned.size());
+            for (std::size_t k = 0; k < packed.size(); ++k) { packed[k] = vals[dom.owned[k]]; }
+            hsize_t global_n = 0;
+            hsize_t offset = 0;
+            for (int r = 0; r < dom.nranks; ++r) {
+                if (r == dom.rank) { offset = global_n; }
+                global_n += static_cast<hsize_t>(dom.rank_owned[r].size());
+            }
+            this->add_contained_vals_collective (path, packed.data(),
+                                                 static_cast<hsize_t>(packed.size()), global_n, offset);
+        }
+#endif // H5_HAVE_PARALLEL
+
+        /*!
+         * Read the dataset at \a path into caller-provided storage at \a vals, which must hold
+         * \a n elements. The dataset must contain exactly n elements in total (any rank); the
+         * HDF5 library converts the stored type to T. No allocation or resize takes place.
+         */
+        template <typename T>
+        void read_contained_vals (const char* path, T* vals, const hsize_t n)
+        {
+            static_assert (std::is_arithmetic<std::decay_t<T>>::value == true,
+                           "HdfData::read_contained_vals(ptr): element type must be arithmetic");
+            hid_t dataset_id = this->open_dataset_read (path);
+            if (this->check_dataset_id (dataset_id, path) == -1) { return; }
+            hid_t space_id = H5Dget_space (dataset_id);
+            hsize_t dims[H5S_MAX_RANK] = {0};
+            int ndims = H5Sget_simple_extent_dims (space_id, dims, nullptr);
+            H5Sclose (space_id);
+            hsize_t n_in_file = ndims > 0 ? 1 : 0;
+            for (int i = 0; i < ndims; ++i) { n_in_file *= dims[i]; }
+            if (n_in_file != n) {
+                std::stringstream ee;
+                ee << "Error. Dataset " << path << " holds " << n_in_file
+                   << " elements but the caller-provided storage holds " << n;
+                throw std::runtime_error (ee.str());
+            }
+            herr_t status = H5Dread (dataset_id, this->mem_dtype<T>(), H5S_ALL, H5S_ALL, H5P_DEFAULT, vals);
+            this->handle_error (status, "Error. status after H5Dread: ");
+            this->close_dataset_read (dataset_id);
+        }
+
+        //! Read the dataset at \a path into the caller-provided span \a vals
+        template <typename T>
+        void read_contained_vals (const char* path, std::span<T> vals)
+        {
+            this->read_contained_vals (path, vals.data(), static_cast<hsize_t>(vals.size()));
+        }
+
+        /*!
+         * Read a whole 2D dataset (such as one written by append_row) into the flat, row-major
+         * container \a vals, returning the dataset's shape in \a nrows and \a ncols. If the
+         * number of columns is known at compile time, read_contained_vals into a
+         * vector<array<T, N>> is an alternative.
+         */
+        template <typename T>
+        void read_rows (const char* path, std::vector<T>& vals, hsize_t& nrows, hsize_t& ncols)
+        {
+            hid_t dataset_id = this->open_dataset_read (path);
+            if (this->check_dataset_id (dataset_id, path) == -1) { return; }
+            hid_t space_id = H5Dget_space (dataset_id);
+            hsize_t dims[2] = { 0, 0 };
+            int ndims = H5Sget_simple_extent_dims (space_id, dims, nullptr);
+            H5Sclose (space_id);
+            if (ndims != 2) {
+                std::stringstream ee;
+                ee << "Error. Expected 2D data to be stored in " << path;
+                throw std::runtime_error (ee.str());
+            }
+            nrows = dims[0];
+            ncols = dims[1];
+            vals.resize (nrows * ncols);
+            herr_t status = H5Dread (dataset_id, this->mem_dtype<T>(), H5S_ALL, H5S_ALL, H5P_DEFAULT, vals.data());
+            this->handle_error (status, "Error. status after H5Dread: ");
+            this->close_dataset_read (dataset_id);
+        }
+
         /*!
          * Templated version of read_contained_vals, for vector/list/deque (but not map,
          * which is more complex) and whatever simple value (int, double, float, etc) is
@@ -292,7 +801,7 @@ namespace morph {
                    typename Allocator=std::allocator<T> >
         void read_contained_vals (const char* path, Container<T, Allocator>& vals)
         {
-            hid_t dataset_id = H5Dopen2 (this->file_id, path, H5P_DEFAULT);
+            hid_t dataset_id = this->open_dataset_read (path);
             if (this->check_dataset_id (dataset_id, path) == -1) { return; }
 
             hid_t space_id = H5Dget_space (dataset_id);
@@ -435,8 +944,7 @@ namespace morph {
             std::copy (invals.begin(), invals.end(), vals.begin());
 
             this->handle_error (status, "Error. status after H5Dread: ");
-            status = H5Dclose (dataset_id);
-            this->handle_error (status, "Error. status after H5Dclose: ");
+            this->close_dataset_read (dataset_id);
         }
 
         // Read pairs
@@ -458,7 +966,7 @@ namespace morph {
         template<typename T, std::size_t N>
         void read_contained_vals (const char* path, std::vector<std::array<T, N>>& vals)
         {
-            hid_t dataset_id = H5Dopen2 (this->file_id, path, H5P_DEFAULT);
+            hid_t dataset_id = this->open_dataset_read (path);
             if (this->check_dataset_id (dataset_id, path) == -1) { return; }
             hid_t space_id = H5Dget_space (dataset_id);
             hsize_t dims[2] = {0,0};
@@ -497,15 +1005,14 @@ namespace morph {
                 throw std::runtime_error ("HdfData::read_contained_vals<vector<array<T,N>>: Don't know how to read that type T");
             }
             this->handle_error (status, "Error. status after H5Dread: ");
-            status = H5Dclose (dataset_id);
-            this->handle_error (status, "Error. status after H5Dclose: ");
+            this->close_dataset_read (dataset_id);
         }
 
         //! read_contained_vals for an array<T,N> (and by extension, a morph::vec<T,N>)
         template<typename T, std::size_t N>
         void read_contained_vals (const char* path, std::array<T, N>& vals)
         {
-            hid_t dataset_id = H5Dopen2 (this->file_id, path, H5P_DEFAULT);
+            hid_t dataset_id = this->open_dataset_read (path);
             if (this->check_dataset_id (dataset_id, path) == -1) { return; }
             hid_t space_id = H5Dget_space (dataset_id);
             hsize_t dims[1] = {0}; // 1D
@@ -545,15 +1052,14 @@ namespace morph {
                 throw std::runtime_error ("HdfData::read_contained_vals<array<T,N>: Don't know how to read that type T");
             }
             this->handle_error (status, "Error. status after H5Dread: ");
-            status = H5Dclose (dataset_id);
-            this->handle_error (status, "Error. status after H5Dclose: ");
+            this->close_dataset_read (dataset_id);
         }
 
         //! read_contained_vals for a vvec of vec<T,N>
         template<typename T, std::size_t N>
         void read_contained_vals (const char* path, morph::vvec<morph::vec<T, N>>& vals)
         {
-            hid_t dataset_id = H5Dopen2 (this->file_id, path, H5P_DEFAULT);
+            hid_t dataset_id = this->open_dataset_read (path);
             if (this->check_dataset_id (dataset_id, path) == -1) { return; }
             hid_t space_id = H5Dget_space (dataset_id);
             hsize_t dims[2] = {0,0};
@@ -592,15 +1098,14 @@ namespace morph {
                 throw std::runtime_error ("HdfData::read_contained_vals<vector<array<T,N>>: Don't know how to read that type T");
             }
             this->handle_error (status, "Error. status after H5Dread: ");
-            status = H5Dclose (dataset_id);
-            this->handle_error (status, "Error. status after H5Dclose: ");
+            this->close_dataset_read (dataset_id);
         }
 
         //! read_contained_vals for vvec of identically sized vvecs of scalar types T
         template<typename T>
         void read_contained_vals (const char* path, morph::vvec<morph::vvec<T>>& vals)
         {
-            hid_t dataset_id = H5Dopen2 (this->file_id, path, H5P_DEFAULT);
+            hid_t dataset_id = this->open_dataset_read (path);
             if (this->check_dataset_id (dataset_id, path) == -1) { return; }
             hid_t space_id = H5Dget_space (dataset_id);
             hsize_t dims[2] = {0,0};
@@ -637,8 +1142,7 @@ namespace morph {
                 throw std::runtime_error ("HdfData::read_contained_vals<T>: Don't know how to read that type");
             }
             this->handle_error (status, "Error. status after H5Dread: ");
-            status = H5Dclose (dataset_id);
-            this->handle_error (status, "Error. status after H5Dclose: ");
+            this->close_dataset_read (dataset_id);
 
             // Now copy the data from invals into vals
             vals.resize (dims[0]);
@@ -654,7 +1158,7 @@ namespace morph {
         template <typename T>
         void read_val (const char* path, T& val)
         {
-            hid_t dataset_id = H5Dopen2 (this->file_id, path, H5P_DEFAULT);
+            hid_t dataset_id = this->open_dataset_read (path);
             if (this->check_dataset_id (dataset_id, path) == -1) { return; }
 
             herr_t status = 0;
@@ -679,14 +1183,13 @@ namespace morph {
                 throw std::runtime_error ("HdfData::read_val<T>: Don't know how to read that type");
             }
             this->handle_error (status, "Error. status after H5Dread: ");
-            status = H5Dclose (dataset_id);
-            this->handle_error (status, "Error. status after H5Dclose: ");
+            this->close_dataset_read (dataset_id);
         }
 
         //! Read a string of chars
         void read_string (const char* path, std::string& str)
         {
-            hid_t dataset_id = H5Dopen2 (this->file_id, path, H5P_DEFAULT);
+            hid_t dataset_id = this->open_dataset_read (path);
             hid_t space_id = H5Dget_space (dataset_id);
             hsize_t dims[1] = {0};
             int ndims = H5Sget_simple_extent_dims (space_id, dims, NULL);
@@ -698,8 +1201,7 @@ namespace morph {
             str.resize (dims[0], ' ');
             herr_t status = H5Dread (dataset_id, H5T_C_S1, H5S_ALL, H5S_ALL, H5P_DEFAULT, &(str[0]));
             this->handle_error (status, "Error. status after H5Dread: ");
-            status = H5Dclose (dataset_id);
-            this->handle_error (status, "Error. status after H5Dclose: ");
+            this->close_dataset_read (dataset_id);
         }
 
         //! Templated read_val for bitsets
@@ -1416,7 +1918,7 @@ namespace morph {
             this->read_val (pathtype.c_str(), channels);
 
             // Now read the matrix
-            hid_t dataset_id = H5Dopen2 (this->file_id, path, H5P_DEFAULT);
+            hid_t dataset_id = this->open_dataset_read (path);
             if (this->check_dataset_id (dataset_id, path) == -1) { return; }
             hid_t space_id = H5Dget_space (dataset_id);
             hsize_t dims[2] = {0,0};
@@ -1500,8 +2002,7 @@ namespace morph {
             }
             }
             this->handle_error (status, "Error. status after H5Dread: ");
-            status = H5Dclose (dataset_id);
-            this->handle_error (status, "Error. status after H5Dclose: ");
+            this->close_dataset_read (dataset_id);
         }
 
         //! Add a cv::Point_<T> to the HDF5 file
@@ -1679,4 +2180,107 @@ namespace morph {
 #endif
     }; // class HdfData
 
+    /*!
+     * Read-ahead for a known list of dataset paths. Post-processing code which
+     * consumes thousands of per-step datasets in a known order spends most of its
+     * time waiting on HDF5 metadata and I/O; an HdfPrefetcher opens its *own*
+     * read-only HdfData on a background thread (the HDF5 library need not be a
+     * threadsafe build, since only that thread makes HDF5 calls) and reads the given
+     * paths, in order, into memory ahead of the consumer. The consumer calls get()
+     * for each path - in the same order - and blocks only if it outruns the reader.
+     * All the listed datasets must hold elements convertible to T (HDF5 converts the
+     * stored type to T's native type, as HdfData reads always have). \a max_buffered
+     * bounds the datasets held in memory at once.
+     *
+     * \code
+     *   morph::HdfPrefetcher<double> pf ("run.h5", paths);
+     *   for (const auto& p : paths) {
+     *       std::vector<double> vals = pf.get (p);
+     *       process (vals);
+     *   }
+     * \endcode
+     */
+    template <typename T>
+    class HdfPrefetcher
+    {
+    public:
+        HdfPrefetcher (const std::string& fname, const std::vector<std::string>& paths,
+                       const std::size_t max_buffered = 64)
+            : pending (paths.begin(), paths.end())
+        {
+            this->reader = std::thread ([this, fname, max_buffered] {
+                try {
+                    morph::HdfData data (fname, morph::FileAccess::ReadOnly);
+                    for (const auto& path : this->pending) {
+                        std::vector<T> vals;
+                        data.read_contained_vals (path.c_str(), vals);
+                        std::unique_lock<std::mutex> lk (this->mtx);
+                        this->space_cv.wait (lk, [this, max_buffered] {
+                            return this->buffered.size() < max_buffered || this->finished == true;
+                        });
+                        if (this->finished == true) { return; } // consumer gone; stop reading
+                        this->buffered[path] = std::move (vals);
+                        this->data_cv.notify_all();
+                    }
+                } catch (...) {
+                    std::lock_guard<std::mutex> lk (this->mtx);
+                    this->reader_error = std::current_exception();
+                    this->data_cv.notify_all();
+                }
+            });
+        }
+
+        ~HdfPrefetcher()
+        {
+            {
+                std::lock_guard<std::mutex> lk (this->mtx);
+                this->finished = true;
+                this->space_cv.notify_all();
+            }
+            if (this->reader.joinable() == true) { this->reader.join(); }
+        }
+
+        HdfPrefetcher (const HdfPrefetcher&) = delete;
+        HdfPrefetcher& operator= (const HdfPrefetcher&) = delete;
+
+        /*!
+         * The content of the dataset at \a path, blocking until the background thread
+         * has read it. Each path can be got once (the data is moved out, freeing the
+         * buffer space). Rethrows here if the reader hit an error (missing path, bad
+         * file). Call in (or close to) the order the paths were listed: a get() for a
+         * late-listed path cannot complete while max_buffered earlier datasets remain
+         * unconsumed.
+         */
+        std::vector<T> get (const std::string& path)
+        {
+            std::unique_lock<std::mutex> lk (this->mtx);
+            this->data_cv.wait (lk, [this, &path] {
+                return this->buffered.count (path) > 0 || this->reader_error != nullptr;
+            });
+            if (this->buffered.count (path) == 0 && this->reader_error != nullptr) {
+                std::rethrow_exception (this->reader_error);
+            }
+            auto got = this->buffered.extract (path);
+            this->space_cv.notify_all();
+            return std::move (got.mapped());
+        }
+
+    private:
+        //! The paths to read, in order (fixed at construction; the reader iterates it
+        //! without locking)
+        const std::vector<std::string> pending;
+        //! Datasets read but not yet consumed
+        std::map<std::string, std::vector<T>> buffered;
+        std::mutex mtx;
+        //! Signalled when a dataset lands in this->buffered
+        std::condition_variable data_cv;
+        //! Signalled when get() frees buffer space (or at destruction)
+        std::condition_variable space_cv;
+        //! An exception from the reader thread, rethrown from get()
+        std::exception_ptr reader_error = nullptr;
+        //! Set at destruction to stop the reader early
+        bool finished = false;
+        std::thread reader;
+    };
+
 } // namespace morph
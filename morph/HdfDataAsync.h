@@ -0,0 +1,180 @@
+/*!
+ * An asynchronous, background-thread writer wrapped around morph::HdfData.
+ *
+ * Simulation code hands off snapshots of its state (moved containers, so no copy on the
+ * simulation thread) to a bounded queue; a dedicated writer thread performs all the HDF5 calls.
+ * This keeps H5Dwrite time off the simulation thread during checkpointing. All HDF5 library
+ * calls are made from the one writer thread, so this is safe with a non-threadsafe (serial)
+ * build of the HDF5 library.
+ */
+#pragma once
+
+#include <string>
+#include <iostream>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <utility>
+#include <exception>
+#include <cstddef>
+#include <morph/HdfData.h>
+#include <morph/vvec.h>
+
+namespace morph {
+
+    class HdfDataAsync
+    {
+    public:
+        /*!
+         * Construct the writer for the HDF5 file \a fname, opened with \a _file_access (as for
+         * HdfData). \a _max_queue bounds the number of jobs waiting to be written; when the
+         * queue is full, the enqueueing thread blocks until the writer catches up
+         * (backpressure), so memory use is limited to max_queue snapshots.
+         */
+        HdfDataAsync (const std::string& fname, const FileAccess _file_access = FileAccess::TruncateWrite,
+                      const std::size_t _max_queue = 8)
+            : max_queue (_max_queue)
+        {
+            // The HdfData object is constructed (and so the file is opened) on the writer
+            // thread, which is the only thread to make HDF5 calls thereafter.
+            this->writer = std::thread ([this, fname, _file_access] { this->writer_loop (fname, _file_access); });
+        }
+
+        //! Destructor completes all queued writes, then closes the file. Any stored write error
+        //! is reported on stderr (use flush() to have errors thrown where you can catch them).
+        ~HdfDataAsync()
+        {
+            {
+                std::unique_lock<std::mutex> lk (this->mtx);
+                this->stop = true;
+            }
+            this->cv_jobs.notify_all();
+            if (this->writer.joinable()) { this->writer.join(); }
+            if (this->error != nullptr) {
+                try {
+                    std::rethrow_exception (this->error);
+                } catch (const std::exception& e) {
+                    std::cerr << "HdfDataAsync: error during background write: " << e.what() << std::endl;
+                }
+            }
+        }
+
+        //! Queue a (moved or copied) vvec snapshot for writing to \a path, as
+        //! HdfData::add_contained_vals. Returns as soon as the job is queued.
+        template <typename T>
+        void add_contained_vals (const std::string& path, morph::vvec<T> vals)
+        {
+            this->enqueue ([path, v = std::move (vals)] (HdfData& d) { d.add_contained_vals (path.c_str(), v); });
+        }
+
+        //! Queue a (moved or copied) vector snapshot for writing to \a path
+        template <typename T>
+        void add_contained_vals (const std::string& path, std::vector<T> vals)
+        {
+            this->enqueue ([path, v = std::move (vals)] (HdfData& d) { d.add_contained_vals (path.c_str(), v); });
+        }
+
+        //! Queue one row for appending to the extendable dataset at \a path (see
+        //! HdfData::append_row)
+        template <typename T>
+        void append_row (const std::string& path, morph::vvec<T> vals)
+        {
+            this->enqueue ([path, v = std::move (vals)] (HdfData& d) { d.append_row (path.c_str(), v); });
+        }
+
+        //! Queue an arbitrary job - any sequence of calls on the underlying HdfData - for
+        //! execution on the writer thread. Blocks while the queue is full.
+        void enqueue (std::function<void(HdfData&)> job)
+        {
+            std::unique_lock<std::mutex> lk (this->mtx);
+            this->cv_space.wait (lk, [this] { return this->jobs.size() < this->max_queue; });
+            this->jobs.push_back (std::move (job));
+            lk.unlock();
+            this->cv_jobs.notify_one();
+        }
+
+        //! Block until every queued job has been written, then rethrow any write error
+        void flush()
+        {
+            std::unique_lock<std::mutex> lk (this->mtx);
+            this->cv_space.wait (lk, [this] { return this->jobs.empty() && this->busy == false; });
+            if (this->error != nullptr) {
+                std::exception_ptr e = this->error;
+                this->error = nullptr;
+                std::rethrow_exception (e);
+            }
+        }
+
+        //! The number of jobs currently queued (not including one in progress)
+        std::size_t queued() const
+        {
+            std::unique_lock<std::mutex> lk (this->mtx);
+            return this->jobs.size();
+        }
+
+    private:
+        //! The writer thread's main loop: open the file, then drain the queue until stopped
+        void writer_loop (const std::string& fname, const FileAccess _file_access)
+        {
+            try {
+                HdfData data (fname, _file_access);
+                while (true) {
+                    std::function<void(HdfData&)> job;
+                    {
+                        std::unique_lock<std::mutex> lk (this->mtx);
+                        this->cv_jobs.wait (lk, [this] { return this->stop == true || this->jobs.empty() == false; });
+                        if (this->jobs.empty() == true) { break; } // stop requested and nothing left to write
+                        job = std::move (this->jobs.front());
+                        this->jobs.pop_front();
+                        this->busy = true;
+                    }
+                    try {
+                        job (data);
+                    } catch (...) {
+                        std::unique_lock<std::mutex> lk (this->mtx);
+                        if (this->error == nullptr) { this->error = std::current_exception(); }
+                    }
+                    {
+                        std::unique_lock<std::mutex> lk (this->mtx);
+                        this->busy = false;
+                    }
+                    this->cv_space.notify_all();
+                }
+            } catch (...) {
+                // Opening the file failed; record the error and discard jobs as they arrive so
+                // that enqueue/flush never deadlock
+                std::unique_lock<std::mutex> lk (this->mtx);
+                if (this->error == nullptr) { this->error = std::current_exception(); }
+                while (this->stop == false) {
+                    this->jobs.clear();
+                    this->cv_space.notify_all();
+                    this->cv_jobs.wait (lk, [this] { return this->stop == true || this->jobs.empty() == false; });
+                }
+                this->jobs.clear();
+                this->cv_space.notify_all();
+            }
+        }
+
+        //! Jobs waiting for the writer thread
+        std::deque<std::function<void(HdfData&)>> jobs;
+        //! Bound on jobs.size(); enqueue blocks when reached
+        std::size_t max_queue = 8;
+        //! Guards jobs, busy, stop and error
+        mutable std::mutex mtx;
+        //! Signalled when a job is queued (or stop is requested)
+        std::condition_variable cv_jobs;
+        //! Signalled when a job completes, freeing queue space
+        std::condition_variable cv_space;
+        //! True while the writer is executing a job
+        bool busy = false;
+        //! Set by the destructor to end the writer loop
+        bool stop = false;
+        //! The first exception thrown by a write job, rethrown by flush()
+        std::exception_ptr error = nullptr;
+        //! The writer thread itself
+        std::thread writer;
+    };
+
+} // namespace morph
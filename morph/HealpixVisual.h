@@ -1,10 +1,14 @@
 #include <cstdint>
+#include <cmath>
+#include <map>
 #include <morph/VisualModel.h>
 #include <morph/ColourMap.h>
 #include <morph/scale.h>
+#include <morph/mathconst.h>
 #include <morph/vec.h>
 #include <morph/vvec.h>
 #include <morph/healpix/healpix_bare.hpp>
+#include <morph/healpix/healpix_resample.hpp>
 
 namespace morph {
     /*
@@ -24,11 +28,23 @@ namespace morph {
         }
 
         // Update the VisualModel, changing only colours if that's enough, or doing a
-        // full rebuild if we're displaying relief.
+        // full rebuild if we're displaying relief or a reduced level-of-detail (whose
+        // downgraded maps have to be recomputed from the new pixeldata).
         void reinit()
         {
-            if (this->relief == true) { morph::VisualModel<glver>::reinit(); }
-            else { this->reinitColours(); }
+            this->lod_maps.clear();
+            if (this->relief == true || (this->lod == true && this->display_order() < this->k)) {
+                morph::VisualModel<glver>::reinit();
+            } else { this->reinitColours(); }
+        }
+
+        // Render, first updating the level of detail if this->lod is enabled. The display
+        // order is chosen so that a HEALPix pixel projects to about lod_px screen pixels,
+        // and refinement towards a higher order proceeds one order per frame.
+        void render()
+        {
+            if (this->lod == true) { this->lod_update(); }
+            morph::VisualModel<glver>::render();
         }
 
         void reinitColours()
@@ -347,18 +363,19 @@ namespace morph {
             if (this->reliefScale.do_autoscale == true) { this->reliefScale.reset(); }
             this->reliefScale.transform (this->pixeldata, scaled_relief);
 
-            // The first loop creates all the *vertices* using nest scheme.
+            // The first loop creates all the *vertices* using nest scheme. The pixel centre
+            // direction vectors are computed up front with the bulk, parallel conversion.
             int64_t n_p = this->n_pixels();
+            morph::vvec<double> px (n_p);
+            morph::vvec<double> py (n_p);
+            morph::vvec<double> pz (n_p);
+            hp::nest2vec_bulk (this->nside, n_p, px.data(), py.data(), pz.data());
             for (int64_t p = 0; p < n_p; ++p) {
-                // Convert nest index p to angle for this pixel
-                hp::t_ang ang = hp::nest2ang (this->nside, p);
-
-                // Find the location of the pixel
-                hp::t_vec pv = hp::loc2vec (hp::ang2loc (ang));
-                // Convert it into a morph::vec and modify according to radius and relief
+                // Convert the pixel centre direction into a morph::vec and modify according to
+                // radius and relief
                 float _r = this->r;
                 if (this->relief == true) { _r += scaled_relief[p]; }
-                morph::vec<float> vpf = (morph::vec<double>({pv.x, pv.y, pv.z}) * _r).as_float();
+                morph::vec<float> vpf = (morph::vec<double>({px[p], py[p], pz[p]}) * _r).as_float();
                 // Make a colour from the pixeldata
                 std::array<float, 3> sc = this->cm.convert (scaled_colours[p]);
                 if (this->show_nest_labels) {
@@ -425,11 +442,32 @@ namespace morph {
             if (this->pixeldata.size() != static_cast<uint64_t>(this->n_pixels())) {
                 this->pixeldata.resize (this->n_pixels(), 0.0f);
             }
+
+            // In LOD mode, tessellate at the display order rather than the full order by
+            // temporarily swapping in the downgraded map and the downgraded k/nside. All
+            // the tessellation code reads this->k, this->nside and this->pixeldata, so it
+            // needs no other changes. The swap is restored before returning.
+            int64_t k_full = this->k;
+            morph::vvec<T> fulldata;
+            if (this->lod == true && this->display_order() < this->k) {
+                fulldata.swap (this->pixeldata);
+                this->pixeldata = this->lod_level (this->k_display);
+                this->k = this->k_display;
+                this->nside = 1LL << this->k;
+            }
+
             if (this->k == 0 || this->show_face_spheres) { this->face_spheres(); }
-            if (this->k == 0) { return; }
-            this->healpix_triangles_by_nest();
-            if (this->show_spheres == true) { this->vertex_spheres(); }
-            if (this->indicate_axes == true) { this->draw_coordaxes(); }
+            if (this->k > 0) {
+                this->healpix_triangles_by_nest();
+                if (this->show_spheres == true) { this->vertex_spheres(); }
+                if (this->indicate_axes == true) { this->draw_coordaxes(); }
+            }
+
+            if (fulldata.empty() == false) {
+                this->k = k_full;
+                this->nside = 1LL << k_full;
+                this->pixeldata.swap (fulldata);
+            }
         }
 
         // Draw a small set of coordinate arrows with origin at pixel 0
@@ -474,6 +512,8 @@ namespace morph {
             }
             this->k = _k;
             this->nside = 1 << _k;
+            this->k_display = -1;
+            this->lod_maps.clear();
             if (this->pixeldata.size() != static_cast<uint64_t>(this->n_pixels())) {
                 this->pixeldata.resize (this->n_pixels(), T{0});
             }
@@ -513,10 +553,89 @@ namespace morph {
         // Show a little coordinate axes set indicating directions?
         bool indicate_axes = false;
 
+        /*
+         * View-dependent level of detail. When enabled, the sphere is tessellated at a
+         * 'display order' chosen each frame from the projected size of a HEALPix pixel,
+         * rather than always at full order. The pixeldata for each reduced order is a
+         * downgrade of the full-resolution map (hp::map_resample_nest), cached per order.
+         * Starts at lod_k_min and refines one order per frame, so a full-sky Nside=1024
+         * map becomes viewable immediately and gains detail as you zoom in.
+         */
+        bool lod = false;
+
+        // The target on-screen size of one HEALPix pixel, in screen pixels. The display
+        // order is refined until pixels project no larger than this.
+        float lod_px = 4.0f;
+
+        // The coarsest display order that LOD may select
+        int64_t lod_k_min = 2;
+
+        // The order at which the sphere is currently tessellated
+        int64_t display_order() const
+        {
+            return (this->lod == true && this->k_display >= 0) ? this->k_display : this->k;
+        }
+
     private:
+        // Return the map downgraded to order k_l, computing and caching it on first use
+        const morph::vvec<T>& lod_level (const int64_t k_l)
+        {
+            auto li = this->lod_maps.find (k_l);
+            if (li == this->lod_maps.end()) {
+                li = this->lod_maps.emplace (k_l, hp::map_resample_nest (this->pixeldata,
+                                                                         this->nside, 1LL << k_l)).first;
+            }
+            return li->second;
+        }
+
+        // Choose the display order from the current view and rebuild the model if it
+        // changes. Refinement steps up one order per frame; coarsening happens at once.
+        void lod_update()
+        {
+            if (this->k <= this->lod_k_min) { return; }
+
+            // The first build (from finalize()) happens before any view information is
+            // available, so start coarse and let subsequent frames refine.
+            if (this->k_display < 0) { this->k_display = std::min (this->k, this->lod_k_min); return; }
+
+            // Eye-space distance from the camera to the nearest point of the sphere
+            const morph::vec<float, 4> ctr = this->scenematrix * this->viewmatrix * morph::vec<float, 4>{ 0.0f, 0.0f, 0.0f, 1.0f };
+            float fov = 30.0f;
+            float znear = 0.001f;
+            int win_h = 480;
+            if (this->parentVis != nullptr) {
+                fov = this->parentVis->fov;
+                znear = this->parentVis->zNear;
+                win_h = this->parentVis->get_winsize()[1];
+            }
+            const float dist = std::max (std::sqrt (ctr[0] * ctr[0] + ctr[1] * ctr[1] + ctr[2] * ctr[2]) - this->r, znear);
+
+            // Screen pixels per unit of eye-space length at this distance
+            const float px_per_unit = static_cast<float>(win_h)
+                / (2.0f * dist * std::tan (fov * 0.5f * morph::mathconst<float>::deg2rad));
+
+            // The typical linear size of a HEALPix pixel on a unit sphere is
+            // sqrt (4 pi / npix) = sqrt (pi/3) / nside. Refine until pixels project
+            // no larger than lod_px.
+            const float pixlin = std::sqrt (morph::mathconst<float>::pi / 3.0f) * this->r;
+            int64_t k_target = this->lod_k_min;
+            while (k_target < this->k
+                   && (pixlin / static_cast<float>(1LL << k_target)) * px_per_unit > this->lod_px) { ++k_target; }
+
+            if (k_target == this->k_display) { return; }
+            this->k_display = (k_target > this->k_display) ? this->k_display + 1 : k_target;
+            morph::VisualModel<glver>::reinit();
+        }
+
         // How many sides for the healpix? This is a choice of the user. Default to 3.
         int64_t k = 3; // k is the 'order'
         int64_t nside = 1 << k;
+
+        // The LOD display order; -1 until lod_update has run (meaning 'use this->k')
+        int64_t k_display = -1;
+
+        // Downgraded copies of pixeldata, keyed by order; cleared when the data changes
+        std::map<int64_t, morph::vvec<T>> lod_maps;
     };
 
 } // namespace morph
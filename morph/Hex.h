@@ -20,6 +20,9 @@
 #endif
 #include <morph/mathconst.h>
 #include <morph/vec.h>
+#ifdef MORPH_POOLED_HEXEN
+# include <morph/pool_allocator.h>
+#endif
 //#define DEBUG_WITH_COUT 1
 #ifdef DEBUG_WITH_COUT
 #include <iostream>
@@ -88,6 +91,21 @@
 
 namespace morph {
 
+    class Hex;
+
+    /*!
+     * The list type that stores a HexGrid's hexes. By default a plain std::list<Hex>.
+     * Compile with MORPH_POOLED_HEXEN to back the list with morph::chunk_allocator,
+     * which allocates the nodes in large contiguous chunks instead of one heap
+     * allocation per hex - a substantial memory and traversal-speed win for
+     * multi-million hex grids.
+     */
+#ifdef MORPH_POOLED_HEXEN
+    using hexlist = std::list<Hex, morph::chunk_allocator<Hex>>;
+#else
+    using hexlist = std::list<Hex>;
+#endif
+
     /*!
      * Describes a regular hexagon arranged with vertices pointing vertically and two flat sides
      * perpendicular to the horizontal axis:
@@ -591,37 +609,37 @@ namespace morph {
         }
 
         //! Set that \a it is the Neighbour to the East
-        void set_ne (std::list<Hex>::iterator it)
+        void set_ne (hexlist::iterator it)
         {
             this->ne = it;
             this->flags |= HEX_HAS_NE;
         }
         //! Set that \a it is the Neighbour to the North East
-        void set_nne (std::list<Hex>::iterator it)
+        void set_nne (hexlist::iterator it)
         {
             this->nne = it;
             this->flags |= HEX_HAS_NNE;
         }
         //! Set that \a it is the Neighbour to the North West
-        void set_nnw (std::list<Hex>::iterator it)
+        void set_nnw (hexlist::iterator it)
         {
             this->nnw = it;
             this->flags |= HEX_HAS_NNW;
         }
         //! Set that \a it is the Neighbour to the West
-        void set_nw (std::list<Hex>::iterator it)
+        void set_nw (hexlist::iterator it)
         {
             this->nw = it;
             this->flags |= HEX_HAS_NW;
         }
         //! Set that \a it is the Neighbour to the South West
-        void set_nsw (std::list<Hex>::iterator it)
+        void set_nsw (hexlist::iterator it)
         {
             this->nsw = it;
             this->flags |= HEX_HAS_NSW;
         }
         //! Set that \a it is the Neighbour to the South East
-        void set_nse (std::list<Hex>::iterator it)
+        void set_nse (hexlist::iterator it)
         {
             this->nse = it;
             this->flags |= HEX_HAS_NSE;
@@ -702,9 +720,9 @@ namespace morph {
          * Get a list<Hex>::iterator to the neighbour at position \a ni.
          * East: 0, North-East: 1, North-West: 2, West: 3, South-West: 4, South-East: 5
          */
-        std::list<Hex>::iterator get_neighbour (unsigned short ni) const
+        hexlist::iterator get_neighbour (unsigned short ni) const
         {
-            std::list<Hex>::iterator hi;
+            hexlist::iterator hi;
             switch (ni) {
             case HEX_NEIGHBOUR_POS_E:
             {
@@ -968,17 +986,17 @@ namespace morph {
          */
 
         //! Nearest neighbour to the East; in the plus r direction.
-        std::list<Hex>::iterator ne;
+        hexlist::iterator ne;
         //! Nearest neighbour to the NorthEast; in the plus g direction.
-        std::list<Hex>::iterator nne;
+        hexlist::iterator nne;
         //! Nearest neighbour to the NorthWest; in the plus b direction.
-        std::list<Hex>::iterator nnw;
+        hexlist::iterator nnw;
         //! Nearest neighbour to the West; in the minus r direction.
-        std::list<Hex>::iterator nw;
+        hexlist::iterator nw;
         //! Nearest neighbour to the SouthWest; in the minus g direction.
-        std::list<Hex>::iterator nsw;
+        hexlist::iterator nsw;
         //! Nearest neighbour to the SouthEast; in the minus b direction.
-        std::list<Hex>::iterator nse;
+        hexlist::iterator nse;
 
     private:
         //! The flags for this Hex.
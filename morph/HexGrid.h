@@ -13,10 +13,12 @@
 #include <morph/Hex.h>
 #include <morph/BezCurvePath.h>
 #include <morph/BezCoord.h>
+#include <morph/profile.h>
 #include <morph/mathconst.h>
 #include <morph/MathAlgo.h>
 #include <morph/debug.h>
 #include <morph/mat22.h>
+#include <morph/snapshot.h>
 
 // If the HexGrid::save and HexGrid::load methods are required, define
 // HEXGRID_COMPILE_LOAD_AND_SAVE. A link to libhdf5 will be required in your program.
@@ -36,9 +38,26 @@
 #include <vector>
 #include <stdexcept>
 #include <limits>
+#include <fstream>
+#include <cstdint>
+#include <span>
+#include <map>
+#include <unordered_map>
+#include <bit>
 
 namespace morph {
 
+    /*!
+     * How should HexGrid create its hexes? hexgridbuild::lists is the original
+     * construction, which builds the morph::hexlist hexen first and fills the flat d_*
+     * vectors from it later. hexgridbuild::soa writes the d_* 'structure of arrays'
+     * directly, creating no Hex objects at all; the list is materialized lazily, only
+     * if a method which works on morph::hexlist (such as the boundary setters) is
+     * called. For multi-million hex grids, soa construction is much faster and avoids
+     * gigabytes of transient list-node storage.
+     */
+    enum class hexgridbuild { lists, soa };
+
     /*!
      * This class is used to build an hexagonal grid of hexagons. The member hexagons
      * are all arranged with a vertex pointing vertically - "point up". The extent of
@@ -102,6 +121,55 @@ namespace morph {
          */
         alignas(8) std::vector<unsigned int> d_flags;
 
+        /*!
+         * Packed, per-mask views of d_flags. For each queried flag mask, one bit per
+         * hex, 64 hexes to the word, so that flag scans (such as visiting every
+         * boundary hex, which domain-growth models do every step) touch 1/32 of the
+         * memory that streaming d_flags does. Built lazily by for_each_flagged() and
+         * invalidated whenever the d_ vectors are rebuilt.
+         */
+        std::map<unsigned int, std::vector<std::uint64_t>> d_flagwords;
+
+        //! Pack a one-bit-per-hex view of (d_flags[i] & flag_mask) into d_flagwords.
+        void build_flag_words (const unsigned int flag_mask)
+        {
+            std::vector<std::uint64_t>& words = this->d_flagwords[flag_mask];
+            words.assign ((this->d_flags.size() + 63u) / 64u, std::uint64_t{0});
+            for (unsigned int i = 0; i < this->d_flags.size(); ++i) {
+                if (this->d_flags[i] & flag_mask) { words[i >> 6u] |= (std::uint64_t{1} << (i & 63u)); }
+            }
+        }
+
+        /*!
+         * Call \a func with the d_ vector index of each hex for which any bit of \a
+         * flag_mask is set in d_flags. The scan runs word-at-a-time over the packed
+         * view from build_flag_words() (built here on first use), using
+         * std::countr_zero to jump straight to each set bit. If you change hex flags
+         * yourself, call clear_flag_words() to force a re-pack.
+         */
+        template <typename F>
+        void for_each_flagged (const unsigned int flag_mask, F&& func)
+        {
+            auto fw = this->d_flagwords.find (flag_mask);
+            if (fw == this->d_flagwords.end()
+                || fw->second.size() != (this->d_flags.size() + 63u) / 64u) {
+                this->build_flag_words (flag_mask);
+                fw = this->d_flagwords.find (flag_mask);
+            }
+            const std::vector<std::uint64_t>& words = fw->second;
+            for (unsigned int w = 0; w < words.size(); ++w) {
+                std::uint64_t bits = words[w];
+                while (bits != 0) {
+                    unsigned int b = static_cast<unsigned int>(std::countr_zero (bits));
+                    func ((w << 6u) + b);
+                    bits &= (bits - 1u); // clear the lowest set bit
+                }
+            }
+        }
+
+        //! Discard the packed flag views, forcing for_each_flagged() to re-pack.
+        void clear_flag_words() { this->d_flagwords.clear(); }
+
         /*!
          * Distance to boundary for any hex.
          */
@@ -134,7 +202,7 @@ namespace morph {
         unsigned int d_growthbuffer_vert = 0;
 
         //! Add entries to all the d_ vectors for the Hex pointed to by hi.
-        void d_push_back (std::list<Hex>::iterator hi)
+        void d_push_back (morph::hexlist::iterator hi)
         {
             d_x.push_back (hi->x);
             d_y.push_back (hi->y);
@@ -159,7 +227,7 @@ namespace morph {
             this->d_nsw.resize (this->d_x.size(), 0);
             this->d_nse.resize (this->d_x.size(), 0);
 
-            std::list<morph::Hex>::iterator hi = this->hexen.begin();
+            morph::hexlist::iterator hi = this->hexen.begin();
             while (hi != this->hexen.end()) {
 
                 if (hi->has_ne() == true) {
@@ -211,6 +279,7 @@ namespace morph {
             this->d_gi.clear();
             this->d_bi.clear();
             this->d_flags.clear();
+            this->d_flagwords.clear();
         }
 
 #ifdef HEXGRID_COMPILE_LOAD_AND_SAVE
@@ -261,7 +330,7 @@ namespace morph {
 
             // list<Hex> hexen
             // for i in list, save Hex
-            std::list<morph::Hex>::const_iterator h = this->hexen.begin();
+            morph::hexlist::const_iterator h = this->hexen.begin();
             unsigned int hcount = 0;
             while (h != this->hexen.end()) {
                 // Make up a path
@@ -330,7 +399,7 @@ namespace morph {
                 if (_h.has_ne() == true) {
                     bool matched = false;
                     unsigned int neighb_it = (unsigned int) this->d_ne[_h.vi];
-                    std::list<morph::Hex>::iterator hi = this->hexen.begin();
+                    morph::hexlist::iterator hi = this->hexen.begin();
                     while (hi != this->hexen.end()) {
                         if (hi->vi == neighb_it) {
                             matched = true;
@@ -347,7 +416,7 @@ namespace morph {
                 if (_h.has_nne() == true) {
                     bool matched = false;
                     unsigned int neighb_it = (unsigned int) this->d_nne[_h.vi];
-                    std::list<morph::Hex>::iterator hi = this->hexen.begin();
+                    morph::hexlist::iterator hi = this->hexen.begin();
                     while (hi != this->hexen.end()) {
                         if (hi->vi == neighb_it) {
                             matched = true;
@@ -364,7 +433,7 @@ namespace morph {
                 if (_h.has_nnw() == true) {
                     bool matched = false;
                     unsigned int neighb_it = (unsigned int) this->d_nnw[_h.vi];
-                    std::list<morph::Hex>::iterator hi = this->hexen.begin();
+                    morph::hexlist::iterator hi = this->hexen.begin();
                     while (hi != this->hexen.end()) {
                         if (hi->vi == neighb_it) {
                             matched = true;
@@ -381,7 +450,7 @@ namespace morph {
                 if (_h.has_nw() == true) {
                     bool matched = false;
                     unsigned int neighb_it = (unsigned int) this->d_nw[_h.vi];
-                    std::list<morph::Hex>::iterator hi = this->hexen.begin();
+                    morph::hexlist::iterator hi = this->hexen.begin();
                     while (hi != this->hexen.end()) {
                         if (hi->vi == neighb_it) {
                             matched = true;
@@ -398,7 +467,7 @@ namespace morph {
                 if (_h.has_nsw() == true) {
                     bool matched = false;
                     unsigned int neighb_it = (unsigned int) this->d_nsw[_h.vi];
-                    std::list<morph::Hex>::iterator hi = this->hexen.begin();
+                    morph::hexlist::iterator hi = this->hexen.begin();
                     while (hi != this->hexen.end()) {
                         if (hi->vi == neighb_it) {
                             matched = true;
@@ -415,7 +484,7 @@ namespace morph {
                 if (_h.has_nse() == true) {
                     bool matched = false;
                     unsigned int neighb_it = (unsigned int) this->d_nse[_h.vi];
-                    std::list<morph::Hex>::iterator hi = this->hexen.begin();
+                    morph::hexlist::iterator hi = this->hexen.begin();
                     while (hi != this->hexen.end()) {
                         if (hi->vi == neighb_it) {
                             matched = true;
@@ -432,6 +501,93 @@ namespace morph {
         }
 #endif // HEXGRID_COMPILE_LOAD_AND_SAVE
 
+        /*!
+         * Save this HexGrid into a flat binary snapshot at \a path. Unlike save(),
+         * which requires HDF5 and serializes the full list<Hex>, this writes only the
+         * scalars and the d_* vectors, as raw, contiguous arrays in the shared
+         * morph::snapshot format (versioned header, named sections, per-section
+         * CRC-32C). The layout is mmap-able: load_snapshot() maps the file and
+         * bulk-copies the arrays in place.
+         */
+        void save_snapshot (const std::string& path) const
+        {
+            morph::snapshot::writer w (path, hg_snapshot_tag, hg_snapshot_version);
+
+            w.add_value ("d", this->d);
+            w.add_value ("x_span", this->x_span);
+            w.add_value ("z", this->z);
+            w.add_value ("d_rowlen", this->d_rowlen);
+            w.add_value ("d_numrows", this->d_numrows);
+            w.add_value ("d_size", this->d_size);
+            w.add_value ("d_gb_horz", this->d_growthbuffer_horz);
+            w.add_value ("d_gb_vert", this->d_growthbuffer_vert);
+            w.add_value ("bcentroid", this->boundaryCentroid);
+            std::uint8_t reduced = this->gridReduced ? 1 : 0;
+            w.add_value ("gridReduced", reduced);
+
+            w.add_array ("d_x", this->d_x);
+            w.add_array ("d_y", this->d_y);
+            w.add_array ("d_ri", this->d_ri);
+            w.add_array ("d_gi", this->d_gi);
+            w.add_array ("d_bi", this->d_bi);
+            w.add_array ("d_ne", this->d_ne);
+            w.add_array ("d_nne", this->d_nne);
+            w.add_array ("d_nnw", this->d_nnw);
+            w.add_array ("d_nw", this->d_nw);
+            w.add_array ("d_nsw", this->d_nsw);
+            w.add_array ("d_nse", this->d_nse);
+            w.add_array ("d_flags", this->d_flags);
+            w.add_array ("d_distToBdry", this->d_distToBoundary);
+
+            w.finish();
+        }
+
+        /*!
+         * Populate this HexGrid from a binary snapshot written by save_snapshot(). The
+         * file is memory mapped (morph::snapshot::reader) and the d_* vectors filled by
+         * bulk copies from the map, with no morph::hexlist reconstruction and no
+         * boundary re-walk; hexen is left empty and is materialized lazily (see
+         * materialize_hexen()) only if a list-based method is called. Throws
+         * std::runtime_error if the file is missing, isn't a HexGrid snapshot, has the
+         * wrong version or fails its checksums.
+         */
+        void load_snapshot (const std::string& path)
+        {
+            morph::snapshot::reader r (path, hg_snapshot_tag, hg_snapshot_version);
+
+            r.value ("d", this->d);
+            r.value ("x_span", this->x_span);
+            r.value ("z", this->z);
+            this->v = this->d * morph::mathconst<float>::root_3_over_2;
+            r.value ("d_rowlen", this->d_rowlen);
+            r.value ("d_numrows", this->d_numrows);
+            r.value ("d_size", this->d_size);
+            r.value ("d_gb_horz", this->d_growthbuffer_horz);
+            r.value ("d_gb_vert", this->d_growthbuffer_vert);
+            r.value ("bcentroid", this->boundaryCentroid);
+            std::uint8_t reduced = 0;
+            r.value ("gridReduced", reduced);
+            this->gridReduced = reduced > 0;
+
+            r.fill ("d_x", this->d_x);
+            r.fill ("d_y", this->d_y);
+            r.fill ("d_ri", this->d_ri);
+            r.fill ("d_gi", this->d_gi);
+            r.fill ("d_bi", this->d_bi);
+            r.fill ("d_ne", this->d_ne);
+            r.fill ("d_nne", this->d_nne);
+            r.fill ("d_nnw", this->d_nnw);
+            r.fill ("d_nw", this->d_nw);
+            r.fill ("d_nsw", this->d_nsw);
+            r.fill ("d_nse", this->d_nse);
+            r.fill ("d_flags", this->d_flags);
+            r.fill ("d_distToBdry", this->d_distToBoundary);
+
+            // The flat arrays are the grid; the list representation, if needed, is
+            // materialized on demand
+            this->hexen.clear();
+        }
+
         /*!
          * Default constructor
          */
@@ -470,10 +626,22 @@ namespace morph {
             this->init();
         }
 
+        /*!
+         * Construct as HexGrid (float, float, float), but selecting the construction
+         * mode. With hexgridbuild::soa, the flat d_* vectors are populated directly and
+         * HexGrid::hexen is left empty; call materialize_hexen() (done automatically by
+         * the boundary-setting methods) if the list representation is needed.
+         */
+        HexGrid (float d_, float x_span_, float z_, hexgridbuild mode) : d(d_), x_span(x_span_), z(z_)
+        {
+            this->v = this->d * morph::mathconst<float>::root_3_over_2;
+            if (mode == hexgridbuild::soa) { this->init_soa(); } else { this->init(); }
+        }
+
         /*!
          * Compute the centroid of the passed in list of Hexes.
          */
-        morph::vec<float, 2> computeCentroid (const std::list<Hex>& pHexes)
+        morph::vec<float, 2> computeCentroid (const morph::hexlist& pHexes)
         {
             morph::vec<float, 2> centroid = {0,0};
             for (auto h : pHexes) {
@@ -488,10 +656,10 @@ namespace morph {
          * Find the Hex in the Hex grid which is closest to the x,y position given by
          * pos.
          */
-        std::list<Hex>::iterator findHexNearest (const morph::vec<float, 2>& pos)
+        morph::hexlist::iterator findHexNearest (const morph::vec<float, 2>& pos)
         {
-            std::list<morph::Hex>::iterator nearest = this->hexen.end();
-            std::list<morph::Hex>::iterator hi = this->hexen.begin();
+            morph::hexlist::iterator nearest = this->hexen.end();
+            morph::hexlist::iterator hi = this->hexen.begin();
             float dist = std::numeric_limits<float>::max();
             while (hi != this->hexen.end()) {
                 float dx = pos[0] - hi->x;
@@ -507,9 +675,9 @@ namespace morph {
         }
 
         // If possible, get the hex at the given rgb position
-        std::list<Hex>::iterator findHexAt (const morph::vec<int, 3>& rgbpos)
+        morph::hexlist::iterator findHexAt (const morph::vec<int, 3>& rgbpos)
         {
-            std::list<morph::Hex>::iterator hi = this->hexen.begin(); // First hex in hexen is always 0,0,0
+            morph::hexlist::iterator hi = this->hexen.begin(); // First hex in hexen is always 0,0,0
 
             // +ri is East
             int inc = rgbpos[0] > 0 ? 1 : -1;
@@ -549,14 +717,15 @@ namespace morph {
          * unlike void setBoundary (const BezCurvePath& p), this method does not apply
          * any offset to the positions of the hexes in @a pHexes.
          */
-        void setBoundary (const std::list<Hex>& pHexes)
+        void setBoundary (const morph::hexlist& pHexes)
         {
+            this->ensure_hexen();
             this->boundaryCentroid = this->computeCentroid (pHexes);
 
-            std::list<morph::Hex>::iterator bpoint = this->hexen.begin();
-            std::list<morph::Hex>::iterator bpi = this->hexen.begin();
+            morph::hexlist::iterator bpoint = this->hexen.begin();
+            morph::hexlist::iterator bpi = this->hexen.begin();
             while (bpi != this->hexen.end()) {
-                std::list<morph::Hex>::const_iterator ppi = pHexes.begin();
+                morph::hexlist::const_iterator ppi = pHexes.begin();
                 while (ppi != pHexes.end()) {
                     // NB: The assumption right now is that the pHexes are from the same dimension hex grid
                     // as this->hexen.
@@ -573,7 +742,7 @@ namespace morph {
 
             // Check that the boundary is contiguous.
             std::set<unsigned int> seen;
-            std::list<morph::Hex>::iterator hi = bpoint;
+            morph::hexlist::iterator hi = bpoint;
             if (this->boundaryContiguous (bpoint, hi, seen) == false) {
                 std::stringstream ee;
                 ee << "The boundary is not a contiguous sequence of hexes.";
@@ -594,6 +763,7 @@ namespace morph {
          */
         void setBoundary (const BezCurvePath<float>& p, bool loffset = true)
         {
+            MORPH_PROFILE_SCOPE ("HexGrid::setBoundary");
             this->boundary = p;
             if (!this->boundary.isNull()) {
                 // Compute the points on the boundary using half of the hex to hex
@@ -632,6 +802,7 @@ namespace morph {
          */
         void setBoundary (std::vector<BezCoord<float>>& bpoints, bool loffset = true)
         {
+            this->ensure_hexen();
             this->boundaryCentroid = morph::BezCurvePath<float>::getCentroid (bpoints);
 
             auto bpi = bpoints.begin();
@@ -649,7 +820,7 @@ namespace morph {
             }
 
             // now proceed with centroid changed or unchanged
-            std::list<morph::Hex>::iterator nearbyBoundaryPoint = this->hexen.begin(); // i.e the Hex at 0,0
+            morph::hexlist::iterator nearbyBoundaryPoint = this->hexen.begin(); // i.e the Hex at 0,0
             bpi = bpoints.begin();
             while (bpi != bpoints.end()) {
                 nearbyBoundaryPoint = this->setBoundary (*bpi++, nearbyBoundaryPoint);
@@ -658,7 +829,7 @@ namespace morph {
             // Check that the boundary is contiguous.
             {
                 std::set<unsigned int> seen;
-                std::list<morph::Hex>::iterator hi = nearbyBoundaryPoint;
+                morph::hexlist::iterator hi = nearbyBoundaryPoint;
                 if (this->boundaryContiguous (nearbyBoundaryPoint, hi, seen) == false) {
                     std::stringstream ee;
                     ee << "The constructed boundary is not a contiguous sequence of hexes.";
@@ -670,6 +841,77 @@ namespace morph {
             this->populate_d_vectors();
         }
 
+        /*!
+         * A parallel version of setBoundary (vector<BezCoord>&, bool). The boundary
+         * hexes are marked as usual, but the region inside the boundary is filled by a
+         * frontier-parallel breadth-first fill (markHexesInside_par) rather than by the
+         * serial inward walk, so it runs across all OpenMP threads. Useful when
+         * applying a boundary (e.g. an SVG curve from morph::ReadCurves) to a fine
+         * grid.
+         */
+        void setBoundary_par (std::vector<BezCoord<float>>& bpoints, bool loffset = true)
+        {
+            this->ensure_hexen();
+            this->boundaryCentroid = morph::BezCurvePath<float>::getCentroid (bpoints);
+
+            auto bpi = bpoints.begin();
+            // conditional executed if we reset the centre
+            if (loffset) {
+                while (bpi != bpoints.end()) {
+                    bpi->subtract (this->boundaryCentroid);
+                    ++bpi;
+                }
+                this->originalBoundaryCentroid = this->boundaryCentroid;
+                this->boundaryCentroid = {0.0f, 0.0f};
+                bpi = bpoints.begin();
+            }
+
+            // Mark the boundary hexes, serially; this is O(boundary) not O(hexes)
+            morph::hexlist::iterator nearbyBoundaryPoint = this->hexen.begin(); // i.e the Hex at 0,0
+            bpi = bpoints.begin();
+            while (bpi != bpoints.end()) {
+                nearbyBoundaryPoint = this->setBoundary (*bpi++, nearbyBoundaryPoint);
+            }
+
+            // Check that the boundary is contiguous.
+            {
+                std::set<unsigned int> seen;
+                morph::hexlist::iterator hi = nearbyBoundaryPoint;
+                if (this->boundaryContiguous (nearbyBoundaryPoint, hi, seen) == false) {
+                    std::stringstream ee;
+                    ee << "The constructed boundary is not a contiguous sequence of hexes.";
+                    throw std::runtime_error (ee.str());
+                }
+            }
+
+            // Fill the region inside the boundary in parallel, then discard hexes outside it
+            morph::hexlist::iterator centroidHex = this->findHexNearest (this->boundaryCentroid);
+            this->markHexesInside_par (centroidHex);
+            auto hi = this->hexen.begin();
+            while (hi != this->hexen.end()) {
+                if (hi->testFlags(HEX_INSIDE_BOUNDARY) == false) {
+                    hi->disconnectNeighbours();
+                    hi = this->hexen.erase (hi);
+                } else {
+                    ++hi;
+                }
+            }
+            this->renumberVectorIndices();
+            this->gridReduced = true;
+            this->populate_d_vectors();
+        }
+
+        //! Parallel version of setBoundary (const BezCurvePath<float>&, bool)
+        void setBoundary_par (const BezCurvePath<float>& p, bool loffset = true)
+        {
+            this->boundary = p;
+            if (!this->boundary.isNull()) {
+                this->boundary.computePoints (this->d/2.0f, true);
+                std::vector<morph::BezCoord<float>> bpoints = this->boundary.getPoints();
+                this->setBoundary_par (bpoints, loffset);
+            }
+        }
+
         /*!
          * This sets a boundary, just as
          * morph::HexGrid::setBoundary(vector<morph::BezCoord<float>& bpoints, bool offset)
@@ -681,6 +923,7 @@ namespace morph {
          */
         void setBoundaryOnly (std::vector<BezCoord<float>>& bpoints, bool loffset)
         {
+            this->ensure_hexen();
             this->boundaryCentroid = morph::BezCurvePath<float>::getCentroid (bpoints);
 
             auto bpi = bpoints.begin();
@@ -700,7 +943,7 @@ namespace morph {
             // now proceed with centroid changed or unchanged. First: clear all boundary flags
             for (auto h : this->hexen) { h.unsetUserFlag (HEX_IS_BOUNDARY); }
 
-            std::list<morph::Hex>::iterator nearbyBoundaryPoint = this->hexen.begin(); // i.e the Hex at 0,0
+            morph::hexlist::iterator nearbyBoundaryPoint = this->hexen.begin(); // i.e the Hex at 0,0
             bpi = bpoints.begin();
             while (bpi != bpoints.end()) {
                 nearbyBoundaryPoint = this->setBoundary (*bpi++, nearbyBoundaryPoint);
@@ -709,7 +952,7 @@ namespace morph {
             // Check that the boundary is contiguous.
             {
                 std::set<unsigned int> seen;
-                std::list<morph::Hex>::iterator hi = nearbyBoundaryPoint;
+                morph::hexlist::iterator hi = nearbyBoundaryPoint;
                 if (this->boundaryContiguous (nearbyBoundaryPoint, hi, seen) == false) {
                     std::stringstream ee;
                     ee << "The constructed boundary is not a contiguous sequence of hexes.";
@@ -727,9 +970,10 @@ namespace morph {
          */
         void setBoundaryOnOuterEdge()
         {
+            this->ensure_hexen();
             // From centre head to boundary, then mark boundary and walk
             // around the edge.
-            std::list<morph::Hex>::iterator bpi = this->hexen.begin();
+            morph::hexlist::iterator bpi = this->hexen.begin();
             while (bpi->has_nne()) { bpi = bpi->nne; }
             bpi->setFlag (HEX_IS_BOUNDARY | HEX_INSIDE_BOUNDARY);
             while (bpi->has_ne()) {
@@ -762,7 +1006,7 @@ namespace morph {
             }
             // Check that the boundary is contiguous.
             std::set<unsigned int> seen;
-            std::list<morph::Hex>::iterator hi = bpi;
+            morph::hexlist::iterator hi = bpi;
             if (this->boundaryContiguous (bpi, hi, seen) == false) {
                 std::stringstream ee;
                 ee << "The boundary is not a contiguous sequence of hexes.";
@@ -783,9 +1027,9 @@ namespace morph {
          *
          * Now a getter for this->bhexen.
          */
-        std::list<Hex> getBoundary() const
+        morph::hexlist getBoundary() const
         {
-            std::list<morph::Hex> bhexen_concrete;
+            morph::hexlist bhexen_concrete;
             auto hh = this->bhexen.begin();
             while (hh != this->bhexen.end()) {
                 bhexen_concrete.push_back (*(*hh));
@@ -996,7 +1240,12 @@ namespace morph {
          *
          * return The number of hexes in the grid.
          */
-        unsigned int num() const { return this->hexen.size(); }
+        unsigned int num() const
+        {
+            // After structure-of-arrays construction, hexen may be empty while the d_
+            // vectors hold the grid
+            return this->hexen.empty() ? this->d_x.size() : this->hexen.size();
+        }
 
         /*!
          * \brief Obtain the vector index of the last Hex in hexen.
@@ -1154,7 +1403,7 @@ namespace morph {
          */
         void computeDistanceToBoundary()
         {
-            std::list<morph::Hex>::iterator h = this->hexen.begin();
+            morph::hexlist::iterator h = this->hexen.begin();
             while (h != this->hexen.end()) {
                 if (h->testFlags(HEX_IS_BOUNDARY) == true) {
                     h->distToBoundary = 0.0f;
@@ -1164,7 +1413,7 @@ namespace morph {
                         h->distToBoundary = -100.0;
                     } else {
                         // Not a boundary hex, but inside boundary
-                        std::list<morph::Hex>::iterator bh = this->hexen.begin();
+                        morph::hexlist::iterator bh = this->hexen.begin();
                         while (bh != this->hexen.end()) {
                             if (bh->testFlags(HEX_IS_BOUNDARY) == true) {
                                 float delta = h->distanceFrom (*bh);
@@ -1180,13 +1429,101 @@ namespace morph {
             }
         }
 
+        /*!
+         * Compute the distance to the nearest boundary hex for every hex by multi-source
+         * propagation over the d_ vectors, rather than the all-pairs scan of
+         * computeDistanceToBoundary(). Every boundary hex starts as its own nearest-boundary
+         * candidate; each sweep, hexes adopt a better candidate from their six neighbours
+         * (compared by true Euclidean distance), so candidates spread one hex ring per sweep
+         * and the cost is O(num() x grid radius in hexes) instead of O(num() x number of
+         * boundary hexes). Sweeps parallelize with OpenMP; double buffering keeps them race
+         * free. Like fast marching, the relay of candidates is not guaranteed to deliver
+         * every hex its globally nearest boundary hex - the discrete boundary ring is jagged
+         * even for a smooth boundary curve - so distances can exceed the all-pairs answer by
+         * a fraction of the hex spacing d (boundary hexes themselves are exactly 0). Use
+         * computeDistanceToBoundary() where that fraction matters more than the run time.
+         *
+         * Results go into d_distToBoundary and, if the hexen list is populated, into each
+         * Hex's distToBoundary. As for computeDistanceToBoundary(), a hex outside the
+         * boundary (or any hex, if no boundary has been set) gets the dummy value -100.
+         */
+        void computeDistanceToBoundaryFast()
+        {
+            const int nhex = static_cast<int>(this->d_x.size());
+            if (nhex == 0) { return; }
+
+            // nearest[i] is the d_ index of the best candidate nearest boundary hex so
+            // far; dist[i] the squared distance to it. Seed from the boundary hexes.
+            std::vector<int> nearest (nhex, -1);
+            std::vector<float> dist (nhex, std::numeric_limits<float>::max());
+#pragma omp parallel for
+            for (int i = 0; i < nhex; ++i) {
+                if (this->d_flags[i] & HEX_IS_BOUNDARY) {
+                    nearest[i] = i;
+                    dist[i] = 0.0f;
+                }
+            }
+            std::vector<int> nearest_next (nearest);
+            std::vector<float> dist_next (dist);
+
+            const std::array<const std::vector<int>*, 6> nbrs = {
+                &this->d_ne, &this->d_nne, &this->d_nnw, &this->d_nw, &this->d_nsw, &this->d_nse
+            };
+
+            int n_changed = 1;
+            while (n_changed > 0) {
+                n_changed = 0;
+#pragma omp parallel for reduction(+:n_changed)
+                for (int i = 0; i < nhex; ++i) {
+                    int best = nearest[i];
+                    float bestd = dist[i];
+                    for (const std::vector<int>* nv : nbrs) {
+                        const int n = (*nv)[i];
+                        if (n < 0) { continue; }
+                        const int cand = nearest[n];
+                        if (cand < 0 || cand == best) { continue; }
+                        const float dx = this->d_x[i] - this->d_x[cand];
+                        const float dy = this->d_y[i] - this->d_y[cand];
+                        const float dd = dx * dx + dy * dy;
+                        if (dd < bestd) {
+                            bestd = dd;
+                            best = cand;
+                        }
+                    }
+                    nearest_next[i] = best;
+                    dist_next[i] = bestd;
+                    if (best != nearest[i]) { ++n_changed; }
+                }
+                std::swap (nearest, nearest_next);
+                std::swap (dist, dist_next);
+            }
+
+            this->d_distToBoundary.resize (nhex);
+#pragma omp parallel for
+            for (int i = 0; i < nhex; ++i) {
+                // As in computeDistanceToBoundary(), hexes outside the boundary (and
+                // all hexes if no boundary has been applied) get a dummy value
+                if (nearest[i] < 0 || (this->d_flags[i] & (HEX_IS_BOUNDARY | HEX_INSIDE_BOUNDARY)) == 0) {
+                    this->d_distToBoundary[i] = -100.0f;
+                } else {
+                    this->d_distToBoundary[i] = std::sqrt (dist[i]);
+                }
+            }
+
+            if (!this->hexen.empty()) {
+                for (auto hi = this->hexen.begin(); hi != this->hexen.end(); ++hi) {
+                    hi->distToBoundary = this->d_distToBoundary[hi->di];
+                }
+            }
+        }
+
         /*!
          * Populate the d_* vectors
          */
         void populate_d_vectors()
         {
             // The starting hex is always the centre one.
-            std::list<morph::Hex>::iterator hi = this->hexen.begin();
+            morph::hexlist::iterator hi = this->hexen.begin();
             // Clear the d_ vectors.
             this->d_clear();
             // Now raster through the hexes, building the d_ vectors.
@@ -1198,6 +1535,47 @@ namespace morph {
             this->populate_d_neighbours();
         }
 
+        /*!
+         * Build the morph::hexlist hexen representation from the d_* vectors. This is
+         * required after structure-of-arrays construction (see hexgridbuild::soa),
+         * which does not create hexen up front. Hex flags, neighbour pointers and
+         * distToBoundary are all restored from the flat arrays. A no-op if hexen is
+         * already populated.
+         */
+        void materialize_hexen()
+        {
+            if (!this->hexen.empty() || this->d_x.empty()) { return; }
+
+            unsigned int nhex = this->d_x.size();
+            std::vector<morph::hexlist::iterator> hexits (nhex);
+            for (unsigned int i = 0; i < nhex; ++i) {
+                this->hexen.emplace_back (i, this->d, this->d_ri[i], this->d_gi[i]);
+                morph::hexlist::iterator hi = this->hexen.end(); --hi;
+                hi->di = i;
+                hi->distToBoundary = this->d_distToBoundary[i];
+                // Neighbour flags are reinstated by set_ne and friends, below
+                hi->setFlag (this->d_flags[i] & ~static_cast<unsigned int>(HEX_HAS_NEIGHB_ALL));
+                hexits[i] = hi;
+            }
+            for (unsigned int i = 0; i < nhex; ++i) {
+                morph::hexlist::iterator hi = hexits[i];
+                if (this->d_ne[i] > -1) { hi->set_ne (hexits[this->d_ne[i]]); }
+                if (this->d_nne[i] > -1) { hi->set_nne (hexits[this->d_nne[i]]); }
+                if (this->d_nnw[i] > -1) { hi->set_nnw (hexits[this->d_nnw[i]]); }
+                if (this->d_nw[i] > -1) { hi->set_nw (hexits[this->d_nw[i]]); }
+                if (this->d_nsw[i] > -1) { hi->set_nsw (hexits[this->d_nsw[i]]); }
+                if (this->d_nse[i] > -1) { hi->set_nse (hexits[this->d_nse[i]]); }
+            }
+            // Restore the vertex iterators of the initial hexagonal grid (used by output())
+            int mr = static_cast<int>(std::abs (std::ceil ((this->x_span / 2.0f) / this->d)));
+            this->vertexNW = this->findHexAt (morph::vec<int, 3>{ -mr, mr, 0 });
+            this->vertexNE = this->findHexAt (morph::vec<int, 3>{ 0, mr, 0 });
+            this->vertexE = this->findHexAt (morph::vec<int, 3>{ mr, 0, 0 });
+            this->vertexSE = this->findHexAt (morph::vec<int, 3>{ mr, -mr, 0 });
+            this->vertexSW = this->findHexAt (morph::vec<int, 3>{ 0, -mr, 0 });
+            this->vertexW = this->findHexAt (morph::vec<int, 3>{ -mr, 0, 0 });
+        }
+
         /*!
          * Get a vector of Hex pointers for all hexes that are inside/on the path
          * defined by the BezCurvePath \a p, thus this gets a 'region of hexes'. The Hex
@@ -1216,7 +1594,7 @@ namespace morph {
          *
          * \return a vector of iterators to the Hexes that make up the region.
          */
-        std::vector<std::list<Hex>::iterator> getRegion (BezCurvePath<float>& p, morph::vec<float, 2>& regionCentroid,
+        std::vector<morph::hexlist::iterator> getRegion (BezCurvePath<float>& p, morph::vec<float, 2>& regionCentroid,
                                                          bool applyOriginalBoundaryCentroid = true)
         {
             p.computePoints (this->d/2.0f, true);
@@ -1227,7 +1605,7 @@ namespace morph {
         /*!
          * The overload of getRegion that does all the work on a vector of coordinates
          */
-        std::vector<std::list<Hex>::iterator> getRegion (std::vector<BezCoord<float>>& bpoints, morph::vec<float, 2>& regionCentroid,
+        std::vector<morph::hexlist::iterator> getRegion (std::vector<BezCoord<float>>& bpoints, morph::vec<float, 2>& regionCentroid,
                                                          bool applyOriginalBoundaryCentroid = true)
         {
             // First clear all region boundary flags, as we'll be defining a new region boundary
@@ -1237,7 +1615,7 @@ namespace morph {
             regionCentroid = morph::BezCurvePath<float>::getCentroid (bpoints);
 
             // A return object
-            std::vector<std::list<morph::Hex>::iterator> theRegion;
+            std::vector<morph::hexlist::iterator> theRegion;
 
             if (applyOriginalBoundaryCentroid) {
                 auto bpi = bpoints.begin();
@@ -1251,7 +1629,7 @@ namespace morph {
             }
 
             // Now find the hexes on the boundary of the region
-            std::list<morph::Hex>::iterator nearbyRegionBoundaryPoint = this->hexen.begin(); // i.e the Hex at 0,0
+            morph::hexlist::iterator nearbyRegionBoundaryPoint = this->hexen.begin(); // i.e the Hex at 0,0
             typename std::vector<morph::BezCoord<float>>::iterator bpi = bpoints.begin();
             while (bpi != bpoints.end()) {
                 nearbyRegionBoundaryPoint = this->setRegionBoundary (*bpi++, nearbyRegionBoundaryPoint);
@@ -1260,7 +1638,7 @@ namespace morph {
             // Check that the region boundary is contiguous.
             {
                 std::set<unsigned int> seen;
-                std::list<morph::Hex>::iterator hi = nearbyRegionBoundaryPoint;
+                morph::hexlist::iterator hi = nearbyRegionBoundaryPoint;
                 if (this->regionBoundaryContiguous (nearbyRegionBoundaryPoint, hi, seen) == false) {
                     std::stringstream ee;
                     ee << "The constructed region boundary is not a contiguous sequence of hexes.";
@@ -1269,11 +1647,11 @@ namespace morph {
             }
 
             // Mark hexes inside region. Use centroid of the region.
-            std::list<morph::Hex>::iterator insideRegionHex = this->findHexNearest (regionCentroid);
+            morph::hexlist::iterator insideRegionHex = this->findHexNearest (regionCentroid);
             this->markHexesInside (insideRegionHex, HEX_IS_REGION_BOUNDARY, HEX_INSIDE_REGION);
 
             // Populate theRegion, then return it
-            std::list<morph::Hex>::iterator hi = this->hexen.begin();
+            morph::hexlist::iterator hi = this->hexen.begin();
             while (hi != this->hexen.end()) {
                 if (hi->testFlags (HEX_INSIDE_REGION) == true) {
                     theRegion.push_back (hi);
@@ -1286,12 +1664,12 @@ namespace morph {
 
         //! Obtain a hexagonal region of hexes around a given central hex, marked by its
         //! d_ index. This is easier than getting a properly circular region of hexes.
-        std::vector<std::list<Hex>::iterator> getHexagonalRegion (unsigned int centreindex, float radius)
+        std::vector<morph::hexlist::iterator> getHexagonalRegion (unsigned int centreindex, float radius)
         {
-            std::vector<std::list<morph::Hex>::iterator> theRegion;
+            std::vector<morph::hexlist::iterator> theRegion;
 
             // Find the hex with index centreindex
-            std::list<Hex>::iterator sh = this->hexen.begin(); // start hex
+            morph::hexlist::iterator sh = this->hexen.begin(); // start hex
             while (sh != this->hexen.end()) {
                 if (sh->vi == centreindex) { break; }
                 sh++;
@@ -1304,8 +1682,8 @@ namespace morph {
             // For each of 6 directions, step out to collect up the hexes on the disc
             // ring by ring. For rings 2 and above, also need to fill in hexes
             // (otherwise you end up with a snowflake shaped disc)
-            std::list<Hex>::iterator h;
-            std::list<Hex>::iterator h2; // for the tangent direction
+            morph::hexlist::iterator h;
+            morph::hexlist::iterator h2; // for the tangent direction
             for (unsigned short i = 0; i < 6; ++i) {
                 h = sh;
                 if (h->has_neighbour(i)) {
@@ -1368,12 +1746,12 @@ namespace morph {
             }
 
             // For each hex in this HexGrid, compute the convolution kernel
-            std::list<Hex>::iterator hi = this->hexen.begin();
+            morph::hexlist::iterator hi = this->hexen.begin();
             for (; hi != this->hexen.end(); ++hi) {
                 T sum = T{0};
                 // For each kernel hex, sum up.
                 for (auto kh : kernelgrid.hexen) {
-                    std::list<Hex>::iterator dhi = hi;
+                    morph::hexlist::iterator dhi = hi;
                     // Kernel hex coords r,g are: kh.ri, kh.gi, which may be (are EXPECTED to be) +ve or -ve
                     //
                     // Origin hex coords are h.ri, h.gi
@@ -1514,6 +1892,279 @@ namespace morph {
             return expr_resampled;
         }
 
+        /*!
+         * As resampleImage, but with the per-hex Gaussian kernel - the indices of the
+         * contributing image pixels and their weights - precomputed on the first call and
+         * reused while the image geometry (pixel dimensions, scale and offset) is unchanged.
+         * Use this when resampling a stream of same-sized images (video frames, for example)
+         * onto the grid; the per-frame cost is then just the weighted sums, computed across
+         * hexes with OpenMP.
+         *
+         * The kernel contains only those pixels within 3 sigma of each hex (resampleImage
+         * evaluates a Gaussian over *every* pixel for every hex, relying on exp underflow to
+         * exclude distant ones), so even the cache-building first call is cheaper than one
+         * resampleImage call for all but tiny images, and its result differs only by
+         * contributions of weight < exp(-4.5).
+         */
+        morph::vvec<float> resampleImage_cached (const morph::vvec<float>& image_data,
+                                                 const unsigned int image_pixelwidth,
+                                                 const morph::vec<float, 2>& image_scale,
+                                                 const morph::vec<float, 2>& image_offset)
+        {
+            unsigned int csz = image_data.size();
+            morph::vec<unsigned int, 2> image_pixelsz = {image_pixelwidth, csz / image_pixelwidth};
+
+            morph::vvec<float> expr_resampled(this->num(), 0.0f);
+
+            // The all-identical short-cut, as in resampleImage
+            float i0 = image_data[0];
+            bool all_same = true;
+            for (auto id : image_data) {
+                if (id != i0) {
+                    all_same = false;
+                    break;
+                }
+            }
+            if (all_same) {
+                expr_resampled.set_from (i0);
+                return expr_resampled;
+            }
+
+            // (Re)build the kernel cache if the image geometry has changed
+            if (this->resample_cache.image_pixelsz != image_pixelsz
+                || this->resample_cache.image_scale != image_scale
+                || this->resample_cache.image_offset != image_offset
+                || this->resample_cache.offsets.size() != this->d_x.size() + 1u) {
+                this->buildResampleCache (image_pixelsz, image_scale, image_offset);
+            }
+
+            const std::vector<unsigned int>& roffs = this->resample_cache.offsets;
+            const std::vector<unsigned int>& rpix = this->resample_cache.pixel_idx;
+            const std::vector<float>& rweight = this->resample_cache.weight;
+#pragma omp parallel for
+            for (typename std::vector<float>::size_type xi = 0u; xi < this->d_x.size(); ++xi) {
+                float expr = 0.0f;
+                for (unsigned int e = roffs[xi]; e < roffs[xi + 1u]; ++e) {
+                    expr += rweight[e] * image_data[rpix[e]];
+                }
+                expr_resampled[xi] = expr;
+            }
+
+            expr_resampled /= expr_resampled.max(); // renormalise result
+            return expr_resampled;
+        }
+
+    protected:
+        //! Per-hex contributing-pixel kernels for resampleImage_cached, flattened: hex xi's
+        //! (pixel index, weight) pairs occupy entries [offsets[xi], offsets[xi+1]).
+        struct ResampleKernelCache
+        {
+            morph::vec<unsigned int, 2> image_pixelsz = { 0u, 0u };
+            morph::vec<float, 2> image_scale = { 0.0f, 0.0f };
+            morph::vec<float, 2> image_offset = { 0.0f, 0.0f };
+            std::vector<unsigned int> offsets;
+            std::vector<unsigned int> pixel_idx;
+            std::vector<float> weight;
+        };
+        ResampleKernelCache resample_cache;
+
+        //! Compute the per-hex pixel kernels for resampleImage_cached. The Gaussian width
+        //! parameters match resampleImage's; only pixels within 3 sigma of the hex go into
+        //! the kernel.
+        void buildResampleCache (const morph::vec<unsigned int, 2>& image_pixelsz,
+                                 const morph::vec<float, 2>& image_scale,
+                                 const morph::vec<float, 2>& image_offset)
+        {
+            // Geometry parameters as in resampleImage
+            morph::vec<float, 2> dist_per_pix = image_scale / (image_pixelsz[0] - 1u);
+            morph::vec<float, 2> input_centering_offset = dist_per_pix * image_pixelsz * 0.5f;
+            morph::vec<float, 2> params = 1.0f / (2.0f * dist_per_pix * dist_per_pix);
+            morph::vec<float, 2> threesig = 3.0f * dist_per_pix;
+
+            const std::size_t nhex = this->d_x.size();
+            std::vector<std::vector<unsigned int>> hex_pix (nhex);
+            std::vector<std::vector<float>> hex_w (nhex);
+#pragma omp parallel for
+            for (std::size_t xi = 0u; xi < nhex; ++xi) {
+                // Pixel index window within 3 sigma of this hex. Pixel idx sits at
+                // posn = dist_per_pix * idx - input_centering_offset + image_offset
+                morph::vec<float, 2> hexpos = { this->d_x[xi], this->d_y[xi] };
+                morph::vec<float, 2> lo = (hexpos - threesig + input_centering_offset - image_offset) / dist_per_pix;
+                morph::vec<float, 2> hi = (hexpos + threesig + input_centering_offset - image_offset) / dist_per_pix;
+                unsigned int ix0 = lo[0] < 0.0f ? 0u : static_cast<unsigned int>(lo[0]);
+                unsigned int iy0 = lo[1] < 0.0f ? 0u : static_cast<unsigned int>(lo[1]);
+                unsigned int ix1 = hi[0] < 0.0f ? 0u : static_cast<unsigned int>(std::ceil (hi[0]));
+                unsigned int iy1 = hi[1] < 0.0f ? 0u : static_cast<unsigned int>(std::ceil (hi[1]));
+                ix1 = ix1 >= image_pixelsz[0] ? image_pixelsz[0] - 1u : ix1;
+                iy1 = iy1 >= image_pixelsz[1] ? image_pixelsz[1] - 1u : iy1;
+                for (unsigned int iy = iy0; iy <= iy1; ++iy) {
+                    for (unsigned int ix = ix0; ix <= ix1; ++ix) {
+                        morph::vec<unsigned int, 2> idx = { ix, iy };
+                        morph::vec<float, 2> posn = (dist_per_pix * idx) - input_centering_offset + image_offset;
+                        float _d_x = hexpos[0] - posn[0];
+                        float _d_y = hexpos[1] - posn[1];
+                        hex_pix[xi].push_back (iy * image_pixelsz[0] + ix);
+                        hex_w[xi].push_back (std::exp ( - ( (params[0] * _d_x * _d_x) + (params[1] * _d_y * _d_y) ) ));
+                    }
+                }
+            }
+            // Flatten into the cache
+            this->resample_cache.offsets.assign (nhex + 1u, 0u);
+            std::size_t total = 0u;
+            for (std::size_t xi = 0u; xi < nhex; ++xi) {
+                total += hex_pix[xi].size();
+                this->resample_cache.offsets[xi + 1u] = static_cast<unsigned int>(total);
+            }
+            this->resample_cache.pixel_idx.clear();
+            this->resample_cache.pixel_idx.reserve (total);
+            this->resample_cache.weight.clear();
+            this->resample_cache.weight.reserve (total);
+            for (std::size_t xi = 0u; xi < nhex; ++xi) {
+                this->resample_cache.pixel_idx.insert (this->resample_cache.pixel_idx.end(),
+                                                       hex_pix[xi].begin(), hex_pix[xi].end());
+                this->resample_cache.weight.insert (this->resample_cache.weight.end(),
+                                                    hex_w[xi].begin(), hex_w[xi].end());
+            }
+            this->resample_cache.image_pixelsz = image_pixelsz;
+            this->resample_cache.image_scale = image_scale;
+            this->resample_cache.image_offset = image_offset;
+        }
+
+    public:
+
+        /*!
+         * The inverse of resampleImage: sample per-hex data onto a regular w x h raster (for
+         * PNG export or use as a texture). Each raster pixel takes the value of its nearest
+         * hex, found not by searching but from the hex lattice geometry (the pixel position
+         * converts to fractional r/g lattice indices, which round to the nearest hex). The
+         * pixel-to-hex index map is built on the first call for a given raster geometry and
+         * reused across frames, so repeated exports cost one indexed copy per pixel, run in
+         * parallel.
+         *
+         * \param data (input) The per-hex data, ordered as the d_ vectors (d_x/d_y)
+         * \param w (input) The width of the raster in pixels
+         * \param h (input) The height of the raster in pixels
+         * \param image_scale (input) The HexGrid-units width and height that the raster spans
+         * \param image_offset (input) Offset of the raster centre from the HexGrid origin
+         * \param fill (input) The value given to pixels that lie on no hex
+         *
+         * \return The raster as a vvec of w*h floats, running from bottom left to top right
+         * (the same convention as resampleImage's input)
+         */
+        morph::vvec<float> rasterize (const std::span<const float> data,
+                                      const unsigned int w, const unsigned int h,
+                                      const morph::vec<float, 2>& image_scale,
+                                      const morph::vec<float, 2>& image_offset,
+                                      const float fill = 0.0f)
+        {
+            morph::vec<unsigned int, 2> raster_sz = { w, h };
+            if (this->raster_cache.raster_sz != raster_sz
+                || this->raster_cache.image_scale != image_scale
+                || this->raster_cache.image_offset != image_offset) {
+                this->buildRasterMap (raster_sz, image_scale, image_offset);
+            }
+
+            morph::vvec<float> im (static_cast<std::size_t>(w) * h, fill);
+            const std::vector<int>& hmap = this->raster_cache.hex_idx;
+#pragma omp parallel for
+            for (std::size_t pi = 0; pi < im.size(); ++pi) {
+                int hi = hmap[pi];
+                if (hi >= 0 && static_cast<std::size_t>(hi) < data.size()) { im[pi] = data[hi]; }
+            }
+            return im;
+        }
+
+    protected:
+        //! The pixel-to-hex index map for rasterize: for each pixel of the raster, the d_
+        //! index of the hex it lies on, or -1 if it lies on no hex
+        struct RasterMapCache
+        {
+            morph::vec<unsigned int, 2> raster_sz = { 0u, 0u };
+            morph::vec<float, 2> image_scale = { 0.0f, 0.0f };
+            morph::vec<float, 2> image_offset = { 0.0f, 0.0f };
+            std::vector<int> hex_idx;
+        };
+        RasterMapCache raster_cache;
+
+        //! Build the pixel-to-hex map for rasterize. Pixel positions follow resampleImage's
+        //! layout convention (raster centred on image_offset, pixel spacing set by the raster
+        //! width), inverted through the hex lattice geometry (Hex::x = d*ri + (d/2)*gi,
+        //! Hex::y = v*gi) with cube-coordinate rounding to find the nearest lattice hex.
+        void buildRasterMap (const morph::vec<unsigned int, 2>& raster_sz,
+                             const morph::vec<float, 2>& image_scale,
+                             const morph::vec<float, 2>& image_offset)
+        {
+            // An (ri,gi) to d_ index lookup for the grid's hexes
+            std::unordered_map<std::int64_t, int> rg_to_idx;
+            rg_to_idx.reserve (this->d_ri.size());
+            for (std::size_t i = 0; i < this->d_ri.size(); ++i) {
+                std::int64_t key = (static_cast<std::int64_t>(this->d_ri[i]) << 32)
+                    | (static_cast<std::int64_t>(this->d_gi[i]) & 0xffffffffll);
+                rg_to_idx[key] = static_cast<int>(i);
+            }
+
+            morph::vec<float, 2> dist_per_pix = image_scale / (raster_sz[0] - 1u);
+            morph::vec<float, 2> input_centering_offset = dist_per_pix * raster_sz * 0.5f;
+
+            this->raster_cache.hex_idx.assign (static_cast<std::size_t>(raster_sz[0]) * raster_sz[1], -1);
+#pragma omp parallel for
+            for (std::size_t pi = 0; pi < this->raster_cache.hex_idx.size(); ++pi) {
+                morph::vec<unsigned int, 2> idx = { static_cast<unsigned int>(pi) % raster_sz[0],
+                                                    static_cast<unsigned int>(pi) / raster_sz[0] };
+                morph::vec<float, 2> posn = (dist_per_pix * idx) - input_centering_offset + image_offset;
+                // Invert the hex position equations for fractional lattice indices
+                float gi_f = posn[1] / this->v;
+                float ri_f = (posn[0] - 0.5f * this->d * gi_f) / this->d;
+                // Round to the nearest hex in cube coordinates (x=ri, z=gi, y=-x-z)
+                float cx = ri_f;
+                float cz = gi_f;
+                float cy = -cx - cz;
+                float rx = std::round (cx);
+                float ry = std::round (cy);
+                float rz = std::round (cz);
+                float ex = std::abs (rx - cx);
+                float ey = std::abs (ry - cy);
+                float ez = std::abs (rz - cz);
+                if (ex > ey && ex > ez) {
+                    rx = -ry - rz;
+                } else if (ey > ez) {
+                    ry = -rx - rz;
+                } else {
+                    rz = -rx - ry;
+                }
+                std::int64_t key = (static_cast<std::int64_t>(static_cast<int>(rx)) << 32)
+                    | (static_cast<std::int64_t>(static_cast<int>(rz)) & 0xffffffffll);
+                auto mi = rg_to_idx.find (key);
+                if (mi != rg_to_idx.end()) { this->raster_cache.hex_idx[pi] = mi->second; }
+            }
+            this->raster_cache.raster_sz = raster_sz;
+            this->raster_cache.image_scale = image_scale;
+            this->raster_cache.image_offset = image_offset;
+        }
+
+    public:
+
+        /*!
+         * Return the d_ indices of the hexes whose centres lie within the rectangle [xmin,
+         * xmax] x [ymin, ymax]. This is the HexGrid analogue of Grid::subgrid(): operations
+         * serving a zoomed-in view or a localized computation can loop over just these
+         * indices, rather than all num() hexes. The HexGrid's storage has no rectangular
+         * structure, so the 'view' is an index list; build it once per zoom region and reuse
+         * it across frames.
+         */
+        std::vector<unsigned int> subgridIndices (const float xmin, const float xmax,
+                                                  const float ymin, const float ymax) const
+        {
+            std::vector<unsigned int> inds;
+            for (unsigned int i = 0; i < this->d_x.size(); ++i) {
+                if (this->d_x[i] >= xmin && this->d_x[i] <= xmax
+                    && this->d_y[i] >= ymin && this->d_y[i] <= ymax) {
+                    inds.push_back (i);
+                }
+            }
+            return inds;
+        }
+
         // Member attributes for visualising the compute_hex_overlap stuff. Put in class HexOverlapGeometry or something
         vec<float, 2> sw_loc = {std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::quiet_NaN()};
         vec<float, 2> nw_loc = {std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::quiet_NaN()};
@@ -1652,14 +2303,14 @@ namespace morph {
 
             static constexpr bool debugdata = false;
 
-            std::list<Hex>::iterator h = this->hexen.begin();
+            morph::hexlist::iterator h = this->hexen.begin();
             while (h != this->hexen.end()) {
                 // image_data[i] is the data to shift.
                 bool datatocopy = false;
                 if constexpr (debugdata) {
                     datatocopy = image_data[h->vi] > T{0} ? true : false;
                 }
-                std::list<Hex>::iterator dest_hex = h;
+                morph::hexlist::iterator dest_hex = h;
                 if (datatocopy) std::cout << "Copying hex data at " << h->outputRG() << "...";
                 if (int_rg[1] > 0) {
                     for (int j = 0; j < int_rg[1] && dest_hex->has_nne(); ++j) {
@@ -2747,7 +3398,7 @@ namespace morph {
             bool first = true;
             std::array<float, 4> limits = {{0,0,0,0}};
             auto h = this->hexen.begin();
-            std::list<Hex>::iterator bl_hex = this->hexen.begin();
+            morph::hexlist::iterator bl_hex = this->hexen.begin();
             while (h != this->hexen.end()) {
                 if (h->testFlags(HEX_IS_BOUNDARY) == true) {
                     if (first) {
@@ -2765,12 +3416,12 @@ namespace morph {
             //std::cout << "Bottom left hex is " << bl_hex->outputCart() << std::endl;
 
             int count = 0;
-            std::list<Hex>::iterator row_start = bl_hex;
+            morph::hexlist::iterator row_start = bl_hex;
             if (onR) {
                 // go to end of each row and wrap back to the start. This may only work
                 // for parallelograms, at least in an initial implementation.
                 // First row
-                std::list<Hex>::iterator cur_hex = row_start;
+                morph::hexlist::iterator cur_hex = row_start;
                 while (cur_hex->has_ne()) { cur_hex = cur_hex->ne; }
                 cur_hex->set_ne(bl_hex);
                 bl_hex->set_nw(cur_hex);
@@ -2791,11 +3442,11 @@ namespace morph {
                 }
             }
 
-            std::list<Hex>::iterator col_start = bl_hex;
+            morph::hexlist::iterator col_start = bl_hex;
             int vcount = 0;
             if (onG) { // scan up columns in the 'G' direction
                 // First col
-                std::list<Hex>::iterator cur_hex = col_start;
+                morph::hexlist::iterator cur_hex = col_start;
                 while (cur_hex->has_nne()) { cur_hex = cur_hex->nne; ++vcount; }
                 cur_hex->set_nne (bl_hex);
                 bl_hex->set_nsw (cur_hex);
@@ -2829,7 +3480,7 @@ namespace morph {
             // Final scan across to set se neighbours of end rows and nw neighbours of start rows.
             row_start = bl_hex;
             if (onR && onG) {
-                std::list<Hex>::iterator cur_hex = row_start;
+                morph::hexlist::iterator cur_hex = row_start;
                 // First row
                 for (int i = 0; i < count; ++i) { cur_hex = cur_hex->ne; }
                 row_start->set_nnw(cur_hex->nne);
@@ -2848,7 +3499,7 @@ namespace morph {
         /*!
          * The list of hexes that make up this HexGrid.
          */
-        std::list<Hex> hexen;
+        morph::hexlist hexen;
 
         /*!
          * Once boundary secured, fill this vector. Experimental - can I do parallel
@@ -2897,12 +3548,12 @@ namespace morph {
             // Vectors of list-iterators to hexes in this->hexen. Used to keep a track of nearest
             // neighbours. I'm using vector, rather than a list as this allows fast random access of
             // elements and I'll not be inserting or erasing in the middle of the arrays.
-            std::vector<std::list<morph::Hex>::iterator> prevRingEven;
-            std::vector<std::list<morph::Hex>::iterator> prevRingOdd;
+            std::vector<morph::hexlist::iterator> prevRingEven;
+            std::vector<morph::hexlist::iterator> prevRingOdd;
 
             // Swap pointers between rings.
-            std::vector<std::list<morph::Hex>::iterator>* prevRing = &prevRingEven;
-            std::vector<std::list<morph::Hex>::iterator>* nextPrevRing = &prevRingOdd;
+            std::vector<morph::hexlist::iterator>* prevRing = &prevRingEven;
+            std::vector<morph::hexlist::iterator>* nextPrevRing = &prevRingOdd;
 
             // Direction iterators used in the loop for creating hexes
             int ri = 0;
@@ -2913,7 +3564,7 @@ namespace morph {
 
             // Put central ring in the prevRing vector:
             {
-                std::list<morph::Hex>::iterator h = this->hexen.end(); --h;
+                morph::hexlist::iterator h = this->hexen.end(); --h;
                 prevRing->push_back (h);
             }
 
@@ -3242,13 +3893,112 @@ namespace morph {
                 ringSideLen++;
 
                 // Swap prevRing and nextPrevRing.
-                std::vector<std::list<morph::Hex>::iterator>* tmp = prevRing;
+                std::vector<morph::hexlist::iterator>* tmp = prevRing;
                 prevRing = nextPrevRing;
                 nextPrevRing = tmp;
             }
             // "Finished creating " << this->hexen.size() << " hexes in " << maxRing << " rings."
         }
 
+        /*!
+         * Structure-of-arrays counterpart to init(). Populates the d_* vectors
+         * directly, in exactly the same hex-spiral order in which init() creates hexes,
+         * but without building the morph::hexlist or setting any neighbour
+         * pointers. Neighbour indices are instead computed from a dense (ri, gi) to
+         * index lookup. For multi-million hex grids this skips the pointer-chasing list
+         * stage and its transient memory cost entirely.
+         */
+        void init_soa()
+        {
+            // Use span_x to determine how many rings out to traverse.
+            float halfX = this->x_span/2.0f;
+            unsigned int maxRing = std::abs(std::ceil(halfX/this->d));
+            const int mr = static_cast<int>(maxRing);
+            // A hexagonal grid of maxRing rings contains 1 + 3*maxRing*(maxRing+1) hexes
+            const unsigned int nhex = 1u + 3u * maxRing * (maxRing + 1u);
+
+            this->d_clear();
+            this->d_ri.reserve (nhex);
+            this->d_gi.reserve (nhex);
+
+            // First, emit (ri, gi) coordinates in spiral order. The six ring walks step
+            // E, SE, SW, W, NW and NE, exactly as in init().
+            constexpr std::array<std::array<int, 2>, 6> walks = {{ {1,0}, {1,-1}, {0,-1}, {-1,0}, {-1,1}, {0,1} }};
+            int ri = 0;
+            int gi = 0;
+            this->d_ri.push_back (ri);
+            this->d_gi.push_back (gi);
+            unsigned int ringSideLen = 1;
+            for (unsigned int ring = 1; ring <= maxRing; ++ring) {
+                // Move up a hex and left a hex onto the start hex of the new ring
+                --ri; ++gi;
+                for (const std::array<int, 2>& w : walks) {
+                    for (unsigned int i = 0; i < ringSideLen; ++i) {
+                        this->d_ri.push_back (ri);
+                        this->d_gi.push_back (gi);
+                        ri += w[0];
+                        gi += w[1];
+                    }
+                }
+                ringSideLen++;
+            }
+
+            // Dense lookup from (ri, gi) to d_ vector index, for neighbour relations
+            const int side = 2 * mr + 1;
+            std::vector<int> lookup (static_cast<std::size_t>(side) * side, -1);
+            for (unsigned int i = 0; i < nhex; ++i) {
+                lookup[(this->d_ri[i] + mr) * side + (this->d_gi[i] + mr)] = static_cast<int>(i);
+            }
+
+            this->d_x.resize (nhex);
+            this->d_y.resize (nhex);
+            this->d_bi.assign (nhex, 0);
+            this->d_flags.assign (nhex, 0x0);
+            this->d_flagwords.clear();
+            this->d_distToBoundary.assign (nhex, -1.0f);
+            this->d_ne.resize (nhex);
+            this->d_nne.resize (nhex);
+            this->d_nnw.resize (nhex);
+            this->d_nw.resize (nhex);
+            this->d_nsw.resize (nhex);
+            this->d_nse.resize (nhex);
+
+            // Now fill positions, neighbour indices and flags. Independent per-hex work.
+#pragma omp parallel for
+            for (int i = 0; i < static_cast<int>(nhex); ++i) {
+                const int r = this->d_ri[i];
+                const int g = this->d_gi[i];
+                // Cartesian location, as Hex::computeLocation() (with bi == 0)
+                this->d_x[i] = this->d * r + (this->d / 2.0f) * g;
+                this->d_y[i] = this->v * g;
+                // A neighbour exists if its (ri, gi) is within the hexagonal region
+                auto nidx = [&lookup, mr, side] (int nr, int ng) {
+                    if (nr < -mr || nr > mr || ng < -mr || ng > mr) { return -1; }
+                    return lookup[(nr + mr) * side + (ng + mr)];
+                };
+                this->d_ne[i] = nidx (r + 1, g);
+                this->d_nne[i] = nidx (r, g + 1);
+                this->d_nnw[i] = nidx (r - 1, g + 1);
+                this->d_nw[i] = nidx (r - 1, g);
+                this->d_nsw[i] = nidx (r, g - 1);
+                this->d_nse[i] = nidx (r + 1, g - 1);
+                unsigned int flgs = 0x0;
+                flgs |= (this->d_ne[i] > -1 ? HEX_HAS_NE : 0x0);
+                flgs |= (this->d_nne[i] > -1 ? HEX_HAS_NNE : 0x0);
+                flgs |= (this->d_nnw[i] > -1 ? HEX_HAS_NNW : 0x0);
+                flgs |= (this->d_nw[i] > -1 ? HEX_HAS_NW : 0x0);
+                flgs |= (this->d_nsw[i] > -1 ? HEX_HAS_NSW : 0x0);
+                flgs |= (this->d_nse[i] > -1 ? HEX_HAS_NSE : 0x0);
+                this->d_flags[i] = flgs;
+            }
+        }
+
+        //! Materialize hexen from the d_ vectors if it is needed, but not yet built
+        void ensure_hexen()
+        {
+            if (this->hexen.empty() && !this->d_x.empty()) { this->materialize_hexen(); }
+        }
+
         /*!
          * Starting from \a startFrom, and following nearest-neighbour relations, find
          * the closest Hex in hexen to the coordinate point \a point, and set its
@@ -3256,10 +4006,10 @@ namespace morph {
          *
          * \return An iterator into HexGrid::hexen which refers to the closest Hex to \a point.
          */
-        std::list<morph::Hex>::iterator setBoundary (const morph::BezCoord<float>& point,
-                                                     std::list<morph::Hex>::iterator startFrom)
+        morph::hexlist::iterator setBoundary (const morph::BezCoord<float>& point,
+                                                     morph::hexlist::iterator startFrom)
         {
-            std::list<morph::Hex>::iterator h = this->findHexNearPoint (point, startFrom);
+            morph::hexlist::iterator h = this->findHexNearPoint (point, startFrom);
             h->setFlag (HEX_IS_BOUNDARY | HEX_INSIDE_BOUNDARY);
             return h;
         }
@@ -3271,13 +4021,13 @@ namespace morph {
         bool boundaryContiguous()
         {
             this->bhexen.clear();
-            std::list<morph::Hex>::const_iterator bhi = this->hexen.begin();
+            morph::hexlist::const_iterator bhi = this->hexen.begin();
             if (this->findBoundaryHex (bhi) == false) {
                 // Found no boundary hex
                 return false;
             }
             std::set<unsigned int> seen;
-            std::list<morph::Hex>::const_iterator hi = bhi;
+            morph::hexlist::const_iterator hi = bhi;
             return this->boundaryContiguous (bhi, hi, seen);
         }
 
@@ -3288,11 +4038,11 @@ namespace morph {
          * The overload with bhexes takes a list of Hex pointers and populates it with
          * pointers to the hexes on the boundary.
          */
-        bool boundaryContiguous (std::list<Hex>::const_iterator bhi,
-                                 std::list<Hex>::const_iterator hi, std::set<unsigned int>& seen)
+        bool boundaryContiguous (morph::hexlist::const_iterator bhi,
+                                 morph::hexlist::const_iterator hi, std::set<unsigned int>& seen)
         {
             bool rtn = false;
-            std::list<morph::Hex>::const_iterator hi_next;
+            morph::hexlist::const_iterator hi_next;
             seen.insert (hi->vi);
             // Insert into the std::list of Hex pointers, too
             this->bhexen.push_back (&(*hi));
@@ -3339,9 +4089,9 @@ namespace morph {
          * region, extract the pointers to all the Hexes in that region and store that
          * information for later use.
          */
-        std::list<Hex>::iterator setRegionBoundary (const BezCoord<float>& point, std::list<Hex>::iterator startFrom)
+        morph::hexlist::iterator setRegionBoundary (const BezCoord<float>& point, morph::hexlist::iterator startFrom)
         {
-            std::list<morph::Hex>::iterator h = this->findHexNearPoint (point, startFrom);
+            morph::hexlist::iterator h = this->findHexNearPoint (point, startFrom);
             h->setFlag (HEX_IS_REGION_BOUNDARY | HEX_INSIDE_REGION);
             return h;
         }
@@ -3350,11 +4100,11 @@ namespace morph {
          * Determine whether the region boundary is contiguous, starting from the
          * boundary Hex iterator #bhi.
          */
-        bool regionBoundaryContiguous (std::list<Hex>::const_iterator bhi,
-                                       std::list<Hex>::const_iterator hi, std::set<unsigned int>& seen)
+        bool regionBoundaryContiguous (morph::hexlist::const_iterator bhi,
+                                       morph::hexlist::const_iterator hi, std::set<unsigned int>& seen)
         {
             bool rtn = false;
-            std::list<morph::Hex>::const_iterator hi_next;
+            morph::hexlist::const_iterator hi_next;
             seen.insert (hi->vi);
             // Insert into the list of Hex pointers, too
             this->bhexen.push_back (&(*hi));
@@ -3397,7 +4147,7 @@ namespace morph {
          * assumes that setBoundary (const BezCurvePath&) has been called to mark the
          * Hexes that lie on the boundary.
          */
-        bool findBoundaryHex (std::list<Hex>::const_iterator& hi) const
+        bool findBoundaryHex (morph::hexlist::const_iterator& hi) const
         {
             if (hi->testFlags(HEX_IS_BOUNDARY) == true) {
                 // No need to change the Hex iterator
@@ -3405,42 +4155,42 @@ namespace morph {
             }
 
             if (hi->has_ne()) {
-                std::list<morph::Hex>::const_iterator ci(hi->ne);
+                morph::hexlist::const_iterator ci(hi->ne);
                 if (this->findBoundaryHex (ci) == true) {
                     hi = ci;
                     return true;
                 }
             }
             if (hi->has_nne()) {
-                std::list<morph::Hex>::const_iterator ci(hi->nne);
+                morph::hexlist::const_iterator ci(hi->nne);
                 if (this->findBoundaryHex (ci) == true) {
                     hi = ci;
                     return true;
                 }
             }
             if (hi->has_nnw()) {
-                std::list<morph::Hex>::const_iterator ci(hi->nnw);
+                morph::hexlist::const_iterator ci(hi->nnw);
                 if (this->findBoundaryHex (ci) == true) {
                     hi = ci;
                     return true;
                 }
             }
             if (hi->has_nw()) {
-                std::list<morph::Hex>::const_iterator ci(hi->nw);
+                morph::hexlist::const_iterator ci(hi->nw);
                 if (this->findBoundaryHex (ci) == true) {
                     hi = ci;
                     return true;
                 }
             }
             if (hi->has_nsw()) {
-                std::list<morph::Hex>::const_iterator ci(hi->nsw);
+                morph::hexlist::const_iterator ci(hi->nsw);
                 if (this->findBoundaryHex (ci) == true) {
                     hi = ci;
                     return true;
                 }
             }
             if (hi->has_nse()) {
-                std::list<morph::Hex>::const_iterator ci(hi->nse);
+                morph::hexlist::const_iterator ci(hi->nse);
                 if (this->findBoundaryHex (ci) == true) {
                     hi = ci;
                     return true;
@@ -3454,11 +4204,11 @@ namespace morph {
          * Find the hex near @point, starting from startFrom, which should be as close
          * as possible to point in order to reduce computation time.
          */
-        std::list<Hex>::iterator findHexNearPoint (const BezCoord<float>& point, std::list<Hex>::iterator startFrom)
+        morph::hexlist::iterator findHexNearPoint (const BezCoord<float>& point, morph::hexlist::iterator startFrom)
         {
             bool neighbourNearer = true;
 
-            std::list<morph::Hex>::iterator h = startFrom;
+            morph::hexlist::iterator h = startFrom;
             float dmin = h->distanceFrom (point);
             float dcur = 0.0f;
 
@@ -3511,7 +4261,7 @@ namespace morph {
          * By changing \a bdryFlag and \a insideFlag, it's possible to use this method
          * with region boundaries.
          */
-        void markFromBoundary (std::list<Hex>::iterator hi,
+        void markFromBoundary (morph::hexlist::iterator hi,
                                unsigned int bdryFlag = HEX_IS_BOUNDARY,
                                unsigned int insideFlag = HEX_INSIDE_BOUNDARY)
         {
@@ -3553,7 +4303,7 @@ namespace morph {
         {
             // Find a marked-inside Hex next to this boundary hex. This will be the first direction to mark
             // a line of inside hexes in.
-            std::list<morph::Hex>::iterator first_inside = this->hexen.begin();
+            morph::hexlist::iterator first_inside = this->hexen.begin();
             unsigned short firsti = 0;
             for (unsigned short i = 0; i < 6; ++i) {
                 if (hi->has_neighbour(i)
@@ -3592,13 +4342,13 @@ namespace morph {
         /*!
          * Common code used by markFromBoundary()
          */
-        void markFromBoundaryCommon (std::list<Hex>::iterator first_inside, unsigned short firsti,
+        void markFromBoundaryCommon (morph::hexlist::iterator first_inside, unsigned short firsti,
                                      unsigned int bdryFlag = HEX_IS_BOUNDARY,
                                      unsigned int insideFlag = HEX_INSIDE_BOUNDARY)
         {
             // From the "first inside the boundary hex" head in the direction specified by firsti until a
             // boundary hex is reached.
-            std::list<morph::Hex>::iterator straight = first_inside;
+            morph::hexlist::iterator straight = first_inside;
 
 #ifdef DO_WARNINGS
             bool warning_given = false;
@@ -3662,8 +4412,8 @@ namespace morph {
          *
          * \return true if a next boundary neighbour was found, false otherwise.
          */
-        bool findNextBoundaryNeighbour (std::list<Hex>::iterator& bhi,
-                                        std::deque<std::list<Hex>::iterator>& recently_seen,
+        bool findNextBoundaryNeighbour (morph::hexlist::iterator& bhi,
+                                        std::deque<morph::hexlist::iterator>& recently_seen,
                                         unsigned int n_recents = 2U,
                                         unsigned int bdryFlag = HEX_IS_BOUNDARY,
                                         unsigned int insideFlag = HEX_INSIDE_BOUNDARY) const
@@ -3677,7 +4427,7 @@ namespace morph {
                 if (bhi->has_neighbour(i) && bhi->get_neighbour(i)->testFlags(bdryFlag)) {
 
                     // cbhi is "candidate boundary hex iterator", now guaranteed to be a boundary hex
-                    std::list<morph::Hex>::iterator cbhi = bhi->get_neighbour(i);
+                    morph::hexlist::iterator cbhi = bhi->get_neighbour(i);
 
                     // Test if the candidate boundary hex is in the 'recently seen' deque
                     bool hex_already_seen = false;
@@ -3724,23 +4474,23 @@ namespace morph {
          * \a hi which is assumed to already be known to refer to a hex lying inside the
          * boundary.
          */
-        void markHexesInside (std::list<Hex>::iterator hi,
+        void markHexesInside (morph::hexlist::iterator hi,
                               unsigned int bdryFlag = HEX_IS_BOUNDARY,
                               unsigned int insideFlag = HEX_INSIDE_BOUNDARY)
         {
             // Run to boundary, marking as we go
-            std::list<morph::Hex>::iterator bhi(hi);
+            morph::hexlist::iterator bhi(hi);
             while (bhi->testFlags (bdryFlag) == false && bhi->has_nne()) {
                 bhi->setFlag (insideFlag);
                 bhi = bhi->nne;
             }
-            std::list<morph::Hex>::iterator bhi_start = bhi;
+            morph::hexlist::iterator bhi_start = bhi;
 
             // Mark from first boundary hex and across the region
             this->markFromBoundary (bhi, bdryFlag, insideFlag);
 
             // a deque to hold the 'n_recents' most recently seen boundary hexes.
-            std::deque<std::list<morph::Hex>::iterator> recently_seen;
+            std::deque<morph::hexlist::iterator> recently_seen;
             unsigned int n_recents = 16U; // 2 should be sufficient for boundaries with double thickness
             // sections. If problems occur, trying increasing this.
             bool gotnext = this->findNextBoundaryNeighbour (bhi, recently_seen, n_recents, bdryFlag, insideFlag);
@@ -3751,6 +4501,57 @@ namespace morph {
             }
         }
 
+        /*!
+         * Parallel alternative to markHexesInside. A breadth-first region fill from \a
+         * hi (assumed to lie inside the boundary), in which each frontier of hexes is
+         * expanded across OpenMP threads. Hexes flagged with \a bdryFlag are marked
+         * with \a insideFlag but not expanded, so the fill halts at the boundary, just
+         * as the serial markHexesInside does. Assumes Hex::vi indices are contiguous
+         * (0 to hexen.size()-1), which holds before any discard and after
+         * renumberVectorIndices().
+         */
+        void markHexesInside_par (morph::hexlist::iterator hi,
+                                  unsigned int bdryFlag = HEX_IS_BOUNDARY,
+                                  unsigned int insideFlag = HEX_INSIDE_BOUNDARY)
+        {
+            // Random access to the hexes by their vector index, for the parallel loop
+            std::vector<morph::hexlist::iterator> hexits (this->hexen.size());
+            for (auto h = this->hexen.begin(); h != this->hexen.end(); ++h) { hexits[h->vi] = h; }
+
+            std::vector<unsigned char> visited (this->hexen.size(), 0);
+            std::vector<unsigned int> frontier;
+            std::vector<unsigned int> next_frontier;
+            frontier.push_back (hi->vi);
+            visited[hi->vi] = 1;
+
+            while (!frontier.empty()) {
+                next_frontier.clear();
+                const int fsz = static_cast<int>(frontier.size());
+#pragma omp parallel
+                {
+                    std::vector<unsigned int> local;
+#pragma omp for nowait
+                    for (int i = 0; i < fsz; ++i) {
+                        morph::hexlist::iterator h = hexits[frontier[i]];
+                        h->setFlag (insideFlag);
+                        // Don't expand past the boundary
+                        if (h->testFlags (bdryFlag) == true) { continue; }
+                        for (unsigned short ni = 0; ni < 6; ++ni) {
+                            if (h->has_neighbour (ni) == false) { continue; }
+                            unsigned int nvi = h->get_neighbour (ni)->vi;
+                            unsigned char was_visited = 0;
+#pragma omp atomic capture
+                            { was_visited = visited[nvi]; visited[nvi] = 1; }
+                            if (was_visited == 0) { local.push_back (nvi); }
+                        }
+                    }
+#pragma omp critical
+                    { next_frontier.insert (next_frontier.end(), local.begin(), local.end()); }
+                }
+                frontier.swap (next_frontier);
+            }
+        }
+
         /*!
          * Recursively mark hexes to be kept if they are inside the rectangular hex
          * domain.
@@ -3843,7 +4644,7 @@ namespace morph {
          */
         void markAllHexesInsideDomain()
         {
-            std::list<morph::Hex>::iterator hi = this->hexen.begin();
+            morph::hexlist::iterator hi = this->hexen.begin();
             while (hi != this->hexen.end()) {
                 hi->setInsideDomain();
                 hi++;
@@ -3856,7 +4657,7 @@ namespace morph {
         void discardOutsideBoundary()
         {
             // Mark those hexes inside the boundary
-            std::list<morph::Hex>::iterator centroidHex = this->findHexNearest (this->boundaryCentroid);
+            morph::hexlist::iterator centroidHex = this->findHexNearest (this->boundaryCentroid);
             this->markHexesInside (centroidHex);
             // Run through and discard those hexes outside the boundary:
             auto hi = this->hexen.begin();
@@ -4017,12 +4818,12 @@ namespace morph {
          * boundary is applied to the original hexagonal grid. When this occurs,
          * gridReduced should be set false.
          */
-        std::list<Hex>::iterator vertexE;
-        std::list<Hex>::iterator vertexNE;
-        std::list<Hex>::iterator vertexNW;
-        std::list<Hex>::iterator vertexW;
-        std::list<Hex>::iterator vertexSW;
-        std::list<Hex>::iterator vertexSE;
+        morph::hexlist::iterator vertexE;
+        morph::hexlist::iterator vertexNE;
+        morph::hexlist::iterator vertexNW;
+        morph::hexlist::iterator vertexW;
+        morph::hexlist::iterator vertexSW;
+        morph::hexlist::iterator vertexSE;
 
         /*!
          * Set true when a new boundary has been applied. This means that
@@ -4030,6 +4831,146 @@ namespace morph {
          */
         bool gridReduced = false;
 
+        //! Content tag identifying a morph::snapshot file written by save_snapshot()
+        static constexpr std::uint32_t hg_snapshot_tag = morph::crc32 ("HexGrid");
+        //! Version of the save_snapshot() section layout (v1 was a bespoke flat
+        //! format; v2 is the shared morph::snapshot format)
+        static constexpr std::uint32_t hg_snapshot_version = 2;
+
+    };
+
+    /*!
+     * \brief A precomputed convolution plan for HexGrid data
+     *
+     * HexGrid::convolve re-walks neighbour pointers from every hex to every kernel hex
+     * on every call, which makes it the hot loop of models that convolve each
+     * timestep. A hexconv_plan resolves those walks ONCE, into a flat table of source
+     * indices over the d_ne/d_nne/... index vectors. apply() is then a dense
+     * multiply-accumulate over the table: cache-friendly (the table is read
+     * sequentially), OpenMP parallel across tiles of hexes, and with no pointer
+     * chasing.
+     *
+     * The plan depends only on the geometry of the two grids, so one plan serves any
+     * number of apply() calls and any data or kernel values. The domain HexGrid must
+     * have its d_ vectors populated (this is the case after setBoundary/
+     * populate_d_vectors or structure-of-arrays construction). Entries for kernel
+     * offsets that walk off the grid edge are -1 and contribute nothing, matching
+     * HexGrid::convolve.
+     */
+    struct hexconv_plan
+    {
+        //! Build the plan for convolving data on \a domain with a kernel defined on \a kernelgrid
+        hexconv_plan (const HexGrid& domain, const HexGrid& kernelgrid)
+        {
+            if (domain.d_ne.empty() || domain.d_x.empty()) {
+                throw std::runtime_error ("hexconv_plan: the domain's d_ vectors are not populated.");
+            }
+            if (kernelgrid.getd() != domain.getd()) {
+                throw std::runtime_error ("hexconv_plan: kernel HexGrid must have same d as the domain HexGrid.");
+            }
+
+            this->n = domain.d_x.size();
+            this->k = kernelgrid.num();
+
+            // Kernel hex coordinates and their indices into kerneldata
+            std::vector<int> kri (this->k);
+            std::vector<int> kgi (this->k);
+            this->kvi.resize (this->k);
+            if (!kernelgrid.hexen.empty()) {
+                unsigned int kk = 0;
+                for (const morph::Hex& kh : kernelgrid.hexen) {
+                    kri[kk] = kh.ri;
+                    kgi[kk] = kh.gi;
+                    this->kvi[kk] = kh.vi;
+                    ++kk;
+                }
+            } else { // structure-of-arrays built kernel grid
+                for (unsigned int kk = 0; kk < this->k; ++kk) {
+                    kri[kk] = kernelgrid.d_ri[kk];
+                    kgi[kk] = kernelgrid.d_gi[kk];
+                    this->kvi[kk] = kk;
+                }
+            }
+
+            // Resolve the walk from each hex to each kernel offset, as
+            // HexGrid::convolve does, but over the flat neighbour index vectors
+            this->src.resize (static_cast<std::size_t>(this->n) * this->k);
+#pragma omp parallel for
+            for (int i = 0; i < static_cast<int>(this->n); ++i) {
+                int* row = this->src.data() + static_cast<std::size_t>(i) * this->k;
+                for (unsigned int kk = 0; kk < this->k; ++kk) {
+                    int di = i;
+                    int rr = kri[kk];
+                    int gg = kgi[kk];
+                    for (;;) {
+                        bool moved = false;
+                        // Try to move in r direction
+                        if (rr > 0) {
+                            if (domain.d_ne[di] > -1) { di = domain.d_ne[di]; --rr; moved = true; }
+                        } else if (rr < 0) {
+                            if (domain.d_nw[di] > -1) { di = domain.d_nw[di]; ++rr; moved = true; }
+                        }
+                        // Try to move in g direction
+                        if (gg > 0) {
+                            if (domain.d_nne[di] > -1) { di = domain.d_nne[di]; --gg; moved = true; }
+                        } else if (gg < 0) {
+                            if (domain.d_nsw[di] > -1) { di = domain.d_nsw[di]; ++gg; moved = true; }
+                        }
+                        if (rr == 0 && gg == 0) { row[kk] = di; break; }
+                        if (!moved) { row[kk] = -1; break; } // walked off the grid
+                    }
+                }
+            }
+        }
+
+        /*!
+         * Convolve \a data with \a kerneldata, writing into \a result. Sizes must
+         * match the plan (kerneldata: kernel grid size; data/result: domain grid
+         * size). Hexes are processed in tiles so that each thread streams through a
+         * bounded stripe of the index table.
+         */
+        template<typename T>
+        void apply (std::span<const T> kerneldata, std::span<const T> data, std::span<T> result) const
+        {
+            if (result.size() != this->n || data.size() != this->n) {
+                throw std::runtime_error ("hexconv_plan::apply: data/result size does not match the domain grid.");
+            }
+            if (kerneldata.size() != this->k) {
+                throw std::runtime_error ("hexconv_plan::apply: kerneldata size does not match the kernel grid.");
+            }
+            if (data.data() == result.data()) {
+                throw std::runtime_error ("hexconv_plan::apply: Pass in separate memory for the result.");
+            }
+
+            // Gather the kernel into plan order once, so the inner loop reads it sequentially
+            std::vector<T> kord (this->k);
+            for (unsigned int kk = 0; kk < this->k; ++kk) { kord[kk] = kerneldata[this->kvi[kk]]; }
+
+            constexpr unsigned int tile = 256;
+            const int ntiles = static_cast<int>((this->n + tile - 1) / tile);
+#pragma omp parallel for
+            for (int t = 0; t < ntiles; ++t) {
+                const unsigned int i0 = static_cast<unsigned int>(t) * tile;
+                const unsigned int i1 = std::min (this->n, i0 + tile);
+                for (unsigned int i = i0; i < i1; ++i) {
+                    const int* row = this->src.data() + static_cast<std::size_t>(i) * this->k;
+                    T sum = T{0};
+                    for (unsigned int kk = 0; kk < this->k; ++kk) {
+                        if (row[kk] > -1) { sum += data[row[kk]] * kord[kk]; }
+                    }
+                    result[i] = sum;
+                }
+            }
+        }
+
+        //! Number of hexes in the domain grid
+        unsigned int n = 0;
+        //! Number of hexes in the kernel grid
+        unsigned int k = 0;
+        //! For each domain hex, k source indices into the data (-1: no contribution)
+        std::vector<int> src;
+        //! Index into kerneldata for each kernel table column
+        std::vector<unsigned int> kvi;
     };
 
 } // namespace morph
@@ -11,6 +11,11 @@
 #include <iostream>
 #include <vector>
 #include <array>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <map>
+#include <mutex>
 
 /*
  * Macros for testing neighbours. The step along for neighbours on the
@@ -57,6 +62,44 @@ namespace morph {
         // Could add HexBars - like the Giant's Causeway in Co. Antrim
     };
 
+    namespace hexgridvisual_detail {
+        /*!
+         * The Triangles-mode index array for the HexGrid at \a hg. The triangulation
+         * depends only on the grid's neighbour relations, which are fixed once
+         * setBoundary has run, so it is computed once per HexGrid here and shared,
+         * read-only, by every HexGridVisual (of any data type) that displays that
+         * grid. The cache holds weak references; an entry goes away with the last
+         * visual that shares it.
+         */
+        inline std::shared_ptr<const std::vector<GLuint>> triangulation (const morph::HexGrid* hg)
+        {
+            static std::map<const morph::HexGrid*, std::weak_ptr<const std::vector<GLuint>>> cache;
+            static std::mutex mtx;
+            std::lock_guard<std::mutex> lock (mtx);
+            auto it = cache.find (hg);
+            if (it != cache.end()) {
+                if (auto tri = it->second.lock()) { return tri; }
+            }
+            auto tri = std::make_shared<std::vector<GLuint>>();
+            const unsigned int nhex = hg->num();
+            tri->reserve (6u * nhex);
+            for (unsigned int hi = 0; hi < nhex; ++hi) {
+                if (hg->d_nne[hi] != -1 && hg->d_ne[hi] != -1) {
+                    tri->push_back (hi);
+                    tri->push_back (static_cast<GLuint>(hg->d_nne[hi]));
+                    tri->push_back (static_cast<GLuint>(hg->d_ne[hi]));
+                }
+                if (hg->d_nw[hi] != -1 && hg->d_nsw[hi] != -1) {
+                    tri->push_back (hi);
+                    tri->push_back (static_cast<GLuint>(hg->d_nw[hi]));
+                    tri->push_back (static_cast<GLuint>(hg->d_nsw[hi]));
+                }
+            }
+            cache[hg] = tri;
+            return tri;
+        }
+    } // namespace hexgridvisual_detail
+
     //! The template argument T is the type of the data which this HexGridVisual
     //! will visualize.
     template <class T, int glver = morph::gl::version_4_1>
@@ -82,6 +125,39 @@ namespace morph {
         //! something, so that it is visible.
         void markHex (unsigned int hi) { this->markedHexes.insert(hi); }
 
+        //! The d_ indices of hexes whose data has changed since the last updateData. See markHexDirty.
+        std::vector<unsigned int> dirtyHexes;
+
+        //! Mark the hex with d_ index \a hi as having changed data. If any hexes have been
+        //! marked dirty when updateData is next called, only their sub-ranges of the
+        //! position/colour buffers are recomputed and re-uploaded (glBufferSubData), rather
+        //! than the whole lot. A win when a small fraction of the field changes per frame.
+        void markHexDirty (unsigned int hi) { this->dirtyHexes.push_back (hi); }
+
+        //! Predict the build's vertex count so that finalize()/reinit() can reserve the
+        //! vertex containers once. Triangles mode generates one vertex per hex;
+        //! HexInterp generates 7 (a centre and six corners).
+        std::size_t predict_vertex_count() const override
+        {
+            std::size_t nhex = this->hg == nullptr ? 0 : this->hg->num();
+            return this->hexVisMode == HexVisMode::Triangles ? nhex : 7u * nhex;
+        }
+
+        //! Assign per-vertex element ids for the picking pass (see VisualBase::pick).
+        //! Each hex's vertices take the hex's d_ index; any vertices beyond the data
+        //! region (boundary or overlay framework) carry no id and pick as element -1.
+        void fillPickIDs() override
+        {
+            std::size_t vph = this->hexVisMode == HexVisMode::Triangles ? 1u : 7u;
+            std::size_t n_data_verts = (this->hg == nullptr ? 0u : this->hg->num()) * vph;
+            std::size_t nverts = this->vertexPositions.size() / 3u;
+            if (n_data_verts == 0u || n_data_verts > nverts) { this->pickIDs.clear(); return; }
+            this->pickIDs.assign (nverts, this->pick_id_none);
+            for (std::size_t v = 0; v < n_data_verts; ++v) {
+                this->pickIDs[v] = static_cast<float>(v / vph);
+            }
+        }
+
         //! The length of the data structure that will be visualized. May be length of
         //! this->scalarData or of this->vectorData.
         unsigned int datasize = 0;
@@ -92,9 +168,10 @@ namespace morph {
             this->datasize = 0;
             if (this->vectorData != nullptr && !this->vectorData->empty()) {
                 this->datasize = this->vectorData->size();
-            } else if (this->scalarData != nullptr && !this->scalarData->empty()) {
-                this->datasize = this->scalarData->size();
-            } // else datasize remains 0
+            } else {
+                // Covers both setScalarData and bindScalarData bindings
+                this->datasize = this->scalarDataSpan().size();
+            } // if neither is bound, datasize remains 0
         }
 
         // Common function for setting up the z and colour scaling
@@ -103,18 +180,19 @@ namespace morph {
             this->dcopy.resize (this->datasize, 0);
             this->dcolour.resize (this->datasize);
 
-            if (this->scalarData != nullptr) {
+            std::span<const T> sdata = this->scalarDataSpan();
+            if (sdata.empty() == false) {
                 // What do these scaling operations do to any NaNs in scalarData? They should remain
                 // NaN. Then in dcopy, might want to make them 0.
-                this->zScale.transform (*(this->scalarData), this->dcopy);
+                this->zScale.transform (sdata.data(), this->dcopy.data(), sdata.size());
                 dcopy.replace_nan_with (this->zScale.transform_one(0.0f));
-                this->colourScale.transform (*(this->scalarData), this->dcolour);
+                this->colourScale.transform (sdata.data(), this->dcolour.data(), sdata.size());
 
             } else if (this->vectorData != nullptr) {
 
                 this->dcolour2.resize (this->datasize);
                 this->dcolour3.resize (this->datasize);
-                std::vector<float> veclens(this->dcopy);
+                morph::vvec<float> veclens(this->dcopy);
                 for (unsigned int i = 0; i < this->datasize; ++i) {
                     veclens[i] = (*this->vectorData)[i].length();
                     this->dcolour[i] = (*this->vectorData)[i][0];
@@ -193,6 +271,56 @@ namespace morph {
         void updateData (const std::vector<T>* _data)
         {
             this->scalarData = _data;
+            this->refresh();
+        }
+
+        /*!
+         * Rewrite just the hex colours from new scalar data, leaving the z positions
+         * and the triangulation untouched - cheaper than updateData when the colours
+         * change but the surface height can stay as it is (or is flat). Only possible
+         * in Triangles mode (one colour vertex per hex) after a full build; otherwise
+         * this falls back to updateData.
+         */
+        void updateColours (const std::vector<T>* _data) override
+        {
+            this->scalarData = _data;
+            std::span<const T> sdata = this->scalarDataSpan();
+            const unsigned int nhex = this->hg->num();
+            if (this->hexVisMode != HexVisMode::Triangles || sdata.size() != nhex
+                || this->vertexColors.size() != 3u * nhex || this->dcolour.size() != nhex) {
+                this->updateData (_data);
+                return;
+            }
+            if (this->colourScale.do_autoscale == true) { this->colourScale.reset(); }
+            this->colourScale.transform (sdata.data(), this->dcolour.data(), sdata.size());
+            std::array<float, 3> blkclr = {0,0,0};
+            for (unsigned int hi = 0; hi < nhex; ++hi) {
+                std::array<float, 3> clr = this->markedHexes.count (hi) ? blkclr : this->setColour (hi);
+                this->vertexColors[hi * 3] = clr[0];
+                this->vertexColors[hi * 3 + 1] = clr[1];
+                this->vertexColors[hi * 3 + 2] = clr[2];
+            }
+            this->reinit_colour_buffer();
+        }
+
+        //! Re-read the currently bound/set scalar data and update the model. Called by
+        //! updateData, and directly by client code which has mutated memory bound with
+        //! bindScalarData().
+        void refresh() override
+        {
+            // If client code marked hexes dirty, take the incremental path, which touches
+            // only those hexes' entries in the GL buffers. That's only possible in
+            // Triangles mode (one vertex per hex) and once a full build has been done (so
+            // that autoscaling has run and the vertex containers are populated).
+            if (!this->dirtyHexes.empty()) {
+                if (this->hexVisMode == HexVisMode::Triangles
+                    && this->dcopy.size() == this->hg->num()
+                    && this->vertexColors.size() == 3u * this->hg->num()) {
+                    this->updateDirtyHexes();
+                    return;
+                }
+                this->dirtyHexes.clear(); // Can't update incrementally; fall through to a full update
+            }
             switch (this->hexVisMode) {
             case HexVisMode::Triangles:
             {
@@ -207,6 +335,49 @@ namespace morph {
             }
         }
 
+        /*!
+         * The incremental update path. For each hex marked with markHexDirty(), recompute
+         * the scaled z position and colour from the current scalarData and poke them into
+         * vertexPositions/vertexColors, then upload just the contiguous runs of dirty hexes
+         * with glBufferSubData (via reinit_buffers_region). Scaling is NOT re-autoscaled
+         * here; a sequence of incremental updates keeps the scaling from the last full
+         * build, so colours remain comparable from frame to frame.
+         */
+        void updateDirtyHexes()
+        {
+            std::array<float, 3> blkclr = {0,0,0};
+            std::span<const T> sdata = this->scalarDataSpan();
+            for (unsigned int hi : this->dirtyHexes) {
+                if (hi >= this->dcopy.size() || hi >= sdata.size()) { continue; }
+                float zval = this->zScale.transform_one (sdata[hi]);
+                if (std::isnan (zval)) { zval = this->zScale.transform_one (T{0}); }
+                this->dcopy[hi] = zval;
+                this->dcolour[hi] = this->colourScale.transform_one (sdata[hi]);
+                if (this->dataCoords == nullptr) {
+                    this->vertexPositions[hi * 3 + 2] = this->zoom * this->dcopy[hi];
+                } else {
+                    this->vertexPositions[hi * 3 + 2] = (*this->dataCoords)[hi][2];
+                }
+                std::array<float, 3> clr = this->markedHexes.count (hi) ? blkclr : this->setColour (hi);
+                this->vertexColors[hi * 3] = clr[0];
+                this->vertexColors[hi * 3 + 1] = clr[1];
+                this->vertexColors[hi * 3 + 2] = clr[2];
+            }
+            // Coalesce the dirty indices into contiguous runs; one glBufferSubData per run
+            std::sort (this->dirtyHexes.begin(), this->dirtyHexes.end());
+            unsigned int run_start = this->dirtyHexes[0];
+            unsigned int run_end = run_start;
+            for (std::size_t i = 1; i < this->dirtyHexes.size(); ++i) {
+                unsigned int hi = this->dirtyHexes[i];
+                if (hi <= run_end + 1) { run_end = std::max (run_end, hi); continue; }
+                this->reinit_buffers_region (run_start, run_end - run_start + 1);
+                run_start = hi;
+                run_end = hi;
+            }
+            this->reinit_buffers_region (run_start, run_end - run_start + 1);
+            this->dirtyHexes.clear();
+        }
+
         // Initialize vertex buffer objects and vertex array object.
 
         /*!
@@ -265,27 +436,14 @@ namespace morph {
                 }
             }
 
-            // Build indices based on neighbour relations in the HexGrid
-            // Only needs to happen *on init*. On update, this will not change :)
+            // Indices are based on neighbour relations in the HexGrid, which never
+            // change after setBoundary, so fetch the triangulation from the
+            // per-HexGrid cache. Only the first HexGridVisual on a grid walks the
+            // neighbour relations; the rest just copy the cached index array. Only
+            // needs to happen *on init*; on update, this will not change :)
             if (update == false) {
-                std::size_t ind_sz = 0;
-                for (unsigned int hi = 0; hi < nhex; ++hi) {
-                    if (HAS_NNE(hi) && HAS_NE(hi)) {
-                        //std::cout << "1st triangle " << hi << "->" << NNE(hi) << "->" << NE(hi) << std::endl;
-                        this->indices.resize (ind_sz + 3);
-                        this->indices[ind_sz++] = hi;
-                        this->indices[ind_sz++] = NNE(hi);
-                        this->indices[ind_sz++] = NE(hi);
-                    }
-
-                    if (HAS_NW(hi) && HAS_NSW(hi)) {
-                        //std::cout << "2nd triangle " << hi << "->" << NW(hi) << "->" << NSW(hi) << std::endl;
-                        this->indices.resize (ind_sz + 3);
-                        this->indices[ind_sz++] = hi;
-                        this->indices[ind_sz++] = NW(hi);
-                        this->indices[ind_sz++] = NSW(hi);
-                    }
-                }
+                this->shared_tri = hexgridvisual_detail::triangulation (this->hg);
+                this->indices = *this->shared_tri;
                 this->idx = nhex;
             }
         }
@@ -1151,6 +1309,10 @@ namespace morph {
         //! assume the HexGrid has remained unaltered)
         const HexGrid* hg;
 
+        //! The cached triangulation for this->hg, shared with any other HexGridVisuals
+        //! on the same grid. Held here so the cache entry lives as long as this visual.
+        std::shared_ptr<const std::vector<GLuint>> shared_tri;
+
         //! A copy of the scalarData which can be transformed suitably to be the z value of the surface
         morph::vvec<float> dcopy;
         //! A copy of the scalarData, scaled to be a colour value
@@ -0,0 +1,324 @@
+/*!
+ * \file
+ *
+ * A GraphVisual whose polygonal data markers are drawn with instanced rendering.
+ * GraphVisual tessellates every marker into the vertex buffers (20 triangles per
+ * circle marker), which caps scatter-style graphs at about 100k points.
+ * InstancedGraphVisual instead tessellates ONE unit polygon per markerstyle in use
+ * and draws it once per datum with glDrawElementsInstanced, supplying centre, size
+ * and colour as per-instance attributes. Appending a datum appends 7 floats to an
+ * instance buffer (uploaded tail-only), so morph::GraphVisual::append stays O(1).
+ * Axes, lines, bars, quivers and text render exactly as in GraphVisual.
+ *
+ * Note: this class makes direct (global alias) OpenGL calls, like the morph::gl
+ * compute subsystem, so use it with morph::VisualNoMX (not the multicontext
+ * morph::Visual). Instancing needs OpenGL 3.3 or newer.
+ *
+ * \author Seb James
+ * \date August 2026
+ */
+#pragma once
+
+#include <morph/gl/version.h>
+#include <morph/gl/shaders.h>
+#include <morph/gl/loadshaders_nomx.h>
+#include <morph/GraphVisual.h>
+#include <morph/VisualDefaultShaders.h>
+#include <morph/mathconst.h>
+#include <morph/vec.h>
+#include <morph/vvec.h>
+#include <cmath>
+#include <map>
+#include <utility>
+#include <vector>
+#include <string>
+
+namespace morph {
+
+    //! A GraphVisual with instanced polygonal markers. Flt is the type of the data.
+    template <typename Flt, int glver = morph::gl::version_4_1>
+    class InstancedGraphVisual : public GraphVisual<Flt, glver>
+    {
+    public:
+        InstancedGraphVisual (const vec<float> _offset)
+            : GraphVisual<Flt, glver> (_offset)
+        {
+            this->markers_on_gpu = true;
+        }
+
+        ~InstancedGraphVisual()
+        {
+            for (auto& [key, g] : this->marker_groups) {
+                if (g.inst_vbo != 0) { glDeleteBuffers (1, &g.inst_vbo); }
+                if (g.ibo != 0) { glDeleteBuffers (1, &g.ibo); }
+                if (g.vbo_norm != 0) { glDeleteBuffers (1, &g.vbo_norm); }
+                if (g.vbo_pos != 0) { glDeleteBuffers (1, &g.vbo_pos); }
+                if (g.vao != 0) { glDeleteVertexArrays (1, &g.vao); }
+            }
+            if (this->marker_prog != 0) { glDeleteProgram (this->marker_prog); }
+        }
+
+        //! A full rebuild re-records every marker instance, so empty the groups first
+        void initializeVertices()
+        {
+            for (auto& [key, g] : this->marker_groups) {
+                g.inst_data.clear();
+                g.n_instances = 0;
+                g.uploaded_instances = 0;
+            }
+            GraphVisual<Flt, glver>::initializeVertices();
+        }
+
+        //! Render the graph as usual (GraphVisual::render also tessellates/records any
+        //! appended data), then draw the marker instances with the instanced shader
+        //! program. GL objects are created lazily here, as render() is the call that
+        //! is guaranteed a current OpenGL context.
+        void render()
+        {
+            GraphVisual<Flt, glver>::render();
+
+            if (this->hide == true) { return; }
+            if (this->marker_prog == 0) { this->init_gl_objects(); }
+
+            bool have_instances = false;
+            for (auto& [key, g] : this->marker_groups) {
+                if (g.vao == 0) { this->init_group_gl (g); }
+                if (g.uploaded_instances != g.n_instances) { this->upload_group (g); }
+                have_instances = have_instances || g.n_instances > 0;
+            }
+            if (have_instances == false) { return; }
+
+            GLint prev_shader = 0;
+            glGetIntegerv (GL_CURRENT_PROGRAM, &prev_shader);
+
+            // The projection matrix and the lighting uniforms are owned by the parent
+            // Visual, which sets them on the scene's graphics program; copy them over.
+            GLuint gprog = this->get_gprog (this->parentVis);
+            glUseProgram (this->marker_prog);
+            this->copy_uniform_mat4 (gprog, "p_matrix");
+            this->copy_uniform_3f (gprog, "light_colour");
+            this->copy_uniform_1f (gprog, "ambient_intensity");
+            this->copy_uniform_3f (gprog, "diffuse_position");
+            this->copy_uniform_1f (gprog, "diffuse_intensity");
+
+            GLint loc_v = glGetUniformLocation (this->marker_prog, static_cast<const GLchar*>("v_matrix"));
+            if (loc_v != -1) { glUniformMatrix4fv (loc_v, 1, GL_FALSE, this->scenematrix.mat.data()); }
+            GLint loc_m = glGetUniformLocation (this->marker_prog, static_cast<const GLchar*>("m_matrix"));
+            if (loc_m != -1) { glUniformMatrix4fv (loc_m, 1, GL_FALSE, (this->model_scaling * this->viewmatrix).mat.data()); }
+            GLint loc_a = glGetUniformLocation (this->marker_prog, static_cast<const GLchar*>("alpha"));
+            if (loc_a != -1) { glUniform1f (loc_a, this->alpha); }
+
+            for (auto& [key, g] : this->marker_groups) {
+                if (g.n_instances == 0) { continue; }
+                glBindVertexArray (g.vao);
+                glDrawElementsInstanced (GL_TRIANGLES, static_cast<GLsizei>(g.n_mesh_indices),
+                                         GL_UNSIGNED_INT, 0, static_cast<GLsizei>(g.n_instances));
+            }
+            glBindVertexArray (0);
+
+            glUseProgram (prev_shader);
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+        }
+
+    protected:
+        //! Floats per instance: centre (3), size (1), colour (3)
+        static constexpr std::size_t inst_stride = 7;
+        //! Attribute locations for the instance data (0-3 are the standard mesh locations)
+        static constexpr unsigned int inst_posn_size_loc = 4;
+        static constexpr unsigned int inst_colour_loc = 5;
+
+        //! The unit mesh and instance buffer for one polygonal markerstyle
+        struct stylegroup
+        {
+            //! Polygon vertex count and first-vertex rotation (see GraphVisual's
+            //! polygonMarker/polygonFlattop)
+            int n = 20;
+            float rotation = 0.0f;
+            //! The unit polygon mesh
+            GLuint vao = 0;
+            GLuint vbo_pos = 0;
+            GLuint vbo_norm = 0;
+            GLuint ibo = 0;
+            unsigned int n_mesh_indices = 0;
+            //! The per-instance data: inst_stride floats per marker
+            GLuint inst_vbo = 0;
+            morph::vvec<float> inst_data;
+            unsigned int n_instances = 0;
+            //! How many instances are already in inst_vbo, so that appends upload
+            //! only the new tail
+            unsigned int uploaded_instances = 0;
+            //! Allocated capacity of inst_vbo, in floats
+            std::size_t inst_capacity = 0;
+        };
+
+        //! Map a markerstyle to a (polygon vertex count, flat-top?) mesh key
+        static std::pair<int, int> stylekey (const morph::markerstyle ms)
+        {
+            switch (ms) {
+            case morph::markerstyle::triangle:
+            case morph::markerstyle::uptriangle: return { 3, 0 };
+            case morph::markerstyle::downtriangle: return { 3, 1 };
+            case morph::markerstyle::square: return { 4, 1 };
+            case morph::markerstyle::diamond: return { 4, 0 };
+            case morph::markerstyle::pentagon: return { 5, 1 };
+            case morph::markerstyle::uppentagon: return { 5, 0 };
+            case morph::markerstyle::hexagon: return { 6, 1 };
+            case morph::markerstyle::uphexagon: return { 6, 0 };
+            case morph::markerstyle::heptagon: return { 7, 1 };
+            case morph::markerstyle::upheptagon: return { 7, 0 };
+            case morph::markerstyle::octagon: return { 8, 1 };
+            case morph::markerstyle::upoctagon: return { 8, 0 };
+            case morph::markerstyle::circle:
+            default: return { 20, 0 };
+            }
+        }
+
+        //! Record one marker instance: an O(1) append of inst_stride floats
+        void appendMarkerInstance (unsigned int dsi, const morph::vec<float>& p)
+        {
+            const morph::DatasetStyle& style = this->datastyles[dsi];
+            const std::pair<int, int> key = this->stylekey (style.markerstyle);
+            stylegroup& g = this->marker_groups[key];
+            if (g.n_instances == 0 && g.inst_data.empty()) {
+                g.n = key.first;
+                g.rotation = key.second == 1 ? morph::mathconst<float>::pi / static_cast<float>(key.first) : 0.0f;
+            }
+            g.inst_data.push_back (p[0]);
+            g.inst_data.push_back (p[1]);
+            g.inst_data.push_back (p[2] + this->thickness);
+            g.inst_data.push_back (style.markersize * 0.5f);
+            g.inst_data.push_back (style.markercolour[0]);
+            g.inst_data.push_back (style.markercolour[1]);
+            g.inst_data.push_back (style.markercolour[2]);
+            g.n_instances++;
+        }
+
+        //! Create the instanced marker shader program (shared by all the groups).
+        //! Requires a current OpenGL context.
+        void init_gl_objects()
+        {
+            // The instanced sphere vertex shader scales a unit mesh by the instance's
+            // fourth attribute component and translates it to the instance centre,
+            // which is exactly what a flat unit polygon needs too.
+            std::vector<morph::gl::ShaderInfo> shaders = {
+                {GL_VERTEX_SHADER, "InstancedGraphVisual.vert.glsl", morph::getInstancedSphereVtxShader (glver), 0 },
+                {GL_FRAGMENT_SHADER, "InstancedGraphVisual.frag.glsl", morph::getDefaultFragShader (glver), 0 }
+            };
+            this->marker_prog = morph::gl::LoadShaders (shaders);
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+        }
+
+        //! Tessellate the unit polygon for one group (matching computeFlatPoly's
+        //! vertex layout: centre plus a triangle fan) and wire up its vertex array,
+        //! with the instance buffer at attribute divisor 1
+        void init_group_gl (stylegroup& g)
+        {
+            std::vector<float> mesh_pos = { 0.0f, 0.0f, 0.0f };
+            std::vector<float> mesh_norm = { 0.0f, 0.0f, 1.0f };
+            std::vector<unsigned int> mesh_idx;
+            for (int j = 0; j < g.n; ++j) {
+                const float t = g.rotation + morph::mathconst<float>::two_pi * static_cast<float>(j) / static_cast<float>(g.n);
+                mesh_pos.push_back (std::sin (t));
+                mesh_pos.push_back (std::cos (t));
+                mesh_pos.push_back (0.0f);
+                mesh_norm.push_back (0.0f);
+                mesh_norm.push_back (0.0f);
+                mesh_norm.push_back (1.0f);
+                mesh_idx.push_back (0u);
+                mesh_idx.push_back (1u + static_cast<unsigned int>(j));
+                mesh_idx.push_back (1u + static_cast<unsigned int>((j + 1) % g.n));
+            }
+            g.n_mesh_indices = static_cast<unsigned int>(mesh_idx.size());
+
+            glGenVertexArrays (1, &g.vao);
+            glBindVertexArray (g.vao);
+
+            glGenBuffers (1, &g.vbo_pos);
+            glBindBuffer (GL_ARRAY_BUFFER, g.vbo_pos);
+            glBufferData (GL_ARRAY_BUFFER, mesh_pos.size() * sizeof(float), mesh_pos.data(), GL_STATIC_DRAW);
+            glVertexAttribPointer (0, 3, GL_FLOAT, GL_FALSE, 0, (void*)(0));
+            glEnableVertexAttribArray (0);
+
+            glGenBuffers (1, &g.vbo_norm);
+            glBindBuffer (GL_ARRAY_BUFFER, g.vbo_norm);
+            glBufferData (GL_ARRAY_BUFFER, mesh_norm.size() * sizeof(float), mesh_norm.data(), GL_STATIC_DRAW);
+            glVertexAttribPointer (1, 3, GL_FLOAT, GL_FALSE, 0, (void*)(0));
+            glEnableVertexAttribArray (1);
+
+            glGenBuffers (1, &g.ibo);
+            glBindBuffer (GL_ELEMENT_ARRAY_BUFFER, g.ibo);
+            glBufferData (GL_ELEMENT_ARRAY_BUFFER, mesh_idx.size() * sizeof(unsigned int), mesh_idx.data(), GL_STATIC_DRAW);
+
+            glGenBuffers (1, &g.inst_vbo);
+            glBindBuffer (GL_ARRAY_BUFFER, g.inst_vbo);
+            constexpr GLsizei stride_bytes = static_cast<GLsizei>(inst_stride * sizeof(float));
+            glVertexAttribPointer (inst_posn_size_loc, 4, GL_FLOAT, GL_FALSE, stride_bytes, (void*)(0));
+            glEnableVertexAttribArray (inst_posn_size_loc);
+            glVertexAttribDivisor (inst_posn_size_loc, 1);
+            glVertexAttribPointer (inst_colour_loc, 3, GL_FLOAT, GL_FALSE, stride_bytes,
+                                   reinterpret_cast<const void*>(4u * sizeof(float)));
+            glEnableVertexAttribArray (inst_colour_loc);
+            glVertexAttribDivisor (inst_colour_loc, 1);
+
+            glBindVertexArray (0);
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+        }
+
+        //! Upload the instances which aren't yet in the GL buffer. After appends this
+        //! is just the new tail; a re-allocation (with headroom) or a rebuild means a
+        //! full re-upload.
+        void upload_group (stylegroup& g)
+        {
+            glBindBuffer (GL_ARRAY_BUFFER, g.inst_vbo);
+            const std::size_t needed = inst_stride * static_cast<std::size_t>(g.n_instances);
+            if (needed > g.inst_capacity) {
+                g.inst_capacity = needed + needed / 2u + inst_stride;
+                glBufferData (GL_ARRAY_BUFFER, g.inst_capacity * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+                g.uploaded_instances = 0;
+            }
+            const std::size_t offset = inst_stride * static_cast<std::size_t>(g.uploaded_instances);
+            glBufferSubData (GL_ARRAY_BUFFER, offset * sizeof(float),
+                             (needed - offset) * sizeof(float), g.inst_data.data() + offset);
+            g.uploaded_instances = g.n_instances;
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+        }
+
+        //! Read a mat4 uniform's value from program \a src_prog and set it on
+        //! marker_prog (which must be in use)
+        void copy_uniform_mat4 (GLuint src_prog, const char* name)
+        {
+            GLint sloc = glGetUniformLocation (src_prog, static_cast<const GLchar*>(name));
+            GLint dloc = glGetUniformLocation (this->marker_prog, static_cast<const GLchar*>(name));
+            if (sloc == -1 || dloc == -1) { return; }
+            std::array<float, 16> val;
+            glGetUniformfv (src_prog, sloc, val.data());
+            glUniformMatrix4fv (dloc, 1, GL_FALSE, val.data());
+        }
+        //! Copy a vec3 uniform from \a src_prog to marker_prog
+        void copy_uniform_3f (GLuint src_prog, const char* name)
+        {
+            GLint sloc = glGetUniformLocation (src_prog, static_cast<const GLchar*>(name));
+            GLint dloc = glGetUniformLocation (this->marker_prog, static_cast<const GLchar*>(name));
+            if (sloc == -1 || dloc == -1) { return; }
+            std::array<float, 3> val;
+            glGetUniformfv (src_prog, sloc, val.data());
+            glUniform3f (dloc, val[0], val[1], val[2]);
+        }
+        //! Copy a float uniform from \a src_prog to marker_prog
+        void copy_uniform_1f (GLuint src_prog, const char* name)
+        {
+            GLint sloc = glGetUniformLocation (src_prog, static_cast<const GLchar*>(name));
+            GLint dloc = glGetUniformLocation (this->marker_prog, static_cast<const GLchar*>(name));
+            if (sloc == -1 || dloc == -1) { return; }
+            float val = 0.0f;
+            glGetUniformfv (src_prog, sloc, &val);
+            glUniform1f (dloc, val);
+        }
+
+        //! One stylegroup per (polygon vertex count, flat-top?) pair in use
+        std::map<std::pair<int, int>, stylegroup> marker_groups;
+        //! Our shader program, which places, scales and colours each marker instance
+        GLuint marker_prog = 0;
+    };
+
+} // namespace morph
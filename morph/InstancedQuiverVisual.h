@@ -0,0 +1,373 @@
+/*!
+ * \file
+ *
+ * An instanced-rendering quiver plot. Where QuiverVisual tessellates a tube+cone arrow
+ * per vector (so updating a 512x512 field re-tessellates a quarter of a million
+ * arrows), InstancedQuiverVisual tessellates ONE unit arrow along +z and draws it once
+ * per vector with glDrawElementsInstanced, supplying start position, thickness, the
+ * (screen-scaled) vector and colour as per-instance attributes. The vertex shader
+ * rotates and scales the arrow into place, so updateQuivers() only rewrites the
+ * 10-floats-per-arrow instance buffer.
+ *
+ * With respect to QuiverVisual, the instanced path does not draw zero-vector markers
+ * or coordinate spheres (zero vectors simply draw nothing), and arrowhead proportion
+ * is fixed at mesh build time.
+ *
+ * Note: this class makes direct (global alias) OpenGL calls, like the morph::gl
+ * compute subsystem, so use it with morph::VisualNoMX (not the multicontext
+ * morph::Visual). Instancing needs OpenGL 3.3 or newer.
+ *
+ * \author Seb James
+ * \date August 2026
+ */
+#pragma once
+
+#include <morph/gl/version.h>
+#include <morph/gl/shaders.h>
+#include <morph/gl/loadshaders_nomx.h>
+#include <morph/VisualDataModel.h>
+#include <morph/VisualDefaultShaders.h>
+#include <morph/scale.h>
+#include <morph/vec.h>
+#include <morph/vvec.h>
+#include <morph/graphstyles.h>
+#include <iostream>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+namespace morph {
+
+    //! An instanced quiver plot. Flt is the type of the vector field elements.
+    template <typename Flt, int glver = morph::gl::version_4_1>
+    class InstancedQuiverVisual : public VisualDataModel<Flt, glver>
+    {
+    public:
+        InstancedQuiverVisual (std::vector<vec<float>>* _coords,
+                               const vec<float> _offset,
+                               const std::vector<vec<Flt,3>>* _quivers,
+                               ColourMapType _cmt,
+                               const float _hue = 0.0f)
+        {
+            this->mv_offset = _offset;
+            this->viewmatrix.translate (this->mv_offset);
+
+            this->dataCoords = _coords;
+            this->vectorData = _quivers;
+
+            this->cm.setHue (_hue);
+            this->cm.setType (_cmt);
+
+            this->length_scale.do_autoscale = true;
+        }
+
+        ~InstancedQuiverVisual()
+        {
+            if (this->inst_vbo != 0) { glDeleteBuffers (1, &this->inst_vbo); }
+            if (this->arrow_prog != 0) { glDeleteProgram (this->arrow_prog); }
+        }
+
+        // Call before initializeVertices() to scale quiver lengths logarithmically
+        void setlog() { this->length_scale.setlog(); }
+
+        //! Tessellate the unit arrow mesh (once) and build the per-instance data
+        void initializeVertices()
+        {
+            // The mesh: a unit arrow from the origin along +z; shaft radius 1, head
+            // radius 2, head length quiver_arrowhead_prop. Instances scale x/y by
+            // their thickness and z by their length.
+            if (this->idx == 0) {
+                std::array<float, 3> meshclr = { 1.0f, 1.0f, 1.0f };
+                morph::vec<float> orig = { 0.0f, 0.0f, 0.0f };
+                morph::vec<float> cone_start = { 0.0f, 0.0f, 1.0f - this->quiver_arrowhead_prop };
+                morph::vec<float> tip = { 0.0f, 0.0f, 1.0f };
+                this->computeTube (orig, cone_start, meshclr, meshclr, 1.0f, this->shapesides);
+                this->computeCone (cone_start, tip, 0.0f, meshclr, 2.0f, this->shapesides);
+            }
+            this->build_instances();
+        }
+
+        /*!
+         * The fast update path: point vectorData at \a _quivers and rebuild only the
+         * per-instance buffer (uploaded at the next render). The arrow mesh and the
+         * GL programs are untouched.
+         */
+        void updateQuivers (const std::vector<vec<Flt,3>>* _quivers)
+        {
+            this->vectorData = _quivers;
+            this->build_instances();
+        }
+
+        //! Render with the instanced quiver shader program. GL objects are created
+        //! lazily here, as render() is the call that is guaranteed a current OpenGL
+        //! context.
+        void render()
+        {
+            if (this->hide == true) { return; }
+
+            if (this->postVertexInitRequired == true) { this->postVertexInit(); }
+            if (this->arrow_prog == 0) { this->init_gl_objects(); }
+            if (this->inst_pending == true) { this->upload_instances(); }
+
+            if (this->n_instances == 0 || this->indices.empty()) { return; }
+
+            GLint prev_shader = 0;
+            glGetIntegerv (GL_CURRENT_PROGRAM, &prev_shader);
+
+            // The projection matrix and the lighting uniforms are owned by the parent
+            // Visual, which sets them on the scene's graphics program; copy them over.
+            GLuint gprog = this->get_gprog (this->parentVis);
+            glUseProgram (this->arrow_prog);
+            this->copy_uniform_mat4 (gprog, "p_matrix");
+            this->copy_uniform_3f (gprog, "light_colour");
+            this->copy_uniform_1f (gprog, "ambient_intensity");
+            this->copy_uniform_3f (gprog, "diffuse_position");
+            this->copy_uniform_1f (gprog, "diffuse_intensity");
+
+            GLint loc_v = glGetUniformLocation (this->arrow_prog, static_cast<const GLchar*>("v_matrix"));
+            if (loc_v != -1) { glUniformMatrix4fv (loc_v, 1, GL_FALSE, this->scenematrix.mat.data()); }
+            GLint loc_m = glGetUniformLocation (this->arrow_prog, static_cast<const GLchar*>("m_matrix"));
+            if (loc_m != -1) { glUniformMatrix4fv (loc_m, 1, GL_FALSE, (this->model_scaling * this->viewmatrix).mat.data()); }
+            GLint loc_a = glGetUniformLocation (this->arrow_prog, static_cast<const GLchar*>("alpha"));
+            if (loc_a != -1) { glUniform1f (loc_a, this->alpha); }
+
+            glBindVertexArray (this->vao);
+            glDrawElementsInstanced (GL_TRIANGLES, static_cast<GLsizei>(this->indices.size()),
+                                     GL_UNSIGNED_INT, 0, static_cast<GLsizei>(this->n_instances));
+            glBindVertexArray (0);
+
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+
+            // Now render any VisualTextModels
+            auto ti = this->texts.begin();
+            while (ti != this->texts.end()) { (*ti)->render(); ti++; }
+
+            glUseProgram (prev_shader);
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+        }
+
+        //! An enumerated type to say whether we draw quivers with coord at mid point; start point or end point
+        QuiverGoes qgoes = QuiverGoes::FromCoord;
+
+        // How many sides to the arrow shaft/head? Set before calling finalize().
+        int shapesides = 12;
+
+        // Setting a fixed length can be useful to focus on the flow of the field.
+        Flt fixed_length = 0.0f;
+
+        // Allows user to linearly scale the size of the quivers that are plotted.
+        float quiver_length_gain = 1.0f;
+
+        // If 0, then quiver thickness is scaled by quiver length. Otherwise, the quiver arrowshaft
+        // tubes have radius = fixed_quiver_thickness * quiver_thickness_gain. Try small values like 0.01f.
+        float fixed_quiver_thickness = 0.0f;
+
+        // Allows user to scale the thickness of the quivers.
+        float quiver_thickness_gain = 0.05f;
+
+        // What proportion of the arrow length should the arrowhead length be? Baked
+        // into the mesh, so set before calling finalize().
+        float quiver_arrowhead_prop = 0.25f;
+
+        // The input vectors are scaled in length to the range [0, 1], which is then modified by the
+        // user using quiver_length_gain. This scaling can be made logarithmic by calling
+        // InstancedQuiverVisual::setlog() before calling finalize().
+        morph::scale<Flt, float> length_scale;
+        // Set this false to avoid applying length_scale to quiver lengths and also and
+        // colourScale (in the absence of ScalarData).
+        bool do_quiver_length_scaling = true;
+
+    protected:
+        //! Floats per instance: start (3), thickness (1), vector (3), colour (3)
+        static constexpr std::size_t inst_stride = 10;
+        //! Attribute locations for the instance data (0-3 are the standard mesh locations)
+        static constexpr unsigned int inst_start_thick_loc = 4;
+        static constexpr unsigned int inst_vec_loc = 5;
+        static constexpr unsigned int inst_colour_loc = 6;
+
+        //! Scale lengths and colours as QuiverVisual::initializeVertices does, then
+        //! fill the per-instance buffer (one instance per vector).
+        void build_instances()
+        {
+            unsigned int ncoords = this->dataCoords == nullptr ? 0 : this->dataCoords->size();
+            unsigned int nquiv = this->vectorData == nullptr ? 0 : this->vectorData->size();
+
+            if (ncoords != nquiv) {
+                std::cout << "InstancedQuiverVisual: ncoords != nquiv, return." << std::endl;
+                return;
+            }
+
+            vvec<Flt> dlengths;
+            for (unsigned int i = 0; i < nquiv; ++i) {
+                dlengths.push_back ( (*this->vectorData)[i].length() );
+            }
+
+            vvec<Flt> lengthcolours(dlengths);
+            if (!this->colourScale.ready()) { this->colourScale.do_autoscale = true; }
+            if (this->scalarData == nullptr || this->scalarData->size() == 0) {
+                if (this->do_quiver_length_scaling == false) {
+                    lengthcolours.set_from (Flt{0.5});
+                } else  {
+                    this->colourScale.transform (dlengths, lengthcolours);
+                }
+            } else {
+                vvec<Flt> sdata (this->scalarData->size());
+                std::copy (this->scalarData->begin(), this->scalarData->end(), sdata.begin());
+                this->colourScale.transform (sdata, lengthcolours);
+            }
+
+            // (if log) First replace zeros with NaNs so that log transform will work.
+            if (this->do_quiver_length_scaling == true && this->length_scale.getType() == morph::scaling_function::Logarithmic) {
+                dlengths.search_replace (Flt{0}, std::numeric_limits<Flt>::quiet_NaN());
+            }
+
+            vvec<float> nrmlzedlengths (dlengths.size());
+            std::copy (dlengths.begin(), dlengths.end(), nrmlzedlengths.begin());
+            if (this->fixed_length != 0.0f) {
+                nrmlzedlengths.set_from (this->fixed_length);
+            } else if (this->do_quiver_length_scaling == true) {
+                this->length_scale.transform (dlengths, nrmlzedlengths);
+            } // else lengths are left as in the data
+
+            vvec<float> lfactor = nrmlzedlengths/dlengths * this->quiver_length_gain;
+
+            this->inst_data.resize (inst_stride * static_cast<std::size_t>(ncoords));
+            vec<float> coords_i, vectorData_i, start;
+            std::array<float, 3> clr;
+            for (unsigned int i = 0; i < ncoords; ++i) {
+
+                coords_i = (*this->dataCoords)[i];
+                float len = nrmlzedlengths[i] * this->quiver_length_gain;
+
+                float* inst = this->inst_data.data() + inst_stride * i;
+                if (std::isnan(dlengths[i]) || dlengths[i] == Flt{0}) {
+                    // A zero vector: write a degenerate (invisible) instance
+                    std::fill (inst, inst + inst_stride, 0.0f);
+                    continue;
+                }
+
+                for (unsigned int j = 0; j < 3; ++j) {
+                    vectorData_i[j] = static_cast<float>((*this->vectorData)[i][j]) * lfactor[i];
+                }
+
+                if (this->qgoes == QuiverGoes::FromCoord) {
+                    start = coords_i;
+                } else if (this->qgoes == QuiverGoes::ToCoord) {
+                    start = coords_i - vectorData_i;
+                } else /* if (this->qgoes == QuiverGoes::OnCoord) */ {
+                    start = coords_i - vectorData_i * 0.5f;
+                }
+
+                float quiv_thick = this->fixed_quiver_thickness ? this->fixed_quiver_thickness : len*quiver_thickness_gain;
+                clr = this->cm.convert (lengthcolours[i]);
+
+                inst[0] = start[0];
+                inst[1] = start[1];
+                inst[2] = start[2];
+                inst[3] = quiv_thick;
+                inst[4] = vectorData_i[0];
+                inst[5] = vectorData_i[1];
+                inst[6] = vectorData_i[2];
+                inst[7] = clr[0];
+                inst[8] = clr[1];
+                inst[9] = clr[2];
+            }
+            this->n_instances = ncoords;
+            this->inst_pending = true;
+        }
+
+        //! Create the instanced quiver shader program and the instance attribute
+        //! buffer, wiring the latter into the vertex array object with an attribute
+        //! divisor of 1. Requires a current OpenGL context.
+        void init_gl_objects()
+        {
+            std::vector<morph::gl::ShaderInfo> shaders = {
+                {GL_VERTEX_SHADER, "InstancedQuiverVisual.vert.glsl", morph::getInstancedQuiverVtxShader (glver), 0 },
+                {GL_FRAGMENT_SHADER, "InstancedQuiverVisual.frag.glsl", morph::getDefaultFragShader (glver), 0 }
+            };
+            this->arrow_prog = morph::gl::LoadShaders (shaders);
+
+            glGenBuffers (1, &this->inst_vbo);
+            glBindVertexArray (this->vao);
+            glBindBuffer (GL_ARRAY_BUFFER, this->inst_vbo);
+            constexpr GLsizei stride_bytes = static_cast<GLsizei>(inst_stride * sizeof(float));
+            glVertexAttribPointer (inst_start_thick_loc, 4, GL_FLOAT, GL_FALSE, stride_bytes, (void*)(0));
+            glEnableVertexAttribArray (inst_start_thick_loc);
+            glVertexAttribDivisor (inst_start_thick_loc, 1);
+            glVertexAttribPointer (inst_vec_loc, 3, GL_FLOAT, GL_FALSE, stride_bytes,
+                                   reinterpret_cast<const void*>(4u * sizeof(float)));
+            glEnableVertexAttribArray (inst_vec_loc);
+            glVertexAttribDivisor (inst_vec_loc, 1);
+            glVertexAttribPointer (inst_colour_loc, 3, GL_FLOAT, GL_FALSE, stride_bytes,
+                                   reinterpret_cast<const void*>(7u * sizeof(float)));
+            glEnableVertexAttribArray (inst_colour_loc);
+            glVertexAttribDivisor (inst_colour_loc, 1);
+            glBindVertexArray (0);
+
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+        }
+
+        //! Upload the per-instance data, re-allocating (with headroom) only when the
+        //! instance count outgrows the buffer
+        void upload_instances()
+        {
+            glBindBuffer (GL_ARRAY_BUFFER, this->inst_vbo);
+            std::size_t needed = inst_stride * static_cast<std::size_t>(this->n_instances);
+            if (needed > this->inst_capacity) {
+                this->inst_capacity = needed + needed / 2u + inst_stride;
+                glBufferData (GL_ARRAY_BUFFER, this->inst_capacity * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+            }
+            glBufferSubData (GL_ARRAY_BUFFER, 0, needed * sizeof(float), this->inst_data.data());
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+            this->inst_pending = false;
+        }
+
+        //! Read a mat4 uniform's value from program \a src_prog and set it on
+        //! arrow_prog (which must be in use)
+        void copy_uniform_mat4 (GLuint src_prog, const char* name)
+        {
+            GLint sloc = glGetUniformLocation (src_prog, static_cast<const GLchar*>(name));
+            GLint dloc = glGetUniformLocation (this->arrow_prog, static_cast<const GLchar*>(name));
+            if (sloc == -1 || dloc == -1) { return; }
+            std::array<float, 16> val;
+            glGetUniformfv (src_prog, sloc, val.data());
+            glUniformMatrix4fv (dloc, 1, GL_FALSE, val.data());
+        }
+        //! Copy a vec3 uniform from \a src_prog to arrow_prog
+        void copy_uniform_3f (GLuint src_prog, const char* name)
+        {
+            GLint sloc = glGetUniformLocation (src_prog, static_cast<const GLchar*>(name));
+            GLint dloc = glGetUniformLocation (this->arrow_prog, static_cast<const GLchar*>(name));
+            if (sloc == -1 || dloc == -1) { return; }
+            std::array<float, 3> val;
+            glGetUniformfv (src_prog, sloc, val.data());
+            glUniform3f (dloc, val[0], val[1], val[2]);
+        }
+        //! Copy a float uniform from \a src_prog to arrow_prog
+        void copy_uniform_1f (GLuint src_prog, const char* name)
+        {
+            GLint sloc = glGetUniformLocation (src_prog, static_cast<const GLchar*>(name));
+            GLint dloc = glGetUniformLocation (this->arrow_prog, static_cast<const GLchar*>(name));
+            if (sloc == -1 || dloc == -1) { return; }
+            float val = 0.0f;
+            glGetUniformfv (src_prog, sloc, &val);
+            glUniform1f (dloc, val);
+        }
+
+        //! The per-instance attribute data: inst_stride floats per vector
+        morph::vvec<float> inst_data;
+        //! How many instances to draw
+        unsigned int n_instances = 0;
+        //! True when inst_data has changed and needs re-uploading
+        bool inst_pending = false;
+        //! The instance attribute buffer
+        GLuint inst_vbo = 0;
+        //! Allocated capacity of inst_vbo, in floats
+        std::size_t inst_capacity = 0;
+        //! Our shader program, which places, scales and colours each arrow instance
+        GLuint arrow_prog = 0;
+    };
+
+} // namespace morph
@@ -0,0 +1,296 @@
+/*!
+ * \file
+ *
+ * An instanced-rendering scatter plot of sphere markers. Where ScatterVisual calls
+ * computeSphere for every data point (360 faces per point, so 100k points mean
+ * millions of vertices rebuilt on every reinit), InstancedScatterVisual tessellates
+ * ONE unit sphere and draws it once per data point with glDrawElementsInstanced,
+ * supplying centre, radius and colour as per-instance attributes. An update is then a
+ * 7-floats-per-point buffer upload rather than a re-tessellation.
+ *
+ * Note: this class makes direct (global alias) OpenGL calls, like the morph::gl
+ * compute subsystem, so use it with morph::VisualNoMX (not the multicontext
+ * morph::Visual). Instancing needs OpenGL 3.3 or newer.
+ *
+ * \author Seb James
+ * \date August 2026
+ */
+#pragma once
+
+#include <morph/gl/version.h>
+#include <morph/gl/shaders.h>
+#include <morph/gl/loadshaders_nomx.h>
+#include <morph/VisualDataModel.h>
+#include <morph/VisualDefaultShaders.h>
+#include <morph/scale.h>
+#include <morph/vec.h>
+#include <morph/vvec.h>
+#include <iostream>
+#include <vector>
+#include <array>
+#include <string>
+
+namespace morph {
+
+    //! The template argument Flt is the type of the data which this
+    //! InstancedScatterVisual will visualize.
+    template <typename Flt, int glver = morph::gl::version_4_1>
+    class InstancedScatterVisual : public VisualDataModel<Flt, glver>
+    {
+    public:
+        InstancedScatterVisual (const vec<float> _offset)
+        {
+            this->mv_offset = _offset;
+            this->viewmatrix.translate (this->mv_offset);
+            this->zScale.setParams (1, 0);
+            this->colourScale.do_autoscale = true;
+        }
+
+        ~InstancedScatterVisual()
+        {
+            if (this->inst_vbo != 0) { glDeleteBuffers (1, &this->inst_vbo); }
+            if (this->sphere_prog != 0) { glDeleteProgram (this->sphere_prog); }
+        }
+
+        //! Tessellate the unit sphere mesh (once) and build the per-instance data
+        void initializeVertices()
+        {
+            unsigned int ncoords = this->dataCoords == nullptr ? 0 : this->dataCoords->size();
+            if (ncoords == 0) { return; }
+            unsigned int ndata = this->scalarData == nullptr ? 0 : this->scalarData->size();
+            unsigned int nvdata = this->vectorData == nullptr ? 0 : this->vectorData->size();
+
+            if (ndata > 0 && ncoords != ndata) {
+                std::cout << "InstancedScatterVisual Error: ncoords ("<<ncoords<<") != ndata ("<<ndata<<"), return (no model)." << std::endl;
+                return;
+            }
+            if (nvdata > 0 && ncoords != nvdata) {
+                std::cout << "InstancedScatterVisual Error: ncoords ("<<ncoords<<") != nvdata ("<<nvdata<<"), return (no model)." << std::endl;
+                return;
+            }
+
+            // The mesh: one unit sphere at the origin. Its colour attribute is unused;
+            // the instanced sphere shader takes colour from the instance attribute.
+            if (this->idx == 0) {
+                std::array<float, 3> meshclr = { 1.0f, 1.0f, 1.0f };
+                this->computeSphere (morph::vec<float>{ 0.0f, 0.0f, 0.0f }, meshclr, 1.0f, 16, 20);
+            }
+
+            // The instances: scale colours as ScatterVisual does
+            std::vector<Flt> dcopy;
+            std::vector<Flt> vdcopy1;
+            std::vector<Flt> vdcopy2;
+            if (ndata && !nvdata) {
+                dcopy = *(this->scalarData);
+                this->colourScale.do_autoscale = true;
+                this->colourScale.transform (*this->scalarData, dcopy);
+            } else if (nvdata) {
+                vdcopy1.resize (this->vectorData->size());
+                vdcopy2.resize (this->vectorData->size());
+                std::vector<Flt> dcopy2 (this->vectorData->size());
+                dcopy.resize (this->vectorData->size());
+                for (unsigned int i = 0; i < this->vectorData->size(); ++i) {
+                    dcopy[i] = (*this->vectorData)[i][0];
+                    dcopy2[i] = (*this->vectorData)[i][1];
+                }
+                this->colourScale.do_autoscale = true;
+                this->colourScale2.do_autoscale = true;
+                this->colourScale.transform (dcopy, vdcopy1);
+                this->colourScale2.transform (dcopy2, vdcopy2);
+            } // else no scaling required - spheres will be one colour
+
+            this->inst_data.resize (inst_stride * static_cast<std::size_t>(ncoords));
+            std::vector<std::string> label_txts;
+            std::vector<morph::vec<float, 3>> label_offs;
+            for (unsigned int i = 0; i < ncoords; ++i) {
+                std::array<float, 3> clr = this->cm.getHueRGB();
+                if (ndata && !nvdata) {
+                    clr = this->cm.convert (dcopy[i]);
+                } else if (nvdata) {
+                    clr = this->cm.convert (vdcopy1[i], vdcopy2[i]);
+                }
+                float rad = static_cast<float>(this->sizeFactor == Flt{0} ? this->radiusFixed : dcopy[i] * this->sizeFactor);
+                float* inst = this->inst_data.data() + inst_stride * i;
+                inst[0] = (*this->dataCoords)[i][0];
+                inst[1] = (*this->dataCoords)[i][1];
+                inst[2] = (*this->dataCoords)[i][2];
+                inst[3] = rad;
+                inst[4] = clr[0];
+                inst[5] = clr[1];
+                inst[6] = clr[2];
+
+                if (this->labelIndices == true) {
+                    // Collected for batch creation after the loop
+                    label_txts.push_back (std::to_string (i));
+                    label_offs.push_back ((*this->dataCoords)[i] + labelOffset);
+                }
+            }
+            if (this->labelIndices == true) {
+                // One VisualTextModel for all the index labels (see addLabels)
+                this->addLabels (label_txts, label_offs, morph::TextFeatures(labelSize));
+            }
+            this->n_instances = ncoords;
+            this->inst_pending = true;
+        }
+
+        //! Render with the instanced sphere shader program. GL objects are created
+        //! lazily here, as render() is the call that is guaranteed a current OpenGL
+        //! context.
+        void render()
+        {
+            if (this->hide == true) { return; }
+
+            if (this->postVertexInitRequired == true) { this->postVertexInit(); }
+            if (this->sphere_prog == 0) { this->init_gl_objects(); }
+            if (this->inst_pending == true) { this->upload_instances(); }
+
+            if (this->n_instances == 0 || this->indices.empty()) { return; }
+
+            GLint prev_shader = 0;
+            glGetIntegerv (GL_CURRENT_PROGRAM, &prev_shader);
+
+            // The projection matrix and the lighting uniforms are owned by the parent
+            // Visual, which sets them on the scene's graphics program; copy them over.
+            GLuint gprog = this->get_gprog (this->parentVis);
+            glUseProgram (this->sphere_prog);
+            this->copy_uniform_mat4 (gprog, "p_matrix");
+            this->copy_uniform_3f (gprog, "light_colour");
+            this->copy_uniform_1f (gprog, "ambient_intensity");
+            this->copy_uniform_3f (gprog, "diffuse_position");
+            this->copy_uniform_1f (gprog, "diffuse_intensity");
+
+            GLint loc_v = glGetUniformLocation (this->sphere_prog, static_cast<const GLchar*>("v_matrix"));
+            if (loc_v != -1) { glUniformMatrix4fv (loc_v, 1, GL_FALSE, this->scenematrix.mat.data()); }
+            GLint loc_m = glGetUniformLocation (this->sphere_prog, static_cast<const GLchar*>("m_matrix"));
+            if (loc_m != -1) { glUniformMatrix4fv (loc_m, 1, GL_FALSE, (this->model_scaling * this->viewmatrix).mat.data()); }
+            GLint loc_a = glGetUniformLocation (this->sphere_prog, static_cast<const GLchar*>("alpha"));
+            if (loc_a != -1) { glUniform1f (loc_a, this->alpha); }
+
+            glBindVertexArray (this->vao);
+            glDrawElementsInstanced (GL_TRIANGLES, static_cast<GLsizei>(this->indices.size()),
+                                     GL_UNSIGNED_INT, 0, static_cast<GLsizei>(this->n_instances));
+            glBindVertexArray (0);
+
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+
+            // Now render any VisualTextModels
+            auto ti = this->texts.begin();
+            while (ti != this->texts.end()) { (*ti)->render(); ti++; }
+
+            glUseProgram (prev_shader);
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+        }
+
+        //! Set this->radiusFixed, then re-compute the instances.
+        void setRadius (float fr)
+        {
+            this->radiusFixed = fr;
+            this->reinit();
+        }
+
+        //! Change this to get larger or smaller spheres.
+        Flt radiusFixed = Flt{0.05};
+        Flt sizeFactor = Flt{0};
+
+        // Do we add index labels?
+        bool labelIndices = false;
+
+        morph::vec<float, 3> labelOffset = { 0.04f, 0.0f, 0.0f };
+        float labelSize = 0.03f;
+
+    protected:
+        //! Floats per instance: centre (3), radius (1), colour (3)
+        static constexpr std::size_t inst_stride = 7;
+        //! Attribute locations for the instance data (0-3 are the standard mesh locations)
+        static constexpr unsigned int inst_posn_rad_loc = 4;
+        static constexpr unsigned int inst_colour_loc = 5;
+
+        //! Create the instanced sphere shader program and the instance attribute
+        //! buffer, wiring the latter into the vertex array object with an attribute
+        //! divisor of 1. Requires a current OpenGL context.
+        void init_gl_objects()
+        {
+            std::vector<morph::gl::ShaderInfo> shaders = {
+                {GL_VERTEX_SHADER, "InstancedScatterVisual.vert.glsl", morph::getInstancedSphereVtxShader (glver), 0 },
+                {GL_FRAGMENT_SHADER, "InstancedScatterVisual.frag.glsl", morph::getDefaultFragShader (glver), 0 }
+            };
+            this->sphere_prog = morph::gl::LoadShaders (shaders);
+
+            glGenBuffers (1, &this->inst_vbo);
+            glBindVertexArray (this->vao);
+            glBindBuffer (GL_ARRAY_BUFFER, this->inst_vbo);
+            constexpr GLsizei stride_bytes = static_cast<GLsizei>(inst_stride * sizeof(float));
+            glVertexAttribPointer (inst_posn_rad_loc, 4, GL_FLOAT, GL_FALSE, stride_bytes, (void*)(0));
+            glEnableVertexAttribArray (inst_posn_rad_loc);
+            glVertexAttribDivisor (inst_posn_rad_loc, 1);
+            glVertexAttribPointer (inst_colour_loc, 3, GL_FLOAT, GL_FALSE, stride_bytes,
+                                   reinterpret_cast<const void*>(4u * sizeof(float)));
+            glEnableVertexAttribArray (inst_colour_loc);
+            glVertexAttribDivisor (inst_colour_loc, 1);
+            glBindVertexArray (0);
+
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+        }
+
+        //! Upload the per-instance data, re-allocating (with headroom) only when the
+        //! instance count outgrows the buffer
+        void upload_instances()
+        {
+            glBindBuffer (GL_ARRAY_BUFFER, this->inst_vbo);
+            std::size_t needed = inst_stride * static_cast<std::size_t>(this->n_instances);
+            if (needed > this->inst_capacity) {
+                this->inst_capacity = needed + needed / 2u + inst_stride;
+                glBufferData (GL_ARRAY_BUFFER, this->inst_capacity * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+            }
+            glBufferSubData (GL_ARRAY_BUFFER, 0, needed * sizeof(float), this->inst_data.data());
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+            this->inst_pending = false;
+        }
+
+        //! Read a mat4 uniform's value from program \a src_prog and set it on
+        //! sphere_prog (which must be in use)
+        void copy_uniform_mat4 (GLuint src_prog, const char* name)
+        {
+            GLint sloc = glGetUniformLocation (src_prog, static_cast<const GLchar*>(name));
+            GLint dloc = glGetUniformLocation (this->sphere_prog, static_cast<const GLchar*>(name));
+            if (sloc == -1 || dloc == -1) { return; }
+            std::array<float, 16> val;
+            glGetUniformfv (src_prog, sloc, val.data());
+            glUniformMatrix4fv (dloc, 1, GL_FALSE, val.data());
+        }
+        //! Copy a vec3 uniform from \a src_prog to sphere_prog
+        void copy_uniform_3f (GLuint src_prog, const char* name)
+        {
+            GLint sloc = glGetUniformLocation (src_prog, static_cast<const GLchar*>(name));
+            GLint dloc = glGetUniformLocation (this->sphere_prog, static_cast<const GLchar*>(name));
+            if (sloc == -1 || dloc == -1) { return; }
+            std::array<float, 3> val;
+            glGetUniformfv (src_prog, sloc, val.data());
+            glUniform3f (dloc, val[0], val[1], val[2]);
+        }
+        //! Copy a float uniform from \a src_prog to sphere_prog
+        void copy_uniform_1f (GLuint src_prog, const char* name)
+        {
+            GLint sloc = glGetUniformLocation (src_prog, static_cast<const GLchar*>(name));
+            GLint dloc = glGetUniformLocation (this->sphere_prog, static_cast<const GLchar*>(name));
+            if (sloc == -1 || dloc == -1) { return; }
+            float val = 0.0f;
+            glGetUniformfv (src_prog, sloc, &val);
+            glUniform1f (dloc, val);
+        }
+
+        //! The per-instance attribute data: inst_stride floats per data point
+        morph::vvec<float> inst_data;
+        //! How many instances to draw
+        unsigned int n_instances = 0;
+        //! True when inst_data has changed and needs re-uploading
+        bool inst_pending = false;
+        //! The instance attribute buffer
+        GLuint inst_vbo = 0;
+        //! Allocated capacity of inst_vbo, in floats
+        std::size_t inst_capacity = 0;
+        //! Our shader program, which places and colours each sphere instance
+        GLuint sphere_prog = 0;
+    };
+
+} // namespace morph
@@ -0,0 +1,152 @@
+/*!
+ * \file
+ *
+ * \brief A read-only, memory-mapped view of a file
+ *
+ * MappedFile maps a file into memory with mmap, rather than copying it through small
+ * sequential reads. The content is presented zero-copy as a span or string_view, and an
+ * madvise hint tells the kernel how the mapping will be accessed, so large assets (SVG
+ * boundary files, GLSL sources, image data) are faulted in efficiently. POSIX only, like
+ * morph::Process.
+ *
+ * \author Seb James
+ * \date August 2026
+ */
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <cstddef>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace morph {
+
+    //! How a MappedFile's content will be accessed; passed to posix_madvise
+    enum class MappedFileAccess
+    {
+        normal,     // No special treatment (POSIX_MADV_NORMAL)
+        sequential, // Front-to-back reading; the kernel can read ahead aggressively (the default)
+        random,     // Scattered access; read-ahead would be wasted
+        willneed    // Whole file wanted soon; fault it in up front
+    };
+
+    class MappedFile
+    {
+    public:
+        //! Construct an empty MappedFile. Call open() before use.
+        MappedFile() {}
+
+        //! Construct and map the file at \a path, with access hint \a hint
+        MappedFile (const std::string& path, const MappedFileAccess hint = MappedFileAccess::sequential)
+        {
+            this->open (path, hint);
+        }
+
+        ~MappedFile() { this->close(); }
+
+        //! No copying (the mapping is owned), but a MappedFile can be moved
+        MappedFile (const MappedFile&) = delete;
+        MappedFile& operator= (const MappedFile&) = delete;
+        MappedFile (MappedFile&& other)
+        {
+            this->map = std::exchange (other.map, nullptr);
+            this->sz = std::exchange (other.sz, 0U);
+            this->filepath = std::move (other.filepath);
+        }
+        MappedFile& operator= (MappedFile&& other)
+        {
+            if (this != &other) {
+                this->close();
+                this->map = std::exchange (other.map, nullptr);
+                this->sz = std::exchange (other.sz, 0U);
+                this->filepath = std::move (other.filepath);
+            }
+            return *this;
+        }
+
+        //! Map the file at \a path read-only, applying the madvise \a hint
+        void open (const std::string& path, const MappedFileAccess hint = MappedFileAccess::sequential)
+        {
+            this->close();
+            this->filepath = path;
+            int fd = ::open (path.c_str(), O_RDONLY);
+            if (fd == -1) {
+                std::stringstream ee;
+                ee << "MappedFile: Failed to open file " << path << " for reading";
+                throw std::runtime_error (ee.str());
+            }
+            struct stat sb;
+            if (fstat (fd, &sb) == -1) {
+                ::close (fd);
+                throw std::runtime_error ("MappedFile: Failed to stat file " + path);
+            }
+            this->sz = static_cast<std::size_t>(sb.st_size);
+            if (this->sz == 0U) {
+                // Can't mmap zero bytes; an empty file gives an empty (but open()ed) view
+                ::close (fd);
+                return;
+            }
+            this->map = mmap (nullptr, this->sz, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close (fd); // the mapping keeps its own reference
+            if (this->map == MAP_FAILED) {
+                this->map = nullptr;
+                this->sz = 0U;
+                throw std::runtime_error ("MappedFile: mmap failed for " + path);
+            }
+            int adv = POSIX_MADV_NORMAL;
+            if (hint == MappedFileAccess::sequential) {
+                adv = POSIX_MADV_SEQUENTIAL;
+            } else if (hint == MappedFileAccess::random) {
+                adv = POSIX_MADV_RANDOM;
+            } else if (hint == MappedFileAccess::willneed) {
+                adv = POSIX_MADV_WILLNEED;
+            }
+            posix_madvise (this->map, this->sz, adv); // advisory; ignore any failure
+        }
+
+        //! Unmap, returning this MappedFile to its empty state
+        void close()
+        {
+            if (this->map != nullptr) { munmap (this->map, this->sz); }
+            this->map = nullptr;
+            this->sz = 0U;
+        }
+
+        //! The file's bytes, zero-copy. NB: NOT null terminated.
+        std::span<const char> bytes() const
+        {
+            return std::span<const char> (static_cast<const char*>(this->map), this->sz);
+        }
+
+        //! The file's content viewed as a string, zero-copy
+        std::string_view view() const
+        {
+            return std::string_view (static_cast<const char*>(this->map), this->sz);
+        }
+
+        //! A pointer to the file's first byte
+        const char* data() const { return static_cast<const char*>(this->map); }
+
+        //! The size of the file in bytes
+        std::size_t size() const { return this->sz; }
+
+        //! The path that was mapped
+        std::string path() const { return this->filepath; }
+
+    private:
+        //! The mmap'd region (nullptr when nothing is mapped)
+        void* map = nullptr;
+        //! The size of the mapping in bytes
+        std::size_t sz = 0U;
+        //! The path from which the data was mapped
+        std::string filepath = "";
+    };
+
+} // namespace morph
@@ -11,6 +11,11 @@
 #include <bitset>
 #include <memory>
 #include <cstddef>
+#include <map>
+#include <utility>
+#include <span>
+#include <cmath>
+#include <stdexcept>
 #include <morph/vec.h>
 #include <morph/vvec.h>
 #include <morph/range.h>
@@ -431,6 +436,66 @@ namespace morph {
             }
         }
 
+        /*!
+         * Compute the median of \a values in place with std::nth_element - O(n), where
+         * sorting a copy is O(n log n) plus the copy. The span is partially reordered
+         * (that is the point: no copy is made). For an even count, the median is the
+         * mean of the two middle elements.
+         */
+        template<typename T>
+        static T median_inplace (std::span<T> values)
+        {
+            if (values.empty()) { throw std::runtime_error ("median_inplace: empty input"); }
+            const std::size_t mid = values.size() / 2;
+            std::nth_element (values.begin(), values.begin() + mid, values.end());
+            T m = values[mid];
+            if ((values.size() & 1) == 0) {
+                // Even count: the other middle element is the max of the lower partition
+                T lo = *std::max_element (values.begin(), values.begin() + mid);
+                m = (lo + m) / T{2};
+            }
+            return m;
+        }
+
+        //! Compute the median of \a values, leaving the container untouched (a working
+        //! copy is made and partially reordered)
+        template<typename Container, std::enable_if_t<morph::is_copyable_container<Container>::value, int> = 0>
+        static typename Container::value_type median (const Container& values)
+        {
+            std::vector<typename Container::value_type> work (values.begin(), values.end());
+            return MathAlgo::median_inplace (std::span<typename Container::value_type>{work});
+        }
+
+        /*!
+         * Compute the \a p quantile (p in [0,1]; p = 0.5 is the median) of \a values in
+         * place with std::nth_element, interpolating linearly between order statistics
+         * (the 'R-7' definition used by numpy.quantile's default). The span is
+         * partially reordered.
+         */
+        template<typename T>
+        static T quantile_inplace (std::span<T> values, const double p)
+        {
+            if (values.empty()) { throw std::runtime_error ("quantile_inplace: empty input"); }
+            if (p < 0.0 || p > 1.0) { throw std::runtime_error ("quantile_inplace: p must be in [0,1]"); }
+            const double h = p * static_cast<double>(values.size() - 1);
+            const std::size_t lo = static_cast<std::size_t>(h);
+            std::nth_element (values.begin(), values.begin() + lo, values.end());
+            const T vlo = values[lo];
+            const double frac = h - static_cast<double>(lo);
+            if (frac == 0.0) { return vlo; }
+            // The next order statistic is the min of the upper partition
+            const T vhi = *std::min_element (values.begin() + lo + 1, values.end());
+            return static_cast<T>(vlo + frac * (vhi - vlo));
+        }
+
+        //! Compute the \a p quantile of \a values, leaving the container untouched
+        template<typename Container, std::enable_if_t<morph::is_copyable_container<Container>::value, int> = 0>
+        static typename Container::value_type quantile (const Container& values, const double p)
+        {
+            std::vector<typename Container::value_type> work (values.begin(), values.end());
+            return MathAlgo::quantile_inplace (std::span<typename Container::value_type>{work}, p);
+        }
+
         //! The bubble sort algorithm, high to low. T could be floating point or
         //! integer types.
         template<typename T>
@@ -1031,4 +1096,165 @@ namespace morph {
 
     }; // struct MathAlgo
 
+    /*!
+     * A filter plan for repeated 2D filtering of same-size image data
+     *
+     * MathAlgo's boxfilter_2d and vvec's smooth_gauss rebuild their coefficient arrays (and
+     * allocate working memory) on every call, which is wasteful when the same filters are applied
+     * to frame after frame of Grid/CartGrid data. A filter_plan is constructed once for a given
+     * image width and height and then re-used. It caches 1D Gaussian kernels by (sigma, n_sigma),
+     * applies them separably with OpenMP parallelism over image rows, and provides an in-place
+     * box filter computed from a summed-area table (so the cost is independent of boxside).
+     *
+     * Unlike MathAlgo::boxfilter_2d, the plan's filters do not wrap horizontally; out-of-image
+     * samples are clamped to the nearest edge pixel (and the box mean is taken over the in-image
+     * box area), which is the usual convention for image preprocessing.
+     *
+     * \tparam T The (floating point) type of the image data
+     */
+    template <typename T> requires std::is_floating_point_v<T>
+    struct filter_plan
+    {
+        //! Construct a plan for images of width \a _w and height \a _h pixels
+        filter_plan (const int _w, const int _h) : w(_w), h(_h)
+        {
+            if (_w <= 0 || _h <= 0) {
+                throw std::runtime_error ("morph::filter_plan: width and height must be positive");
+            }
+            this->tmp.resize (static_cast<std::size_t>(_w) * _h, T{0});
+            this->sat.resize ((static_cast<std::size_t>(_w) + 1u) * (static_cast<std::size_t>(_h) + 1u), 0.0);
+        }
+
+        /*!
+         * Return the normalized 1D Gaussian kernel for the given \a sigma, built out to \a
+         * n_sigma standard deviations. Kernels are cached, so repeated calls with the same
+         * arguments cost one map lookup.
+         */
+        const morph::vvec<T>& gauss_kernel (const T sigma, const unsigned int n_sigma = 3)
+        {
+            auto k = this->kernels.find (std::make_pair (sigma, n_sigma));
+            if (k != this->kernels.end()) { return k->second; }
+            if (sigma <= T{0}) { throw std::runtime_error ("morph::filter_plan::gauss_kernel: sigma must be positive"); }
+            const int hw = static_cast<int>(std::ceil (sigma * n_sigma));
+            morph::vvec<T> kern (2 * hw + 1, T{0});
+            T sum = T{0};
+            for (int i = -hw; i <= hw; ++i) {
+                kern[i + hw] = std::exp (-(static_cast<T>(i) * static_cast<T>(i)) / (T{2} * sigma * sigma));
+                sum += kern[i + hw];
+            }
+            kern /= sum;
+            return this->kernels[std::make_pair (sigma, n_sigma)] = kern;
+        }
+
+        /*!
+         * Gaussian-smooth the w*h image \a data into \a result (which may be the same vvec; the
+         * intermediate row pass goes via plan-owned memory). The 2D convolution is applied
+         * separably - a horizontal pass then a vertical pass - parallelized over image rows.
+         */
+        void smooth_gauss (const morph::vvec<T>& data, morph::vvec<T>& result, const T sigma, const unsigned int n_sigma = 3)
+        {
+            if (data.size() != this->tmp.size() || result.size() != this->tmp.size()) {
+                throw std::runtime_error ("morph::filter_plan::smooth_gauss: data/result size does not match the plan's w * h");
+            }
+            const morph::vvec<T>& kern = this->gauss_kernel (sigma, n_sigma);
+            const int hw = (static_cast<int>(kern.size()) - 1) / 2;
+
+            // Horizontal pass, data -> tmp
+#pragma omp parallel for
+            for (int y = 0; y < this->h; ++y) {
+                const T* drow = data.data() + static_cast<std::size_t>(y) * this->w;
+                T* trow = this->tmp.data() + static_cast<std::size_t>(y) * this->w;
+                for (int x = 0; x < this->w; ++x) {
+                    T acc = T{0};
+                    for (int i = -hw; i <= hw; ++i) {
+                        const int xi = std::clamp (x + i, 0, this->w - 1);
+                        acc += kern[i + hw] * drow[xi];
+                    }
+                    trow[x] = acc;
+                }
+            }
+
+            // Vertical pass, tmp -> result
+#pragma omp parallel for
+            for (int y = 0; y < this->h; ++y) {
+                for (int x = 0; x < this->w; ++x) {
+                    T acc = T{0};
+                    for (int i = -hw; i <= hw; ++i) {
+                        const int yi = std::clamp (y + i, 0, this->h - 1);
+                        acc += kern[i + hw] * this->tmp[static_cast<std::size_t>(yi) * this->w + x];
+                    }
+                    result[static_cast<std::size_t>(y) * this->w + x] = acc;
+                }
+            }
+        }
+
+        /*!
+         * In-place box filter of the w*h image \a data using a summed-area table, so the cost per
+         * pixel is four lookups however large \a boxside is. At the image edges the box is
+         * clipped and the mean is taken over the in-image pixels.
+         */
+        void boxfilter_sat (morph::vvec<T>& data, const int boxside)
+        {
+            if (boxside % 2 == 0) {
+                throw std::runtime_error ("morph::filter_plan::boxfilter_sat was not designed for even box filter squares");
+            }
+            if (data.size() != this->tmp.size()) {
+                throw std::runtime_error ("morph::filter_plan::boxfilter_sat: data size does not match the plan's w * h");
+            }
+            const int hb = boxside / 2;
+            const std::size_t sw = static_cast<std::size_t>(this->w) + 1u;
+
+            // Build the summed-area table. First row prefix sums (parallel over rows)...
+            for (std::size_t x = 0; x < sw; ++x) { this->sat[x] = 0.0; }
+#pragma omp parallel for
+            for (int y = 0; y < this->h; ++y) {
+                double rs = 0.0;
+                double* srow = this->sat.data() + (static_cast<std::size_t>(y) + 1u) * sw;
+                const T* drow = data.data() + static_cast<std::size_t>(y) * this->w;
+                srow[0] = 0.0;
+                for (int x = 0; x < this->w; ++x) {
+                    rs += static_cast<double>(drow[x]);
+                    srow[x + 1] = rs;
+                }
+            }
+            // ...then accumulate down the columns (parallel over columns)
+#pragma omp parallel for
+            for (int x = 0; x < static_cast<int>(sw); ++x) {
+                for (int y = 1; y <= this->h; ++y) {
+                    this->sat[static_cast<std::size_t>(y) * sw + x] += this->sat[(static_cast<std::size_t>(y) - 1u) * sw + x];
+                }
+            }
+
+            // Now each output pixel is four table lookups
+#pragma omp parallel for
+            for (int y = 0; y < this->h; ++y) {
+                const int y0 = y - hb < 0 ? 0 : y - hb;
+                const int y1 = y + hb >= this->h ? this->h - 1 : y + hb;
+                for (int x = 0; x < this->w; ++x) {
+                    const int x0 = x - hb < 0 ? 0 : x - hb;
+                    const int x1 = x + hb >= this->w ? this->w - 1 : x + hb;
+                    const double boxsum = this->sat[(static_cast<std::size_t>(y1) + 1u) * sw + x1 + 1]
+                    - this->sat[static_cast<std::size_t>(y0) * sw + x1 + 1]
+                    - this->sat[(static_cast<std::size_t>(y1) + 1u) * sw + x0]
+                    + this->sat[static_cast<std::size_t>(y0) * sw + x0];
+                    data[static_cast<std::size_t>(y) * this->w + x] =
+                    static_cast<T>(boxsum / (static_cast<double>(y1 - y0 + 1) * static_cast<double>(x1 - x0 + 1)));
+                }
+            }
+        }
+
+        //! The width of the images this plan filters
+        int w = 0;
+        //! The height of the images this plan filters
+        int h = 0;
+
+    private:
+        //! Cached 1D Gaussian kernels, keyed by (sigma, n_sigma)
+        std::map<std::pair<T, unsigned int>, morph::vvec<T>> kernels;
+        //! Plan-owned intermediate for the separable passes
+        morph::vvec<T> tmp;
+        //! The summed-area table, (w+1)*(h+1), accumulated in double for precision
+        std::vector<double> sat;
+    };
+
 } // namespace morph
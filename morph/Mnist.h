@@ -43,6 +43,15 @@
 #include <stdexcept>
 #include <morph/vec.h>
 #include <morph/vvec.h>
+#ifndef _MSC_VER
+# include <cstdint>
+# include <cstddef>
+# include <span>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <fcntl.h>
+# include <unistd.h>
+#endif
 
 namespace morph {
 
@@ -292,4 +301,189 @@ namespace morph {
         std::multimap<unsigned char, std::pair<int, morph::vvec<float>> > test_f;
     };
 
+#ifndef _MSC_VER // MnistMmap uses POSIX mmap
+    /*!
+     * A memory-mapped, zero-copy alternative to morph::Mnist.
+     *
+     * Where Mnist reads every pixel through an ifstream and stores each image as a vvec of float
+     * (several times the on-disk size, and slow to load), MnistMmap simply maps the idx files
+     * into memory. Images stay as contiguous uint8 pixels in the page cache - shared between
+     * processes mapping the same files - and are converted to floating point on demand, either
+     * one image or a batch at a time, into caller-provided storage. 'Loading' is then just four
+     * mmap calls, however large the dataset.
+     *
+     * Note one layout difference from Mnist: the spans returned by image() present the pixels in
+     * file order (top row first); extract() and image_f() convert to Mnist's bottom-row-first
+     * ordering (and 0-1 range) so that converted images are interchangeable with Mnist's.
+     */
+    struct MnistMmap
+    {
+        //! One mapped idx image/label file pair; MnistMmap holds one for training, one for test
+        struct idxset
+        {
+            idxset() {}
+            ~idxset()
+            {
+                if (this->img_map != nullptr) { munmap (this->img_map, this->img_bytes); }
+                if (this->lbl_map != nullptr) { munmap (this->lbl_map, this->lbl_bytes); }
+            }
+            // The mappings can't be shared, so no copying (MnistMmap holds idxsets by value)
+            idxset (const idxset&) = delete;
+            idxset& operator= (const idxset&) = delete;
+
+            //! Map the image file \a img_p and label file \a lbl_p, checking idx headers
+            void open (const std::string& img_p, const std::string& lbl_p)
+            {
+                this->img_map = this->map_one (img_p, 16, this->img_bytes); // 16/8: min bytes for the idx header
+                this->lbl_map = this->map_one (lbl_p, 8, this->lbl_bytes);
+
+                const std::uint8_t* ih = static_cast<const std::uint8_t*>(this->img_map);
+                const std::uint8_t* lh = static_cast<const std::uint8_t*>(this->lbl_map);
+                if (this->be32 (ih) != 2051) { throw std::runtime_error ("MnistMmap: images magic number is wrong"); }
+                if (this->be32 (lh) != 2049) { throw std::runtime_error ("MnistMmap: labels magic number is wrong"); }
+                this->n = this->be32 (ih + 4);
+                int nr = this->be32 (ih + 8);
+                int nc = this->be32 (ih + 12);
+                if (nr * nc != mnlen) { throw std::runtime_error ("MnistMmap: Expecting 28x28 images in Mnist!"); }
+                if (this->be32 (lh + 4) != this->n) { throw std::runtime_error ("MnistMmap: num labels != num images"); }
+                if (this->img_bytes < 16 + static_cast<std::size_t>(this->n) * mnlen
+                    || this->lbl_bytes < 8 + static_cast<std::size_t>(this->n)) {
+                    throw std::runtime_error ("MnistMmap: file too short for the number of examples it declares");
+                }
+                this->pixels = ih + 16;
+                this->labels = lh + 8;
+            }
+
+            //! The number of examples in this set
+            int size() const { return this->n; }
+
+            //! The label of example \a i
+            unsigned char label (int i) const { return this->labels[i]; }
+
+            //! The raw pixels of example \a i: 784 uint8s, top row first, straight from the file
+            std::span<const std::uint8_t> image (int i) const
+            {
+                return std::span<const std::uint8_t> (this->pixels + static_cast<std::size_t>(i) * mnlen, mnlen);
+            }
+
+            //! Convert example \a i into \a buf (at least mnlen elements), matching Mnist's
+            //! format: values in [0,1), bottom row first
+            template <typename F = float>
+            void extract (int i, F* buf) const
+            {
+                const std::uint8_t* px = this->pixels + static_cast<std::size_t>(i) * mnlen;
+                for (int r = 0; r < 28; ++r) {
+                    const std::uint8_t* row = px + r * 28;
+                    F* orow = buf + (27 - r) * 28;
+                    for (int c = 0; c < 28; ++c) { orow[c] = static_cast<F>(row[c]) / F{256}; }
+                }
+            }
+
+            //! Batch-convert \a n_imgs examples starting at \a i0 into \a buf, which must have
+            //! space for n_imgs * mnlen elements (one image after another)
+            template <typename F = float>
+            void extract_batch (int i0, int n_imgs, F* buf) const
+            {
+                for (int i = 0; i < n_imgs; ++i) { this->extract (i0 + i, buf + static_cast<std::size_t>(i) * mnlen); }
+            }
+
+            //! Convert example \a i, returning a vvec like those held by morph::Mnist
+            template <typename F = float>
+            morph::vvec<F> image_f (int i) const
+            {
+                morph::vvec<F> rtn (mnlen, F{0});
+                this->extract (i, rtn.data());
+                return rtn;
+            }
+
+            //! What the iterator yields: the example's ID, its label and a zero-copy span of
+            //! its raw pixels (top row first; use extract() for Mnist-format floats)
+            struct example
+            {
+                int id;
+                unsigned char label;
+                std::span<const std::uint8_t> pixels;
+            };
+
+            //! A forward iterator over the examples in an idxset, yielding spans - no copying
+            struct iterator
+            {
+                const idxset* parent = nullptr;
+                int i = 0;
+                example operator*() const { return example{ this->i, this->parent->label (this->i), this->parent->image (this->i) }; }
+                iterator& operator++() { ++this->i; return *this; }
+                bool operator== (const iterator& other) const { return this->i == other.i; }
+                bool operator!= (const iterator& other) const { return this->i != other.i; }
+            };
+            iterator begin() const { return iterator{ this, 0 }; }
+            iterator end() const { return iterator{ this, this->n }; }
+
+        private:
+            //! mmap the whole of the file at \a path read-only, returning the mapping (and its
+            //! size in \a len_out). \a min_len is the smallest credible file (its header size).
+            void* map_one (const std::string& path, const std::size_t min_len, std::size_t& len_out)
+            {
+                int fd = ::open (path.c_str(), O_RDONLY);
+                if (fd == -1) {
+                    throw std::runtime_error ("MnistMmap: File access error opening " + path);
+                }
+                struct stat sb;
+                if (fstat (fd, &sb) == -1 || sb.st_size < static_cast<off_t>(min_len)) {
+                    ::close (fd);
+                    throw std::runtime_error ("MnistMmap: Could not stat (or too short): " + path);
+                }
+                len_out = static_cast<std::size_t>(sb.st_size);
+                void* m = mmap (nullptr, len_out, PROT_READ, MAP_PRIVATE, fd, 0);
+                ::close (fd); // the mapping keeps its own reference
+                if (m == MAP_FAILED) {
+                    throw std::runtime_error ("MnistMmap: mmap failed for " + path);
+                }
+                return m;
+            }
+
+            //! Decode a big-endian 32 bit integer, as used in the idx headers
+            int be32 (const std::uint8_t* p) const { return p[3] | p[2] << 8 | p[1] << 16 | p[0] << 24; }
+
+            //! First pixel byte (header skipped) within img_map
+            const std::uint8_t* pixels = nullptr;
+            //! First label byte within lbl_map
+            const std::uint8_t* labels = nullptr;
+            //! The raw mappings and their lengths, for munmap
+            void* img_map = nullptr;
+            void* lbl_map = nullptr;
+            std::size_t img_bytes = 0;
+            std::size_t lbl_bytes = 0;
+            //! The number of examples
+            int n = 0;
+        };
+
+        MnistMmap() { this->init(); }
+
+        MnistMmap (const std::string& path)
+        {
+            this->basepath = path;
+            this->init();
+        }
+
+        void init()
+        {
+            this->training.open (basepath + "train-images-idx3-ubyte", basepath + "train-labels-idx1-ubyte");
+            this->test.open (basepath + "t10k-images-idx3-ubyte", basepath + "t10k-labels-idx1-ubyte");
+        }
+
+        //! Get the number of training examples
+        std::size_t num_training() { return static_cast<std::size_t>(this->training.size()); }
+        //! Number of test examples
+        std::size_t num_test() { return static_cast<std::size_t>(this->test.size()); }
+
+        //! The basepath for finding the files that contain the numeral image data
+        std::string basepath = "mnist/";
+
+        //! The mapped training data (60000 examples)
+        idxset training;
+        //! The mapped test data (10000 examples)
+        idxset test;
+    };
+#endif // _MSC_VER
+
 } // namespace morph
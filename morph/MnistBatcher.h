@@ -0,0 +1,320 @@
+/*!
+ * \file
+ *
+ * \brief A background augmentation and prefetch pipeline for MNIST training batches
+ *
+ * Training loops that augment examples (shift/rotate/add noise) on the fly in the same
+ * thread that runs the network spend a large fraction of each step preparing data while
+ * the net sits idle. MnistBatcher moves that work onto a pool of worker threads which
+ * fill preallocated batch buffers ahead of the consumer, so a ready, augmented batch is
+ * (almost) always waiting when the training step asks for one.
+ *
+ * \code
+ *   morph::Mnist data ("mnist/");
+ *   morph::MnistAugment aug; // default: +/-2 px shift, +/-10 deg rotation
+ *   morph::MnistBatcher batcher (data, 64, aug);
+ *   for (unsigned int step = 0; step < n_steps; ++step) {
+ *       const morph::MnistBatch& b = batcher.acquire(); // blocks only if workers lag
+ *       net.trainMiniBatch (b.ins, b.outs, eta);
+ *       batcher.release(); // hand the buffer back for refilling
+ *   }
+ * \endcode
+ *
+ * \author Seb James
+ * \date August 2026
+ */
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <stdexcept>
+#include <cmath>
+#include <morph/Mnist.h>
+#include <morph/vvec.h>
+#include <morph/Random.h>
+#include <morph/mathconst.h>
+
+namespace morph {
+
+    //! The augmentations MnistBatcher applies to each example it serves. Each is
+    //! disabled by setting its parameter to zero; with all three zero, batches hold
+    //! unmodified (but still randomly sampled) examples.
+    struct MnistAugment
+    {
+        //! Shift the image by a uniform-random subpixel offset in [-max_shift,
+        //! max_shift] pixels, independently per axis
+        float max_shift = 2.0f;
+        //! Rotate the image about its centre by a uniform-random angle in
+        //! [-max_rotate, max_rotate] degrees
+        float max_rotate = 10.0f;
+        //! Add Gaussian noise of this standard deviation to each pixel (the result is
+        //! clamped back to [0,1])
+        float noise_sd = 0.0f;
+    };
+
+    //! One training batch: inputs and one-hot (10 element) targets, shaped for
+    //! FeedForwardNet::trainMiniBatch
+    struct MnistBatch
+    {
+        std::vector<morph::vvec<float>> ins;
+        std::vector<morph::vvec<float>> outs;
+    };
+
+    /*!
+     * The pipeline. At construction this flattens the source examples into contiguous
+     * storage, preallocates n_workers + 2 batch buffers and starts n_workers threads.
+     * Each worker repeatedly takes a free buffer, fills it with batch_size
+     * randomly-sampled, augmented examples (one fused rotate+shift resampling pass
+     * with bilinear interpolation, then optional noise) and queues it as ready. The
+     * consumer alternates acquire()/release(); with the consumer holding one buffer
+     * and at least one more ready or in flight, data preparation is fully overlapped
+     * with training. No allocation happens in the steady state - buffers cycle between
+     * the free and ready queues.
+     */
+    struct MnistBatcher
+    {
+        /*!
+         * Set up the pipeline drawing examples from the training set of \a data. \a
+         * batch_size examples per batch; \a aug configures the augmentations; \a
+         * n_workers worker threads (0 means half of hardware_concurrency, at least
+         * one: the training step needs cores too); \a seed makes the sampled
+         * example-and-augmentation sequence of each worker deterministic.
+         */
+        MnistBatcher (const morph::Mnist& data, const unsigned int batch_size,
+                      const MnistAugment aug = {}, const unsigned int n_workers = 0,
+                      const unsigned int seed = 0xba7c4e5u)
+        {
+            const std::size_t n = data.training_f.size();
+            if (n == 0) { throw std::runtime_error ("MnistBatcher: no training examples in the Mnist"); }
+            this->base_pixels.resize (n * morph::mnlen);
+            this->base_labels.resize (n);
+            std::size_t i = 0;
+            for (const auto& ex : data.training_f) {
+                this->base_labels[i] = ex.first;
+                const morph::vvec<float>& img = ex.second.second;
+                std::copy (img.begin(), img.end(), this->base_pixels.begin() + i * morph::mnlen);
+                ++i;
+            }
+            this->init (batch_size, aug, n_workers, seed);
+        }
+
+        /*!
+         * Set up the pipeline from already-flattened data: \a pixels holds one
+         * mnlen-element image after another (any consistent row order; values in
+         * [0,1]) and \a labels one 0-9 label per image.
+         */
+        MnistBatcher (std::vector<float>&& pixels, std::vector<unsigned char>&& labels,
+                      const unsigned int batch_size,
+                      const MnistAugment aug = {}, const unsigned int n_workers = 0,
+                      const unsigned int seed = 0xba7c4e5u)
+            : base_pixels (std::move (pixels))
+            , base_labels (std::move (labels))
+        {
+            if (this->base_labels.empty()
+                || this->base_pixels.size() != this->base_labels.size() * morph::mnlen) {
+                throw std::runtime_error ("MnistBatcher: pixels/labels sizes don't make a whole number of examples");
+            }
+            this->init (batch_size, aug, n_workers, seed);
+        }
+
+        ~MnistBatcher()
+        {
+            {
+                std::lock_guard<std::mutex> lk (this->mtx);
+                this->finished = true;
+                this->free_cv.notify_all();
+            }
+            for (std::thread& w : this->workers) {
+                if (w.joinable() == true) { w.join(); }
+            }
+        }
+
+        MnistBatcher (const MnistBatcher&) = delete;
+        MnistBatcher& operator= (const MnistBatcher&) = delete;
+
+        /*!
+         * A filled batch, blocking until one is ready (in the steady state the workers
+         * keep ahead and this returns at once). The returned reference is valid until
+         * the matching release(). Rethrows here if a worker hit an error.
+         */
+        const MnistBatch& acquire()
+        {
+            std::unique_lock<std::mutex> lk (this->mtx);
+            if (this->held != MnistBatcher::none) {
+                throw std::runtime_error ("MnistBatcher: call release() before the next acquire()");
+            }
+            this->ready_cv.wait (lk, [this] {
+                return !this->ready.empty() || this->worker_error != nullptr;
+            });
+            if (this->ready.empty() && this->worker_error != nullptr) {
+                std::rethrow_exception (this->worker_error);
+            }
+            this->held = this->ready.front();
+            this->ready.pop_front();
+            return this->slots[this->held];
+        }
+
+        //! Hand the acquired batch buffer back to the workers for refilling
+        void release()
+        {
+            std::lock_guard<std::mutex> lk (this->mtx);
+            if (this->held == MnistBatcher::none) {
+                throw std::runtime_error ("MnistBatcher: release() without a matching acquire()");
+            }
+            this->freeq.push_back (this->held);
+            this->held = MnistBatcher::none;
+            this->free_cv.notify_one();
+        }
+
+        //! The number of source examples the pipeline samples from
+        std::size_t num_examples() const { return this->base_labels.size(); }
+
+    private:
+        static constexpr std::size_t none = std::size_t{0} - 1u;
+
+        //! Preallocate the batch buffers and start the workers (common to both ctors)
+        void init (const unsigned int batch_size, const MnistAugment aug,
+                   unsigned int n_workers, const unsigned int seed)
+        {
+            if (batch_size == 0) { throw std::runtime_error ("MnistBatcher: batch_size must be > 0"); }
+            this->bs = batch_size;
+            this->augment = aug;
+            if (n_workers == 0) {
+                n_workers = std::thread::hardware_concurrency() / 2u;
+                if (n_workers == 0) { n_workers = 1; }
+            }
+
+            // Preallocate every buffer up front; nothing allocates after this
+            this->slots.resize (n_workers + 2u);
+            for (std::size_t s = 0; s < this->slots.size(); ++s) {
+                this->slots[s].ins.assign (this->bs, morph::vvec<float> (morph::mnlen, 0.0f));
+                this->slots[s].outs.assign (this->bs, morph::vvec<float> (10, 0.0f));
+                this->freeq.push_back (s);
+            }
+
+            this->workers.reserve (n_workers);
+            for (unsigned int w = 0; w < n_workers; ++w) {
+                this->workers.emplace_back (&MnistBatcher::work, this, seed + w);
+            }
+        }
+
+        //! The worker loop: take a free buffer, fill it, queue it as ready
+        void work (const unsigned int seed)
+        {
+            try {
+                morph::RandUniform<std::size_t> pick_rng (0, this->base_labels.size() - 1u, seed);
+                morph::RandUniform<float> aug_rng (-1.0f, 1.0f, seed + 0x9e3779b9u);
+                morph::RandNormal<float> noise_rng (0.0f, 1.0f, seed + 0x85ebca6bu);
+                for (;;) {
+                    std::size_t s = MnistBatcher::none;
+                    {
+                        std::unique_lock<std::mutex> lk (this->mtx);
+                        this->free_cv.wait (lk, [this] {
+                            return !this->freeq.empty() || this->finished == true;
+                        });
+                        if (this->finished == true) { return; }
+                        s = this->freeq.front();
+                        this->freeq.pop_front();
+                    }
+                    MnistBatch& b = this->slots[s];
+                    for (unsigned int j = 0; j < this->bs; ++j) {
+                        const std::size_t id = pick_rng.get();
+                        this->fill_example (id, b.ins[j], aug_rng, noise_rng);
+                        b.outs[j].zero();
+                        b.outs[j][this->base_labels[id] % 10u] = 1.0f;
+                    }
+                    {
+                        std::lock_guard<std::mutex> lk (this->mtx);
+                        this->ready.push_back (s);
+                        this->ready_cv.notify_one();
+                    }
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lk (this->mtx);
+                this->worker_error = std::current_exception();
+                this->ready_cv.notify_all();
+            }
+        }
+
+        //! Write one augmented copy of base example \a id into \a out: a fused
+        //! rotate-and-shift resampling pass (bilinear interpolation; pixels sampled
+        //! from outside the source image are 0) followed by optional additive noise.
+        void fill_example (const std::size_t id, morph::vvec<float>& out,
+                           morph::RandUniform<float>& aug_rng, morph::RandNormal<float>& noise_rng)
+        {
+            const float* src = this->base_pixels.data() + id * morph::mnlen;
+
+            const float theta = this->augment.max_rotate * morph::mathconst<float>::deg2rad * aug_rng.get();
+            const float sx = this->augment.max_shift * aug_rng.get();
+            const float sy = this->augment.max_shift * aug_rng.get();
+
+            if (theta == 0.0f && sx == 0.0f && sy == 0.0f) {
+                std::copy (src, src + morph::mnlen, out.begin());
+            } else {
+                // For each output pixel, sample the source at the inverse-transformed
+                // location: rotate by -theta about the image centre, then un-shift
+                const float ct = std::cos (theta);
+                const float st = std::sin (theta);
+                constexpr float centre = 13.5f; // of columns/rows 0 to 27
+                for (int r = 0; r < 28; ++r) {
+                    for (int c = 0; c < 28; ++c) {
+                        const float xo = static_cast<float>(c) - centre - sx;
+                        const float yo = static_cast<float>(r) - centre - sy;
+                        const float xs = ct * xo + st * yo + centre;
+                        const float ys = -st * xo + ct * yo + centre;
+                        const int x0 = static_cast<int>(std::floor (xs));
+                        const int y0 = static_cast<int>(std::floor (ys));
+                        const float fx = xs - static_cast<float>(x0);
+                        const float fy = ys - static_cast<float>(y0);
+                        auto px = [src] (const int x, const int y) {
+                            return (x < 0 || x > 27 || y < 0 || y > 27) ? 0.0f : src[y * 28 + x];
+                        };
+                        out[r * 28 + c] = (1.0f - fy) * ((1.0f - fx) * px (x0, y0) + fx * px (x0 + 1, y0))
+                            + fy * ((1.0f - fx) * px (x0, y0 + 1) + fx * px (x0 + 1, y0 + 1));
+                    }
+                }
+            }
+
+            if (this->augment.noise_sd > 0.0f) {
+                for (int p = 0; p < morph::mnlen; ++p) {
+                    const float v = out[p] + this->augment.noise_sd * noise_rng.get();
+                    out[p] = v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+                }
+            }
+        }
+
+        //! The source examples, flattened: one mnlen-element image after another
+        std::vector<float> base_pixels;
+        //! One 0-9 label per source example
+        std::vector<unsigned char> base_labels;
+        //! Examples per batch
+        unsigned int bs = 0;
+        //! The augmentations to apply
+        MnistAugment augment;
+
+        //! The preallocated batch buffers; indices into this cycle through freeq/ready
+        std::vector<MnistBatch> slots;
+        //! Buffers awaiting a worker
+        std::deque<std::size_t> freeq;
+        //! Filled buffers awaiting the consumer
+        std::deque<std::size_t> ready;
+        //! The buffer the consumer holds between acquire() and release()
+        std::size_t held = MnistBatcher::none;
+
+        std::mutex mtx;
+        //! Signalled when a batch lands in ready
+        std::condition_variable ready_cv;
+        //! Signalled when release() frees a buffer (or at destruction)
+        std::condition_variable free_cv;
+        //! An exception from a worker thread, rethrown from acquire()
+        std::exception_ptr worker_error = nullptr;
+        //! Set at destruction to stop the workers
+        bool finished = false;
+        std::vector<std::thread> workers;
+    };
+
+} // namespace morph
@@ -34,7 +34,10 @@ namespace morph {
         // Need to compute the value of the contracted point, xc
         NeedToComputeContraction,
         // The algorithm has finished and found a location within tolerance
-        ReadyToStop
+        ReadyToStop,
+        // In speculative mode: need to compute the objective for every candidate in
+        // x_spec (the results go in f_x_spec)
+        NeedToComputeSpeculative
     };
 
     //! For what reason did we enter NM_Simplex_State?
@@ -89,6 +92,39 @@ namespace morph {
         //! simplex drop below this value, the algorithm will be deemed to be finished.
         T termination_threshold = T{0.0001};
 
+        /*!
+         * If true, then instead of requesting objective function values one at a time
+         * (reflection, then perhaps expansion, then perhaps contraction...), present
+         * *every* candidate that this iteration could possibly need as a batch in
+         * x_spec and enter the state NeedToComputeSpeculative. Client code computes
+         * all of the values (farming them out to threads or processes), places them in
+         * f_x_spec and calls apply_speculative(), which consumes whichever values the
+         * Nelder-Mead logic requires. Some evaluations are wasted, but for expensive
+         * objective functions with parallel hardware available, each iteration costs
+         * one batch rather than up to three serial evaluations (plus n more for a
+         * shrink). The sequence of simplexes visited is identical to the serial mode.
+         */
+        bool speculative = false;
+
+        /*!
+         * The batch of speculative candidate points, filled when state becomes
+         * NeedToComputeSpeculative. In the usual case there are n+3 entries:
+         *
+         * x_spec[0]:      the reflected point, xr
+         * x_spec[1]:      the expanded point, xe
+         * x_spec[2]:      the contracted point, xc
+         * x_spec[3..n+2]: the shrunk locations of vertices 1 to n (vertex 0 does not
+         *                 move in a shrink, so its existing value is reused)
+         *
+         * On the first iteration (from the state NeedToComputeThenOrder) it instead
+         * holds the n+1 initial vertices.
+         */
+        morph::vvec<morph::vvec<T>> x_spec;
+
+        //! The objective function values for the points in x_spec. To be filled by
+        //! client code before calling apply_speculative().
+        morph::vvec<T> f_x_spec;
+
         //! The centroid of all points except vertex n (the last one)
         morph::vvec<T> x0;
 
@@ -200,7 +236,17 @@ namespace morph {
          */
         void step()
         {
-            if (this->state == NM_Simplex_State::NeedToComputeThenOrder) {
+            if (this->speculative == true && this->state == NM_Simplex_State::NeedToComputeThenOrder) {
+                this->speculate_initial();
+            }
+            if (this->state == NM_Simplex_State::NeedToComputeSpeculative) {
+                // The whole batch is computed serially here; client code which wants
+                // parallelism computes f_x_spec itself and calls apply_speculative().
+                for (unsigned int i = 0; i < this->x_spec.size(); ++i) {
+                    this->f_x_spec[i] = this->objective (this->x_spec[i]);
+                }
+                this->apply_speculative();
+            } else if (this->state == NM_Simplex_State::NeedToComputeThenOrder) {
                 for (unsigned int i = 0; i <= this->n; ++i) {
                     this->values[i] = this->objective (this->vertices[i]);
                 }
@@ -262,10 +308,86 @@ namespace morph {
             }
 
             this->compute_x0();
-            this->reflect();
+            if (this->speculative) {
+                this->speculate();
+            } else {
+                this->reflect();
+            }
+        }
+
+        //! In speculative mode, present the initial vertices as the first batch of
+        //! candidates. Called from step(), or by client code driving the states
+        //! manually, when the state is NeedToComputeThenOrder.
+        void speculate_initial()
+        {
+            this->x_spec.resize (this->n + 1);
+            for (unsigned int i = 0; i <= this->n; ++i) { this->x_spec[i] = this->vertices[i]; }
+            this->f_x_spec.resize (this->n + 1, T{0});
+            this->spec_initial = true;
+            this->state = NM_Simplex_State::NeedToComputeSpeculative;
+        }
+
+        /*!
+         * With f_x_spec populated with the objective function values of the candidate
+         * points in x_spec, apply the Nelder-Mead logic, consuming whichever of the
+         * values it needs, and then re-order the simplex, which either stops the
+         * algorithm or proposes the next speculative batch.
+         */
+        void apply_speculative()
+        {
+            if (this->spec_initial == true) {
+                // The batch held the initial vertices; record their values and order
+                for (unsigned int i = 0; i <= this->n; ++i) { this->values[i] = this->f_x_spec[i]; }
+                this->spec_initial = false;
+                this->order();
+                return;
+            }
+
+            // The decision logic of the serial states, with every value to hand
+            this->apply_reflection (this->f_x_spec[0]);
+            if (this->state == NM_Simplex_State::NeedToComputeExpansion) {
+                this->apply_expansion (this->f_x_spec[1]);
+            } else if (this->state == NM_Simplex_State::NeedToComputeContraction) {
+                this->apply_contraction (this->f_x_spec[2]);
+                if (this->state == NM_Simplex_State::NeedToComputeThenOrder) {
+                    // The contraction failed and shrink() moved vertices 1 to n to the
+                    // locations x_spec[3..n+2], whose values are in the batch. Vertex
+                    // 0 did not move, so values[0] stands.
+                    for (unsigned int i = 1; i <= this->n; ++i) {
+                        this->values[i] = this->f_x_spec[2 + i];
+                    }
+                    this->state = NM_Simplex_State::NeedToOrder;
+                }
+            }
+            // Each branch above ends with the simplex updated and in need of ordering
+            this->order();
         }
 
     private:
+        //! Fill x_spec with every point whose objective function value *could* be
+        //! needed by this iteration of the algorithm, so that the values can be
+        //! computed as one batch. Each candidate is computed with exactly the
+        //! arithmetic of reflect()/expand()/contract()/shrink(), so consuming the
+        //! batched values visits the same simplexes as the serial states would.
+        void speculate()
+        {
+            this->reflect(); // Sets xr (and counts the operation); we'll override the state
+            unsigned int worst = this->vertex_order[this->n];
+            this->x_spec.resize (this->n + 3);
+            this->x_spec[0] = this->xr;
+            this->x_spec[1] = this->x0 + (this->xr - this->x0) * this->gamma;
+            this->x_spec[2] = this->x0 + (this->vertices[worst] - this->x0) * this->rho;
+            for (unsigned int i = 1; i <= this->n; ++i) {
+                this->x_spec[2 + i] = this->vertices[0] + (this->vertices[i] - this->vertices[0]) * this->sigma;
+            }
+            this->f_x_spec.resize (this->n + 3, T{0});
+            this->state = NM_Simplex_State::NeedToComputeSpeculative;
+        }
+
+        //! Set when the speculative batch holds the initial vertices rather than the
+        //! reflection/expansion/contraction/shrink candidates.
+        bool spec_initial = false;
+
         //! Find the reflected point, xr, which is the reflection of the worst point about the
         //! centroid of the simplex.
         void reflect()
@@ -111,6 +111,10 @@ namespace morph {
             return this->cm.convert (datum);
         }
 
+        //! Keep only every decimation-th point of each row (row ends are always
+        //! kept). 1 (the default) keeps everything. Useful for dense surface scans.
+        unsigned int decimation = 1;
+
         //! Do the computations to initialize the vertices that will represent the surface.
         void initializeVertices()
         {
@@ -122,6 +126,52 @@ namespace morph {
                 return;
             }
 
+            // Decimation works by building reduced copies of the coords/data and
+            // (temporarily) pointing the mesh build at them
+            std::vector<vec<float, 3>>* coords_in = this->dataCoords;
+            const std::vector<Flt>* data_in = this->scalarData;
+            if (this->decimation > 1) {
+                this->decimate_rows();
+                this->dataCoords = &this->decimated_coords;
+                this->scalarData = &this->decimated_data;
+            }
+
+            this->buildMesh();
+
+            this->dataCoords = coords_in;
+            this->scalarData = data_in;
+        }
+
+    protected:
+        //! Fill decimated_coords/decimated_data with every decimation-th point of
+        //! each row, always keeping the row's end point
+        void decimate_rows()
+        {
+            this->decimated_coords.clear();
+            this->decimated_data.clear();
+            const std::size_t n = this->dataCoords->size();
+            std::size_t i = 0;
+            while (i < n) {
+                const float x = (*this->dataCoords)[i][pa];
+                std::size_t j = i;
+                while (j < n && (*this->dataCoords)[j][pa] == x) { ++j; }
+                std::size_t last_kept = i;
+                for (std::size_t k = i; k < j; k += this->decimation) {
+                    this->decimated_coords.push_back ((*this->dataCoords)[k]);
+                    this->decimated_data.push_back ((*this->scalarData)[k]);
+                    last_kept = k;
+                }
+                if (last_kept != j - 1) {
+                    this->decimated_coords.push_back ((*this->dataCoords)[j - 1]);
+                    this->decimated_data.push_back ((*this->scalarData)[j - 1]);
+                }
+                i = j;
+            }
+        }
+
+        //! Build the sphere-and-tube mesh from this->dataCoords/this->scalarData
+        void buildMesh()
+        {
             std::vector<Flt> dcopy = *(this->scalarData);
             this->colourScale.do_autoscale = true;
             this->colourScale.transform (*this->scalarData, dcopy);
@@ -271,6 +321,10 @@ namespace morph {
             std::cout << "PointRowsMeshVisual has " << this->idx << " vertex indices\n";
         }
 
+        //! Reduced copies of the coords/data used when decimation > 1
+        std::vector<vec<float, 3>> decimated_coords;
+        std::vector<Flt> decimated_data;
+
     private:
         //! Which axis are we perpendicular to?
         unsigned int pa = 0U;
@@ -55,6 +55,19 @@ namespace morph {
             return this->cm.convert (datum);
         }
 
+        /*!
+         * When true, the surface is built as an indexed mesh: each point becomes ONE
+         * shared vertex (with a smooth, area-weighted normal) and the triangles
+         * reference vertices by index. The default (false) triangulation pushes each
+         * point once per triangle corner - about 6x the vertex memory on a large,
+         * regular scan.
+         */
+        bool indexed_mesh = false;
+
+        //! Keep only every decimation-th point of each row (row ends are always
+        //! kept). 1 (the default) keeps everything. Useful for dense surface scans.
+        unsigned int decimation = 1;
+
         //! Do the computations to initialize the vertices that will represent the
         //! surface.
         void initializeVertices()
@@ -67,6 +80,136 @@ namespace morph {
                 return;
             }
 
+            // Decimation works by building reduced copies of the coords/data and
+            // (temporarily) pointing the builders at them
+            std::vector<vec<float, 3>>* coords_in = this->dataCoords;
+            const std::vector<Flt>* data_in = this->scalarData;
+            if (this->decimation > 1) {
+                this->decimate_rows();
+                this->dataCoords = &this->decimated_coords;
+                this->scalarData = &this->decimated_data;
+            }
+
+            if (this->indexed_mesh == true) {
+                this->buildIndexedTriangles();
+            } else {
+                this->buildTriangles();
+            }
+
+            this->dataCoords = coords_in;
+            this->scalarData = data_in;
+        }
+
+    protected:
+        //! Fill decimated_coords/decimated_data with every decimation-th point of
+        //! each row, always keeping the row's end point
+        void decimate_rows()
+        {
+            this->decimated_coords.clear();
+            this->decimated_data.clear();
+            const std::size_t n = this->dataCoords->size();
+            std::size_t i = 0;
+            while (i < n) {
+                const float x = (*this->dataCoords)[i][pa];
+                std::size_t j = i;
+                while (j < n && (*this->dataCoords)[j][pa] == x) { ++j; }
+                std::size_t last_kept = i;
+                for (std::size_t k = i; k < j; k += this->decimation) {
+                    this->decimated_coords.push_back ((*this->dataCoords)[k]);
+                    this->decimated_data.push_back ((*this->scalarData)[k]);
+                    last_kept = k;
+                }
+                if (last_kept != j - 1) {
+                    this->decimated_coords.push_back ((*this->dataCoords)[j - 1]);
+                    this->decimated_data.push_back ((*this->scalarData)[j - 1]);
+                }
+                i = j;
+            }
+        }
+
+        /*!
+         * Build the surface as an indexed mesh: one shared vertex per point,
+         * triangles as index triples. The row-zippering (which of the two candidate
+         * next-vertices to advance to) uses the same apex-angle criterion as
+         * buildTriangles, so the triangulation is the same; only the vertex sharing
+         * and the (smooth, area-weighted) normals differ.
+         */
+        void buildIndexedTriangles()
+        {
+            std::vector<Flt> dcopy = *(this->scalarData);
+            this->colourScale.do_autoscale = true;
+            this->colourScale.transform (*this->scalarData, dcopy);
+
+            const std::size_t prlen = this->dataCoords->size();
+
+            // Find the start of each row (a row shares its pa-axis coordinate)
+            std::vector<std::size_t> row_start;
+            std::size_t i = 0;
+            while (i < prlen) {
+                row_start.push_back (i);
+                const float x = (*this->dataCoords)[i][pa];
+                while (i < prlen && (*this->dataCoords)[i][pa] == x) { ++i; }
+            }
+            row_start.push_back (prlen); // sentinel
+
+            // One vertex per point
+            const unsigned int base = this->idx;
+            for (std::size_t p = 0; p < prlen; ++p) {
+                this->vertex_push ((*this->dataCoords)[p], this->vertexPositions);
+                this->vertex_push (this->cm.convert (dcopy[p]), this->vertexColors);
+            }
+            std::vector<morph::vec<float>> vnorms (prlen, morph::vec<float>{ 0.0f, 0.0f, 0.0f });
+
+            auto pos = [this] (std::size_t q) { return (*this->dataCoords)[q]; };
+
+            for (std::size_t r = 0; r + 2 < row_start.size(); ++r) {
+                std::size_t a = row_start[r];
+                const std::size_t a_e = row_start[r + 1] - 1;
+                std::size_t b = row_start[r + 1];
+                const std::size_t b_e = row_start[r + 2] - 1;
+                while (a < a_e || b < b_e) {
+                    const std::size_t q1 = a;
+                    const std::size_t q2 = b;
+                    bool advance_a = false;
+                    if (a >= a_e) {
+                        advance_a = false;
+                    } else if (b >= b_e) {
+                        advance_a = true;
+                    } else {
+                        // The apex-angle criterion from buildTriangles
+                        const float asq = MathAlgo::distance_sq<float, 3> (pos (q1), pos (q2));
+                        float bsq = MathAlgo::distance_sq<float, 3> (pos (q2), pos (a + 1));
+                        float csq = MathAlgo::distance_sq<float, 3> (pos (q1), pos (a + 1));
+                        const float alpha1 = std::acos ((bsq + csq - asq) / (2.0f * std::sqrt (bsq) * std::sqrt (csq)));
+                        bsq = MathAlgo::distance_sq<float, 3> (pos (q2), pos (b + 1));
+                        csq = MathAlgo::distance_sq<float, 3> (pos (q1), pos (b + 1));
+                        const float alpha2 = std::acos ((bsq + csq - asq) / (2.0f * std::sqrt (bsq) * std::sqrt (csq)));
+                        advance_a = (alpha2 < alpha1);
+                    }
+                    const std::size_t qn = advance_a ? ++a : ++b;
+                    this->indices.push_back (base + static_cast<unsigned int>(q1));
+                    this->indices.push_back (base + static_cast<unsigned int>(q2));
+                    this->indices.push_back (base + static_cast<unsigned int>(qn));
+                    // Accumulate the (area-weighted, so un-normalized) face normal
+                    morph::vec<float> plane1 = pos (q1) - pos (qn);
+                    morph::vec<float> plane2 = pos (q2) - pos (qn);
+                    const morph::vec<float> fnorm = plane2.cross (plane1);
+                    vnorms[q1] += fnorm;
+                    vnorms[q2] += fnorm;
+                    vnorms[qn] += fnorm;
+                }
+            }
+
+            for (auto& vn : vnorms) {
+                if (vn.length() > 0.0f) { vn.renormalize(); } else { vn = { 0.0f, 0.0f, 1.0f }; }
+                this->vertex_push (vn, this->vertexNormals);
+            }
+            this->idx += static_cast<unsigned int>(prlen);
+        }
+
+        //! The original, non-indexed surface build (a vertex per triangle corner)
+        void buildTriangles()
+        {
             std::vector<Flt> dcopy = *(this->scalarData);
             this->colourScale.do_autoscale = true;
             this->colourScale.transform (*this->scalarData, dcopy);
@@ -294,6 +437,10 @@ namespace morph {
             }
         }
 
+        //! Reduced copies of the coords/data used when decimation > 1
+        std::vector<vec<float, 3>> decimated_coords;
+        std::vector<Flt> decimated_data;
+
     private:
         //! Which axis are we perpendicular to?
         unsigned int pa = 0U;
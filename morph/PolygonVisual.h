@@ -4,10 +4,16 @@
 #include <morph/VisualModel.h>
 #include <morph/mathconst.h>
 #include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
 
 namespace morph {
 
-    //! This class creates the vertices for a polygonal object in a 3D scene
+    //! This class creates the vertices for a polygonal object in a 3D scene. It can
+    //! hold either a single polygon (the original behaviour) or, via addPolygon, many
+    //! polygons tessellated into one shared buffer - one VisualModel and one draw call
+    //! for (e.g.) 10000 map regions, rather than 10000 models.
     template<int glver = morph::gl::version_4_1>
     class PolygonVisual : public VisualModel<glver>
     {
@@ -39,6 +45,52 @@ namespace morph {
             this->n = _n;
         }
 
+        //! The specification of one polygon in the batched, multi-polygon mode
+        struct polyspec
+        {
+            vec<float, 3> position = { 0.0f, 0.0f, 0.0f };
+            vec<float, 3> vertex = { 1.0f, 0.0f, 0.0f };
+            float radius = 1.0f;
+            float thickness = 0.01f;
+            std::array<float, 3> col = { 1.0f, 0.0f, 0.0f };
+            int n = 4;
+        };
+
+        //! Append a polygon to the batch, switching this model into multi-polygon
+        //! mode (the single-polygon members position/vertex/etc are then ignored).
+        //! Returns the polygon's index, for use with setPolygonColour. Call
+        //! finalize()/reinit() after adding polygons.
+        std::size_t addPolygon (const vec<float, 3>& _position, const vec<float, 3>& _vertex,
+                                const float _radius, const float _thickness,
+                                const std::array<float, 3>& _col, const int _n)
+        {
+            this->polygons.push_back (polyspec{ _position, _vertex, _radius, _thickness, _col, _n });
+            return this->polygons.size() - 1u;
+        }
+
+        //! The number of polygons in the batch (0 means single-polygon mode)
+        std::size_t polygonCount() const { return this->polygons.size(); }
+
+        //! Re-colour the polygon with index i. This rewrites the polygon's range of
+        //! the shared colour buffer and re-uploads only that buffer, so it is cheap
+        //! enough to call per-polygon, per-frame (no re-tessellation occurs).
+        void setPolygonColour (const std::size_t i, const std::array<float, 3>& _col)
+        {
+            if (i >= this->polygons.size()) {
+                throw std::runtime_error ("PolygonVisual::setPolygonColour: polygon index out of range");
+            }
+            this->polygons[i].col = _col;
+            if (this->poly_col_start.size() <= i) { return; } // model doesn't exist yet
+            const std::size_t c_start = this->poly_col_start[i];
+            const std::size_t c_end = (i + 1u < this->poly_col_start.size()) ? this->poly_col_start[i + 1u] : this->vertexColors.size();
+            for (std::size_t c = c_start; c < c_end; c += 3u) {
+                this->vertexColors[c] = _col[0];
+                this->vertexColors[c + 1u] = _col[1];
+                this->vertexColors[c + 2u] = _col[2];
+            }
+            this->reinit_colour_buffer();
+        }
+
         //! Initialize vertex buffer objects and vertex array object.
         void initializeVertices()
         {
@@ -48,15 +100,30 @@ namespace morph {
             this->indices.clear();
             this->idx = 0;
 
-            // Always draw a full 3D polygon
-            morph::vec<float> pend = this->position;
-            pend[2] += this->thickness;
-            // Figure out ux, uy from position and vertex. Let ux be like dirn to vertex
-            this->_ux = this->vertex - this->position;
-            this->_uy = this->_ux.cross(this->uz);
-            this->computeTube (this->position, pend, this->_ux, this->_uy,
-                               this->col, this->col,
-                               this->radius, this->n);
+            if (this->polygons.empty()) {
+                // Always draw a full 3D polygon
+                morph::vec<float> pend = this->position;
+                pend[2] += this->thickness;
+                // Figure out ux, uy from position and vertex. Let ux be like dirn to vertex
+                this->_ux = this->vertex - this->position;
+                this->_uy = this->_ux.cross(this->uz);
+                this->computeTube (this->position, pend, this->_ux, this->_uy,
+                                   this->col, this->col,
+                                   this->radius, this->n);
+            } else {
+                // Multi-polygon mode: tessellate every polygon into the shared
+                // buffers, recording where each one's colour vertices start
+                this->poly_col_start.clear();
+                this->poly_col_start.reserve (this->polygons.size());
+                for (const polyspec& ps : this->polygons) {
+                    this->poly_col_start.push_back (this->vertexColors.size());
+                    morph::vec<float> pend = ps.position;
+                    pend[2] += ps.thickness;
+                    morph::vec<float> pux = ps.vertex - ps.position;
+                    morph::vec<float> puy = pux.cross (this->uz);
+                    this->computeTube (ps.position, pend, pux, puy, ps.col, ps.col, ps.radius, ps.n);
+                }
+            }
         }
 
         //! The position of the start of the rod, given with respect to the parent's offset
@@ -76,6 +143,12 @@ namespace morph {
 
         //! The colour of the thing.
         std::array<float, 3> col = {1.0f, 0.0f, 0.0f};
+
+    protected:
+        //! The polygon batch. If this is non-empty, the model is in multi-polygon mode.
+        std::vector<polyspec> polygons;
+        //! Index into vertexColors of each polygon's first colour component
+        std::vector<std::size_t> poly_col_start;
     };
 
 } // namespace morph
@@ -0,0 +1,204 @@
+/*!
+ * \file
+ *
+ * A GPU-expanded polyline. Visual models which draw thick lines (GraphVisual and
+ * friends) tessellate each segment into quads on the CPU, so a multi-million-point
+ * line means an enormous vertex buffer which is rebuilt on every re-scale.
+ * PolylineVisual instead uploads the bare polyline points (one vertex per point) and
+ * expands each segment to a screen-space-width, mitred ribbon in a geometry shader.
+ * The buffer is about 6x smaller, and changing the line width is a uniform update
+ * rather than a re-tessellation.
+ *
+ * Note: this class makes direct (global alias) OpenGL calls, like the morph::gl
+ * compute subsystem, so use it with morph::VisualNoMX (not the multicontext
+ * morph::Visual). Geometry shaders need OpenGL 3.2 or newer (and are absent from
+ * OpenGL ES before 3.2).
+ *
+ * \author Seb James
+ * \date August 2026
+ */
+#pragma once
+
+#include <morph/gl/version.h>
+#include <morph/gl/shaders.h>
+#include <morph/gl/loadshaders_nomx.h>
+#include <morph/VisualDataModel.h>
+#include <morph/VisualDefaultShaders.h>
+#include <morph/vec.h>
+#include <iostream>
+#include <vector>
+#include <array>
+#include <string>
+
+namespace morph {
+
+    //! A screen-space-width polyline through the dataCoords, coloured by the
+    //! scalarData (if any) via the colour map. Flt is the type of the data.
+    template <typename Flt, int glver = morph::gl::version_4_1>
+    class PolylineVisual : public VisualDataModel<Flt, glver>
+    {
+    public:
+        PolylineVisual (const vec<float> _offset)
+        {
+            this->mv_offset = _offset;
+            this->viewmatrix.translate (this->mv_offset);
+            this->zScale.setParams (1, 0);
+            this->colourScale.do_autoscale = true;
+        }
+
+        ~PolylineVisual()
+        {
+            if (this->line_prog != 0) { glDeleteProgram (this->line_prog); }
+        }
+
+        //! Fill the standard vertex buffers with ONE vertex per polyline point (the
+        //! geometry shader does the widening). The first and last points are
+        //! duplicated as the adjacency sentinels which GL_LINE_STRIP_ADJACENCY needs.
+        void initializeVertices()
+        {
+            unsigned int ncoords = this->dataCoords == nullptr ? 0 : this->dataCoords->size();
+            if (ncoords < 2) { return; }
+            unsigned int ndata = this->scalarData == nullptr ? 0 : this->scalarData->size();
+
+            if (ndata > 0 && ncoords != ndata) {
+                std::cout << "PolylineVisual Error: ncoords ("<<ncoords<<") != ndata ("<<ndata<<"), return (no model)." << std::endl;
+                return;
+            }
+
+            std::vector<Flt> dcopy;
+            if (ndata) {
+                dcopy = *(this->scalarData);
+                this->colourScale.do_autoscale = true;
+                this->colourScale.transform (*this->scalarData, dcopy);
+            }
+
+            morph::vec<float> norml = { 0.0f, 0.0f, 1.0f };
+            for (unsigned int i = 0; i < ncoords; ++i) {
+                std::array<float, 3> clr = ndata ? this->cm.convert (dcopy[i]) : this->colour;
+                // Duplicate the endpoints as adjacency sentinels
+                unsigned int reps = (i == 0 || i + 1 == ncoords) ? 2u : 1u;
+                for (unsigned int r = 0; r < reps; ++r) {
+                    this->vertex_push ((*this->dataCoords)[i], this->vertexPositions);
+                    this->vertex_push (norml, this->vertexNormals);
+                    this->vertex_push (clr, this->vertexColors);
+                }
+            }
+            this->n_points = ncoords + 2u;
+        }
+
+        //! Render with the polyline shader program, which is created lazily here, as
+        //! render() is the call that is guaranteed a current OpenGL context.
+        void render()
+        {
+            if (this->hide == true) { return; }
+
+            if (this->postVertexInitRequired == true) { this->postVertexInit(); }
+            if (this->line_prog == 0) { this->init_gl_objects(); }
+            if (this->n_points < 4) { return; }
+
+            GLint prev_shader = 0;
+            glGetIntegerv (GL_CURRENT_PROGRAM, &prev_shader);
+
+            // The projection matrix and the lighting uniforms are owned by the parent
+            // Visual, which sets them on the scene's graphics program; copy them over.
+            GLuint gprog = this->get_gprog (this->parentVis);
+            glUseProgram (this->line_prog);
+            this->copy_uniform_mat4 (gprog, "p_matrix");
+            this->copy_uniform_3f (gprog, "light_colour");
+            this->copy_uniform_1f (gprog, "ambient_intensity");
+            this->copy_uniform_3f (gprog, "diffuse_position");
+            this->copy_uniform_1f (gprog, "diffuse_intensity");
+
+            GLint loc_v = glGetUniformLocation (this->line_prog, static_cast<const GLchar*>("v_matrix"));
+            if (loc_v != -1) { glUniformMatrix4fv (loc_v, 1, GL_FALSE, this->scenematrix.mat.data()); }
+            GLint loc_m = glGetUniformLocation (this->line_prog, static_cast<const GLchar*>("m_matrix"));
+            if (loc_m != -1) { glUniformMatrix4fv (loc_m, 1, GL_FALSE, (this->model_scaling * this->viewmatrix).mat.data()); }
+            GLint loc_a = glGetUniformLocation (this->line_prog, static_cast<const GLchar*>("alpha"));
+            if (loc_a != -1) { glUniform1f (loc_a, this->alpha); }
+
+            // The geometry shader works in pixels, so it needs the viewport size and
+            // the line width as uniforms. Changing thickness_px costs nothing more
+            // than this.
+            GLint vp[4] = { 0, 0, 1, 1 };
+            glGetIntegerv (GL_VIEWPORT, vp);
+            GLint loc_vp = glGetUniformLocation (this->line_prog, static_cast<const GLchar*>("viewport_size"));
+            if (loc_vp != -1) { glUniform2f (loc_vp, static_cast<float>(vp[2]), static_cast<float>(vp[3])); }
+            GLint loc_lw = glGetUniformLocation (this->line_prog, static_cast<const GLchar*>("linewidth"));
+            if (loc_lw != -1) { glUniform1f (loc_lw, this->thickness_px); }
+
+            glBindVertexArray (this->vao);
+            glDrawArrays (GL_LINE_STRIP_ADJACENCY, 0, static_cast<GLsizei>(this->n_points));
+            glBindVertexArray (0);
+
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+
+            // Now render any VisualTextModels
+            auto ti = this->texts.begin();
+            while (ti != this->texts.end()) { (*ti)->render(); ti++; }
+
+            glUseProgram (prev_shader);
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+        }
+
+        //! Set the line width in pixels. No reinit needed; it's a render-time uniform.
+        void setThickness (const float thick_px) { this->thickness_px = thick_px; }
+
+        //! The line width, in screen pixels
+        float thickness_px = 2.0f;
+
+        //! The line colour, used when there is no scalarData to colour-map
+        std::array<float, 3> colour = { 0.0f, 0.0f, 0.0f };
+
+    protected:
+        //! Compile and link the polyline shader program. Requires a current OpenGL
+        //! context.
+        void init_gl_objects()
+        {
+            std::vector<morph::gl::ShaderInfo> shaders = {
+                {GL_VERTEX_SHADER, "PolylineVisual.vert.glsl", morph::getPolylineVtxShader (glver), 0 },
+                {GL_GEOMETRY_SHADER, "PolylineVisual.geom.glsl", morph::getPolylineGeomShader (glver), 0 },
+                {GL_FRAGMENT_SHADER, "PolylineVisual.frag.glsl", morph::getDefaultFragShader (glver), 0 }
+            };
+            this->line_prog = morph::gl::LoadShaders (shaders);
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+        }
+
+        //! Read a mat4 uniform's value from program \a src_prog and set it on
+        //! line_prog (which must be in use)
+        void copy_uniform_mat4 (GLuint src_prog, const char* name)
+        {
+            GLint sloc = glGetUniformLocation (src_prog, static_cast<const GLchar*>(name));
+            GLint dloc = glGetUniformLocation (this->line_prog, static_cast<const GLchar*>(name));
+            if (sloc == -1 || dloc == -1) { return; }
+            std::array<float, 16> val;
+            glGetUniformfv (src_prog, sloc, val.data());
+            glUniformMatrix4fv (dloc, 1, GL_FALSE, val.data());
+        }
+        //! Copy a vec3 uniform from \a src_prog to line_prog
+        void copy_uniform_3f (GLuint src_prog, const char* name)
+        {
+            GLint sloc = glGetUniformLocation (src_prog, static_cast<const GLchar*>(name));
+            GLint dloc = glGetUniformLocation (this->line_prog, static_cast<const GLchar*>(name));
+            if (sloc == -1 || dloc == -1) { return; }
+            std::array<float, 3> val;
+            glGetUniformfv (src_prog, sloc, val.data());
+            glUniform3f (dloc, val[0], val[1], val[2]);
+        }
+        //! Copy a float uniform from \a src_prog to line_prog
+        void copy_uniform_1f (GLuint src_prog, const char* name)
+        {
+            GLint sloc = glGetUniformLocation (src_prog, static_cast<const GLchar*>(name));
+            GLint dloc = glGetUniformLocation (this->line_prog, static_cast<const GLchar*>(name));
+            if (sloc == -1 || dloc == -1) { return; }
+            float val = 0.0f;
+            glGetUniformfv (src_prog, sloc, &val);
+            glUniform1f (dloc, val);
+        }
+
+        //! How many vertices are in the buffers (polyline points plus 2 sentinels)
+        unsigned int n_points = 0;
+        //! Our shader program, which widens the polyline on the GPU
+        GLuint line_prog = 0;
+    };
+
+} // namespace morph
@@ -17,14 +17,19 @@
 #include <string>
 #include <fstream>
 #include <cstdlib>
+#include <cstddef>
 #include <iostream>
 extern "C" {
 #include <unistd.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <sys/stat.h>
 #include <sys/poll.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
 #include <signal.h>
 }
 
@@ -69,6 +74,14 @@ namespace morph {
         virtual void processFinishedSignal (std::string) {}
         virtual void readyReadStandardOutputSignal() {}
         virtual void readyReadStandardErrorSignal() {}
+        /*!
+         * Called by the bulk reading path (Process::drainPipes) with each chunk of
+         * stdout/stderr as it is read from the pipe - a pointer into Process's read
+         * buffer and the chunk's length, valid only for the duration of the call, so
+         * nothing is copied on the way to the client. See Process::enableBulkReads.
+         */
+        virtual void stdoutChunkSignal (const char*, const std::size_t) {}
+        virtual void stderrChunkSignal (const char*, const std::size_t) {}
     };
 
     /*!
@@ -120,6 +133,10 @@ namespace morph {
         //! Close any open file descriptors.
         void closeAllFileDescriptors()
         {
+            if (this->epfd > -1) {
+                close (this->epfd);
+                this->epfd = -1;
+            }
             if (this->parentToChild[PROCESS_WRITING_END] > 0) {
                 if constexpr (dbg) { std::cout << "close parentToChild[PROCESS_WRITING_END]...\n"; }
                 if (close (this->parentToChild[PROCESS_WRITING_END])) {
@@ -196,6 +213,8 @@ namespace morph {
             this->error = PROCESSNOERROR;
             this->progName = "unknown";
             this->environment.clear();
+            this->outBuffer.clear();
+            this->errBuffer.clear();
             // Ensure all file descriptors are closed.
             this->closeAllFileDescriptors();
             return true;
@@ -429,6 +448,112 @@ namespace morph {
             }
         }
 
+#ifdef __linux__
+        /*!
+         * Switch this process's stdout/stderr pipes to buffered bulk reading. Call once,
+         * after Process::start(). The pipe read ends are made non-blocking and
+         * registered, edge-triggered, with an epoll instance; thereafter call
+         * drainPipes() (instead of, or as well as, probeProcess()) to move the pipe
+         * contents in chunk_sz chunks into the output buffers - or straight to the
+         * chunk callbacks. Returns false (and sets the error) if the epoll instance
+         * could not be set up.
+         */
+        bool enableBulkReads()
+        {
+            if (this->epfd > -1) { return true; } // already enabled
+            if (this->pid == 0) { return false; } // not started; no pipes to register yet
+            this->epfd = epoll_create1 (0);
+            if (this->epfd == -1) {
+                this->error = PROCESSREADERR;
+                return false;
+            }
+            // Edge-triggered notification requires non-blocking reads: the drain loop
+            // must read until EAGAIN or events can be lost.
+            for (int fd : { this->childToParent[PROCESS_READING_END], this->childErrToParent[PROCESS_READING_END] }) {
+                fcntl (fd, F_SETFL, fcntl (fd, F_GETFL, 0) | O_NONBLOCK);
+                struct epoll_event ev;
+                // Cast out of the EPOLL_EVENTS enum type, else morph::operator| (flags.h)
+                // captures the enum operands and yields a morph::flags
+                ev.events = static_cast<uint32_t>(EPOLLIN) | static_cast<uint32_t>(EPOLLET);
+                ev.data.fd = fd;
+                if (epoll_ctl (this->epfd, EPOLL_CTL_ADD, fd, &ev) == -1) {
+                    this->error = PROCESSREADERR;
+                    close (this->epfd);
+                    this->epfd = -1;
+                    return false;
+                }
+            }
+            this->chunkbuf.resize (chunk_sz);
+            return true;
+        }
+
+        /*!
+         * Wait up to \a timeout_ms milliseconds (0: return immediately; -1: block until
+         * data) for stdout/stderr data, then drain the pipes in chunk_sz chunks. Each
+         * chunk is handed, zero-copy, to the stdoutChunkSignal/stderrChunkSignal
+         * callbacks; unless bufferBulkOutput has been set false it is also appended to
+         * the buffer that readAllStandardOutput/readAllStandardError return. Returns
+         * the number of bytes drained. Requires a prior enableBulkReads().
+         */
+        std::size_t drainPipes (const int timeout_ms = 0)
+        {
+            if (this->epfd == -1) { return 0u; }
+            std::size_t drained = 0u;
+            struct epoll_event evs[2];
+            int nev = epoll_wait (this->epfd, evs, 2, timeout_ms);
+            for (int e = 0; e < nev; ++e) {
+                bool is_stdout = (evs[e].data.fd == this->childToParent[PROCESS_READING_END]);
+                std::string& buf = is_stdout ? this->outBuffer : this->errBuffer;
+                bool got_data = false;
+                // Edge-triggered, so read until the pipe is dry (EAGAIN) or closed
+                for (;;) {
+                    ssize_t n = read (evs[e].data.fd, this->chunkbuf.data(), chunk_sz);
+                    if (n > 0) {
+                        got_data = true;
+                        drained += static_cast<std::size_t>(n);
+                        if (this->callbacks != nullptr) {
+                            if (is_stdout) {
+                                this->callbacks->stdoutChunkSignal (this->chunkbuf.data(), static_cast<std::size_t>(n));
+                            } else {
+                                this->callbacks->stderrChunkSignal (this->chunkbuf.data(), static_cast<std::size_t>(n));
+                            }
+                        }
+                        if (this->bufferBulkOutput == true) { buf.append (this->chunkbuf.data(), static_cast<std::size_t>(n)); }
+                        if (n < static_cast<ssize_t>(chunk_sz)) { break; } // short read; pipe is dry
+                    } else if (n == 0) {
+                        // End of file - the child has closed this pipe; stop monitoring it
+                        epoll_ctl (this->epfd, EPOLL_CTL_DEL, evs[e].data.fd, nullptr);
+                        break;
+                    } else {
+                        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                            this->error = PROCESSREADERR;
+                        }
+                        break;
+                    }
+                }
+                if (got_data == true && this->callbacks != nullptr) {
+                    if (is_stdout) {
+                        this->callbacks->readyReadStandardOutputSignal();
+                    } else {
+                        this->callbacks->readyReadStandardErrorSignal();
+                    }
+                }
+            }
+            return drained;
+        }
+
+        /*!
+         * If false, drainPipes hands chunks to the chunk callbacks only, and nothing
+         * accumulates in memory - for clients that consume output entirely in their
+         * ProcessCallbacks::stdoutChunkSignal override. Default true: chunks also
+         * collect in a buffer for readAllStandardOutput/readAllStandardError.
+         */
+        bool bufferBulkOutput = true;
+
+        //! The bulk read chunk size (and the read granularity of drainPipes)
+        static constexpr std::size_t chunk_sz = 65536u;
+#endif // __linux__
+
         //! If the process is running - if pid > 0, return true. Otherwise return false.
         bool running() const { return this->pid > 0 ? true : false; }
 
@@ -447,6 +572,8 @@ namespace morph {
         {
             if constexpr (dbg) { std::cout << "Called\n"; }
             std::string s;
+            // Take anything the bulk reading path (drainPipes) has buffered first
+            if (this->outBuffer.empty() == false) { s.swap (this->outBuffer); }
             int bytes = 0;
             char c;
             struct pollfd p;
@@ -470,6 +597,8 @@ namespace morph {
         std::string readAllStandardError() const
         {
             std::string s;
+            // Take anything the bulk reading path (drainPipes) has buffered first
+            if (this->errBuffer.empty() == false) { s.swap (this->errBuffer); }
             int bytes = 0;
             char c;
             struct pollfd p;
@@ -566,6 +695,19 @@ namespace morph {
         //! Used in the poll() call in probeProcess()
         struct pollfd * p;
 
+        //! The epoll instance for bulk reads; -1 until enableBulkReads() is called
+        int epfd = -1;
+        //! The chunk_sz read buffer for drainPipes - chunk callbacks point into this
+        std::vector<char> chunkbuf;
+        /*!
+         * Output accumulated by drainPipes, awaiting readAllStandardOutput (which
+         * swaps it out, so the accumulation never memmoves). mutable because
+         * readAllStandardOutput() has always been const.
+         */
+        mutable std::string outBuffer;
+        //! As outBuffer, for stderr
+        mutable std::string errBuffer;
+
         //! Pointer to a callback object
         ProcessCallbacks * callbacks;
     };
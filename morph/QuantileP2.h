@@ -0,0 +1,135 @@
+/*!
+ * \file
+ *
+ * \brief A streaming quantile estimator using the P2 algorithm
+ *
+ * morph::QuantileP2 estimates a chosen quantile of a stream of values in O(1) memory and
+ * O(1) time per value, using the P2 algorithm of Jain & Chlamtac (1985): five markers
+ * track the minimum, the maximum, the target quantile and the two quantiles halfway to
+ * each extreme, and their heights are adjusted with piecewise-parabolic interpolation as
+ * observations arrive. Use it where the data can't (or shouldn't) be stored - for
+ * example deciding robust axis limits while appending to a graph - and
+ * morph::MathAlgo::quantile where it can.
+ *
+ * \author Seb James
+ * \date August 2026
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+
+namespace morph {
+
+    //! Streaming estimator of the \a p quantile of a sequence of values of type T
+    //! (floating point), by the P2 algorithm. Feed values with update(); read the
+    //! estimate with get().
+    template <typename T = float>
+    struct QuantileP2
+    {
+        //! Construct an estimator for the \a _p quantile, 0 < _p < 1
+        QuantileP2 (const double _p) : p(_p)
+        {
+            if (_p <= 0.0 || _p >= 1.0) {
+                throw std::runtime_error ("QuantileP2: p must be in (0,1)");
+            }
+            this->npos = { 0.0, 2.0 * _p, 4.0 * _p, 2.0 + 2.0 * _p, 4.0 };
+            this->dnpos = { 0.0, _p / 2.0, _p, (1.0 + _p) / 2.0, 1.0 };
+        }
+
+        //! Incorporate one observation
+        void update (const T x)
+        {
+            if (this->n_obs < 5u) {
+                // The first five observations initialize the marker heights
+                this->q[this->n_obs++] = x;
+                if (this->n_obs == 5u) { std::sort (this->q.begin(), this->q.end()); }
+                return;
+            }
+
+            // Find the cell k holding x, updating the extreme markers
+            std::size_t k = 0;
+            if (x < this->q[0]) {
+                this->q[0] = x;
+                k = 0;
+            } else if (x >= this->q[4]) {
+                this->q[4] = x;
+                k = 3;
+            } else {
+                while (k < 3 && x >= this->q[k + 1]) { ++k; }
+            }
+
+            // Markers above the cell shift up; all desired positions advance
+            for (std::size_t i = k + 1; i < 5u; ++i) { this->pos[i] += 1.0; }
+            for (std::size_t i = 0; i < 5u; ++i) { this->npos[i] += this->dnpos[i]; }
+
+            // Adjust the three interior markers towards their desired positions
+            for (std::size_t i = 1; i < 4u; ++i) {
+                const double d = this->npos[i] - this->pos[i];
+                if ((d >= 1.0 && this->pos[i + 1] - this->pos[i] > 1.0)
+                    || (d <= -1.0 && this->pos[i - 1] - this->pos[i] < -1.0)) {
+                    const double s = d < 0.0 ? -1.0 : 1.0;
+                    // Piecewise-parabolic estimate of the new height
+                    double qn = this->parabolic (i, s);
+                    if (qn <= this->q[i - 1] || qn >= this->q[i + 1]) {
+                        // Parabola left the bracket; fall back to linear
+                        const std::size_t j = s > 0.0 ? i + 1 : i - 1;
+                        qn = static_cast<double>(this->q[i])
+                            + s * (static_cast<double>(this->q[j]) - static_cast<double>(this->q[i]))
+                            / (this->pos[j] - this->pos[i]);
+                    }
+                    this->q[i] = static_cast<T>(qn);
+                    this->pos[i] += s;
+                }
+            }
+            ++this->n_obs;
+        }
+
+        //! \return the current estimate of the quantile. Until five observations have
+        //! arrived, this is the exact quantile of those seen (by nearest rank).
+        T get() const
+        {
+            if (this->n_obs == 0u) { throw std::runtime_error ("QuantileP2: no observations"); }
+            if (this->n_obs < 5u) {
+                std::array<T, 5> qs = this->q;
+                std::sort (qs.begin(), qs.begin() + this->n_obs);
+                std::size_t i = static_cast<std::size_t>(this->p * static_cast<double>(this->n_obs));
+                return qs[i < this->n_obs ? i : this->n_obs - 1];
+            }
+            return this->q[2];
+        }
+
+        //! \return the number of observations incorporated so far
+        std::size_t count() const { return this->n_obs; }
+
+    private:
+        //! The piecewise-parabolic (P2) height update for marker \a i moving in
+        //! direction \a s
+        double parabolic (const std::size_t i, const double s) const
+        {
+            const double qim1 = static_cast<double>(this->q[i - 1]);
+            const double qi = static_cast<double>(this->q[i]);
+            const double qip1 = static_cast<double>(this->q[i + 1]);
+            return qi + (s / (this->pos[i + 1] - this->pos[i - 1]))
+                * ((this->pos[i] - this->pos[i - 1] + s) * (qip1 - qi) / (this->pos[i + 1] - this->pos[i])
+                   + (this->pos[i + 1] - this->pos[i] - s) * (qi - qim1) / (this->pos[i] - this->pos[i - 1]));
+        }
+
+        //! The quantile being estimated
+        double p;
+        //! Marker heights: min, (0+p)/2, p, (p+1)/2, max quantile estimates
+        std::array<T, 5> q = {};
+        //! Actual marker positions (0-based observation counts)
+        std::array<double, 5> pos = { 0.0, 1.0, 2.0, 3.0, 4.0 };
+        //! Desired marker positions
+        std::array<double, 5> npos = {};
+        //! Increment of each desired position per observation
+        std::array<double, 5> dnpos = {};
+        //! Number of observations so far
+        std::size_t n_obs = 0u;
+    };
+
+} // namespace morph
@@ -6,6 +6,7 @@
 #include <morph/scale.h>
 #include <morph/vec.h>
 #include <morph/vvec.h>
+#include <morph/range.h>
 #include <morph/colour.h>
 #include <morph/graphstyles.h>
 #include <iostream>
@@ -107,14 +108,21 @@ namespace morph {
             vec<Flt> vectorData_i, halfquiv;
             vec<float> start, end, coords_i;
             std::array<float, 3> clr;
+            this->datum_colour_extents.clear();
+            this->datum_colour_extents.reserve (ncoords);
             for (unsigned int i = 0; i < ncoords; ++i) {
 
                 coords_i = (*this->dataCoords)[i];
+                // Record which colour vertices belong to this datum, for updateColours
+                unsigned int c_start = static_cast<unsigned int>(this->vertexColors.size() / 3u);
 
                 float len = nrmlzedlengths[i] * this->quiver_length_gain;
                 if ((std::isnan(dlengths[i]) || dlengths[i] == Flt{0}) && this->show_zero_vectors) {
                     // NaNs denote zero vectors when the lengths have been log scaled.
                     this->computeSphere (coords_i, zero_vector_colour, this->zero_vector_marker_size * quiver_thickness_gain);
+                    // The zero-vector marker keeps its fixed colour; record an empty range
+                    unsigned int c_zero = static_cast<unsigned int>(this->vertexColors.size() / 3u);
+                    this->datum_colour_extents.push_back ({ c_zero, c_zero });
                     continue;
                 }
 
@@ -154,7 +162,40 @@ namespace morph {
                     // Draw a sphere on the coordinate:
                     this->computeSphere (coords_i, clr, quiv_thick*2.0f, shapesides/2, shapesides);
                 }
+
+                this->datum_colour_extents.push_back ({ c_start, static_cast<unsigned int>(this->vertexColors.size() / 3u) });
+            }
+        }
+
+        /*!
+         * Rewrite just the quiver colours from new scalar data, leaving the arrow geometry
+         * untouched. The arrows' geometry depends only on the coordinates and vectorData, so
+         * when colours are driven by scalarData this is much cheaper than a full updateData.
+         * Falls back to a full reinit when the data size does not match the recorded geometry.
+         */
+        void updateColours (const std::vector<Flt>* _data) override
+        {
+            this->scalarData = _data;
+            unsigned int ncoords = this->dataCoords == nullptr ? 0 : this->dataCoords->size();
+            if (ncoords == 0 || this->scalarData == nullptr || this->scalarData->size() != ncoords
+                || this->datum_colour_extents.size() != ncoords) {
+                this->reinit();
+                return;
             }
+            vvec<Flt> sdata (ncoords);
+            std::copy (this->scalarData->begin(), this->scalarData->end(), sdata.begin());
+            vvec<Flt> scolours (ncoords);
+            if (this->colourScale.do_autoscale == true) { this->colourScale.reset(); }
+            this->colourScale.transform (sdata, scolours);
+            for (unsigned int i = 0; i < ncoords; ++i) {
+                std::array<float, 3> clr = this->cm.convert (scolours[i]);
+                for (unsigned int v = this->datum_colour_extents[i].min; v < this->datum_colour_extents[i].max; ++v) {
+                    this->vertexColors[3u * v] = clr[0];
+                    this->vertexColors[3u * v + 1u] = clr[1];
+                    this->vertexColors[3u * v + 2u] = clr[2];
+                }
+            }
+            this->reinit_colour_buffer();
         }
 
         //! An enumerated type to say whether we draw quivers with coord at mid point; start point or end point
@@ -202,6 +243,13 @@ namespace morph {
         // Set this false to avoid applying length_scale to quiver lengths and also and
         // colourScale (in the absence of ScalarData).
         bool do_quiver_length_scaling = true;
+
+    protected:
+        //! For each datum, the range of colour vertices ([min, max), as indices into
+        //! vertexColors/3) that its arrow occupies. Recorded by initializeVertices so that
+        //! updateColours can rewrite colours without re-tessellating. Zero-vector markers
+        //! keep their fixed colour and record an empty range.
+        std::vector<morph::range<unsigned int>> datum_colour_extents;
     };
 
 } // namespace morph
@@ -12,10 +12,14 @@
 #include <list>
 #include <vector>
 #include <map>
+#include <utility>
+#include <exception>
+#include <cstdint>
 #include <rapidxml/rapidxml.hpp>
 #include <morph/BezCurvePath.h>
 #include <morph/AllocAndRead.h>
 #include <morph/tools.h>
+#include <morph/snapshot.h>
 
 namespace morph
 {
@@ -68,6 +72,45 @@ namespace morph
             } // else DID get cortex ID
         }
 
+        /*!
+         * Construct using the SVG file at svgpath, with a parsed-boundary cache. The
+         * parsed curves (and, if \a cache_point_step > 0, the point sets sampled at
+         * that step) are serialized to a small binary file next to the SVG
+         * (svgpath + ".curves.bin", morph::snapshot format) keyed by a CRC-32C of the
+         * SVG's bytes. On subsequent construction, if the cache exists and the SVG is
+         * unchanged, the curves are loaded from the memory-mapped cache instead of
+         * re-parsing the XML - microseconds instead of seconds, which matters when
+         * thousands of sweep jobs each read the same boundary. A stale, corrupt or
+         * unwritable cache simply falls back to parsing. Note that the scale-bar line
+         * path itself is not cached; only its effect (lineToMillimetres and the scaling
+         * already applied to the paths and circles).
+         */
+        ReadCurves (const std::string& svgpath, const bool use_cache, const float cache_point_step = 0.0f)
+        {
+            // Read (without parsing) the svg file text into memory; also needed for the content hash
+            this->modeldata.read (svgpath);
+
+            bool cached = false;
+            const std::string cachepath = svgpath + ".curves.bin";
+            const std::uint32_t svg_crc = morph::crc32c (this->modeldata.data(), this->modeldata.getsize());
+            if (use_cache == true) { cached = this->load_cache (cachepath, svg_crc); }
+
+            if (cached == false) {
+                // Parse the XML, find the root node and read the curves as usual
+                this->init();
+                this->read();
+                if (cache_point_step > 0.0f) {
+                    this->corticalPath.computePoints (cache_point_step);
+                    for (auto& er : this->enclosedRegions) { er.computePoints (cache_point_step); }
+                }
+                if (use_cache == true) { this->save_cache (cachepath, svg_crc); }
+            }
+
+            if (this->gotCortex == false) {
+                std::cerr << "WARNING: No object in SVG with id \"cortex\". Cortical boundary will be null.\n";
+            } // else DID get cortex ID
+        }
+
         /*!
          * Get the cortical path as a list of BezCurves
          */
@@ -178,6 +221,9 @@ namespace morph
                 } // else failed to get p_id
             }
 
+            // Parse all the paths recorded by the traversals above, in parallel
+            this->parsePaths();
+
             // Search circles, and make up a table of all the circles along with their IDs
             for (rapidxml::xml_node<>* circ_node = this->root_node->first_node("circle");
                  circ_node;
@@ -333,7 +379,41 @@ namespace morph
 
             // std::cout << "Path commands for layer " << layerName << ": " << d << std::endl;
 
-            morph::BezCurvePath<float> curves = this->parseD (d);
+            // Just record the d attribute for now; the (comparatively expensive) parsing of all
+            // the paths is carried out concurrently, in parsePaths().
+            this->path_jobs.push_back (std::make_pair (layerName, d));
+        }
+
+        /*!
+         * Parse the d attributes collected by readPath - one path per thread, as each path's
+         * Bezier curves are independent of every other path's - then store the results in
+         * document order.
+         */
+        void parsePaths()
+        {
+            const int n_jobs = static_cast<int>(this->path_jobs.size());
+            std::vector<morph::BezCurvePath<float>> parsed (n_jobs);
+            // An exception thrown on a worker thread is stashed and rethrown below
+            std::exception_ptr pp_error = nullptr;
+#pragma omp parallel for
+            for (int i = 0; i < n_jobs; ++i) {
+                try {
+                    parsed[i] = this->parseD (this->path_jobs[i].second);
+                } catch (...) {
+#pragma omp critical (readcurves_parsepaths)
+                    { if (pp_error == nullptr) { pp_error = std::current_exception(); } }
+                }
+            }
+            if (pp_error != nullptr) { std::rethrow_exception (pp_error); }
+
+            for (int i = 0; i < n_jobs; ++i) { this->storePath (parsed[i], this->path_jobs[i].first); }
+            this->path_jobs.clear();
+        }
+
+        //! Store one parsed path into corticalPath, linePath or enclosedRegions, as its
+        //! layerName dictates
+        void storePath (morph::BezCurvePath<float>& curves, const std::string& layerName)
+        {
             curves.name = layerName;
             if (layerName == "cortex") {
                 this->gotCortex = true;
@@ -379,13 +459,15 @@ namespace morph
          * Split up a string of SVG command numbers. These are delimited either by a comma, a space
          * or by a minus sign. Interpret them as floats and return in a vector.
          *
-         * This version also sets this->lastCmd where appropriate, and ensures that numParams are
+         * This version also sets lastCmd where appropriate, and ensures that numParams are
          * extracted from s. When s contains a longer than numParams list of numbers, endOfCmd is
-         * set to point to the end of the commands read into the return value.
+         * set to point to the end of the commands read into the return value. lastCmd is local to
+         * the calling parseD, not a class member, so that paths can be parsed concurrently.
          */
         std::vector<float> splitSvgCmdString (const std::string& s, char cmd,
                                               unsigned int numParams,
-                                              std::string::size_type& endOfCmd)
+                                              std::string::size_type& endOfCmd,
+                                              char& lastCmd) const
         {
             std::vector<float> numbers;
             unsigned int numnum = 0; // number of numbers stored in numbers
@@ -447,9 +529,9 @@ namespace morph
             endOfCmd = p1;
 
             if (endOfCmd == std::string::npos) {
-                this->lastCmd = '\0';
+                lastCmd = '\0';
             } else {
-                this->lastCmd = cmd;
+                lastCmd = cmd;
             }
 
             return numbers;
@@ -462,8 +544,11 @@ namespace morph
          * NB: The SVG is encoded in a left-hand coordinate system, with x positive right and y
          * positive down. This parsing does not change that coordinate system, and so the BezCoords
          * in the path may need to have their y coordinates reversed.
+         *
+         * parseD keeps all its parsing state local (it is const), so several d attributes can be
+         * parsed concurrently - see parsePaths().
          */
-        morph::BezCurvePath<float> parseD (const std::string& d)
+        morph::BezCurvePath<float> parseD (const std::string& d) const
         {
             morph::BezCurvePath<float> curves;
 
@@ -491,7 +576,9 @@ namespace morph
             std::string::size_type p1 = d.find_first_of (svgCmds, p0);
             std::string::size_type p2 = 0;
             std::string::size_type p3 = std::string::npos;
-            this->lastCmd = '\0';
+            // Records the last command, used when a string of identical commands needs to be
+            // parsed. Local, so that parseD is safe to call from several threads at once.
+            char lastCmd = '\0';
             char cmd = '\0';
             while (p1 != std::string::npos) {
 
@@ -499,7 +586,7 @@ namespace morph
                 if (lastCmd == '\0') {
                     cmd = d[p1];
                 } else {
-                    cmd = this->lastCmd;
+                    cmd = lastCmd;
                 }
 
                 p3 = std::string::npos;
@@ -514,7 +601,7 @@ namespace morph
                     if (morph::tools::containsOnlyWhitespace (lCmd)) {
                         p3 = lCmd.size()-1;
                     } else {
-                        std::vector<float> v = this->splitSvgCmdString (lCmd, cmd, 10000, p3);
+                        std::vector<float> v = this->splitSvgCmdString (lCmd, cmd, 10000, p3, lastCmd);
                         if (v.size()%2 != 0) {
                             throw std::runtime_error ("Unexpected size of SVG path L command (expected pairs of numbers)");
                         }
@@ -540,7 +627,7 @@ namespace morph
                     if (morph::tools::containsOnlyWhitespace (lCmd)) {
                         p3 = lCmd.size()-1;
                     } else {
-                        std::vector<float> v = this->splitSvgCmdString (lCmd, cmd, 10000, p3);
+                        std::vector<float> v = this->splitSvgCmdString (lCmd, cmd, 10000, p3, lastCmd);
                         if (v.size() == 0) {
                             throw std::runtime_error ("Unexpected size of SVG path H command (expected at least one number)");
                         }
@@ -566,7 +653,7 @@ namespace morph
                     if (morph::tools::containsOnlyWhitespace (lCmd)) {
                         p3 = lCmd.size()-1;
                     } else {
-                        std::vector<float> v = this->splitSvgCmdString (lCmd, cmd, 10000, p3);
+                        std::vector<float> v = this->splitSvgCmdString (lCmd, cmd, 10000, p3, lastCmd);
                         if (v.size() == 0) {
                             throw std::runtime_error ("Unexpected size of SVG path V command (expected at least one number)");
                         }
@@ -597,7 +684,7 @@ namespace morph
                     if (morph::tools::containsOnlyWhitespace (mCmd)) {
                         p3 = mCmd.size()-1;
                     } else {
-                        std::vector<float> v = this->splitSvgCmdString (mCmd, cmd, 10000, p3);
+                        std::vector<float> v = this->splitSvgCmdString (mCmd, cmd, 10000, p3, lastCmd);
                         if (v.size()%2 != 0) {
                             throw std::runtime_error ("Unexpected size of SVG path M command (expected pairs of numbers)");
                         }
@@ -637,7 +724,7 @@ namespace morph
                     if (morph::tools::containsOnlyWhitespace (cCmd)) {
                         p3 = cCmd.size()-1;
                     } else {
-                        std::vector<float> v = this->splitSvgCmdString (cCmd, cmd, 6, p3);
+                        std::vector<float> v = this->splitSvgCmdString (cCmd, cmd, 6, p3, lastCmd);
                         if (v.size() != 6) {
                             std::stringstream ee;
                             ee << "Unexpected size of SVG path C command (expected 6 numbers, got " << v.size() << ")";
@@ -667,7 +754,7 @@ namespace morph
                     if (morph::tools::containsOnlyWhitespace (sCmd)) {
                         p3 = sCmd.size()-1;
                     } else {
-                        std::vector<float> v = this->splitSvgCmdString (sCmd, cmd, 4, p3);
+                        std::vector<float> v = this->splitSvgCmdString (sCmd, cmd, 4, p3, lastCmd);
                         if (v.size() != 4) {
                             throw std::runtime_error ("Unexpected size of SVG path S command (expected 4 numbers)");
                         }
@@ -722,7 +809,7 @@ namespace morph
                     p1 = p1+1+p3;
                     if (p1+1 == p2) {
                         // It's a new command!
-                        this->lastCmd = '\0';
+                        lastCmd = '\0';
                     }
                 }
             }
@@ -806,6 +893,148 @@ namespace morph
             }
         }
 
+        //! Identifies a ReadCurves boundary cache file (see morph::snapshot)
+        static constexpr std::uint32_t rc_cache_tag = morph::crc32 ("ReadCurves");
+        //! The version of the cache section layout
+        static constexpr std::uint32_t rc_cache_version = 1;
+
+        /*!
+         * Write one BezCurvePath into the cache as a group of sections named
+         * \a pfx + "/nm" (name), "/ic" (initial coordinate), "/sc" (scale), "/cpr"
+         * (control points per curve), "/cps" (the control point coordinates, unscaled,
+         * flattened) and - if computePoints has been run - "/pts", "/tan" and "/nrm".
+         */
+        void add_path_to_cache (morph::snapshot::writer& w, const std::string& pfx,
+                                const morph::BezCurvePath<float>& p) const
+        {
+            w.add (pfx + "/nm", p.name.data(), p.name.size());
+            w.add_value (pfx + "/ic", p.initialCoordinate);
+            w.add_value (pfx + "/sc", p.scale);
+            std::vector<std::uint32_t> cpr;
+            std::vector<float> cps;
+            for (const morph::BezCurve<float>& c : p.curves) {
+                morph::vvec<morph::vec<float, 2>> ctrl = c.getControls();
+                cpr.push_back (static_cast<std::uint32_t>(ctrl.size()));
+                for (const morph::vec<float, 2>& cp : ctrl) {
+                    cps.push_back (cp[0]);
+                    cps.push_back (cp[1]);
+                }
+            }
+            w.add_array (pfx + "/cpr", cpr);
+            w.add_array (pfx + "/cps", cps);
+            if (p.points.empty() == false) {
+                w.add_array (pfx + "/pts", p.points);
+                w.add_array (pfx + "/tan", p.tangents);
+                w.add_array (pfx + "/nrm", p.normals);
+            }
+        }
+
+        //! Rebuild one BezCurvePath from its group of cache sections (see add_path_to_cache)
+        morph::BezCurvePath<float> path_from_cache (const morph::snapshot::reader& r, const std::string& pfx) const
+        {
+            morph::BezCurvePath<float> p;
+            std::span<const char> nm = r.bytes (pfx + "/nm");
+            p.name.assign (nm.data(), nm.size());
+            std::span<const std::uint32_t> cpr = r.view<std::uint32_t> (pfx + "/cpr");
+            std::span<const float> cps = r.view<float> (pfx + "/cps");
+            std::size_t o = 0;
+            for (const std::uint32_t nc : cpr) {
+                morph::vvec<morph::vec<float, 2>> ctrl (nc);
+                for (std::uint32_t i = 0; i < nc; ++i) {
+                    ctrl[i] = { cps[o], cps[o + 1] };
+                    o += 2;
+                }
+                morph::BezCurve<float> c (ctrl);
+                p.addCurve (c);
+            }
+            float sc = 1.0f;
+            r.value (pfx + "/sc", sc);
+            if (sc != 1.0f) { p.setScale (sc); }
+            r.value (pfx + "/ic", p.initialCoordinate);
+            if (r.has (pfx + "/pts") == true) {
+                r.fill (pfx + "/pts", p.points);
+                r.fill (pfx + "/tan", p.tangents);
+                r.fill (pfx + "/nrm", p.normals);
+            }
+            return p;
+        }
+
+        /*!
+         * Try to load the parsed boundary from the cache file at \a cachepath. Returns
+         * false - leaving this object untouched for a normal parse - if the file is
+         * missing, is not a ReadCurves cache, fails a checksum or was made from
+         * different SVG content than \a svg_crc.
+         */
+        bool load_cache (const std::string& cachepath, const std::uint32_t svg_crc)
+        {
+            try {
+                morph::snapshot::reader r (cachepath, rc_cache_tag, rc_cache_version);
+                std::uint32_t stored_crc = 0;
+                r.value ("svg_crc", stored_crc);
+                if (stored_crc != svg_crc) { return false; } // the SVG has changed
+                r.value ("line_to_mm", this->lineToMillimetres);
+                std::uint8_t gc = 0;
+                r.value ("got_cortex", gc);
+                this->gotCortex = (gc != 0);
+                this->corticalPath = this->path_from_cache (r, "cx");
+                std::uint32_t nr = 0;
+                r.value ("n_regions", nr);
+                for (std::uint32_t i = 0; i < nr; ++i) {
+                    this->enclosedRegions.push_back (this->path_from_cache (r, "r" + std::to_string (i)));
+                }
+                if (r.has ("circ_names") == true) {
+                    std::span<const char> nb = r.bytes ("circ_names");
+                    std::span<const float> cc = r.view<float> ("circ_coords");
+                    std::string names (nb.data(), nb.size());
+                    std::string::size_type p0 = 0;
+                    std::size_t ci = 0;
+                    while (p0 < names.size()) {
+                        std::string::size_type p1 = names.find ('\n', p0);
+                        if (p1 == std::string::npos) { p1 = names.size(); }
+                        this->circles[names.substr (p0, p1 - p0)] = { cc[2 * ci], cc[2 * ci + 1] };
+                        p0 = p1 + 1;
+                        ++ci;
+                    }
+                }
+            } catch (const std::runtime_error&) { return false; }
+            return true;
+        }
+
+        //! Write the parsed boundary to the cache file at \a cachepath, keyed by
+        //! \a svg_crc. Failure to write is only a warning; the curves were parsed fine.
+        void save_cache (const std::string& cachepath, const std::uint32_t svg_crc) const
+        {
+            try {
+                morph::snapshot::writer w (cachepath, rc_cache_tag, rc_cache_version);
+                w.add_value ("svg_crc", svg_crc);
+                w.add_value ("line_to_mm", this->lineToMillimetres);
+                std::uint8_t gc = this->gotCortex == true ? 1 : 0;
+                w.add_value ("got_cortex", gc);
+                this->add_path_to_cache (w, "cx", this->corticalPath);
+                std::uint32_t nr = static_cast<std::uint32_t>(this->enclosedRegions.size());
+                w.add_value ("n_regions", nr);
+                std::uint32_t i = 0;
+                for (const morph::BezCurvePath<float>& er : this->enclosedRegions) {
+                    this->add_path_to_cache (w, "r" + std::to_string (i++), er);
+                }
+                if (this->circles.empty() == false) {
+                    std::string names;
+                    std::vector<float> coords;
+                    for (const auto& c : this->circles) {
+                        if (names.empty() == false) { names += '\n'; }
+                        names += c.first;
+                        coords.push_back (c.second[0]);
+                        coords.push_back (c.second[1]);
+                    }
+                    w.add ("circ_names", names.data(), names.size());
+                    w.add_array ("circ_coords", coords);
+                }
+                w.finish();
+            } catch (const std::runtime_error& e) {
+                std::cerr << "WARNING: Could not write boundary cache: " << e.what() << std::endl;
+            }
+        }
+
         /*!
          * The neocortical path.
          */
@@ -853,10 +1082,10 @@ namespace morph
         rapidxml::xml_node<>* root_node = static_cast<rapidxml::xml_node<>*>(0);
 
         /*!
-         * Records the last command. Used when a string of identical commands needs to be parsed by
-         * parseD.
+         * The d attributes found during document traversal, paired with the layer name each was
+         * found in. These are parsed concurrently by parsePaths().
          */
-        char lastCmd = '\0';
+        std::vector<std::pair<std::string, std::string>> path_jobs;
     };
 
 } // namespace morph
@@ -10,9 +10,13 @@
 #include <morph/VisualDataModel.h>
 #include <morph/scale.h>
 #include <morph/vec.h>
+#include <morph/range.h>
+#include <morph/kdtree.h>
 #include <iostream>
 #include <vector>
 #include <array>
+#include <string>
+#include <limits>
 
 namespace morph {
 
@@ -46,6 +50,34 @@ namespace morph {
         }
 
         //! Compute spheres for a scatter plot
+        //! Predict the build's vertex count so that finalize()/reinit() can reserve the
+        //! vertex containers once. Each datum is a sphere: computeSphere (16 rings, 20
+        //! segments) generates 2 + 15 * 20 = 302 vertices; the 2-iteration geodesic
+        //! alternative has 162.
+        std::size_t predict_vertex_count() const override
+        {
+            std::size_t ncoords = this->dataCoords == nullptr ? 0 : this->dataCoords->size();
+            constexpr std::size_t verts_per_sphere = draw_spheres_as_geodesics ? 162u : 302u;
+            return ncoords * verts_per_sphere;
+        }
+
+        //! Assign per-vertex element ids for the picking pass (see VisualBase::pick).
+        //! Each datum's sphere vertices take the datum's index, read from the same
+        //! per-datum vertex ranges that updateColours uses.
+        void fillPickIDs() override
+        {
+            std::size_t nverts = this->vertexPositions.size() / 3u;
+            if (nverts == 0u || this->datum_colour_extents.empty()) { this->pickIDs.clear(); return; }
+            this->pickIDs.assign (nverts, this->pick_id_none);
+            for (std::size_t i = 0; i < this->datum_colour_extents.size(); ++i) {
+                unsigned int vmax = this->datum_colour_extents[i].max;
+                if (vmax > nverts) { vmax = static_cast<unsigned int>(nverts); }
+                for (unsigned int v = this->datum_colour_extents[i].min; v < vmax; ++v) {
+                    this->pickIDs[v] = static_cast<float>(i);
+                }
+            }
+        }
+
         void initializeVertices()
         {
             unsigned int ncoords = this->dataCoords == nullptr ? 0 : this->dataCoords->size();
@@ -100,7 +132,15 @@ namespace morph {
 
             } // else no scaling required - spheres will be one colour
 
+            this->datum_colour_extents.clear();
+            this->datum_colour_extents.reserve (ncoords);
+            // Index labels are collected here during the loop and created in one batch
+            // afterwards (one VisualTextModel for all of them - see addLabels)
+            std::vector<std::string> label_txts;
+            std::vector<morph::vec<float, 3>> label_offs;
             for (unsigned int i = 0; i < ncoords; ++i) {
+                // Record which colour vertices belong to this datum, for updateColours
+                unsigned int c_start = static_cast<unsigned int>(this->vertexColors.size() / 3u);
                 // Scale colour (or use single colour)
                 std::array<float, 3> clr = this->cm.getHueRGB();
                 if (ndata && !nvdata) {
@@ -128,10 +168,53 @@ namespace morph {
                 }
 
                 if (this->labelIndices == true) {
-                    // Draw an index label...
-                    this->addLabel (std::to_string (i), (*this->dataCoords)[i] + labelOffset, morph::TextFeatures(labelSize) );
+                    // Collect an index label, unless the datum lies outside the label
+                    // region, in which case it skips text layout entirely
+                    const morph::vec<float, 3>& dc = (*this->dataCoords)[i];
+                    if (dc[0] >= this->labelRegionMin[0] && dc[0] <= this->labelRegionMax[0]
+                        && dc[1] >= this->labelRegionMin[1] && dc[1] <= this->labelRegionMax[1]
+                        && dc[2] >= this->labelRegionMin[2] && dc[2] <= this->labelRegionMax[2]) {
+                        label_txts.push_back (std::to_string (i));
+                        label_offs.push_back (dc + labelOffset);
+                    }
+                }
+
+                this->datum_colour_extents.push_back ({ c_start, static_cast<unsigned int>(this->vertexColors.size() / 3u) });
+            }
+
+            if (this->labelIndices == true) {
+                this->addLabels (label_txts, label_offs, morph::TextFeatures(labelSize));
+            }
+        }
+
+        /*!
+         * Rewrite just the sphere colours from new scalar data, leaving the geometry untouched -
+         * much cheaper than updateData when values change but coordinates do not. Falls back to a
+         * full reinit when the geometry depends on the data (sizeFactor != 0) or the data size
+         * has changed.
+         */
+        void updateColours (const std::vector<Flt>* _data) override
+        {
+            this->scalarData = _data;
+            unsigned int ncoords = this->dataCoords == nullptr ? 0 : this->dataCoords->size();
+            if (this->sizeFactor != Flt{0} || ncoords == 0
+                || this->scalarData == nullptr || this->scalarData->size() != ncoords
+                || this->datum_colour_extents.size() != ncoords) {
+                this->reinit();
+                return;
+            }
+            std::vector<Flt> dcopy (ncoords);
+            if (this->colourScale.do_autoscale == true) { this->colourScale.reset(); }
+            this->colourScale.transform (*this->scalarData, dcopy);
+            for (unsigned int i = 0; i < ncoords; ++i) {
+                std::array<float, 3> clr = this->cm.convert (dcopy[i]);
+                for (unsigned int v = this->datum_colour_extents[i].min; v < this->datum_colour_extents[i].max; ++v) {
+                    this->vertexColors[3u * v] = clr[0];
+                    this->vertexColors[3u * v + 1u] = clr[1];
+                    this->vertexColors[3u * v + 2u] = clr[2];
                 }
             }
+            this->reinit_colour_buffer();
         }
 
         // The constexpr, unordered geodesic code is no slower than the regular
@@ -139,6 +222,56 @@ namespace morph {
         // required)
         static constexpr bool draw_spheres_as_geodesics = false;
 
+        /*!
+         * Build (or rebuild) the spatial index over dataCoords. Until this is called
+         * (and again after the coordinates change), the query functions below fall
+         * back to linear scans, so indexing is pay-for-what-you-use; build it when
+         * pick/hover queries against a large scatter need to be fast.
+         */
+        void buildSpatialIndex()
+        {
+            if (this->dataCoords != nullptr) { this->spatial_index.build (*this->dataCoords); }
+        }
+
+        /*!
+         * The index (into dataCoords) of the datum nearest to \a coord (in model
+         * coordinates), placing its distance in \a dist if non-null. Returns
+         * kdtree::npos when there are no coordinates. Used for hover/pick.
+         */
+        std::size_t nearestDatum (const morph::vec<float, 3>& coord, float* dist = nullptr) const
+        {
+            if (this->dataCoords == nullptr || this->dataCoords->empty()) {
+                return morph::kdtree<float, 3>::npos;
+            }
+            if (this->spatial_index.size() == this->dataCoords->size()) {
+                return this->spatial_index.nearest (coord, dist);
+            }
+            // No up-to-date index; scan
+            std::size_t best = 0;
+            float best_sq = std::numeric_limits<float>::max();
+            for (std::size_t i = 0; i < this->dataCoords->size(); ++i) {
+                float d_sq = ((*this->dataCoords)[i] - coord).length_sq();
+                if (d_sq < best_sq) { best_sq = d_sq; best = i; }
+            }
+            if (dist != nullptr) { *dist = std::sqrt (best_sq); }
+            return best;
+        }
+
+        //! Indices of the data within distance \a radius of \a coord - a pick with a
+        //! selection radius. Linear scan if buildSpatialIndex() has not been called.
+        std::vector<std::size_t> dataWithin (const morph::vec<float, 3>& coord, const float radius) const
+        {
+            std::vector<std::size_t> found;
+            if (this->dataCoords == nullptr) { return found; }
+            if (this->spatial_index.size() == this->dataCoords->size()) {
+                return this->spatial_index.within_ball (coord, radius);
+            }
+            for (std::size_t i = 0; i < this->dataCoords->size(); ++i) {
+                if (((*this->dataCoords)[i] - coord).length() <= radius) { found.push_back (i); }
+            }
+            return found;
+        }
+
         //! Set this->radiusFixed, then re-compute vertices.
         void setRadius (float fr)
         {
@@ -160,6 +293,29 @@ namespace morph {
 
         morph::vec<float, 3> labelOffset = { 0.04f, 0.0f, 0.0f };
         float labelSize = 0.03f;
+
+        /*!
+         * The region (an axis-aligned box in model coordinates) within which datapoints get
+         * index labels. By default it is unbounded, so every datum is labelled. Narrow it to
+         * the region of interest when labelling a very large scatter - datapoints outside the
+         * box skip text layout entirely.
+         */
+        morph::vec<float, 3> labelRegionMin = { std::numeric_limits<float>::lowest(),
+                                                std::numeric_limits<float>::lowest(),
+                                                std::numeric_limits<float>::lowest() };
+        morph::vec<float, 3> labelRegionMax = { std::numeric_limits<float>::max(),
+                                                std::numeric_limits<float>::max(),
+                                                std::numeric_limits<float>::max() };
+
+    protected:
+        //! For each datum, the range of colour vertices ([min, max), as indices into
+        //! vertexColors/3) that its sphere occupies. Recorded by initializeVertices so that
+        //! updateColours can rewrite colours without re-tessellating.
+        std::vector<morph::range<unsigned int>> datum_colour_extents;
+
+        //! The k-d tree over dataCoords for nearestDatum/dataWithin. Empty until
+        //! buildSpatialIndex() is called; stale (and unused) if dataCoords changes size.
+        morph::kdtree<float, 3> spatial_index;
     };
 
 } // namespace morph
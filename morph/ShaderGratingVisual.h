@@ -0,0 +1,144 @@
+/*!
+ * \file
+ *
+ * A shader-animated version of GratingVisual. GratingVisual re-tessellates its bands
+ * on the CPU for every time step, which cannot hold a low-jitter 144 Hz stimulus.
+ * ShaderGratingVisual draws ONE static quad and evaluates the square wave between the
+ * two band colours per fragment, with the wavelength, front angle, front velocity and
+ * time as uniforms - so advancing the animation is a uniform update per frame. Set t
+ * (or call setTime) and render; no reinit is needed.
+ *
+ * Note: this class makes direct (global alias) OpenGL calls, like the morph::gl
+ * compute subsystem, so use it with morph::VisualNoMX (not the multicontext
+ * morph::Visual).
+ *
+ * \author Seb James
+ * \date August 2026
+ */
+#pragma once
+
+#include <morph/gl/version.h>
+#include <morph/gl/shaders.h>
+#include <morph/gl/loadshaders_nomx.h>
+#include <morph/GratingVisual.h>
+#include <morph/VisualDefaultShaders.h>
+#include <morph/mathconst.h>
+#include <morph/vec.h>
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace morph {
+
+    //! A GratingVisual whose bands are computed per fragment on the GPU
+    template<int glver = morph::gl::version_4_1>
+    class ShaderGratingVisual : public GratingVisual<glver>
+    {
+    public:
+        ShaderGratingVisual() {}
+        ShaderGratingVisual (const vec<float, 3> _offset) { this->init (_offset); }
+
+        ~ShaderGratingVisual()
+        {
+            if (this->grating_prog != 0) { glDeleteProgram (this->grating_prog); }
+        }
+
+        //! The geometry is one quad over the grating's rectangle (the same coordinate
+        //! convention as GratingVisual's bands). The model-space x/y of each corner
+        //! rides in the standard colour attribute, which the textured grid vertex
+        //! shader forwards as texture coordinates.
+        void initializeVertices()
+        {
+            const float left  = this->mv_offset[0];
+            const float right = this->mv_offset[0] + this->dims[0];
+            const float bot   = this->mv_offset[1];
+            const float top   = this->mv_offset[1] + this->dims[1];
+
+            this->vertexPositions = { left, bot, 0.0f,   right, bot, 0.0f,
+                                      right, top, 0.0f,  left, top, 0.0f };
+            this->vertexNormals = { 0.0f, 0.0f, 1.0f,  0.0f, 0.0f, 1.0f,
+                                    0.0f, 0.0f, 1.0f,  0.0f, 0.0f, 1.0f };
+            this->vertexColors = { left, bot, 0.0f,   right, bot, 0.0f,
+                                   right, top, 0.0f,  left, top, 0.0f };
+            this->indices = { 0, 1, 2,  0, 2, 3 };
+            this->idx = 4;
+        }
+
+        //! Set the current time. Takes effect at the next render; no reinit required.
+        void setTime (const unsigned long long int _t) { this->t = _t; }
+
+        //! Render the quad with the grating shader program, which is created lazily
+        //! here, as render() is the call that is guaranteed a current OpenGL context.
+        void render()
+        {
+            if (this->hide == true) { return; }
+
+            if (this->postVertexInitRequired == true) { this->postVertexInit(); }
+            if (this->grating_prog == 0) { this->init_gl_objects(); }
+
+            GLint prev_shader = 0;
+            glGetIntegerv (GL_CURRENT_PROGRAM, &prev_shader);
+
+            // The projection matrix is owned by the parent Visual, which sets it on the
+            // scene's graphics program each frame; copy it over to our program.
+            GLuint gprog = this->get_gprog (this->parentVis);
+            std::array<float, 16> pmat;
+            GLint ploc = glGetUniformLocation (gprog, static_cast<const GLchar*>("p_matrix"));
+            if (ploc != -1) { glGetUniformfv (gprog, ploc, pmat.data()); }
+
+            glUseProgram (this->grating_prog);
+            GLint loc_p = glGetUniformLocation (this->grating_prog, static_cast<const GLchar*>("p_matrix"));
+            if (loc_p != -1 && ploc != -1) { glUniformMatrix4fv (loc_p, 1, GL_FALSE, pmat.data()); }
+            GLint loc_v = glGetUniformLocation (this->grating_prog, static_cast<const GLchar*>("v_matrix"));
+            if (loc_v != -1) { glUniformMatrix4fv (loc_v, 1, GL_FALSE, this->scenematrix.mat.data()); }
+            GLint loc_m = glGetUniformLocation (this->grating_prog, static_cast<const GLchar*>("m_matrix"));
+            if (loc_m != -1) { glUniformMatrix4fv (loc_m, 1, GL_FALSE, (this->model_scaling * this->viewmatrix).mat.data()); }
+
+            // The grating parameters. Note that in GratingVisual, alpha is the front
+            // angle, not a transparency.
+            const float a_rad = morph::mathconst<float>::deg2rad * this->alpha;
+            GLint loc_d = glGetUniformLocation (this->grating_prog, static_cast<const GLchar*>("u_dir"));
+            if (loc_d != -1) { glUniform2f (loc_d, std::cos (a_rad), std::sin (a_rad)); }
+            const vec<float, 2> v_offset = this->v_front * this->t;
+            GLint loc_o = glGetUniformLocation (this->grating_prog, static_cast<const GLchar*>("v_offset"));
+            if (loc_o != -1) { glUniform2f (loc_o, v_offset[0], v_offset[1]); }
+            GLint loc_l = glGetUniformLocation (this->grating_prog, static_cast<const GLchar*>("lambda"));
+            if (loc_l != -1) { glUniform1f (loc_l, this->lambda); }
+            GLint loc_c1 = glGetUniformLocation (this->grating_prog, static_cast<const GLchar*>("colour1"));
+            if (loc_c1 != -1) { glUniform3f (loc_c1, this->colour1[0], this->colour1[1], this->colour1[2]); }
+            GLint loc_c2 = glGetUniformLocation (this->grating_prog, static_cast<const GLchar*>("colour2"));
+            if (loc_c2 != -1) { glUniform3f (loc_c2, this->colour2[0], this->colour2[1], this->colour2[2]); }
+            GLint loc_a = glGetUniformLocation (this->grating_prog, static_cast<const GLchar*>("alpha"));
+            if (loc_a != -1) { glUniform1f (loc_a, 1.0f); }
+
+            glBindVertexArray (this->vao);
+            glDrawElements (GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+            glBindVertexArray (0);
+
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+
+            // Now render any VisualTextModels
+            auto ti = this->texts.begin();
+            while (ti != this->texts.end()) { (*ti)->render(); ti++; }
+
+            glUseProgram (prev_shader);
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+        }
+
+    protected:
+        //! Create the grating shader program. Requires a current OpenGL context.
+        void init_gl_objects()
+        {
+            std::vector<morph::gl::ShaderInfo> shaders = {
+                {GL_VERTEX_SHADER, "ShaderGratingVisual.vert.glsl", morph::getTexturedGridVtxShader (glver), 0 },
+                {GL_FRAGMENT_SHADER, "ShaderGratingVisual.frag.glsl", morph::getGratingFragShader (glver), 0 }
+            };
+            this->grating_prog = morph::gl::LoadShaders (shaders);
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+        }
+
+        //! Our shader program, which evaluates the band pattern per fragment
+        GLuint grating_prog = 0;
+    };
+
+} // namespace morph
@@ -16,6 +16,7 @@
 #include <morph/HexGrid.h>
 #include <morph/DirichDom.h>
 #include <morph/DirichVtx.h>
+#include <morph/pool_allocator.h>
 
 namespace morph {
 
@@ -37,21 +38,29 @@ namespace morph {
     public:
         static constexpr bool dbg = false;
 
+        /*!
+         * A list of DirichVtx whose nodes come from the thread-local pool
+         * (morph/pool_allocator.h). The vertex-finding code creates and destroys many small
+         * DirichVtx list nodes; pass one of these as the working list to dirichlet_vertices()
+         * and the node allocations become pointer pops from the pool's free lists.
+         */
+        using dirichvtx_list = std::list<DirichVtx<Flt>, morph::pool_allocator<DirichVtx<Flt>>>;
+
         /*!
          * Obtain the contours (as a vector of list<Hex>) in the scalar fields f, where threshold is
          * crossed.
          */
-        static std::vector<std::list<Hex> > get_contours (HexGrid* hg,
+        static std::vector<morph::hexlist > get_contours (HexGrid* hg,
                                                           std::vector<std::vector<Flt> >& f,
                                                           Flt threshold) {
 
             unsigned int nhex = hg->num();
             unsigned int N = f.size();
 
-            std::vector<std::list<Hex> > rtn;
+            std::vector<morph::hexlist > rtn;
             // Initialise
             for (unsigned int li = 0; li < N; ++li) {
-                std::list<Hex> lh;
+                morph::hexlist lh;
                 rtn.push_back (lh);
             }
 
@@ -281,6 +290,69 @@ namespace morph {
             return rtn;
         }
 
+        /*!
+         * Segment the identity map @regions (one value per hex on the HexGrid @hg, as produced
+         * by dirichlet_regions) into its connected components; that is, into the individual
+         * domains, distinguishing separate, same-ID domains from one another. Carried out as a
+         * parallel connected-component labelling over the HexGrid's d_ neighbour-index vectors
+         * by iterative minimum-label propagation (with one pointer-jumping step per sweep to
+         * shorten label chains). The result is deterministic regardless of thread count.
+         *
+         * Return a vector (indexed like @regions) of domain labels, renumbered densely from 0
+         * in order of each domain's first (lowest) hex index. The number of domains is returned
+         * in @n_domains.
+         */
+        static std::vector<int>
+        dirichlet_domains (HexGrid* hg, const std::vector<Flt>& regions, unsigned int& n_domains) {
+
+            int nhex = static_cast<int>(hg->num());
+            std::vector<int> labels (nhex);
+            std::vector<int> next_labels (nhex);
+            for (int i = 0; i < nhex; ++i) { labels[i] = i; }
+
+            // The six d_ neighbour-index vectors, in the usual E, NE, NW, W, SW, SE order. An
+            // entry of -1 means 'no neighbour'.
+            const std::vector<int>* nbrs[6] = {
+                &hg->d_ne, &hg->d_nne, &hg->d_nnw, &hg->d_nw, &hg->d_nsw, &hg->d_nse
+            };
+
+            // Sweep until no label changes. Each sweep reads labels and writes next_labels, so
+            // the sweeps are data-race free and the fixed point is independent of the schedule.
+            unsigned int nchanged = 1;
+            while (nchanged > 0) {
+                nchanged = 0;
+#pragma omp parallel for reduction(+:nchanged)
+                for (int i = 0; i < nhex; ++i) {
+                    int lbl = labels[i];
+                    for (unsigned int ni = 0; ni < 6; ++ni) {
+                        int nb = (*nbrs[ni])[i];
+                        if (nb >= 0 && regions[nb] == regions[i] && labels[nb] < lbl) {
+                            lbl = labels[nb];
+                        }
+                    }
+                    // Pointer jumping: hop to the label of the label, roughly halving the number
+                    // of sweeps needed for elongated domains.
+                    if (labels[lbl] < lbl) { lbl = labels[lbl]; }
+                    next_labels[i] = lbl;
+                    nchanged += (lbl == labels[i]) ? 0u : 1u;
+                }
+                labels.swap (next_labels);
+            }
+
+            // Renumber the surviving root labels densely from 0, in hex index order.
+            std::map<int, int> renumber;
+            for (int i = 0; i < nhex; ++i) {
+                if (renumber.count (labels[i]) == 0) {
+                    int dense = static_cast<int>(renumber.size());
+                    renumber[labels[i]] = dense;
+                }
+            }
+            for (int i = 0; i < nhex; ++i) { labels[i] = renumber[labels[i]]; }
+            n_domains = static_cast<unsigned int>(renumber.size());
+
+            return labels;
+        }
+
         /*!
          * @regions is a vector of a size specified in the HexGrid @hg containing N
          * unique IDs. For each unique ID, compute the centroid of all the hexes
@@ -306,11 +378,13 @@ namespace morph {
 
         /*!
          * A method to test the hex give by @h, which must live on the HexGrid pointed to by @hg, to
-         * see if it is a Dirichlet vertex. If so, a vertex should be created in @vertices.
+         * see if it is a Dirichlet vertex. If so, a vertex should be created in @vertices. The
+         * @vertices list may use any allocator; pass a dirichvtx_list for pooled node allocation.
          */
+        template <typename Alloc = std::allocator<DirichVtx<Flt>>>
         static void
         vertex_test (HexGrid* hg, std::vector<Flt>& f,
-                     std::list<Hex>::iterator h, std::list<DirichVtx<Flt> >& vertices) {
+                     morph::hexlist::iterator h, std::list<DirichVtx<Flt>, Alloc>& vertices) {
 
             // For each hex, examine its neighbours, counting number of different neighbours.
             std::set<Flt> n_ids;
@@ -451,14 +525,14 @@ namespace morph {
             // side. _Initially_, point hexit at the hex that's on the inside of the domain for
             // which v is a Dirichlet vertex - v.hi. At least, this is what you do when walking OUT
             // to a neighbour vertex that's part of another domain.
-            std::list<Hex>::iterator hexit = v.hi;
+            morph::hexlist::iterator hexit = v.hi;
             // point hexit_neighb to the hexes on the edgedoms[1] side
-            std::list<Hex>::iterator hexit_neighb = v.hi;
+            morph::hexlist::iterator hexit_neighb = v.hi;
             // The first hex, inside the domain.
-            std::list<Hex>::iterator hexit_first = v.hi;
+            morph::hexlist::iterator hexit_first = v.hi;
             // Temporary hex pointers
-            std::list<Hex>::iterator hexit_next = v.hi;
-            std::list<Hex>::iterator hexit_last = v.hi;
+            morph::hexlist::iterator hexit_next = v.hi;
+            morph::hexlist::iterator hexit_last = v.hi;
 
             // Set true when we find the partner vertex.
             bool partner_found = false;
@@ -848,10 +922,11 @@ namespace morph {
          * Return true for success, false for failure, and leave dv pointing to the next vertex in
          * vertices so that @domain can be stored, reset and the next Dirichlet domain can be found.
          */
+        template <typename Alloc = std::allocator<DirichVtx<Flt>>>
         static bool
         process_domain (HexGrid* hg, std::vector<Flt>& f,
-                        typename std::list<DirichVtx<Flt>>::iterator dv,
-                        std::list<DirichVtx<Flt>>& vertices,
+                        typename std::list<DirichVtx<Flt>, Alloc>::iterator dv,
+                        std::list<DirichVtx<Flt>, Alloc>& vertices,
                         DirichDom<Flt>& domain,
                         DirichVtx<Flt> first_vtx) {
 
@@ -883,7 +958,7 @@ namespace morph {
             dv->closed = true;
             domain.vertices.push_back (v);
 
-            typename std::list<DirichVtx<Flt>>::iterator dv2 = vertices.begin();
+            typename std::list<DirichVtx<Flt>, Alloc>::iterator dv2 = vertices.begin();
             if (first_vtx.compare (next_vtx) == false) {
                 // Find a dv which matches next_vtx.
                 bool matched_next_vertex = false;
@@ -939,15 +1014,16 @@ namespace morph {
          * different values of @f. @f is indexed by the HexGrid @hg. Return a list containing lists
          * of the vertices, each of which define a domain.
          */
+        template <typename Alloc = std::allocator<DirichVtx<Flt>>>
         static std::list<DirichDom<Flt>>
-        dirichlet_vertices (HexGrid* hg, std::vector<Flt>& f, std::list<DirichVtx<Flt>>& vertices) {
+        dirichlet_vertices (HexGrid* hg, std::vector<Flt>& f, std::list<DirichVtx<Flt>, Alloc>& vertices) {
 
             // 1. Go though and find a list of all vertices, in no particular order.  This will
             // lead to duplications because >1 domain for a given ID, f, is possible early in
             // simulations. From this list, I can find vertex sets, whilst deleting from the list
             // until it is empty, and know that I will have discovered all the domain vertex sets.
             // list<DirichVtx<Flt> > vertices;
-            std::list<Hex>::iterator h = hg->hexen.begin();
+            morph::hexlist::iterator h = hg->hexen.begin();
             while (h != hg->hexen.end()) {
                 vertex_test (hg, f, h, vertices);
                 // Move on to the next Hex in hexen
@@ -960,7 +1036,7 @@ namespace morph {
             // to achieve this (to disambiguate between vertices from separate, but same-ID
             // domains).
             std::list<DirichDom<Flt>> dirich_domains;
-            typename std::list<DirichVtx<Flt>>::iterator dv = vertices.begin();
+            typename std::list<DirichVtx<Flt>, Alloc>::iterator dv = vertices.begin();
             //unsigned int domcount = 0;
             while (dv != vertices.end() /* && domcount++ < 3 */) {
                 DirichDom<Flt> one_domain;
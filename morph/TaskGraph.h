@@ -0,0 +1,221 @@
+/*!
+ * \file
+ *
+ * \brief A lightweight task-graph scheduler for pipelining simulation stages
+ *
+ * Simulation programs step the model, analyse the state, update a plot and save to
+ * file strictly serially, though the stages for *different* timesteps are
+ * independent: analysis of step N can overlap computation of step N+1 and saving of
+ * step N-1, given a private copy of the data for each stage. TaskGraph holds a set
+ * of named task nodes with dependencies and executes them on a morph::threadpool,
+ * running every node whose dependencies are satisfied concurrently. A graph is
+ * reusable: build it once, then call run() every timestep. DoubleBuffer provides
+ * the data handoff between pipelined stages - the producer stage writes back(),
+ * the consumer stage reads front(), and the (single-threaded) code between run()
+ * calls flip()s.
+ *
+ * So a pipelined simulation loop looks like:
+ *
+ * \code
+ *   morph::TaskGraph graph;
+ *   morph::DoubleBuffer<std::vector<double>> state;
+ *   auto step = graph.add ("step", [&] { model.step(); state.back() = model.A; });
+ *   auto analyse = graph.add ("analyse", [&] { analysis = analyse_fn (state.front()); });
+ *   auto save = graph.add ("save", [&] { data.add_contained_vals ("/A", state.front()); });
+ *   graph.depends (save, analyse); // save wants the analysis of the same step
+ *   for (unsigned int i = 0; i < nsteps; ++i) {
+ *       graph.run();   // step i+1 computes while step i is analysed and saved
+ *       state.flip();  // hand the new state to the analysis side
+ *   }
+ * \endcode
+ *
+ * \author Seb James
+ * \date August 2026
+ */
+#pragma once
+
+#include <vector>
+#include <array>
+#include <string>
+#include <functional>
+#include <exception>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <cstddef>
+#include <stdexcept>
+#include <morph/threadpool.h>
+
+namespace morph {
+
+    /*!
+     * Two buffers of T with a front/back distinction, for handing data between
+     * pipelined stages. Within one TaskGraph::run(), the producing node writes
+     * back() while consuming nodes read front(); these touch different objects, so
+     * no locking is needed. flip() swaps the roles and must be called from the
+     * single-threaded code between run() calls, never from inside a task.
+     */
+    template <typename T>
+    struct DoubleBuffer
+    {
+        //! The buffer for consumers to read - the producer's output from before the
+        //! last flip()
+        T& front() { return this->bufs[this->fidx]; }
+        const T& front() const { return this->bufs[this->fidx]; }
+
+        //! The buffer for the producer to write
+        T& back() { return this->bufs[1 - this->fidx]; }
+        const T& back() const { return this->bufs[1 - this->fidx]; }
+
+        //! Swap the roles of the buffers. Call between TaskGraph::run() calls.
+        void flip() { this->fidx = 1 - this->fidx; }
+
+    private:
+        std::array<T, 2> bufs;
+        std::size_t fidx = 0;
+    };
+
+    //! A graph of dependent tasks, executed on a morph::threadpool
+    class TaskGraph
+    {
+    public:
+        //! Add a task node. \a name is for error messages; \a work is what the node
+        //! does. \return the node's id, for use with depends().
+        std::size_t add (const std::string& name, std::function<void()> work)
+        {
+            this->nodes.push_back (node{});
+            this->nodes.back().name = name;
+            this->nodes.back().work = std::move (work);
+            return this->nodes.size() - 1;
+        }
+
+        //! Declare that node \a child may only run after node \a parent has completed
+        void depends (const std::size_t child, const std::size_t parent)
+        {
+            if (child >= this->nodes.size() || parent >= this->nodes.size()) {
+                throw std::runtime_error ("TaskGraph::depends: no such node");
+            }
+            if (child == parent) {
+                throw std::runtime_error ("TaskGraph::depends: node '" + this->nodes[child].name
+                                          + "' cannot depend on itself");
+            }
+            this->nodes[parent].children.push_back (child);
+            ++this->nodes[child].n_parents;
+        }
+
+        //! The number of task nodes
+        std::size_t size() const { return this->nodes.size(); }
+
+        /*!
+         * Execute the graph on \a pool (the process-wide pool by default). Nodes
+         * whose dependencies are satisfied run concurrently; run() returns when
+         * every node has completed. Throws if the dependencies contain a cycle; an
+         * exception from a node's work is rethrown here (the first of them, if
+         * several nodes throw) after the remaining runnable nodes are skipped. Call
+         * from outside the pool's own workers.
+         */
+        void run (morph::threadpool& pool = morph::threadpool::global())
+        {
+            const std::size_t n = this->nodes.size();
+            if (n == 0) { return; }
+            this->check_acyclic();
+
+            auto st = std::make_shared<run_state>(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                st->n_waiting[i].store (this->nodes[i].n_parents);
+            }
+
+            // The recursive executor: run node i, then release its children,
+            // submitting any which become runnable
+            auto exec = std::make_shared<std::function<void (std::size_t)>>();
+            *exec = [this, st, exec, &pool] (const std::size_t i) {
+                bool failed = false;
+                {
+                    std::lock_guard<std::mutex> lk (st->mtx);
+                    failed = (st->eptr != nullptr);
+                }
+                if (!failed) {
+                    try {
+                        this->nodes[i].work();
+                    } catch (...) {
+                        std::lock_guard<std::mutex> lk (st->mtx);
+                        if (!st->eptr) { st->eptr = std::current_exception(); }
+                    }
+                }
+                for (const std::size_t c : this->nodes[i].children) {
+                    if (st->n_waiting[c].fetch_sub (1) == 1) {
+                        pool.run ([exec, c] { (*exec) (c); });
+                    }
+                }
+                if (st->n_done.fetch_add (1) + 1 == st->n_waiting.size()) {
+                    std::lock_guard<std::mutex> lk (st->mtx);
+                    st->cv.notify_all();
+                }
+            };
+
+            // Submit the root nodes; everything else follows from them
+            for (std::size_t i = 0; i < n; ++i) {
+                if (this->nodes[i].n_parents == 0) {
+                    pool.run ([exec, i] { (*exec) (i); });
+                }
+            }
+
+            std::unique_lock<std::mutex> lk (st->mtx);
+            st->cv.wait (lk, [&st, n] { return st->n_done.load() >= n; });
+            if (st->eptr) { std::rethrow_exception (st->eptr); }
+        }
+
+    private:
+        //! One task node
+        struct node
+        {
+            std::string name;
+            std::function<void()> work;
+            //! Nodes which may only run after this one
+            std::vector<std::size_t> children;
+            //! How many nodes this one waits for
+            unsigned int n_parents = 0;
+        };
+
+        //! The state shared by one run()'s executors
+        struct run_state
+        {
+            explicit run_state (const std::size_t n) : n_waiting (n) {}
+            //! Per-node count of incomplete parents
+            std::vector<std::atomic<unsigned int>> n_waiting;
+            std::atomic<std::size_t> n_done = 0;
+            std::mutex mtx;
+            std::condition_variable cv;
+            std::exception_ptr eptr = nullptr;
+        };
+
+        //! Kahn's algorithm: if the nodes cannot be topologically ordered, the
+        //! dependencies contain a cycle and run() would never complete
+        void check_acyclic() const
+        {
+            std::vector<unsigned int> waiting (this->nodes.size());
+            std::vector<std::size_t> ready;
+            for (std::size_t i = 0; i < this->nodes.size(); ++i) {
+                waiting[i] = this->nodes[i].n_parents;
+                if (waiting[i] == 0) { ready.push_back (i); }
+            }
+            std::size_t n_ordered = 0;
+            while (!ready.empty()) {
+                const std::size_t i = ready.back();
+                ready.pop_back();
+                ++n_ordered;
+                for (const std::size_t c : this->nodes[i].children) {
+                    if (--waiting[c] == 0) { ready.push_back (c); }
+                }
+            }
+            if (n_ordered != this->nodes.size()) {
+                throw std::runtime_error ("TaskGraph::run: the dependencies contain a cycle");
+            }
+        }
+
+        //! The task nodes; ids are indices into this vector
+        std::vector<node> nodes;
+    };
+
+} // namespace morph
@@ -47,6 +47,15 @@ namespace morph {
         //! The supported font to use when displaying a text string
         morph::VisualFont font = morph::VisualFont::DVSans;
 
+        /*!
+         * If true, render this text from a signed-distance-field glyph atlas. The
+         * face's glyphs are stored as distance fields and thresholded with smoothstep
+         * in the fragment shader, so the text stays crisp at any zoom from a single
+         * moderate-resolution texture, instead of needing a large fontres (and a
+         * large texture) per size.
+         */
+        bool sdf = false;
+
         // Maybe also things like rotate, centre_vert, etc
     };
 
@@ -0,0 +1,203 @@
+/*!
+ * \file
+ *
+ * A ColourBarVisual whose gradient is one textured quad. ColourBarVisual tessellates
+ * numsegs (256 by default) quads through ColourMap::convert to paint the gradient, and
+ * every figure window carries one or more colour bars which are rebuilt on each
+ * rescale. TexturedColourBarVisual instead draws a single quad whose fragment shader
+ * samples the ColourMap's look-up-table texture (as TexturedGridVisual does), so a
+ * rebuild re-tessellates only the frame, ticks and labels.
+ *
+ * Note: this class makes direct (global alias) OpenGL calls, like the morph::gl
+ * compute subsystem, so use it with morph::VisualNoMX (not the multicontext
+ * morph::Visual).
+ *
+ * \author Seb James
+ * \date August 2026
+ */
+#pragma once
+
+#include <morph/gl/version.h>
+#include <morph/gl/shaders.h>
+#include <morph/gl/loadshaders_nomx.h>
+#include <morph/ColourBarVisual.h>
+#include <morph/VisualDefaultShaders.h>
+#include <morph/vec.h>
+#include <array>
+#include <vector>
+
+namespace morph {
+
+    //! A ColourBarVisual with a GPU-painted gradient. F is the type of the data.
+    template <typename F, int glver = morph::gl::version_4_1>
+    class TexturedColourBarVisual : public ColourBarVisual<F, glver>
+    {
+    public:
+        TexturedColourBarVisual (const vec<float> _offset)
+            : ColourBarVisual<F, glver> (_offset)
+        {
+            this->gradient_on_gpu = true;
+        }
+
+        ~TexturedColourBarVisual()
+        {
+            if (this->lut_texture != 0) { glDeleteTextures (1, &this->lut_texture); }
+            if (this->quad_ibo != 0) { glDeleteBuffers (1, &this->quad_ibo); }
+            if (this->quad_vbo_uv != 0) { glDeleteBuffers (1, &this->quad_vbo_uv); }
+            if (this->quad_vbo_pos != 0) { glDeleteBuffers (1, &this->quad_vbo_pos); }
+            if (this->quad_vao != 0) { glDeleteVertexArrays (1, &this->quad_vao); }
+            if (this->bar_prog != 0) { glDeleteProgram (this->bar_prog); }
+        }
+
+        //! The frame, ticks and labels tessellate as usual (gradient_on_gpu suppresses
+        //! fillFrameWithColour); here we additionally (re)compute the gradient quad's
+        //! corners
+        void initializeVertices()
+        {
+            ColourBarVisual<F, glver>::initializeVertices();
+
+            morph::vec<float, 2> extents = { this->width, this->length };
+            if (this->orientation == colourbar_orientation::horizontal) { extents = { this->length, this->width }; }
+            this->quad_pos = { 0.0f,        0.0f,        this->z,
+                               extents.x(), 0.0f,        this->z,
+                               extents.x(), extents.y(), this->z,
+                               0.0f,        extents.y(), this->z };
+            // The first texture coordinate is the colour map index: it runs 0->1 along
+            // the bar (left to right, or bottom to top)
+            if (this->orientation == colourbar_orientation::horizontal) {
+                this->quad_uv = { 0.0f, 0.0f,  1.0f, 0.0f,  1.0f, 0.0f,  0.0f, 0.0f };
+            } else {
+                this->quad_uv = { 0.0f, 0.0f,  0.0f, 0.0f,  1.0f, 0.0f,  1.0f, 0.0f };
+            }
+            this->quad_pending = true;
+        }
+
+        //! Render the frame/tick/label geometry as usual, then draw the gradient quad
+        //! with the colour bar shader program. GL objects are created lazily here, as
+        //! render() is the call that is guaranteed a current OpenGL context.
+        void render()
+        {
+            ColourBarVisual<F, glver>::render();
+
+            if (this->hide == true) { return; }
+            if (this->bar_prog == 0) { this->init_gl_objects(); }
+            if (this->quad_pending == true) { this->upload_quad(); }
+
+            GLint prev_shader = 0;
+            glGetIntegerv (GL_CURRENT_PROGRAM, &prev_shader);
+
+            // The projection matrix is owned by the parent Visual, which sets it on the
+            // scene's graphics program each frame; copy it over to our program.
+            GLuint gprog = this->get_gprog (this->parentVis);
+            std::array<float, 16> pmat;
+            GLint ploc = glGetUniformLocation (gprog, static_cast<const GLchar*>("p_matrix"));
+            if (ploc != -1) { glGetUniformfv (gprog, ploc, pmat.data()); }
+
+            glUseProgram (this->bar_prog);
+            GLint loc_p = glGetUniformLocation (this->bar_prog, static_cast<const GLchar*>("p_matrix"));
+            if (loc_p != -1 && ploc != -1) { glUniformMatrix4fv (loc_p, 1, GL_FALSE, pmat.data()); }
+            GLint loc_v = glGetUniformLocation (this->bar_prog, static_cast<const GLchar*>("v_matrix"));
+            if (loc_v != -1) { glUniformMatrix4fv (loc_v, 1, GL_FALSE, this->scenematrix.mat.data()); }
+            GLint loc_m = glGetUniformLocation (this->bar_prog, static_cast<const GLchar*>("m_matrix"));
+            if (loc_m != -1) { glUniformMatrix4fv (loc_m, 1, GL_FALSE, (this->model_scaling * this->viewmatrix).mat.data()); }
+            GLint loc_a = glGetUniformLocation (this->bar_prog, static_cast<const GLchar*>("alpha"));
+            if (loc_a != -1) { glUniform1f (loc_a, this->alpha); }
+
+            glActiveTexture (GL_TEXTURE0);
+            glBindTexture (GL_TEXTURE_2D, this->lut_texture);
+
+            glBindVertexArray (this->quad_vao);
+            glDrawElements (GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+            glBindVertexArray (0);
+
+            glUseProgram (prev_shader);
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+        }
+
+    protected:
+        //! Create our shader program, the quad's vertex array and the 256x1 colour map
+        //! LUT texture. Requires a current OpenGL context.
+        void init_gl_objects()
+        {
+            // The textured grid vertex shader carries texture coordinates in the
+            // standard colour attribute, which suits the gradient quad too
+            std::vector<morph::gl::ShaderInfo> shaders = {
+                {GL_VERTEX_SHADER, "TexturedColourBarVisual.vert.glsl", morph::getTexturedGridVtxShader (glver), 0 },
+                {GL_FRAGMENT_SHADER, "TexturedColourBarVisual.frag.glsl", morph::getColourBarFragShader (glver), 0 }
+            };
+            this->bar_prog = morph::gl::LoadShaders (shaders);
+
+            glGenVertexArrays (1, &this->quad_vao);
+            glBindVertexArray (this->quad_vao);
+
+            glGenBuffers (1, &this->quad_vbo_pos);
+            glBindBuffer (GL_ARRAY_BUFFER, this->quad_vbo_pos);
+            glBufferData (GL_ARRAY_BUFFER, 12 * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+            glVertexAttribPointer (0, 3, GL_FLOAT, GL_FALSE, 0, (void*)(0));
+            glEnableVertexAttribArray (0);
+
+            glGenBuffers (1, &this->quad_vbo_uv);
+            glBindBuffer (GL_ARRAY_BUFFER, this->quad_vbo_uv);
+            glBufferData (GL_ARRAY_BUFFER, 8 * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+            glVertexAttribPointer (2, 2, GL_FLOAT, GL_FALSE, 0, (void*)(0));
+            glEnableVertexAttribArray (2);
+
+            constexpr std::array<unsigned int, 6> qindices = { 0, 1, 2,  0, 2, 3 };
+            glGenBuffers (1, &this->quad_ibo);
+            glBindBuffer (GL_ELEMENT_ARRAY_BUFFER, this->quad_ibo);
+            glBufferData (GL_ELEMENT_ARRAY_BUFFER, 6 * sizeof(unsigned int), qindices.data(), GL_STATIC_DRAW);
+
+            glBindVertexArray (0);
+
+            constexpr unsigned int lutsz = 256;
+            glGenTextures (1, &this->lut_texture);
+            glBindTexture (GL_TEXTURE_2D, this->lut_texture);
+            glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexImage2D (GL_TEXTURE_2D, 0, GL_RGB32F, lutsz, 1, 0, GL_RGB, GL_FLOAT, nullptr);
+
+            glUseProgram (this->bar_prog);
+            GLint loc_l = glGetUniformLocation (this->bar_prog, static_cast<const GLchar*>("lut"));
+            if (loc_l != -1) { glUniform1i (loc_l, 0); }
+
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+        }
+
+        //! Upload the quad corners and re-sample the ColourMap into the LUT texture
+        //! (so that a reinit after a colour map change shows the new map)
+        void upload_quad()
+        {
+            glBindBuffer (GL_ARRAY_BUFFER, this->quad_vbo_pos);
+            glBufferSubData (GL_ARRAY_BUFFER, 0, 12 * sizeof(float), this->quad_pos.data());
+            glBindBuffer (GL_ARRAY_BUFFER, this->quad_vbo_uv);
+            glBufferSubData (GL_ARRAY_BUFFER, 0, 8 * sizeof(float), this->quad_uv.data());
+
+            constexpr unsigned int lutsz = 256;
+            std::vector<std::array<float, 3>> lutdata = this->cm.makeLut (lutsz);
+            glBindTexture (GL_TEXTURE_2D, this->lut_texture);
+            glTexSubImage2D (GL_TEXTURE_2D, 0, 0, 0, lutsz, 1, GL_RGB, GL_FLOAT, lutdata.data()->data());
+
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+            this->quad_pending = false;
+        }
+
+        //! The gradient quad's corner positions (4 x 3 floats)
+        std::array<float, 12> quad_pos = { 0.0f };
+        //! The gradient quad's texture coordinates (4 x 2 floats)
+        std::array<float, 8> quad_uv = { 0.0f };
+        //! True when the quad corners or the colour map need (re-)uploading
+        bool quad_pending = false;
+        //! The gradient quad's vertex array and buffers
+        GLuint quad_vao = 0;
+        GLuint quad_vbo_pos = 0;
+        GLuint quad_vbo_uv = 0;
+        GLuint quad_ibo = 0;
+        //! The 256x1 RGB texture holding the colour map look-up-table
+        GLuint lut_texture = 0;
+        //! Our shader program, which paints the gradient from the LUT
+        GLuint bar_prog = 0;
+    };
+
+} // namespace morph
@@ -0,0 +1,315 @@
+/*!
+ * \file
+ *
+ * A texture-backed CurvyTellyVisual for video display. CurvyTellyVisual shows image
+ * data by recolouring every Grid element's vertices on the CPU each frame, which caps
+ * a 60 FPS camera feed well below its frame rate. TexturedCurvyTellyVisual builds the
+ * curved screen ONCE, as a mesh with texture coordinates, and streams frames into a GL
+ * texture through the morph::gl::texture_streamer PBO ring - so a new video frame is a
+ * memcpy into acquireFrame()'s pointer plus a DMA transfer, with no geometry work.
+ * The telly's border frames draw exactly as in CurvyTellyVisual.
+ *
+ * Note: this class makes direct (global alias) OpenGL calls, like the morph::gl
+ * compute subsystem, so use it with morph::VisualNoMX (not the multicontext
+ * morph::Visual).
+ *
+ * \author Seb James
+ * \date August 2026
+ */
+#pragma once
+
+#include <morph/gl/version.h>
+#include <morph/gl/shaders.h>
+#include <morph/gl/loadshaders_nomx.h>
+#include <morph/gl/texture.h>
+#include <morph/CurvyTellyVisual.h>
+#include <morph/VisualDefaultShaders.h>
+#include <morph/vec.h>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace morph {
+
+    /*!
+     * TexturedCurvyTellyVisual: a curved video screen
+     *
+     * \tparam T the type of the *data* (unused here - frames arrive as pixels - but
+     * kept so the class slots in where a CurvyTellyVisual would)
+     *
+     * \tparam I The type for the Grid indexing (defaults to unsigned int)
+     *
+     * \tparam C The type for the Grid coordinates (default float, must be a signed type)
+     *
+     * \tparam glver The OpenGL version in use in your program
+     */
+    template <typename T, typename I = unsigned int, typename C = float, int glver = morph::gl::version_4_1>
+    struct TexturedCurvyTellyVisual : public morph::CurvyTellyVisual<T, I, C, glver>
+    {
+        TexturedCurvyTellyVisual (const morph::Grid<I, C>* _cg, const morph::vec<float> _offset)
+            : morph::CurvyTellyVisual<T, I, C, glver> (_cg, _offset) {}
+
+        ~TexturedCurvyTellyVisual()
+        {
+            this->frames.deinit();
+            if (this->screen_ibo != 0) { glDeleteBuffers (1, &this->screen_ibo); }
+            if (this->screen_vbo_uv != 0) { glDeleteBuffers (1, &this->screen_vbo_uv); }
+            if (this->screen_vbo_pos != 0) { glDeleteBuffers (1, &this->screen_vbo_pos); }
+            if (this->screen_vao != 0) { glDeleteVertexArrays (1, &this->screen_vao); }
+            if (this->telly_prog != 0) { glDeleteProgram (this->telly_prog); }
+        }
+
+        //! The pixel size of the video frames. Set before the first acquireFrame()
+        //! call (along with frame_format/frame_type if your frames aren't RGBA bytes).
+        morph::vec<GLsizei, 2> frame_dims = { 0, 0 };
+        GLenum frame_internal_format = GL_RGBA8;
+        GLenum frame_format = GL_RGBA;
+        GLenum frame_type = GL_UNSIGNED_BYTE;
+        std::size_t frame_bytes_per_pixel = 4;
+
+        //! Camera and video frames are normally delivered top row first; flipping the
+        //! v texture coordinate shows them upright. Set false for bottom-first frames.
+        bool flip_v = true;
+
+        //! The streamed-frame texture and its PBO ring (frames.frame_bytes tells you
+        //! how much to write per acquireFrame())
+        morph::gl::texture_streamer frames;
+
+        /*!
+         * Return a write-only pointer for the next video frame; write
+         * frames.frame_bytes of pixel data into it and call commitFrame(). Needs a
+         * current OpenGL context (call from the render thread). The PBO ring means
+         * this waits only if you run more than two frames ahead of the renderer.
+         */
+        void* acquireFrame()
+        {
+            if (this->frames.texture_id == 0) {
+                if (this->frame_dims[0] <= 0 || this->frame_dims[1] <= 0) {
+                    throw std::runtime_error ("TexturedCurvyTellyVisual: set frame_dims before acquireFrame()");
+                }
+                this->frames.init (0, this->frame_dims, this->frame_internal_format,
+                                   this->frame_format, this->frame_type, this->frame_bytes_per_pixel);
+            }
+            return this->frames.acquire();
+        }
+
+        //! Hand the frame written since acquireFrame() to the GPU (a DMA transfer
+        //! from the PBO; the texture shows it once the transfer completes)
+        void commitFrame() { this->frames.commit(); }
+
+        //! Build the curved screen as a (w+1)x(h+1) vertex mesh with texture
+        //! coordinates (kept in side buffers for our shader program) and tessellate
+        //! only the border frames into the standard vertex buffers.
+        void initializeVertices()
+        {
+            if (this->options.test (morph::gridvisual_flags::centralize) == true) {
+                this->centering_offset = -this->grid->centre().plus_one_dim();
+            }
+
+            const morph::vec<float, 2> dx = this->grid->get_dx();
+            const float hx = 0.5f * dx[0];
+            const float vy = 0.5f * dx[1];
+            const morph::vec<C, 4> ext = this->grid->extents(); // {xmin, xmax, ymin, ymax}
+            const float angle_per_distance = this->angle_to_subtend / (dx[0] + this->grid->width());
+            const unsigned int nu = static_cast<unsigned int>(this->grid->get_w());
+            const unsigned int nv = static_cast<unsigned int>(this->grid->get_h());
+
+            // The mesh spans the same region as CurvyTellyVisual's rectangles: the
+            // grid extents plus the half-element margin
+            const float x0 = static_cast<float>(ext[0]) + this->centering_offset[0] - hx;
+            const float xspan = static_cast<float>(this->grid->width()) + dx[0];
+            const float z0 = static_cast<float>(ext[2]) + this->centering_offset[1] - vy;
+            const float zspan = static_cast<float>(this->grid->height()) + dx[1];
+
+            this->screen_pos.clear();
+            this->screen_uv.clear();
+            this->screen_idx.clear();
+            morph::vec<float> centroid = { 0.0f, 0.0f, 0.0f };
+            for (unsigned int jv = 0; jv <= nv; ++jv) {
+                const float vfrac = static_cast<float>(jv) / static_cast<float>(nv);
+                const float z = z0 + vfrac * zspan;
+                for (unsigned int ju = 0; ju <= nu; ++ju) {
+                    const float ufrac = static_cast<float>(ju) / static_cast<float>(nu);
+                    // -x on Grid becomes +angle on the telly, as in CurvyTellyVisual
+                    const float _x = -(x0 + ufrac * xspan);
+                    const float ang = this->rotoff + _x * angle_per_distance;
+                    const morph::vec<float> p = {
+                        static_cast<float>(this->radius) * std::cos (ang),
+                        static_cast<float>(this->radius) * std::sin (ang),
+                        z
+                    };
+                    this->screen_pos.push_back (p[0]);
+                    this->screen_pos.push_back (p[1]);
+                    this->screen_pos.push_back (p[2]);
+                    this->screen_uv.push_back (ufrac);
+                    this->screen_uv.push_back (this->flip_v == true ? 1.0f - vfrac : vfrac);
+                    centroid += p;
+                }
+            }
+            centroid /= static_cast<float>((nu + 1u) * (nv + 1u));
+            for (unsigned int vi = 0; vi < this->screen_pos.size() / 3u; ++vi) {
+                this->screen_pos[vi * 3u]      -= centroid[0];
+                this->screen_pos[vi * 3u + 1u] -= centroid[1];
+                this->screen_pos[vi * 3u + 2u] -= centroid[2];
+            }
+            for (unsigned int jv = 0; jv < nv; ++jv) {
+                for (unsigned int ju = 0; ju < nu; ++ju) {
+                    const unsigned int a = jv * (nu + 1u) + ju;
+                    const unsigned int b = a + 1u;
+                    const unsigned int c = a + nu + 1u;
+                    const unsigned int d = c + 1u;
+                    this->screen_idx.push_back (a);
+                    this->screen_idx.push_back (b);
+                    this->screen_idx.push_back (d);
+                    this->screen_idx.push_back (a);
+                    this->screen_idx.push_back (d);
+                    this->screen_idx.push_back (c);
+                }
+            }
+            this->screen_pending = true;
+
+            // The border frames go into the standard vertex buffers (drawn by the
+            // scene's graphics program), using the mesh's edge vertices
+            auto meshvtx = [this, nu] (unsigned int jv, unsigned int ju) {
+                const unsigned int i = 3u * (jv * (nu + 1u) + ju);
+                return morph::vec<float>{ this->screen_pos[i], this->screen_pos[i + 1u], this->screen_pos[i + 2u] };
+            };
+            if (this->tb_frames == true) {
+                for (unsigned int ju = 0; ju < nu; ++ju) {
+                    this->draw_top_border (meshvtx (nv, ju), meshvtx (nv, ju + 1u));
+                    this->draw_bottom_border (meshvtx (0, ju), meshvtx (0, ju + 1u));
+                }
+            }
+            if (this->lr_frames == true) {
+                for (unsigned int jv = 0; jv < nv; ++jv) {
+                    this->draw_edge_border (meshvtx (jv + 1u, 0), meshvtx (jv, 0), meshvtx (jv + 1u, 1u));
+                    this->draw_edge_border (meshvtx (jv + 1u, nu), meshvtx (jv, nu), meshvtx (jv + 1u, nu - 1u));
+                }
+            }
+            if (this->tb_frames == true && this->lr_frames == true) {
+                // Corner fill-ins, as CurvyTellyVisual draws
+                for (const unsigned int e : { 0u, nu }) {
+                    const unsigned int ci = (e == 0u) ? 1u : nu - 1u;
+                    morph::vec<float> a = meshvtx (nv, e);
+                    morph::vec<float> a_up = a;
+                    a_up[2] += this->frame_width;
+                    morph::vec<float> c_up = meshvtx (nv, ci);
+                    c_up[2] += this->frame_width;
+                    this->draw_edge_border (a_up, a, c_up);
+                    a = meshvtx (0, e);
+                    morph::vec<float> a_dn = a;
+                    a_dn[2] -= this->frame_width;
+                    this->draw_edge_border (a, a_dn, meshvtx (0, ci));
+                }
+            }
+        }
+
+        //! Render the border frames as usual, then the screen mesh with the video
+        //! texture shader. GL objects are created lazily here, as render() is the
+        //! call that is guaranteed a current OpenGL context.
+        void render()
+        {
+            morph::CurvyTellyVisual<T, I, C, glver>::render();
+
+            if (this->hide == true) { return; }
+            if (this->telly_prog == 0) { this->init_gl_objects(); }
+            if (this->screen_pending == true) { this->upload_screen(); }
+            if (this->screen_idx.empty()) { return; }
+
+            GLint prev_shader = 0;
+            glGetIntegerv (GL_CURRENT_PROGRAM, &prev_shader);
+
+            // The projection matrix is owned by the parent Visual, which sets it on the
+            // scene's graphics program each frame; copy it over to our program.
+            GLuint gprog = this->get_gprog (this->parentVis);
+            std::array<float, 16> pmat;
+            GLint ploc = glGetUniformLocation (gprog, static_cast<const GLchar*>("p_matrix"));
+            if (ploc != -1) { glGetUniformfv (gprog, ploc, pmat.data()); }
+
+            glUseProgram (this->telly_prog);
+            GLint loc_p = glGetUniformLocation (this->telly_prog, static_cast<const GLchar*>("p_matrix"));
+            if (loc_p != -1 && ploc != -1) { glUniformMatrix4fv (loc_p, 1, GL_FALSE, pmat.data()); }
+            GLint loc_v = glGetUniformLocation (this->telly_prog, static_cast<const GLchar*>("v_matrix"));
+            if (loc_v != -1) { glUniformMatrix4fv (loc_v, 1, GL_FALSE, this->scenematrix.mat.data()); }
+            GLint loc_m = glGetUniformLocation (this->telly_prog, static_cast<const GLchar*>("m_matrix"));
+            if (loc_m != -1) { glUniformMatrix4fv (loc_m, 1, GL_FALSE, (this->model_scaling * this->viewmatrix).mat.data()); }
+            GLint loc_a = glGetUniformLocation (this->telly_prog, static_cast<const GLchar*>("alpha"));
+            if (loc_a != -1) { glUniform1f (loc_a, this->alpha); }
+
+            glActiveTexture (GL_TEXTURE0);
+            glBindTexture (GL_TEXTURE_2D, this->frames.texture_id);
+
+            glBindVertexArray (this->screen_vao);
+            glDrawElements (GL_TRIANGLES, static_cast<GLsizei>(this->screen_idx.size()), GL_UNSIGNED_INT, 0);
+            glBindVertexArray (0);
+
+            glUseProgram (prev_shader);
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+        }
+
+    protected:
+        //! Create our shader program and the screen mesh's vertex array. Requires a
+        //! current OpenGL context.
+        void init_gl_objects()
+        {
+            // The textured grid vertex shader carries texture coordinates in the
+            // standard colour attribute, which suits the screen mesh too
+            std::vector<morph::gl::ShaderInfo> shaders = {
+                {GL_VERTEX_SHADER, "TexturedCurvyTellyVisual.vert.glsl", morph::getTexturedGridVtxShader (glver), 0 },
+                {GL_FRAGMENT_SHADER, "TexturedCurvyTellyVisual.frag.glsl", morph::getVideoFragShader (glver), 0 }
+            };
+            this->telly_prog = morph::gl::LoadShaders (shaders);
+
+            glGenVertexArrays (1, &this->screen_vao);
+            glBindVertexArray (this->screen_vao);
+            glGenBuffers (1, &this->screen_vbo_pos);
+            glBindBuffer (GL_ARRAY_BUFFER, this->screen_vbo_pos);
+            glVertexAttribPointer (0, 3, GL_FLOAT, GL_FALSE, 0, (void*)(0));
+            glEnableVertexAttribArray (0);
+            glGenBuffers (1, &this->screen_vbo_uv);
+            glBindBuffer (GL_ARRAY_BUFFER, this->screen_vbo_uv);
+            glVertexAttribPointer (2, 2, GL_FLOAT, GL_FALSE, 0, (void*)(0));
+            glEnableVertexAttribArray (2);
+            glGenBuffers (1, &this->screen_ibo);
+            glBindBuffer (GL_ELEMENT_ARRAY_BUFFER, this->screen_ibo);
+            glBindVertexArray (0);
+
+            glUseProgram (this->telly_prog);
+            GLint loc_f = glGetUniformLocation (this->telly_prog, static_cast<const GLchar*>("frametex"));
+            if (loc_f != -1) { glUniform1i (loc_f, 0); }
+
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+        }
+
+        //! Upload the screen mesh. This happens once per (re)init, not per video frame.
+        void upload_screen()
+        {
+            glBindVertexArray (this->screen_vao); // the element buffer binding is VAO state
+            glBindBuffer (GL_ARRAY_BUFFER, this->screen_vbo_pos);
+            glBufferData (GL_ARRAY_BUFFER, this->screen_pos.size() * sizeof(float), this->screen_pos.data(), GL_STATIC_DRAW);
+            glBindBuffer (GL_ARRAY_BUFFER, this->screen_vbo_uv);
+            glBufferData (GL_ARRAY_BUFFER, this->screen_uv.size() * sizeof(float), this->screen_uv.data(), GL_STATIC_DRAW);
+            glBindBuffer (GL_ELEMENT_ARRAY_BUFFER, this->screen_ibo);
+            glBufferData (GL_ELEMENT_ARRAY_BUFFER, this->screen_idx.size() * sizeof(unsigned int), this->screen_idx.data(), GL_STATIC_DRAW);
+            glBindVertexArray (0);
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+            this->screen_pending = false;
+        }
+
+        //! The screen mesh: positions, texture coordinates and triangle indices
+        std::vector<float> screen_pos;
+        std::vector<float> screen_uv;
+        std::vector<unsigned int> screen_idx;
+        //! True when the screen mesh needs (re-)uploading
+        bool screen_pending = false;
+        //! The screen mesh's vertex array and buffers
+        GLuint screen_vao = 0;
+        GLuint screen_vbo_pos = 0;
+        GLuint screen_vbo_uv = 0;
+        GLuint screen_ibo = 0;
+        //! Our shader program, which textures the screen with the streamed frames
+        GLuint telly_prog = 0;
+    };
+
+} // namespace morph
@@ -0,0 +1,268 @@
+/*!
+ * \file
+ *
+ * A texture-backed visualizer for morph::Grid. Where GridVisual emits geometry per grid
+ * element (5 vertices per element in RectInterp mode - about 8 million vertices for a
+ * 2048x2048 Grid, all regenerated on every update), TexturedGridVisual draws a single
+ * quad and samples the scalar field from a single-channel GL texture, doing the colour
+ * mapping in the fragment shader via a look-up-table texture built from the model's
+ * ColourMap. An update is then just a glTexSubImage2D upload of the new field values.
+ *
+ * The trade-offs with respect to GridVisual: the surface is rendered flat (no z
+ * displacement from the data - zScale is ignored) and unlit. Use it for big,
+ * frequently-updated 2D fields; use GridVisual when you want 3D relief or columns.
+ *
+ * Note: this class makes direct (global alias) OpenGL calls, like the morph::gl
+ * compute subsystem, so use it with morph::VisualNoMX (not the multicontext
+ * morph::Visual).
+ *
+ * \author Seb James
+ * \date August 2026
+ */
+#pragma once
+
+#include <morph/gl/version.h>
+#include <morph/gl/shaders.h>
+#include <morph/gl/loadshaders_nomx.h>
+#include <morph/VisualDataModel.h>
+#include <morph/VisualDefaultShaders.h>
+#include <morph/ColourMap.h>
+#include <morph/Grid.h>
+#include <morph/vec.h>
+#include <morph/range.h>
+#include <vector>
+#include <array>
+#include <stdexcept>
+
+namespace morph {
+
+    /*!
+     * TexturedGridVisual: a texture-backed visualizer for the morph::Grid class
+     *
+     * \tparam T the type of the *data* which this TexturedGridVisual will visualize.
+     *
+     * \tparam I The type for the Grid indexing (defaults to unsigned int)
+     *
+     * \tparam C The type for the Grid coordinates (default float, must be a signed type)
+     *
+     * \tparam glver The OpenGL version in use in your program
+     */
+    template <typename T, typename I = unsigned int, typename C = float, int glver = morph::gl::version_4_1>
+    class TexturedGridVisual : public VisualDataModel<T, glver>
+    {
+    public:
+        TexturedGridVisual (const morph::Grid<I, C>* _grid, const vec<float> _offset)
+        {
+            morph::vec<float> pixel_offset = _grid->get_dx().plus_one_dim (0.0f);
+            this->mv_offset = _offset + pixel_offset;
+            this->viewmatrix.translate (this->mv_offset);
+            this->colourScale.do_autoscale = true;
+            this->grid = _grid;
+            // Note: VisualModel::finalize() should be called before rendering
+        }
+
+        ~TexturedGridVisual()
+        {
+            if (this->data_texture != 0) { glDeleteTextures (1, &this->data_texture); }
+            if (this->lut_texture != 0) { glDeleteTextures (1, &this->lut_texture); }
+            if (this->surface_prog != 0) { glDeleteProgram (this->surface_prog); }
+        }
+
+        //! The geometry is just one quad covering the grid's extents (plus the
+        //! half-element margin that RectInterp mode would cover). Texture coordinates
+        //! for the corners ride in the standard colour attribute, which the textured
+        //! grid vertex shader interprets as such.
+        void initializeVertices()
+        {
+            if (this->grid == nullptr) {
+                throw std::runtime_error ("TexturedGridVisual: grid is nullptr");
+            }
+            morph::vec<C, 4> ext = this->grid->extents(); // {xmin, xmax, ymin, ymax}
+            morph::vec<C, 2> dx = this->grid->get_dx();
+            float left  = static_cast<float>(ext[0] - dx[0] / C{2});
+            float right = static_cast<float>(ext[1] + dx[0] / C{2});
+            float bot   = static_cast<float>(ext[2] - dx[1] / C{2});
+            float top   = static_cast<float>(ext[3] + dx[1] / C{2});
+
+            this->vertexPositions = { left, bot, 0.0f,   right, bot, 0.0f,
+                                      right, top, 0.0f,  left, top, 0.0f };
+            this->vertexNormals = { 0.0f, 0.0f, 1.0f,  0.0f, 0.0f, 1.0f,
+                                    0.0f, 0.0f, 1.0f,  0.0f, 0.0f, 1.0f };
+            // Texture coords (u, v, unused). Texture row 0 is the bottom row of the grid
+            this->vertexColors = { 0.0f, 0.0f, 0.0f,  1.0f, 0.0f, 0.0f,
+                                   1.0f, 1.0f, 0.0f,  0.0f, 1.0f, 0.0f };
+            this->indices = { 0, 1, 2,  0, 2, 3 };
+            this->idx = 4;
+            this->data_pending = true;
+        }
+
+        //! Updating the data costs one texture sub-image upload (at the next render);
+        //! no geometry is regenerated.
+        void updateData (const std::vector<T>* _data)
+        {
+            this->scalarData = _data;
+            this->data_pending = true;
+        }
+
+        //! Render with our own shader program, sampling the field texture and the
+        //! colour map LUT. GL objects are created lazily here, as render() is the call
+        //! that is guaranteed a current OpenGL context.
+        void render()
+        {
+            if (this->hide == true) { return; }
+
+            if (this->postVertexInitRequired == true) { this->postVertexInit(); }
+            if (this->surface_prog == 0) { this->init_gl_objects(); }
+            if (this->data_pending == true) { this->upload_data(); }
+
+            GLint prev_shader = 0;
+            glGetIntegerv (GL_CURRENT_PROGRAM, &prev_shader);
+
+            // The projection matrix is owned by the parent Visual, which sets it on the
+            // scene's graphics program each frame; copy it over to our program.
+            GLuint gprog = this->get_gprog (this->parentVis);
+            std::array<float, 16> pmat;
+            GLint ploc = glGetUniformLocation (gprog, static_cast<const GLchar*>("p_matrix"));
+            if (ploc != -1) { glGetUniformfv (gprog, ploc, pmat.data()); }
+
+            glUseProgram (this->surface_prog);
+            GLint loc_p = glGetUniformLocation (this->surface_prog, static_cast<const GLchar*>("p_matrix"));
+            if (loc_p != -1 && ploc != -1) { glUniformMatrix4fv (loc_p, 1, GL_FALSE, pmat.data()); }
+            GLint loc_v = glGetUniformLocation (this->surface_prog, static_cast<const GLchar*>("v_matrix"));
+            if (loc_v != -1) { glUniformMatrix4fv (loc_v, 1, GL_FALSE, this->scenematrix.mat.data()); }
+            GLint loc_m = glGetUniformLocation (this->surface_prog, static_cast<const GLchar*>("m_matrix"));
+            if (loc_m != -1) { glUniformMatrix4fv (loc_m, 1, GL_FALSE, (this->model_scaling * this->viewmatrix).mat.data()); }
+            GLint loc_a = glGetUniformLocation (this->surface_prog, static_cast<const GLchar*>("alpha"));
+            if (loc_a != -1) { glUniform1f (loc_a, this->alpha); }
+            GLint loc_smin = glGetUniformLocation (this->surface_prog, static_cast<const GLchar*>("scale_min"));
+            if (loc_smin != -1) { glUniform1f (loc_smin, this->scale_min); }
+            GLint loc_srange = glGetUniformLocation (this->surface_prog, static_cast<const GLchar*>("scale_range"));
+            if (loc_srange != -1) { glUniform1f (loc_srange, this->scale_range); }
+
+            glActiveTexture (GL_TEXTURE0);
+            glBindTexture (GL_TEXTURE_2D, this->data_texture);
+            glActiveTexture (GL_TEXTURE1);
+            glBindTexture (GL_TEXTURE_2D, this->lut_texture);
+
+            glBindVertexArray (this->vao);
+            glDrawElements (GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+            glBindVertexArray (0);
+
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+
+            // Now render any VisualTextModels
+            auto ti = this->texts.begin();
+            while (ti != this->texts.end()) { (*ti)->render(); ti++; }
+
+            glUseProgram (prev_shader);
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+        }
+
+        /*!
+         * The colour scaling applied in the fragment shader: s = (datum - scale_min) /
+         * scale_range, clamped to [0,1], indexes the LUT. While
+         * colourScale.do_autoscale is true (the default) these are recomputed from the
+         * data's range on each upload; set do_autoscale false and set these directly
+         * for a fixed scaling.
+         */
+        float scale_min = 0.0f;
+        float scale_range = 1.0f;
+
+    protected:
+        //! Create our shader program, the single-channel field texture and the 256x1
+        //! colour map LUT texture. Requires a current OpenGL context.
+        void init_gl_objects()
+        {
+            std::vector<morph::gl::ShaderInfo> shaders = {
+                {GL_VERTEX_SHADER, "TexturedGridVisual.vert.glsl", morph::getTexturedGridVtxShader (glver), 0 },
+                {GL_FRAGMENT_SHADER, "TexturedGridVisual.frag.glsl", morph::getTexturedGridFragShader (glver), 0 }
+            };
+            this->surface_prog = morph::gl::LoadShaders (shaders);
+
+            const GLsizei w = static_cast<GLsizei>(this->grid->get_w());
+            const GLsizei h = static_cast<GLsizei>(this->grid->get_h());
+
+            // The field texture. NEAREST filtering gives RectInterp/Pixels-like
+            // rendering; change to GL_LINEAR for interpolated colour between elements.
+            glGenTextures (1, &this->data_texture);
+            glBindTexture (GL_TEXTURE_2D, this->data_texture);
+            glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexImage2D (GL_TEXTURE_2D, 0, GL_R32F, w, h, 0, GL_RED, GL_FLOAT, nullptr);
+
+            // The colour map LUT
+            constexpr unsigned int lutsz = 256;
+            std::vector<std::array<float, 3>> lutdata = this->cm.makeLut (lutsz);
+            glGenTextures (1, &this->lut_texture);
+            glBindTexture (GL_TEXTURE_2D, this->lut_texture);
+            glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexImage2D (GL_TEXTURE_2D, 0, GL_RGB32F, lutsz, 1, 0, GL_RGB, GL_FLOAT, lutdata.data()->data());
+
+            // The samplers only need setting once
+            glUseProgram (this->surface_prog);
+            GLint loc_d = glGetUniformLocation (this->surface_prog, static_cast<const GLchar*>("datatex"));
+            if (loc_d != -1) { glUniform1i (loc_d, 0); }
+            GLint loc_l = glGetUniformLocation (this->surface_prog, static_cast<const GLchar*>("lut"));
+            if (loc_l != -1) { glUniform1i (loc_l, 1); }
+
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+        }
+
+        //! Repack scalarData into texture row order (bottom row first, whatever the
+        //! GridOrder) and upload it with glTexSubImage2D
+        void upload_data()
+        {
+            if (this->scalarData == nullptr || this->scalarData->empty()) { return; }
+            const I w = this->grid->get_w();
+            const I h = this->grid->get_h();
+            const I n = this->grid->n();
+            if (this->scalarData->size() != static_cast<std::size_t>(n)) {
+                throw std::runtime_error ("TexturedGridVisual: scalarData size does not match Grid::n()");
+            }
+
+            GridOrder order = this->grid->get_order();
+            const bool topdown = (order == GridOrder::topleft_to_bottomright
+                                  || order == GridOrder::topleft_to_bottomright_colmaj);
+            this->texbuf.resize (static_cast<std::size_t>(w) * h);
+            for (I i = I{0}; i < n; ++i) {
+                I r = this->grid->row (i);
+                I y = topdown ? (h - I{1} - r) : r;
+                this->texbuf[static_cast<std::size_t>(y) * w + this->grid->col (i)]
+                    = static_cast<float>((*this->scalarData)[i]);
+            }
+
+            if (this->colourScale.do_autoscale == true) {
+                morph::range<float> r;
+                r.search_init();
+                for (const float& v : this->texbuf) { r.update (v); }
+                this->scale_min = r.min;
+                this->scale_range = (r.max > r.min) ? (r.max - r.min) : 1.0f;
+            }
+
+            glBindTexture (GL_TEXTURE_2D, this->data_texture);
+            glTexSubImage2D (GL_TEXTURE_2D, 0, 0, 0, static_cast<GLsizei>(w), static_cast<GLsizei>(h),
+                             GL_RED, GL_FLOAT, this->texbuf.data());
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+            this->data_pending = false;
+        }
+
+        //! The morph::Grid to visualize
+        const morph::Grid<I, C>* grid = nullptr;
+        //! Our shader program, which does the colour mapping on the GPU
+        GLuint surface_prog = 0;
+        //! The single-channel texture holding the scalar field
+        GLuint data_texture = 0;
+        //! The 256x1 RGB texture holding the colour map look-up-table
+        GLuint lut_texture = 0;
+        //! True when scalarData has changed and the texture needs re-uploading
+        bool data_pending = false;
+        //! CPU-side staging buffer for the texture upload, in texture row order
+        std::vector<float> texbuf;
+    };
+
+} // namespace morph
@@ -0,0 +1,110 @@
+/*!
+ * \file
+ *
+ * A lock-free triple buffer for decoupling a simulation thread from a render thread.
+ *
+ * \author Seb James
+ * \date August 2026
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+namespace morph {
+
+    /*!
+     * TripleBuffer<T> passes snapshots of state from one producer thread (your simulation
+     * loop) to one consumer thread (your render loop) without either ever blocking the
+     * other. The producer fills back() and calls publish(); the consumer calls fetch() -
+     * true when a new snapshot has arrived - and reads front(). The hot path is one atomic
+     * exchange per publish and at most one per fetch: no locks. A slow consumer never
+     * stalls the producer (an unclaimed middle snapshot is simply overwritten) and a slow
+     * producer never stalls the consumer (fetch returns false and front() still holds the
+     * last adopted snapshot).
+     *
+     * Typical use with a morph::Visual - the simulation thread steps the model into back()
+     * and publishes; the render loop adopts fresh snapshots by span binding
+     * (VisualDataModel::bindScalarData), so nothing is copied on the render thread:
+     *
+     * \code
+     * morph::TripleBuffer<morph::vvec<float>> tb (morph::vvec<float> (n, 0.0f));
+     *
+     * // Simulation thread:        // Render thread:
+     * step_model (tb.back());      if (tb.fetch()) {
+     * tb.publish();                    gv->bindScalarData (std::span<const float> (tb.front()));
+     *                                  gv->reinitColours();
+     *                              }
+     *                              v.render();
+     * \endcode
+     *
+     * One producer and one consumer only; back() belongs to the producer thread and
+     * front() to the consumer thread at all times.
+     */
+    template<typename T>
+    class TripleBuffer
+    {
+    public:
+        TripleBuffer() {}
+
+        //! Construct with all three slots initialised to a copy of \a initial (so that
+        //! front() is well defined before the first publish)
+        TripleBuffer (const T& initial)
+        {
+            this->slots[0] = initial;
+            this->slots[1] = initial;
+            this->slots[2] = initial;
+        }
+
+        //! The slot the producer writes into. Valid only on the producer thread.
+        T& back() { return this->slots[this->back_idx]; }
+
+        /*!
+         * Make the snapshot in back() available to the consumer and take ownership of a new
+         * slot to write into. The new back() holds a stale snapshot (whatever was last in
+         * the middle slot), so a producer that updates incrementally should overwrite it
+         * fully rather than assume it holds the previous step.
+         */
+        void publish()
+        {
+            std::uint8_t prev = this->middle.exchange (this->back_idx | fresh_bit, std::memory_order_acq_rel);
+            this->back_idx = prev & idx_mask;
+        }
+
+        /*!
+         * If the producer has published since the last fetch, adopt the newest snapshot
+         * into front() and return true. Otherwise return false, leaving front()
+         * unchanged. Valid only on the consumer thread.
+         */
+        bool fetch()
+        {
+            if ((this->middle.load (std::memory_order_acquire) & fresh_bit) == 0) { return false; }
+            std::uint8_t prev = this->middle.exchange (this->front_idx, std::memory_order_acq_rel);
+            this->front_idx = prev & idx_mask;
+            return true;
+        }
+
+        //! The latest adopted snapshot. Valid only on the consumer thread; call fetch()
+        //! to take up newer snapshots.
+        const T& front() const { return this->slots[this->front_idx]; }
+
+        //! True if a publish has occurred since the last fetch (a fetch() would succeed)
+        bool fresh() const { return (this->middle.load (std::memory_order_acquire) & fresh_bit) != 0; }
+
+    private:
+        //! The three buffer slots
+        std::array<T, 3> slots;
+        //! The slot the producer is writing (producer thread only)
+        std::uint8_t back_idx = 0;
+        //! The slot the consumer is reading (consumer thread only)
+        std::uint8_t front_idx = 2;
+        //! The in-between slot index, with fresh_bit set when it holds an unclaimed snapshot
+        std::atomic<std::uint8_t> middle { 1 };
+
+        static constexpr std::uint8_t idx_mask = 0x3;
+        static constexpr std::uint8_t fresh_bit = 0x4;
+    };
+
+} // namespace morph
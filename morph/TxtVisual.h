@@ -32,12 +32,35 @@ namespace morph {
 
         void initializeVertices()
         {
-            // No op, but add text
-            this->addLabel (this->text, morph::vec<float>({0,0,0}), this->tfeatures);
+            // No op, but add the text as a single block (one VisualTextModel, so one
+            // geometry buffer and one draw call however many lines it contains), keeping
+            // a pointer to it so that updateText can modify it later.
+            this->addLabel (this->text, morph::vec<float>({0,0,0}), this->vtm, this->tfeatures);
+        }
+
+        /*!
+         * Replace the text with \a _text. Only those lines that differ from the current
+         * text are laid out again (see VisualTextModel::updateText), so this is cheap
+         * enough to call every frame for a status readout in which one or two lines
+         * change. If the text is unchanged, this does nothing at all.
+         */
+        void updateText (const std::string& _text)
+        {
+            this->text = _text;
+            if (this->vtm == nullptr) { return; }
+            if (this->setContext != nullptr) { this->setContext (this->parentVis); }
+            if (this->vtm->updateText (_text) == true) {
+                if (this->parentVis != nullptr) { this->parentVis->signal_needs_render(); }
+            }
+            if (this->releaseContext != nullptr) { this->releaseContext (this->parentVis); }
         }
 
         std::string text;
         morph::TextFeatures tfeatures;
+
+    protected:
+        //! The single text model holding the whole block of text
+        morph::VisualTextModel<glver>* vtm = nullptr;
     };
 
 } // namespace morph
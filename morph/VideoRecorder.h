@@ -0,0 +1,148 @@
+/*!
+ * \file
+ *
+ * Direct-to-video frame encoding for morph::Visual frame capture.
+ *
+ * VideoRecorder streams raw RGBA frames into a child ffmpeg process which encodes them
+ * (H.264 by default, or any encoder ffmpeg knows about, including the hardware ones such
+ * as h264_vaapi and h264_nvenc) straight into an .mp4. Compared with saving a PNG per
+ * frame and running ffmpeg offline, there is no per-frame file, no PNG compress/decompress
+ * round trip and the encode happens concurrently in the child process. The ffmpeg
+ * executable must be on the PATH at runtime; nothing is linked.
+ *
+ * You normally won't use this class directly - see VisualOwnable*::startRecording,
+ * recordFrame and stopRecording, which feed it from the asynchronous pixel-buffer-object
+ * readback ring.
+ *
+ * \author Seb James
+ * \date August 2026
+ */
+#pragma once
+
+#include <cstdio>
+#include <cstddef>
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <morph/vec.h>
+
+namespace morph {
+
+    class VideoRecorder
+    {
+    public:
+        /*!
+         * Set up a recorder for \a _filename at \a _fps frames per second, encoding with
+         * \a _codec. The ffmpeg process is not launched until open() - which needs the
+         * frame dimensions - is called with the first frame.
+         *
+         * For hardware encoding set codec to (e.g.) "h264_vaapi" and codec_args to
+         * "-vaapi_device /dev/dri/renderD128" with filter_chain
+         * "vflip,format=nv12,hwupload", or codec to "h264_nvenc" (no extra args
+         * usually required).
+         */
+        VideoRecorder (const std::string& _filename, const double _fps = 30.0,
+                       const std::string& _codec = "libx264", const std::string& _codec_args = "")
+            : filename(_filename), fps(_fps), codec(_codec), codec_args(_codec_args) {}
+
+        //! Closes the stream (waiting for the encoder) if the user did not
+        ~VideoRecorder() { if (this->pipe != nullptr) { this->close(); } }
+
+        // The recorder owns a process handle; forbid copies
+        VideoRecorder (const VideoRecorder&) = delete;
+        VideoRecorder& operator= (const VideoRecorder&) = delete;
+
+        /*!
+         * The ffmpeg filter chain. vflip turns glReadPixels' bottom-up rows the right way
+         * up (cheaper in ffmpeg than a row-reversing copy per frame); the crop rounds odd
+         * window dimensions down to the even sizes yuv420p H.264 requires. Replace this
+         * wholesale for hardware upload chains.
+         */
+        std::string filter_chain = "vflip,crop=trunc(iw/2)*2:trunc(ih/2)*2,format=yuv420p";
+
+        //! The name of (or path to) the ffmpeg executable
+        std::string ffmpeg = "ffmpeg";
+
+        /*!
+         * Launch the encoder for \a frame_dims (width, height) frames. Called
+         * automatically by writeFrame for the first frame. Throws if ffmpeg cannot be
+         * started.
+         */
+        void open (const morph::vec<int, 2>& frame_dims)
+        {
+            if (this->pipe != nullptr) { throw std::runtime_error ("VideoRecorder::open: already open"); }
+            if (frame_dims[0] <= 0 || frame_dims[1] <= 0) {
+                throw std::runtime_error ("VideoRecorder::open: bad frame dimensions");
+            }
+            this->dims = frame_dims;
+            std::stringstream cmd;
+            cmd << this->ffmpeg << " -hide_banner -loglevel error -y"
+                << " -f rawvideo -pixel_format rgba"
+                << " -video_size " << this->dims[0] << "x" << this->dims[1]
+                << " -framerate " << this->fps << " -i -";
+            if (!this->codec_args.empty()) { cmd << " " << this->codec_args; }
+            cmd << " -c:v " << this->codec
+                << " -vf \"" << this->filter_chain << "\""
+                << " -movflags +faststart"
+                << " \"" << this->filename << "\"";
+            this->pipe = ::popen (cmd.str().c_str(), "w");
+            if (this->pipe == nullptr) {
+                throw std::runtime_error ("VideoRecorder::open: failed to start " + this->ffmpeg);
+            }
+        }
+
+        /*!
+         * Stream one frame - RGBA bytes, rows bottom-up exactly as glReadPixels returns
+         * them - to the encoder. \a frame_dims must match the dimensions the stream was
+         * opened with (on the first frame, it sets them). Returns false if the frame could
+         * not be written (usually: the ffmpeg process has exited; see close() for its
+         * status).
+         */
+        bool writeFrame (const unsigned char* rgba_pixels, const morph::vec<int, 2>& frame_dims)
+        {
+            if (this->pipe == nullptr) { this->open (frame_dims); }
+            if (frame_dims != this->dims) { return false; } // window was resized mid-recording
+            std::size_t sz = static_cast<std::size_t>(this->dims[0]) * this->dims[1] * 4u;
+            if (::fwrite (rgba_pixels, 1, sz, this->pipe) != sz) { return false; }
+            ++this->nframes;
+            return true;
+        }
+
+        /*!
+         * Close the stream and wait for ffmpeg to finish writing the file. Returns the
+         * encoder's exit status (0 on success) or -1 if nothing was ever encoded.
+         */
+        int close()
+        {
+            if (this->pipe == nullptr) { return -1; }
+            int st = ::pclose (this->pipe);
+            this->pipe = nullptr;
+            return st;
+        }
+
+        //! True while the encoder process is running
+        bool is_open() const { return this->pipe != nullptr; }
+
+        //! The number of frames streamed to the encoder so far
+        std::size_t framesWritten() const { return this->nframes; }
+
+        //! The output video path
+        std::string filename;
+        //! Frames per second declared to the encoder
+        double fps = 30.0;
+        //! The ffmpeg video encoder name (libx264, libx265, h264_vaapi, h264_nvenc, ...)
+        std::string codec = "libx264";
+        //! Extra ffmpeg arguments inserted before the encoder options (hardware device
+        //! selection and the like)
+        std::string codec_args;
+
+    protected:
+        //! The write end of the pipe to the ffmpeg child process
+        std::FILE* pipe = nullptr;
+        //! Frame dimensions, fixed when the stream opens
+        morph::vec<int, 2> dims = { 0, 0 };
+        //! Count of frames streamed
+        std::size_t nframes = 0u;
+    };
+
+} // namespace morph
@@ -21,16 +21,31 @@
 #include <nlohmann/json.hpp>
 #include <morph/CoordArrows.h>
 #include <morph/quaternion.h>
+#include <morph/CameraPath.h>
 #include <morph/mat44.h>
 #include <morph/vec.h>
 #include <morph/tools.h>
+#include <morph/VideoRecorder.h>
 
 #include <string>
+#include <sstream>
+#include <iomanip>
 #include <array>
 #include <vector>
 #include <memory>
 #include <functional>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <algorithm>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <fstream>
 
 #include <morph/VisualDefaultShaders.h>
 
@@ -38,6 +53,7 @@
 #define LODEPNG_NO_COMPILE_DECODER 1
 #define LODEPNG_NO_COMPILE_ANCILLARY_CHUNKS 1
 #include <morph/lodepng.h>
+#include <morph/pngenc.h>
 
 namespace morph {
 
@@ -126,7 +142,10 @@ namespace morph {
         }
 
     protected:
-        virtual void freetype_init() = 0; // does this need to be here?
+        //! Initialize this window's FreeType library instance. No longer called during
+        //! init_resources - getVisualFace does it lazily on the first text render - but
+        //! callable (with the GL context current) to take the font setup cost up front.
+        virtual void freetype_init() = 0;
 
     public:
         // Do one-time init of resources (such as freetypes, windowing system etc)
@@ -197,6 +216,154 @@ namespace morph {
          */
         morph::VisualModel<glver>* getVisualModel (unsigned int modelId) { return (this->vm[modelId].get()); }
 
+        /*!
+         * Finalize every model in the scene that has not yet been finalized, building
+         * the vertex arrays on \a n_threads worker threads (pass 0 to use
+         * std::thread::hardware_concurrency). Only models which declare
+         * VisualModel::threadsafe_vertex_init == true are built on the workers; the
+         * rest are finalized one by one on the calling thread, as their
+         * initializeVertices may make OpenGL calls (creating text labels, for
+         * example). In either case the OpenGL buffer upload (postVertexInit) is
+         * deferred to the next render, so it remains serialized on the GL thread.
+         *
+         * To use this, add your models to the scene with addVisualModel *without*
+         * calling VisualModel::finalize on them, then call finalize_models() (from
+         * the thread that owns the OpenGL context) once all have been added. Models
+         * that were already finalized individually are left alone.
+         */
+        void finalize_models (unsigned int n_threads = 0)
+        {
+            // Partition the un-finalized models into parallelizable work and work
+            // for this thread
+            std::vector<morph::VisualModel<glver>*> parwork;
+            std::vector<morph::VisualModel<glver>*> serwork;
+            for (auto& m : this->vm) {
+                if (m->postVertexInitRequired == false && m->vertexPositions.empty()) {
+                    if (m->threadsafe_vertex_init == true) {
+                        parwork.push_back (m.get());
+                    } else {
+                        serwork.push_back (m.get());
+                    }
+                }
+            }
+
+            if (parwork.size() == 1) {
+                // No point spinning up a pool for one model
+                serwork.push_back (parwork.back());
+                parwork.clear();
+            }
+
+            if (!parwork.empty()) {
+                if (n_threads == 0) { n_threads = std::thread::hardware_concurrency(); }
+                if (n_threads == 0) { n_threads = 1; } // hardware_concurrency may fail
+                n_threads = std::min (n_threads, static_cast<unsigned int>(parwork.size()));
+                // Each worker claims the next un-built model until none remain
+                std::atomic<std::size_t> next_model = 0;
+                auto worker = [&parwork, &next_model]()
+                {
+                    std::size_t i = 0;
+                    while ((i = next_model.fetch_add (1)) < parwork.size()) {
+                        parwork[i]->initializeVertices();
+                        parwork[i]->postVertexInitRequired = true;
+                    }
+                };
+                std::vector<std::thread> pool;
+                pool.reserve (n_threads);
+                for (unsigned int t = 0; t < n_threads; ++t) { pool.emplace_back (worker); }
+                for (auto& thrd : pool) { thrd.join(); }
+            }
+
+            // Models whose initializeVertices may need the GL context are finalized here
+            for (auto m : serwork) { m->finalize(); }
+        }
+
+        /*
+         * Frame profiling. Set profile_frames (or show_profile_hud) true and each
+         * render() fills VisualBase::profiling with per-model CPU and GPU render
+         * times, so you can find which of your models is blowing the frame budget.
+         * The GL timer queries and the HUD drawing live in the Ownable
+         * implementation classes; these structs and the summary text are GL-free.
+         */
+
+        //! Render timings for one VisualModel in one frame
+        struct model_render_stats
+        {
+            //! Index of the model in the scene (VisualBase::vm)
+            unsigned int modelId = 0;
+            //! The model's (optional, client-set) VisualModel::name
+            std::string name;
+            //! CPU time spent in the model's render() call, in ms
+            double cpu_ms = 0.0;
+            //! GPU time for the model's draw calls in ms, from a GL_TIME_ELAPSED
+            //! query. Queries are double buffered, so this is one frame old.
+            double gpu_ms = 0.0;
+            //! How long the model's last finalize() spent generating vertices, in ms
+            double vertex_init_ms = 0.0;
+        };
+
+        //! Timings for one whole frame
+        struct frame_stats
+        {
+            //! CPU time for the whole render() call, in ms
+            double frame_cpu_ms = 0.0;
+            //! Smoothed frames-per-second figure
+            double fps = 0.0;
+            //! Counts profiled frames
+            unsigned long long framenum = 0;
+            //! Per-model render timings
+            std::vector<model_render_stats> models;
+        };
+
+        //! Set true to collect per-model frame timings into VisualBase::profiling
+        bool profile_frames = false;
+        //! Set true to also draw the frame timings as a text overlay on the scene
+        bool show_profile_hud = false;
+        //! The statistics collected for the most recently rendered frame
+        frame_stats profiling;
+        //! The HUD text is refreshed every this-many frames
+        unsigned int profile_hud_period = 30;
+
+        //! A short multi-line text summary of VisualBase::profiling: overall fps and
+        //! frame time, then the \a n_models most expensive models. Used for the HUD;
+        //! also handy for logging.
+        std::string profile_summary (unsigned int n_models = 5) const
+        {
+            std::stringstream ss;
+            ss.precision (1);
+            ss << std::fixed << this->profiling.fps << " fps, render "
+               << std::setprecision(2) << this->profiling.frame_cpu_ms << " ms\n";
+            // Rank models by GPU time (falling back on CPU time when queries have not
+            // yet delivered)
+            std::vector<unsigned int> order (this->profiling.models.size());
+            for (unsigned int i = 0; i < order.size(); ++i) { order[i] = i; }
+            std::sort (order.begin(), order.end(), [this](unsigned int a, unsigned int b) {
+                const auto& ma = this->profiling.models[a];
+                const auto& mb = this->profiling.models[b];
+                return (ma.gpu_ms + ma.cpu_ms) > (mb.gpu_ms + mb.cpu_ms);
+            });
+            unsigned int n = std::min (n_models, static_cast<unsigned int>(order.size()));
+            for (unsigned int i = 0; i < n; ++i) {
+                const auto& m = this->profiling.models[order[i]];
+                ss << "vm" << m.modelId;
+                if (!m.name.empty()) { ss << " (" << m.name << ")"; }
+                ss << ": cpu " << m.cpu_ms << " gpu " << m.gpu_ms << " ms\n";
+            }
+            return ss.str();
+        }
+
+    protected:
+        //! Called by the implementation render() when a profiled frame completes;
+        //! updates the frame counter and the smoothed fps figure
+        void profile_frame_done (const double frame_ms)
+        {
+            this->profiling.frame_cpu_ms = frame_ms;
+            this->profiling.framenum++;
+            double inst_fps = frame_ms > 0.0 ? 1000.0 / frame_ms : 0.0;
+            // Exponential smoothing so the HUD number is readable
+            this->profiling.fps = this->profiling.fps == 0.0 ? inst_fps : (0.95 * this->profiling.fps + 0.05 * inst_fps);
+        }
+    public:
+
         //! Remove the VisualModel with ID \a modelId from the scene.
         void removeVisualModel (unsigned int modelId) { this->vm.erase (this->vm.begin() + modelId); }
 
@@ -252,6 +419,11 @@ namespace morph {
 
         //! Stores the info required to load the cylindrical projection shader
         std::vector<morph::gl::ShaderInfo> cyl_shader_progs;
+        //! Stores the info required to load the ID-buffer picking shader (see pick(),
+        //! in the deriving classes). Loaded lazily, on the first call to pick().
+        std::vector<morph::gl::ShaderInfo> pick_shader_progs;
+        //! The ID-buffer picking shader program; 0 until the first call to pick()
+        unsigned int /*GLuint*/ pick_gprog = 0;
         //! Passed to the cyl_shader_progs as a uniform to define the location of the cylindrical
         //! projection camera
         morph::vec<float, 4> cyl_cam_pos = { 0.0f, 0.0f, 0.0f, 1.0f };
@@ -318,6 +490,66 @@ namespace morph {
         float zFar = 300.0f;
         float fov = 30.0f;
 
+        /*!
+         * Set to true to skip rendering VisualModels whose bounding boxes lie wholly outside
+         * the view frustum (see VisualModelBase::withinFrustum). Worthwhile in large scenes
+         * where many models are off screen; applies in perspective and orthographic
+         * projections only. Note that text labels attached to a model are culled with it.
+         */
+        bool frustum_cull = false;
+
+        /*!
+         * Render-on-demand mode. When true, render() draws a frame only when a change
+         * has been signalled: user interaction (mouse rotation/translation, key
+         * presses, window resizes) and model buffer updates signal automatically, and
+         * anything else can call signal_needs_render(). Identical frames are then
+         * skipped entirely, so an idle scene in a keepOpen() or waitevents() loop
+         * costs no GPU time. The default (false) renders every call, as before.
+         */
+        bool render_on_demand = false;
+
+        /*!
+         * When true, saveImage/saveImageAsync encode PNGs with morph::pngenc - the
+         * multithreaded encoder - instead of lodepng. Several times faster (more on
+         * many-core machines), at the cost of files a few tens of percent larger;
+         * worthwhile when capturing interactively or exporting figures in batches.
+         * The default (false) encodes with lodepng, as before.
+         */
+        bool fast_png_encode = false;
+
+        /*!
+         * When true, the Visual's destructor releases the VisualModels' memory on a
+         * detached reaper thread, after their GL resources have been deleted (in
+         * batched glDeleteBuffers/glDeleteVertexArrays calls) on this one. That takes
+         * model destruction off the shutdown critical path - worthwhile when cycling
+         * many windows each holding thousands of models. The default (false) frees
+         * the models on the calling thread, as before, which is what you want under
+         * leak checkers and when the process exits straight afterwards.
+         */
+        bool async_model_free = false;
+
+        //! True when a redraw has been signalled; see render_on_demand. Starts true so
+        //! that the first frame always draws.
+        bool render_required = true;
+
+        //! Note that the scene has changed, so that the next render() call draws a
+        //! frame even in render-on-demand mode. Called by the interaction callbacks
+        //! and by VisualModel buffer updates; call it yourself after changing anything
+        //! else that affects the scene (bgcolour, lighting, hide flags...).
+        void signal_needs_render() { this->render_required = true; }
+
+        /*!
+         * Project \a model's cached bounding box to window pixel bounds, {x, y, w, h}
+         * with the origin bottom left as glScissor expects. Returns false when the
+         * bounds cannot be determined (no cached box, or a box corner behind the
+         * camera); assume whole-window coverage in that case. Used for
+         * damage-rectangle schemes - see morph::wx::Canvas.
+         */
+        bool modelScreenBounds (const morph::VisualModel<glver>* model, morph::vec<int, 4>& rect) const
+        {
+            return model->screenBounds (this->projection, this->window_w, this->window_h, rect);
+        }
+
         //! Set to true to show the coordinate arrows
         bool showCoordArrows = false;
 
@@ -406,6 +638,34 @@ namespace morph {
             this->rotation_default = _rotn;
         }
 
+        /*!
+         * Start playing this->cameraPath, compiling it first if necessary. From the
+         * next render() the scene rotation and translation are set from the path each
+         * frame - no per-frame camera math in user code. With \a loop_it true the
+         * path repeats; otherwise playback stops (leaving the final pose) at the
+         * path's end. \a frame_dt of zero advances by wall-clock time; set it to the
+         * frame period (e.g. 1/60 s) for deterministic offline renders, where each
+         * rendered frame advances the path by exactly that much.
+         */
+        void playCameraPath (const bool loop_it = false, const float frame_dt = 0.0f)
+        {
+            if (this->cameraPath.compiled() == false) { this->cameraPath.compile(); }
+            this->camera_path_loop = loop_it;
+            this->camera_path_dt = frame_dt;
+            this->camera_path_t = 0.0f;
+            this->camera_path_last = std::chrono::steady_clock::now();
+            this->camera_path_playing = true;
+        }
+
+        //! Stop camera path playback, leaving the scene at its current pose
+        void stopCameraPath() { this->camera_path_playing = false; }
+
+        //! True while render() is advancing the camera along this->cameraPath
+        bool cameraPathPlaying() const { return this->camera_path_playing; }
+
+        //! The camera path played by playCameraPath(). Add keyframes to it directly.
+        morph::CameraPath cameraPath;
+
         void lightingEffects (const bool effects_on = true)
         {
             this->ambient_intensity = effects_on ? 0.4f : 1.0f;
@@ -550,13 +810,197 @@ namespace morph {
             fout.close();
         }
 
+        /*!
+         * Save all the VisualModels in this Visual out to a binary glTF (.glb) file. The JSON
+         * chunk holds only the scene structure; the vertex/index buffers are written straight
+         * from the models' vectors into the binary chunk, so unlike savegltf() there is no
+         * base64 encoding and no per-buffer string copy.
+         */
+        virtual void saveglb (const std::string& glb_file)
+        {
+            // First pass: lay out one binary buffer with 4 bufferViews (indices, positions,
+            // colours, normals) per model, each offset. All elements are 4 bytes wide, so the
+            // 4-byte alignment that glTF requires comes for free.
+            std::size_t binsz = 0u;
+            for (std::size_t vmi = 0u; vmi < this->vm.size(); ++vmi) {
+                binsz += this->vm[vmi]->indices_bytes() + this->vm[vmi]->vpos_bytes()
+                    + this->vm[vmi]->vcol_bytes() + this->vm[vmi]->vnorm_bytes();
+            }
+
+            // Build the JSON chunk. This mirrors savegltf(), but all bufferViews index into the
+            // single binary buffer and there are no data URIs.
+            std::stringstream json;
+            json << "{\n  \"scenes\" : [ { \"nodes\" : [ ";
+            for (std::size_t vmi = 0u; vmi < this->vm.size(); ++vmi) {
+                json << vmi << (vmi < this->vm.size()-1 ? ", " : "");
+            }
+            json << " ] } ],\n";
+
+            json << "  \"nodes\" : [\n";
+            for (std::size_t vmi = 0u; vmi < this->vm.size(); ++vmi) {
+                json << "    { \"mesh\" : " << vmi
+                     << ", \"translation\" : " << this->vm[vmi]->translation_str()
+                     << (vmi < this->vm.size()-1 ? " },\n" : " }\n");
+            }
+            json << "  ],\n";
+
+            json << "  \"meshes\" : [\n";
+            for (std::size_t vmi = 0u; vmi < this->vm.size(); ++vmi) {
+                json << "    { \"primitives\" : [ { \"attributes\" : { \"POSITION\" : " << 1+vmi*4
+                     << ", \"COLOR_0\" : " << 2+vmi*4
+                     << ", \"NORMAL\" : " << 3+vmi*4 << " }, \"indices\" : " << vmi*4 << ", \"material\": 0 } ] }"
+                     << (vmi < this->vm.size()-1 ? ",\n" : "\n");
+            }
+            json << "  ],\n";
+
+            json << "  \"buffers\" : [ { \"byteLength\" : " << binsz << " } ],\n";
+
+            json << "  \"bufferViews\" : [\n";
+            std::size_t offs = 0u;
+            for (std::size_t vmi = 0u; vmi < this->vm.size(); ++vmi) {
+                // indices (target 34963: ELEMENT_ARRAY_BUFFER)
+                json << "    { \"buffer\" : 0, \"byteOffset\" : " << offs
+                     << ", \"byteLength\" : " << this->vm[vmi]->indices_bytes() << ", \"target\" : 34963 },\n";
+                offs += this->vm[vmi]->indices_bytes();
+                // vpos (target 34962: ARRAY_BUFFER)
+                json << "    { \"buffer\" : 0, \"byteOffset\" : " << offs
+                     << ", \"byteLength\" : " << this->vm[vmi]->vpos_bytes() << ", \"target\" : 34962 },\n";
+                offs += this->vm[vmi]->vpos_bytes();
+                // vcol
+                json << "    { \"buffer\" : 0, \"byteOffset\" : " << offs
+                     << ", \"byteLength\" : " << this->vm[vmi]->vcol_bytes() << ", \"target\" : 34962 },\n";
+                offs += this->vm[vmi]->vcol_bytes();
+                // vnorm
+                json << "    { \"buffer\" : 0, \"byteOffset\" : " << offs
+                     << ", \"byteLength\" : " << this->vm[vmi]->vnorm_bytes() << ", \"target\" : 34962 }"
+                     << (vmi < this->vm.size()-1 ? ",\n" : "\n");
+                offs += this->vm[vmi]->vnorm_bytes();
+            }
+            json << "  ],\n";
+
+            json << "  \"accessors\" : [\n";
+            for (std::size_t vmi = 0u; vmi < this->vm.size(); ++vmi) {
+                this->vm[vmi]->computeVertexMaxMins();
+                // indices. 5125 is unsigned int; 5126 is float
+                json << "    { \"bufferView\" : " << vmi*4
+                     << ", \"byteOffset\" : 0, \"componentType\" : 5125, \"type\" : \"SCALAR\", "
+                     << "\"count\" : " << this->vm[vmi]->indices_size() << "},\n";
+                // vpos. Vertex position requires max/min to be specified in the gltf format
+                json << "    { \"bufferView\" : " << 1+vmi*4
+                     << ", \"byteOffset\" : 0, \"componentType\" : 5126, \"type\" : \"VEC3\", "
+                     << "\"count\" : " << this->vm[vmi]->vpos_size()/3
+                     << ", \"max\" : " << this->vm[vmi]->vpos_max()
+                     << ", \"min\" : " << this->vm[vmi]->vpos_min() << " },\n";
+                // vcol
+                json << "    { \"bufferView\" : " << 2+vmi*4
+                     << ", \"byteOffset\" : 0, \"componentType\" : 5126, \"type\" : \"VEC3\", "
+                     << "\"count\" : " << this->vm[vmi]->vcol_size()/3 << "},\n";
+                // vnorm
+                json << "    { \"bufferView\" : " << 3+vmi*4
+                     << ", \"byteOffset\" : 0, \"componentType\" : 5126, \"type\" : \"VEC3\", "
+                     << "\"count\" : " << this->vm[vmi]->vnorm_size()/3 << "}"
+                     << (vmi < this->vm.size()-1 ? ",\n" : "\n");
+            }
+            json << "  ],\n";
+
+            json << "  \"materials\" : [ { \"doubleSided\" : true } ],\n";
+
+            json << "  \"asset\" : {\n"
+                 << "    \"generator\" : \"https://github.com/ABRG-Models/morphologica: morph::Visual::saveglb() (ver "
+                 << morph::version_string() << ")\",\n"
+                 << "    \"version\" : \"2.0\"\n" // This version is the *glTF* version.
+                 << "  }\n";
+            json << "}";
+
+            std::string json_str = json.str();
+            // The JSON chunk must be padded to a 4 byte boundary with spaces
+            while (json_str.size() % 4 != 0) { json_str += ' '; }
+            // Binary chunk padding would be zero bytes, but binsz is always a multiple of 4
+
+            std::ofstream fout;
+            fout.open (glb_file, std::ios::out|std::ios::trunc|std::ios::binary);
+            if (!fout.is_open()) { throw std::runtime_error ("Visual::saveglb(): Failed to open file for writing"); }
+
+            auto write_u32 = [&fout] (const std::uint32_t u)
+            {
+                fout.write (reinterpret_cast<const char*>(&u), sizeof (u));
+            };
+
+            // 12 byte GLB header: magic 'glTF', container version 2, total file length
+            write_u32 (0x46546c67u);
+            write_u32 (2u);
+            write_u32 (static_cast<std::uint32_t>(12u + 8u + json_str.size() + 8u + binsz));
+
+            // JSON chunk: length, type 'JSON', content
+            write_u32 (static_cast<std::uint32_t>(json_str.size()));
+            write_u32 (0x4e4f534au);
+            fout.write (json_str.data(), static_cast<std::streamsize>(json_str.size()));
+
+            // Binary chunk: length, type 'BIN\0', then each model's buffers written directly
+            write_u32 (static_cast<std::uint32_t>(binsz));
+            write_u32 (0x004e4942u);
+            for (std::size_t vmi = 0u; vmi < this->vm.size(); ++vmi) {
+                fout.write (this->vm[vmi]->indices_raw(), static_cast<std::streamsize>(this->vm[vmi]->indices_bytes()));
+                fout.write (this->vm[vmi]->vpos_raw(), static_cast<std::streamsize>(this->vm[vmi]->vpos_bytes()));
+                fout.write (this->vm[vmi]->vcol_raw(), static_cast<std::streamsize>(this->vm[vmi]->vcol_bytes()));
+                fout.write (this->vm[vmi]->vnorm_raw(), static_cast<std::streamsize>(this->vm[vmi]->vnorm_bytes()));
+            }
+            fout.close();
+        }
+
         void set_winsize (int _w, int _h) { this->window_w = _w; this->window_h = _h; }
+        //! Getter for the window size in pixels, {width, height}
+        morph::vec<int, 2> get_winsize() const { return { this->window_w, this->window_h }; }
 
     protected:
 
+        /*!
+         * Called at the top of render() each frame. While a camera path is playing,
+         * advance the path time (by wall clock, or by the fixed per-frame step) and
+         * set this->rotation and this->scenetrans from the precomputed tables - an
+         * O(1) lookup. Also marks the render as required, so playback works with
+         * render_on_demand.
+         */
+        void advanceCameraPath()
+        {
+            if (this->camera_path_playing == false) { return; }
+            if (this->camera_path_dt > 0.0f) {
+                this->camera_path_t += this->camera_path_dt;
+            } else {
+                const auto now = std::chrono::steady_clock::now();
+                this->camera_path_t += std::chrono::duration<float>(now - this->camera_path_last).count();
+                this->camera_path_last = now;
+            }
+            if (this->camera_path_loop == false && this->camera_path_t >= this->cameraPath.duration()) {
+                this->camera_path_t = this->cameraPath.duration();
+                this->camera_path_playing = false;
+            }
+            this->cameraPath.eval (this->camera_path_t, this->rotation, this->scenetrans, this->camera_path_loop);
+            this->render_required = true;
+        }
+
+        //! Seconds along the camera path
+        float camera_path_t = 0.0f;
+        //! Per-frame path advance; 0 means advance by wall-clock time
+        float camera_path_dt = 0.0f;
+        //! The wall-clock time of the last camera path advance
+        std::chrono::steady_clock::time_point camera_path_last;
+        bool camera_path_playing = false;
+        bool camera_path_loop = false;
+
         //! Set up a perspective projection based on window width and height. Not public.
         void setPerspective()
         {
+            if (this->tile_render == true) {
+                // A tiled capture is in progress (see saveImageTiled); project just this
+                // tile's sub-rectangle of the full film plane
+                this->projection.setToIdentity();
+                this->projection.frustum (this->tile_frustum[0], this->tile_frustum[1],
+                                          this->tile_frustum[2], this->tile_frustum[3],
+                                          this->zNear, this->zFar);
+                this->invproj = this->projection.invert();
+                return;
+            }
             // Calculate aspect ratio
             float aspect = static_cast<float>(this->window_w) / static_cast<float>(this->window_h ? this->window_h : 1);
             // Reset projection
@@ -579,14 +1023,167 @@ namespace morph {
         void setOrthographic()
         {
             this->projection.setToIdentity();
-            this->projection.orthographic (this->ortho_lb, this->ortho_rt, this->zNear, this->zFar);
+            if (this->tile_render == true) {
+                // A tiled capture is in progress (see saveImageTiled)
+                this->projection.orthographic ({ this->tile_frustum[0], this->tile_frustum[2] },
+                                               { this->tile_frustum[1], this->tile_frustum[3] },
+                                               this->zNear, this->zFar);
+            } else {
+                this->projection.orthographic (this->ortho_lb, this->ortho_rt, this->zNear, this->zFar);
+            }
             this->invproj = this->projection.invert();
         }
 
+        /*!
+         * Tiled capture state, used by saveImageTiled (in VisualOwnableMX/NoMX). When
+         * tile_render is true, setPerspective/setOrthographic project only the
+         * tile_frustum sub-rectangle {left, right, bottom, top} of the full film
+         * plane, so that each offscreen tile renders one patch of a much larger
+         * virtual framebuffer.
+         */
+        bool tile_render = false;
+        morph::vec<float, 4> tile_frustum = { 0.0f, 0.0f, 0.0f, 0.0f };
+
         //! A vector of pointers to all the morph::VisualModels (HexGridVisual,
         //! ScatterVisual, etc) which are going to be rendered in the scene.
         std::vector<std::unique_ptr<morph::VisualModel<glver>>> vm;
 
+        /*!
+         * Background PNG encoding, used by the asynchronous frame capture path
+         * (VisualOwnable*::saveImageAsync). saveImageAsync reads frames back through
+         * a ring of pixel buffer objects and hands each one to encode_enqueue; a
+         * background thread does the row flip and the lodepng encode, so the render
+         * loop never waits on the PNG compressor. This part of the pipeline makes no
+         * OpenGL calls, which is why it lives here in VisualBase.
+         */
+        //! A frame awaiting PNG encoding. pixels holds RGBA rows, bottom-up, as read
+        //! by glReadPixels.
+        struct img_encode_job
+        {
+            std::string filename;
+            morph::vec<int, 2> dims = { 0, 0 };
+            bool transparent_bg = false;
+            //! If true, this frame goes to video_recorder rather than to a PNG file
+            bool video = false;
+            std::vector<unsigned char> pixels;
+        };
+        /*!
+         * The video encoder stream, while a recording is in progress (see
+         * VisualOwnable*::startRecording). Created on the render thread; frames are
+         * streamed to it by the encoder thread, which is also the thread that opens the
+         * ffmpeg process (lazily, on the first frame, when the frame dimensions are
+         * known).
+         */
+        std::unique_ptr<morph::VideoRecorder> video_recorder;
+        //! Frames awaiting the encoder thread
+        std::deque<img_encode_job> encode_queue;
+        std::mutex encode_mtx;
+        //! Signalled when a job is queued, or when the encoder should finish up
+        std::condition_variable encode_cv;
+        //! Signalled when the encoder completes a job (un-blocks a full queue)
+        std::condition_variable encode_done_cv;
+        std::thread encode_thread;
+        //! Tell the encoder thread to exit once the queue is empty
+        bool encode_finishing = false;
+        /*!
+         * If the encoder falls this many frames behind, encode_enqueue blocks until it
+         * catches up, bounding the memory held in queued frames
+         */
+        static constexpr std::size_t encode_queue_max = 64;
+
+        //! Queue \a job for the background encoder thread, starting the thread if necessary
+        void encode_enqueue (img_encode_job&& job)
+        {
+            std::unique_lock<std::mutex> lk (this->encode_mtx);
+            if (this->encode_thread.joinable() == false) {
+                this->encode_finishing = false;
+                this->encode_thread = std::thread (&morph::VisualBase<glver>::encoder_loop, this);
+            }
+            this->encode_done_cv.wait (lk, [this]{ return this->encode_queue.size() < encode_queue_max; });
+            this->encode_queue.push_back (std::move (job));
+            lk.unlock();
+            this->encode_cv.notify_one();
+        }
+
+        //! The encoder thread's main loop: flip each queued frame the right way up and
+        //! encode it to its PNG file
+        void encoder_loop()
+        {
+            for (;;) {
+                img_encode_job job;
+                {
+                    std::unique_lock<std::mutex> lk (this->encode_mtx);
+                    this->encode_cv.wait (lk, [this]{ return !this->encode_queue.empty() || this->encode_finishing; });
+                    if (this->encode_queue.empty()) { break; } // finishing and nothing left to do
+                    job = std::move (this->encode_queue.front());
+                    this->encode_queue.pop_front();
+                }
+                this->encode_done_cv.notify_one();
+
+                if (job.video == true) {
+                    // Stream the frame to the video encoder, bottom-up as it is - the
+                    // recorder's filter chain flips it. A false return means ffmpeg has
+                    // gone away or the window was resized; drop the frame.
+                    if (this->video_recorder != nullptr) {
+                        try {
+                            if (this->video_recorder->writeFrame (job.pixels.data(), job.dims) == false) {
+                                std::cerr << "VideoRecorder dropped a " << job.dims << " frame\n";
+                            }
+                        } catch (const std::exception& e) {
+                            // open() failed; kill the recording rather than the encoder thread
+                            std::cerr << e.what() << std::endl;
+                            this->video_recorder.reset();
+                        }
+                    }
+                    continue;
+                }
+
+                // glReadPixels gives rows bottom-up; reverse them (and opaque-ify alpha
+                // unless a transparent background was requested)
+                std::vector<unsigned char> rbits (job.pixels.size());
+                for (int i = 0; i < job.dims[1]; ++i) {
+                    int rev_line = (job.dims[1] - i - 1) * 4 * job.dims[0];
+                    int for_line = i * 4 * job.dims[0];
+                    if (job.transparent_bg) {
+                        for (int j = 0; j < 4 * job.dims[0]; ++j) {
+                            rbits[rev_line + j] = job.pixels[for_line + j];
+                        }
+                    } else {
+                        for (int j = 0; j < 4 * job.dims[0]; ++j) {
+                            rbits[rev_line + j] = (j % 4 == 3) ? 255 : job.pixels[for_line + j];
+                        }
+                    }
+                }
+                if (this->fast_png_encode == true) {
+                    try {
+                        morph::pngenc::encode (job.filename, rbits.data(), job.dims[0], job.dims[1]);
+                    } catch (const std::exception& e) {
+                        std::cerr << "encoder error: " << e.what() << std::endl;
+                    }
+                } else {
+                    unsigned int error = lodepng::encode (job.filename, rbits.data(), job.dims[0], job.dims[1]);
+                    if (error) {
+                        std::cerr << "encoder error " << error << ": " << lodepng_error_text (error) << std::endl;
+                    }
+                }
+            }
+        }
+
+        //! Wait for the encoder thread to drain its queue and join it. It restarts on
+        //! the next encode_enqueue.
+        void encoder_finish()
+        {
+            if (this->encode_thread.joinable() == false) { return; }
+            {
+                std::lock_guard<std::mutex> lk (this->encode_mtx);
+                this->encode_finishing = true;
+            }
+            this->encode_cv.notify_one();
+            this->encode_thread.join();
+            this->encode_thread = std::thread{};
+            this->encode_finishing = false;
+        }
+
         // Initialize OpenGL shaders, set some flags (Alpha, Anti-aliasing), read in any external
         // state from json, and set up the coordinate arrows and any VisualTextModels that will be
         // required to render the Visual.
@@ -38,13 +38,15 @@ namespace morph {
         };
 
         //! The locations for the position, normal and colour vertex attributes in the
-        //! morph::Visual GLSL programs
-        enum AttribLocn { posnLoc = 0, normLoc = 1, colLoc = 2, textureLoc = 3 };
+        //! morph::Visual GLSL programs. pickLoc is the per-vertex element id attribute
+        //! used only by the ID-buffer picking pass (see VisualBase::pick).
+        enum AttribLocn { posnLoc = 0, normLoc = 1, colLoc = 2, textureLoc = 3, pickLoc = 4 };
 
         //! A struct to hold information about font glyph properties
         struct CharInfo
         {
-            //! ID handle of the glyph texture
+            //! ID handle of the glyph texture. All glyphs of one face share an atlas
+            //! texture, so this is the same for every CharInfo of a face.
             unsigned int textureID;
             //! Size of glyph
             morph::vec<int,2>  size;
@@ -52,6 +54,9 @@ namespace morph {
             morph::vec<int,2>  bearing;
             //! Offset to advance to next glyph
             unsigned int advance;
+            //! The glyph's texture coordinates within the face's atlas texture, in the
+            //! order u_left, v_top, u_right, v_bottom (v increases downwards)
+            morph::vec<float,4> uv = { 0.0f, 0.0f, 1.0f, 1.0f };
         };
 
     } // namespace gl
@@ -4,7 +4,9 @@
 #pragma once
 
 #include <vector>
+#include <span>
 #include <morph/vec.h>
+#include <morph/vecs.h>
 #include <morph/VisualModel.h>
 #include <morph/ColourMap.h>
 #include <morph/scale.h>
@@ -50,9 +52,47 @@ namespace morph {
         void setZScale (const scale<T, float>& zscale) { this->zScale = zscale; }
         void setCScale (const scale<T, float>& cscale) { this->colourScale = cscale; }
         void setScalarData (const std::vector<T>* _data) { this->scalarData = _data; }
+
+        /*!
+         * Bind externally managed scalar data without copying it. The span can view an
+         * arena allocation, a double-buffer or persistently mapped GPU memory; it must
+         * remain valid for as long as it is bound. After mutating the underlying
+         * memory, call refresh() to re-read it. Visuals which read their data through
+         * scalarDataSpan() (the grid visuals do) honour the binding; for others,
+         * setScalarData remains the supported route.
+         */
+        void bindScalarData (std::span<const T> _data) { this->scalarDataBound = _data; }
+
+        //! The scalar data as a span: the bound span if one was set with
+        //! bindScalarData, otherwise a view of *scalarData (empty if neither is set)
+        std::span<const T> scalarDataSpan() const
+        {
+            if (this->scalarDataBound.empty() == false) { return this->scalarDataBound; }
+            if (this->scalarData != nullptr) {
+                return std::span<const T> (this->scalarData->data(), this->scalarData->size());
+            }
+            return std::span<const T>{};
+        }
+
+        //! Re-read the currently bound/set scalar data and rebuild the model. Derived
+        //! classes with a cheaper update path (incremental or colour-only) override this.
+        virtual void refresh() { this->reinit(); }
         void setVectorData (const std::vector<vec<T>>* _vectors) { this->vectorData = _vectors; }
         void setDataCoords (std::vector<vec<float>>* _coords) { this->dataCoords = _coords; }
 
+        /*!
+         * Set coordinates from a structure-of-arrays cloud (morph::vecs). The points
+         * are gathered into an owned, interleaved copy which dataCoords then points at,
+         * so the caller's vecs can go out of scope (and can stay in its vectorizable
+         * layout for the caller's own bulk transforms). Call again after changing the
+         * cloud; unlike the pointer overload, changes are not seen automatically.
+         */
+        void setDataCoords (const morph::vecs<float, 3>& _coords)
+        {
+            this->dataCoordsOwned = _coords.to_aos();
+            this->dataCoords = &this->dataCoordsOwned;
+        }
+
         void updateZScale (const scale<T, float>& zscale)
         {
             this->zScale = zscale;
@@ -84,6 +124,15 @@ namespace morph {
             this->reinit();
         }
 
+        /*!
+         * Update only the colours of the model from new scalar data. Visuals whose geometry does
+         * not depend on the data values (or whose values have changed but not their coordinates)
+         * can override this to rewrite just the colour part of their vertex buffers, which is
+         * much cheaper than the full re-tessellation that updateData performs. This base
+         * implementation falls back to updateData.
+         */
+        virtual void updateColours (const std::vector<T>* _data) { this->updateData (_data); }
+
         //! Update the scalar data with an associated z-scaling
         void updateData (const std::vector<T>* _data, const scale<T, float>& zscale)
         {
@@ -129,6 +178,15 @@ namespace morph {
             this->reinit();
         }
 
+        //! Update the coordinate data from a structure-of-arrays cloud (see the vecs
+        //! overload of setDataCoords) and rebuild the model
+        void updateCoords (const morph::vecs<float, 3>& _coords)
+        {
+            this->dataCoordsOwned = _coords.to_aos();
+            this->dataCoords = &this->dataCoordsOwned;
+            this->reinit();
+        }
+
         //! Update the vector data (for plotting quiver plots)
         void updateData (const std::vector<vec<T>>* _vectors)
         {
@@ -170,6 +228,9 @@ namespace morph {
         //! visualization is of directional information, such as in a quiver plot,
         const std::vector<T>* scalarData = nullptr;
 
+        //! A non-owning view of externally managed scalar data. See bindScalarData.
+        std::span<const T> scalarDataBound;
+
         //! A container for vector data to visualize. Can also be used for colour of the
         //! hexes.
         const std::vector<vec<T>>* vectorData = nullptr;
@@ -178,6 +239,10 @@ namespace morph {
         //! graph, quiver plot). Note fixed type of float, which is suitable for
         //! OpenGL coordinates. Not const as child code may resize or update content.
         std::vector<vec<float>>* dataCoords = nullptr;
+
+        //! Interleaved copy of coordinates passed in structure-of-arrays form; the
+        //! vecs overloads of setDataCoords/updateCoords point dataCoords here.
+        std::vector<vec<float>> dataCoordsOwned;
     };
 
 } // namespace morph
@@ -161,6 +161,55 @@ namespace morph {
         return shdr;
     }
 
+    /*
+     * ID-buffer picking shaders. Geometry is transformed exactly as in the default 2D
+     * projection shader, but each fragment's colour encodes which model and which
+     * element it belongs to: model id (a uniform, 1-255) in the red channel and a
+     * 24 bit element id in green/blue/alpha. The element id arrives as a per-vertex
+     * float attribute in slot morph::visgl::pickLoc (floats hold integers exactly up
+     * to 2^24); models without a pick attribute get element id 0. A one pixel
+     * readback of the resulting image identifies what lies under the cursor. See
+     * VisualOwnable*::pick.
+     */
+    const char* pickVtxShader = "uniform mat4 m_matrix;\n"
+    "uniform mat4 v_matrix;\n"
+    "uniform mat4 p_matrix;\n"
+    "layout(location = 0) in vec4 position;\n"
+    "layout(location = 4) in float pickid;\n"
+    "flat out float elem_id;\n"
+    "void main()\n"
+    "{\n"
+    "    gl_Position = (p_matrix * v_matrix * m_matrix * position);\n"
+    "    elem_id = pickid;\n"
+    "}\n";
+
+    std::string getDefaultPickVtxShader (const int glver)
+    {
+        std::string shdr;
+        shdr += morph::gl::version::shaderpreamble (glver);
+        shdr += pickVtxShader;
+        return shdr;
+    }
+
+    const char* pickFragShader = "flat in float elem_id;\n"
+    "uniform float model_id;\n"
+    "out vec4 finalcolor;\n"
+    "void main()\n"
+    "{\n"
+    "    float b0 = floor(mod(elem_id, 256.0));\n"
+    "    float b1 = floor(mod(elem_id / 256.0, 256.0));\n"
+    "    float b2 = floor(elem_id / 65536.0);\n"
+    "    finalcolor = vec4(model_id / 255.0, b0 / 255.0, b1 / 255.0, b2 / 255.0);\n"
+    "}\n";
+
+    std::string getDefaultPickFragShader (const int glver)
+    {
+        std::string shdr;
+        shdr += morph::gl::version::shaderpreamble (glver);
+        shdr += pickFragShader;
+        return shdr;
+    }
+
     // Default text vertex shader. See VisText.vert.glsl
     const char* defaultTextVtxShader = "uniform mat4 m_matrix;\n"
     "uniform mat4 v_matrix;\n"
@@ -185,13 +234,22 @@ namespace morph {
     }
 
     // Default text fragment shader. See VisText.frag.glsl
+    // Text is rendered from either a coverage atlas (sampled red channel is the glyph
+    // alpha) or, when sdf_text is set, a signed-distance-field atlas thresholded at 0.5
+    // with a screen-space smoothstep for resolution-independent edges.
     const char* defaultTextFragShader = "in vec2 TexCoords;\n"
     "out vec4 color;\n"
     "uniform sampler2D text;\n"
     "uniform vec3 textColor;\n"
+    "uniform float sdf_text;\n" // 0 unless set; renderers set it from TextFeatures::sdf
     "void main()\n"
     "{\n"
-    "    color = vec4(textColor, texture(text, TexCoords).r);\n"
+    "    float a = texture(text, TexCoords).r;\n"
+    "    if (sdf_text > 0.5) {\n"
+    "        float w = fwidth(a);\n"
+    "        a = smoothstep(0.5 - w, 0.5 + w, a);\n"
+    "    }\n"
+    "    color = vec4(textColor, a);\n"
     "}\n";
 
     std::string getDefaultTextFragShader (const int glver)
@@ -202,6 +260,299 @@ namespace morph {
         return shdr;
     }
 
+    // Vertex shader for texture-backed grid surfaces (see TexturedGridVisual.h). The
+    // standard colour attribute carries the texture coordinates for the quad corners.
+    const char* texturedGridVtxShader = "uniform mat4 m_matrix;\n"
+    "uniform mat4 v_matrix;\n"
+    "uniform mat4 p_matrix;\n"
+    "layout(location = 0) in vec4 position;\n"
+    "layout(location = 1) in vec4 normalin;\n"
+    "layout(location = 2) in vec3 color;\n"
+    "out vec2 TexCoords;\n"
+    "void main()\n"
+    "{\n"
+    "    gl_Position = p_matrix * v_matrix * m_matrix * position;\n"
+    "    TexCoords = color.xy;\n"
+    "}";
+
+    std::string getTexturedGridVtxShader (const int glver)
+    {
+        std::string shdr;
+        shdr += morph::gl::version::shaderpreamble (glver);
+        shdr += texturedGridVtxShader;
+        return shdr;
+    }
+
+    // Fragment shader for texture-backed grid surfaces. Samples the scalar field from a
+    // single-channel texture and colour-maps it through a 1D look-up-table texture.
+    const char* texturedGridFragShader = "in vec2 TexCoords;\n"
+    "out vec4 finalcolor;\n"
+    "uniform sampler2D datatex;\n"
+    "uniform sampler2D lut;\n"
+    "uniform float scale_min;\n"
+    "uniform float scale_range;\n"
+    "uniform float alpha;\n"
+    "void main()\n"
+    "{\n"
+    "    float datum = texture(datatex, TexCoords).r;\n"
+    "    float s = clamp((datum - scale_min) / scale_range, 0.0, 1.0);\n"
+    "    finalcolor = vec4(texture(lut, vec2(s, 0.5)).rgb, alpha);\n"
+    "}\n";
+
+    std::string getTexturedGridFragShader (const int glver)
+    {
+        std::string shdr;
+        shdr += morph::gl::version::shaderpreamble (glver);
+        shdr += texturedGridFragShader;
+        return shdr;
+    }
+
+    // Vertex shader for instanced sphere markers (see InstancedScatterVisual.h). The
+    // mesh attributes (locations 0-2) describe a unit sphere at the origin; each
+    // instance supplies its centre and radius (location 4) and colour (location 5).
+    // The lighting interface matches the default fragment shader.
+    const char* instancedSphereVtxShader = "uniform mat4 m_matrix;\n"
+    "uniform mat4 v_matrix;\n"
+    "uniform mat4 p_matrix;\n"
+    "uniform float alpha;\n"
+    "layout(location = 0) in vec4 position;\n"
+    "layout(location = 1) in vec4 normalin;\n"
+    "layout(location = 2) in vec3 color;\n"
+    "layout(location = 4) in vec4 inst_posn_rad;\n"
+    "layout(location = 5) in vec3 inst_colour;\n"
+    "out VERTEX\n"
+    "{\n"
+    "    vec4 normal;\n"
+    "    vec4 color;\n"
+    "    vec3 fragpos;\n"
+    "} vertex;\n"
+    "void main()\n"
+    "{\n"
+    "    vec4 wpos = vec4(position.xyz * inst_posn_rad.w + inst_posn_rad.xyz, 1.0);\n"
+    "    gl_Position = p_matrix * v_matrix * m_matrix * wpos;\n"
+    "    vertex.color = vec4(inst_colour, alpha);\n"
+    "    vertex.fragpos = vec3(m_matrix * wpos);\n"
+    "    vertex.normal = normalin;\n"
+    "}\n";
+
+    std::string getInstancedSphereVtxShader (const int glver)
+    {
+        std::string shdr;
+        shdr += morph::gl::version::shaderpreamble (glver);
+        shdr += instancedSphereVtxShader;
+        return shdr;
+    }
+
+    // Vertex shader for instanced arrow glyphs (see InstancedQuiverVisual.h). The mesh
+    // attributes describe a unit arrow along +z; each instance supplies its start
+    // position and shaft thickness (location 4), its (screen-scaled) vector (location
+    // 5) and colour (location 6). The arrow is scaled in z by the vector length, in
+    // x/y by the thickness, and rotated so +z lies along the vector. The lighting
+    // interface matches the default fragment shader.
+    const char* instancedQuiverVtxShader = "uniform mat4 m_matrix;\n"
+    "uniform mat4 v_matrix;\n"
+    "uniform mat4 p_matrix;\n"
+    "uniform float alpha;\n"
+    "layout(location = 0) in vec4 position;\n"
+    "layout(location = 1) in vec4 normalin;\n"
+    "layout(location = 2) in vec3 color;\n"
+    "layout(location = 4) in vec4 inst_start_thick;\n"
+    "layout(location = 5) in vec3 inst_vec;\n"
+    "layout(location = 6) in vec3 inst_colour;\n"
+    "out VERTEX\n"
+    "{\n"
+    "    vec4 normal;\n"
+    "    vec4 color;\n"
+    "    vec3 fragpos;\n"
+    "} vertex;\n"
+    "void main()\n"
+    "{\n"
+    "    float len = length(inst_vec);\n"
+    "    vec3 d = len > 0.0 ? inst_vec / len : vec3(0.0, 0.0, 1.0);\n"
+    "    vec3 a = abs(d.z) < 0.99 ? vec3(0.0, 0.0, 1.0) : vec3(1.0, 0.0, 0.0);\n"
+    "    vec3 xb = normalize(cross(a, d));\n"
+    "    vec3 yb = cross(d, xb);\n"
+    "    mat3 rotn = mat3(xb, yb, d);\n"
+    "    float th = max(inst_start_thick.w, 1e-8);\n"
+    "    vec3 lpos = vec3(position.x * th, position.y * th, position.z * len);\n"
+    "    vec4 wpos = vec4(inst_start_thick.xyz + rotn * lpos, 1.0);\n"
+    "    gl_Position = p_matrix * v_matrix * m_matrix * wpos;\n"
+    "    vertex.color = vec4(inst_colour, alpha);\n"
+    "    vertex.fragpos = vec3(m_matrix * wpos);\n"
+    "    vec3 lnrm = vec3(normalin.x / th, normalin.y / th, normalin.z / max(len, 1e-8));\n"
+    "    vertex.normal = vec4(normalize(rotn * lnrm), 0.0);\n"
+    "}\n";
+
+    std::string getInstancedQuiverVtxShader (const int glver)
+    {
+        std::string shdr;
+        shdr += morph::gl::version::shaderpreamble (glver);
+        shdr += instancedQuiverVtxShader;
+        return shdr;
+    }
+
+    // Fragment shader for a colour bar gradient quad (see TexturedColourBarVisual.h).
+    // The first texture coordinate runs from 0 to 1 along the bar; it indexes the
+    // colour map look-up-table texture directly.
+    const char* colourBarFragShader = "in vec2 TexCoords;\n"
+    "out vec4 finalcolor;\n"
+    "uniform sampler2D lut;\n"
+    "uniform float alpha;\n"
+    "void main()\n"
+    "{\n"
+    "    finalcolor = vec4(texture(lut, vec2(TexCoords.x, 0.5)).rgb, alpha);\n"
+    "}\n";
+
+    std::string getColourBarFragShader (const int glver)
+    {
+        std::string shdr;
+        shdr += morph::gl::version::shaderpreamble (glver);
+        shdr += colourBarFragShader;
+        return shdr;
+    }
+
+    // Fragment shader for video-textured surfaces (see TexturedCurvyTellyVisual.h).
+    // Samples the streamed frame texture directly; no colour mapping.
+    const char* videoFragShader = "in vec2 TexCoords;\n"
+    "out vec4 finalcolor;\n"
+    "uniform sampler2D frametex;\n"
+    "uniform float alpha;\n"
+    "void main()\n"
+    "{\n"
+    "    finalcolor = vec4(texture(frametex, TexCoords).rgb, alpha);\n"
+    "}\n";
+
+    std::string getVideoFragShader (const int glver)
+    {
+        std::string shdr;
+        shdr += morph::gl::version::shaderpreamble (glver);
+        shdr += videoFragShader;
+        return shdr;
+    }
+
+    // Fragment shader for a shader-animated grating (see ShaderGratingVisual.h). The
+    // model-space x/y of the fragment rides in the texture coordinates; the square
+    // wave between the two band colours is evaluated here, so drifting the grating is
+    // a v_offset uniform update rather than a re-tessellation.
+    const char* gratingFragShader = "in vec2 TexCoords;\n"
+    "out vec4 finalcolor;\n"
+    "uniform vec2 u_dir;\n"
+    "uniform vec2 v_offset;\n"
+    "uniform float lambda;\n"
+    "uniform vec3 colour1;\n"
+    "uniform vec3 colour2;\n"
+    "uniform float alpha;\n"
+    "void main()\n"
+    "{\n"
+    "    float s = fract(dot(TexCoords - v_offset, u_dir) / lambda);\n"
+    "    finalcolor = vec4(s < 0.5 ? colour1 : colour2, alpha);\n"
+    "}\n";
+
+    std::string getGratingFragShader (const int glver)
+    {
+        std::string shdr;
+        shdr += morph::gl::version::shaderpreamble (glver);
+        shdr += gratingFragShader;
+        return shdr;
+    }
+
+    // Vertex shader for GPU-expanded polylines (see PolylineVisual.h). Each vertex is
+    // a bare polyline point; the expansion to a screen-space-width ribbon happens in
+    // the polyline geometry shader, so this stage only transforms to clip space and
+    // forwards colour and fragment position.
+    const char* polylineVtxShader = "uniform mat4 m_matrix;\n"
+    "uniform mat4 v_matrix;\n"
+    "uniform mat4 p_matrix;\n"
+    "uniform float alpha;\n"
+    "layout(location = 0) in vec4 position;\n"
+    "layout(location = 2) in vec3 color;\n"
+    "out VERTEXG\n"
+    "{\n"
+    "    vec4 color;\n"
+    "    vec3 fragpos;\n"
+    "} vtx;\n"
+    "void main()\n"
+    "{\n"
+    "    gl_Position = p_matrix * v_matrix * m_matrix * position;\n"
+    "    vtx.color = vec4(color, alpha);\n"
+    "    vtx.fragpos = vec3(m_matrix * position);\n"
+    "}\n";
+
+    std::string getPolylineVtxShader (const int glver)
+    {
+        std::string shdr;
+        shdr += morph::gl::version::shaderpreamble (glver);
+        shdr += polylineVtxShader;
+        return shdr;
+    }
+
+    // Geometry shader for GPU-expanded polylines. Takes each segment (with its two
+    // adjacent points) and emits a quad whose width is linewidth pixels in screen
+    // space, mitred against the neighbouring segments (with the mitre length clamped
+    // so that sharp corners do not spike). The output interface matches the default
+    // fragment shader; the normal faces the camera so lighting leaves line colours
+    // flat, as computeFlatLine does.
+    const char* polylineGeomShader = "layout(lines_adjacency) in;\n"
+    "layout(triangle_strip, max_vertices = 4) out;\n"
+    "uniform vec2 viewport_size;\n"
+    "uniform float linewidth;\n"
+    "in VERTEXG\n"
+    "{\n"
+    "    vec4 color;\n"
+    "    vec3 fragpos;\n"
+    "} vtx[];\n"
+    "out VERTEX\n"
+    "{\n"
+    "    vec4 normal;\n"
+    "    vec4 color;\n"
+    "    vec3 fragpos;\n"
+    "} vertex;\n"
+    "vec2 toscreen (vec4 clip) { return (clip.xy / clip.w) * viewport_size * 0.5; }\n"
+    "void emitoffset (int i, vec2 offset_px)\n"
+    "{\n"
+    "    vec4 clip = gl_in[i].gl_Position;\n"
+    "    clip.xy += offset_px * (2.0 / viewport_size) * clip.w;\n"
+    "    gl_Position = clip;\n"
+    "    vertex.normal = vec4(0.0, 0.0, 1.0, 0.0);\n"
+    "    vertex.color = vtx[i].color;\n"
+    "    vertex.fragpos = vtx[i].fragpos;\n"
+    "    EmitVertex();\n"
+    "}\n"
+    "void main()\n"
+    "{\n"
+    "    vec2 p0 = toscreen (gl_in[0].gl_Position);\n"
+    "    vec2 p1 = toscreen (gl_in[1].gl_Position);\n"
+    "    vec2 p2 = toscreen (gl_in[2].gl_Position);\n"
+    "    vec2 p3 = toscreen (gl_in[3].gl_Position);\n"
+    "    vec2 d = p2 - p1;\n"
+    "    float dlen = length(d);\n"
+    "    if (dlen < 1e-6) { return; }\n"
+    "    d /= dlen;\n"
+    "    vec2 n = vec2(-d.y, d.x);\n"
+    "    vec2 d0 = length(p1 - p0) > 1e-6 ? normalize(p1 - p0) : d;\n"
+    "    vec2 d2 = length(p3 - p2) > 1e-6 ? normalize(p3 - p2) : d;\n"
+    "    vec2 t1 = normalize(d0 + d);\n"
+    "    vec2 m1 = vec2(-t1.y, t1.x);\n"
+    "    float l1 = clamp (1.0 / max (dot (m1, n), 0.25), 1.0, 4.0);\n"
+    "    vec2 t2 = normalize(d + d2);\n"
+    "    vec2 m2 = vec2(-t2.y, t2.x);\n"
+    "    float l2 = clamp (1.0 / max (dot (m2, n), 0.25), 1.0, 4.0);\n"
+    "    float hw = linewidth * 0.5;\n"
+    "    emitoffset (1, m1 * (hw * l1));\n"
+    "    emitoffset (1, -m1 * (hw * l1));\n"
+    "    emitoffset (2, m2 * (hw * l2));\n"
+    "    emitoffset (2, -m2 * (hw * l2));\n"
+    "    EndPrimitive();\n"
+    "}\n";
+
+    std::string getPolylineGeomShader (const int glver)
+    {
+        std::string shdr;
+        shdr += morph::gl::version::shaderpreamble (glver);
+        shdr += polylineGeomShader;
+        return shdr;
+    }
+
     // Cylindrical projection
     const char* defaultCylShader = "uniform mat4 mvp_matrix;\n"
     "uniform mat4 vp_matrix;\n"
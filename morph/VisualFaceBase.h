@@ -13,14 +13,18 @@
 #pragma once
 
 #include <map>
+#include <vector>
+#include <algorithm>
 #include <iostream>
 #include <utility>
 #include <fstream>
+#include <cstring>
 
 #include <morph/tools.h>
 #include <morph/VisualCommon.h> // for visgl::CharInfo
 #include <morph/VisualFont.h>
 #include <morph/TextFeatures.h>
+#include <morph/TextGeometry.h>
 
 // FreeType for text rendering
 #include <ft2build.h>
@@ -168,18 +172,224 @@ namespace morph {
         struct VisualFaceBase
         {
             VisualFaceBase () {}
-            ~VisualFaceBase () {}
+            //! The face is kept open for the lifetime of the VisualFace, so that glyphs can be
+            //! loaded into the atlas on demand. Close it here.
+            ~VisualFaceBase ()
+            {
+                if (this->face_open == true) {
+                    FT_Done_Face (this->face);
+                    this->face_open = false;
+                }
+            }
 
             //! Set true for informational/debug messages
             static constexpr bool debug_visualface = false;
 
             //! The FT_Face that we're managing
             FT_Face face;
+            //! True while this->face is valid (opened, not yet FT_Done_Face-ed)
+            bool face_open = false;
 
             //! The OpenGL character info stuff
             std::map<char32_t, morph::visgl::CharInfo> glchars;
 
+            /*!
+             * A cache of the layout geometry of strings that have been laid out with this face,
+             * in unscaled font-pixel units (scale by VisualTextModel::fontscale at the point of
+             * use). Labels that are recreated with the same text - tick labels during a dynamic
+             * graph rescale, for example - then skip the per-glyph metrics loop.
+             */
+            std::map<std::basic_string<char32_t>, morph::TextGeometry> text_geometry_cache;
+
+            //! The ID of the single atlas texture that holds every loaded glyph of this face
+            //! (generated by the derived, GL-calling class)
+            unsigned int atlas_textureID = 0;
+            //! The width and height of the (always square) atlas texture in pixels
+            unsigned int atlas_dim = 0;
+
         protected:
+            //! A CPU-side copy of the atlas pixels (GL_RED format), one byte per pixel
+            std::vector<unsigned char> atlas_pixels;
+            //! The shelf-packing cursor: next glyph goes at (atlas_pen_x, atlas_pen_y)
+            unsigned int atlas_pen_x = 0;
+            unsigned int atlas_pen_y = 0;
+            //! The height of the current shelf (the tallest glyph packed into it)
+            unsigned int atlas_row_h = 0;
+            //! Empty pixels left between packed glyphs, so that linear filtering cannot bleed
+            //! one glyph into its neighbour
+            static constexpr unsigned int atlas_padding = 1;
+            //! Set true (with a warning) if the atlas fills up; further new glyphs render blank
+            bool atlas_full = false;
+
+            /*!
+             * When true, glyph bitmaps are converted to signed distance fields as they
+             * are loaded (see make_glyph_sdf), for resolution-independent rendering
+             * with the smoothstep branch of the text fragment shader. Set from
+             * TextFeatures::sdf via the derived class's constructor.
+             */
+            bool sdf_mode = false;
+            //! The SDF spread: how many pixels of distance range (and of padding around
+            //! each glyph) the field encodes. 128 in the texture is the glyph edge.
+            static constexpr unsigned int sdf_spread = 4;
+
+            /*!
+             * Convert the coverage bitmap of the glyph just rendered into this->face
+             * into a signed distance field with sdf_spread pixels of padding on every
+             * side, returning the field (one byte per pixel; 128 at the glyph edge,
+             * >128 inside) and its dimensions in \a sw and \a sh. Distances come from
+             * a two-pass 3-4 chamfer transform - accurate to a few percent, which is
+             * plenty for smoothstep thresholding in the fragment shader.
+             */
+            std::vector<unsigned char> make_glyph_sdf (unsigned int& sw, unsigned int& sh)
+            {
+                const unsigned int w = this->face->glyph->bitmap.width;
+                const unsigned int h = this->face->glyph->bitmap.rows;
+                const unsigned char* cov = this->face->glyph->bitmap.buffer;
+                const int pitch = this->face->glyph->bitmap.pitch;
+                constexpr int s = static_cast<int>(sdf_spread);
+                sw = w + 2u * sdf_spread;
+                sh = h + 2u * sdf_spread;
+                constexpr int far_away = 1 << 28;
+
+                // Forward/backward chamfer passes. Orthogonal steps cost 3, diagonal 4
+                // (approximating 3 * sqrt(2)), so distances are in thirds of a pixel.
+                auto chamfer = [this, &sw, &sh] (std::vector<int>& d) {
+                    const int iw = static_cast<int>(sw);
+                    const int ih = static_cast<int>(sh);
+                    auto at = [&d, iw] (const int x, const int y) -> int& { return d[y * iw + x]; };
+                    for (int y = 0; y < ih; ++y) {
+                        for (int x = 0; x < iw; ++x) {
+                            int v = at (x, y);
+                            if (x > 0) { v = std::min (v, at (x - 1, y) + 3); }
+                            if (y > 0) {
+                                v = std::min (v, at (x, y - 1) + 3);
+                                if (x > 0) { v = std::min (v, at (x - 1, y - 1) + 4); }
+                                if (x + 1 < iw) { v = std::min (v, at (x + 1, y - 1) + 4); }
+                            }
+                            at (x, y) = v;
+                        }
+                    }
+                    for (int y = ih - 1; y >= 0; --y) {
+                        for (int x = iw - 1; x >= 0; --x) {
+                            int v = at (x, y);
+                            if (x + 1 < iw) { v = std::min (v, at (x + 1, y) + 3); }
+                            if (y + 1 < ih) {
+                                v = std::min (v, at (x, y + 1) + 3);
+                                if (x + 1 < iw) { v = std::min (v, at (x + 1, y + 1) + 4); }
+                                if (x > 0) { v = std::min (v, at (x - 1, y + 1) + 4); }
+                            }
+                            at (x, y) = v;
+                        }
+                    }
+                };
+
+                std::vector<int> dist_out (static_cast<std::size_t>(sw) * sh, far_away);
+                std::vector<int> dist_in (static_cast<std::size_t>(sw) * sh, 0);
+                for (unsigned int y = 0; y < h; ++y) {
+                    for (unsigned int x = 0; x < w; ++x) {
+                        if (cov[static_cast<std::size_t>(y) * pitch + x] >= 128u) {
+                            const std::size_t i = static_cast<std::size_t>(y + s) * sw + (x + s);
+                            dist_out[i] = 0;        // an inside pixel: zero distance-to-glyph
+                            dist_in[i] = far_away;  // ...and to be computed distance-to-outside
+                        }
+                    }
+                }
+                chamfer (dist_out);
+                chamfer (dist_in);
+
+                std::vector<unsigned char> sdf (static_cast<std::size_t>(sw) * sh);
+                for (std::size_t i = 0; i < sdf.size(); ++i) {
+                    // Signed distance in pixels; positive inside the glyph
+                    const float signed_px = static_cast<float>(dist_in[i] - dist_out[i]) / 3.0f;
+                    const float norm = 0.5f + signed_px / (2.0f * static_cast<float>(sdf_spread));
+                    sdf[i] = static_cast<unsigned char>(255.0f * std::clamp (norm, 0.0f, 1.0f));
+                }
+                return sdf;
+            }
+
+            //! Choose the atlas dimensions from the font pixel size and create the CPU-side
+            //! pixel store. Sized for a typical working set of a few hundred distinct glyphs.
+            void init_atlas (const unsigned int fontpixels)
+            {
+                unsigned int dim = 1024;
+                // Room for roughly 400-500 glyphs of height fontpixels; capped at 4096 which
+                // every OpenGL 4 implementation must support
+                const unsigned int target = 19u * fontpixels;
+                while (dim < target && dim < 4096u) { dim <<= 1; }
+                this->atlas_dim = dim;
+                this->atlas_pixels.assign (static_cast<std::size_t>(dim) * dim, 0);
+            }
+
+            /*!
+             * Load the glyph for unicode character \a c with FreeType, pack its bitmap into the
+             * CPU-side atlas and return the filled-out CharInfo (which includes the glyph's
+             * texture coordinates within the atlas). On failure (character missing from the
+             * font, FreeType error or full atlas) a zero-size CharInfo is returned, which draws
+             * nothing - matching the old behaviour for missing glyphs. The derived class is
+             * responsible for uploading the packed region (returned in \a atlas_pos) to the GL
+             * texture.
+             */
+            morph::visgl::CharInfo load_glyph_common (const char32_t c, morph::vec<unsigned int, 2>& atlas_pos)
+            {
+                morph::visgl::CharInfo ci = { this->atlas_textureID, {0, 0}, {0, 0}, 0u, {0.0f, 0.0f, 0.0f, 0.0f} };
+                atlas_pos = { 0u, 0u };
+                if (this->face_open == false || FT_Get_Char_Index (this->face, c) == 0) { return ci; }
+                if (FT_Load_Char (this->face, c, FT_LOAD_RENDER)) {
+                    std::cout << "ERROR::FREETYPE: Failed to load Glyph for Unicode 0x"
+                              << std::hex << static_cast<unsigned int>(c) << std::dec << std::endl;
+                    return ci;
+                }
+                ci.size = { static_cast<int>(this->face->glyph->bitmap.width),
+                            static_cast<int>(this->face->glyph->bitmap.rows) };
+                ci.bearing = { this->face->glyph->bitmap_left, this->face->glyph->bitmap_top };
+                ci.advance = static_cast<unsigned int>(this->face->glyph->advance.x);
+
+                unsigned int w = this->face->glyph->bitmap.width;
+                unsigned int h = this->face->glyph->bitmap.rows;
+                if (w == 0 || h == 0) { return ci; } // e.g. the space character; no pixels to pack
+
+                // In SDF mode, replace the coverage bitmap with a padded distance
+                // field and grow the metrics to cover the padding
+                std::vector<unsigned char> sdf;
+                const unsigned char* src = this->face->glyph->bitmap.buffer;
+                std::size_t src_pitch = static_cast<std::size_t>(this->face->glyph->bitmap.pitch);
+                if (this->sdf_mode == true) {
+                    sdf = this->make_glyph_sdf (w, h);
+                    src = sdf.data();
+                    src_pitch = w;
+                    ci.size = { static_cast<int>(w), static_cast<int>(h) };
+                    ci.bearing[0] -= static_cast<int>(sdf_spread);
+                    ci.bearing[1] += static_cast<int>(sdf_spread);
+                }
+
+                // Shelf-pack: start a new row if this glyph won't fit in the current one
+                if (this->atlas_pen_x + w + atlas_padding > this->atlas_dim) {
+                    this->atlas_pen_y += this->atlas_row_h + atlas_padding;
+                    this->atlas_pen_x = 0;
+                    this->atlas_row_h = 0;
+                }
+                if (this->atlas_pen_y + h + atlas_padding > this->atlas_dim) {
+                    if (this->atlas_full == false) {
+                        std::cout << "ERROR::VisualFace: The glyph atlas is full; new glyphs will render blank" << std::endl;
+                        this->atlas_full = true;
+                    }
+                    ci.size = { 0, 0 };
+                    return ci;
+                }
+                // Copy the bitmap (or distance field) rows into the CPU-side atlas
+                for (unsigned int r = 0; r < h; ++r) {
+                    std::memcpy (this->atlas_pixels.data()
+                                 + (static_cast<std::size_t>(this->atlas_pen_y) + r) * this->atlas_dim + this->atlas_pen_x,
+                                 src + static_cast<std::size_t>(r) * src_pitch, w);
+                }
+                atlas_pos = { this->atlas_pen_x, this->atlas_pen_y };
+                const float fdim = static_cast<float>(this->atlas_dim);
+                ci.uv = { this->atlas_pen_x / fdim, this->atlas_pen_y / fdim,
+                          (this->atlas_pen_x + w) / fdim, (this->atlas_pen_y + h) / fdim };
+                this->atlas_pen_x += w + atlas_padding;
+                this->atlas_row_h = (h > this->atlas_row_h) ? h : this->atlas_row_h;
+                return ci;
+            }
 
             void init_common (const morph::VisualFont _font, unsigned int fontpixels, FT_Library& ft_freetype)
             {
@@ -382,6 +592,8 @@ namespace morph {
                 }
                 if (FT_New_Face (ft_freetype, fontpath.c_str(), 0, &this->face)) {
                     std::cout << "ERROR::FREETYPE: Failed to load font (font file may be invalid)" << std::endl;
+                } else {
+                    this->face_open = true;
                 }
 
                 FT_Set_Pixel_Sizes (this->face, 0, fontpixels);
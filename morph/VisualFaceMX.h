@@ -41,67 +41,71 @@ namespace morph {
              * the same pixel size.
              */
             VisualFaceMX (const morph::VisualFont _font, unsigned int fontpixels, FT_Library& ft_freetype,
-                          GladGLContext* glfn = nullptr)
+                          GladGLContext* _glfn = nullptr, const bool sdf = false)
+                : glfn(_glfn)
             {
                 this->init_common (_font, fontpixels, ft_freetype);
+                this->sdf_mode = sdf;
 
-                // How far to loop. In principle, up to 21 bits worth - that's 2097151 possible characters!
-                for (char32_t c = 0; c < 2097151; c++) {
-                    // Check glyph index first, if it's 0 it's a blank so skip.
-                    if (FT_Get_Char_Index (this->face, c) == 0) { continue; }
+                if (this->glfn == nullptr) { throw std::runtime_error ("glfn problem"); }
 
-                    // load character glyph
-                    if (FT_Load_Char (this->face, c, FT_LOAD_RENDER)) {
-                        std::cout << "ERROR::FREETYPE: Failed to load Glyph for Unicode 0x"
-                                  << std::hex << static_cast<unsigned int>(c) << std::dec << std::endl;
-                        continue;
-                    }
-
-                    // generate texture
-                    unsigned int texture = 0;
-
-                    if (glfn == nullptr) { throw std::runtime_error ("glfn problem"); }
-                    glfn->GenTextures (1, &texture);
-                    glfn->BindTexture (GL_TEXTURE_2D, texture);
-                    glfn->TexImage2D(
-                        GL_TEXTURE_2D,
-                        0,
-                        GL_RED,
-                        this->face->glyph->bitmap.width,
-                        this->face->glyph->bitmap.rows,
-                        0,
-                        GL_RED,
-                        GL_UNSIGNED_BYTE,
-                        this->face->glyph->bitmap.buffer
-                        );
-                    // set texture options
-                    glfn->TexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-                    glfn->TexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-                    glfn->TexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-                    glfn->TexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR); // Could be GL_NEAREST, but doesn't look as good.
+                // Create the single glyph-atlas texture for this face. Glyphs are rendered and
+                // packed into it on demand (see getchar), so that all the text of all the
+                // VisualTextModels sharing this face can be drawn from one texture. SDF glyphs
+                // carry sdf_spread pixels of padding per side, so size the atlas for that.
+                this->init_atlas (fontpixels + (sdf == true ? 2u * VisualFaceBase::sdf_spread : 0u));
+                this->glfn->GenTextures (1, &this->atlas_textureID);
+                this->glfn->BindTexture (GL_TEXTURE_2D, this->atlas_textureID);
+                this->glfn->TexImage2D (GL_TEXTURE_2D, 0, GL_RED, this->atlas_dim, this->atlas_dim, 0,
+                                        GL_RED, GL_UNSIGNED_BYTE, this->atlas_pixels.data());
+                // set texture options
+                this->glfn->TexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+                this->glfn->TexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+                this->glfn->TexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+                this->glfn->TexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR); // Could be GL_NEAREST, but doesn't look as good.
+                this->glfn->BindTexture (GL_TEXTURE_2D, 0);
+            }
 
-                    // now store character for later use
-                    morph::visgl::CharInfo glchar = {
-                        texture,
-                        {static_cast<int>(this->face->glyph->bitmap.width), static_cast<int>(this->face->glyph->bitmap.rows)}, // size
-                        {this->face->glyph->bitmap_left, this->face->glyph->bitmap_top}, // bearing
-                        static_cast<unsigned int>(this->face->glyph->advance.x)          // advance
-                    };
+            /*!
+             * Obtain the CharInfo for unicode character \a c, loading the glyph into the atlas
+             * (and uploading the packed region to the atlas texture) if this is the first
+             * request for it. The returned CharInfo for a character that is missing from the
+             * font has zero size and renders nothing.
+             */
+            const morph::visgl::CharInfo& getchar (const char32_t c)
+            {
+                auto gi = this->glchars.find (c);
+                if (gi != this->glchars.end()) { return gi->second; }
 
-                    if constexpr (debug_visualface == true) {
-                        std::cout << "Inserting character into this->glchars with info: ID:" << glchar.textureID
-                                  << ", Size:" << glchar.size << ", Bearing:" << glchar.bearing
-                                  << ", Advance:" << glchar.advance << std::endl;
-                    }
-                    this->glchars.insert (std::pair<char32_t, morph::visgl::CharInfo>(c, glchar));
+                morph::vec<unsigned int, 2> atlas_pos = { 0u, 0u };
+                morph::visgl::CharInfo ci = this->load_glyph_common (c, atlas_pos);
+                ci.textureID = this->atlas_textureID;
+                if (ci.size[0] > 0 && ci.size[1] > 0) {
+                    // Upload just the newly packed region from the CPU-side atlas
+                    this->glfn->BindTexture (GL_TEXTURE_2D, this->atlas_textureID);
+                    this->glfn->PixelStorei (GL_UNPACK_ROW_LENGTH, this->atlas_dim);
+                    this->glfn->TexSubImage2D (GL_TEXTURE_2D, 0, atlas_pos[0], atlas_pos[1], ci.size[0], ci.size[1],
+                                               GL_RED, GL_UNSIGNED_BYTE,
+                                               this->atlas_pixels.data()
+                                               + static_cast<std::size_t>(atlas_pos[1]) * this->atlas_dim + atlas_pos[0]);
+                    this->glfn->PixelStorei (GL_UNPACK_ROW_LENGTH, 0);
+                    this->glfn->BindTexture (GL_TEXTURE_2D, 0);
+                }
+                if constexpr (debug_visualface == true) {
+                    std::cout << "Inserting character into this->glchars with info: ID:" << ci.textureID
+                              << ", Size:" << ci.size << ", Bearing:" << ci.bearing
+                              << ", Advance:" << ci.advance << ", uv:" << ci.uv << std::endl;
                 }
-                glfn->BindTexture(GL_TEXTURE_2D, 0);
+                return this->glchars.insert (std::pair<char32_t, morph::visgl::CharInfo>(c, ci)).first->second;
+            }
 
-                // At this point could FT_Done_Face() etc, I think. as we no longer do anything Freetypey with it.
-                FT_Done_Face (this->face);
+            ~VisualFaceMX()
+            {
+                if (this->atlas_textureID != 0) { this->glfn->DeleteTextures (1, &this->atlas_textureID); }
             }
 
-            ~VisualFaceMX() {}
+            //! The multi-context GL function pointers, needed for on-demand glyph uploads
+            GladGLContext* glfn = nullptr;
         };
     } // namespace gl
 } // namespace morph
@@ -0,0 +1,260 @@
+/*!
+ * \file
+ *
+ * Awesome graphics code for high performance graphing and visualisation.
+ *
+ * This is a *headless* visual scene class. It derives from morph::VisualOwnableNoMX, but instead
+ * of presenting the scene in a GLFW window, it creates an OpenGL context with EGL, drawing into an
+ * offscreen pbuffer surface. That makes it possible to batch-generate figures on machines with no
+ * display server at all (containers, render farms, CI) - no X, no Xvfb. The EGL pbuffer provides a
+ * regular default framebuffer, so render(), saveImage() and saveImageAsync() all work exactly as
+ * they do in the windowed classes.
+ *
+ * Usage is as for morph::VisualNoMX, except that there is no user interaction: construct, add and
+ * finalize your VisualModels, call render() and then saveImage ("plot.png").
+ *
+ * Do not include this header in the same translation unit as morph::Visual/VisualNoMX; one program
+ * draws either to windows or headlessly.
+ *
+ * \author Seb James
+ * \date August 2026
+ */
+#pragma once
+
+#include <EGL/egl.h>
+
+#include <mutex>
+#include <string>
+#include <stdexcept>
+
+namespace morph {
+    // In a headless Visual there is no window; the scene renders into an EGL pbuffer. The win_t
+    // type (the VisualBase::window member) is unused.
+    using win_t = void;
+}
+
+#include <morph/gl/version.h>
+#include <morph/VisualOwnableNoMX.h>
+
+namespace morph {
+
+    /*!
+     * Headless Visual 'scene' class
+     *
+     * A class for visualising computational models, rendering into an offscreen EGL surface
+     * rather than an on-screen window. See the file comment above for usage.
+     *
+     * \tparam glver The OpenGL version, encoded as a single int (see morph::gl::version)
+     */
+    template <int glver = morph::gl::version_4_1>
+    class VisualHeadlessNoMX : public morph::VisualOwnableNoMX<glver>
+    {
+    public:
+        /*!
+         * Construct a headless visualiser with a \a _width x \a _height pixel framebuffer. The
+         * rule is one EGL context to one Visual object. \a _title is used only for saved files
+         * and version output.
+         */
+        VisualHeadlessNoMX (const int _width, const int _height, const std::string& _title, const bool _version_stdout = true)
+        {
+            this->window_w = _width;
+            this->window_h = _height;
+            this->title = _title;
+            this->version_stdout = _version_stdout;
+
+            this->init_resources();
+            this->init_gl();
+
+            // Special tasks: re-bind coordArrows and title text
+            this->bindextra (this->coordArrows);
+            this->bindextra (this->textModel);
+        }
+
+        //! Deconstructor destroys the EGL context/surface/display connection
+        ~VisualHeadlessNoMX()
+        {
+            this->setContext();
+            this->deconstructCommon();
+            if (this->egl_display != EGL_NO_DISPLAY) {
+                eglMakeCurrent (this->egl_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+                if (this->egl_context != EGL_NO_CONTEXT) { eglDestroyContext (this->egl_display, this->egl_context); }
+                if (this->egl_surface != EGL_NO_SURFACE) { eglDestroySurface (this->egl_display, this->egl_surface); }
+                eglTerminate (this->egl_display);
+            }
+        }
+
+        // Do one-time init of the Visual's resources. This gets/creates the VisualResources and
+        // sets up the EGL context (the headless stand-in for creating a window).
+        void init_resources()
+        {
+            // VisualResources provides font management. Ensure it exists in memory.
+            morph::VisualResourcesNoMX<glver>::i().create();
+            // Set up the EGL context that will take the OpenGL graphics. FreeType
+            // initialization is deferred to the first text render (see
+            // VisualResourcesNoMX::getVisualFace), so a text-free context pays
+            // nothing for font setup.
+            this->init_context();
+        }
+
+        //! There is no display to sync with, so nothing to do here
+        void setSwapInterval() final {}
+
+        //! Make this Visual's EGL context current, so that when creating/adding a visual model,
+        //! the vao ids relate to the correct OpenGL context.
+        void setContext() final
+        {
+            eglMakeCurrent (this->egl_display, this->egl_surface, this->egl_surface, this->egl_context);
+        }
+
+        //! A pbuffer is single buffered; just ensure the GL commands are flushed to it
+        void swapBuffers() final { glFlush(); }
+
+        //! Lock the context to prevent accessing the OpenGL context from multiple threads
+        //! then obtain the context.
+        void lockContext()
+        {
+            this->context_mutex.lock();
+            this->setContext();
+        }
+
+        //! Attempt to lock the context. If the mutex lock is obtained, set the OpenGL
+        //! context and return true. If the mutex lock is not obtained, return false.
+        bool tryLockContext()
+        {
+            if (this->context_mutex.try_lock()) {
+                this->setContext();
+                return true;
+            }
+            return false;
+        }
+
+        //! Release the OpenGL context and unlock the context mutex.
+        void unlockContext()
+        {
+            this->releaseContext();
+            this->context_mutex.unlock();
+        }
+
+        //! Release the OpenGL context
+        void releaseContext() final
+        {
+            eglMakeCurrent (this->egl_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        }
+
+        //! Return true if this Visual's EGL context is the current one
+        bool checkContext()
+        {
+            return this->egl_context == EGL_NO_CONTEXT ? false : (eglGetCurrentContext() == this->egl_context);
+        }
+
+        /*!
+         * Set up the passed-in VisualModel (or indeed, VisualTextModel) with functions that need access to Visual attributes.
+         */
+        template <typename T>
+        void bindmodel (std::unique_ptr<T>& model)
+        {
+            morph::VisualBase<glver>::template bindmodel<T> (model);
+            model->setContext = &morph::VisualBase<glver>::set_context;
+            model->releaseContext = &morph::VisualBase<glver>::release_context;
+        }
+
+        template <typename T>
+        void bindextra (std::unique_ptr<T>& model)
+        {
+            model->setContext = &morph::VisualBase<glver>::set_context;
+            model->releaseContext = &morph::VisualBase<glver>::release_context;
+        }
+
+    private:
+
+        //! The headless analogue of init_window: connect to the default EGL display (which needs
+        //! no display server), choose a pbuffer-capable config and create context and surface.
+        void init_context()
+        {
+            this->egl_display = eglGetDisplay (EGL_DEFAULT_DISPLAY);
+            EGLint egl_major = 0;
+            EGLint egl_minor = 0;
+            bool egl_up = (this->egl_display != EGL_NO_DISPLAY
+                           && eglInitialize (this->egl_display, &egl_major, &egl_minor) == EGL_TRUE);
+#ifdef EGL_VERSION_1_5
+            if (egl_up == false) {
+                // The default display needs a GPU device node; in a bare container there may be
+                // none. Fall back to Mesa's surfaceless platform, which renders in software
+                // (llvmpipe). The platform constant is from EGL_MESA_platform_surfaceless.
+                constexpr EGLenum platform_surfaceless_mesa = 0x31DD;
+                this->egl_display = eglGetPlatformDisplay (platform_surfaceless_mesa, nullptr, nullptr);
+                egl_up = (this->egl_display != EGL_NO_DISPLAY
+                          && eglInitialize (this->egl_display, &egl_major, &egl_minor) == EGL_TRUE);
+            }
+#endif
+            if (egl_up == false) {
+                throw std::runtime_error ("VisualHeadless: Could not initialize an EGL display. "
+                                          "Is there an EGL implementation (Mesa) installed?");
+            }
+
+            constexpr bool gles = morph::gl::version::gles (glver);
+            const EGLint cfg_attribs[] = {
+                EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+                EGL_RED_SIZE, 8,
+                EGL_GREEN_SIZE, 8,
+                EGL_BLUE_SIZE, 8,
+                EGL_ALPHA_SIZE, 8,
+                EGL_DEPTH_SIZE, 24,
+                EGL_RENDERABLE_TYPE, (gles ? EGL_OPENGL_ES2_BIT : EGL_OPENGL_BIT),
+                EGL_NONE
+            };
+            EGLConfig cfg{};
+            EGLint n_cfg = 0;
+            if (eglChooseConfig (this->egl_display, cfg_attribs, &cfg, 1, &n_cfg) == EGL_FALSE || n_cfg < 1) {
+                throw std::runtime_error ("VisualHeadless: eglChooseConfig found no pbuffer-capable config");
+            }
+
+            if (eglBindAPI (gles ? EGL_OPENGL_ES_API : EGL_OPENGL_API) == EGL_FALSE) {
+                throw std::runtime_error ("VisualHeadless: eglBindAPI failed");
+            }
+
+            // The pbuffer surface stands in for the window and provides the default framebuffer
+            const EGLint pbuf_attribs[] = {
+                EGL_WIDTH, this->window_w,
+                EGL_HEIGHT, this->window_h,
+                EGL_NONE
+            };
+            this->egl_surface = eglCreatePbufferSurface (this->egl_display, cfg, pbuf_attribs);
+            if (this->egl_surface == EGL_NO_SURFACE) {
+                throw std::runtime_error ("VisualHeadless: eglCreatePbufferSurface failed");
+            }
+
+            const EGLint ctx_attribs[] = {
+                EGL_CONTEXT_MAJOR_VERSION, morph::gl::version::major (glver),
+                EGL_CONTEXT_MINOR_VERSION, morph::gl::version::minor (glver),
+                EGL_NONE
+            };
+            this->egl_context = eglCreateContext (this->egl_display, cfg, EGL_NO_CONTEXT, ctx_attribs);
+            if (this->egl_context == EGL_NO_CONTEXT) {
+                throw std::runtime_error ("VisualHeadless: eglCreateContext failed (OpenGL "
+                                          + morph::gl::version::vstring (glver) + " requested)");
+            }
+
+            this->setContext();
+
+#ifdef GLAD_GL // Load GL function aliases via GLAD, getting the functions from EGL
+            this->init_glad (reinterpret_cast<GLADloadfunc>(eglGetProcAddress));
+#endif
+        }
+
+    private:
+        //! The EGL display connection (EGL_DEFAULT_DISPLAY; no display server involved)
+        EGLDisplay egl_display = EGL_NO_DISPLAY;
+        //! The offscreen pbuffer surface that provides our default framebuffer
+        EGLSurface egl_surface = EGL_NO_SURFACE;
+        //! The OpenGL context in which this scene renders
+        EGLContext egl_context = EGL_NO_CONTEXT;
+        //! Context mutex to prevent contexts being acquired in a non-threadsafe manner.
+        std::mutex context_mutex;
+    };
+
+    //! The headless scene class is expected to be used via this shorter name
+    template <int glver = morph::gl::version_4_1>
+    using VisualHeadless = morph::VisualHeadlessNoMX<glver>;
+
+} // namespace morph
@@ -78,25 +78,23 @@ namespace morph {
         //! Deconstructor destroys GLFW/Qt window and deregisters access to VisualResources
         ~VisualMX()
         {
+            this->closeMirrors();
             this->setContext();
             glfwDestroyWindow (this->window);
             this->deconstructCommon();
         }
 
         // Do one-time init of the Visual's resources. This gets/creates the VisualResources,
-        // registers this visual with resources, calls init_window for any glfw stuff that needs to
-        // happen, and lastly initializes the freetype code.
+        // registers this visual with resources and calls init_window for any glfw stuff that needs
+        // to happen. FreeType initialization is deferred to the first text render (see
+        // VisualResourcesMX::getVisualFace), so a text-free window pays nothing for font setup.
         void init_resources()
         {
             morph::VisualGlfw<glver>::i().init(); // Init GLFW windows system
             // VisualResources provides font management. Ensure it exists in memory.
             morph::VisualResourcesMX<glver>::i().create();
-            // Set up the window that will present the OpenGL graphics.  This has to
-            // happen BEFORE the call to VisualResources::freetype_init()
+            // Set up the window that will present the OpenGL graphics
             this->init_window();
-            this->setContext(); // For freetype_init
-            this->freetype_init();
-            this->releaseContext();
         }
 
         void setSwapInterval() final
@@ -226,6 +224,132 @@ namespace morph {
             }
         }
 
+        /*!
+         * A secondary window that renders this Visual's models with its own view. Its
+         * GL context shares buffer objects, textures and shader programs with the main
+         * window's context, so no model data is duplicated; only a small per-window
+         * vertex array object and a GL function context are created (VAOs are not
+         * shareable). See addMirrorWindow.
+         */
+        struct MirrorWindow
+        {
+            GLFWwindow* win = nullptr;
+            //! The mirror context's own GL function pointers
+            GladGLContext* glfn = nullptr;
+            //! The mirror context's own vertex array object
+            GLuint vao = 0;
+            //! The mirror's view of the scene
+            morph::vec<float, 3> scenetrans = { 0.0f, 0.0f, -5.0f };
+            morph::quaternion<float> rotation;
+        };
+
+        /*!
+         * Open an additional window of size \a _width x \a _height which renders the
+         * same VisualModels as this Visual, with a per-window view (see
+         * setMirrorView). The new window's GL context shares this window's buffer
+         * objects, textures and shader programs, so an extra display adds no GPU
+         * memory and no per-frame update cost for the models themselves. Mirror
+         * windows are display-only: no mouse/key handling and no text rendering.
+         * Refresh them with renderMirrors() after each render(). Returns the index of
+         * the new mirror window.
+         */
+        unsigned int addMirrorWindow (const std::string& _title, const int _width, const int _height)
+        {
+            MirrorWindow mw;
+            mw.win = glfwCreateWindow (_width, _height, _title.c_str(), NULL, this->window);
+            if (!mw.win) { throw std::runtime_error ("GLFW mirror window creation failed!"); }
+            glfwMakeContextCurrent (mw.win);
+            mw.glfn = this->create_gladgl_context (glfwGetProcAddress);
+            if (mw.glfn == nullptr) {
+                glfwDestroyWindow (mw.win);
+                this->setContext();
+                throw std::runtime_error ("Failed to load GL functions for mirror window!");
+            }
+            mw.scenetrans = this->scenetrans;
+            mw.rotation = this->rotation;
+            this->mirrors.push_back (mw);
+            this->setContext();
+            return static_cast<unsigned int>(this->mirrors.size() - 1u);
+        }
+
+        //! Give mirror window \a mi its own view of the scene
+        void setMirrorView (const unsigned int mi,
+                            const morph::vec<float, 3>& _scenetrans, const morph::quaternion<float>& _rotation)
+        {
+            if (mi >= this->mirrors.size()) { return; }
+            this->mirrors[mi].scenetrans = _scenetrans;
+            this->mirrors[mi].rotation = _rotation;
+        }
+
+        //! Render the scene into each mirror window, then restore the main context.
+        //! Call after render(), which is what uploads any changed model buffers.
+        void renderMirrors()
+        {
+            for (auto& mw : this->mirrors) {
+                if (mw.win == nullptr) { continue; }
+                glfwMakeContextCurrent (mw.win);
+                if (mw.vao == 0) { mw.glfn->GenVertexArrays (1, &mw.vao); }
+                mw.glfn->BindVertexArray (mw.vao);
+
+                int fb_w = 0, fb_h = 0;
+                glfwGetFramebufferSize (mw.win, &fb_w, &fb_h);
+                if (fb_w <= 0 || fb_h <= 0) { continue; }
+                mw.glfn->UseProgram (this->shaders.gprog);
+                mw.glfn->Viewport (0, 0, fb_w, fb_h);
+                // Raster state is per-context; set the options that render() relies on
+                mw.glfn->Enable (GL_DEPTH_TEST);
+                mw.glfn->Enable (GL_BLEND);
+                mw.glfn->BlendFunc (GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                mw.glfn->Disable (GL_CULL_FACE);
+
+                // The mirror's own projection; its aspect ratio may differ. (Uniforms
+                // are program state and programs are shared, so the lighting uniforms
+                // set by render() carry over; p_matrix is re-set per window.)
+                morph::mat44<float> proj;
+                proj.perspective (this->fov, static_cast<float>(fb_w) / static_cast<float>(fb_h),
+                                  this->zNear, this->zFar);
+                GLint loc_p = mw.glfn->GetUniformLocation (this->shaders.gprog, static_cast<const GLchar*>("p_matrix"));
+                if (loc_p != -1) { mw.glfn->UniformMatrix4fv (loc_p, 1, GL_FALSE, proj.mat.data()); }
+
+                mw.glfn->Clear (GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                mw.glfn->ClearBufferfv (GL_COLOR, 0, this->bgcolour.data());
+
+                morph::mat44<float> sceneview;
+                sceneview.translate (mw.scenetrans);
+                sceneview.rotate (mw.rotation);
+                morph::mat44<float> scenetransonly;
+                scenetransonly.translate (mw.scenetrans);
+
+                for (auto& model : this->vm) {
+                    model->render_shared (mw.glfn, this->shaders.gprog,
+                                          model->twodimensional == true ? scenetransonly : sceneview);
+                }
+                mw.glfn->BindVertexArray (0);
+                glfwSwapBuffers (mw.win);
+            }
+            this->setContext();
+        }
+
+        //! Close all mirror windows and release their vertex array objects
+        void closeMirrors()
+        {
+            for (auto& mw : this->mirrors) {
+                if (mw.win == nullptr) { continue; }
+                glfwMakeContextCurrent (mw.win);
+                if (mw.vao != 0) { mw.glfn->DeleteVertexArrays (1, &mw.vao); mw.vao = 0; }
+                this->free_gladgl_context (mw.glfn);
+                mw.glfn = nullptr;
+                glfwDestroyWindow (mw.win);
+                mw.win = nullptr;
+            }
+            this->mirrors.clear();
+            if (this->window != nullptr) { this->setContext(); }
+        }
+
+    protected:
+        //! Any secondary windows sharing this Visual's GL objects (see addMirrorWindow)
+        std::vector<MirrorWindow> mirrors;
+
     private:
 
         void init_window()
@@ -262,6 +386,7 @@ namespace morph {
         {
             VisualMX<glver>* self = static_cast<VisualMX<glver>*>(glfwGetWindowUserPointer (_window));
             if (self->key_callback (key, scancode, action, mods)) {
+                self->signal_needs_render();
                 self->render();
             }
         }
@@ -274,6 +399,7 @@ namespace morph {
         {
             VisualMX<glver>* self = static_cast<VisualMX<glver>*>(glfwGetWindowUserPointer (_window));
             if (self->cursor_position_callback (x, y)) {
+                self->signal_needs_render();
                 self->render();
             }
         }
@@ -281,6 +407,7 @@ namespace morph {
         {
             VisualMX<glver>* self = static_cast<VisualMX<glver>*>(glfwGetWindowUserPointer (_window));
             if (self->window_size_callback (width, height)) {
+                self->signal_needs_render();
                 self->render();
             }
         }
@@ -293,6 +420,7 @@ namespace morph {
         {
             VisualMX<glver>* self = static_cast<VisualMX<glver>*>(glfwGetWindowUserPointer (_window));
             if (self->scroll_callback (xoffset, yoffset)) {
+                self->signal_needs_render();
                 self->render();
             }
         }
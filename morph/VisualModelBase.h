@@ -20,9 +20,11 @@
 #include <morph/vec.h>
 #include <morph/range.h>
 #include <morph/mathconst.h>
+#include <morph/constexpr_math.h>
 #include <morph/VisualCommon.h>
 #include <morph/colour.h>
 #include <morph/base64.h>
+#include <morph/profile.h>
 #include <morph/MathAlgo.h>
 #include <iostream>
 #include <vector>
@@ -32,8 +34,13 @@
 #include <string>
 #include <memory>
 #include <functional>
+#include <map>
+#include <utility>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <cmath>
+#include <bit>
 
 namespace morph {
 
@@ -107,6 +114,42 @@ namespace morph {
         //! reinit ONLY vertexColors buffer
         virtual void reinit_colour_buffer() = 0;
 
+        /*!
+         * Hand over this model's OpenGL buffer and vertex array ids, appending them
+         * to \a buf_ids and \a vao_ids, and forget them - after this the destructor
+         * has no GL deletions left to make. VisualOwnable*::deconstructCommon uses
+         * this to collect the ids from every model and delete them with a single
+         * glDeleteBuffers and glDeleteVertexArrays pair, which is far quicker than a
+         * pair of GL calls per model when a scene holds thousands of models.
+         */
+        virtual void surrender_gl_ids (std::vector<GLuint>& buf_ids, std::vector<GLuint>& vao_ids)
+        {
+            if (this->vbos != nullptr) {
+                for (unsigned int i = 0; i < numVBO; ++i) { buf_ids.push_back (this->vbos[i]); }
+                this->vbos.reset (nullptr);
+            }
+            if (this->vao != 0) { vao_ids.push_back (this->vao); this->vao = 0; }
+        }
+
+        /*!
+         * Re-upload a sub-range of the vertexPositions and vertexColors buffers with
+         * glBufferSubData. \a start_vertex and \a n_vertices count whole vertices (3 floats
+         * each). This supports dirty-region update paths (see HexGridVisual::updateData),
+         * which avoid re-uploading entire VBOs when only a few elements of a data field have
+         * changed. The CPU-side vertexPositions/vertexColors must already contain the new
+         * values for the range.
+         */
+        virtual void reinit_buffers_region (unsigned int start_vertex, unsigned int n_vertices) = 0;
+
+        /*!
+         * Upload vertices and indices that client code has *appended* to the CPU-side
+         * arrays (from vertex number \a start_vertex and index number \a start_index
+         * to the ends of the arrays). The buffers are allocated with reserve capacity,
+         * so that repeated appends are glBufferSubData tail writes, not full
+         * glBufferData re-allocations. Used by GraphVisual's incremental append mode.
+         */
+        virtual void reinit_buffers_appended (unsigned int start_vertex, unsigned int start_index) = 0;
+
         virtual void clearTexts() = 0;
 
         //! Clear out the model, *including text models*
@@ -125,6 +168,7 @@ namespace morph {
         void reinit()
         {
             if (this->setContext != nullptr) { this->setContext (this->parentVis); }
+            this->pooled = false; // a rebuilt model leaves the scene geometry pool
             // Fixme: Better not to clear, then repeatedly pushback here:
             this->vertexPositions.clear();
             this->vertexNormals.clear();
@@ -132,7 +176,9 @@ namespace morph {
             this->indices.clear();
             // NB: Do NOT call clearTexts() here! We're only updating the model itself.
             this->idx = 0u;
+            this->reserve_predicted_vertices();
             this->initializeVertices();
+            this->cacheModelExtents();
             this->reinit_buffers();
         }
 
@@ -144,13 +190,16 @@ namespace morph {
         void reinit_with_clearTexts()
         {
             if (this->setContext != nullptr) { this->setContext (this->parentVis); }
+            this->pooled = false; // a rebuilt model leaves the scene geometry pool
             this->vertexPositions.clear();
             this->vertexNormals.clear();
             this->vertexColors.clear();
             this->indices.clear();
             this->clearTexts();
             this->idx = 0u;
+            this->reserve_predicted_vertices();
             this->initializeVertices();
+            this->cacheModelExtents();
             this->reinit_buffers();
         }
 
@@ -162,20 +211,153 @@ namespace morph {
             this->indices.reserve (6u * n_vertices);
         }
 
+        /*!
+         * Predict approximately how many vertices this model's initializeVertices() will
+         * generate. finalize() and reinit() use the prediction to reserve the vertex
+         * containers once, up front, rather than letting them grow by repeated
+         * reallocation during the build. Return 0 (the default) when no useful
+         * prediction can be made. The prediction need not be exact - it is a capacity
+         * hint, and a modest over-estimate is preferable to an under-estimate.
+         */
+        virtual std::size_t predict_vertex_count() const { return 0; }
+
+        //! If the model predicts its vertex count, reserve that much capacity
+        void reserve_predicted_vertices()
+        {
+            std::size_t n_vertices = this->predict_vertex_count();
+            if (n_vertices > 0) { this->reserve_vertices (n_vertices); }
+        }
+
         /*!
          * A function to call initialiseVertices and postVertexInit after any necessary attributes
          * have been set (see, for example, setting the colour maps up in VisualDataModel).
          */
         void finalize()
         {
+            MORPH_PROFILE_SCOPE ("VisualModel::finalize");
             if (this->setContext != nullptr) { this->setContext (this->parentVis); }
+            auto t0 = std::chrono::steady_clock::now();
+            this->reserve_predicted_vertices();
             this->initializeVertices();
+            this->vertex_init_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            this->cacheModelExtents();
             this->postVertexInitRequired = true;
             // Release context after creating and finalizing this VisualModel. On Visual::render(),
             // context will be re-acquired.
             if (this->releaseContext != nullptr) { this->releaseContext (this->parentVis); }
         }
 
+        /*!
+         * An optional, client-settable name for this model, used in profiling output
+         * (see VisualBase::frame_stats) and useful in debugging
+         */
+        std::string name;
+
+        //! How long the initializeVertices call took in the last finalize(), in ms
+        double vertex_init_ms = 0.0;
+
+        /*!
+         * Set this true to declare that this model's initializeVertices() makes no
+         * OpenGL calls (in particular, that it creates no text labels, as
+         * VisualTextModel creation uploads glyph textures). Such models may have
+         * their vertices built on a worker thread by VisualBase::finalize_models.
+         * The default is false, which keeps finalization on the OpenGL thread.
+         */
+        bool threadsafe_vertex_init = false;
+
+        /*!
+         * Set true (before finalize()) to permit the index buffer to be uploaded as
+         * GL_UNSIGNED_SHORT when the model has few enough vertices (<= 65536). This halves
+         * index buffer memory and bandwidth, which is worthwhile when very many small models
+         * (markers and the like) are resident. The CPU-side indices remain GLuint; conversion
+         * happens at upload. Ignored when buffer streaming is in use.
+         */
+        bool compact_indices = false;
+
+        /*!
+         * Set true (before finalize()) to upload the vertex attributes in packed
+         * formats: GL_HALF_FLOAT positions, 10_10_10_2 packed normals and RGBA8
+         * colours - 14 bytes per vertex instead of 36. This more than halves vertex
+         * memory and upload bandwidth, which is what matters for big scenes that are
+         * GPU-transfer bound during reinit. The CPU-side staging buffers remain
+         * float; conversion happens at upload, in setupVBO. Note that half positions
+         * carry ~3 decimal digits of precision, so only opt in where that is enough.
+         * Requires OpenGL 3.3+ (or OpenGL ES 3.0+) for the packed normal format.
+         * Ignored when buffer streaming is in use, and not for models that use the
+         * incremental append path (both write floats directly).
+         */
+        bool packed_attributes = false;
+
+        /*!
+         * Per-vertex element ids for the ID-buffer picking pass (see
+         * VisualOwnable*::pick). Models which support element-level picking override
+         * fillPickIDs() to map each vertex to the index of the data element (hex,
+         * rect, datum...) it belongs to; the ids are uploaded as a float attribute in
+         * slot morph::visgl::pickLoc. When left empty, the model is still pickable as
+         * a whole, with element id 0. A float holds integers exactly up to 2^24, so
+         * element indices are limited to pick_id_none - 1.
+         */
+        std::vector<float> pickIDs;
+
+        //! The element id given to vertices which belong to no data element (borders,
+        //! tubes and other decorations). pick() reports these as element -1.
+        static constexpr float pick_id_none = 16777215.0f; // 2^24 - 1
+
+        //! Fill pickIDs with one element id per vertex. The default leaves pickIDs
+        //! empty: the model can be picked, but not resolved to an element.
+        virtual void fillPickIDs() {}
+
+        /*!
+         * Set true (before the parent Visual's buildGeometryPool() call) to allow this
+         * model's geometry to be merged into the scene's shared vertex/index buffers.
+         * Suits scenes with very many small, static models (markers, rods, coordinate
+         * frames), where per-model VAO/VBO handling dominates driver time. Pooled
+         * models should be finalized once and not subsequently reinit'd.
+         */
+        bool join_geometry_pool = false;
+
+        /*!
+         * True while this model's geometry is resident in the scene geometry pool. The
+         * model then skips its own draw (the parent Visual draws its triangles from
+         * the pool with a base-vertex draw call) and needs no VAO/VBOs of its own.
+         * Cleared by reinit(), which returns the model to its own buffers; call the
+         * parent's buildGeometryPool() again to re-admit it.
+         */
+        bool pooled = false;
+
+        //! This model's base vertex within the scene geometry pool
+        unsigned int pool_base_vertex = 0u;
+        //! The offset (in indices) of this model's triangles in the pool index buffer
+        unsigned int pool_index_offset = 0u;
+        //! The number of indices this model contributes to the pool
+        unsigned int pool_index_count = 0u;
+
+        //! The number of vertices in the model's CPU-side geometry
+        std::size_t geometry_vertex_count() const { return this->vertexPositions.size() / 3u; }
+        //! The number of indices in the model's CPU-side geometry
+        std::size_t geometry_index_count() const { return this->indices.size(); }
+
+        /*!
+         * Append this model's CPU-side geometry to the given pool containers (see
+         * VisualOwnable*::buildGeometryPool), recording where it lands in
+         * pool_base_vertex, pool_index_offset and pool_index_count. Normals or colours
+         * that are shorter than the positions are padded with zeros, so that the pool
+         * attribute buffers stay in step.
+         */
+        void append_geometry_to (morph::vertex_buffer_t<float>& pool_posn, morph::vertex_buffer_t<float>& pool_norm,
+                                 morph::vertex_buffer_t<float>& pool_col, morph::vertex_buffer_t<GLuint>& pool_idx)
+        {
+            this->pool_base_vertex = static_cast<unsigned int>(pool_posn.size() / 3u);
+            this->pool_index_offset = static_cast<unsigned int>(pool_idx.size());
+            this->pool_index_count = static_cast<unsigned int>(this->indices.size());
+            pool_posn.insert (pool_posn.end(), this->vertexPositions.begin(), this->vertexPositions.end());
+            pool_norm.insert (pool_norm.end(), this->vertexNormals.begin(), this->vertexNormals.end());
+            pool_norm.resize (pool_posn.size(), 0.0f);
+            pool_col.insert (pool_col.end(), this->vertexColors.begin(), this->vertexColors.end());
+            pool_col.resize (pool_posn.size(), 0.0f);
+            pool_idx.insert (pool_idx.end(), this->indices.begin(), this->indices.end());
+        }
+
         //! Render the VisualModel. Note that it is assumed that the OpenGL context has been
         //! obtained by the parent Visual::render call.
         virtual void render() = 0;
@@ -333,6 +515,100 @@ namespace morph {
             return axis_extents;
         }
 
+        /*!
+         * Cache the model-space bounding box of the vertices, for frustum culling (see
+         * VisualBase::frustum_cull). Called after each initializeVertices, from finalize() and
+         * the reinit functions.
+         */
+        void cacheModelExtents()
+        {
+            if (this->vertexPositions.size() >= 3u) {
+                this->model_bb = this->extents();
+                this->model_bb_valid = true;
+            } else {
+                this->model_bb_valid = false;
+            }
+        }
+
+        /*!
+         * A conservative view-frustum test. Transform the corners of the cached bounding box
+         * into clip space with \a proj and this model's scene and model matrices. If all eight
+         * corners fall outside the same clip plane the model cannot appear on screen and false
+         * is returned. Note that the box bounds this model's vertices only, not any text labels
+         * attached to it. Returns true (draw it) if no bounding box has been cached.
+         */
+        bool withinFrustum (const mat44<float>& proj) const
+        {
+            if (this->model_bb_valid == false) { return true; }
+            const mat44<float> pvm = proj * this->scenematrix * this->viewmatrix;
+            int outside[6] = { 0, 0, 0, 0, 0, 0 };
+            for (int c = 0; c < 8; ++c) {
+                const morph::vec<float, 4> corner = {
+                    (c & 1) ? this->model_bb[0].max : this->model_bb[0].min,
+                    (c & 2) ? this->model_bb[1].max : this->model_bb[1].min,
+                    (c & 4) ? this->model_bb[2].max : this->model_bb[2].min,
+                    1.0f
+                };
+                const morph::vec<float, 4> clip = pvm * corner;
+                if (clip[0] < -clip[3]) { ++outside[0]; }
+                if (clip[0] >  clip[3]) { ++outside[1]; }
+                if (clip[1] < -clip[3]) { ++outside[2]; }
+                if (clip[1] >  clip[3]) { ++outside[3]; }
+                if (clip[2] < -clip[3]) { ++outside[4]; }
+                if (clip[2] >  clip[3]) { ++outside[5]; }
+            }
+            for (int p = 0; p < 6; ++p) { if (outside[p] == 8) { return false; } }
+            return true;
+        }
+
+        /*!
+         * Project the cached bounding box into window pixel bounds. On success, fill \a
+         * rect with {x, y, w, h} - origin bottom-left, as glScissor expects - clamped to
+         * the vp_w x vp_h viewport (w and h are 0 if the model is entirely off screen)
+         * and return true. Returns false, meaning the caller should assume the model may
+         * cover the whole window, when no bounding box is cached or the box touches or
+         * crosses the camera plane. As with withinFrustum, the box bounds this model's
+         * vertices only, not any text labels attached to it.
+         */
+        bool screenBounds (const mat44<float>& proj, const int vp_w, const int vp_h, morph::vec<int, 4>& rect) const
+        {
+            if (this->model_bb_valid == false) { return false; }
+            const mat44<float> pvm = proj * this->scenematrix * this->viewmatrix;
+            float xmin = 1.0f, xmax = -1.0f, ymin = 1.0f, ymax = -1.0f;
+            for (int c = 0; c < 8; ++c) {
+                const morph::vec<float, 4> corner = {
+                    (c & 1) ? this->model_bb[0].max : this->model_bb[0].min,
+                    (c & 2) ? this->model_bb[1].max : this->model_bb[1].min,
+                    (c & 4) ? this->model_bb[2].max : this->model_bb[2].min,
+                    1.0f
+                };
+                const morph::vec<float, 4> clip = pvm * corner;
+                if (clip[3] <= 0.0f) { return false; } // a corner is behind the camera
+                const float nx = clip[0] / clip[3];
+                const float ny = clip[1] / clip[3];
+                xmin = nx < xmin ? nx : xmin;
+                xmax = nx > xmax ? nx : xmax;
+                ymin = ny < ymin ? ny : ymin;
+                ymax = ny > ymax ? ny : ymax;
+            }
+            // NDC to pixels, with a pixel of slack for rasterization rounding
+            int x0 = static_cast<int>(std::floor ((xmin * 0.5f + 0.5f) * vp_w)) - 1;
+            int x1 = static_cast<int>(std::ceil ((xmax * 0.5f + 0.5f) * vp_w)) + 1;
+            int y0 = static_cast<int>(std::floor ((ymin * 0.5f + 0.5f) * vp_h)) - 1;
+            int y1 = static_cast<int>(std::ceil ((ymax * 0.5f + 0.5f) * vp_h)) + 1;
+            x0 = x0 < 0 ? 0 : x0;
+            y0 = y0 < 0 ? 0 : y0;
+            x1 = x1 > vp_w ? vp_w : x1;
+            y1 = y1 > vp_h ? vp_h : y1;
+            rect = { x0, y0, (x1 > x0 ? x1 - x0 : 0), (y1 > y0 ? y1 - y0 : 0) };
+            return true;
+        }
+
+        //! The cached model-space bounding box (valid only if model_bb_valid is true)
+        morph::vec<morph::range<float>, 3> model_bb;
+        //! True once cacheModelExtents has run on a non-empty model
+        bool model_bb_valid = false;
+
         /*!
          * Compute the max and min values of indices and vertexPositions/Colors/Normals for use
          * when saving gltf files
@@ -428,6 +704,16 @@ namespace morph {
             }
             return base64::encode (_bytes);
         }
+
+        /*
+         * Raw views of this model's buffers for binary export (Visual::saveglb()), which writes
+         * the vectors' bytes straight to file with no base64 copy. GLB is little-endian, as are
+         * all the platforms we run on.
+         */
+        const char* indices_raw() const { return reinterpret_cast<const char*>(this->indices.data()); }
+        const char* vpos_raw() const { return reinterpret_cast<const char*>(this->vertexPositions.data()); }
+        const char* vcol_raw() const { return reinterpret_cast<const char*>(this->vertexColors.data()); }
+        const char* vnorm_raw() const { return reinterpret_cast<const char*>(this->vertexNormals.data()); }
         // end Visual::savegltf() methods
 
         //! If true, then this VisualModel should always be viewed in a plane - it's a 2D model
@@ -521,14 +807,65 @@ namespace morph {
         //! Vertex Buffer Objects stored in an array
         std::unique_ptr<GLuint[]> vbos;
 
+        /*!
+         * Set true *before the first render* to request persistent-mapped buffer
+         * streaming for this model. Where the driver supports it (desktop OpenGL 4.4
+         * or newer), the vertex buffers are then allocated once with glBufferStorage
+         * as persistently mapped, triple-buffered sections, and reinit_buffers()
+         * writes vertices straight into GPU-visible memory instead of re-allocating
+         * with glBufferData. This suits models (GraphVisual, HexGridVisual) that
+         * reinit every frame. Where unsupported, the glBufferData path is used and
+         * this flag has no effect.
+         */
+        bool use_persistent_buffers = false;
+
+        /*
+         * Internal state for the persistent-mapped streaming mode. See
+         * setup_streaming_buffers() in VisualModelImpl.
+         */
+
+        //! Number of in-flight sections in each streamed buffer
+        static constexpr unsigned int stream_nsections = 3;
+        //! True once persistent buffers have been allocated and mapped
+        bool stream_active = false;
+        //! The section that reinit_buffers() will write next
+        unsigned int stream_section = 0;
+        //! Per-section capacity of each vertex buffer, in floats
+        std::size_t stream_vcap = 0;
+        //! Per-section capacity of the index buffer, in elements
+        std::size_t stream_icap = 0;
+        //! Mapped base addresses of the position, normal and colour buffers
+        float* stream_vmap[3] = { nullptr, nullptr, nullptr };
+        //! Mapped base address of the index buffer
+        GLuint* stream_imap = nullptr;
+        //! Per-section fences, signalled when the GPU finishes reading a section
+        GLsync stream_fence[stream_nsections] = { nullptr, nullptr, nullptr };
+        //! Byte offset into the index buffer at which the current section's indices
+        //! start. Passed to glDrawElements. 0 in the glBufferData mode.
+        std::size_t stream_draw_offset = 0;
+
+        /*
+         * Reserve capacities for reinit_buffers_appended(). 0 means 'buffers were
+         * last allocated exact-size by the glBufferData path'.
+         */
+
+        //! Allocated capacity, in floats, of each vertex buffer
+        std::size_t append_vcap = 0;
+        //! Allocated capacity, in elements, of the index buffer
+        std::size_t append_icap = 0;
+
         //! CPU-side data for indices
-        std::vector<GLuint> indices = {};
+        morph::vertex_buffer_t<GLuint> indices = {};
+
+        //! The GL type of the *uploaded* index buffer: GL_UNSIGNED_SHORT when a
+        //! compact_indices upload has taken place, otherwise GL_UNSIGNED_INT
+        GLenum index_type = GL_UNSIGNED_INT;
         //! CPU-side data for vertex positions
-        std::vector<float> vertexPositions = {};
+        morph::vertex_buffer_t<float> vertexPositions = {};
         //! CPU-side data for vertex normals
-        std::vector<float> vertexNormals = {};
+        morph::vertex_buffer_t<float> vertexNormals = {};
         //! CPU-side data for vertex colours
-        std::vector<float> vertexColors = {};
+        morph::vertex_buffer_t<float> vertexColors = {};
 
         static constexpr float _max = std::numeric_limits<float>::max();
         static constexpr float _low = std::numeric_limits<float>::lowest();
@@ -557,25 +894,298 @@ namespace morph {
         // The morph::VisualBase in which this model exists.
         morph::VisualBase<glver>* parentVis = nullptr;
 
+        /*!
+         * Compute smooth, area-weighted per-vertex normals from vertexPositions and
+         * indices (triangles), overwriting vertexNormals. A tessellator that builds
+         * an indexed mesh can call this at the end of its initializeVertices() and
+         * skip per-primitive normal math entirely. Face normals are computed in
+         * parallel (and left un-normalized for the accumulation, so that larger
+         * faces weigh more); the scatter-accumulate onto shared vertices is serial,
+         * as it would race; the final normalization is parallel again. Vertices
+         * belonging to no triangle (or only to degenerate ones) get normal {0,0,1}.
+         *
+         * Note that shared-vertex smooth normals are only right for meshes that
+         * *share* vertices between faces. The flat-shaded visuals (QuadsVisual and
+         * friends) duplicate vertices per face deliberately and should keep their
+         * per-face normals.
+         */
+        void computeSmoothNormals()
+        {
+            const std::size_t nverts = this->vertexPositions.size() / 3u;
+            const std::size_t nfaces = this->indices.size() / 3u;
+
+            std::vector<morph::vec<float>> fnorms (nfaces);
+#pragma omp parallel for
+            for (std::ptrdiff_t fi = 0; fi < static_cast<std::ptrdiff_t>(nfaces); ++fi) {
+                const std::size_t i0 = 3u * this->indices[3u * fi];
+                const std::size_t i1 = 3u * this->indices[3u * fi + 1u];
+                const std::size_t i2 = 3u * this->indices[3u * fi + 2u];
+                const morph::vec<float> v0 = { this->vertexPositions[i0], this->vertexPositions[i0 + 1u], this->vertexPositions[i0 + 2u] };
+                const morph::vec<float> v1 = { this->vertexPositions[i1], this->vertexPositions[i1 + 1u], this->vertexPositions[i1 + 2u] };
+                const morph::vec<float> v2 = { this->vertexPositions[i2], this->vertexPositions[i2 + 1u], this->vertexPositions[i2 + 2u] };
+                const morph::vec<float> plane1 = v1 - v0;
+                const morph::vec<float> plane2 = v2 - v0;
+                fnorms[fi] = plane2.cross (plane1);
+            }
+
+            std::vector<morph::vec<float>> vnorms (nverts, morph::vec<float>{ 0.0f, 0.0f, 0.0f });
+            for (std::size_t fi = 0; fi < nfaces; ++fi) {
+                vnorms[this->indices[3u * fi]] += fnorms[fi];
+                vnorms[this->indices[3u * fi + 1u]] += fnorms[fi];
+                vnorms[this->indices[3u * fi + 2u]] += fnorms[fi];
+            }
+
+            this->vertexNormals.resize (3u * nverts);
+#pragma omp parallel for
+            for (std::ptrdiff_t v = 0; v < static_cast<std::ptrdiff_t>(nverts); ++v) {
+                morph::vec<float> vn = vnorms[v];
+                if (vn.length() > 0.0f) { vn.renormalize(); } else { vn = { 0.0f, 0.0f, 1.0f }; }
+                this->vertexNormals[3u * v] = vn[0];
+                this->vertexNormals[3u * v + 1u] = vn[1];
+                this->vertexNormals[3u * v + 2u] = vn[2];
+            }
+        }
+
         //! Push three floats onto the vector of floats \a vp
-        void vertex_push (const float& x, const float& y, const float& z, std::vector<float>& vp)
+        void vertex_push (const float& x, const float& y, const float& z, morph::vertex_buffer_t<float>& vp)
         {
             vec<float> vec = { x, y, z };
             std::copy (vec.begin(), vec.end(), std::back_inserter (vp));
         }
         //! Push array of 3 floats onto the vector of floats \a vp
-        void vertex_push (const std::array<float, 3>& arr, std::vector<float>& vp)
+        void vertex_push (const std::array<float, 3>& arr, morph::vertex_buffer_t<float>& vp)
         {
             std::copy (arr.begin(), arr.end(), std::back_inserter (vp));
         }
         //! Push morph::vec of 3 floats onto the vector of floats \a vp
-        void vertex_push (const vec<float>& vec, std::vector<float>& vp)
+        void vertex_push (const vec<float>& vec, morph::vertex_buffer_t<float>& vp)
         {
             std::copy (vec.begin(), vec.end(), std::back_inserter (vp));
         }
 
         //! Set up a vertex buffer object - bind, buffer and set vertex array object attribute
-        virtual void setupVBO (GLuint& buf, std::vector<float>& dat, unsigned int bufferAttribPosition) = 0;
+        virtual void setupVBO (GLuint& buf, morph::vertex_buffer_t<float>& dat, unsigned int bufferAttribPosition) = 0;
+
+        /*
+         * CPU-side conversions for the packed_attributes upload path. These have no
+         * GL calls, so they live here in the base; setupVBO in the Impl classes
+         * chooses the packing per attribute slot.
+         */
+
+        //! Convert a float to IEEE 754 half precision (round to nearest; denormals
+        //! flush to zero; out-of-range values saturate to infinity)
+        static std::uint16_t float_to_half (const float f)
+        {
+            const std::uint32_t x = std::bit_cast<std::uint32_t>(f);
+            const std::uint32_t sign = (x >> 16) & 0x8000u;
+            const std::int32_t e = static_cast<std::int32_t>((x >> 23) & 0xffu) - 127 + 15;
+            const std::uint32_t m = x & 0x007fffffu;
+            if (e <= 0) { return static_cast<std::uint16_t>(sign); }
+            if (e >= 31) { return static_cast<std::uint16_t>(sign | 0x7c00u); }
+            std::uint32_t half = sign | (static_cast<std::uint32_t>(e) << 10) | (m >> 13);
+            if (m & 0x1000u) { ++half; } // round up; a carry correctly bumps the exponent
+            return static_cast<std::uint16_t>(half);
+        }
+
+        //! Pack x/y/z float triplets as half precision for a GL_HALF_FLOAT attribute
+        static std::vector<std::uint16_t> pack_halves (const morph::vertex_buffer_t<float>& dat)
+        {
+            std::vector<std::uint16_t> packed (dat.size());
+            for (std::size_t i = 0; i < dat.size(); ++i) { packed[i] = float_to_half (dat[i]); }
+            return packed;
+        }
+
+        //! Pack unit-vector x/y/z triplets into one 2_10_10_10_REV word per vertex
+        //! for a normalized, signed packed attribute
+        static std::vector<std::uint32_t> pack_normals (const morph::vertex_buffer_t<float>& dat)
+        {
+            auto to10 = [](float f) -> std::uint32_t {
+                f = f > 1.0f ? 1.0f : (f < -1.0f ? -1.0f : f);
+                return static_cast<std::uint32_t>(static_cast<std::int32_t>(std::round (f * 511.0f))) & 0x3ffu;
+            };
+            std::vector<std::uint32_t> packed (dat.size() / 3u);
+            for (std::size_t i = 0; i < packed.size(); ++i) {
+                packed[i] = to10 (dat[3u * i]) | (to10 (dat[3u * i + 1u]) << 10) | (to10 (dat[3u * i + 2u]) << 20);
+            }
+            return packed;
+        }
+
+        //! Pack r/g/b float triplets into 4 bytes per vertex (alpha 255) for a
+        //! normalized GL_UNSIGNED_BYTE attribute
+        static std::vector<std::uint8_t> pack_colours (const morph::vertex_buffer_t<float>& dat)
+        {
+            auto to8 = [](float f) -> std::uint8_t {
+                f = f > 1.0f ? 1.0f : (f < 0.0f ? 0.0f : f);
+                return static_cast<std::uint8_t>(std::round (f * 255.0f));
+            };
+            std::vector<std::uint8_t> packed (4u * (dat.size() / 3u));
+            for (std::size_t i = 0; 3u * i < dat.size(); ++i) {
+                packed[4u * i] = to8 (dat[3u * i]);
+                packed[4u * i + 1u] = to8 (dat[3u * i + 1u]);
+                packed[4u * i + 2u] = to8 (dat[3u * i + 2u]);
+                packed[4u * i + 3u] = 255u;
+            }
+            return packed;
+        }
+
+        /*!
+         * (sin(t), cos(t)) pairs for the angles t = j * 2pi/segments, j in [0,
+         * segments). The compute* primitives call sin/cos for every ring segment of
+         * every tube, cone and sphere, and in a scene with thousands of primitives
+         * most of finalize() ends up in libm. A model usually draws all its
+         * primitives with one or two segment counts, so cache the tables. The cache
+         * is thread_local because separate threads may build separate models
+         * concurrently.
+         */
+        static const std::vector<morph::vec<float, 2>>& unit_circle_trig (int segments)
+        {
+            // The compute* primitives default to these segment counts. For them, serve tables
+            // computed at compile time (morph::math::unit_circle), so no libm calls are made
+            // even on first use.
+            switch (segments) {
+            case 8:   { static const std::vector<morph::vec<float, 2>> tbl = unit_circle_trig_ct<8>();   return tbl; }
+            case 12:  { static const std::vector<morph::vec<float, 2>> tbl = unit_circle_trig_ct<12>();  return tbl; }
+            case 128: { static const std::vector<morph::vec<float, 2>> tbl = unit_circle_trig_ct<128>(); return tbl; }
+            default: break;
+            }
+            static thread_local std::map<int, std::vector<morph::vec<float, 2>>> cache;
+            auto ci = cache.find (segments);
+            if (ci == cache.end()) {
+                std::vector<morph::vec<float, 2>> tbl (segments > 0 ? segments : 0);
+                for (int j = 0; j < segments; j++) {
+                    float t = j * morph::mathconst<float>::two_pi / static_cast<float>(segments);
+                    tbl[j] = { std::sin (t), std::cos (t) };
+                }
+                ci = cache.emplace (segments, std::move (tbl)).first;
+            }
+            return ci->second;
+        }
+
+        //! Copy the compile-time trig table for \tparam N segments into unit_circle_trig()'s
+        //! return format
+        template <int N>
+        static std::vector<morph::vec<float, 2>> unit_circle_trig_ct()
+        {
+            std::vector<morph::vec<float, 2>> tbl (N);
+            for (int j = 0; j < N; ++j) {
+                tbl[j] = { morph::math::unit_circle<float, N>::sines[j], morph::math::unit_circle<float, N>::cosines[j] };
+            }
+            return tbl;
+        }
+
+        /*!
+         * A unit-radius sphere mesh, as tessellated by computeSphere. The vertices
+         * double as the vertex normals (for a unit sphere centred on the origin, the
+         * normal of a vertex IS the vertex). ring_of_vertex records which ring each
+         * vertex belongs to (0 for the 'north pole' cap centre vertex through
+         * \a rings for the 'south pole' one), which the two colour computeSphere
+         * uses to choose each vertex's colour. The triangle indices are relative to
+         * vertex 0 of the mesh.
+         */
+        struct unitsphere_mesh
+        {
+            std::vector<morph::vec<float>> vertices;
+            std::vector<int> ring_of_vertex;
+            std::vector<GLuint> indices;
+        };
+
+        /*!
+         * Obtain the unit sphere mesh for the given numbers of \a rings and \a
+         * segments, computing it on first use. Like unit_circle_trig(), this is a
+         * thread_local cache; computeSphere transforms the unit mesh into place,
+         * which turns a sin/cos pair per vertex into a multiply-add.
+         */
+        static const unitsphere_mesh& unit_sphere_mesh (int rings, int segments)
+        {
+            static thread_local std::map<std::pair<int, int>, unitsphere_mesh> cache;
+            auto ci = cache.find (std::make_pair (rings, segments));
+            if (ci != cache.end()) { return ci->second; }
+
+            unitsphere_mesh usm;
+            int nverts = 2 + (rings - 1) * segments;
+            usm.vertices.reserve (nverts);
+            usm.ring_of_vertex.reserve (nverts);
+
+            const std::vector<morph::vec<float, 2>>& trig = unit_circle_trig (segments);
+
+            // First cap vertex at the 'north pole'
+            usm.vertices.push_back (morph::vec<float>{ 0.0f, 0.0f, -1.0f });
+            usm.ring_of_vertex.push_back (0);
+
+            GLuint lidx = 0; // local index, replicating computeSphere's use of this->idx
+            GLuint capMiddle = lidx++;
+            GLuint ringStartIdx = lidx;
+            GLuint lastRingStartIdx = lidx;
+
+            // First ring of vertices and the triangle fan that makes the cap
+            float rings1 = morph::mathconst<float>::pi * (-0.5f + 1.0f / rings);
+            float _z1 = std::sin (rings1);
+            float r1 = std::cos (rings1);
+            bool firstseg = true;
+            for (int j = 0; j < segments; j++) {
+                usm.vertices.push_back (morph::vec<float>{ trig[j][1] * r1, trig[j][0] * r1, _z1 });
+                usm.ring_of_vertex.push_back (1);
+                if (!firstseg) {
+                    usm.indices.push_back (capMiddle);
+                    usm.indices.push_back (lidx - 1);
+                    usm.indices.push_back (lidx++);
+                } else {
+                    lidx++;
+                    firstseg = false;
+                }
+            }
+            usm.indices.push_back (capMiddle);
+            usm.indices.push_back (lidx - 1);
+            usm.indices.push_back (capMiddle + 1);
+
+            // The rings between the caps
+            for (int i = 2; i < rings; i++) {
+                float rings0 = morph::mathconst<float>::pi * (-0.5f + static_cast<float>(i) / rings);
+                float _z0 = std::sin (rings0);
+                float r0 = std::cos (rings0);
+                for (int j = 0; j < segments; j++) {
+                    usm.vertices.push_back (morph::vec<float>{ trig[j][1] * r0, trig[j][0] * r0, _z0 });
+                    usm.ring_of_vertex.push_back (i);
+                    if (j == segments - 1) {
+                        // Last vertex is back to the start
+                        usm.indices.push_back (ringStartIdx++);
+                        usm.indices.push_back (lidx);
+                        usm.indices.push_back (lastRingStartIdx);
+                        usm.indices.push_back (lastRingStartIdx);
+                        usm.indices.push_back (lidx++);
+                        usm.indices.push_back (lastRingStartIdx + segments);
+                    } else {
+                        usm.indices.push_back (ringStartIdx++);
+                        usm.indices.push_back (lidx);
+                        usm.indices.push_back (ringStartIdx);
+                        usm.indices.push_back (ringStartIdx);
+                        usm.indices.push_back (lidx++);
+                        usm.indices.push_back (lidx);
+                    }
+                }
+                lastRingStartIdx += segments;
+            }
+
+            // Bottom cap vertex at the 'south pole' and its triangle fan
+            usm.vertices.push_back (morph::vec<float>{ 0.0f, 0.0f, 1.0f });
+            usm.ring_of_vertex.push_back (rings);
+            capMiddle = lidx++;
+            ringStartIdx = lastRingStartIdx;
+            for (int j = 0; j < segments; j++) {
+                if (j != segments - 1) {
+                    usm.indices.push_back (capMiddle);
+                    usm.indices.push_back (ringStartIdx++);
+                    usm.indices.push_back (ringStartIdx);
+                } else {
+                    usm.indices.push_back (capMiddle);
+                    usm.indices.push_back (ringStartIdx);
+                    usm.indices.push_back (lastRingStartIdx);
+                }
+            }
+
+            ci = cache.emplace (std::make_pair (rings, segments), std::move (usm)).first;
+            return ci->second;
+        }
 
         /*!
          * Create a tube from \a start to \a end, with radius \a r and a colour which
@@ -636,20 +1246,29 @@ namespace morph {
             this->vertex_push (-v, this->vertexNormals);
             this->vertex_push (colStart, this->vertexColors);
 
+            // Compute the ring of points once, from the cached trig table (rather
+            // than calling sin/cos for every vertex of each of the four rings below)
+            const std::vector<morph::vec<float, 2>>& trig = unit_circle_trig (segments);
+            float sr = std::sin (rotation);
+            float cr = std::cos (rotation);
+            std::vector<vec<float>> ringpts (segments);
+            for (int j = 0; j < segments; j++) {
+                // Angle sum identities give sin/cos of (rotation + j * 2pi/segments)
+                float st = sr * trig[j][1] + cr * trig[j][0];
+                float ct = cr * trig[j][1] - sr * trig[j][0];
+                ringpts[j] = _ux * st * r + _uy * ct * r;
+            }
+
             // Start cap vertices (a triangle fan)
             for (int j = 0; j < segments; j++) {
-                // t is the angle of the segment
-                float t = rotation + j * morph::mathconst<float>::two_pi/(float)segments;
-                vec<float> c = _ux * std::sin(t) * r + _uy * std::cos(t) * r;
-                this->vertex_push (vstart+c, this->vertexPositions);
+                this->vertex_push (vstart+ringpts[j], this->vertexPositions);
                 this->vertex_push (-v, this->vertexNormals);
                 this->vertex_push (colStart, this->vertexColors);
             }
 
             // Intermediate, near start cap. Normals point in direction c
             for (int j = 0; j < segments; j++) {
-                float t = rotation + j * morph::mathconst<float>::two_pi/(float)segments;
-                vec<float> c = _ux * std::sin(t) * r + _uy * std::cos(t) * r;
+                vec<float> c = ringpts[j];
                 this->vertex_push (vstart+c, this->vertexPositions);
                 c.renormalize();
                 this->vertex_push (c, this->vertexNormals);
@@ -658,8 +1277,7 @@ namespace morph {
 
             // Intermediate, near end cap. Normals point in direction c
             for (int j = 0; j < segments; j++) {
-                float t = rotation + (float)j * morph::mathconst<float>::two_pi/(float)segments;
-                vec<float> c = _ux * std::sin(t) * r + _uy * std::cos(t) * r;
+                vec<float> c = ringpts[j];
                 this->vertex_push (vend+c, this->vertexPositions);
                 c.renormalize();
                 this->vertex_push (c, this->vertexNormals);
@@ -668,9 +1286,7 @@ namespace morph {
 
             // Bottom cap vertices
             for (int j = 0; j < segments; j++) {
-                float t = rotation + (float)j * morph::mathconst<float>::two_pi/(float)segments;
-                vec<float> c = _ux * std::sin(t) * r + _uy * std::cos(t) * r;
-                this->vertex_push (vend+c, this->vertexPositions);
+                this->vertex_push (vend+ringpts[j], this->vertexPositions);
                 this->vertex_push (v, this->vertexNormals);
                 this->vertex_push (colEnd, this->vertexColors);
             }
@@ -856,42 +1472,39 @@ namespace morph {
             this->vertex_push (-v, this->vertexNormals);
             this->vertex_push (colStart, this->vertexColors);
 
+            // Compute the unit ring of points once, from the cached trig table. The
+            // start ring scales it by r; the end ring by r_end.
+            const std::vector<morph::vec<float, 2>>& trig = unit_circle_trig (segments);
+            std::vector<morph::vec<float>> unitring (segments);
+            for (int j = 0; j < segments; j++) {
+                unitring[j] = inplane * trig[j][0] + v_x_inplane * trig[j][1];
+            }
+
             // Start cap vertices. Draw as a triangle fan, but record indices so that we
             // only need a single call to glDrawElements.
             for (int j = 0; j < segments; j++) {
-                // t is the angle of the segment
-                float t = j * morph::mathconst<float>::two_pi/(float)segments;
-                morph::vec<float> c = inplane * std::sin(t) * r + v_x_inplane * std::cos(t) * r;
-                this->vertex_push (vstart+c, this->vertexPositions);
+                this->vertex_push (vstart + unitring[j] * r, this->vertexPositions);
                 this->vertex_push (-v, this->vertexNormals);
                 this->vertex_push (colStart, this->vertexColors);
             }
 
             // Intermediate, near start cap. Normals point in direction c
             for (int j = 0; j < segments; j++) {
-                float t = j * morph::mathconst<float>::two_pi/(float)segments;
-                morph::vec<float> c = inplane * std::sin(t) * r + v_x_inplane * std::cos(t) * r;
-                this->vertex_push (vstart+c, this->vertexPositions);
-                c.renormalize();
-                this->vertex_push (c, this->vertexNormals);
+                this->vertex_push (vstart + unitring[j] * r, this->vertexPositions);
+                this->vertex_push (unitring[j], this->vertexNormals);
                 this->vertex_push (colStart, this->vertexColors);
             }
 
             // Intermediate, near end cap. Normals point in direction c
             for (int j = 0; j < segments; j++) {
-                float t = (float)j * morph::mathconst<float>::two_pi/(float)segments;
-                morph::vec<float> c = inplane * std::sin(t) * r_end + v_x_inplane * std::cos(t) * r_end;
-                this->vertex_push (vend+c, this->vertexPositions);
-                c.renormalize();
-                this->vertex_push (c, this->vertexNormals);
+                this->vertex_push (vend + unitring[j] * r_end, this->vertexPositions);
+                this->vertex_push (unitring[j], this->vertexNormals);
                 this->vertex_push (colEnd, this->vertexColors);
             }
 
             // Bottom cap vertices
             for (int j = 0; j < segments; j++) {
-                float t = (float)j * morph::mathconst<float>::two_pi/(float)segments;
-                morph::vec<float> c = inplane * std::sin(t) * r_end + v_x_inplane * std::cos(t) * r_end;
-                this->vertex_push (vend+c, this->vertexPositions);
+                this->vertex_push (vend + unitring[j] * r_end, this->vertexPositions);
                 this->vertex_push (v, this->vertexNormals);
                 this->vertex_push (colEnd, this->vertexColors);
             }
@@ -1025,9 +1638,9 @@ namespace morph {
             // Now use parameterization of circle inplane = p1-x1 and
             // c1(t) = ( (p1-x1).normalized std::sin(t) + v.normalized cross (p1-x1).normalized * std::cos(t) )
             // c1(t) = ( inplane std::sin(t) + v * inplane * std::cos(t)
+            const std::vector<morph::vec<float, 2>>& trig = unit_circle_trig (segments);
             for (int j = 0; j < segments; j++) {
-                float t = j * morph::mathconst<float>::two_pi/(float)segments;
-                morph::vec<float> c = inplane * std::sin(t) * r + v_x_inplane * std::cos(t) * r_mod;
+                morph::vec<float> c = inplane * trig[j][0] * r + v_x_inplane * trig[j][1] * r_mod;
                 this->vertex_push (vstart+c, this->vertexPositions);
                 c.renormalize();
                 this->vertex_push (c, this->vertexNormals);
@@ -1040,8 +1653,7 @@ namespace morph {
             r_mod = r_end / v_x_inplane.cross (v).length();
 
             for (int j = 0; j < segments; j++) {
-                float t = (float)j * morph::mathconst<float>::two_pi/(float)segments;
-                morph::vec<float> c = inplane * std::sin(t) * r_end + v_x_inplane * std::cos(t) * r_mod;
+                morph::vec<float> c = inplane * trig[j][0] * r_end + v_x_inplane * trig[j][1] * r_mod;
                 this->vertex_push (vend+c, this->vertexPositions);
                 c.renormalize();
                 this->vertex_push (c, this->vertexNormals);
@@ -1286,8 +1898,9 @@ namespace morph {
                     throw std::runtime_error ("computeSphereGeo: This is an abitrary iterations limit (10 gives 20971520 faces)");
                 }
             }
-            // Note that we need double precision to compute higher iterations of the geodesic (iterations > 5)
-            morph::geometry::icosahedral_geodesic<F> geo = morph::geometry::make_icosahedral_geodesic<F> (iterations);
+            // Note that we need double precision to compute higher iterations of the geodesic
+            // (iterations > 5). The cached accessor computes each subdivision level only once.
+            const morph::geometry::icosahedral_geodesic<F>& geo = morph::geometry::icosahedral_geodesic_cached<F> (iterations);
 
             // Now essentially copy geo into vertex buffers
             for (auto v : geo.poly.vertices) {
@@ -1337,8 +1950,9 @@ namespace morph {
                     throw std::runtime_error ("computeSphereGeo: This is an abitrary iterations limit (10 gives 20971520 faces)");
                 }
             }
-            // Note that we need double precision to compute higher iterations of the geodesic (iterations > 5)
-            morph::geometry::icosahedral_geodesic<F> geo = morph::geometry::make_icosahedral_geodesic<F> (iterations);
+            // Note that we need double precision to compute higher iterations of the geodesic
+            // (iterations > 5). The cached accessor computes each subdivision level only once.
+            const morph::geometry::icosahedral_geodesic<F>& geo = morph::geometry::icosahedral_geodesic_cached<F> (iterations);
             int n_faces = static_cast<int>(geo.poly.faces.size());
 
             for (int i = 0; i < n_faces; ++i) { // For each face in the geodesic...
@@ -1409,126 +2023,18 @@ namespace morph {
         void computeSphere (vec<float> so, std::array<float, 3> sc,
                             float r = 1.0f, int rings = 10, int segments = 12)
         {
-            // First cap, draw as a triangle fan, but record indices so that
-            // we only need a single call to glDrawElements.
-            float rings0 = -morph::mathconst<float>::pi_over_2;
-            float _z0  = std::sin(rings0);
-            float z0  = r * _z0;
-            float r0 =  std::cos(rings0);
-            float rings1 = morph::mathconst<float>::pi * (-0.5f + 1.0f / rings);
-            float _z1 = std::sin(rings1);
-            float z1 = r * _z1;
-            float r1 = std::cos(rings1);
-            // Push the central point
-            this->vertex_push (so[0]+0.0f, so[1]+0.0f, so[2]+z0, this->vertexPositions);
-            this->vertex_push (0.0f, 0.0f, -1.0f, this->vertexNormals);
-            this->vertex_push (sc, this->vertexColors);
-
-            GLuint capMiddle = this->idx++;
-            GLuint ringStartIdx = this->idx;
-            GLuint lastRingStartIdx = this->idx;
-
-            bool firstseg = true;
-            for (int j = 0; j < segments; j++) {
-                float segment = morph::mathconst<float>::two_pi * static_cast<float>(j) / segments;
-                float x = std::cos(segment);
-                float y = std::sin(segment);
-
-                float _x1 = x*r1;
-                float x1 = _x1*r;
-                float _y1 = y*r1;
-                float y1 = _y1*r;
-
-                this->vertex_push (so[0]+x1, so[1]+y1, so[2]+z1, this->vertexPositions);
-                this->vertex_push (_x1, _y1, _z1, this->vertexNormals);
+            // Transform the cached unit sphere mesh into place. For a sphere the
+            // normal of each vertex is the unit vertex itself, so no trigonometry
+            // (and no normal correction) is required here.
+            const unitsphere_mesh& usm = unit_sphere_mesh (rings, segments);
+            unsigned int nverts = static_cast<unsigned int>(usm.vertices.size());
+            for (unsigned int i = 0; i < nverts; ++i) {
+                this->vertex_push (so + usm.vertices[i] * r, this->vertexPositions);
+                this->vertex_push (usm.vertices[i], this->vertexNormals);
                 this->vertex_push (sc, this->vertexColors);
-
-                if (!firstseg) {
-                    this->indices.push_back (capMiddle);
-                    this->indices.push_back (this->idx-1);
-                    this->indices.push_back (this->idx++);
-                } else {
-                    this->idx++;
-                    firstseg = false;
-                }
-            }
-            this->indices.push_back (capMiddle);
-            this->indices.push_back (this->idx-1);
-            this->indices.push_back (capMiddle+1);
-
-            // Now add the triangles around the rings
-            for (int i = 2; i < rings; i++) {
-
-                rings0 = morph::mathconst<float>::pi * (-0.5f + static_cast<float>(i) / rings);
-                _z0  = std::sin(rings0);
-                z0  = r * _z0;
-                r0 =  std::cos(rings0);
-
-                for (int j = 0; j < segments; j++) {
-
-                    // "current" segment
-                    float segment = morph::mathconst<float>::two_pi * static_cast<float>(j) / segments;
-                    float x = std::cos(segment);
-                    float y = std::sin(segment);
-
-                    // One vertex per segment
-                    float _x0 = x*r0;
-                    float x0 = _x0*r;
-                    float _y0 = y*r0;
-                    float y0 = _y0*r;
-
-                    // NB: Only add ONE vertex per segment. ALREADY have the first ring!
-                    this->vertex_push (so[0]+x0, so[1]+y0, so[2]+z0, this->vertexPositions);
-                    // The vertex normal of a vertex that makes up a sphere is
-                    // just a normal vector in the direction of the vertex.
-                    this->vertex_push (_x0, _y0, _z0, this->vertexNormals);
-                    this->vertex_push (sc, this->vertexColors);
-
-                    if (j == segments - 1) {
-                        // Last vertex is back to the start
-                        this->indices.push_back (ringStartIdx++);
-                        this->indices.push_back (this->idx);
-                        this->indices.push_back (lastRingStartIdx);
-                        this->indices.push_back (lastRingStartIdx);
-                        this->indices.push_back (this->idx++);
-                        this->indices.push_back (lastRingStartIdx+segments);
-                    } else {
-                        this->indices.push_back (ringStartIdx++);
-                        this->indices.push_back (this->idx);
-                        this->indices.push_back (ringStartIdx);
-                        this->indices.push_back (ringStartIdx);
-                        this->indices.push_back (this->idx++);
-                        this->indices.push_back (this->idx);
-                    }
-                }
-                lastRingStartIdx += segments;
-            }
-
-            // bottom cap
-            rings0 = morph::mathconst<float>::pi_over_2;
-            _z0  = std::sin(rings0);
-            z0  = r * _z0;
-            r0 =  std::cos(rings0);
-            // Push the central point of the bottom cap
-            this->vertex_push (so[0]+0.0f, so[1]+0.0f, so[2]+z0, this->vertexPositions);
-            this->vertex_push (0.0f, 0.0f, 1.0f, this->vertexNormals);
-            this->vertex_push (sc, this->vertexColors);
-            capMiddle = this->idx++;
-            firstseg = true;
-            // No more vertices to push, just do the indices for the bottom cap
-            ringStartIdx = lastRingStartIdx;
-            for (int j = 0; j < segments; j++) {
-                if (j != segments - 1) {
-                    this->indices.push_back (capMiddle);
-                    this->indices.push_back (ringStartIdx++);
-                    this->indices.push_back (ringStartIdx);
-                } else {
-                    // Last segment
-                    this->indices.push_back (capMiddle);
-                    this->indices.push_back (ringStartIdx);
-                    this->indices.push_back (lastRingStartIdx);
-                }
             }
+            for (auto ind : usm.indices) { this->indices.push_back (this->idx + ind); }
+            this->idx += nverts;
         } // end of sphere calculation
 
         /*!
@@ -1547,129 +2053,25 @@ namespace morph {
         void computeSphere (vec<float> so, std::array<float, 3> sc, std::array<float, 3> sc2,
                             float r = 1.0f, int rings = 10, int segments = 12)
         {
-            // First cap, draw as a triangle fan, but record indices so that
-            // we only need a single call to glDrawElements.
-            float rings0 = -morph::mathconst<float>::pi_over_2;
-            float _z0  = std::sin(rings0);
-            float z0  = r * _z0;
-            float r0 =  std::cos(rings0);
-            float rings1 = morph::mathconst<float>::pi * (-0.5f + 1.0f / rings);
-            float _z1 = std::sin(rings1);
-            float z1 = r * _z1;
-            float r1 = std::cos(rings1);
-            // Push the central point
-            this->vertex_push (so[0]+0.0f, so[1]+0.0f, so[2]+z0, this->vertexPositions);
-            this->vertex_push (0.0f, 0.0f, -1.0f, this->vertexNormals);
-            this->vertex_push (sc2, this->vertexColors);
-
-            GLuint capMiddle = this->idx++;
-            GLuint ringStartIdx = this->idx;
-            GLuint lastRingStartIdx = this->idx;
-
-            bool firstseg = true;
-            for (int j = 0; j < segments; j++) {
-                float segment = morph::mathconst<float>::two_pi * static_cast<float>(j) / segments;
-                float x = std::cos(segment);
-                float y = std::sin(segment);
-
-                float _x1 = x*r1;
-                float x1 = _x1*r;
-                float _y1 = y*r1;
-                float y1 = _y1*r;
-
-                this->vertex_push (so[0]+x1, so[1]+y1, so[2]+z1, this->vertexPositions);
-                this->vertex_push (_x1, _y1, _z1, this->vertexNormals);
-                this->vertex_push (sc2, this->vertexColors);
-
-                if (!firstseg) {
-                    this->indices.push_back (capMiddle);
-                    this->indices.push_back (this->idx-1);
-                    this->indices.push_back (this->idx++);
-                } else {
-                    this->idx++;
-                    firstseg = false;
-                }
-            }
-            this->indices.push_back (capMiddle);
-            this->indices.push_back (this->idx-1);
-            this->indices.push_back (capMiddle+1);
-
-            // Now add the triangles around the rings
-            for (int i = 2; i < rings; i++) {
-
-                rings0 = morph::mathconst<float>::pi * (-0.5f + static_cast<float>(i) / rings);
-                _z0  = std::sin(rings0);
-                z0  = r * _z0;
-                r0 =  std::cos(rings0);
-
-                for (int j = 0; j < segments; j++) {
-
-                    // "current" segment
-                    float segment = morph::mathconst<float>::two_pi * static_cast<float>(j) / segments;
-                    float x = std::cos(segment);
-                    float y = std::sin(segment);
-
-                    // One vertex per segment
-                    float _x0 = x*r0;
-                    float x0 = _x0*r;
-                    float _y0 = y*r0;
-                    float y0 = _y0*r;
-
-                    // NB: Only add ONE vertex per segment. ALREADY have the first ring!
-                    this->vertex_push (so[0]+x0, so[1]+y0, so[2]+z0, this->vertexPositions);
-                    // The vertex normal of a vertex that makes up a sphere is
-                    // just a normal vector in the direction of the vertex.
-                    this->vertex_push (_x0, _y0, _z0, this->vertexNormals);
-                    if (i == 2 || i > (rings-2)) {
-                        this->vertex_push (sc2, this->vertexColors);
-                    } else {
-                        this->vertex_push (sc, this->vertexColors);
-                    }
-                    if (j == segments - 1) {
-                        // Last vertex is back to the start
-                        this->indices.push_back (ringStartIdx++);
-                        this->indices.push_back (this->idx);
-                        this->indices.push_back (lastRingStartIdx);
-                        this->indices.push_back (lastRingStartIdx);
-                        this->indices.push_back (this->idx++);
-                        this->indices.push_back (lastRingStartIdx+segments);
-                    } else {
-                        this->indices.push_back (ringStartIdx++);
-                        this->indices.push_back (this->idx);
-                        this->indices.push_back (ringStartIdx);
-                        this->indices.push_back (ringStartIdx);
-                        this->indices.push_back (this->idx++);
-                        this->indices.push_back (this->idx);
-                    }
-                }
-                lastRingStartIdx += segments;
-            }
-
-            // bottom cap
-            rings0 = morph::mathconst<float>::pi_over_2;
-            _z0  = std::sin(rings0);
-            z0  = r * _z0;
-            r0 =  std::cos(rings0);
-            // Push the central point of the bottom cap
-            this->vertex_push (so[0]+0.0f, so[1]+0.0f, so[2]+z0, this->vertexPositions);
-            this->vertex_push (0.0f, 0.0f, 1.0f, this->vertexNormals);
-            this->vertex_push (sc2, this->vertexColors);
-            capMiddle = this->idx++;
-            firstseg = true;
-            // No more vertices to push, just do the indices for the bottom cap
-            ringStartIdx = lastRingStartIdx;
-            for (int j = 0; j < segments; j++) {
-                if (j != segments - 1) {
-                    this->indices.push_back (capMiddle);
-                    this->indices.push_back (ringStartIdx++);
-                    this->indices.push_back (ringStartIdx);
+            // As for the one colour version, transform the cached unit sphere mesh
+            // into place, here using ring_of_vertex to choose the colour: sc2 for
+            // the caps and the rings nearest them, sc for the rest (matching the
+            // original tessellation, which coloured the cap centres, the first two
+            // rings and the last ring with sc2).
+            const unitsphere_mesh& usm = unit_sphere_mesh (rings, segments);
+            unsigned int nverts = static_cast<unsigned int>(usm.vertices.size());
+            for (unsigned int i = 0; i < nverts; ++i) {
+                this->vertex_push (so + usm.vertices[i] * r, this->vertexPositions);
+                this->vertex_push (usm.vertices[i], this->vertexNormals);
+                int ring = usm.ring_of_vertex[i];
+                if (ring <= 2 || ring > (rings-2)) {
+                    this->vertex_push (sc2, this->vertexColors);
                 } else {
-                    // Last segment
-                    this->indices.push_back (capMiddle);
-                    this->indices.push_back (ringStartIdx);
-                    this->indices.push_back (lastRingStartIdx);
+                    this->vertex_push (sc, this->vertexColors);
                 }
             }
+            for (auto ind : usm.indices) { this->indices.push_back (this->idx + ind); }
+            this->idx += nverts;
         }
 
         /*!
@@ -1742,36 +2144,35 @@ namespace morph {
             this->vertex_push (-v, this->vertexNormals);
             this->vertex_push (col, this->vertexColors);
 
+            // Compute the ring of points (shifted along v by ringoffset) and their
+            // normalized versions once, from the cached trig table
+            const std::vector<morph::vec<float, 2>>& trig = unit_circle_trig (segments);
+            std::vector<vec<float>> ringpts (segments);
+            std::vector<vec<float>> ringnorms (segments);
+            for (int j = 0; j < segments; j++) {
+                ringpts[j] = inplane * trig[j][0] * r + v_x_inplane * trig[j][1] * r + (v * ringoffset);
+                ringnorms[j] = ringpts[j];
+                ringnorms[j].renormalize();
+            }
+
             // Base ring with normals in direction -v
             for (int j = 0; j < segments; j++) {
-                float t = j * morph::mathconst<float>::two_pi / static_cast<float>(segments);
-                vec<float> c = inplane * std::sin(t) * r + v_x_inplane * std::cos(t) * r;
-                // Subtract the vector which makes this circle
-                c = c + (v * ringoffset);
-                this->vertex_push (vbase+c, this->vertexPositions);
+                this->vertex_push (vbase+ringpts[j], this->vertexPositions);
                 this->vertex_push (-v, this->vertexNormals);
                 this->vertex_push (col, this->vertexColors);
             }
 
             // Intermediate ring of vertices around/aligned with the base ring with normals in direction c
             for (int j = 0; j < segments; j++) {
-                float t = j * morph::mathconst<float>::two_pi / static_cast<float>(segments);
-                vec<float> c = inplane * std::sin(t) * r + v_x_inplane * std::cos(t) * r;
-                c = c + (v * ringoffset);
-                this->vertex_push (vbase+c, this->vertexPositions);
-                c.renormalize();
-                this->vertex_push (c, this->vertexNormals);
+                this->vertex_push (vbase+ringpts[j], this->vertexPositions);
+                this->vertex_push (ringnorms[j], this->vertexNormals);
                 this->vertex_push (col, this->vertexColors);
             }
 
             // Intermediate ring of vertices around the tip with normals direction c
             for (int j = 0; j < segments; j++) {
-                float t = j * morph::mathconst<float>::two_pi / static_cast<float>(segments);
-                vec<float> c = inplane * std::sin(t) * r + v_x_inplane * std::cos(t) * r;
-                c = c + (v * ringoffset);
                 this->vertex_push (vtip, this->vertexPositions);
-                c.renormalize();
-                this->vertex_push (c, this->vertexNormals);
+                this->vertex_push (ringnorms[j], this->vertexNormals);
                 this->vertex_push (col, this->vertexColors);
             }
 
@@ -16,6 +16,8 @@
 #endif
 
 #include <type_traits>
+#include <algorithm>
+#include <cstring>
 
 #include <morph/VisualModelBase.h>
 
@@ -43,11 +45,32 @@ namespace morph {
             // Explicitly clear owned VisualTextModels
             this->texts.clear();
             if (this->vbos != nullptr) {
+                for (unsigned int s = 0; s < this->stream_nsections; ++s) {
+                    if (this->stream_fence[s] != nullptr) { glDeleteSync (this->stream_fence[s]); }
+                }
+                // Deleting the buffers implicitly unmaps any persistent mappings
                 glDeleteBuffers (this->numVBO, this->vbos.get());
+                if (this->pickvbo != 0) { glDeleteBuffers (1, &this->pickvbo); }
                 glDeleteVertexArrays (1, &this->vao);
             }
         }
 
+        //! Hand over ids for batched deletion (see VisualModelBase). Here, also
+        //! surrender the ids of any owned text models, delete streaming sync objects
+        //! (which cannot be batched) and forget the pick buffer.
+        void surrender_gl_ids (std::vector<GLuint>& buf_ids, std::vector<GLuint>& vao_ids) override
+        {
+            for (auto& t : this->texts) { if (t != nullptr) { t->surrender_gl_ids (buf_ids, vao_ids); } }
+            for (unsigned int s = 0; s < this->stream_nsections; ++s) {
+                if (this->stream_fence[s] != nullptr) {
+                    glDeleteSync (this->stream_fence[s]);
+                    this->stream_fence[s] = nullptr;
+                }
+            }
+            if (this->pickvbo != 0) { buf_ids.push_back (this->pickvbo); this->pickvbo = 0; }
+            morph::VisualModelBase<glver>::surrender_gl_ids (buf_ids, vao_ids);
+        }
+
         /*!
          * Set up the passed-in VisualTextModel with functions that need access to the parent Visual attributes.
          */
@@ -81,11 +104,21 @@ namespace morph {
                 glGenBuffers (this->numVBO, this->vbos.get()); // OpenGL 4.4- safe
             }
 
-            // Set up the indices buffer - bind and buffer the data in this->indices
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->vbos[this->idxVBO]);
+            if constexpr (buffer_streaming_supported) {
+                if (this->use_persistent_buffers == true && this->stream_active == false) {
+                    this->setup_streaming_buffers(); // on failure, fall through to the glBufferData path
+                }
+                if (this->stream_active == true) {
+                    this->stream_upload();
+                    glBindVertexArray(0);
+                    morph::gl::Util::checkError (__FILE__, __LINE__);
+                    this->postVertexInitRequired = false;
+                    return;
+                }
+            }
 
-            std::size_t sz = this->indices.size() * sizeof(GLuint);
-            glBufferData(GL_ELEMENT_ARRAY_BUFFER, sz, this->indices.data(), GL_STATIC_DRAW);
+            // Set up the indices buffer - bind and buffer the data in this->indices
+            this->upload_indices();
 
             // Binds data from the "C++ world" to the OpenGL shader world for
             // "position", "normalin" and "color"
@@ -94,6 +127,10 @@ namespace morph {
             this->setupVBO (this->vbos[this->normVBO], this->vertexNormals, visgl::normLoc);
             this->setupVBO (this->vbos[this->colVBO], this->vertexColors, visgl::colLoc);
 
+            // The buffers are now exact-size allocations (see reinit_buffers_appended)
+            this->append_vcap = 0;
+            this->append_icap = 0;
+
             // Unbind only the vertex array (not the buffers, that causes GL_INVALID_ENUM errors)
             glBindVertexArray(0); // carefully unbind and rebind
             morph::gl::Util::checkError (__FILE__, __LINE__);
@@ -101,6 +138,27 @@ namespace morph {
             this->postVertexInitRequired = false;
         }
 
+        /*!
+         * Bind the index VBO and buffer this->indices into it. If compact_indices permits it
+         * and the model is small enough, the indices are narrowed to GL_UNSIGNED_SHORT at
+         * upload; index_type records what was uploaded for glDrawElements.
+         */
+        void upload_indices()
+        {
+            glBindBuffer (GL_ELEMENT_ARRAY_BUFFER, this->vbos[this->idxVBO]);
+            if (this->compact_indices == true && this->idx <= 65536u) {
+                std::vector<GLushort> shortidx (this->indices.size());
+                for (std::size_t i = 0; i < this->indices.size(); ++i) {
+                    shortidx[i] = static_cast<GLushort>(this->indices[i]);
+                }
+                glBufferData (GL_ELEMENT_ARRAY_BUFFER, shortidx.size() * sizeof(GLushort), shortidx.data(), GL_STATIC_DRAW);
+                this->index_type = GL_UNSIGNED_SHORT;
+            } else {
+                glBufferData (GL_ELEMENT_ARRAY_BUFFER, this->indices.size() * sizeof(GLuint), this->indices.data(), GL_STATIC_DRAW);
+                this->index_type = GL_UNSIGNED_INT;
+            }
+        }
+
         //! Initialize vertex buffer objects and vertex array object. Empty for 'text only' VisualModels.
         void initializeVertices() {};
 
@@ -110,18 +168,39 @@ namespace morph {
          */
         void reinit_buffers() final
         {
+            if (this->parentVis != nullptr) { this->parentVis->signal_needs_render(); }
             if (this->setContext != nullptr) { this->setContext (this->parentVis); }
             if (this->postVertexInitRequired == true) { this->postVertexInit(); }
+            if constexpr (buffer_streaming_supported) {
+                if (this->stream_active == true) {
+                    if (this->vertexPositions.size() > this->stream_vcap
+                        || this->vertexNormals.size() > this->stream_vcap
+                        || this->vertexColors.size() > this->stream_vcap
+                        || this->indices.size() > this->stream_icap) {
+                        // The model grew past the allocated capacity; re-allocate
+                        this->teardown_streaming_buffers();
+                        this->postVertexInit();
+                        return;
+                    }
+                    glBindVertexArray (this->vao);
+                    this->stream_section = (this->stream_section + 1u) % this->stream_nsections;
+                    this->stream_upload();
+                    glBindVertexArray(0);
+                    morph::gl::Util::checkError (__FILE__, __LINE__);
+                    return;
+                }
+            }
             // Now re-set up the VBOs
             glBindVertexArray (this->vao);                              // carefully unbind and rebind
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->vbos[this->idxVBO]);  // carefully unbind and rebind
-
-            std::size_t sz = this->indices.size() * sizeof(GLuint);
-            glBufferData(GL_ELEMENT_ARRAY_BUFFER, sz, this->indices.data(), GL_STATIC_DRAW);
+            this->upload_indices();
             this->setupVBO (this->vbos[this->posnVBO], this->vertexPositions, visgl::posnLoc);
             this->setupVBO (this->vbos[this->normVBO], this->vertexNormals, visgl::normLoc);
             this->setupVBO (this->vbos[this->colVBO], this->vertexColors, visgl::colLoc);
 
+            // The buffers are now exact-size allocations (see reinit_buffers_appended)
+            this->append_vcap = 0;
+            this->append_icap = 0;
+
             glBindVertexArray(0);                               // carefully unbind and rebind
             morph::gl::Util::checkError (__FILE__, __LINE__);   // carefully unbind and rebind
         }
@@ -129,8 +208,12 @@ namespace morph {
         //! reinit ONLY vertexColors buffer
         void reinit_colour_buffer() final
         {
+            if (this->parentVis != nullptr) { this->parentVis->signal_needs_render(); }
             if (this->setContext != nullptr) { this->setContext (this->parentVis); }
             if (this->postVertexInitRequired == true) { this->postVertexInit(); }
+            // The streamed buffers are immutable storage, so partial updates go
+            // through the streaming path (which advances to a fresh section)
+            if (this->stream_active == true) { this->reinit_buffers(); return; }
             // Now re-set up the VBOs
             glBindVertexArray (this->vao);  // carefully unbind and rebind
             this->setupVBO (this->vbos[this->colVBO], this->vertexColors, visgl::colLoc);
@@ -138,6 +221,80 @@ namespace morph {
             morph::gl::Util::checkError (__FILE__, __LINE__);
         }
 
+        //! Re-upload a sub-range of vertexPositions and vertexColors with glBufferSubData
+        void reinit_buffers_region (unsigned int start_vertex, unsigned int n_vertices) final
+        {
+            if (this->parentVis != nullptr) { this->parentVis->signal_needs_render(); }
+            if (this->setContext != nullptr) { this->setContext (this->parentVis); }
+            if (this->postVertexInitRequired == true) { this->postVertexInit(); return; } // uploads everything
+            if (this->stream_active == true) { this->reinit_buffers(); return; } // immutable storage
+            glBindVertexArray (this->vao);  // carefully unbind and rebind
+            GLintptr buf_offset = static_cast<GLintptr>(3u * start_vertex * sizeof(float));
+            GLsizeiptr buf_sz = static_cast<GLsizeiptr>(3u * n_vertices * sizeof(float));
+            glBindBuffer (GL_ARRAY_BUFFER, this->vbos[this->posnVBO]);
+            glBufferSubData (GL_ARRAY_BUFFER, buf_offset, buf_sz, this->vertexPositions.data() + 3u * start_vertex);
+            glBindBuffer (GL_ARRAY_BUFFER, this->vbos[this->colVBO]);
+            glBufferSubData (GL_ARRAY_BUFFER, buf_offset, buf_sz, this->vertexColors.data() + 3u * start_vertex);
+            glBindVertexArray(0);  // carefully unbind and rebind
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+        }
+
+        /*!
+         * Upload appended vertices and indices (see VisualModelBase). Allocates the
+         * buffers with reserve capacity so that successive appends are glBufferSubData
+         * tail writes; grows (with more headroom) when the capacity is exceeded.
+         */
+        void reinit_buffers_appended (unsigned int start_vertex, unsigned int start_index) final
+        {
+            if (this->parentVis != nullptr) { this->parentVis->signal_needs_render(); }
+            if (this->setContext != nullptr) { this->setContext (this->parentVis); }
+            if (this->postVertexInitRequired == true) { this->postVertexInit(); return; } // uploads everything
+            if (this->stream_active == true) { this->reinit_buffers(); return; } // streaming handles appends
+            // The tail-write arithmetic below assumes a GLuint index buffer; compact (16 bit)
+            // models are small, so a full re-upload is the simpler correct path
+            if (this->index_type == GL_UNSIGNED_SHORT) { this->reinit_buffers(); return; }
+            glBindVertexArray (this->vao);  // carefully unbind and rebind
+            const GLuint vbufs[3] = { this->vbos[this->posnVBO], this->vbos[this->normVBO], this->vbos[this->colVBO] };
+            const morph::vertex_buffer_t<float>* dats[3] = { &this->vertexPositions, &this->vertexNormals, &this->vertexColors };
+            constexpr unsigned int locns[3] = { visgl::posnLoc, visgl::normLoc, visgl::colLoc };
+            if (this->vertexPositions.size() > this->append_vcap
+                || this->vertexNormals.size() > this->append_vcap
+                || this->vertexColors.size() > this->append_vcap
+                || this->indices.size() > this->append_icap) {
+                // (Re-)allocate with headroom and upload everything
+                std::size_t vneed = std::max ({ this->vertexPositions.size(),
+                                                this->vertexNormals.size(), this->vertexColors.size() });
+                this->append_vcap = vneed + vneed / 2u + 96u;
+                this->append_icap = this->indices.size() + this->indices.size() / 2u + 96u;
+                glBindBuffer (GL_ELEMENT_ARRAY_BUFFER, this->vbos[this->idxVBO]);
+                glBufferData (GL_ELEMENT_ARRAY_BUFFER, this->append_icap * sizeof(GLuint), nullptr, GL_DYNAMIC_DRAW);
+                glBufferSubData (GL_ELEMENT_ARRAY_BUFFER, 0, this->indices.size() * sizeof(GLuint), this->indices.data());
+                for (unsigned int b = 0; b < 3; ++b) {
+                    glBindBuffer (GL_ARRAY_BUFFER, vbufs[b]);
+                    glBufferData (GL_ARRAY_BUFFER, this->append_vcap * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+                    glBufferSubData (GL_ARRAY_BUFFER, 0, dats[b]->size() * sizeof(float), dats[b]->data());
+                    glVertexAttribPointer (locns[b], 3, GL_FLOAT, GL_FALSE, 0, (void*)(0));
+                    glEnableVertexAttribArray (locns[b]);
+                }
+            } else {
+                // The appended tails fit; write only them
+                GLintptr voff = static_cast<GLintptr>(3u * start_vertex * sizeof(float));
+                for (unsigned int b = 0; b < 3; ++b) {
+                    glBindBuffer (GL_ARRAY_BUFFER, vbufs[b]);
+                    glBufferSubData (GL_ARRAY_BUFFER, voff,
+                                     static_cast<GLsizeiptr>(dats[b]->size() * sizeof(float)) - voff,
+                                     dats[b]->data() + 3u * start_vertex);
+                }
+                glBindBuffer (GL_ELEMENT_ARRAY_BUFFER, this->vbos[this->idxVBO]);
+                glBufferSubData (GL_ELEMENT_ARRAY_BUFFER,
+                                 static_cast<GLintptr>(start_index * sizeof(GLuint)),
+                                 static_cast<GLsizeiptr>((this->indices.size() - start_index) * sizeof(GLuint)),
+                                 this->indices.data() + start_index);
+            }
+            glBindVertexArray(0);  // carefully unbind and rebind
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+        }
+
         void clearTexts() { this->texts.clear(); }
 
         static constexpr bool debug_render = false;
@@ -147,8 +304,10 @@ namespace morph {
         {
             if (this->hide == true) { return; }
 
-            // Execute post-vertex init at render, as GL should be available.
-            if (this->postVertexInitRequired == true) { this->postVertexInit(); }
+            // Execute post-vertex init at render, as GL should be available. A pooled
+            // model's triangles live in the parent Visual's shared buffers, so it
+            // needs no buffers of its own and no draw call here (texts still render).
+            if (this->postVertexInitRequired == true && this->pooled == false) { this->postVertexInit(); }
 
             GLint prev_shader = 0;
 
@@ -156,7 +315,7 @@ namespace morph {
             // Ensure the correct program is in play for this VisualModel
             glUseProgram (this->get_gprog(this->parentVis));
 
-            if (!this->indices.empty()) {
+            if (!this->indices.empty() && this->pooled == false) {
                 // It is only necessary to bind the vertex array object before rendering
                 // (not the vertex buffer objects)
                 glBindVertexArray (this->vao);
@@ -177,8 +336,20 @@ namespace morph {
                     std::cout << "VisualModelImpl::render: model viewmatrix:\n" << this->viewmatrix << std::endl;
                 }
 
-                // Draw the triangles
-                glDrawElements (GL_TRIANGLES, static_cast<unsigned int>(this->indices.size()), GL_UNSIGNED_INT, 0);
+                // Draw the triangles. stream_draw_offset is 0 unless buffer streaming is active.
+                glDrawElements (GL_TRIANGLES, static_cast<unsigned int>(this->indices.size()), this->index_type,
+                                reinterpret_cast<const void*>(this->stream_draw_offset));
+
+                if constexpr (buffer_streaming_supported) {
+                    if (this->stream_active == true) {
+                        // Fence the section just drawn, so that stream_upload() can
+                        // wait for the GPU to release it before re-using it
+                        if (this->stream_fence[this->stream_section] != nullptr) {
+                            glDeleteSync (this->stream_fence[this->stream_section]);
+                        }
+                        this->stream_fence[this->stream_section] = glFenceSync (GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+                    }
+                }
 
                 // Unbind the VAO
                 glBindVertexArray(0);
@@ -193,6 +364,114 @@ namespace morph {
             morph::gl::Util::checkError (__FILE__, __LINE__);
         }
 
+        /*!
+         * Draw this model's triangles from the scene geometry pool, whose VAO the
+         * parent Visual has already bound. Sets the model's usual uniforms on the
+         * graphics program, then issues a single base-vertex draw into the shared
+         * buffers (see VisualOwnable*::buildGeometryPool).
+         */
+        void render_pooled()
+        {
+            if (this->pooled == false || this->hide == true) { return; }
+            GLuint prog = this->get_gprog(this->parentVis);
+            GLint loc_a = glGetUniformLocation (prog, static_cast<const GLchar*>("alpha"));
+            if (loc_a != -1) { glUniform1f (loc_a, this->alpha); }
+            GLint loc_v = glGetUniformLocation (prog, static_cast<const GLchar*>("v_matrix"));
+            if (loc_v != -1) { glUniformMatrix4fv (loc_v, 1, GL_FALSE, this->scenematrix.mat.data()); }
+            GLint loc_m = glGetUniformLocation (prog, static_cast<const GLchar*>("m_matrix"));
+            if (loc_m != -1) { glUniformMatrix4fv (loc_m, 1, GL_FALSE, (this->model_scaling * this->viewmatrix).mat.data()); }
+            glDrawElementsBaseVertex (GL_TRIANGLES, this->pool_index_count, GL_UNSIGNED_INT,
+                                      reinterpret_cast<const void*>(this->pool_index_offset * sizeof(GLuint)),
+                                      this->pool_base_vertex);
+        }
+
+        /*!
+         * Draw this model in a second GL context whose buffer objects are shared with
+         * the parent Visual's context (see VisualNoMX::addMirrorWindow). Vertex array
+         * objects are not shared between contexts, so the caller binds a VAO of its
+         * own and this function re-specifies the attribute pointers from the shared
+         * VBOs before drawing. \a v_matrix is the mirror window's scene matrix, which
+         * replaces this->scenematrix so that each window can have its own view.
+         */
+        void render_shared (GLuint prog, const mat44<float>& v_matrix)
+        {
+            if (this->hide == true || this->pooled == true) { return; }
+            if (this->postVertexInitRequired == true || this->vbos == nullptr) { return; } // nothing uploaded yet
+            if (this->indices.empty()) { return; }
+
+            glBindBuffer (GL_ELEMENT_ARRAY_BUFFER, this->vbos[this->idxVBO]);
+            const GLuint vbufs[3] = { this->vbos[this->posnVBO], this->vbos[this->normVBO], this->vbos[this->colVBO] };
+            constexpr unsigned int locns[3] = { visgl::posnLoc, visgl::normLoc, visgl::colLoc };
+            for (unsigned int b = 0; b < 3; ++b) {
+                glBindBuffer (GL_ARRAY_BUFFER, vbufs[b]);
+                glVertexAttribPointer (locns[b], 3, GL_FLOAT, GL_FALSE, 0, (void*)(0));
+                glEnableVertexAttribArray (locns[b]);
+            }
+
+            GLint loc_a = glGetUniformLocation (prog, static_cast<const GLchar*>("alpha"));
+            if (loc_a != -1) { glUniform1f (loc_a, this->alpha); }
+            GLint loc_v = glGetUniformLocation (prog, static_cast<const GLchar*>("v_matrix"));
+            if (loc_v != -1) { glUniformMatrix4fv (loc_v, 1, GL_FALSE, v_matrix.mat.data()); }
+            GLint loc_m = glGetUniformLocation (prog, static_cast<const GLchar*>("m_matrix"));
+            if (loc_m != -1) { glUniformMatrix4fv (loc_m, 1, GL_FALSE, (this->model_scaling * this->viewmatrix).mat.data()); }
+
+            glDrawElements (GL_TRIANGLES, static_cast<unsigned int>(this->indices.size()), this->index_type,
+                            reinterpret_cast<const void*>(this->stream_draw_offset));
+        }
+
+        /*!
+         * Render this model for the ID-buffer picking pass (see VisualOwnable*::pick).
+         * \a pick_prog is the pick shader program, already in use, and \a model_id
+         * identifies this model in the red channel of the pick image. Vertex positions
+         * and indices are shared with the normal render; the only extra GL state is a
+         * small per-vertex element id VBO, uploaded lazily and re-uploaded if the
+         * vertex count has changed.
+         */
+        void render_pick (GLuint pick_prog, const float model_id)
+        {
+            if (this->hide == true) { return; }
+            if (this->pooled == true) { return; } // pooled models have no VAO to draw from
+            if (this->postVertexInitRequired == true) { this->postVertexInit(); }
+            if (this->indices.empty()) { return; }
+
+            glBindVertexArray (this->vao);
+
+            this->fillPickIDs();
+            std::size_t nverts = this->vertexPositions.size() / 3u;
+            if (this->pickIDs.size() == nverts && nverts > 0) {
+                if (this->pickvbo == 0) { glGenBuffers (1, &this->pickvbo); }
+                glBindBuffer (GL_ARRAY_BUFFER, this->pickvbo);
+                if (this->pickvbo_size != nverts) {
+                    glBufferData (GL_ARRAY_BUFFER, nverts * sizeof(float), this->pickIDs.data(), GL_STATIC_DRAW);
+                    this->pickvbo_size = nverts;
+                }
+                glVertexAttribPointer (visgl::pickLoc, 1, GL_FLOAT, GL_FALSE, 0, (void*)(0));
+                glEnableVertexAttribArray (visgl::pickLoc);
+            } else {
+                // No per-element ids; a disabled pick attribute reads as 0, so the
+                // whole model gets element id 0
+                glDisableVertexAttribArray (visgl::pickLoc);
+            }
+
+            GLint loc_v = glGetUniformLocation (pick_prog, static_cast<const GLchar*>("v_matrix"));
+            if (loc_v != -1) { glUniformMatrix4fv (loc_v, 1, GL_FALSE, this->scenematrix.mat.data()); }
+            GLint loc_m = glGetUniformLocation (pick_prog, static_cast<const GLchar*>("m_matrix"));
+            if (loc_m != -1) { glUniformMatrix4fv (loc_m, 1, GL_FALSE, (this->model_scaling * this->viewmatrix).mat.data()); }
+            GLint loc_id = glGetUniformLocation (pick_prog, static_cast<const GLchar*>("model_id"));
+            if (loc_id != -1) { glUniform1f (loc_id, model_id); }
+
+            glDrawElements (GL_TRIANGLES, static_cast<unsigned int>(this->indices.size()), this->index_type,
+                            reinterpret_cast<const void*>(this->stream_draw_offset));
+
+            glBindVertexArray(0);
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+        }
+
+        //! The pick attribute buffer (see render_pick); 0 until first pick
+        GLuint pickvbo = 0;
+        //! Number of per-vertex ids last uploaded into pickvbo
+        std::size_t pickvbo_size = 0;
+
         /*!
          * Helper to make a VisualTextModel and bind it ready for use.
          *
@@ -248,6 +527,35 @@ namespace morph {
             return this->texts.back()->getTextGeometry();
         }
 
+        /*!
+         * Add a batch of short text labels, with _texts[i] placed at _toffsets[i] (within
+         * the model's coordinates). All the labels go into a single VisualTextModel - one
+         * geometry buffer and one draw call - which is very much faster than one addLabel
+         * call per label when there are thousands of them (index labels on a large scatter
+         * plot, for example). See VisualTextModel::setupTexts.
+         */
+        void addLabels (const std::vector<std::string>& _texts,
+                        const std::vector<morph::vec<float, 3>>& _toffsets,
+                        const morph::TextFeatures& tfeatures = morph::TextFeatures())
+        {
+            if (_texts.empty()) { return; }
+
+            if (this->get_shaderprogs(this->parentVis).tprog == 0) {
+                throw std::runtime_error ("No text shader prog. Did your VisualModel-derived class set it up?");
+            }
+
+            if (this->setContext != nullptr) { this->setContext (this->parentVis); } // For VisualTextModel
+
+            auto tmup = this->makeVisualTextModel (tfeatures);
+            std::vector<morph::vec<float, 3>> offs (_toffsets);
+            for (auto& o : offs) { o += this->mv_offset; }
+            tmup->setupTexts (_texts, offs, tfeatures.colour);
+            this->texts.push_back (std::move(tmup));
+
+            // As this is a setup function, release the context
+            if (this->releaseContext != nullptr) { this->releaseContext (this->parentVis); }
+        }
+
         /*!
          * Add a text label, with given offset _toffset and the specified tfeatures. The
          * reference to a pointer, tm, allows client code to change the text of the
@@ -326,19 +634,149 @@ namespace morph {
         std::vector<std::unique_ptr<morph::VisualTextModel<glver>>> texts;
 
         //! Set up a vertex buffer object - bind, buffer and set vertex array object attribute
-        void setupVBO (GLuint& buf, std::vector<float>& dat, unsigned int bufferAttribPosition) final
+        void setupVBO (GLuint& buf, morph::vertex_buffer_t<float>& dat, unsigned int bufferAttribPosition) final
         {
-            std::size_t sz = dat.size() * sizeof(float);
-
             glBindBuffer (GL_ARRAY_BUFFER, buf);
             morph::gl::Util::checkError (__FILE__, __LINE__);
-            glBufferData (GL_ARRAY_BUFFER, sz, dat.data(), GL_STATIC_DRAW);
-            morph::gl::Util::checkError (__FILE__, __LINE__);
-            glVertexAttribPointer (bufferAttribPosition, 3, GL_FLOAT, GL_FALSE, 0, (void*)(0));
+
+#if defined GL_HALF_FLOAT && defined GL_INT_2_10_10_10_REV
+            if (this->packed_attributes == true) {
+                // Convert to the packed format for this attribute slot at upload (the
+                // CPU-side buffer stays float). See VisualModelBase::packed_attributes.
+                if (bufferAttribPosition == visgl::posnLoc) {
+                    std::vector<std::uint16_t> packed = this->pack_halves (dat);
+                    glBufferData (GL_ARRAY_BUFFER, packed.size() * sizeof(std::uint16_t), packed.data(), GL_STATIC_DRAW);
+                    glVertexAttribPointer (bufferAttribPosition, 3, GL_HALF_FLOAT, GL_FALSE, 0, (void*)(0));
+                } else if (bufferAttribPosition == visgl::normLoc) {
+                    std::vector<std::uint32_t> packed = this->pack_normals (dat);
+                    glBufferData (GL_ARRAY_BUFFER, packed.size() * sizeof(std::uint32_t), packed.data(), GL_STATIC_DRAW);
+                    glVertexAttribPointer (bufferAttribPosition, 4, GL_INT_2_10_10_10_REV, GL_TRUE, 0, (void*)(0));
+                } else { // visgl::colLoc (and any other slot carrying 0-1 values)
+                    std::vector<std::uint8_t> packed = this->pack_colours (dat);
+                    glBufferData (GL_ARRAY_BUFFER, packed.size() * sizeof(std::uint8_t), packed.data(), GL_STATIC_DRAW);
+                    glVertexAttribPointer (bufferAttribPosition, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, (void*)(0));
+                }
+            } else
+#endif
+            {
+                glBufferData (GL_ARRAY_BUFFER, dat.size() * sizeof(float), dat.data(), GL_STATIC_DRAW);
+                glVertexAttribPointer (bufferAttribPosition, 3, GL_FLOAT, GL_FALSE, 0, (void*)(0));
+            }
             morph::gl::Util::checkError (__FILE__, __LINE__);
             glEnableVertexAttribArray (bufferAttribPosition);
             morph::gl::Util::checkError (__FILE__, __LINE__);
         }
+
+#ifdef GL_MAP_PERSISTENT_BIT
+        //! True when glver supports glBufferStorage and persistent mapping (desktop OpenGL 4.4+)
+        static constexpr bool buffer_streaming_supported =
+            morph::gl::version::gles (glver) == false
+            && (morph::gl::version::major (glver) > 4
+                || (morph::gl::version::major (glver) == 4 && morph::gl::version::minor (glver) >= 4));
+
+        /*!
+         * Allocate the vertex and index buffers as persistently-mapped, triple-buffered
+         * immutable storage (see use_persistent_buffers). The vertex array object must
+         * be bound. Returns false, leaving the glBufferData path in charge, if any
+         * mapping fails.
+         */
+        bool setup_streaming_buffers()
+        {
+            std::size_t vneed = std::max ({ this->vertexPositions.size(),
+                                            this->vertexNormals.size(), this->vertexColors.size() });
+            // Allow headroom, so that a growing model doesn't force a re-allocation every frame
+            this->stream_vcap = vneed + vneed / 2u + 96u;
+            this->stream_icap = this->indices.size() + this->indices.size() / 2u + 96u;
+            constexpr GLbitfield mapflags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            bool ok = true;
+            const GLuint vbufs[3] = { this->vbos[this->posnVBO], this->vbos[this->normVBO], this->vbos[this->colVBO] };
+            for (unsigned int b = 0; b < 3; ++b) {
+                GLsizeiptr sz = static_cast<GLsizeiptr>(this->stream_nsections * this->stream_vcap * sizeof(float));
+                glBindBuffer (GL_ARRAY_BUFFER, vbufs[b]);
+                glBufferStorage (GL_ARRAY_BUFFER, sz, nullptr, mapflags);
+                this->stream_vmap[b] = static_cast<float*>(glMapBufferRange (GL_ARRAY_BUFFER, 0, sz, mapflags));
+                ok = ok && (this->stream_vmap[b] != nullptr);
+            }
+            GLsizeiptr isz = static_cast<GLsizeiptr>(this->stream_nsections * this->stream_icap * sizeof(GLuint));
+            glBindBuffer (GL_ELEMENT_ARRAY_BUFFER, this->vbos[this->idxVBO]);
+            glBufferStorage (GL_ELEMENT_ARRAY_BUFFER, isz, nullptr, mapflags);
+            this->stream_imap = static_cast<GLuint*>(glMapBufferRange (GL_ELEMENT_ARRAY_BUFFER, 0, isz, mapflags));
+            ok = ok && (this->stream_imap != nullptr);
+            if (ok == false) {
+                while (glGetError() != GL_NO_ERROR) {} // swallow errors from the failed allocation
+                this->teardown_streaming_buffers();
+                return false;
+            }
+            this->stream_section = 0;
+            this->stream_active = true;
+            this->index_type = GL_UNSIGNED_INT; // the streamed index buffer is always GLuint
+            return true;
+        }
+
+        /*!
+         * Write the CPU-side vertex/index arrays straight into the current stream
+         * section of the persistently mapped buffers and point the vertex attributes
+         * (and stream_draw_offset) at that section. The vertex array object must be
+         * bound. Waits on the section's fence if the GPU is still reading it.
+         */
+        void stream_upload()
+        {
+            const unsigned int s = this->stream_section;
+            if (this->stream_fence[s] != nullptr) {
+                GLenum waitrtn = GL_TIMEOUT_EXPIRED;
+                while (waitrtn != GL_ALREADY_SIGNALED && waitrtn != GL_CONDITION_SATISFIED) {
+                    waitrtn = glClientWaitSync (this->stream_fence[s], GL_SYNC_FLUSH_COMMANDS_BIT, GLuint64{1000000});
+                    if (waitrtn == GL_WAIT_FAILED) { break; }
+                }
+                glDeleteSync (this->stream_fence[s]);
+                this->stream_fence[s] = nullptr;
+            }
+            std::memcpy (this->stream_vmap[0] + s * this->stream_vcap,
+                         this->vertexPositions.data(), this->vertexPositions.size() * sizeof(float));
+            std::memcpy (this->stream_vmap[1] + s * this->stream_vcap,
+                         this->vertexNormals.data(), this->vertexNormals.size() * sizeof(float));
+            std::memcpy (this->stream_vmap[2] + s * this->stream_vcap,
+                         this->vertexColors.data(), this->vertexColors.size() * sizeof(float));
+            std::memcpy (this->stream_imap + s * this->stream_icap,
+                         this->indices.data(), this->indices.size() * sizeof(GLuint));
+            // Point the vertex attributes at this section
+            const std::size_t voffs = s * this->stream_vcap * sizeof(float);
+            const GLuint vbufs[3] = { this->vbos[this->posnVBO], this->vbos[this->normVBO], this->vbos[this->colVBO] };
+            constexpr unsigned int locns[3] = { visgl::posnLoc, visgl::normLoc, visgl::colLoc };
+            for (unsigned int b = 0; b < 3; ++b) {
+                glBindBuffer (GL_ARRAY_BUFFER, vbufs[b]);
+                glVertexAttribPointer (locns[b], 3, GL_FLOAT, GL_FALSE, 0, reinterpret_cast<const void*>(voffs));
+                glEnableVertexAttribArray (locns[b]);
+            }
+            glBindBuffer (GL_ELEMENT_ARRAY_BUFFER, this->vbos[this->idxVBO]);
+            this->stream_draw_offset = s * this->stream_icap * sizeof(GLuint);
+        }
+
+        //! Release the streamed buffers (waiting out in-flight fences) and regenerate
+        //! plain, unmapped buffer objects, ready for either path to allocate.
+        void teardown_streaming_buffers()
+        {
+            for (unsigned int s = 0; s < this->stream_nsections; ++s) {
+                if (this->stream_fence[s] != nullptr) {
+                    glClientWaitSync (this->stream_fence[s], GL_SYNC_FLUSH_COMMANDS_BIT, GLuint64{100000000});
+                    glDeleteSync (this->stream_fence[s]);
+                    this->stream_fence[s] = nullptr;
+                }
+            }
+            glDeleteBuffers (this->numVBO, this->vbos.get()); // deletion unmaps
+            glGenBuffers (this->numVBO, this->vbos.get());
+            this->stream_vmap[0] = this->stream_vmap[1] = this->stream_vmap[2] = nullptr;
+            this->stream_imap = nullptr;
+            this->stream_draw_offset = 0;
+            this->stream_active = false;
+        }
+#else
+        // GL headers without GL_MAP_PERSISTENT_BIT (pre OpenGL 4.4): no streaming
+        static constexpr bool buffer_streaming_supported = false;
+        bool setup_streaming_buffers() { return false; }
+        void stream_upload() {}
+        void teardown_streaming_buffers() {}
+#endif
     };
 
 } // namespace morph
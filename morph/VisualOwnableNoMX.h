@@ -31,6 +31,7 @@ namespace morph { namespace gl { static constexpr int multicontext = 0; } }
 #include <morph/VisualResourcesNoMX.h>
 #include <morph/VisualTextModel.h>
 #include <morph/VisualBase.h>
+#include <morph/profile.h>
 #include <morph/gl/loadshaders_nomx.h>
 
 namespace morph {
@@ -71,12 +72,53 @@ namespace morph {
         //! Deconstruct gl memory/context
         void deconstructCommon()
         {
-            // Explicitly deconstruct any owned VisualModels
+            // Complete any asynchronous image captures and stop the encoder thread
+            if (this->capture_pbos[0] != 0) {
+                this->finishSavedImages();
+                glDeleteBuffers (capture_npbos, this->capture_pbos);
+                for (unsigned int s = 0; s < capture_npbos; ++s) { this->capture_pbos[s] = 0; }
+            } else {
+                this->encoder_finish();
+            }
+            // Delete any frame-profiler timer queries
+            for (auto& qs : this->profile_queries) {
+                if (!qs.empty()) { glDeleteQueries (static_cast<GLsizei>(qs.size()), qs.data()); }
+                qs.clear();
+            }
+            this->deleteGeometryPool();
+            // Batched teardown of the owned models. Collect every model's buffer and
+            // vertex array ids, then delete them with a single glDeleteBuffers and a
+            // single glDeleteVertexArrays call instead of a pair of GL calls per
+            // model. With the GL work done up front, the model memory itself can be
+            // released off this thread (see async_model_free).
+            std::vector<GLuint> buf_ids;
+            std::vector<GLuint> vao_ids;
+            for (auto& model : this->vm) { if (model != nullptr) { model->surrender_gl_ids (buf_ids, vao_ids); } }
+            if (this->coordArrows != nullptr) { this->coordArrows->surrender_gl_ids (buf_ids, vao_ids); }
+            if (this->textModel != nullptr) { this->textModel->surrender_gl_ids (buf_ids, vao_ids); }
+            if (this->profile_hud_text != nullptr) { this->profile_hud_text->surrender_gl_ids (buf_ids, vao_ids); }
+            for (auto& t : this->texts) { if (t != nullptr) { t->surrender_gl_ids (buf_ids, vao_ids); } }
+            if (buf_ids.empty() == false) { glDeleteBuffers (static_cast<GLsizei>(buf_ids.size()), buf_ids.data()); }
+            if (vao_ids.empty() == false) { glDeleteVertexArrays (static_cast<GLsizei>(vao_ids.size()), vao_ids.data()); }
+            if (this->async_model_free == true) {
+                // The destructors have no GL deletions left to make, so run them on a
+                // reaper thread while this one gets on with closing the window
+                std::thread ([vms = std::move (this->vm), ca = std::move (this->coordArrows),
+                              tm = std::move (this->textModel), pht = std::move (this->profile_hud_text),
+                              ts = std::move (this->texts)] () mutable {
+                    vms.clear();
+                    ca.reset (nullptr);
+                    tm.reset (nullptr);
+                    pht.reset (nullptr);
+                    ts.clear();
+                }).detach();
+            }
+            // If the memory was moved to the reaper thread, these are trivial
             this->vm.clear();
-            // Explicitly deconstruct coordArrows, textModel and texts here
-            this->coordArrows.reset(nullptr);
-            this->textModel.reset(nullptr);
-            for (auto& t : this->texts) { t.reset(nullptr); }
+            this->coordArrows.reset (nullptr);
+            this->textModel.reset (nullptr);
+            this->profile_hud_text.reset (nullptr);
+            this->texts.clear();
 
             if (this->shaders.gprog) {
                 glDeleteProgram (this->shaders.gprog);
@@ -87,6 +129,10 @@ namespace morph {
                 glDeleteProgram (this->shaders.tprog);
                 this->shaders.tprog = 0;
             }
+            if (this->pick_gprog) {
+                glDeleteProgram (this->pick_gprog);
+                this->pick_gprog = 0;
+            }
             // Free up the Fonts associated with this morph::Visual
             morph::VisualResourcesNoMX<glver>::i().freetype_deinit (this);
         }
@@ -99,14 +145,14 @@ namespace morph {
         }
 
     public:
-        // Do one-time init of the Visual's resources. This gets/creates the VisualResources,
-        // registers this visual with resources, calls init_window for any glfw stuff that needs to
-        // happen, and lastly initializes the freetype code.
+        // Do one-time init of the Visual's resources. This gets/creates the VisualResources and
+        // registers this visual with resources. FreeType initialization is deferred: it happens on
+        // the first getVisualFace call (i.e. the first text render), so a Visual which draws no
+        // text never pays for font setup.
         void init_resources()
         {
             // VisualResources provides font management and GLFW management. Ensure it exists in memory.
             morph::VisualResourcesNoMX<glver>::i().create();
-            this->freetype_init();
         }
 
         //! Stores the OpenGL function context version that was loaded
@@ -147,20 +193,528 @@ namespace morph {
                     }
                 }
             }
-            unsigned int error = lodepng::encode (img_filename, rbits.get(), dims[0], dims[1]);
-            if (error) {
-                std::cerr << "encoder error " << error << ": " << lodepng_error_text (error) << std::endl;
-                dims.set_from (-1);
-                return dims;
+            if (this->fast_png_encode == true) {
+                try {
+                    morph::pngenc::encode (img_filename, rbits.get(), dims[0], dims[1]);
+                } catch (const std::exception& e) {
+                    std::cerr << "encoder error: " << e.what() << std::endl;
+                    dims.set_from (-1);
+                }
+            } else {
+                unsigned int error = lodepng::encode (img_filename, rbits.get(), dims[0], dims[1]);
+                if (error) {
+                    std::cerr << "encoder error " << error << ": " << lodepng_error_text (error) << std::endl;
+                    dims.set_from (-1);
+                }
             }
             return dims;
         }
 
+        /*!
+         * Queue a screenshot of the window for writing to \a img_filename, without
+         * blocking the render loop. The pixels are read back through a ring of pixel
+         * buffer objects (so glReadPixels returns without draining the GL pipeline)
+         * and the PNG encode runs on a background thread. Frames land on disk a few
+         * saveImageAsync calls (or one finishSavedImages call) later. Use this
+         * instead of saveImage when capturing every frame of a running simulation;
+         * call finishSavedImages() before reading the files or exiting.
+         */
+        void saveImageAsync (const std::string& img_filename, const bool transparent_bg = false)
+        {
+            this->setContext();
+
+            GLint viewport[4]; // current viewport
+            glGetIntegerv (GL_VIEWPORT, viewport);
+            morph::vec<int, 2> dims = { viewport[2], viewport[3] };
+
+            if (this->capture_pbos[0] == 0) { glGenBuffers (capture_npbos, this->capture_pbos); }
+
+            // Collect any readbacks that have completed; if the ring is full, wait for the oldest
+            for (unsigned int s = 0; s < capture_npbos; ++s) { this->harvest_capture (s, false); }
+            this->harvest_capture (this->capture_head, true);
+
+            // Issue a readback into the head slot. With a bound pixel-pack buffer,
+            // glReadPixels returns immediately; the fence tells us when the pixels
+            // have landed. The glBufferData orphans any storage still in flight.
+            unsigned int s = this->capture_head;
+            glBindBuffer (GL_PIXEL_PACK_BUFFER, this->capture_pbos[s]);
+            glBufferData (GL_PIXEL_PACK_BUFFER, dims.product() * 4, nullptr, GL_STREAM_READ);
+            glPixelStorei (GL_PACK_ALIGNMENT, 1);
+            glPixelStorei (GL_PACK_ROW_LENGTH, 0);
+            glPixelStorei (GL_PACK_SKIP_ROWS, 0);
+            glPixelStorei (GL_PACK_SKIP_PIXELS, 0);
+            glReadPixels (0, 0, dims[0], dims[1], GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            this->capture_fences[s] = glFenceSync (GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            glBindBuffer (GL_PIXEL_PACK_BUFFER, 0);
+
+            this->capture_filenames[s] = img_filename;
+            this->capture_dims[s] = dims;
+            this->capture_transparent[s] = transparent_bg;
+            this->capture_video[s] = false;
+            this->capture_pending[s] = true;
+            this->capture_head = (this->capture_head + 1u) % capture_npbos;
+        }
+
+        /*!
+         * Collect all in-flight asynchronous captures and wait for the background
+         * encoder to finish writing them out. Call before exiting (or whenever the
+         * queued PNG files must exist on disk).
+         */
+        void finishSavedImages()
+        {
+            if (this->capture_pbos[0] != 0) {
+                this->setContext();
+                for (unsigned int i = 1; i <= capture_npbos; ++i) {
+                    this->harvest_capture ((this->capture_head + i) % capture_npbos, true);
+                }
+            }
+            this->encoder_finish();
+        }
+
+        /*!
+         * Begin recording a video to \a video_filename at \a fps frames per second. Add
+         * frames by calling recordFrame() after each render(); they travel through the
+         * same asynchronous pixel-buffer readback ring as saveImageAsync and are
+         * streamed to an ffmpeg child process (which must be on the PATH at runtime) by
+         * the background encoder thread, so the render loop waits on neither the
+         * readback nor the video encoder and no per-frame image files are written.
+         * Encodes H.264 (libx264) by default; pass "h264_vaapi" or "h264_nvenc" as \a
+         * codec for hardware encoding - see morph::VideoRecorder for device selection
+         * via \a codec_args and for the filter_chain adjustment a hardware upload
+         * needs. Throws if a recording is already in progress.
+         */
+        void startRecording (const std::string& video_filename, const double fps = 30.0,
+                             const std::string& codec = "libx264", const std::string& codec_args = "")
+        {
+            if (this->video_recorder != nullptr) {
+                throw std::runtime_error ("startRecording: a recording is already in progress");
+            }
+            this->video_recorder = std::make_unique<morph::VideoRecorder> (video_filename, fps, codec, codec_args);
+        }
+
+        //! Queue the window's current frame for the video recording begun with
+        //! startRecording(). Call once per render(). Does nothing when not recording.
+        void recordFrame()
+        {
+            if (this->video_recorder == nullptr) { return; }
+            this->setContext();
+
+            GLint viewport[4]; // current viewport
+            glGetIntegerv (GL_VIEWPORT, viewport);
+            morph::vec<int, 2> dims = { viewport[2], viewport[3] };
+
+            if (this->capture_pbos[0] == 0) { glGenBuffers (capture_npbos, this->capture_pbos); }
+
+            // Collect any readbacks that have completed; if the ring is full, wait for the oldest
+            for (unsigned int s = 0; s < capture_npbos; ++s) { this->harvest_capture (s, false); }
+            this->harvest_capture (this->capture_head, true);
+
+            // Issue a readback into the head slot, exactly as saveImageAsync does
+            unsigned int s = this->capture_head;
+            glBindBuffer (GL_PIXEL_PACK_BUFFER, this->capture_pbos[s]);
+            glBufferData (GL_PIXEL_PACK_BUFFER, dims.product() * 4, nullptr, GL_STREAM_READ);
+            glPixelStorei (GL_PACK_ALIGNMENT, 1);
+            glPixelStorei (GL_PACK_ROW_LENGTH, 0);
+            glPixelStorei (GL_PACK_SKIP_ROWS, 0);
+            glPixelStorei (GL_PACK_SKIP_PIXELS, 0);
+            glReadPixels (0, 0, dims[0], dims[1], GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            this->capture_fences[s] = glFenceSync (GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            glBindBuffer (GL_PIXEL_PACK_BUFFER, 0);
+
+            this->capture_filenames[s].clear();
+            this->capture_dims[s] = dims;
+            this->capture_transparent[s] = false;
+            this->capture_video[s] = true;
+            this->capture_pending[s] = true;
+            this->capture_head = (this->capture_head + 1u) % capture_npbos;
+        }
+
+        /*!
+         * Finish the recording: drain the in-flight readbacks, wait for the encoder
+         * thread and close the ffmpeg stream (which finalizes the .mp4). Returns the
+         * number of frames encoded - 0 if no recording was running or the encoder could
+         * not be started.
+         */
+        std::size_t stopRecording()
+        {
+            if (this->video_recorder == nullptr) { return 0u; }
+            this->finishSavedImages();
+            std::size_t nf = this->video_recorder->framesWritten();
+            int status = this->video_recorder->close();
+            if (nf > 0u && status != 0) {
+                std::cerr << "stopRecording: the video encoder exited with status " << status << std::endl;
+            }
+            this->video_recorder.reset();
+            return nf;
+        }
+
+        //! True while a startRecording()/stopRecording() video recording is in progress
+        bool isRecording() const { return this->video_recorder != nullptr; }
+
+        /*!
+         * Render the scene at \a img_dims resolution - which may be far larger than any
+         * framebuffer the window system will give you - and write it to \a
+         * img_filename. The scene is rendered tile by tile into an offscreen
+         * framebuffer object of the window's size, with the projection set (via
+         * mat44::frustum) to each tile's sub-rectangle of the full film plane, and the
+         * tiles are composited into the image as they are read back. The PNG encode
+         * runs on the background encoder thread, so call finishSavedImages() before
+         * reading the file or exiting. Works for perspective and orthographic
+         * projections (not cylindrical). Returns img_dims, or {-1, -1} on failure.
+         */
+        morph::vec<int, 2> saveImageTiled (const std::string& img_filename, const morph::vec<int, 2>& img_dims,
+                                           const bool transparent_bg = false)
+        {
+            morph::vec<int, 2> fail = { -1, -1 };
+            if (img_dims[0] <= 0 || img_dims[1] <= 0) { return fail; }
+            if (this->ptype != perspective_type::orthographic && this->ptype != perspective_type::perspective) {
+                std::cerr << "saveImageTiled: only perspective and orthographic projections are supported\n";
+                return fail;
+            }
+            this->setContext();
+
+            // Each tile is the size of the window framebuffer, which is the viewport that render() sets
+            int tw = this->window_w * morph::retinaScale;
+            int th = this->window_h * morph::retinaScale;
+            if (tw <= 0 || th <= 0) { return fail; }
+            int nx = (img_dims[0] + tw - 1) / tw;
+            int ny = (img_dims[1] + th - 1) / th;
+
+            // An offscreen framebuffer of tile size with colour and depth renderbuffers
+            GLuint fbo = 0, rb_colour = 0, rb_depth = 0;
+            glGenFramebuffers (1, &fbo);
+            glBindFramebuffer (GL_FRAMEBUFFER, fbo);
+            glGenRenderbuffers (1, &rb_colour);
+            glBindRenderbuffer (GL_RENDERBUFFER, rb_colour);
+            glRenderbufferStorage (GL_RENDERBUFFER, GL_RGBA8, tw, th);
+            glFramebufferRenderbuffer (GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, rb_colour);
+            glGenRenderbuffers (1, &rb_depth);
+            glBindRenderbuffer (GL_RENDERBUFFER, rb_depth);
+            glRenderbufferStorage (GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, tw, th);
+            glFramebufferRenderbuffer (GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, rb_depth);
+            bool fbo_ok = (glCheckFramebufferStatus (GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE);
+
+            if (fbo_ok == true) {
+                // The full film plane {left, right, bottom, top}; perspective measures it at
+                // zNear, orthographic in scene units
+                morph::vec<float, 4> film;
+                if (this->ptype == perspective_type::perspective) {
+                    float t_half = this->zNear * std::tan (this->fov * morph::mathconst<float>::pi_over_360);
+                    float r_half = t_half * (static_cast<float>(img_dims[0]) / static_cast<float>(img_dims[1]));
+                    film = { -r_half, r_half, -t_half, t_half };
+                } else {
+                    film = { this->ortho_lb[0], this->ortho_rt[0], this->ortho_lb[1], this->ortho_rt[1] };
+                }
+
+                // The frame to be encoded, assembled with rows bottom-up as encode_enqueue expects
+                typename morph::VisualBase<glver>::img_encode_job job;
+                job.filename = img_filename;
+                job.dims = img_dims;
+                job.transparent_bg = transparent_bg;
+                job.pixels.resize (4u * static_cast<std::size_t>(img_dims[0]) * img_dims[1]);
+                std::vector<unsigned char> tilebits (4u * static_cast<std::size_t>(tw) * th);
+
+                this->tile_render = true;
+                for (int tj = 0; tj < ny; ++tj) {         // tile row, from the bottom of the image
+                    for (int ti = 0; ti < nx; ++ti) {     // tile column, from the left
+                        // Project this tile's patch of the film plane. Edge tiles may
+                        // extend beyond it; the excess pixels are simply not copied.
+                        this->tile_frustum[0] = film[0] + (film[1] - film[0]) * (static_cast<float>(ti * tw) / img_dims[0]);
+                        this->tile_frustum[1] = film[0] + (film[1] - film[0]) * (static_cast<float>(ti * tw + tw) / img_dims[0]);
+                        this->tile_frustum[2] = film[2] + (film[3] - film[2]) * (static_cast<float>(tj * th) / img_dims[1]);
+                        this->tile_frustum[3] = film[2] + (film[3] - film[2]) * (static_cast<float>(tj * th + th) / img_dims[1]);
+                        this->render();
+
+                        glPixelStorei (GL_PACK_ALIGNMENT, 1);
+                        glPixelStorei (GL_PACK_ROW_LENGTH, 0);
+                        glPixelStorei (GL_PACK_SKIP_ROWS, 0);
+                        glPixelStorei (GL_PACK_SKIP_PIXELS, 0);
+                        glReadPixels (0, 0, tw, th, GL_RGBA, GL_UNSIGNED_BYTE, tilebits.data());
+
+                        // Composite the tile's in-image region into the frame
+                        int wcopy = std::min (tw, img_dims[0] - ti * tw);
+                        int hcopy = std::min (th, img_dims[1] - tj * th);
+                        for (int r = 0; r < hcopy; ++r) {
+                            std::size_t dst = 4u * (static_cast<std::size_t>(tj * th + r) * img_dims[0] + ti * tw);
+                            std::memcpy (&job.pixels[dst], &tilebits[4u * static_cast<std::size_t>(r) * tw], 4u * wcopy);
+                        }
+                    }
+                }
+                this->tile_render = false;
+
+                // Hand the assembled frame to the background encoder thread
+                this->encode_enqueue (std::move (job));
+            }
+
+            glBindFramebuffer (GL_FRAMEBUFFER, 0);
+            glDeleteRenderbuffers (1, &rb_depth);
+            glDeleteRenderbuffers (1, &rb_colour);
+            glDeleteFramebuffers (1, &fbo);
+
+            return fbo_ok == true ? img_dims : fail;
+        }
+
+        /*!
+         * Identify the model and element under window pixel (\a x, \a y) (origin top
+         * left, as mouse coordinates arrive) by rendering the scene into an offscreen
+         * ID buffer. Each model is drawn with a small picking shader that writes the
+         * model's index into the red channel and a per-vertex element id (filled in by
+         * the model's fillPickIDs override, if it has one) into the remaining three.
+         * Returns {model index in order of addVisualModel, element index within that
+         * model}, or {-1, -1} if the background was hit. The element index is -1 for
+         * parts of a model (such as borders or framework) that carry no element id,
+         * and 0 for models with no fillPickIDs override at all. Works for perspective
+         * and orthographic projections (not cylindrical) and for up to 255 models.
+         */
+        morph::vec<int, 2> pick (const int x, const int y)
+        {
+            morph::vec<int, 2> fail = { -1, -1 };
+            if (this->ptype != perspective_type::orthographic && this->ptype != perspective_type::perspective) {
+                std::cerr << "pick: only perspective and orthographic projections are supported\n";
+                return fail;
+            }
+            this->setContext();
+
+            // Lazily load the picking shader on first use (cf. cyl_shader_progs)
+            if (this->pick_gprog == 0) {
+                this->pick_shader_progs = {
+                    {GL_VERTEX_SHADER, "VisPick.vert.glsl", morph::getDefaultPickVtxShader(glver), 0 },
+                    {GL_FRAGMENT_SHADER, "VisPick.frag.glsl", morph::getDefaultPickFragShader(glver), 0 }
+                };
+                this->pick_gprog = morph::gl::LoadShaders (this->pick_shader_progs);
+            }
+
+            int w = this->window_w * morph::retinaScale;
+            int h = this->window_h * morph::retinaScale;
+            int px = x * morph::retinaScale;
+            int py = h - 1 - (y * morph::retinaScale); // ID buffer rows are bottom-up
+            if (px < 0 || px >= w || py < 0 || py >= h) { return fail; }
+
+            // An offscreen framebuffer, window sized, with colour and depth renderbuffers
+            GLuint fbo = 0, rb_colour = 0, rb_depth = 0;
+            glGenFramebuffers (1, &fbo);
+            glBindFramebuffer (GL_FRAMEBUFFER, fbo);
+            glGenRenderbuffers (1, &rb_colour);
+            glBindRenderbuffer (GL_RENDERBUFFER, rb_colour);
+            glRenderbufferStorage (GL_RENDERBUFFER, GL_RGBA8, w, h);
+            glFramebufferRenderbuffer (GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, rb_colour);
+            glGenRenderbuffers (1, &rb_depth);
+            glBindRenderbuffer (GL_RENDERBUFFER, rb_depth);
+            glRenderbufferStorage (GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, w, h);
+            glFramebufferRenderbuffer (GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, rb_depth);
+
+            morph::vec<int, 2> rtn = fail;
+            if (glCheckFramebufferStatus (GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE) {
+
+                glUseProgram (this->pick_gprog);
+                glViewport (0, 0, w, h);
+                // Blending would corrupt the IDs encoded in the colour channels
+                glDisable (GL_BLEND);
+
+                if (this->ptype == perspective_type::orthographic) {
+                    this->setOrthographic();
+                } else {
+                    this->setPerspective();
+                }
+                GLint loc_p = glGetUniformLocation (this->pick_gprog, static_cast<const GLchar*>("p_matrix"));
+                if (loc_p != -1) { glUniformMatrix4fv (loc_p, 1, GL_FALSE, this->projection.mat.data()); }
+
+                // Background clears to 0, which is reserved to mean 'no model'
+                glClearColor (0.0f, 0.0f, 0.0f, 0.0f);
+                glClear (GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+                // The same scene transformations that render() applies
+                morph::mat44<float> sceneview;
+                sceneview.translate (this->scenetrans);
+                sceneview.rotate (this->rotation);
+                morph::mat44<float> scenetransonly;
+                scenetransonly.translate (this->scenetrans);
+
+                unsigned int mi = 0;
+                for (auto& model : this->vm) {
+                    if (mi >= 255u) { break; } // model index must fit the red channel
+                    if (model->twodimensional == true) {
+                        model->setSceneMatrix (scenetransonly);
+                    } else {
+                        model->setSceneMatrix (sceneview);
+                    }
+                    model->render_pick (this->pick_gprog, static_cast<float>(mi + 1u));
+                    ++mi;
+                }
+
+                unsigned char idpx[4] = { 0, 0, 0, 0 };
+                glPixelStorei (GL_PACK_ALIGNMENT, 1);
+                glReadPixels (px, py, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, idpx);
+
+                glEnable (GL_BLEND);
+
+                if (idpx[0] > 0) {
+                    int elem = idpx[1] + 256 * idpx[2] + 65536 * idpx[3];
+                    if (elem == static_cast<int>(morph::VisualModelBase<glver>::pick_id_none)) { elem = -1; }
+                    rtn = { static_cast<int>(idpx[0]) - 1, elem };
+                }
+            }
+
+            glBindFramebuffer (GL_FRAMEBUFFER, 0);
+            glDeleteRenderbuffers (1, &rb_depth);
+            glDeleteRenderbuffers (1, &rb_colour);
+            glDeleteFramebuffers (1, &fbo);
+
+            return rtn;
+        }
+
+        /*!
+         * Merge the geometry of every finalized model that has opted in with
+         * join_geometry_pool == true into one shared vertex array and index buffer,
+         * drawn with one base-vertex draw call per model. This trades per-model
+         * VAO/VBO handling (which dominates driver time in scenes of thousands of
+         * small, static models) for a single buffer bind. Pooled models keep their
+         * usual scene/model transformations and alpha; their texts render as normal.
+         * Call after finalizing and adding the models; a model that is subsequently
+         * reinit'd drops out of the pool and renders from its own buffers until
+         * buildGeometryPool() is called again. Pooled models are skipped by the
+         * picking pass (see pick()).
+         */
+        void buildGeometryPool()
+        {
+            this->setContext();
+            this->deleteGeometryPool();
+
+            std::size_t n_pool_verts = 0u;
+            std::size_t n_pool_indices = 0u;
+            for (auto& m : this->vm) {
+                if (m->join_geometry_pool == false) { continue; }
+                if (m->geometry_vertex_count() == 0u || m->geometry_index_count() == 0u) { continue; }
+                n_pool_verts += m->geometry_vertex_count();
+                n_pool_indices += m->geometry_index_count();
+                this->pool_members.push_back (m.get());
+            }
+            if (this->pool_members.empty()) { return; }
+
+            // Concatenate the members' CPU-side vertex containers, recording where
+            // each member's geometry lands
+            morph::vertex_buffer_t<float> pool_posn;
+            morph::vertex_buffer_t<float> pool_norm;
+            morph::vertex_buffer_t<float> pool_col;
+            morph::vertex_buffer_t<GLuint> pool_idx;
+            pool_posn.reserve (3u * n_pool_verts);
+            pool_norm.reserve (3u * n_pool_verts);
+            pool_col.reserve (3u * n_pool_verts);
+            pool_idx.reserve (n_pool_indices);
+            for (auto* m : this->pool_members) {
+                m->append_geometry_to (pool_posn, pool_norm, pool_col, pool_idx);
+                m->pooled = true;
+            }
+
+            // One VAO and four buffers for the whole pool (cf. VisualModelImpl::postVertexInit)
+            glGenVertexArrays (1, &this->pool_vao);
+            glBindVertexArray (this->pool_vao);
+            glGenBuffers (4, this->pool_vbos);
+            glBindBuffer (GL_ELEMENT_ARRAY_BUFFER, this->pool_vbos[3]);
+            glBufferData (GL_ELEMENT_ARRAY_BUFFER, pool_idx.size() * sizeof(GLuint), pool_idx.data(), GL_STATIC_DRAW);
+            const morph::vertex_buffer_t<float>* dats[3] = { &pool_posn, &pool_norm, &pool_col };
+            constexpr unsigned int locns[3] = { morph::visgl::posnLoc, morph::visgl::normLoc, morph::visgl::colLoc };
+            for (unsigned int b = 0; b < 3; ++b) {
+                glBindBuffer (GL_ARRAY_BUFFER, this->pool_vbos[b]);
+                glBufferData (GL_ARRAY_BUFFER, dats[b]->size() * sizeof(float), dats[b]->data(), GL_STATIC_DRAW);
+                glVertexAttribPointer (locns[b], 3, GL_FLOAT, GL_FALSE, 0, (void*)(0));
+                glEnableVertexAttribArray (locns[b]);
+            }
+            glBindVertexArray (0);
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+        }
+
+        //! Release the scene geometry pool, returning its members to their own buffers
+        void deleteGeometryPool()
+        {
+            for (auto* m : this->pool_members) { m->pooled = false; }
+            this->pool_members.clear();
+            if (this->pool_vao != 0) {
+                glDeleteBuffers (4, this->pool_vbos);
+                glDeleteVertexArrays (1, &this->pool_vao);
+                this->pool_vao = 0;
+                for (auto& b : this->pool_vbos) { b = 0; }
+            }
+        }
+
+    protected:
+        //! The scene geometry pool vertex array (see buildGeometryPool); 0 when no pool exists
+        GLuint pool_vao = 0;
+        //! The pool's position, normal, colour and index buffers
+        GLuint pool_vbos[4] = { 0, 0, 0, 0 };
+        //! The models whose geometry is resident in the pool
+        std::vector<morph::VisualModel<glver>*> pool_members;
+
+        //! If capture slot \a s holds a completed readback (or \a wait is true), map
+        //! its pixel buffer and queue the frame for the encoder thread
+        void harvest_capture (unsigned int s, bool wait)
+        {
+            if (this->capture_pending[s] == false) { return; }
+            if (this->capture_fences[s] != nullptr) {
+                GLenum ws = glClientWaitSync (this->capture_fences[s], GL_SYNC_FLUSH_COMMANDS_BIT,
+                                              wait ? GLuint64{5000000000} : GLuint64{0});
+                if (wait == false && (ws == GL_TIMEOUT_EXPIRED || ws == GL_WAIT_FAILED)) { return; }
+                glDeleteSync (this->capture_fences[s]);
+                this->capture_fences[s] = nullptr;
+            }
+            std::size_t sz = this->capture_dims[s].product() * 4;
+            glBindBuffer (GL_PIXEL_PACK_BUFFER, this->capture_pbos[s]);
+            void* p = glMapBufferRange (GL_PIXEL_PACK_BUFFER, 0, sz, GL_MAP_READ_BIT);
+            if (p != nullptr) {
+                typename morph::VisualBase<glver>::img_encode_job job;
+                job.filename = this->capture_filenames[s];
+                job.dims = this->capture_dims[s];
+                job.transparent_bg = this->capture_transparent[s];
+                job.video = this->capture_video[s];
+                job.pixels.assign (static_cast<unsigned char*>(p), static_cast<unsigned char*>(p) + sz);
+                glUnmapBuffer (GL_PIXEL_PACK_BUFFER);
+                this->encode_enqueue (std::move (job));
+            }
+            glBindBuffer (GL_PIXEL_PACK_BUFFER, 0);
+            this->capture_pending[s] = false;
+        }
+
+        //! Number of pixel buffer objects in the asynchronous capture ring. Three
+        //! means a readback can be two frames in flight before anything blocks.
+        static constexpr unsigned int capture_npbos = 3;
+        //! The pixel-pack buffer ring for saveImageAsync (0 until first use)
+        GLuint capture_pbos[capture_npbos] = { 0, 0, 0 };
+        //! Per-slot fence, signalled when the readback's pixels have landed
+        GLsync capture_fences[capture_npbos] = { nullptr, nullptr, nullptr };
+        //! Per-slot target filename
+        std::string capture_filenames[capture_npbos];
+        //! Per-slot frame dimensions
+        morph::vec<int, 2> capture_dims[capture_npbos];
+        //! Per-slot transparent background flag
+        bool capture_transparent[capture_npbos] = { false, false, false };
+        //! Per-slot flag: the frame is destined for the video recorder, not a PNG
+        bool capture_video[capture_npbos] = { false, false, false };
+        //! True for slots with a readback in flight
+        bool capture_pending[capture_npbos] = { false, false, false };
+        //! The next capture slot to issue into
+        unsigned int capture_head = 0;
+
+    public:
         //! Render the scene
         void render() noexcept final
         {
+            MORPH_PROFILE_SCOPE ("Visual::render");
+            // A playing camera path sets the scene pose (and render_required) each frame
+            this->advanceCameraPath();
+
+            // In render-on-demand mode, skip the frame entirely if nothing has changed
+            if (this->render_on_demand == true && this->render_required == false) { return; }
+            this->render_required = false;
+
             this->setContext();
 
+            const bool prof = (this->profile_frames == true || this->show_profile_hud == true);
+            std::chrono::steady_clock::time_point t_frame0{};
+            if (prof == true) {
+                t_frame0 = std::chrono::steady_clock::now();
+                this->ensure_profile_queries();
+            }
+
             if (this->ptype == perspective_type::orthographic || this->ptype == perspective_type::perspective) {
                 if (this->active_gprog != morph::visgl::graphics_shader_type::projection2d) {
                     if (this->shaders.gprog) { glDeleteProgram (this->shaders.gprog); }
@@ -255,6 +809,12 @@ namespace morph {
             morph::mat44<float> scenetransonly;
             scenetransonly.translate (this->scenetrans);
 
+            if (prof == true) { this->profiling.models.resize (this->vm.size()); }
+            // Frustum culling is meaningless for the shader-based cylindrical projection
+            const bool cull = (this->frustum_cull == true
+                               && (this->ptype == perspective_type::orthographic
+                                   || this->ptype == perspective_type::perspective));
+            unsigned int mi = 0;
             auto vmi = this->vm.begin();
             while (vmi != this->vm.end()) {
                 if ((*vmi)->twodimensional == true) {
@@ -263,8 +823,53 @@ namespace morph {
                 } else {
                     (*vmi)->setSceneMatrix (sceneview);
                 }
-                (*vmi)->render();
+                const bool drawit = (cull == false || (*vmi)->withinFrustum (this->projection) == true);
+                if (prof == true) {
+                    // Time the model's render on the CPU and, with a timer query,
+                    // on the GPU
+                    auto t0 = std::chrono::steady_clock::now();
+                    glBeginQuery (GL_TIME_ELAPSED, this->profile_queries[this->profile_qset][mi]);
+                    if (drawit == true) { (*vmi)->render(); }
+                    glEndQuery (GL_TIME_ELAPSED);
+                    auto& mstats = this->profiling.models[mi];
+                    mstats.modelId = mi;
+                    mstats.name = (*vmi)->name;
+                    mstats.cpu_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+                    mstats.vertex_init_ms = (*vmi)->vertex_init_ms;
+                } else if (drawit == true) {
+                    (*vmi)->render();
+                }
                 ++vmi;
+                ++mi;
+            }
+
+            // Draw the scene geometry pool, if one has been built: one VAO bind, then
+            // a base-vertex draw per resident model with its own transforms and alpha
+            if (this->pool_vao != 0) {
+                glBindVertexArray (this->pool_vao);
+                for (auto* pm : this->pool_members) {
+                    if (cull == true && pm->withinFrustum (this->projection) == false) { continue; }
+                    pm->render_pooled();
+                }
+                glBindVertexArray (0);
+                morph::gl::Util::checkError (__FILE__, __LINE__);
+            }
+
+            if (prof == true) {
+                // Harvest GPU times from the queries issued *last* frame (reading the
+                // current frame's queries here would stall on the GPU)
+                unsigned int prevset = 1u - this->profile_qset;
+                if (this->profile_qissued[prevset] == true) {
+                    std::size_t n = std::min (this->profiling.models.size(), this->profile_queries[prevset].size());
+                    for (std::size_t i = 0; i < n; ++i) {
+                        GLuint64 ns = 0;
+                        glGetQueryObjectui64v (this->profile_queries[prevset][i], GL_QUERY_RESULT, &ns);
+                        this->profiling.models[i].gpu_ms = static_cast<double>(ns) * 1e-6;
+                    }
+                }
+                this->profile_qissued[this->profile_qset] = true;
+                this->profile_qset = prevset;
+                this->profile_frame_done (std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t_frame0).count());
             }
 
             morph::vec<float, 3> v0 = this->textPosition ({-0.8f, 0.8f});
@@ -283,9 +888,56 @@ namespace morph {
                 ++ti;
             }
 
+            if (this->show_profile_hud == true) { this->render_profile_hud(); }
+
             this->swapBuffers();
         }
 
+    protected:
+        //! Draw the profiling HUD text overlay, refreshing its content every
+        //! profile_hud_period frames (setupText rebuilds the glyph quads, so it is
+        //! not done every frame)
+        void render_profile_hud()
+        {
+            if (this->profile_hud_text == nullptr || (this->profiling.framenum % this->profile_hud_period) == 0) {
+                if (this->profile_hud_text == nullptr) {
+                    morph::TextFeatures hud_tf (0.03f, 48);
+                    this->profile_hud_text = std::make_unique<morph::VisualTextModel<glver>> (hud_tf);
+                    this->bindmodel (this->profile_hud_text);
+                }
+                this->profile_hud_text->setupText (this->profile_summary());
+            }
+            morph::vec<float, 3> hudpos = this->textPosition ({-0.9f, 0.6f});
+            this->profile_hud_text->setSceneTranslation (hudpos);
+            this->profile_hud_text->setVisibleOn (this->bgcolour);
+            this->profile_hud_text->render();
+        }
+
+        //! Make sure there is one GL_TIME_ELAPSED query per model in each of the two
+        //! query sets. Two sets, used in alternate frames, mean last frame's results
+        //! are always ready to read without a stall.
+        void ensure_profile_queries()
+        {
+            for (auto& qs : this->profile_queries) {
+                if (qs.size() < this->vm.size()) {
+                    std::size_t oldsz = qs.size();
+                    qs.resize (this->vm.size(), 0);
+                    glGenQueries (static_cast<GLsizei>(qs.size() - oldsz), qs.data() + oldsz);
+                }
+            }
+        }
+
+        //! Timer query pools for the frame profiler (one query per model, two sets)
+        std::vector<GLuint> profile_queries[2];
+        //! Which query set is being written this frame
+        unsigned int profile_qset = 0;
+        //! Whether each query set holds issued (readable) queries
+        bool profile_qissued[2] = { false, false };
+        //! The profiling HUD's text model
+        std::unique_ptr<morph::VisualTextModel<glver>> profile_hud_text = nullptr;
+
+    public:
+
     public:
 #ifdef GLAD_GL // Only define if GL was included with GLAD
         void init_glad (GLADloadfunc procaddressfn)
@@ -29,9 +29,9 @@ namespace morph {
         ~VisualResourcesMX() { this->faces.clear(); }
 
         //! The collection of VisualFaces generated for this instance of the
-        //! application. Create one VisualFace for each unique combination of VisualFont
-        //! and fontpixels (the texture resolution)
-        std::map<std::tuple<morph::VisualFont, unsigned int, morph::VisualBase<glver>*>,
+        //! application. Create one VisualFace for each unique combination of VisualFont,
+        //! fontpixels (the texture resolution) and coverage/SDF atlas mode
+        std::map<std::tuple<morph::VisualFont, unsigned int, bool, morph::VisualBase<glver>*>,
                  std::unique_ptr<morph::visgl::VisualFaceMX>> faces;
     public:
         VisualResourcesMX(const VisualResourcesMX<glver>&) = delete;
@@ -77,15 +77,21 @@ namespace morph {
 
         //! Return a pointer to a VisualFace for the given \a font at the given texture
         //! resolution, \a fontpixels and the given window (i.e. OpenGL context) \a _win.
+        //! The FT_Library for the window and the VisualFace itself are created on the
+        //! first call (with the right GL context current - true for the
+        //! VisualTextModel code paths that call this), so a Visual that renders no
+        //! text never initializes FreeType or rasterizes a glyph.
         morph::visgl::VisualFaceMX* getVisualFace (morph::VisualFont font, unsigned int fontpixels,
-                                                   morph::VisualBase<glver>* _vis, GladGLContext* glfn)
+                                                   morph::VisualBase<glver>* _vis, GladGLContext* glfn,
+                                                   const bool sdf = false)
         {
+            this->freetype_init (_vis, glfn); // no-op after the first call for _vis
             morph::visgl::VisualFaceMX* rtn = nullptr;
-            auto key = std::make_tuple(font, fontpixels, _vis);
+            auto key = std::make_tuple(font, fontpixels, sdf, _vis);
             try {
                 rtn = this->faces.at(key).get();
             } catch (const std::out_of_range&) {
-                this->faces[key] = std::make_unique<morph::visgl::VisualFaceMX> (font, fontpixels, this->freetypes.at(_vis), glfn);
+                this->faces[key] = std::make_unique<morph::visgl::VisualFaceMX> (font, fontpixels, this->freetypes.at(_vis), glfn, sdf);
                 rtn = this->faces.at(key).get();
             }
             return rtn;
@@ -94,7 +100,7 @@ namespace morph {
         morph::visgl::VisualFaceMX* getVisualFace (const morph::TextFeatures& tf,
                                                    morph::VisualBase<glver>* _vis, GladGLContext* glfn)
         {
-            return this->getVisualFace (tf.font, tf.fontres, _vis, glfn);
+            return this->getVisualFace (tf.font, tf.fontres, _vis, glfn, tf.sdf);
         }
 
         //! Loop through this->faces clearing out those associated with the given morph::Visual
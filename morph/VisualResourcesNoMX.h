@@ -32,9 +32,9 @@ namespace morph {
         ~VisualResourcesNoMX() { this->faces.clear(); }
 
         //! The collection of VisualFaces generated for this instance of the
-        //! application. Create one VisualFace for each unique combination of VisualFont
-        //! and fontpixels (the texture resolution)
-        std::map<std::tuple<morph::VisualFont, unsigned int, morph::VisualBase<glver>*>,
+        //! application. Create one VisualFace for each unique combination of VisualFont,
+        //! fontpixels (the texture resolution) and coverage/SDF atlas mode
+        std::map<std::tuple<morph::VisualFont, unsigned int, bool, morph::VisualBase<glver>*>,
                  std::unique_ptr<morph::visgl::VisualFaceNoMX>> faces;
     public:
         VisualResourcesNoMX(const VisualResourcesNoMX<glver>&) = delete;
@@ -80,14 +80,20 @@ namespace morph {
 
         //! Return a pointer to a VisualFace for the given \a font at the given texture
         //! resolution, \a fontpixels and the given window (i.e. OpenGL context) \a _win.
-        morph::visgl::VisualFaceNoMX* getVisualFace (morph::VisualFont font, unsigned int fontpixels, morph::VisualBase<glver>* _vis)
+        //! The FT_Library for the window and the VisualFace itself are created on the
+        //! first call (with the right GL context current - true for the
+        //! VisualTextModel code paths that call this), so a Visual that renders no
+        //! text never initializes FreeType or rasterizes a glyph.
+        morph::visgl::VisualFaceNoMX* getVisualFace (morph::VisualFont font, unsigned int fontpixels, morph::VisualBase<glver>* _vis,
+                                                     const bool sdf = false)
         {
+            this->freetype_init (_vis); // no-op after the first call for _vis
             morph::visgl::VisualFaceNoMX* rtn = nullptr;
-            auto key = std::make_tuple(font, fontpixels, _vis);
+            auto key = std::make_tuple(font, fontpixels, sdf, _vis);
             try {
                 rtn = this->faces.at(key).get();
             } catch (const std::out_of_range&) {
-                this->faces[key] = std::make_unique<morph::visgl::VisualFaceNoMX> (font, fontpixels, this->freetypes.at(_vis));
+                this->faces[key] = std::make_unique<morph::visgl::VisualFaceNoMX> (font, fontpixels, this->freetypes.at(_vis), sdf);
                 rtn = this->faces.at(key).get();
             }
             return rtn;
@@ -95,7 +101,7 @@ namespace morph {
 
         morph::visgl::VisualFaceNoMX* getVisualFace (const morph::TextFeatures& tf, morph::VisualBase<glver>* _vis)
         {
-            return this->getVisualFace (tf.font, tf.fontres, _vis);
+            return this->getVisualFace (tf.font, tf.fontres, _vis, tf.sdf);
         }
 
         //! Loop through this->faces clearing out those associated with the given morph::Visual
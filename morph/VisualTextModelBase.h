@@ -19,6 +19,7 @@
 #include <morph/TextGeometry.h>
 #include <morph/TextFeatures.h>
 #include <morph/colour.h>
+#include <morph/AllocationStats.h>
 #include <string>
 #include <sstream>
 #include <vector>
@@ -189,11 +190,15 @@ namespace morph {
                 this->vertex_push (quad[6], quad[7],  quad[8],  this->vertexPositions); //3
                 this->vertex_push (quad[9], quad[10], quad[11], this->vertexPositions); //4
 
-                // Add the info for drawing the textures on the quads
-                this->vertex_push (0.0f, 1.0f, 0.0f, this->vertexTextures);
-                this->vertex_push (0.0f, 0.0f, 0.0f, this->vertexTextures);
-                this->vertex_push (1.0f, 0.0f, 0.0f, this->vertexTextures);
-                this->vertex_push (1.0f, 1.0f, 0.0f, this->vertexTextures);
+                // Add the info for drawing the textures on the quads. Each quad samples its
+                // glyph's sub-rectangle of the face's atlas texture (quad_uvs is u_left, v_top,
+                // u_right, v_bottom; the quad's vertex order is BL, TL, TR, BR).
+                const morph::vec<float, 4> uv = (qi < this->quad_uvs.size()) ? this->quad_uvs[qi]
+                                                                             : morph::vec<float, 4>{0.0f, 0.0f, 1.0f, 1.0f};
+                this->vertex_push (uv[0], uv[3], 0.0f, this->vertexTextures);
+                this->vertex_push (uv[0], uv[1], 0.0f, this->vertexTextures);
+                this->vertex_push (uv[2], uv[1], 0.0f, this->vertexTextures);
+                this->vertex_push (uv[2], uv[3], 0.0f, this->vertexTextures);
 
                 // All same colours
                 this->vertex_push (this->clr_backing, this->vertexColors);
@@ -299,8 +304,37 @@ namespace morph {
         //! VisualTextModel. setupText should modify these as it sets up quads. Order of
         //! numbers is left, right, bottom, top
         vec<float, 4> extents = { 1e7, -1e7, 1e7, -1e7 };
-        //! The texture ID for each quad - so that we draw the right texture image over each quad.
+        //! The texture ID for each quad - so that we draw the right texture image over each
+        //! quad. With the atlas-based VisualFace, every quad of a face carries the same
+        //! (atlas) texture ID, so the whole text renders with one bind and one draw call.
         std::vector<unsigned int> quad_ids = {};
+        //! Per-quad texture coordinates within the face's glyph atlas, as (u_left, v_top,
+        //! u_right, v_bottom)
+        std::vector<morph::vec<float, 4>> quad_uvs = {};
+        /*!
+         * The per-line cache used by updateText (see the implementation classes): the text of
+         * each line and the glyph quads that were laid out for it. A line whose text has not
+         * changed since the last layout re-uses its cached quads rather than being laid out
+         * again. Cleared by setupText, which always lays out the whole block.
+         */
+        std::vector<std::basic_string<char32_t>> cached_lines = {};
+        std::vector<std::vector<std::array<float, 12>>> cached_line_quads = {};
+        std::vector<std::vector<unsigned int>> cached_line_ids = {};
+        std::vector<std::vector<morph::vec<float, 4>>> cached_line_uvs = {};
+    public:
+        //! Hand over the GL buffer/vertex array ids for batched deletion (see
+        //! VisualModelBase::surrender_gl_ids); the destructor then has no GL work to do.
+        //! Public, as VisualOwnable*::deconstructCommon calls it on each text model.
+        void surrender_gl_ids (std::vector<GLuint>& buf_ids, std::vector<GLuint>& vao_ids)
+        {
+            if (this->vbos != nullptr) {
+                for (unsigned int i = 0; i < numVBO; ++i) { buf_ids.push_back (this->vbos[i]); }
+                this->vbos.reset (nullptr);
+            }
+            if (this->vao != 0) { vao_ids.push_back (this->vao); this->vao = 0; }
+        }
+
+    protected:
         //! Position within vertex buffer object (if I use an array of VBO)
         enum VBOPos { posnVBO, normVBO, colVBO, idxVBO, textureVBO, numVBO };
         //! The OpenGL Vertex Array Object
@@ -310,39 +344,39 @@ namespace morph {
         //! Vertex Buffer Objects stored in an array
         std::unique_ptr<GLuint[]> vbos;
         //! CPU-side data for indices
-        std::vector<GLuint> indices = {};
+        morph::vertex_buffer_t<GLuint> indices = {};
         //! CPU-side data for quad vertex positions
-        std::vector<float> vertexPositions = {};
+        morph::vertex_buffer_t<float> vertexPositions = {};
         //! CPU-side data for quad vertex normals
-        std::vector<float> vertexNormals = {};
+        morph::vertex_buffer_t<float> vertexNormals = {};
         //! CPU-side data for vertex colours
-        std::vector<float> vertexColors = {};
+        morph::vertex_buffer_t<float> vertexColors = {};
         //! data for textures
-        std::vector<float> vertexTextures = {};
+        morph::vertex_buffer_t<float> vertexTextures = {};
         //! A model-wide alpha value for the shader
         float alpha = 1.0f;
         //! If true, then calls to VisualModel::render should return
         bool hide = false;
 
         //! Set up a vertex buffer object - bind, buffer and set vertex array object attribute
-        virtual void setupVBO (GLuint& buf, std::vector<float>& dat, unsigned int bufferAttribPosition) = 0;
+        virtual void setupVBO (GLuint& buf, morph::vertex_buffer_t<float>& dat, unsigned int bufferAttribPosition) = 0;
 
         //! Push three floats onto the vector of floats \a vp
-        void vertex_push (const float& x, const float& y, const float& z, std::vector<float>& vp)
+        void vertex_push (const float& x, const float& y, const float& z, morph::vertex_buffer_t<float>& vp)
         {
             vp.push_back (x);
             vp.push_back (y);
             vp.push_back (z);
         }
         //! Push array of 3 floats onto the vector of floats \a vp
-        void vertex_push (const std::array<float, 3>& arr, std::vector<float>& vp)
+        void vertex_push (const std::array<float, 3>& arr, morph::vertex_buffer_t<float>& vp)
         {
             vp.push_back (arr[0]);
             vp.push_back (arr[1]);
             vp.push_back (arr[2]);
         }
         //! Push morph::vec of 3 floats onto the vector of floats \a vp
-        void vertex_push (const vec<float>& vec, std::vector<float>& vp)
+        void vertex_push (const vec<float>& vec, morph::vertex_buffer_t<float>& vp)
         {
             std::copy (vec.begin(), vec.end(), std::back_inserter (vp));
         }
@@ -64,6 +64,8 @@ namespace morph {
             if (loc_tc != -1) { glUniform3f (loc_tc, this->clr_text[0], this->clr_text[1], this->clr_text[2]); }
             GLint loc_a = glGetUniformLocation (tshaderprog, static_cast<const GLchar*>("alpha"));
             if (loc_a != -1) { glUniform1f (loc_a, this->alpha); }
+            GLint loc_sdf = glGetUniformLocation (tshaderprog, static_cast<const GLchar*>("sdf_text"));
+            if (loc_sdf != -1) { glUniform1f (loc_sdf, this->tfeatures.sdf == true ? 1.0f : 0.0f); }
             GLint loc_v = glGetUniformLocation (tshaderprog, static_cast<const GLchar*>("v_matrix"));
             if (loc_v != -1) { glUniformMatrix4fv (loc_v, 1, GL_FALSE, this->scenematrix.mat.data()); }
             GLint loc_m = glGetUniformLocation (tshaderprog, static_cast<const GLchar*>("m_matrix"));
@@ -74,16 +76,12 @@ namespace morph {
             // It is only necessary to bind the vertex array object before rendering
             glBindVertexArray (this->vao);
 
-            // We have a max of (2^32)-1 characters. Should be enough.
-            for (unsigned int i = 0U; i < this->quads.size(); ++i) {
-                // Bind the right texture for the quad.
-                glBindTexture (GL_TEXTURE_2D, this->quad_ids[i]);
-                // This is 'draw a subset of the elements from the vertex array
-                // object'. You say how many indices to draw and which base *vertex* you
-                // start from. In my scheme, I have 4 vertices for each two triangles
-                // that are constructed. Thus, I draw 6 indices, but increment the base
-                // vertex by 4 for each letter.
-                glDrawElementsBaseVertex (GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, 4*i);
+            // Every glyph quad samples the face's single atlas texture (each quad carries its
+            // glyph's atlas coordinates in its texture vertices), so the whole text is one
+            // texture bind and one draw call.
+            if (this->face != nullptr && !this->indices.empty()) {
+                glBindTexture (GL_TEXTURE_2D, this->face->atlas_textureID);
+                glDrawElements (GL_TRIANGLES, static_cast<GLsizei>(this->indices.size()), GL_UNSIGNED_INT, 0);
             }
 
             glBindVertexArray(0);
@@ -95,43 +93,20 @@ namespace morph {
         //! Compute the geometry for a sample text.
         morph::TextGeometry getTextGeometry (const std::string& _txt) final
         {
-            morph::TextGeometry geom;
-
             if (this->face == nullptr) {
                 this->face = VisualResourcesNoMX<glver>::i().getVisualFace (this->tfeatures, this->parentVis);
             }
-
             // First convert string from ASCII/UTF-8 into Unicode.
-            std::basic_string<char32_t> utxt = morph::unicode::fromUtf8(_txt);
-            for (std::basic_string<char32_t>::const_iterator c = utxt.begin(); c != utxt.end(); c++) {
-                morph::visgl::CharInfo ci = this->face->glchars[*c];
-                float drop = (ci.size.y() - ci.bearing.y()) * this->fontscale;
-                geom.max_drop = (drop > geom.max_drop) ? drop : geom.max_drop;
-                float bearingy = ci.bearing.y() * this->fontscale;
-                geom.max_bearingy = (bearingy > geom.max_bearingy) ? bearingy : geom.max_bearingy;
-                geom.total_advance += ((ci.advance>>6)*this->fontscale);
-            }
-            return geom;
+            return this->scaledTextGeometry (morph::unicode::fromUtf8_cached (_txt));
         }
 
         //! Return the geometry for the stored txt
         morph::TextGeometry getTextGeometry() final
         {
-            morph::TextGeometry geom;
-
             if (this->face == nullptr) {
                 this->face = VisualResourcesNoMX<glver>::i().getVisualFace (this->tfeatures, this->parentVis);
             }
-
-            for (std::basic_string<char32_t>::const_iterator c = this->txt.begin(); c != this->txt.end(); c++) {
-                morph::visgl::CharInfo ci = this->face->glchars[*c];
-                float drop = (ci.size.y() - ci.bearing.y()) * this->fontscale;
-                geom.max_drop = (drop > geom.max_drop) ? drop : geom.max_drop;
-                float bearingy = ci.bearing.y() * this->fontscale;
-                geom.max_bearingy = (bearingy > geom.max_bearingy) ? bearingy : geom.max_bearingy;
-                geom.total_advance += ((ci.advance>>6)*this->fontscale);
-            }
-            return geom;
+            return this->scaledTextGeometry (this->txt);
         }
 
         //! For some reason, I can't place these setupText functions in the base class. Compiler
@@ -164,7 +139,7 @@ namespace morph {
         void setupText (const std::string& _txt)
         {
             // Convert std::string _txt to std::basic_string<uchar32_t> text and call the other setupText
-            this->setupText (morph::unicode::fromUtf8 (_txt));
+            this->setupText (morph::unicode::fromUtf8_cached (_txt));
         }
         //!}
 
@@ -179,6 +154,12 @@ namespace morph {
             // With glyph information from txt, set up this->quads.
             this->quads.clear();
             this->quad_ids.clear();
+            this->quad_uvs.clear();
+            // This is a full layout, so any per-line cache held by updateText is stale
+            this->cached_lines.clear();
+            this->cached_line_quads.clear();
+            this->cached_line_ids.clear();
+            this->cached_line_uvs.clear();
             // Our string of letters starts at this location
             float letter_pos = 0.0f;
             float letter_y = 0.0f;
@@ -188,13 +169,13 @@ namespace morph {
                 if (*c == '\n') {
                     // Skip newline, but add a y offset and reset letter_pos
                     letter_pos = 0.0f;
-                    morph::visgl::CharInfo ch = this->face->glchars['h'];
+                    morph::visgl::CharInfo ch = this->face->getchar ('h');
                     letter_y += this->line_spacing * -ch.size.y() * this->fontscale;
                     continue;
                 }
 
                 // Add a quad to this->quads
-                morph::visgl::CharInfo ci = this->face->glchars[*c];
+                morph::visgl::CharInfo ci = this->face->getchar (*c);
 
                 float xpos = letter_pos + ci.bearing.x() * this->fontscale;
                 float ypos = letter_y /*this->mv_offset[1]*/ - (ci.size.y() - ci.bearing.y()) * this->fontscale;
@@ -225,6 +206,7 @@ namespace morph {
                 }
                 this->quads.push_back (tbox);
                 this->quad_ids.push_back (ci.textureID);
+                this->quad_uvs.push_back (ci.uv);
 
                 // The value in ci.advance has to be divided by 64 to bring it into the
                 // same units as the ci.size and ci.bearing values.
@@ -245,8 +227,241 @@ namespace morph {
             this->postVertexInit();
         }
 
+        /*!
+         * Batch layout: lay out many short texts in this one text model, with text _txts[i]
+         * starting at position _toffsets[i] (positions in the same frame as setupText's
+         * _mv_offset argument - so callers add the parent model's mv_offset, as they do for
+         * setupText). Every text's glyph quads go into a single set of vertex buffers, so a
+         * large set of datum labels costs one draw call, rather than one VisualTextModel -
+         * with its own buffers and draw call - per label.
+         *
+         * The glyphs are fetched (and, on a cache miss, rendered into the GL atlas) serially
+         * first, because VisualFace::getchar may modify the atlas texture and so must run on
+         * the GL thread. The per-glyph quad arithmetic, which is what dominates for tens of
+         * thousands of labels, then runs across threads; it only reads the glyph map.
+         */
+        void setupTexts (const std::vector<std::string>& _txts,
+                         const std::vector<morph::vec<float>>& _toffsets,
+                         std::array<float, 3> _clr = {0,0,0})
+        {
+            this->clr_text = _clr;
+            if (this->face == nullptr) {
+                this->face = VisualResourcesNoMX<glver>::i().getVisualFace (this->tfeatures, this->parentVis);
+            }
+
+            const std::size_t n = _txts.size() < _toffsets.size() ? _txts.size() : _toffsets.size();
+
+            // Convert to unicode and warm the glyph cache. Index labels re-use a handful of
+            // distinct glyphs, so after the first few labels these getchar calls are lookups
+            std::vector<std::basic_string<char32_t>> utxts (n);
+            for (std::size_t i = 0; i < n; ++i) {
+                utxts[i] = morph::unicode::fromUtf8_cached (_txts[i]);
+                for (const char32_t c : utxts[i]) { if (c != U'\n') { this->face->getchar (c); } }
+            }
+            const morph::visgl::CharInfo hch = this->face->getchar ('h');
+            const float line_advance = this->line_spacing * -hch.size.y() * this->fontscale;
+
+            std::vector<std::vector<std::array<float, 12>>> label_quads (n);
+            std::vector<std::vector<unsigned int>> label_ids (n);
+            std::vector<std::vector<morph::vec<float, 4>>> label_uvs (n);
+#pragma omp parallel for
+            for (std::size_t i = 0; i < n; ++i) {
+                float letter_pos = _toffsets[i][0];
+                float letter_y = _toffsets[i][1];
+                float text_epsilon = 0.0f;
+                for (const char32_t c : utxts[i]) {
+                    if (c == U'\n') {
+                        letter_pos = _toffsets[i][0];
+                        letter_y += line_advance;
+                        continue;
+                    }
+                    const morph::visgl::CharInfo& ci = this->face->glchars.at (c);
+                    float xpos = letter_pos + ci.bearing.x() * this->fontscale;
+                    float ypos = letter_y - (ci.size.y() - ci.bearing.y()) * this->fontscale;
+                    float w = ci.size.x() * this->fontscale;
+                    float h = ci.size.y() * this->fontscale;
+                    label_quads[i].push_back ({ xpos,   ypos,   _toffsets[i][2] + text_epsilon,
+                                                xpos,   ypos+h, _toffsets[i][2] + text_epsilon,
+                                                xpos+w, ypos+h, _toffsets[i][2] + text_epsilon,
+                                                xpos+w, ypos,   _toffsets[i][2] + text_epsilon });
+                    text_epsilon -= 10.0f * std::numeric_limits<float>::epsilon();
+                    label_ids[i].push_back (ci.textureID);
+                    label_uvs[i].push_back (ci.uv);
+                    letter_pos += ((ci.advance>>6)*this->fontscale);
+                }
+            }
+
+            // Merge into the usual containers. The per-line cache and txt relate to a single
+            // setupText block, so they are meaningless here
+            this->txt.clear();
+            this->cached_lines.clear();
+            this->cached_line_quads.clear();
+            this->cached_line_ids.clear();
+            this->cached_line_uvs.clear();
+            this->quads.clear();
+            this->quad_ids.clear();
+            this->quad_uvs.clear();
+            std::size_t nq = 0;
+            for (std::size_t i = 0; i < n; ++i) { nq += label_quads[i].size(); }
+            this->quads.reserve (nq);
+            this->quad_ids.reserve (nq);
+            this->quad_uvs.reserve (nq);
+            for (std::size_t i = 0; i < n; ++i) {
+                this->quads.insert (this->quads.end(), label_quads[i].begin(), label_quads[i].end());
+                this->quad_ids.insert (this->quad_ids.end(), label_ids[i].begin(), label_ids[i].end());
+                this->quad_uvs.insert (this->quad_uvs.end(), label_uvs[i].begin(), label_uvs[i].end());
+            }
+            this->extents = { 1e7, -1e7, 1e7, -1e7 };
+            for (const auto& q : this->quads) {
+                if (q[0] < this->extents[0]) { this->extents[0] = q[0]; } // left
+                if (q[6] > this->extents[1]) { this->extents[1] = q[6]; } // right
+                if (q[1] < this->extents[2]) { this->extents[2] = q[1]; } // bottom
+                if (q[4] > this->extents[3]) { this->extents[3] = q[4]; } // top
+            }
+
+            this->vertexPositions.clear();
+            this->vertexNormals.clear();
+            this->vertexColors.clear();
+            this->vertexTextures.clear();
+            this->indices.clear();
+            this->initializeVertices();
+            this->postVertexInit();
+        }
+
+        /*!
+         * Replace the model's text with \a _txt, re-laying-out only those lines that differ
+         * from the current text. Lines are compared against a per-line cache of glyph quads,
+         * so a 40 line status readout in which one line changes per frame costs one line's
+         * worth of glyph lookups, not forty. The whole block remains a single geometry buffer
+         * and a single draw call. Returns false - doing no GL work at all - if the text is
+         * unchanged.
+         */
+        bool updateText (const std::string& _txt)
+        {
+            std::basic_string<char32_t> newtxt = morph::unicode::fromUtf8_cached (_txt);
+            if (newtxt == this->txt) { return false; }
+
+            if (this->face == nullptr) {
+                this->face = VisualResourcesNoMX<glver>::i().getVisualFace (this->tfeatures, this->parentVis);
+            }
+
+            // Split the new text into lines
+            std::vector<std::basic_string<char32_t>> newlines (1);
+            for (const char32_t c : newtxt) {
+                if (c == U'\n') { newlines.emplace_back(); } else { newlines.back() += c; }
+            }
+
+            // Each line sits this far below the previous one (matching setupText)
+            morph::visgl::CharInfo hch = this->face->getchar ('h');
+            const float line_advance = this->line_spacing * -hch.size.y() * this->fontscale;
+
+            // Lay out each line, re-using the cached quads for any line whose text is
+            // unchanged. A line's quads depend only on its text and its vertical position -
+            // which is fixed by its line index - so the cached quads remain valid however the
+            // other lines have changed.
+            std::vector<std::vector<std::array<float, 12>>> line_quads (newlines.size());
+            std::vector<std::vector<unsigned int>> line_ids (newlines.size());
+            std::vector<std::vector<morph::vec<float, 4>>> line_uvs (newlines.size());
+            for (std::size_t i = 0; i < newlines.size(); ++i) {
+                if (i < this->cached_lines.size() && this->cached_lines[i] == newlines[i]) {
+                    line_quads[i] = this->cached_line_quads[i];
+                    line_ids[i] = this->cached_line_ids[i];
+                    line_uvs[i] = this->cached_line_uvs[i];
+                } else {
+                    this->layoutLine (newlines[i], static_cast<float>(i) * line_advance,
+                                      line_quads[i], line_ids[i], line_uvs[i]);
+                }
+            }
+            this->cached_lines = newlines;
+            this->cached_line_quads = line_quads;
+            this->cached_line_ids = line_ids;
+            this->cached_line_uvs = line_uvs;
+            this->txt = newtxt;
+
+            // Concatenate the per-line quads into the usual containers and recompute extents
+            this->quads.clear();
+            this->quad_ids.clear();
+            this->quad_uvs.clear();
+            this->extents = { 1e7, -1e7, 1e7, -1e7 };
+            for (std::size_t i = 0; i < newlines.size(); ++i) {
+                this->quads.insert (this->quads.end(), line_quads[i].begin(), line_quads[i].end());
+                this->quad_ids.insert (this->quad_ids.end(), line_ids[i].begin(), line_ids[i].end());
+                this->quad_uvs.insert (this->quad_uvs.end(), line_uvs[i].begin(), line_uvs[i].end());
+            }
+            for (const auto& q : this->quads) {
+                if (q[0] < this->extents[0]) { this->extents[0] = q[0]; } // left
+                if (q[6] > this->extents[1]) { this->extents[1] = q[6]; } // right
+                if (q[1] < this->extents[2]) { this->extents[2] = q[1]; } // bottom
+                if (q[4] > this->extents[3]) { this->extents[3] = q[4]; } // top
+            }
+
+            // Rebuild and re-upload the vertex buffers
+            this->vertexPositions.clear();
+            this->vertexNormals.clear();
+            this->vertexColors.clear();
+            this->vertexTextures.clear();
+            this->indices.clear();
+            this->initializeVertices();
+            this->postVertexInit();
+            return true;
+        }
+
     protected:
 
+        //! Lay out one line of glyph quads at vertical position \a letter_y, filling the
+        //! per-line containers. The layout matches setupText's, minus the newline handling.
+        //! Used by updateText. The face pointer must be valid before calling.
+        void layoutLine (const std::basic_string<char32_t>& line, const float letter_y,
+                         std::vector<std::array<float, 12>>& lquads,
+                         std::vector<unsigned int>& lids,
+                         std::vector<morph::vec<float, 4>>& luvs)
+        {
+            float letter_pos = 0.0f;
+            float text_epsilon = 0.0f;
+            for (const char32_t c : line) {
+                morph::visgl::CharInfo ci = this->face->getchar (c);
+                float xpos = letter_pos + ci.bearing.x() * this->fontscale;
+                float ypos = letter_y - (ci.size.y() - ci.bearing.y()) * this->fontscale;
+                float w = ci.size.x() * this->fontscale;
+                float h = ci.size.y() * this->fontscale;
+                lquads.push_back ({ xpos,   ypos,     text_epsilon,
+                                    xpos,   ypos+h,   text_epsilon,
+                                    xpos+w, ypos+h,   text_epsilon,
+                                    xpos+w, ypos,     text_epsilon });
+                text_epsilon -= 10.0f * std::numeric_limits<float>::epsilon();
+                lids.push_back (ci.textureID);
+                luvs.push_back (ci.uv);
+                letter_pos += ((ci.advance>>6)*this->fontscale);
+            }
+        }
+
+        /*!
+         * Look up the layout geometry of \a utxt in the face's text_geometry_cache, computing and
+         * caching it (in unscaled font-pixel units) on a miss, then scale it by this model's
+         * fontscale. The face pointer must be valid before calling.
+         */
+        morph::TextGeometry scaledTextGeometry (const std::basic_string<char32_t>& utxt)
+        {
+            auto gci = this->face->text_geometry_cache.find (utxt);
+            if (gci == this->face->text_geometry_cache.end()) {
+                morph::TextGeometry unscaled;
+                for (std::basic_string<char32_t>::const_iterator c = utxt.begin(); c != utxt.end(); c++) {
+                    const morph::visgl::CharInfo& ci = this->face->getchar (*c);
+                    float drop = static_cast<float>(ci.size.y() - ci.bearing.y());
+                    unscaled.max_drop = (drop > unscaled.max_drop) ? drop : unscaled.max_drop;
+                    float bearingy = static_cast<float>(ci.bearing.y());
+                    unscaled.max_bearingy = (bearingy > unscaled.max_bearingy) ? bearingy : unscaled.max_bearingy;
+                    unscaled.total_advance += static_cast<float>(ci.advance >> 6);
+                }
+                gci = this->face->text_geometry_cache.emplace (utxt, unscaled).first;
+            }
+            morph::TextGeometry geom = gci->second;
+            geom.total_advance *= this->fontscale;
+            geom.max_bearingy *= this->fontscale;
+            geom.max_drop *= this->fontscale;
+            return geom;
+        }
+
         //! Common code to call after the vertices have been set up.
         void postVertexInit() final
         {
@@ -285,7 +500,7 @@ namespace morph {
         morph::visgl::VisualFaceNoMX* face = nullptr;
 
         //! Set up a vertex buffer object - bind, buffer and set vertex array object attribute
-        void setupVBO (GLuint& buf, std::vector<float>& dat, unsigned int bufferAttribPosition) final
+        void setupVBO (GLuint& buf, morph::vertex_buffer_t<float>& dat, unsigned int bufferAttribPosition) final
         {
             std::size_t sz = dat.size() * sizeof(float);
             glBindBuffer (GL_ARRAY_BUFFER, buf);
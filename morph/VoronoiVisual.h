@@ -22,8 +22,7 @@
 #include <map>
 #include <set>
 
-#define JC_VORONOI_IMPLEMENTATION
-#include <morph/jcvoronoi/jc_voronoi.h>
+#include <morph/voronoi.h>
 
 namespace morph {
 
@@ -109,7 +108,7 @@ namespace morph {
                 jcv_point{rx.min - this->border_width, ry.min - this->border_width, 0.0f},
                 jcv_point{rx.max + this->border_width, ry.max + this->border_width, 0.0f}
             };
-            jcv_diagram_generate (ncoords, this->dcoords_ptr->data(), &domain, 0, &diagram);
+            morph::voronoi_generate (ncoords, this->dcoords_ptr->data(), &domain, this->varena, &diagram);
 
             // We obtain access the the Voronoi cell sites:
             const jcv_site* sites = jcv_diagram_get_sites (&diagram);
@@ -323,9 +322,64 @@ namespace morph {
             }
 
             // At end free the Voronoi diagram memory
+            if (this->incremental == true && this->data_z_direction == this->uz) {
+                this->cache_cells (sites, diagram.numsites);
+            } else {
+                this->cells_cached = false;
+            }
             jcv_diagram_free (&diagram);
         }
 
+        //! Update just the colours from new scalar data, leaving the tessellation untouched.
+        //! See reinitColours.
+        void updateColours (const std::vector<F>* _data) override
+        {
+            this->scalarData = _data;
+            unsigned int ncoords = this->dataCoords == nullptr ? 0 : this->dataCoords->size();
+            if (ncoords == 0 || this->triangle_counts.size() != ncoords
+                || this->scalarData == nullptr || this->scalarData->size() != ncoords) {
+                this->reinit();
+                return;
+            }
+            this->reinitColours();
+        }
+
+        //! In incremental mode, new scalar data with unchanged coordinates means the sorted site
+        //! structure (and hence the tessellation) is unchanged; only the colours need recomputing.
+        void updateData (const std::vector<F>* _data) override
+        {
+            if (this->incremental == true) {
+                this->updateColours (_data);
+            } else {
+                VisualDataModel<F, glver>::updateData (_data);
+            }
+        }
+
+        void updateData (std::vector<vec<float>>* _coords, const std::vector<F>* _data,
+                         const scale<F, float>& zscale) override
+        {
+            this->dataCoords = _coords;
+            this->scalarData = _data;
+            this->zScale = zscale;
+            if (this->incremental == false || this->update_cells() == false) { this->reinit(); }
+        }
+
+        void updateData (std::vector<vec<float>>* _coords, const std::vector<F>* _data,
+                         const scale<F, float>& zscale, const scale<F, float>& cscale) override
+        {
+            this->dataCoords = _coords;
+            this->scalarData = _data;
+            this->zScale = zscale;
+            this->colourScale = cscale;
+            if (this->incremental == false || this->update_cells() == false) { this->reinit(); }
+        }
+
+        void updateCoords (std::vector<vec<float>>* _coords) override
+        {
+            this->dataCoords = _coords;
+            if (this->incremental == false || this->update_cells() == false) { this->reinit(); }
+        }
+
         void reinitColoursScalar()
         {
             if (this->colourScale.do_autoscale == true) { this->colourScale.reset(); }
@@ -405,6 +459,18 @@ namespace morph {
         //! Zoom in? To zoom in (make bigger) choose a value >1
         float zoom = 1.0f;
 
+        /*!
+         * If true, updateData()/updateCoords() attempt an incremental update of the model. When
+         * the coordinates are unchanged, the existing tessellation is kept and only the colours
+         * are recomputed. When some coordinates have moved, the Voronoi diagram is regenerated,
+         * but triangles are recomputed only for the cells whose geometry can actually have
+         * changed (the moved sites, plus their old and new Delaunay neighbours); all other cells'
+         * vertices are left in place. Falls back to a full rebuild whenever the update can't be
+         * done in place (first render, changed site count, a changed cell gaining or losing an
+         * edge, a rotated view via data_z_direction, or any of the debug draw options).
+         */
+        bool incremental = false;
+
         //! If true, show 2.5D Voronoi edges
         bool debug_edges = false;
         //! If true, show 2D Voronoi edges
@@ -529,6 +595,250 @@ namespace morph {
             this->indices.push_back (this->idx++);
         }
 
+        //! Rewrite triangle number @tri of the model in place. The in-place counterpart of
+        //! computeTriangle, used by update_cells().
+        void updateTriangle (const unsigned int tri, vec<float> c1, vec<float> c2, vec<float> c3,
+                             const std::array<float, 3>& colr)
+        {
+            c1 *= this->zoom;
+            c2 *= this->zoom;
+            c3 *= this->zoom;
+            vec<float> u1 = c1-c2;
+            vec<float> u2 = c2-c3;
+            vec<float> v = u1.cross(u2);
+            v.renormalize();
+            std::size_t f = static_cast<std::size_t>(tri) * 9u; // 3 floats per vtx, 3 vtxs per tri
+            const vec<float>* corners[3] = { &c1, &c2, &c3 };
+            for (unsigned int i = 0; i < 3U; ++i) {
+                for (unsigned int j = 0; j < 3U; ++j) {
+                    this->vertexPositions[f + 3u * i + j] = (*corners[i])[j];
+                    this->vertexNormals[f + 3u * i + j] = v[j];
+                    this->vertexColors[f + 3u * i + j] = colr[j];
+                }
+            }
+        }
+
+        //! Record what update_cells() needs to match cells between rebuilds: the coordinates that
+        //! were tessellated, each cell's Delaunay neighbours and each cell's (fixed) slot in the
+        //! vertex arrays. Called at the end of a full initializeVertices() pass.
+        void cache_cells (const jcv_site* sites, const int numsites)
+        {
+            unsigned int ncoords = static_cast<unsigned int>(numsites);
+            this->prev_coords = *this->dcoords_ptr;
+            this->cell_neighbours.assign (ncoords, std::vector<unsigned int>());
+            this->cell_first_tri.assign (ncoords, 0);
+            this->cell_tri_count.assign (ncoords, 0);
+            unsigned int tri = 0;
+            for (int i = 0; i < numsites; ++i) {
+                const jcv_site* site = &sites[i];
+                unsigned int ntri = 0;
+                for (const jcv_graphedge* e = site->edges; e != nullptr; e = e->next) {
+                    for (unsigned int j = 0; j < 2; ++j) {
+                        if (e->edge->sites[j] && e->edge->sites[j]->index != site->index) {
+                            this->cell_neighbours[site->index].push_back (e->edge->sites[j]->index);
+                        }
+                    }
+                    ++ntri;
+                }
+                this->cell_first_tri[site->index] = tri;
+                this->cell_tri_count[site->index] = ntri;
+                tri += ntri;
+            }
+            this->cells_cached = true;
+        }
+
+        //! Attempt an incremental update of the tessellation (see the incremental flag). Return
+        //! false if a full rebuild is required instead.
+        bool update_cells()
+        {
+            unsigned int ncoords = this->dataCoords == nullptr ? 0 : this->dataCoords->size();
+            unsigned int ndata = this->scalarData == nullptr ? 0 : this->scalarData->size();
+            unsigned int nvdata = this->vectorData == nullptr ? 0 : this->vectorData->size();
+            if (this->cells_cached == false || ncoords == 0 || this->prev_coords.size() != ncoords
+                || (ndata == 0 && nvdata == 0)
+                || (ndata > 0 && ndata != ncoords) || (nvdata > 0 && nvdata != ncoords)
+                || this->data_z_direction != this->uz
+                || this->debug_edges == true || this->show_voronoi2d == true
+                || this->debug_dataCoords == true || this->labelIndices == true) {
+                return false;
+            }
+
+            // Which sites have moved since the last (re)build?
+            std::vector<bool> moved (ncoords, false);
+            bool any_moved = false;
+            for (unsigned int i = 0; i < ncoords; ++i) {
+                if ((*this->dataCoords)[i] != this->prev_coords[i]) {
+                    moved[i] = true;
+                    any_moved = true;
+                }
+            }
+            if (any_moved == false) {
+                // The sorted site structure and hence the tessellation are unchanged; only the
+                // colours need recomputing.
+                this->reinitColours();
+                return true;
+            }
+
+            this->setupScaling (ncoords); // refresh dcolour etc. for setColour()
+
+            // Regenerate the 2D Voronoi diagram, exactly as initializeVertices does
+            morph::range<float> rx, ry;
+            rx.search_init();
+            ry.search_init();
+            for (unsigned int i = 0; i < ncoords; ++i) {
+                rx.update ((*this->dataCoords)[i][0]);
+                ry.update ((*this->dataCoords)[i][1]);
+            }
+            jcv_diagram diagram;
+            std::memset (&diagram, 0, sizeof(jcv_diagram));
+            jcv_rect domain = {
+                jcv_point{rx.min - this->border_width, ry.min - this->border_width, 0.0f},
+                jcv_point{rx.max + this->border_width, ry.max + this->border_width, 0.0f}
+            };
+            morph::voronoi_generate (ncoords, this->dataCoords->data(), &domain, this->varena, &diagram);
+            const jcv_site* sites = jcv_diagram_get_sites (&diagram);
+            if (static_cast<unsigned int>(diagram.numsites) != ncoords) {
+                jcv_diagram_free (&diagram);
+                return false;
+            }
+
+            // The new Delaunay neighbour lists
+            std::vector<std::vector<unsigned int>> nbrs (ncoords);
+            for (int i = 0; i < diagram.numsites; ++i) {
+                const jcv_site* site = &sites[i];
+                for (const jcv_graphedge* e = site->edges; e != nullptr; e = e->next) {
+                    for (unsigned int j = 0; j < 2; ++j) {
+                        if (e->edge->sites[j] && e->edge->sites[j]->index != site->index) {
+                            nbrs[site->index].push_back (e->edge->sites[j]->index);
+                        }
+                    }
+                }
+            }
+
+            // A cell's geometry may have changed if its own site moved, or if any of its old or
+            // new neighbours moved
+            std::vector<bool> changed (ncoords, false);
+            for (unsigned int i = 0; i < ncoords; ++i) {
+                changed[i] = moved[i];
+                if (changed[i] == false) {
+                    for (auto nb : nbrs[i]) { if (moved[nb]) { changed[i] = true; break; } }
+                }
+                if (changed[i] == false) {
+                    for (auto nb : this->cell_neighbours[i]) { if (moved[nb]) { changed[i] = true; break; } }
+                }
+            }
+
+            // An in-place rewrite needs each changed cell to keep its triangle count
+            for (int i = 0; i < diagram.numsites; ++i) {
+                const jcv_site* site = &sites[i];
+                if (changed[site->index] == false) { continue; }
+                unsigned int ntri = 0;
+                for (const jcv_graphedge* e = site->edges; e != nullptr; e = e->next) { ++ntri; }
+                if (ntri != this->cell_tri_count[site->index]) {
+                    jcv_diagram_free (&diagram);
+                    return false;
+                }
+            }
+
+            // The z value at a Voronoi vertex is a mean over all the cells adjacent to that
+            // vertex, so the z re-assignment maps must take contributions from two rings of
+            // neighbours around the changed cells
+            std::vector<bool> affected (changed);
+            for (unsigned int ring = 0; ring < 2; ++ring) {
+                std::vector<bool> next_ring (affected);
+                for (unsigned int i = 0; i < ncoords; ++i) {
+                    if (affected[i] == true) {
+                        for (auto nb : nbrs[i]) { next_ring[nb] = true; }
+                    }
+                }
+                affected.swap (next_ring);
+            }
+
+            // Re-assign edge z values, as in initializeVertices, but only clustering cell
+            // centres around the affected cells' edge ends
+            std::map<morph::vec<float, 3>, std::set<morph::vec<float, 3>, veccmp>, veccmp> edge_pos_centres;
+            std::map<morph::vec<float, 3>, float, veccmp> edge_end_zsums;
+            for (int i = 0; i < diagram.numsites; ++i) {
+                const jcv_site* site = &sites[i];
+                if (affected[site->index] == false) { continue; }
+                jcv_graphedge* edge_first = site->edges;
+                jcv_graphedge* edge_1 = edge_first;
+                jcv_graphedge* edge_2 = edge_first;
+                jcv_graphedge* edge_0 = edge_first;
+                while (edge_0->next) { edge_0 = edge_0->next; }
+                while (edge_1) {
+                    edge_1->pos[0][2] = jcv_real{0};
+                    edge_1->pos[1][2] = jcv_real{0};
+                    edge_2 = edge_1->next ? edge_1->next : edge_first;
+                    for (unsigned int j = 0; j < 2; ++j) {
+                        if (edge_1->edge->sites[j]) {
+                            edge_pos_centres[edge_1->pos[1]].insert (edge_1->edge->sites[j]->p);
+                            edge_pos_centres[edge_1->pos[0]].insert (edge_1->edge->sites[j]->p);
+                        }
+                        if (edge_2->edge->sites[j]) {
+                            edge_pos_centres[edge_1->pos[1]].insert (edge_2->edge->sites[j]->p);
+                        }
+                        if (edge_0->edge->sites[j]) {
+                            edge_pos_centres[edge_1->pos[0]].insert (edge_0->edge->sites[j]->p);
+                        }
+                    }
+                    edge_0 = edge_1;
+                    edge_1 = edge_1->next;
+                }
+            }
+            for (auto epc : edge_pos_centres) {
+                float zsum = 0.0f;
+                for (auto cce : epc.second) { zsum += cce[2]; }
+                edge_end_zsums[epc.first] = zsum / epc.second.size();
+            }
+            for (int i = 0; i < diagram.numsites; ++i) {
+                const jcv_site* site = &sites[i];
+                if (changed[site->index] == false) { continue; }
+                jcv_graphedge* edge_1 = site->edges;
+                while (edge_1) {
+                    edge_1->pos[0][2] = edge_end_zsums[edge_1->pos[0]];
+                    edge_1->pos[1][2] = edge_end_zsums[edge_1->pos[1]];
+                    edge_1 = edge_1->next;
+                }
+            }
+
+            // Re-tessellate only the changed cells, writing into their existing vertex slots
+            for (int i = 0; i < diagram.numsites; ++i) {
+                const jcv_site* site = &sites[i];
+                if (changed[site->index] == false) { continue; }
+                unsigned int tri = this->cell_first_tri[site->index];
+                for (const jcv_graphedge* e = site->edges; e != nullptr; e = e->next) {
+                    this->updateTriangle (tri++, site->p, e->pos[0], e->pos[1], this->setColour (site->index));
+                }
+            }
+
+            // The cells keep their slots in the vertex arrays, so only the coordinates and
+            // neighbour lists need re-caching
+            this->prev_coords = *this->dataCoords;
+            this->cell_neighbours.swap (nbrs);
+            jcv_diagram_free (&diagram);
+
+            // Upload the updated buffers, then refresh all the cell colours (the data may have
+            // changed along with the coordinates)
+            this->reinit_buffers();
+            this->reinitColours();
+            return true;
+        }
+
+        //! Reusable memory for diagram generation; retained between rebuilds (see morph/voronoi.h)
+        morph::voronoi_arena varena;
+
+        //! True when cache_cells() has recorded the state that update_cells() needs
+        bool cells_cached = false;
+        //! The coordinates that were last tessellated
+        std::vector<morph::vec<float>> prev_coords;
+        //! For each data index, the data indices of the cell's Delaunay neighbours
+        std::vector<std::vector<unsigned int>> cell_neighbours;
+        //! For each data index, the cell's first triangle in the vertex arrays
+        std::vector<unsigned int> cell_first_tri;
+        //! For each data index, the cell's triangle count
+        std::vector<unsigned int> cell_tri_count;
+
         //! Have to record the number of triangles in each cell in order to update the colours
         morph::vvec<unsigned int> triangle_counts;
         //! Record the data index for each Voronoi cell index
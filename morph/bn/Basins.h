@@ -12,7 +12,11 @@
 #include <map>
 #include <set>
 #include <vector>
+#include <array>
+#include <thread>
+#include <atomic>
 #include <cstddef>
+#include <morph/bn/GeneNet.h>
 
 namespace morph {
     namespace bn {
@@ -45,7 +49,7 @@ namespace morph {
             //! maps of StateNodes.
             state_t id;
             //! The parents of the base node, which feed into it.
-            set<state_t> parents;
+            std::set<state_t> parents;
             //! the child StateNode
             state_t child;
         };
@@ -74,30 +78,32 @@ namespace morph {
                     ++mi;
                 }
                 // THEN add any states in other.nodes that don't exist in this.
-                map<state_t, StateNode>::const_iterator cmi = other.nodes.begin();
+                std::map<state_t, StateNode>::const_iterator cmi = other.nodes.begin();
                 while (cmi != other.nodes.end()) {
                     // cmi->first is the state_t id of a node in the other basin of
                     // attraction.
                     if (this->nodes.count (cmi->first) == 0) {
-                        this->nodes.insert (make_pair(cmi->first, cmi->second));
+                        this->nodes.insert (std::make_pair(cmi->first, cmi->second));
                     }
                     ++cmi;
                 }
                 // ("After merge, this->nodes.size() = " << this->nodes.size());
             }
 
-            //! An "output for debugging" method
+            //! An "output for debugging" method. Template args give the network
+            //! dimensions, for state string formatting.
+            template <std::size_t N, std::size_t K = N>
             void debug() const
             {
                 std::cout << "----------------------Basin-output-begin---------------------------" << std::endl;
                 std::cout << "Basin of attraction with the attractor:" << std::endl;
                 std::set<state_t>::const_iterator si = this->limitCycle.begin();
                 while (si != this->limitCycle.end()) {
-                    std::cout << "  " << state_str (*si) << std::endl;
+                    std::cout << "  " << GeneNet<N,K>::state_str (*si) << std::endl;
                     si++;
                 }
                 std::cout << "Branches:" << std::endl;
-                map<state_t, StateNode>::const_iterator mi = this->nodes.begin();
+                std::map<state_t, StateNode>::const_iterator mi = this->nodes.begin();
                 while (mi != this->nodes.end()) {
                     if (mi->second.parents.empty()) {
                         // Then this is an "outer node" on the basin. Show
@@ -105,14 +111,14 @@ namespace morph {
                         state_t state = mi->first;
                         StateNode sn = mi->second;
                         while (this->limitCycle.count(state) == 0) {
-                            std::cout << " --> " << state_str (state) << "(" << (unsigned int)state << ")";
+                            std::cout << " --> " << GeneNet<N,K>::state_str (state) << "(" << (unsigned int)state << ")";
                             state = sn.child;
                             sn = this->nodes.at (state);
                         }
-                        set<state_t>::const_iterator si = this->limitCycle.begin();
+                        std::set<state_t>::const_iterator si = this->limitCycle.begin();
                         std::cout << " -->* ";
                         while (si != this->limitCycle.end()) {
-                            std::cout << state_str (*si) << "("<< (unsigned int)state << "):";
+                            std::cout << GeneNet<N,K>::state_str (*si) << "("<< (unsigned int)state << "):";
                             ++si;
                         }
                         std::cout << std::endl;
@@ -124,7 +130,7 @@ namespace morph {
                 std::cout << "Transitions in basin:" << std::endl;
                 mi = this->nodes.begin();
                 while (mi != this->nodes.end()) {
-                    std::cout << state_str(mi->second.id) << " --> " << state_str(mi->second.child) << std::endl;
+                    std::cout << GeneNet<N,K>::state_str(mi->second.id) << " --> " << GeneNet<N,K>::state_str(mi->second.child) << std::endl;
                     ++mi;
                 }
                 std::cout << "-----------------------Basin-output-end----------------------------" << std::endl;
@@ -149,6 +155,9 @@ namespace morph {
             //! Is the endpoint type a fixed attractor or a limit cycle?
             morph::bn::endpoint endpoint = endpoint::unknown;
 
+            //! General purpose flags (ORed together when basins are merged)
+            unsigned int flags = 0x0;
+
             /*!
              * The set of states in the limit cycle. Will be a set of size 1 if endpoint
              * is a fixed point attractor. This is used to determine if one partially
@@ -161,6 +170,118 @@ namespace morph {
             std::map<state_t, StateNode> nodes;
         };
 
+        //! The statistics of one basin of attraction, as computed by BasinFinder.
+        struct BasinStats
+        {
+            //! The smallest state on the attractor; the attractor's canonical identifier
+            state_t attractor_min = state_t_unset;
+            //! The number of states on the attractor (1 for a point attractor)
+            unsigned int attractor_length = 0;
+            //! The number of states whose trajectories end on this attractor
+            unsigned int basin_size = 0;
+        };
+
+        /*!
+         * A parallel basin-of-attraction enumerator. Where AllBasins builds the full
+         * state graph of each basin (parents, children, transitions), BasinFinder
+         * computes just the basin *statistics* - how many basins there are, the length
+         * of each attractor and the size of each basin - but does so across threads.
+         * The 2^N state space is partitioned between the threads; each thread follows
+         * its states' trajectories using Brent's cycle detection algorithm, which needs
+         * only two state variables rather than a visited set, and each basin's
+         * statistics are merged with atomic counters, so the threads never lock.
+         */
+        template <std::size_t N=5, std::size_t K=N>
+        struct BasinFinder
+        {
+            //! The number of states in the state space
+            static constexpr unsigned int n_states = (1u << N);
+
+            /*!
+             * Brent's algorithm. Follow the trajectory from state \a s to its
+             * attractor, returning the attractor's length and placing one state that
+             * lies on the attractor in \a on_cycle. O(1) memory; about two develops per
+             * trajectory step.
+             */
+            static unsigned int brent (const Genome<N,K>& genome, const state_t s, state_t& on_cycle)
+            {
+                state_t tortoise = s;
+                state_t hare = s;
+                GeneNet<N,K>::develop (hare, genome);
+                unsigned int power = 1;
+                unsigned int lam = 1;
+                while (tortoise != hare) {
+                    if (power == lam) { // time to start a new power of two
+                        tortoise = hare;
+                        power *= 2;
+                        lam = 0;
+                    }
+                    GeneNet<N,K>::develop (hare, genome);
+                    ++lam;
+                }
+                // The search terminates once both pointers are on the cycle
+                on_cycle = hare;
+                return lam;
+            }
+
+            /*!
+             * Enumerate the basins of attraction of \a genome in parallel with \a
+             * n_threads threads (0 means 'use hardware_concurrency') and return the
+             * statistics of each basin, ordered by the attractor's canonical (minimum)
+             * state. The basin_size fields sum to 2^N.
+             */
+            static std::vector<BasinStats> find (const Genome<N,K>& genome, unsigned int n_threads = 0)
+            {
+                // Per-attractor counters, indexed by the attractor's canonical state
+                std::array<std::atomic<unsigned int>, n_states> basin_counts{};
+                std::array<std::atomic<unsigned int>, n_states> attr_lengths{};
+
+                unsigned int nt = n_threads > 0 ? n_threads : std::thread::hardware_concurrency();
+                if (nt < 1) { nt = 1; }
+                if (nt > n_states) { nt = n_states; }
+
+                // Each thread processes the states s for which s % nt == t
+                auto worker = [&genome, &basin_counts, &attr_lengths, nt] (unsigned int t) {
+                    for (unsigned int s = t; s < n_states; s += nt) {
+                        state_t on_cycle = state_t_unset;
+                        unsigned int lam = BasinFinder<N,K>::brent (genome, static_cast<state_t>(s), on_cycle);
+                        // Identify the attractor by its minimum state, found by going
+                        // around the cycle once
+                        state_t mn = on_cycle;
+                        state_t lc = on_cycle;
+                        for (unsigned int i = 1; i < lam; ++i) {
+                            GeneNet<N,K>::develop (lc, genome);
+                            mn = lc < mn ? lc : mn;
+                        }
+                        basin_counts[mn].fetch_add (1, std::memory_order_relaxed);
+                        attr_lengths[mn].store (lam, std::memory_order_relaxed);
+                    }
+                };
+
+                if (nt == 1) {
+                    worker (0);
+                } else {
+                    std::vector<std::thread> threads;
+                    threads.reserve (nt);
+                    for (unsigned int t = 0; t < nt; ++t) { threads.emplace_back (worker, t); }
+                    for (auto& th : threads) { th.join(); }
+                }
+
+                // Collect the populated counters into the result
+                std::vector<BasinStats> stats;
+                for (unsigned int s = 0; s < n_states; ++s) {
+                    if (basin_counts[s].load (std::memory_order_relaxed) > 0) {
+                        BasinStats bs;
+                        bs.attractor_min = static_cast<state_t>(s);
+                        bs.attractor_length = attr_lengths[s].load (std::memory_order_relaxed);
+                        bs.basin_size = basin_counts[s].load (std::memory_order_relaxed);
+                        stats.push_back (bs);
+                    }
+                }
+                return stats;
+            }
+        };
+
         /*!
          * Container class to hold several basins of attraction for a particular genome
          * and some information that can be obtained from them.
@@ -179,7 +300,7 @@ namespace morph {
                 this->basins.clear();
                 this->attractorSizes.clear();
                 this->transitions.clear();
-                find_basins_of_attraction (this->genome, this->basins);
+                this->find_basins_of_attraction();
                 std::vector<BasinOfAttraction>::const_iterator i = this->basins.begin();
                 while (i != basins.end()) {
                     std::set<unsigned int> tset = i->getTransitionSet();
@@ -215,13 +336,10 @@ namespace morph {
                     state_t next_st = state_t_unset;
                     state_t last_st = state_t_unset;
 
-                    unsigned int saw_flags = 0x0;
-
                     for (;;) {
                         // For the current state, st, compute what the next state will be.
                         next_st = st;
-                        // Becomes.. GeneNet.develop()
-                        compute_next (genome, next_st);
+                        GeneNet<N,K>::develop (next_st, genome);
 
                         // Create state node
                         StateNode stnode(st); // node for current state.
@@ -266,7 +384,7 @@ namespace morph {
                         }
 
                         // Insert it into basin
-                        basin.nodes.insert (make_pair (st, stnode));
+                        basin.nodes.insert (std::make_pair (st, stnode));
                         // ("Inserting " << state_str (st));
 
                         // Update last_st and st
@@ -276,7 +394,7 @@ namespace morph {
 
                     // Now see if our basin is already present in basins, and if not, simply push_back.
                     bool found = false;
-                    bi = thish->basins.begin();
+                    bi = this->basins.begin();
                     while (bi != this->basins.end()) {
                         // Nice thing with sets is that we can directly compare them.
                         if (basin.limitCycle == bi->limitCycle) {
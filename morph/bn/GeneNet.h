@@ -16,7 +16,8 @@
 #include <bitset>
 #include <list>
 #include <cstddef>
-#include <immintrin.h> // Using intrinsics for computing Hamming distances
+#include <cstdint>
+#include <bit> // std::popcount for computing Hamming distances
 #include <morph/bn/Genome.h>
 
 namespace morph {
@@ -227,6 +228,81 @@ namespace morph {
                 }
             }
 
+            /*!
+             * The word type for the bit-sliced methods. Each of the 64 bit 'lanes' of a
+             * state64_t belongs to a different network instance.
+             */
+            typedef std::uint64_t state64_t;
+
+            /*!
+             * Pack 64 states into bit-sliced planes. Plane b holds, across its 64
+             * lanes, bit b of each instance's state (so plane N-1 is Gene a, the MSB,
+             * and plane 0 is the LSB gene).
+             */
+            static std::array<state64_t, N> pack64 (const std::array<state_t, 64>& states)
+            {
+                std::array<state64_t, N> planes;
+                planes.fill (state64_t{0});
+                for (unsigned int l = 0; l < 64; ++l) {
+                    for (unsigned int b = 0; b < N; ++b) {
+                        planes[b] |= static_cast<state64_t>((states[l] >> b) & 0x1) << l;
+                    }
+                }
+                return planes;
+            }
+
+            //! Unpack bit-sliced planes (as made by pack64) back into 64 states.
+            static std::array<state_t, 64> unpack64 (const std::array<state64_t, N>& planes)
+            {
+                std::array<state_t, 64> states;
+                states.fill (state_t{0});
+                for (unsigned int l = 0; l < 64; ++l) {
+                    for (unsigned int b = 0; b < N; ++b) {
+                        states[l] |= static_cast<state_t>((planes[b] >> l) & 0x1) << b;
+                    }
+                }
+                return states;
+            }
+
+            /*!
+             * The bit-sliced, word-parallel version of develop(). Advances 64 network
+             * instances by one synchronous update with bitwise operations on the
+             * packed state planes, exactly as develop() would advance each instance
+             * individually.
+             *
+             * For gene i, input bit j is state bit ((j-i) mod N) - the bit-sliced
+             * analogue of the rotation performed by setup_inputs(). The 2^K row truth
+             * table (genome section) for the gene is then evaluated across all 64
+             * lanes at once by repeatedly multiplexing its halves on each input plane
+             * in turn, leaving the lane-wise output in the final remaining word.
+             */
+            static void develop64 (std::array<state64_t, N>& planes, const Genome<N, K>& genome)
+            {
+                static_assert (random_wiring == false);
+                std::array<state64_t, N> next;
+                for (unsigned int i = 0; i < N; ++i) {
+                    // Initialise one word per truth table row; ~0 where genome[i] has the row bit set
+                    genosect_t gs = genome[i];
+                    std::array<state64_t, (std::size_t{1} << K)> tbl;
+                    for (std::size_t r = 0; r < (std::size_t{1} << K); ++r) {
+                        tbl[r] = ((gs >> r) & 0x1) ? ~state64_t{0} : state64_t{0};
+                    }
+                    // Fold the table on each input plane. Rows 2r and 2r+1 differ only
+                    // in input bit j, so after each pass, half as many rows remain.
+                    std::size_t rows = (std::size_t{1} << K);
+                    for (unsigned int j = 0; j < K; ++j) {
+                        const state64_t inp = planes[(j + N - i) % N];
+                        rows >>= 1;
+                        for (std::size_t r = 0; r < rows; ++r) {
+                            tbl[r] = (tbl[2*r] & ~inp) | (tbl[2*r + 1] & inp);
+                        }
+                    }
+                    // As in develop(), gene i's output is state bit N-i-1
+                    next[N-i-1] = tbl[0];
+                }
+                planes = next;
+            }
+
             //! Generate string representation of an input, showing the input bits that
             //! are ignored with 'X'
             static std::string input_str (const state_t& _input)
@@ -391,12 +467,11 @@ namespace morph {
                 return state;
             }
 
-            //! Computes the Hamming distance between this->state and target.
+            //! Computes the Hamming distance between this->state and target - i.e. a
+            //! count of the bits of state which mismatch the target, via one popcount.
             static state_t hamming (state_t state, state_t target)
             {
-                // For this very short type, a lookup is probably faster than this intrinsic:
-                state_t bits = state ^ target;
-                unsigned int hamming = _mm_popcnt_u32 ((unsigned int)bits);
+                unsigned int hamming = static_cast<unsigned int>(std::popcount (static_cast<state_t>(state ^ target)));
                 return static_cast<state_t>(hamming);
             }
 
@@ -9,11 +9,11 @@
 
 #include <array>
 #include <list>
+#include <bit>
 #include <bitset>
 #include <iostream>
 #include <sstream>
 #include <cstddef>
-#include <immintrin.h>
 #include <morph/tools.h>
 #include <morph/bn/Random.h>
 #include <morph/bn/Genosect.h>
@@ -259,23 +259,14 @@ namespace morph {
                 (*this)[sect] ^= (genosect_t{1} << sectidx);
             }
 
-            //! Compute Hamming distance between this genome and another (g2).
+            //! Compute Hamming distance between this genome and another (g2). One
+            //! popcount per genosect word (std::popcount emits the POPCNT
+            //! instruction); no per-bit work.
             unsigned int hamming (const morph::bn::Genome<N,K>& g2) const
             {
                 unsigned int hamming = 0;
                 for (unsigned int i = 0; i < N; ++i) {
-                    genosect_t bits = (*this)[i] ^ g2[i]; // XOR
-                    // Compile time-selection of the correct population count intrinsic
-                    if constexpr (sizeof(genosect_t) == 1) {
-                        hamming += _mm_popcnt_u32 ((unsigned int)bits);
-                    } else if constexpr (sizeof(genosect_t) == 2) {
-                        hamming += _mm_popcnt_u32 ((unsigned int)bits);
-                    } else if constexpr (sizeof(genosect_t) == 4) {
-                        hamming += _mm_popcnt_u32 ((unsigned int)bits);
-                        // _mm_popcnt_u32 is __popcnt() on AMD, but the above should be binary compatible
-                    } else { // } else if constexpr (sizeof(genosect_t) == 8) {
-                        hamming += _mm_popcnt_u64 ((unsigned long long int)bits);
-                    }
+                    hamming += static_cast<unsigned int>(std::popcount (static_cast<genosect_t>((*this)[i] ^ g2[i])));
                 }
                 return hamming;
             }
@@ -367,14 +358,13 @@ namespace morph {
                 return canal;
             }
 
-            //! Compute the bias; the proportion of set bits in the genome.
+            //! Compute the bias; the proportion of set bits in the genome. One
+            //! popcount per genosect word.
             float bias() const
             {
                 unsigned int bits = 0;
                 for (unsigned int i = 0; i < N; ++i) {
-                    for (unsigned int j = 0; j < (0x1 << N); ++j) {
-                        bits += (((*this)[i] >> j) & 0x1) ? 1 : 0;
-                    }
+                    bits += static_cast<unsigned int>(std::popcount (static_cast<genosect_t>((*this)[i] & this->genosect_mask)));
                 }
                 return (float)bits/(float)(N*(1<<N));
             }
@@ -73,7 +73,7 @@ namespace morph {
                 int bit = 1 << this->vars, lit = 0;
                 std::ostringstream ss;
                 if (fin) {
-                    ss << right << setw(16);
+                    ss << std::right << std::setw(16);
                 }
                 while (bit >>= 1) {
                     if (!(this->mask & bit)) {
@@ -82,7 +82,7 @@ namespace morph {
                     ++lit;
                 }
                 if (pr) {
-                    ss << '\t' << setw(16) << left << this->minterms << ' ' << this->bits << '\t' << this->ones;
+                    ss << '\t' << std::setw(16) << std::left << this->minterms << ' ' << this->bits << '\t' << this->ones;
                 }
                 return ss.str();
             }
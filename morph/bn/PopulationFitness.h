@@ -0,0 +1,138 @@
+/*
+ * Multi-threaded fitness evaluation for a population of Boolean gene network Genomes.
+ *
+ * Author: Seb James
+ * Date: August 2026
+ */
+
+#pragma once
+
+#include <vector>
+#include <array>
+#include <thread>
+#include <atomic>
+#include <cstddef>
+#include <morph/bn/Genome.h>
+#include <morph/bn/GeneNetDual.h>
+
+namespace morph {
+    namespace  bn {
+
+        /*!
+         * A population fitness evaluation engine. Evolutionary loops (see
+         * tests/testEvolve.cpp) evaluate one Genome at a time, but the fitness of each
+         * Genome is independent of every other, so a whole population can be scored in
+         * parallel. Each worker thread owns its own GeneNetDual (fitness evaluation is
+         * deterministic - no random numbers are drawn - so no per-thread bn::Random
+         * state is required) and the threads claim genomes from a shared atomic
+         * counter, writing each fitness into its own slot of the preallocated result
+         * vector; there are no locks.
+         */
+        template <std::size_t N=5, std::size_t K=5>
+        struct PopulationFitness
+        {
+            /*!
+             * Evaluate the fitness of every Genome in \a population for the dual
+             * context system whose targets are \a target_ant and \a target_pos,
+             * spreading the work across \a n_threads threads (0 means 'use
+             * hardware_concurrency'). Element i of the returned vector is the fitness
+             * of population[i], exactly as GeneNetDual::evaluate_fitness would compute
+             * it serially.
+             */
+            static std::vector<double> evaluate (const std::vector<Genome<N,K>>& population,
+                                                 const state_t target_ant, const state_t target_pos,
+                                                 unsigned int n_threads = 0)
+            {
+                std::vector<double> fitnesses (population.size(), 0.0);
+
+                unsigned int nt = n_threads > 0 ? n_threads : std::thread::hardware_concurrency();
+                if (nt < 1) { nt = 1; }
+                if (nt > population.size()) { nt = static_cast<unsigned int>(population.size()); }
+
+                // Workers claim the next unevaluated genome from this counter
+                std::atomic<std::size_t> next{0};
+
+                auto worker = [&population, &fitnesses, &next, target_ant, target_pos]() {
+                    // Each thread has its own gene network object
+                    GeneNetDual<N,K> gn;
+                    gn.target_ant = target_ant;
+                    gn.target_pos = target_pos;
+                    for (;;) {
+                        std::size_t i = next.fetch_add (1);
+                        if (i >= population.size()) { break; }
+                        fitnesses[i] = gn.evaluate_fitness (population[i]);
+                    }
+                };
+
+                if (nt == 1) {
+                    worker(); // No need to spawn for a single thread
+                } else {
+                    std::vector<std::thread> threads;
+                    threads.reserve (nt);
+                    for (unsigned int t = 0; t < nt; ++t) { threads.emplace_back (worker); }
+                    for (auto& th : threads) { th.join(); }
+                }
+
+                return fitnesses;
+            }
+
+            /*
+             * Population diversity metrics. These work at genosect-word level (one
+             * popcount per word via Genome::hamming, or one pass of per-bit set
+             * counts) rather than looping bit-by-bit per genome pair, so population
+             * statistics passes cost O(P) or O(P * words) rather than O(P^2 * bits).
+             */
+
+            //! The Hamming distance from each Genome in \a population to \a ref (for
+            //! example the current best genome). Element i is population[i].hamming (ref).
+            static std::vector<unsigned int> hamming_to (const std::vector<Genome<N,K>>& population,
+                                                         const Genome<N,K>& ref)
+            {
+                std::vector<unsigned int> dists (population.size(), 0U);
+                for (std::size_t i = 0; i < population.size(); ++i) {
+                    dists[i] = population[i].hamming (ref);
+                }
+                return dists;
+            }
+
+            /*!
+             * The sum of the Hamming distances between every pair of Genomes in \a
+             * population. Computed in a single pass: for each bit position, if c of
+             * the P genomes have the bit set then that position contributes
+             * c * (P - c) mismatching pairs. This is O(P * genome width), not
+             * O(P^2) pairwise comparisons.
+             */
+            static unsigned long long int total_pairwise_hamming (const std::vector<Genome<N,K>>& population)
+            {
+                using genosect_t = typename Genosect<K>::type;
+                constexpr unsigned int genosect_w = (1 << K);
+                const std::size_t P = population.size();
+
+                unsigned long long int total = 0;
+                for (unsigned int i = 0; i < N; ++i) {
+                    std::array<std::size_t, genosect_w> setcount = {};
+                    for (std::size_t g = 0; g < P; ++g) {
+                        genosect_t w = population[g][i];
+                        for (unsigned int j = 0; j < genosect_w; ++j) {
+                            setcount[j] += (w >> j) & 0x1;
+                        }
+                    }
+                    for (unsigned int j = 0; j < genosect_w; ++j) {
+                        total += static_cast<unsigned long long int>(setcount[j]) * (P - setcount[j]);
+                    }
+                }
+                return total;
+            }
+
+            //! The mean Hamming distance between pairs of Genomes in \a population - a
+            //! scalar diversity metric for an evolving population. 0 for fewer than 2 genomes.
+            static double mean_pairwise_hamming (const std::vector<Genome<N,K>>& population)
+            {
+                const std::size_t P = population.size();
+                if (P < 2) { return 0.0; }
+                const double npairs = 0.5 * static_cast<double>(P) * static_cast<double>(P - 1);
+                return static_cast<double>(PopulationFitness<N,K>::total_pairwise_hamming (population)) / npairs;
+            }
+        };
+    }
+}
@@ -6,6 +6,10 @@
 #include <string>
 #include <vector>
 #include <cstddef>
+#include <cstdint>
+#include <bit>
+#include <thread>
+#include <stdexcept>
 #include <algorithm>
 #include <morph/bn/Implicant.h>
 
@@ -33,7 +37,7 @@ namespace morph {
             std::size_t ind = 0;
 
             // Debugging
-            constexpr bool verboseout = false;
+            static constexpr bool verboseout = false;
 
             Quine (int _vars): vars(_vars) { combs = 1 << this->vars; }
 
@@ -82,7 +86,7 @@ namespace morph {
 
             void go()
             {
-                if constexpr (verboseout) { if (!minterms.size()) { cout << "\n\tF = 0\n"; } }
+                if constexpr (verboseout) { if (!minterms.size()) { std::cout << "\n\tF = 0\n"; } }
 
                 sort (minterms.begin(), minterms.end());
                 minterms.erase( unique( minterms.begin(), minterms.end() ), minterms.end() );
@@ -90,9 +94,9 @@ namespace morph {
                 sort (implicants.begin(), implicants.end());
                 if constexpr (verboseout) {
                     for (std::size_t i = 0; i < implicants.size(); ++i) {
-                        cout << implicants[i].output(pr, fin) << endl;
+                        std::cout << implicants[i].str(pr, fin) << std::endl;
                     }
-                    cout << "-------------------------------------------------------\n";
+                    std::cout << "-------------------------------------------------------\n";
                 }
 
                 std::vector<Implicant> aux;
@@ -132,9 +136,9 @@ namespace morph {
                     sort (implicants.begin(), implicants.end());
                     if constexpr (verboseout) {
                         for (std::size_t i = 0; i < implicants.size(); ++i) {
-                            cout << implicants[i].output(pr, fin) << endl;
+                            std::cout << implicants[i].str(pr, fin) << std::endl;
                         }
-                        cout << "-------------------------------------------------------\n";
+                        std::cout << "-------------------------------------------------------\n";
                     }
                 }
                 for (std::size_t i = 0; i < implicants.size(); ++i) {
@@ -142,16 +146,11 @@ namespace morph {
                 }
                 if constexpr (verboseout) {
                     if (primes.back().mask == combs - 1) {
-                        cout << "\n\tF = 1\n";
+                        std::cout << "\n\tF = 1\n";
                     }
                 }
                 this->pr = false;
-                bool table[primes.size()][minterms.size()];
-                for (std::size_t i = 0; i < primes.size(); ++i) {
-                    for (std::size_t k = 0; k < minterms.size(); ++k) {
-                        table[i][k] = false;
-                    }
-                }
+                std::vector<std::vector<bool>> table (primes.size(), std::vector<bool> (minterms.size(), false));
                 for (std::size_t i = 0; i < primes.size(); ++i) {
                     for (std::size_t j = 0; j < primes[i].mints.size(); ++j) {
                         for (std::size_t k = 0; k < minterms.size(); ++k) {
@@ -162,20 +161,20 @@ namespace morph {
                     }
                 }
                 if constexpr (verboseout) {
-                    for (int k = 0; k < 18; ++k) { cout << " "; }
+                    for (int k = 0; k < 18; ++k) { std::cout << " "; }
                     for (std::size_t k = 0; k < minterms.size(); ++k) {
-                        cout << right << setw(2) << minterms[k] << ' ';
+                        std::cout << std::right << std::setw(2) << minterms[k] << ' ';
                     }
-                    cout << endl;
-                    for (int k = 0; k < 18; ++k) { cout << " "; }
-                    for (std::size_t k = 0; k < minterms.size(); ++k) { cout << "---"; }
-                    cout << endl;
+                    std::cout << std::endl;
+                    for (int k = 0; k < 18; ++k) { std::cout << " "; }
+                    for (std::size_t k = 0; k < minterms.size(); ++k) { std::cout << "---"; }
+                    std::cout << std::endl;
                     for (std::size_t i = 0; i < primes.size(); ++i) {
-                        cout << primes[i].output (pr, fin) << " |";
+                        std::cout << primes[i].str (pr, fin) << " |";
                         for (std::size_t k = 0; k < minterms.size(); ++k) {
-                            cout << (table[i][k] ? " X " : " ");
+                            std::cout << (table[i][k] ? " X " : " ");
                         }
-                        cout << endl;
+                        std::cout << std::endl;
                     }
                 }
 
@@ -204,31 +203,31 @@ namespace morph {
                 this->fin = false;
                 if constexpr (verboseout) {
                     bool f;
-                    cout << "-------------------------------------------------------\n";
+                    std::cout << "-------------------------------------------------------\n";
                     for (std::size_t j = 0; j < M0.size(); ++j) {
-                        cout << "\tF = ";
+                        std::cout << "\tF = ";
                         f = false;
                         for (std::size_t i = 0; i < primes.size(); ++i)
                             if (M0[j] & (1 << i)) {
-                                if (f) { cout << " + "; }
+                                if (f) { std::cout << " + "; }
                                 f = true;
-                                cout << primes[i].output (this->pr, this->fin);
+                                std::cout << primes[i].str (this->pr, this->fin);
                             }
-                        cout << endl;
+                        std::cout << std::endl;
                     }
-                    cout << "-------------------------------------------------------\n";
+                    std::cout << "-------------------------------------------------------\n";
 
                     // minimal solution
-                    cout << "F = ";
+                    std::cout << "F = ";
                     f = false;
                     for (std::size_t i = 0; i < primes.size(); ++i) {
                         if (M0[this->ind] & (1 << i)) {
-                            if (f) { cout << " + "; }
+                            if (f) { std::cout << " + "; }
                             f = true;
-                            cout << primes[i].output (this->pr, this->fin);
+                            std::cout << primes[i].str (this->pr, this->fin);
                         }
                     }
-                    cout << endl;
+                    std::cout << std::endl;
                 }
             }
 
@@ -248,20 +247,283 @@ namespace morph {
             }
 
             //! Run after go()
-            string min()
+            std::string min()
             {
-                string s("F = ");
+                std::string s("F = ");
                 bool f = false;
                 for (std::size_t i = 0; i < primes.size(); ++i) {
                     if (M0[this->ind] & (1 << i)) {
                         if (f) { s += " + "; }
                         f = true;
-                        s += primes[i].output (this->pr, this->fin);
+                        s += primes[i].str (this->pr, this->fin);
                     }
                 }
                 return s;
             }
         };
 
+        /*!
+         * A packed-bitset Quine-McCluskey minimizer for Boolean functions of up to 6
+         * variables (so, any Genosect-derived function). Where morph::bn::Quine holds
+         * each implicant as an object with strings and minterm vectors and compares
+         * all pairs quadratically, Quine64 packs an implicant into a (value,
+         * dash-mask) pair of words, merges terms with XOR/popcount tests, and covers
+         * minterms with single 64 bit words (one bit per input combination - the same
+         * packing as a Genosect). Prime implicant generation only ever combines terms
+         * from adjacent weight classes (weight = number of set value bits), and each
+         * pair of adjacent classes is independent, so the classes are searched in
+         * parallel across threads.
+         */
+        class Quine64
+        {
+        public:
+            //! A packed implicant: value holds the literal polarities and mask has a 1
+            //! wherever a variable has been eliminated (a '-' in QM tables). Dashed
+            //! positions of value are kept at 0 so that terms compare canonically.
+            struct Term
+            {
+                std::uint32_t value;
+                std::uint32_t mask;
+                bool operator== (const Term& o) const { return value == o.value && mask == o.mask; }
+                bool operator< (const Term& o) const
+                {
+                    return mask < o.mask || (mask == o.mask && value < o.value);
+                }
+            };
+
+            //! The number of variables in the function
+            int vars;
+            //! The truth table; bit m is the output for input combination m
+            std::uint64_t table = 0;
+            //! The prime implicants, found by go()
+            std::vector<Term> primes;
+            //! The selected minimal cover (a subset of primes), found by go()
+            std::vector<Term> cover;
+
+            Quine64 (int _vars) : vars(_vars)
+            {
+                if (_vars < 1 || _vars > 6) {
+                    throw std::runtime_error ("Quine64 handles 1 to 6 variables");
+                }
+            }
+
+            //! Add one minterm (input combination for which the function is 1)
+            void addMinterm (int m) { this->table |= (std::uint64_t{1} << m); }
+
+            //! Set the whole truth table at once - for a Genosect, pass the genome section
+            void setTable (std::uint64_t tbl)
+            {
+                std::uint64_t lim = this->vars == 6 ? ~std::uint64_t{0}
+                : ((std::uint64_t{1} << (1 << this->vars)) - 1);
+                this->table = tbl & lim;
+            }
+
+            //! Does prime \a p cover minterm \a m?
+            static bool covers (const Term& p, const int m)
+            {
+                return (static_cast<std::uint32_t>(m) & ~p.mask) == p.value;
+            }
+
+            //! The set of minterms covered by \a p, as a packed truth table word
+            std::uint64_t coverage (const Term& p) const
+            {
+                std::uint64_t cov = 0;
+                for (int m = 0; m < (1 << this->vars); ++m) {
+                    if (Quine64::covers (p, m) && (this->table & (std::uint64_t{1} << m))) {
+                        cov |= (std::uint64_t{1} << m);
+                    }
+                }
+                return cov;
+            }
+
+            //! Find the prime implicants and a minimal cover, searching the weight
+            //! classes with \a n_threads threads (0 means 'use hardware_concurrency')
+            void go (unsigned int n_threads = 0)
+            {
+                this->primes.clear();
+                this->cover.clear();
+                if (this->table == 0) { return; } // F = 0; no primes
+
+                // Generation 0: one term per minterm
+                std::vector<Term> current;
+                for (int m = 0; m < (1 << this->vars); ++m) {
+                    if (this->table & (std::uint64_t{1} << m)) {
+                        current.push_back (Term{static_cast<std::uint32_t>(m), 0});
+                    }
+                }
+
+                unsigned int nt = n_threads > 0 ? n_threads : std::thread::hardware_concurrency();
+                if (nt < 1) { nt = 1; }
+
+                while (!current.empty()) {
+                    // Group term indices by weight (popcount of value)
+                    std::vector<std::vector<std::size_t>> byweight (this->vars + 1);
+                    for (std::size_t i = 0; i < current.size(); ++i) {
+                        byweight[std::popcount (current[i].value)].push_back (i);
+                    }
+
+                    // Each weight class pair (w, w+1) is searched independently. A
+                    // task writes only into its own slots of merged/used_by, so the
+                    // threads don't interact; used flags are combined after the join.
+                    std::vector<std::vector<Term>> merged (this->vars);
+                    std::vector<std::vector<std::size_t>> used_by (this->vars);
+                    auto task = [&current, &byweight, &merged, &used_by, nt] (unsigned int t) {
+                        for (std::size_t w = t; w + 1 < byweight.size(); w += nt) {
+                            for (std::size_t i : byweight[w]) {
+                                for (std::size_t j : byweight[w+1]) {
+                                    if (current[i].mask != current[j].mask) { continue; }
+                                    std::uint32_t diff = current[i].value ^ current[j].value;
+                                    if (std::popcount (diff) == 1) {
+                                        // The lower-weight value has 0 in the diff
+                                        // position, so it is the canonical merged value
+                                        merged[w].push_back (Term{current[i].value,
+                                                                  current[i].mask | diff});
+                                        used_by[w].push_back (i);
+                                        used_by[w].push_back (j);
+                                    }
+                                }
+                            }
+                        }
+                    };
+                    if (nt == 1 || current.size() < 64) {
+                        task (0); // Not worth spawning for tiny tables
+                        for (unsigned int t = 1; t < nt; ++t) { task (t); }
+                    } else {
+                        std::vector<std::thread> threads;
+                        threads.reserve (nt);
+                        for (unsigned int t = 0; t < nt; ++t) { threads.emplace_back (task, t); }
+                        for (auto& th : threads) { th.join(); }
+                    }
+
+                    // Terms that merged with nothing are prime
+                    std::vector<bool> used (current.size(), false);
+                    for (const auto& ub : used_by) {
+                        for (std::size_t i : ub) { used[i] = true; }
+                    }
+                    for (std::size_t i = 0; i < current.size(); ++i) {
+                        if (!used[i]) { this->primes.push_back (current[i]); }
+                    }
+
+                    // The merged terms, deduplicated, form the next generation
+                    std::vector<Term> next;
+                    for (auto& mg : merged) { next.insert (next.end(), mg.begin(), mg.end()); }
+                    std::sort (next.begin(), next.end());
+                    next.erase (std::unique (next.begin(), next.end()), next.end());
+                    current = next;
+                }
+
+                this->select_cover();
+            }
+
+            //! Run after go(). The complexity measure of morph::bn::Quine: the number
+            //! of terms in the minimal cover over the number of input combinations.
+            double complexity() const
+            {
+                return static_cast<double>(this->cover.size()) / static_cast<double>(1 << this->vars);
+            }
+
+            //! Run after go(). Returns the minimized expression as a string.
+            std::string min() const
+            {
+                if (this->table == 0) { return std::string("F = 0"); }
+                if (this->cover.size() == 1
+                    && this->cover[0].mask == static_cast<std::uint32_t>((1 << this->vars) - 1)) {
+                    return std::string("F = 1");
+                }
+                std::string s("F = ");
+                bool f = false;
+                for (const Term& p : this->cover) {
+                    if (f) { s += " + "; }
+                    f = true;
+                    int lit = 0;
+                    for (int bit = (1 << (this->vars - 1)); bit > 0; bit >>= 1) {
+                        if (!(p.mask & static_cast<std::uint32_t>(bit))) {
+                            s += char(lit + 'A');
+                            s += (p.value & static_cast<std::uint32_t>(bit)) ? ' ' : '\'';
+                        }
+                        ++lit;
+                    }
+                }
+                return s;
+            }
+
+        private:
+            //! Choose a minimal subset of primes covering every minterm. Petrick's
+            //! method (as in Quine::mul) on packed words when there are at most 64
+            //! primes; greedy set cover otherwise.
+            void select_cover()
+            {
+                // Each prime's coverage as a packed minterm word
+                std::vector<std::uint64_t> cov (this->primes.size());
+                for (std::size_t i = 0; i < this->primes.size(); ++i) {
+                    cov[i] = this->coverage (this->primes[i]);
+                }
+
+                std::vector<std::size_t> chosen;
+                if (this->primes.size() <= 64) {
+                    // Petrick: product over minterms of (sum of primes covering it)
+                    std::vector<std::uint64_t> M0;
+                    bool first = true;
+                    for (int m = 0; m < (1 << this->vars); ++m) {
+                        if (!(this->table & (std::uint64_t{1} << m))) { continue; }
+                        std::vector<std::uint64_t> M1;
+                        for (std::size_t i = 0; i < this->primes.size(); ++i) {
+                            if (cov[i] & (std::uint64_t{1} << m)) {
+                                M1.push_back (std::uint64_t{1} << i);
+                            }
+                        }
+                        if (first) { M0 = M1; first = false; } else { Quine64::mul (M0, M1); }
+                    }
+                    // The product term with fewest primes is the minimal cover
+                    std::size_t ind = 0;
+                    for (std::size_t i = 1; i < M0.size(); ++i) {
+                        if (std::popcount (M0[i]) < std::popcount (M0[ind])) { ind = i; }
+                    }
+                    for (std::size_t i = 0; i < this->primes.size(); ++i) {
+                        if (M0[ind] & (std::uint64_t{1} << i)) { chosen.push_back (i); }
+                    }
+                } else {
+                    // Greedy: repeatedly take the prime covering most uncovered minterms
+                    std::uint64_t uncovered = this->table;
+                    while (uncovered != 0) {
+                        std::size_t best = 0;
+                        int bestn = -1;
+                        for (std::size_t i = 0; i < this->primes.size(); ++i) {
+                            int nc = std::popcount (cov[i] & uncovered);
+                            if (nc > bestn) { bestn = nc; best = i; }
+                        }
+                        chosen.push_back (best);
+                        uncovered &= ~cov[best];
+                    }
+                }
+                for (std::size_t i : chosen) { this->cover.push_back (this->primes[i]); }
+            }
+
+            //! Petrick's product step; the packed-word analogue of Quine::mul
+            static void mul (std::vector<std::uint64_t>& a, const std::vector<std::uint64_t>& b)
+            {
+                std::vector<std::uint64_t> v;
+                v.reserve (a.size() * b.size());
+                for (std::uint64_t ai : a) {
+                    for (std::uint64_t bj : b) { v.push_back (ai | bj); }
+                }
+                std::sort (v.begin(), v.end());
+                v.erase (std::unique (v.begin(), v.end()), v.end());
+                // Absorption: discard any product term that is a superset of another
+                std::vector<std::uint64_t> w;
+                for (std::size_t i = 0; i < v.size(); ++i) {
+                    bool absorbed = false;
+                    for (std::size_t j = 0; j < v.size(); ++j) {
+                        if (j != i && (v[i] & v[j]) == v[j] && v[j] != v[i]) {
+                            absorbed = true;
+                            break;
+                        }
+                    }
+                    if (!absorbed) { w.push_back (v[i]); }
+                }
+                a = w;
+            }
+        };
+
     } // namespace bn (Boolean Nets)
 } // namespace morph
@@ -7,9 +7,12 @@
 
 #pragma once
 
+#include <cstdint>
 #include <vector>
+#include <random>
 #include <morph/vec.h>
 #include <morph/vvec.h>
+#include <morph/Random.h>
 
 namespace morph {
 
@@ -35,6 +38,36 @@ namespace morph {
             }
         }
 
+        // The parallel resampling kernel. For each of B resamples of data (drawn with
+        // replacement), place the resample's mean in r_mean[i] and, if r_var is non-null, its
+        // variance in (*r_var)[i]. The loop over resamples runs under OpenMP; resample i draws
+        // its indices from stream (stream_base + i) of a counter-based Philox engine, so for a
+        // given seed the result is identical however many threads execute the loop. Each thread
+        // reuses a single, preallocated resample buffer - there are no per-resample allocations.
+        static void resample_stats (const morph::vvec<T>& data,
+                                    morph::vvec<T>& r_mean, morph::vvec<T>* r_var,
+                                    const unsigned int B, const std::uint32_t seed,
+                                    const std::uint32_t stream_base = 0)
+        {
+            const unsigned int data_n = data.size();
+            r_mean.resize (B);
+            if (r_var != nullptr) { r_var->resize (B); }
+#pragma omp parallel
+            {
+                morph::vvec<T> resample (data_n);
+#pragma omp for schedule(static)
+                for (unsigned int i = 0; i < B; ++i) {
+                    morph::philox_engine eng (seed, stream_base + i);
+                    std::uniform_int_distribution<unsigned int> randindex (0, data_n - 1);
+                    for (unsigned int j = 0; j < data_n; ++j) {
+                        resample[j] = data[randindex (eng)];
+                    }
+                    r_mean[i] = resample.mean();
+                    if (r_var != nullptr) { (*r_var)[i] = resample.variance(); }
+                }
+            }
+        }
+
         // Compute a bootstapped standard error of the mean of the data with B resamples
         static T error_of_mean (const morph::vvec<T>& data, const unsigned int B)
         {
@@ -55,6 +88,24 @@ namespace morph {
             return bootstrap<T>::error_of_mean (vdata, B);
         }
 
+        // Parallel version of error_of_mean, which resamples via resample_stats. Results are
+        // deterministic for a given seed (and independent of the number of OpenMP threads).
+        static T error_of_mean_par (const morph::vvec<T>& data, const unsigned int B,
+                                    const std::uint32_t seed = morph::philox_engine::default_seed)
+        {
+            morph::vvec<T> r_mean;
+            morph::bootstrap<T>::resample_stats (data, r_mean, nullptr, B, seed);
+            return r_mean.std();
+        }
+        // std::vector version of error_of_mean_par
+        static T error_of_mean_par (const std::vector<T>& data, const unsigned int B,
+                                    const std::uint32_t seed = morph::philox_engine::default_seed)
+        {
+            morph::vvec<T> vdata;
+            vdata.set_from (data);
+            return bootstrap<T>::error_of_mean_par (vdata, B, seed);
+        }
+
         // Compute a bootstapped standard error of the SD of the data with B resamples
         static T error_of_std (const morph::vvec<T>& data, const unsigned int B)
         {
@@ -75,6 +126,25 @@ namespace morph {
             return bootstrap<T>::error_of_std (vdata, B);
         }
 
+        // Parallel version of error_of_std
+        static T error_of_std_par (const morph::vvec<T>& data, const unsigned int B,
+                                   const std::uint32_t seed = morph::philox_engine::default_seed)
+        {
+            morph::vvec<T> r_mean;
+            morph::vvec<T> r_var;
+            morph::bootstrap<T>::resample_stats (data, r_mean, &r_var, B, seed);
+            // The standard deviation of each resample is the square root of its variance
+            return r_var.sqrt().std();
+        }
+        // std::vector version of error_of_std_par
+        static T error_of_std_par (const std::vector<T>& data, const unsigned int B,
+                                   const std::uint32_t seed = morph::philox_engine::default_seed)
+        {
+            morph::vvec<T> vdata;
+            vdata.set_from (data);
+            return bootstrap<T>::error_of_std_par (vdata, B, seed);
+        }
+
         // Compute a bootstrapped two sample t statistic as per algorithm 16.2
         // in Efron & Tibshirani.
         // zdata is treatment; ydata is control. B is the number of bootstrap samples to make
@@ -199,5 +269,75 @@ namespace morph {
             vydata.set_from (_ydata);
             return bootstrap<T>::ttest_equalityofmeans (vzdata, vydata, B);
         }
+
+        // Parallel version of ttest_equalityofmeans, in which the B resamples of each of the two
+        // shifted distributions are drawn and summarised by the OpenMP-parallel resample_stats
+        // kernel (the z resamples use streams 0 to B-1 and the y resamples streams B to 2B-1).
+        // The statistics are the same as the serial version's; only the resampling engine
+        // differs. Deterministic for a given seed, whatever the thread count.
+        static morph::vec<T, 2> ttest_equalityofmeans_par (const morph::vvec<T>& _zdata,
+                                                           const morph::vvec<T>& _ydata, const unsigned int B,
+                                                           const std::uint32_t seed = morph::philox_engine::default_seed)
+        {
+            // Ensure that the group which we name zdata is the larger one.
+            morph::vvec<T> zdata = _zdata;
+            morph::vvec<T> ydata = _ydata;
+            if (_zdata.mean() <= _ydata.mean()) { std::swap (ydata, zdata); }
+
+            unsigned int n = zdata.size();
+            unsigned int m = ydata.size();
+
+            T zmean = zdata.mean();
+            T ymean = ydata.mean();
+
+            // combine the data as if they were drawn from a single distribution
+            morph::vvec<T> x = ydata;
+            x.concat (zdata);
+            T xmean = x.mean();
+
+            // Compute variances for the observed values:
+            T obsvarz = (zdata-zmean).pow(2).sum() / (n-1);
+            T obsvary = (ydata-ymean).pow(2).sum() / (m-1);
+
+            // Compute the observed value of the studentised statistic (using separate
+            // variances, rather than a pooled variance):
+            T tobs = (zmean - ymean) / std::sqrt (obsvary/static_cast<T>(m) + obsvarz/static_cast<T>(n));
+
+            // Create shifted distributions; shifted by group mean and combined mean:
+            morph::vvec<T> ztilda = zdata - zmean + xmean;
+            morph::vvec<T> ytilda = ydata - ymean + xmean;
+
+            // Resample from the shifted (tilda) distributions, obtaining the mean and variance
+            // of each resample directly:
+            morph::vvec<T> zstarmeans;
+            morph::vvec<T> zvariances;
+            morph::bootstrap<T>::resample_stats (ztilda, zstarmeans, &zvariances, B, seed, 0);
+            morph::vvec<T> ystarmeans;
+            morph::vvec<T> yvariances;
+            morph::bootstrap<T>::resample_stats (ytilda, ystarmeans, &yvariances, B, seed, B);
+
+            morph::vvec<T> top = zstarmeans - ystarmeans;
+            morph::vvec<T> bot = (yvariances/static_cast<T>(m) + zvariances/static_cast<T>(n)).sqrt();
+            morph::vvec<T> txstar = top / bot;
+
+            T numbeyond = (txstar.element_compare_gteq (tobs)).sum();
+
+            auto asl = numbeyond / static_cast<T>(B);
+            // The minimum achieved significance level for the number of resamples, B.
+            T minasl = T{1} / static_cast<T>(B);
+
+            return morph::vec<T, 2> ({asl, minasl});
+        }
+        // std::vector version of ttest_equalityofmeans_par()
+        static morph::vec<T, 2> ttest_equalityofmeans_par (const std::vector<T>& _zdata,
+                                                           const std::vector<T>& _ydata, const unsigned int B,
+                                                           const std::uint32_t seed = morph::philox_engine::default_seed)
+        {
+            morph::vvec<T> vzdata;
+            vzdata.set_from (_zdata);
+            morph::vvec<T> vydata;
+            vydata.set_from (_ydata);
+            return bootstrap<T>::ttest_equalityofmeans_par (vzdata, vydata, B, seed);
+        }
     };
 }
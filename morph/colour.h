@@ -10,6 +10,9 @@
 #pragma once
 
 #include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 
 namespace morph {
     namespace colour {
@@ -708,5 +711,76 @@ namespace morph {
         static constexpr std::array<float, 3> grey3 = {0.031372549f,0.031372549f,0.031372549f};
         static constexpr std::array<float, 3> grey2 = {0.0196078431f,0.0196078431f,0.0196078431f};
         static constexpr std::array<float, 3> grey1 = {0.0117647059f,0.0117647059f,0.0117647059f};
+
+        /*
+         * sRGB transfer functions. The named colours above, and the colours that ColourMap
+         * produces, are sRGB-encoded; convert to linear before doing arithmetic on colours
+         * (blending, averaging, image processing) and back to sRGB for display.
+         */
+
+        //! Exact sRGB-encoded component to linear-light component (both in range [0,1])
+        inline float srgb_to_linear (const float s)
+        {
+            return s <= 0.04045f ? s / 12.92f : std::pow ((s + 0.055f) / 1.055f, 2.4f);
+        }
+
+        //! Exact linear-light component to sRGB-encoded component (both in range [0,1])
+        inline float linear_to_srgb (const float l)
+        {
+            return l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow (l, 1.0f / 2.4f) - 0.055f;
+        }
+
+        /*!
+         * Look-up table version of srgb_to_linear for 8 bit components (image pixels). The
+         * 256-entry table is exact - there are only 256 possible inputs - and is built once,
+         * on first use, replacing a std::pow call per component with a table index.
+         */
+        inline float srgb_to_linear_lut (const uint8_t s8)
+        {
+            static const std::array<float, 256> tbl = [] {
+                std::array<float, 256> t;
+                for (std::size_t i = 0; i < t.size(); ++i) {
+                    t[i] = srgb_to_linear (static_cast<float>(i) / 255.0f);
+                }
+                return t;
+            }();
+            return tbl[s8];
+        }
+
+        /*!
+         * Look-up table version of linear_to_srgb. The input is continuous, so this is
+         * approximate: the 1024-entry table quantizes the result to well under one 8 bit
+         * step (the largest table-step error is at the dark end, where the sRGB curve is
+         * steepest). Out-of-range inputs are clamped.
+         */
+        inline float linear_to_srgb_lut (const float l)
+        {
+            static constexpr std::size_t lut_n = 1024;
+            static const std::array<float, lut_n> tbl = [] {
+                std::array<float, lut_n> t;
+                for (std::size_t i = 0; i < t.size(); ++i) {
+                    t[i] = linear_to_srgb (static_cast<float>(i) / static_cast<float>(lut_n - 1));
+                }
+                return t;
+            }();
+            float lc = l < 0.0f ? 0.0f : (l > 1.0f ? 1.0f : l);
+            return tbl[static_cast<std::size_t>(std::round (lc * static_cast<float>(lut_n - 1)))];
+        }
+
+        //! Batch conversion of \a n 8 bit sRGB components (RGB, RGBA or greyscale - any
+        //! layout, as components convert independently) to linear floats via the LUT
+        inline void srgb_to_linear_array (const uint8_t* in, float* out, const std::size_t n)
+        {
+            srgb_to_linear_lut (0); // Ensure the table is built outside the loop
+            for (std::size_t i = 0; i < n; ++i) { out[i] = srgb_to_linear_lut (in[i]); }
+        }
+
+        //! Batch conversion of \a n linear-light float components to sRGB floats via the LUT
+        inline void linear_to_srgb_array (const float* in, float* out, const std::size_t n)
+        {
+            linear_to_srgb_lut (0.0f);
+            for (std::size_t i = 0; i < n; ++i) { out[i] = linear_to_srgb_lut (in[i]); }
+        }
+
     } // end of namespace colour
 } // namespace morph
@@ -41,6 +41,7 @@
 #include <cstdint>
 #include <limits>
 #include <type_traits>
+#include <array>
 #include <morph/mathconst.h>
 #include <cmath>
 
@@ -774,5 +775,39 @@ namespace morph
             }
         }
 
+        /*!
+         * Compile-time trig tables for the angles around the unit circle
+         *
+         * sines[j] = sin(j * 2pi/N) and cosines[j] = cos(j * 2pi/N) for j in [0, N), all
+         * evaluated by the constexpr sin/cos above, so the tables cost nothing at runtime. The
+         * geometry primitive builders (computeSphere, computeTube, computeRing and friends)
+         * place N vertices around a circle for their ring segments; with these tables the
+         * standard segment counts become pure lookups. The tables are also available to user
+         * geometry code, e.g.
+         *
+         *   constexpr auto& s = morph::math::unit_circle<float, 60>::sines;
+         *
+         * \tparam T The floating point type for the table entries
+         * \tparam N The number of equally spaced angles around the circle
+         */
+        template <typename T, int N> requires (N > 0 && std::is_floating_point_v<T>)
+        struct unit_circle
+        {
+            static constexpr std::array<T, N> sines = []() constexpr {
+                std::array<T, N> tbl = {};
+                for (int j = 0; j < N; ++j) {
+                    tbl[j] = math::sin (static_cast<T>(j) * morph::mathconst<T>::two_pi / static_cast<T>(N));
+                }
+                return tbl;
+            }();
+            static constexpr std::array<T, N> cosines = []() constexpr {
+                std::array<T, N> tbl = {};
+                for (int j = 0; j < N; ++j) {
+                    tbl[j] = math::cos (static_cast<T>(j) * morph::mathconst<T>::two_pi / static_cast<T>(N));
+                }
+                return tbl;
+            }();
+        };
+
     } // math
 } // morph
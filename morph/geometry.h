@@ -745,6 +745,26 @@ namespace morph {
             return geo;
         }
 
+        /*!
+         * A cached make_icosahedral_geodesic. The first request for a given number of \a
+         * iterations runs the full subdivision (with its std::map-based vertex deduplication and
+         * re-ordering); thereafter the statically held mesh is returned by reference, so creating
+         * thousands of GeodesicVisuals builds each subdivision level once rather than once per
+         * model. The cache is thread_local because separate threads may build separate models
+         * concurrently. For compile-time meshes (unordered vertices) see
+         * morph::geometry_ce::make_icosahedral_geodesic.
+         */
+        template<typename F>
+        const morph::geometry::icosahedral_geodesic<F>& icosahedral_geodesic_cached (const int iterations)
+        {
+            static thread_local std::map<int, morph::geometry::icosahedral_geodesic<F>> cache;
+            auto gi = cache.find (iterations);
+            if (gi == cache.end()) {
+                gi = cache.emplace (iterations, morph::geometry::make_icosahedral_geodesic<F> (iterations)).first;
+            }
+            return gi->second;
+        }
+
     } // geometry
 
 } // morph
@@ -26,6 +26,7 @@
 #include <GLFW/glfw3.h> // GLFW is our only supported way to getting OpenGL context for morph::gl_compute
 
 #include <chrono>
+#include <vector>
 #include <morph/VisualDefaultShaders.h>
 
 namespace morph {
@@ -93,6 +94,41 @@ namespace morph {
                 glfwSwapBuffers (this->window);
             }
 
+            /*
+             * The dispatch queue. Rather than calling compute_shaderprog::dispatch() for each
+             * pass (which places a GL_ALL_BARRIER_BITS barrier after every dispatch), record a
+             * chain of passes with queue_dispatch() and submit them with one flush_dispatches()
+             * call. Each pass is followed only by the (narrow, default
+             * GL_SHADER_STORAGE_BARRIER_BIT) barrier it asked for, so the chain pipelines on the
+             * GPU, and if enable_timing() has been called on a program, each of its dispatches
+             * is wrapped in a GL_TIME_ELAPSED query for per-pass accounting.
+             */
+
+            //! Record a dispatch of \a prog for later submission by flush_dispatches(). Pass
+            //! barrier_bits = 0 if the next queued pass does not read this one's output.
+            void queue_dispatch (compute_shaderprog<glver>& prog,
+                                 GLuint ngrps_x, GLuint ngrps_y, GLuint ngrps_z,
+                                 GLbitfield barrier_bits = GL_SHADER_STORAGE_BARRIER_BIT)
+            {
+                this->dispatch_queue.push_back ({ &prog, ngrps_x, ngrps_y, ngrps_z, barrier_bits });
+            }
+
+            //! Submit all queued dispatches to the GPU in order, then clear the queue. Does not
+            //! wait for completion; map/read your output SSBO (or call glFinish) when you need
+            //! the results.
+            void flush_dispatches()
+            {
+                for (auto& qd : this->dispatch_queue) {
+                    qd.prog->use();
+                    bool timed = qd.prog->begin_timed();
+                    glDispatchCompute (qd.ngrps_x, qd.ngrps_y, qd.ngrps_z);
+                    qd.prog->end_timed (timed);
+                    if (qd.barrier_bits != 0) { glMemoryBarrier (qd.barrier_bits); }
+                }
+                this->dispatch_queue.clear();
+                morph::gl::Util::checkError (__FILE__, __LINE__);
+            }
+
             //! Set to true when the program should end
             bool readyToFinish = false;
 
@@ -243,6 +279,18 @@ namespace morph {
             virtual void load_shaders() = 0;
 
         protected:
+            //! One entry in the dispatch queue; see queue_dispatch()
+            struct queued_dispatch
+            {
+                compute_shaderprog<glver>* prog;
+                GLuint ngrps_x;
+                GLuint ngrps_y;
+                GLuint ngrps_z;
+                GLbitfield barrier_bits;
+            };
+            //! Dispatches recorded by queue_dispatch(), awaiting flush_dispatches()
+            std::vector<queued_dispatch> dispatch_queue;
+
             //! The window (and OpenGL context) for this gl::compute_manager
             GLFWwindow* window = nullptr;
 
@@ -1,6 +1,7 @@
 #pragma once
 #include <type_traits>
 #include <vector>
+#include <array>
 #include <string>
 #include <sstream>
 #include <cstddef>
@@ -40,6 +41,9 @@ namespace morph {
                     glDeleteProgram (this->prog_id);
                     this->prog_id = 0;
                 }
+#ifdef GL_TIME_ELAPSED
+                if (this->time_queries[0] != 0) { glDeleteQueries (n_tq, this->time_queries.data()); }
+#endif
             }
 
             void load_shaders (const std::vector<morph::gl::ShaderInfo>& shaders)
@@ -57,6 +61,95 @@ namespace morph {
                 glMemoryBarrier (GL_ALL_BARRIER_BITS);
             }
 
+            /*
+             * GL_TIME_ELAPSED accounting. Call enable_timing() once (with the GL context
+             * current), then time dispatches either with dispatch_timed() or, when recording into
+             * compute_manager's dispatch queue, automatically. Results are harvested without
+             * blocking, so timings for a dispatch become visible a frame or two later; read them
+             * with last_dispatch_ns()/mean_dispatch_ms(). Not available on OpenGL ES (where
+             * GL_TIME_ELAPSED needs EXT_disjoint_timer_query); there, these are no-ops.
+             */
+
+            //! Generate the timer query ring and switch timing on
+            void enable_timing()
+            {
+#ifdef GL_TIME_ELAPSED
+                if (this->time_queries[0] == 0) { glGenQueries (n_tq, this->time_queries.data()); }
+                this->timing_enabled = true;
+#endif
+            }
+
+            //! Begin a GL_TIME_ELAPSED query for a dispatch, if timing is on and a query object
+            //! is free. Returns true if a query was begun (pass this to end_timed()).
+            bool begin_timed()
+            {
+#ifdef GL_TIME_ELAPSED
+                if (this->timing_enabled == false) { return false; }
+                this->harvest_timings();
+                if (this->tq_head - this->tq_tail >= n_tq) { return false; } // ring full; skip this one
+                glBeginQuery (GL_TIME_ELAPSED, this->time_queries[this->tq_head % n_tq]);
+                return true;
+#else
+                return false;
+#endif
+            }
+
+            //! End the query begun by begin_timed() (a no-op if begin_timed returned false)
+            void end_timed (const bool began)
+            {
+#ifdef GL_TIME_ELAPSED
+                if (began == true) {
+                    glEndQuery (GL_TIME_ELAPSED);
+                    ++this->tq_head;
+                }
+#endif
+            }
+
+            //! Collect the results of any completed timer queries, without blocking
+            void harvest_timings()
+            {
+#ifdef GL_TIME_ELAPSED
+                while (this->tq_tail != this->tq_head) {
+                    GLuint q = this->time_queries[this->tq_tail % n_tq];
+                    GLuint avail = 0;
+                    glGetQueryObjectuiv (q, GL_QUERY_RESULT_AVAILABLE, &avail);
+                    if (avail == 0u) { break; }
+                    GLuint64 ns = 0;
+                    glGetQueryObjectui64v (q, GL_QUERY_RESULT, &ns);
+                    this->time_elapsed_last_ns = ns;
+                    this->time_elapsed_total_ns += ns;
+                    ++this->n_timings;
+                    ++this->tq_tail;
+                }
+#endif
+            }
+
+            //! As dispatch(), but wrapped in a GL_TIME_ELAPSED query (if timing is enabled)
+            void dispatch_timed (GLuint ngrps_x, GLuint ngrps_y, GLuint ngrps_z)
+            {
+                bool began = this->begin_timed();
+                glDispatchCompute (ngrps_x, ngrps_y, ngrps_z);
+                this->end_timed (began);
+                glMemoryBarrier (GL_ALL_BARRIER_BITS);
+            }
+
+            //! GPU time of the most recently completed timed dispatch, in ns
+            unsigned long long last_dispatch_ns() const { return this->time_elapsed_last_ns; }
+            //! Mean GPU time per timed dispatch, in ms
+            double mean_dispatch_ms() const
+            {
+                return this->n_timings == 0u ? 0.0 : (this->time_elapsed_total_ns / 1e6) / this->n_timings;
+            }
+            //! The number of dispatches for which a timing has been collected
+            unsigned int timings_collected() const { return this->n_timings; }
+            //! Zero the timing accumulators
+            void reset_timings()
+            {
+                this->time_elapsed_total_ns = 0u;
+                this->time_elapsed_last_ns = 0u;
+                this->n_timings = 0u;
+            }
+
             // Set a uniform variable into the OpenGL context associated with this shader program
             template <typename T>
             void set_uniform (const std::string& glsl_varname, const T& value)
@@ -92,6 +185,20 @@ namespace morph {
             }
 
         private:
+            // The timer query ring. n_tq queries lets timings be harvested asynchronously while
+            // several dispatches are still in flight.
+            static constexpr unsigned int n_tq = 8;
+            std::array<GLuint, n_tq> time_queries = {};
+            // Query ring head/tail; entries [tq_tail, tq_head) are in flight
+            unsigned int tq_head = 0;
+            unsigned int tq_tail = 0;
+            // Only query GL_TIME_ELAPSED when enable_timing() has been called
+            bool timing_enabled = false;
+            // Timing accumulators, harvested by harvest_timings()
+            unsigned long long time_elapsed_total_ns = 0;
+            unsigned long long time_elapsed_last_ns = 0;
+            unsigned int n_timings = 0;
+
             // Runtime check on a uniform location. If -1 throw exception. This is useful because
             // any uniform variable in a GLSL program which is not used may be compiled out and thus
             // be not 'active'. In this case, glGetUniformLocation will return -1. Our programmer
@@ -0,0 +1,216 @@
+/*!
+ * \file
+ *
+ * GPU-resident stepping of PDE-style stencil computations over the elements of a
+ * morph::Grid or a morph::HexGrid.
+ *
+ * morph::gl::grid_compute uploads a grid's state and its neighbour table into SSBOs
+ * once, then runs a user-supplied GLSL compute shader for as many steps as you like
+ * with no CPU readback between steps (the state lives in a ping-pong pair of buffers
+ * on the GPU). When you want to display or analyse the state - say once every few
+ * hundred steps - call sync_for_display() to copy the current state back into a
+ * CPU-side vvec, which can be handed straight to GridVisual::updateData or
+ * HexGridVisual::updateData.
+ *
+ * Note: You have to include a header like GL3/gl3.h or GLES3/gl31.h for the GL types
+ * and functions BEFORE including this file (see morph/gl/compute_manager.h for why),
+ * and an OpenGL context must be current when you call init() and the other methods.
+ *
+ * \author Seb James
+ * \date August 2026
+ */
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <limits>
+#include <morph/vvec.h>
+#include <morph/Grid.h>
+#include <morph/HexGrid.h>
+#include <morph/gl/version.h>
+#include <morph/gl/util_nomx.h>
+#include <morph/gl/compute_shaderprog.h>
+
+namespace morph {
+    namespace gl {
+
+        /*!
+         * A GPU-resident stepping loop for grid stencil computations.
+         *
+         * Your GLSL compute shader (loaded into this->step_program by your client code)
+         * should declare its buffers to match the binding layout that grid_compute
+         * uploads:
+         *
+         * \code
+         * layout (local_size_x = 64) in; // must match grid_compute::workgroup_size
+         * layout (std430, binding = 0) buffer StateIn  { float state_in[]; };
+         * layout (std430, binding = 1) buffer StateOut { float state_out[]; };
+         * layout (std430, binding = 2) readonly buffer Nbr { int nbr[]; };
+         * \endcode
+         *
+         * The neighbour table holds k ints per element (k == 4 for a morph::Grid, in
+         * the order east, north, west, south; k == 6 for a morph::HexGrid, in the order
+         * NE, NNE, NNW, NW, NSW, NSE, matching the d_ne/d_nne/... vectors). An absent
+         * neighbour is -1, whichever grid class the table came from. Guard your
+         * invocations with \code if (gl_GlobalInvocationID.x >= state_in.length()) {
+         * return; } \endcode and set any model parameters (dt, D, etc.) as uniforms on
+         * this->step_program before calling step().
+         *
+         * \tparam glver The OpenGL version, from morph/gl/version.h (4.3+ or 3.1 ES+
+         * required for compute shaders)
+         * \tparam T The type of the per-element state. float is what GLSL expects;
+         * other types require matching buffer declarations in your shader.
+         */
+        template <int glver = morph::gl::version_4_5, typename T = float>
+        struct grid_compute
+        {
+            //! SSBO binding indices, fixed so that GLSL code can be written against them
+            static constexpr GLuint state_in_binding = 0;
+            static constexpr GLuint state_out_binding = 1;
+            static constexpr GLuint nbr_binding = 2;
+            //! The local_size_x that your compute shader must declare
+            static constexpr GLuint workgroup_size = 64;
+
+            //! The number of elements in the grid
+            unsigned int n = 0;
+            //! Neighbours per element; 4 for a Grid, 6 for a HexGrid
+            unsigned int k = 0;
+            //! The CPU-side state. Valid after init() and after each sync_for_display()
+            morph::vvec<T> state;
+            //! The user-supplied stepping shader. Load your GLSL into this before step()
+            compute_shaderprog<glver> step_program;
+
+            grid_compute() {}
+            ~grid_compute()
+            {
+                if (this->ssbo_state[0]) { glDeleteBuffers (2, this->ssbo_state); }
+                if (this->ssbo_nbr) { glDeleteBuffers (1, &this->ssbo_nbr); }
+            }
+
+            //! Upload a morph::Grid's neighbour table along with the initial state. Non-const
+            //! Grid reference, because the Grid's precomputed neighbour table is built here if
+            //! the client code has not already done so.
+            template <typename I, typename C>
+            void init (morph::Grid<I, C>& g, const morph::vvec<T>& initial_state)
+            {
+                if (initial_state.size() != static_cast<std::size_t>(g.n())) {
+                    throw std::runtime_error ("grid_compute::init: initial_state size does not match Grid::n()");
+                }
+                if (g.v_nbr.empty()) { g.build_neighbour_table(); }
+                this->n = static_cast<unsigned int>(g.n());
+                this->k = 4;
+                // The Grid neighbour table uses std::numeric_limits<I>::max() for 'no
+                // neighbour'; translate to the -1 that the GLSL-side int table uses
+                morph::vvec<int> nbr (4u * this->n, -1);
+                for (unsigned int i = 0; i < 4u * this->n; ++i) {
+                    if (g.v_nbr[i] != std::numeric_limits<I>::max()) { nbr[i] = static_cast<int>(g.v_nbr[i]); }
+                }
+                this->upload (nbr, initial_state);
+            }
+
+            //! Upload a morph::HexGrid's neighbour vectors along with the initial state
+            void init (const morph::HexGrid& hg, const morph::vvec<T>& initial_state)
+            {
+                if (hg.d_ne.empty()) {
+                    throw std::runtime_error ("grid_compute::init: HexGrid d_ vectors are empty (is the grid initialized?)");
+                }
+                if (initial_state.size() != static_cast<std::size_t>(hg.num())) {
+                    throw std::runtime_error ("grid_compute::init: initial_state size does not match HexGrid::num()");
+                }
+                this->n = hg.num();
+                this->k = 6;
+                // Interleave the six neighbour vectors, which already use -1 for 'no neighbour'
+                morph::vvec<int> nbr (6u * this->n, -1);
+                for (unsigned int i = 0; i < this->n; ++i) {
+                    nbr[6u * i] = hg.d_ne[i];
+                    nbr[6u * i + 1u] = hg.d_nne[i];
+                    nbr[6u * i + 2u] = hg.d_nnw[i];
+                    nbr[6u * i + 3u] = hg.d_nw[i];
+                    nbr[6u * i + 4u] = hg.d_nsw[i];
+                    nbr[6u * i + 5u] = hg.d_nse[i];
+                }
+                this->upload (nbr, initial_state);
+            }
+
+            //! Run the stepping shader n_steps times, ping-ponging the state between the two
+            //! GPU buffers. No data crosses back to the CPU here; call sync_for_display() when
+            //! you want to see the result.
+            void step (const unsigned int n_steps)
+            {
+                if (this->n == 0) { throw std::runtime_error ("grid_compute::step: call init() first"); }
+                const GLuint ngrps = (static_cast<GLuint>(this->n) + workgroup_size - 1) / workgroup_size;
+                this->step_program.use();
+                for (unsigned int s = 0; s < n_steps; ++s) {
+                    glBindBufferBase (GL_SHADER_STORAGE_BUFFER, state_in_binding, this->ssbo_state[this->src]);
+                    glBindBufferBase (GL_SHADER_STORAGE_BUFFER, state_out_binding, this->ssbo_state[1u - this->src]);
+                    glBindBufferBase (GL_SHADER_STORAGE_BUFFER, nbr_binding, this->ssbo_nbr);
+                    // dispatch() includes the glMemoryBarrier that orders this step's writes
+                    // before the next step's reads
+                    this->step_program.dispatch (ngrps, 1, 1);
+                    this->src = 1u - this->src;
+                }
+                morph::gl::Util::checkError (__FILE__, __LINE__);
+            }
+
+            //! Copy the current GPU state back into this->state and return a reference to it,
+            //! suitable for passing to GridVisual::updateData or HexGridVisual::updateData.
+            const morph::vvec<T>& sync_for_display()
+            {
+                if (this->n == 0) { throw std::runtime_error ("grid_compute::sync_for_display: call init() first"); }
+                glBindBuffer (GL_SHADER_STORAGE_BUFFER, this->ssbo_state[this->src]);
+                T* cpuptr = static_cast<T*>(glMapBufferRange (GL_SHADER_STORAGE_BUFFER, 0, this->n * sizeof(T), GL_MAP_READ_BIT));
+                for (unsigned int i = 0; i < this->n; ++i) { this->state[i] = cpuptr[i]; }
+                glUnmapBuffer (GL_SHADER_STORAGE_BUFFER);
+                glBindBuffer (GL_SHADER_STORAGE_BUFFER, 0);
+                morph::gl::Util::checkError (__FILE__, __LINE__);
+                return this->state;
+            }
+
+            //! Overwrite the GPU-side state with new CPU-side values (re-seeding a model)
+            void set_state (const morph::vvec<T>& new_state)
+            {
+                if (new_state.size() != static_cast<std::size_t>(this->n)) {
+                    throw std::runtime_error ("grid_compute::set_state: new_state size does not match");
+                }
+                this->state = new_state;
+                glBindBuffer (GL_SHADER_STORAGE_BUFFER, this->ssbo_state[this->src]);
+                glBufferData (GL_SHADER_STORAGE_BUFFER, this->n * sizeof(T), this->state.data(), GL_DYNAMIC_COPY);
+                glBindBuffer (GL_SHADER_STORAGE_BUFFER, 0);
+                morph::gl::Util::checkError (__FILE__, __LINE__);
+            }
+
+            //! The GL name of the buffer holding the current state, should client code want to
+            //! bind it for its own purposes (rendering from the SSBO, extra shader passes, etc.)
+            GLuint current_state_ssbo() const { return this->ssbo_state[this->src]; }
+
+        private:
+            //! Create the neighbour table SSBO and the ping-pong pair of state SSBOs
+            void upload (const morph::vvec<int>& nbr, const morph::vvec<T>& initial_state)
+            {
+                this->state = initial_state;
+
+                glGenBuffers (1, &this->ssbo_nbr);
+                glBindBufferBase (GL_SHADER_STORAGE_BUFFER, nbr_binding, this->ssbo_nbr);
+                glBufferData (GL_SHADER_STORAGE_BUFFER, nbr.size() * sizeof(int), nbr.data(), GL_STATIC_DRAW);
+
+                glGenBuffers (2, this->ssbo_state);
+                glBindBufferBase (GL_SHADER_STORAGE_BUFFER, state_in_binding, this->ssbo_state[0]);
+                glBufferData (GL_SHADER_STORAGE_BUFFER, this->n * sizeof(T), this->state.data(), GL_DYNAMIC_COPY);
+                glBindBufferBase (GL_SHADER_STORAGE_BUFFER, state_out_binding, this->ssbo_state[1]);
+                glBufferData (GL_SHADER_STORAGE_BUFFER, this->n * sizeof(T), this->state.data(), GL_DYNAMIC_COPY);
+
+                glBindBuffer (GL_SHADER_STORAGE_BUFFER, 0);
+                this->src = 0;
+                morph::gl::Util::checkError (__FILE__, __LINE__);
+            }
+
+            //! The ping-pong pair of state buffers
+            GLuint ssbo_state[2] = { 0, 0 };
+            //! The neighbour table buffer
+            GLuint ssbo_nbr = 0;
+            //! Which of ssbo_state currently holds the state
+            unsigned int src = 0;
+        };
+
+    } // namespace gl
+} // namespace morph
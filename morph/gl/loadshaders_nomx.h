@@ -5,6 +5,7 @@
 #pragma once
 
 #include <morph/gl/shaders.h>
+#include <morph/gl/shadercache.h>
 
 #include <morph/tools.h>
 #include <vector>
@@ -21,8 +22,6 @@ namespace morph {
         {
             if (shader_info.empty()) { return 0; }
 
-            GLuint program = glCreateProgram();
-
 #ifdef GL_SHADER_COMPILER
             GLboolean shaderCompilerPresent = GL_FALSE;
             glGetBooleanv (GL_SHADER_COMPILER, &shaderCompilerPresent);
@@ -34,41 +33,80 @@ namespace morph {
                 }
             }
 #endif
-            for (auto entry : shader_info) {
-                GLuint shader = glCreateShader (entry.type);
-                entry.shader = shader;
+            // Read all the shader sources up front. As well as being needed for
+            // compilation, they make up the binary cache key.
+            std::vector<std::unique_ptr<GLchar[]>> sources (shader_info.size());
+            for (std::size_t i = 0; i < shader_info.size(); ++i) {
+                const auto& entry = shader_info[i];
                 // Test entry.filename. If this GLSL file can be read, then do so, otherwise,
                 // compile the default version specified in the ShaderInfo
-                std::unique_ptr<GLchar[]> source;
                 if constexpr (debug_shaders == true) {
                     std::cout << "Check file exists for " << entry.filename << std::endl;
                 }
                 if (morph::tools::fileExists (entry.filename)) {
                     std::cout << "Using " << morph::gl::shader_type_str(entry.type)
                               << " shader from the file " << entry.filename << std::endl;
-                    source = morph::gl::ReadShader (entry.filename);
+                    sources[i] = morph::gl::ReadShader (entry.filename);
                 } else {
                     if constexpr (debug_shaders == true) {
                         std::cout << "Using compiled-in " << morph::gl::shader_type_str(entry.type) << " shader\n";
                     }
-                    source = morph::gl::ReadDefaultShader (entry.compiledIn);
+                    sources[i] = morph::gl::ReadDefaultShader (entry.compiledIn);
                 }
-                if (source == nullptr) {
-                    for (auto entry : shader_info) {
-                        glDeleteShader (entry.shader);
-                        entry.shader = 0;
-                    }
-                    return 0;
+                if (sources[i] == nullptr) { return 0; }
+            }
 
-                } else {
-                    if constexpr (debug_shaders == true) {
-                        std::cout << "Compiling this shader: \n" << "-----\n";
-                        std::cout << source.get() << "-----\n";
+            // Try the on-disk program binary cache before compiling anything. The key
+            // hashes the driver's identity strings along with every shader source, so
+            // a driver update or GLSL change is a simple cache miss.
+            std::string cache_file;
+#ifdef GL_PROGRAM_BINARY_LENGTH
+            if (morph::gl::shadercache_disabled() == false) {
+                GLint nformats = 0;
+                glGetIntegerv (GL_NUM_PROGRAM_BINARY_FORMATS, &nformats);
+                std::string cache_dir = nformats > 0 ? morph::gl::shadercache_dir() : std::string("");
+                if (cache_dir.empty() == false) {
+                    uint64_t h = morph::gl::shadercache_hash_init;
+                    morph::gl::shadercache_fold (h, reinterpret_cast<const char*>(glGetString (GL_VENDOR)));
+                    morph::gl::shadercache_fold (h, reinterpret_cast<const char*>(glGetString (GL_RENDERER)));
+                    morph::gl::shadercache_fold (h, reinterpret_cast<const char*>(glGetString (GL_VERSION)));
+                    for (auto& src : sources) { morph::gl::shadercache_fold (h, src.get()); }
+                    cache_file = morph::gl::shadercache_path (cache_dir, h);
+
+                    uint32_t bin_format = 0;
+                    std::vector<unsigned char> bin_blob;
+                    if (morph::gl::shadercache_read (cache_file, bin_format, bin_blob)) {
+                        GLuint cached = glCreateProgram();
+                        glProgramBinary (cached, static_cast<GLenum>(bin_format),
+                                         bin_blob.data(), static_cast<GLsizei>(bin_blob.size()));
+                        GLint bin_linked = 0;
+                        glGetProgramiv (cached, GL_LINK_STATUS, &bin_linked);
+                        glGetError(); // a rejected binary may raise GL_INVALID_ENUM; clear it
+                        if (bin_linked) {
+                            if constexpr (debug_shaders == true) {
+                                std::cout << "Loaded program binary from " << cache_file << std::endl;
+                            }
+                            return cached;
+                        }
+                        // The driver rejected the binary (stale format?); fall through
+                        // and recompile, which will overwrite the cache entry
+                        glDeleteProgram (cached);
                     }
                 }
-                GLint slen = (GLint)strlen (source.get());
-                const GLchar* sptr = source.get();
-                glShaderSource (shader, 1, &sptr, &slen);
+            }
+#endif
+            GLuint program = glCreateProgram();
+
+            for (std::size_t i = 0; i < shader_info.size(); ++i) {
+                const auto& entry = shader_info[i];
+                GLuint shader = glCreateShader (entry.type);
+                const GLchar* source = sources[i].get();
+                if constexpr (debug_shaders == true) {
+                    std::cout << "Compiling this shader: \n" << "-----\n";
+                    std::cout << source << "-----\n";
+                }
+                GLint slen = (GLint)strlen (source);
+                glShaderSource (shader, 1, &source, &slen);
                 glCompileShader (shader);
                 GLint shaderCompileSuccess = GL_FALSE;
                 char infoLog[512];
@@ -77,7 +115,7 @@ namespace morph {
                     glGetShaderInfoLog(shader, 512, NULL, infoLog);
                     std::cerr << "\nShader compilation failed!";
                     std::cerr << "\n--------------------------\n\n";
-                    std::cerr << source.get();
+                    std::cerr << source;
                     std::cerr << "\n\n--------------------------\n";
                     std::cerr << infoLog << std::endl;
                     std::cerr << "Exiting.\n";
@@ -101,6 +139,12 @@ namespace morph {
                 glDeleteShader (shader); // Note it's correct to glDeleteShader after attaching it to program
             }
 
+#ifdef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+            // Ask for a retrievable binary so the linked program can be cached
+            if (cache_file.empty() == false) {
+                glProgramParameteri (program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+            }
+#endif
             GLint linked = 0;
             glLinkProgram (program);
             glGetProgramiv (program, GL_LINK_STATUS, &linked);
@@ -116,6 +160,24 @@ namespace morph {
                 exit (5);
             } // else successfully linked
 
+#ifdef GL_PROGRAM_BINARY_LENGTH
+            // Cache the freshly linked program for the next run
+            if (cache_file.empty() == false) {
+                GLint blen = 0;
+                glGetProgramiv (program, GL_PROGRAM_BINARY_LENGTH, &blen);
+                if (blen > 0) {
+                    std::vector<unsigned char> bin_blob (static_cast<std::size_t>(blen));
+                    GLenum bin_format = 0;
+                    GLsizei got = 0;
+                    glGetProgramBinary (program, blen, &got, &bin_format, bin_blob.data());
+                    if (got > 0) {
+                        bin_blob.resize (static_cast<std::size_t>(got));
+                        morph::gl::shadercache_write (cache_file, static_cast<uint32_t>(bin_format), bin_blob);
+                    }
+                }
+                glGetError(); // clear any error from an unsupported retrieval
+            }
+#endif
             return program;
         }
     } // namespace gl
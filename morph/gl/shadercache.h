@@ -0,0 +1,119 @@
+#pragma once
+
+/*
+ * An on-disk cache of linked GL shader program binaries, used by LoadShaders
+ * (morph/gl/loadshaders_nomx.h) and LoadShadersMX (morph/gl/loadshaders_mx.h) to avoid
+ * recompiling the GLSL on every morph::Visual construction. Cache entries are keyed by
+ * a hash of the shader sources together with the driver's identity strings, so a driver
+ * update or a change to the GLSL simply misses the cache and recompiles. Set the
+ * environment variable MORPH_NO_SHADER_CACHE to disable the cache entirely.
+ *
+ * Note: This file contains no GL calls; retrieving and installing the binaries (which
+ * needs glGetProgramBinary/glProgramBinary) happens in the LoadShaders functions.
+ *
+ * Author: Seb James.
+ */
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <filesystem>
+
+namespace morph {
+
+    namespace gl {
+
+        //! Returns true if the user has disabled the shader binary cache by setting the
+        //! environment variable MORPH_NO_SHADER_CACHE
+        inline bool shadercache_disabled()
+        {
+            return std::getenv ("MORPH_NO_SHADER_CACHE") != nullptr;
+        }
+
+        /*!
+         * Return the shader binary cache directory, creating it if necessary. This is
+         * $XDG_CACHE_HOME/morphologica/shaders when XDG_CACHE_HOME is set, otherwise
+         * $HOME/.cache/morphologica/shaders. Returns an empty string if no suitable
+         * location exists or the directory could not be created (the caller should
+         * then just compile without caching).
+         */
+        inline std::string shadercache_dir()
+        {
+            std::string base;
+            const char* xdg = std::getenv ("XDG_CACHE_HOME");
+            if (xdg != nullptr && xdg[0] != '\0') {
+                base = xdg;
+            } else {
+                const char* home = std::getenv ("HOME");
+                if (home == nullptr || home[0] == '\0') { return std::string(""); }
+                base = std::string(home) + "/.cache";
+            }
+            std::string dir = base + "/morphologica/shaders";
+            std::error_code ec;
+            std::filesystem::create_directories (dir, ec);
+            if (ec) { return std::string(""); }
+            return dir;
+        }
+
+        //! Fold the characters of the null-terminated string \a str into the FNV-1a
+        //! hash \a h. Initialise h with shadercache_hash_init before the first fold.
+        inline void shadercache_fold (uint64_t& h, const char* str)
+        {
+            if (str == nullptr) { return; }
+            while (*str != '\0') {
+                h ^= static_cast<uint64_t>(static_cast<unsigned char>(*str++));
+                h *= 0x100000001b3ULL;
+            }
+        }
+
+        //! The FNV-1a offset basis, with which to initialise a shadercache hash
+        constexpr uint64_t shadercache_hash_init = 0xcbf29ce484222325ULL;
+
+        //! The cache file path for the program whose key hashed to \a h
+        inline std::string shadercache_path (const std::string& dir, const uint64_t h)
+        {
+            char fname[24];
+            std::snprintf (fname, sizeof(fname), "%016llx.bin", static_cast<unsigned long long>(h));
+            return dir + "/" + fname;
+        }
+
+        /*!
+         * Read a cached program binary: the file holds the 4 byte binary format
+         * followed by the blob. Returns false on any problem (no file, short file),
+         * in which case the caller compiles from source as usual.
+         */
+        inline bool shadercache_read (const std::string& path, uint32_t& format, std::vector<unsigned char>& blob)
+        {
+            std::ifstream f (path, std::ios::in | std::ios::binary);
+            if (!f.is_open()) { return false; }
+            f.read (reinterpret_cast<char*>(&format), sizeof(format));
+            if (!f.good()) { return false; }
+            blob.assign (std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+            return blob.empty() == false;
+        }
+
+        //! Write a program binary into the cache, via a temporary file and a rename so
+        //! that a part-written entry is never visible to another process. Failures are
+        //! silently ignored; the cache is only ever an optimisation.
+        inline void shadercache_write (const std::string& path, const uint32_t format, const std::vector<unsigned char>& blob)
+        {
+            if (blob.empty()) { return; }
+            std::string tmp = path + ".tmp";
+            {
+                std::ofstream f (tmp, std::ios::out | std::ios::binary | std::ios::trunc);
+                if (!f.is_open()) { return; }
+                f.write (reinterpret_cast<const char*>(&format), sizeof(format));
+                f.write (reinterpret_cast<const char*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+                if (!f.good()) { return; }
+            }
+            std::error_code ec;
+            std::filesystem::rename (tmp, path, ec);
+            if (ec) { std::filesystem::remove (tmp, ec); }
+        }
+
+    } // namespace gl
+} // namespace
@@ -87,6 +87,10 @@ namespace morph {
                 type = "vertex";
             } else if (shader_type == GL_FRAGMENT_SHADER) {
                 type = "fragment";
+#ifdef GL_GEOMETRY_SHADER
+            } else if (shader_type == GL_GEOMETRY_SHADER) {
+                type = "geometry";
+#endif
 #ifdef GL_COMPUTE_SHADER
             } else if (shader_type == GL_COMPUTE_SHADER) {
                 type = "compute";
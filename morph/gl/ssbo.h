@@ -10,6 +10,8 @@
  */
 
 #include <cstddef>
+#include <span>
+#include <stdexcept>
 #include <morph/vec.h>
 #include <morph/vvec.h>
 #include <morph/range.h>
@@ -88,6 +90,126 @@ namespace morph {
             }
         };
 
+        // A multi-buffered SSBO, for overlapping CPU writes with GPU compute dispatches.
+        //
+        // Where morph::gl::ssbo is a single buffer (so that writing new data for the next
+        // dispatch serializes on the driver until the previous dispatch has finished with the
+        // buffer), this wrapper rotates through nbuf buffer objects. You write into one slot
+        // while the GPU reads another:
+        //
+        //   auto s = my_ssbo.acquire_write_span();    // maps the next free slot
+        //   /* fill s[0] .. s[N-1] */
+        //   my_ssbo.commit_write();                   // unmaps; binds the slot to the GLSL index
+        //   /* glDispatchCompute / glMemoryBarrier */
+        //   my_ssbo.fence();                          // fence the dispatch that uses the slot
+        //
+        // acquire_write_span() client-waits on a slot's fence only if the GPU has not yet
+        // finished the dispatch that last used it, so with nbuf >= 2 the wait is normally zero.
+        //
+        // @tparam index: The index of the buffer binding, used in the GLSL
+        // @tparam T: The type of the data in the SSBO
+        // @tparam N: The number of elements of type T in the SSBO
+        // @tparam nbuf: How many buffers to rotate through (2 for double-buffering; 3 allows
+        // upload, dispatch and readback to overlap)
+        template <unsigned int index, typename T, std::size_t N, unsigned int nbuf = 3>
+        struct ssbo_multi
+        {
+            static_assert (nbuf > 1, "ssbo_multi needs at least 2 buffers; use morph::gl::ssbo for 1");
+
+            // The names of the buffers, generated with glGenBuffers()
+            unsigned int names[nbuf] = { 0 };
+            // A fence for each buffer, inserted by fence() after the dispatch that uses it
+            GLsync fences[nbuf] = { nullptr };
+            // The slot currently bound to the GLSL binding index
+            unsigned int current = 0;
+            // The slot that acquire_write_span() has mapped, awaiting commit_write()
+            unsigned int writing = 0;
+
+            ssbo_multi() {}
+            ~ssbo_multi() {}
+
+            // Init is not built into the constructor, as client code must ensure there is an OpenGL context available
+            void init()
+            {
+                glGenBuffers (nbuf, this->names);
+                for (unsigned int b = 0; b < nbuf; ++b) {
+                    glBindBuffer (GL_SHADER_STORAGE_BUFFER, this->names[b]);
+                    glBufferData (GL_SHADER_STORAGE_BUFFER, N * sizeof(T), nullptr, GL_DYNAMIC_DRAW);
+                }
+                glBindBuffer (GL_SHADER_STORAGE_BUFFER, 0);
+                glBindBufferBase (GL_SHADER_STORAGE_BUFFER, index, this->names[this->current]);
+                morph::gl::Util::checkError (__FILE__, __LINE__);
+            }
+
+            // Map the next free slot for writing, first waiting out any fence that shows the GPU
+            // is still using it. Returns a span of N elements of CPU-accessible memory.
+            std::span<T> acquire_write_span()
+            {
+                this->writing = (this->current + 1) % nbuf;
+                this->wait_slot (this->writing);
+                glBindBuffer (GL_SHADER_STORAGE_BUFFER, this->names[this->writing]);
+                T* cpuptr = static_cast<T*>(glMapBufferRange (GL_SHADER_STORAGE_BUFFER, 0, N * sizeof(T),
+                                                              GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+                morph::gl::Util::checkError (__FILE__, __LINE__);
+                if (cpuptr == nullptr) { throw std::runtime_error ("ssbo_multi: glMapBufferRange failed"); }
+                return std::span<T> (cpuptr, N);
+            }
+
+            // Unmap the span obtained from acquire_write_span() and bind its slot to the GLSL
+            // binding index, ready for the next dispatch
+            void commit_write()
+            {
+                glBindBuffer (GL_SHADER_STORAGE_BUFFER, this->names[this->writing]);
+                glUnmapBuffer (GL_SHADER_STORAGE_BUFFER);
+                glBindBufferBase (GL_SHADER_STORAGE_BUFFER, index, this->names[this->writing]);
+                glBindBuffer (GL_SHADER_STORAGE_BUFFER, 0);
+                morph::gl::Util::checkError (__FILE__, __LINE__);
+                this->current = this->writing;
+            }
+
+            // Insert a fence after the dispatch (or draw) that reads/writes the current slot, so
+            // that acquire_write_span() knows when the slot is free again
+            void fence()
+            {
+                if (this->fences[this->current] != nullptr) { glDeleteSync (this->fences[this->current]); }
+                this->fences[this->current] = glFenceSync (GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            }
+
+            // Map the current slot for reading back results (call after a glMemoryBarrier for
+            // compute-written data). Unmap with release_read_span().
+            std::span<const T> acquire_read_span()
+            {
+                this->wait_slot (this->current);
+                glBindBuffer (GL_SHADER_STORAGE_BUFFER, this->names[this->current]);
+                const T* cpuptr = static_cast<const T*>(glMapBufferRange (GL_SHADER_STORAGE_BUFFER, 0, N * sizeof(T),
+                                                                          GL_MAP_READ_BIT));
+                morph::gl::Util::checkError (__FILE__, __LINE__);
+                if (cpuptr == nullptr) { throw std::runtime_error ("ssbo_multi: glMapBufferRange failed"); }
+                return std::span<const T> (cpuptr, N);
+            }
+
+            void release_read_span()
+            {
+                glBindBuffer (GL_SHADER_STORAGE_BUFFER, this->names[this->current]);
+                glUnmapBuffer (GL_SHADER_STORAGE_BUFFER);
+                glBindBuffer (GL_SHADER_STORAGE_BUFFER, 0);
+                morph::gl::Util::checkError (__FILE__, __LINE__);
+            }
+
+        private:
+            // Client-wait on the fence for the given slot (if any), then clean the fence up
+            void wait_slot (const unsigned int slot)
+            {
+                if (this->fences[slot] == nullptr) { return; }
+                GLenum ws = GL_TIMEOUT_EXPIRED;
+                while (ws == GL_TIMEOUT_EXPIRED) {
+                    ws = glClientWaitSync (this->fences[slot], GL_SYNC_FLUSH_COMMANDS_BIT, GLuint64{1000000});
+                }
+                glDeleteSync (this->fences[slot]);
+                this->fences[slot] = nullptr;
+            }
+        };
+
         // Set up a Shader Storage Buffer Object (SSBO) and buffer data into it (from a morph::vvec)
         template<typename T>
         void setup_ssbo (const GLuint target_index, unsigned int& ssbo_id, const morph::vvec<T>& data)
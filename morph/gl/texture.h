@@ -62,6 +62,211 @@ namespace morph {
             }
         }
 
+        /*!
+         * texture_streamer: stream frames of pixel data (live camera images, simulation
+         * output) into a GL texture without a client-memory glTexImage2D on every
+         * update. A ring of pixel-unpack buffers (PBOs) decouples the producer from the
+         * GPU: the caller writes each frame into the pointer returned by acquire() and
+         * then calls commit(), which issues a glTexSubImage2D sourced from the PBO - a
+         * DMA transfer that the driver overlaps with rendering. When the context offers
+         * GL 4.4 buffer storage, the PBOs are persistently and coherently mapped once
+         * at init, so acquire() costs nothing but a fence wait; otherwise each
+         * acquire() orphans the buffer and re-maps it with glMapBufferRange, which
+         * avoids stalling on a buffer the GPU is still reading from.
+         *
+         * Usage:
+         * \code
+         *   morph::gl::texture_streamer ts;
+         *   ts.init (0, {640, 480}); // GL_RGBA8/GL_RGBA/GL_UNSIGNED_BYTE by default
+         *   while (havemoreframes) {
+         *       void* dst = ts.acquire();
+         *       memcpy (dst, camera_frame, ts.frame_bytes); // or write pixels in place
+         *       ts.commit();
+         *   }
+         *   ts.deinit();
+         * \endcode
+         *
+         * Requires a current OpenGL context for every call, as do the setup_texture
+         * functions above.
+         */
+        struct texture_streamer
+        {
+            //! The number of buffers in the PBO ring. Three allows the CPU to fill one
+            //! frame while the driver transfers a second and the GPU samples a third.
+            static constexpr unsigned int npbos = 3;
+
+            //! The texture that receives the streamed frames
+            GLuint texture_id = 0;
+            //! The ring of pixel-unpack buffer objects
+            GLuint pbos[npbos] = { 0, 0, 0 };
+            //! Persistent mapping pointers, one per PBO (persistent path only)
+            void* maps[npbos] = { nullptr, nullptr, nullptr };
+            //! Fences guarding each PBO against overwrite while the GPU reads it
+            GLsync fences[npbos] = { nullptr, nullptr, nullptr };
+            //! The frame size in pixels
+            morph::vec<GLsizei, 2> dims = { 0, 0 };
+            //! The pixel format and type of the client frames (args to glTexSubImage2D)
+            GLenum pixel_format = GL_RGBA;
+            GLenum pixel_type = GL_UNSIGNED_BYTE;
+            //! The size of one frame in bytes; write exactly this much into acquire()'s pointer
+            std::size_t frame_bytes = 0;
+            //! True when the PBOs are persistently mapped (GL 4.4 buffer storage)
+            bool persistent = false;
+            //! The ring slot that the next acquire()/commit() pair will use
+            unsigned int head = 0;
+            //! Set between acquire() and commit(); guards against mismatched calls
+            bool acquired = false;
+
+            /*!
+             * Create the destination texture (immutable storage, \a internal_format)
+             * and the PBO ring. \a bytes_per_pixel must match \a pixel_format and \a
+             * pixel_type (4 for the default GL_RGBA/GL_UNSIGNED_BYTE). The texture is
+             * bound to \a texture_unit with linear filtering, suitable for video-like
+             * content.
+             */
+            void init (const GLuint texture_unit, const morph::vec<GLsizei, 2> _dims,
+                       const GLenum internal_format = GL_RGBA8,
+                       const GLenum _pixel_format = GL_RGBA, const GLenum _pixel_type = GL_UNSIGNED_BYTE,
+                       const std::size_t bytes_per_pixel = 4)
+            {
+                this->dims = _dims;
+                this->pixel_format = _pixel_format;
+                this->pixel_type = _pixel_type;
+                this->frame_bytes = static_cast<std::size_t>(this->dims[0]) * static_cast<std::size_t>(this->dims[1]) * bytes_per_pixel;
+
+                glActiveTexture (GL_TEXTURE0 + texture_unit);
+                glGenTextures (1, &this->texture_id);
+                glBindTexture (GL_TEXTURE_2D, this->texture_id);
+                glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+                glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+                glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+                glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+                glTexStorage2D (GL_TEXTURE_2D, 1, internal_format, this->dims[0], this->dims[1]);
+                morph::gl::Util::checkError (__FILE__, __LINE__);
+
+                glGenBuffers (npbos, this->pbos);
+#ifdef GL_MAP_PERSISTENT_BIT
+                // Persistent, coherent mapping: map each PBO once, write into it for
+                // ever more. Requires GL 4.4/ARB_buffer_storage.
+                this->persistent = true;
+                for (unsigned int i = 0; i < npbos; ++i) {
+                    glBindBuffer (GL_PIXEL_UNPACK_BUFFER, this->pbos[i]);
+                    glBufferStorage (GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(this->frame_bytes), nullptr,
+                                     GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+                    this->maps[i] = glMapBufferRange (GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(this->frame_bytes),
+                                                      GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+                    if (this->maps[i] == nullptr) {
+                        throw std::runtime_error ("texture_streamer::init: glMapBufferRange (persistent) failed");
+                    }
+                }
+#else
+                // No buffer storage at compile time; fall back to orphaned re-mapping
+                this->persistent = false;
+                for (unsigned int i = 0; i < npbos; ++i) {
+                    glBindBuffer (GL_PIXEL_UNPACK_BUFFER, this->pbos[i]);
+                    glBufferData (GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(this->frame_bytes), nullptr, GL_STREAM_DRAW);
+                }
+#endif
+                glBindBuffer (GL_PIXEL_UNPACK_BUFFER, 0);
+                morph::gl::Util::checkError (__FILE__, __LINE__);
+            }
+
+            /*!
+             * Return a write-only pointer to frame_bytes of memory for the next frame.
+             * Waits (on a fence) only if the GPU has not finished with this ring slot,
+             * which with npbos slots means the producer is more than npbos frames ahead
+             * of the renderer.
+             */
+            void* acquire()
+            {
+                if (this->acquired == true) {
+                    throw std::runtime_error ("texture_streamer::acquire: commit() the previous frame first");
+                }
+                if (this->fences[this->head] != nullptr) {
+                    glClientWaitSync (this->fences[this->head], GL_SYNC_FLUSH_COMMANDS_BIT, GLuint64{1000000000});
+                    glDeleteSync (this->fences[this->head]);
+                    this->fences[this->head] = nullptr;
+                }
+                void* ptr = nullptr;
+                if (this->persistent == true) {
+                    ptr = this->maps[this->head];
+                } else {
+                    glBindBuffer (GL_PIXEL_UNPACK_BUFFER, this->pbos[this->head]);
+                    // Orphan the buffer so the driver can hand us fresh storage if the
+                    // old storage is still in flight, then map it
+                    glBufferData (GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(this->frame_bytes), nullptr, GL_STREAM_DRAW);
+                    ptr = glMapBufferRange (GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(this->frame_bytes),
+                                            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+                    if (ptr == nullptr) {
+                        throw std::runtime_error ("texture_streamer::acquire: glMapBufferRange failed");
+                    }
+                }
+                this->acquired = true;
+                return ptr;
+            }
+
+            //! Upload the frame written since acquire() into the texture (a
+            //! driver-side DMA transfer from the PBO) and advance the ring.
+            void commit()
+            {
+                if (this->acquired == false) {
+                    throw std::runtime_error ("texture_streamer::commit: acquire() a frame first");
+                }
+                glBindBuffer (GL_PIXEL_UNPACK_BUFFER, this->pbos[this->head]);
+                if (this->persistent == false) { glUnmapBuffer (GL_PIXEL_UNPACK_BUFFER); }
+                glBindTexture (GL_TEXTURE_2D, this->texture_id);
+                // With a pixel-unpack buffer bound, the data argument is an offset into the PBO
+                glTexSubImage2D (GL_TEXTURE_2D, 0, 0, 0, this->dims[0], this->dims[1],
+                                 this->pixel_format, this->pixel_type, nullptr);
+                this->fences[this->head] = glFenceSync (GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+                glBindBuffer (GL_PIXEL_UNPACK_BUFFER, 0);
+                this->head = (this->head + 1) % npbos;
+                this->acquired = false;
+            }
+
+            //! Delete the texture, the PBO ring and any outstanding fences
+            void deinit()
+            {
+                for (unsigned int i = 0; i < npbos; ++i) {
+                    if (this->fences[i] != nullptr) {
+                        glDeleteSync (this->fences[i]);
+                        this->fences[i] = nullptr;
+                    }
+                    if (this->persistent == true && this->maps[i] != nullptr) {
+                        glBindBuffer (GL_PIXEL_UNPACK_BUFFER, this->pbos[i]);
+                        glUnmapBuffer (GL_PIXEL_UNPACK_BUFFER);
+                        this->maps[i] = nullptr;
+                    }
+                }
+                glBindBuffer (GL_PIXEL_UNPACK_BUFFER, 0);
+                if (this->pbos[0] != 0) { glDeleteBuffers (npbos, this->pbos); }
+                for (unsigned int i = 0; i < npbos; ++i) { this->pbos[i] = 0; }
+                if (this->texture_id != 0) {
+                    glDeleteTextures (1, &this->texture_id);
+                    this->texture_id = 0;
+                }
+                this->acquired = false;
+                this->head = 0;
+            }
+        };
+
+        /*!
+         * Bind an externally created texture to \a texture_unit, so that frames which
+         * already live in GPU (or shared) memory reach a shader without any copy at
+         * all. \a external_texture_id is a texture name created outside morphologica -
+         * typically by importing a DMA-BUF file descriptor as an EGLImage and attaching
+         * it with glEGLImageTargetTexture2DOES, which is window-system territory and so
+         * stays with the caller. \a target is GL_TEXTURE_2D for ordinary imports;
+         * external-image extensions may require GL_TEXTURE_EXTERNAL_OES.
+         */
+        inline void attach_external_texture (const GLuint texture_unit, const GLuint external_texture_id,
+                                             const GLenum target = GL_TEXTURE_2D)
+        {
+            glActiveTexture (GL_TEXTURE0 + texture_unit);
+            glBindTexture (target, external_texture_id);
+            morph::gl::Util::checkError (__FILE__, __LINE__);
+        }
+
 #ifdef I_HAD_FIGURED_OUT_SETUP_TEXTURE_WITH_DATA_PROPERLY
 # define USE_IMMUTABLE_STORAGE 1 // Should use immutable texture storage in order to use glBindImageTexture
 
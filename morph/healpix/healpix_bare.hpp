@@ -431,4 +431,99 @@ namespace hp {
         return hp::loc2vec (hp::hpd2loc (nside, hp::nest2hpd (nside, ipix)));
     }
 
+    /*
+     * Bulk conversions. These take structure-of-arrays input/output (separate theta/phi or x/y/z
+     * arrays rather than arrays of t_ang/t_vec), so the trigonometry runs over contiguous data,
+     * and they are OpenMP-parallelized across pixels. For large maps (Nside=1024 is 12.6M pixels)
+     * they are much faster than per-pixel calls to the functions above.
+     */
+
+    /*!
+     * PUBLIC INTERFACE
+     * Fills \a theta and \a phi (each \a n elements) with the angular positions of the centres of
+     * pixels 0 to n-1 in NEST scheme at resolution \a nside.
+     */
+    void nest2ang_bulk (int64_t nside, int64_t n, double* theta, double* phi)
+    {
+#pragma omp parallel for
+        for (int64_t p = 0; p < n; ++p) {
+            t_ang a = hp::loc2ang (hp::hpd2loc (nside, hp::nest2hpd (nside, p)));
+            theta[p] = a.theta;
+            phi[p] = a.phi;
+        }
+    }
+
+    /*!
+     * PUBLIC INTERFACE
+     * Fills \a theta and \a phi (each \a n elements) with the angular positions of the centres of
+     * pixels 0 to n-1 in RING scheme at resolution \a nside.
+     */
+    void ring2ang_bulk (int64_t nside, int64_t n, double* theta, double* phi)
+    {
+#pragma omp parallel for
+        for (int64_t p = 0; p < n; ++p) {
+            t_ang a = hp::loc2ang (hp::hpd2loc (nside, hp::ring2hpd (nside, p)));
+            theta[p] = a.theta;
+            phi[p] = a.phi;
+        }
+    }
+
+    /*!
+     * PUBLIC INTERFACE
+     * Fills \a x, \a y and \a z (each \a n elements) with normalized 3-vectors pointing in the
+     * directions of the centres of pixels 0 to n-1 in NEST scheme at resolution \a nside.
+     */
+    void nest2vec_bulk (int64_t nside, int64_t n, double* x, double* y, double* z)
+    {
+#pragma omp parallel for
+        for (int64_t p = 0; p < n; ++p) {
+            t_vec v = hp::loc2vec (hp::hpd2loc (nside, hp::nest2hpd (nside, p)));
+            x[p] = v.x;
+            y[p] = v.y;
+            z[p] = v.z;
+        }
+    }
+
+    /*!
+     * PUBLIC INTERFACE
+     * Fills \a x, \a y and \a z (each \a n elements) with normalized 3-vectors pointing in the
+     * directions of the centres of pixels 0 to n-1 in RING scheme at resolution \a nside.
+     */
+    void ring2vec_bulk (int64_t nside, int64_t n, double* x, double* y, double* z)
+    {
+#pragma omp parallel for
+        for (int64_t p = 0; p < n; ++p) {
+            t_vec v = hp::loc2vec (hp::hpd2loc (nside, hp::ring2hpd (nside, p)));
+            x[p] = v.x;
+            y[p] = v.y;
+            z[p] = v.z;
+        }
+    }
+
+    /*!
+     * PUBLIC INTERFACE
+     * For each of the \a n angular positions in \a theta / \a phi, writes into \a ipix the pixel
+     * number in NEST scheme at resolution \a nside which contains that position.
+     */
+    void ang2nest_bulk (int64_t nside, int64_t n, const double* theta, const double* phi, int64_t* ipix)
+    {
+#pragma omp parallel for
+        for (int64_t p = 0; p < n; ++p) {
+            ipix[p] = hp::hpd2nest (nside, hp::loc2hpd (nside, hp::ang2loc (t_ang{theta[p], phi[p]})));
+        }
+    }
+
+    /*!
+     * PUBLIC INTERFACE
+     * For each of the \a n angular positions in \a theta / \a phi, writes into \a ipix the pixel
+     * number in RING scheme at resolution \a nside which contains that position.
+     */
+    void ang2ring_bulk (int64_t nside, int64_t n, const double* theta, const double* phi, int64_t* ipix)
+    {
+#pragma omp parallel for
+        for (int64_t p = 0; p < n; ++p) {
+            ipix[p] = hp::hpd2ring (nside, hp::loc2hpd (nside, hp::ang2loc (t_ang{theta[p], phi[p]})));
+        }
+    }
+
 } // namespace hp (for healpix)
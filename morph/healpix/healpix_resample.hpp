@@ -0,0 +1,66 @@
+/*!
+ * \file
+ *
+ * \brief OpenMP-parallel HEALPix map resampling (nside up/downgrade)
+ *
+ * \author Seb James
+ * \date 2025
+ */
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <morph/vvec.h>
+#include <morph/healpix/healpix_bare.hpp>
+
+namespace hp {
+
+    /*!
+     * Resample the NEST-ordered HEALPix map \a map_in from resolution \a nside_in to resolution
+     * \a nside_out (both must be powers of 2) and return the resampled map. In NEST ordering a
+     * pixel's descendants at higher resolutions are contiguous, so a downgrade averages each
+     * output pixel's block of input pixels and an upgrade replicates each input pixel into its
+     * block of output pixels; no angular conversions are needed. The loop over output pixels is
+     * OpenMP-parallelized.
+     */
+    template <typename T>
+    morph::vvec<T> map_resample_nest (const morph::vvec<T>& map_in,
+                                      const int64_t nside_in, const int64_t nside_out)
+    {
+        if (nside_in < 1 || (nside_in & (nside_in - 1)) != 0
+            || nside_out < 1 || (nside_out & (nside_out - 1)) != 0) {
+            throw std::runtime_error ("map_resample_nest: nside values must be powers of 2");
+        }
+        if (map_in.size() != static_cast<std::size_t>(hp::nside2npix (nside_in))) {
+            throw std::runtime_error ("map_resample_nest: map_in has the wrong size for nside_in");
+        }
+
+        int64_t npix_out = hp::nside2npix (nside_out);
+        morph::vvec<T> map_out (npix_out, T{0});
+
+        if (nside_out == nside_in) {
+            map_out = map_in;
+
+        } else if (nside_out < nside_in) {
+            // Downgrade: each output pixel is the mean of its (nside_in/nside_out)^2 descendants
+            int64_t f = nside_in / nside_out;
+            int64_t ratio = f * f;
+#pragma omp parallel for
+            for (int64_t p = 0; p < npix_out; ++p) {
+                T sum = T{0};
+                for (int64_t c = p * ratio; c < (p + 1) * ratio; ++c) { sum += map_in[c]; }
+                map_out[p] = sum / static_cast<T>(ratio);
+            }
+
+        } else {
+            // Upgrade: each output pixel takes the value of its ancestor
+            int64_t f = nside_out / nside_in;
+            int64_t ratio = f * f;
+#pragma omp parallel for
+            for (int64_t p = 0; p < npix_out; ++p) { map_out[p] = map_in[p / ratio]; }
+        }
+
+        return map_out;
+    }
+
+} // namespace hp (for healpix)
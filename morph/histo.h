@@ -42,6 +42,10 @@ namespace morph {
          * \tparam Allocator The memory allocator for the container. You don't usually need to
          * specify this.
          */
+        //! Default constructor. Used by morph::histo_engine, which fills the members of a
+        //! default-constructed histo itself.
+        histo() {}
+
         template < template <typename, typename> typename Container, typename Allocator=std::allocator<H> >
         histo (const Container<H, Allocator>& data, std::size_t n)
         {
@@ -189,4 +193,132 @@ namespace morph {
         //! The counts as proportions for each bin. n elements.
         morph::vvec<T> proportions;
     };
+
+    /*!
+     * A parallel, streaming histogram engine
+     *
+     * morph::histo makes two serial passes over its data (one for min/max, one for binning) and
+     * holds a copy of nothing, so it's fine for small datasets but slow for 10^8 samples. This
+     * engine has fixed bin edges (you provide the data range up front, which is what makes
+     * streaming possible), and each add_samples call makes a single fused pass that bins the
+     * samples *and* tracks the observed min/max, parallelized with per-thread local bin arrays
+     * that are merged at the end. Because the merge is a sum of integer counts, the result is
+     * identical whatever the thread count.
+     *
+     * Samples outside the given range are counted in histo_engine::underflow and
+     * histo_engine::overflow rather than throwing (data that arrives in chunks can't be
+     * range-checked up front).
+     *
+     * Workflow: construct -> add_samples() as data arrives -> get() for a filled-in morph::histo.
+     *
+     * \tparam H The type of the data from which to make the histogram.
+     * \tparam T The floating point type for proportions, etc.
+     */
+    template <typename H=float, typename T=float> requires std::is_floating_point_v<T>
+    struct histo_engine
+    {
+        //! Construct with the number of bins \a n and the data range \a _datarange, which fixes
+        //! the bin edges for the lifetime of the engine.
+        histo_engine (std::size_t n, const morph::range<H>& _datarange)
+        {
+            if (n == 0u) { throw std::runtime_error ("morph::histo_engine: need at least one bin"); }
+            if (_datarange.span() == H{0}) {
+                throw std::runtime_error ("morph::histo_engine: range span is 0, can't make a histogram");
+            }
+            this->datarange = _datarange;
+            this->observed.search_init();
+            this->counts.resize (n, 0u);
+        }
+
+        //! Bin \a nsamp samples at \a data in a single, parallel pass, also updating the
+        //! observed data range. May be called repeatedly for streaming data.
+        void add_samples (const H* data, const std::size_t nsamp)
+        {
+            const std::size_t n = this->counts.size();
+            const T d_span = static_cast<T>(this->datarange.span());
+            const std::ptrdiff_t ns = static_cast<std::ptrdiff_t>(nsamp);
+
+#pragma omp parallel
+            {
+                // Per-thread locals; merged under the critical section below. Without OpenMP,
+                // this block runs once and the code is simply the serial fused pass.
+                std::vector<std::size_t> local_counts (n, 0u);
+                morph::range<H> local_observed (morph::range_init::for_search);
+                std::size_t local_under = 0u;
+                std::size_t local_over = 0u;
+
+#pragma omp for nowait
+                for (std::ptrdiff_t i = 0; i < ns; ++i) {
+                    const H datum = data[i];
+                    local_observed.update (datum);
+                    const T bin_proportion = static_cast<T>(datum - this->datarange.min) / d_span;
+                    if (std::abs(bin_proportion - T{1}) < std::numeric_limits<T>::epsilon()) {
+                        // Edge case, right on t'limit. Place in last bin.
+                        local_counts[n - 1u] += 1u;
+                    } else if (bin_proportion > T{1}) {
+                        local_over += 1u;
+                    } else if (bin_proportion < T{0}) {
+                        local_under += 1u;
+                    } else {
+                        local_counts[static_cast<std::size_t>(std::floor(bin_proportion * n))] += 1u;
+                    }
+                }
+
+#pragma omp critical (morph_histo_engine_merge)
+                {
+                    for (std::size_t b = 0; b < n; ++b) { this->counts[b] += local_counts[b]; }
+                    if (local_observed.min <= local_observed.max) { // thread saw at least one sample
+                        this->observed.update (local_observed.min);
+                        this->observed.update (local_observed.max);
+                    }
+                    this->underflow += local_under;
+                    this->overflow += local_over;
+                }
+            }
+            this->datacount += nsamp;
+        }
+
+        //! add_samples overload for a container (anything with contiguous data() and size())
+        template < template <typename, typename> typename Container, typename Allocator=std::allocator<H> >
+        void add_samples (const Container<H, Allocator>& data)
+        {
+            this->add_samples (data.data(), data.size());
+        }
+
+        //! Return a filled-in morph::histo for the samples seen so far. In-range samples only;
+        //! check underflow/overflow if your range may not have encompassed the data.
+        morph::histo<H, T> get() const
+        {
+            const std::size_t n = this->counts.size();
+            morph::histo<H, T> h;
+            h.datarange = this->datarange;
+            h.datacount = this->datacount - this->underflow - this->overflow;
+            h.binwidth = static_cast<T>(this->datarange.span()) / static_cast<T>(n);
+            h.bins.resize (n, T{0});
+            h.binedges.resize (n + 1u, T{0});
+            for (std::size_t i = 0; i < n; ++i) {
+                h.bins[i] = i * h.binwidth;
+                h.binedges[i + 1u] = (i + 1u) * h.binwidth;
+            }
+            h.bins += (this->datarange.min + (h.binwidth / T{2}));
+            h.binedges += this->datarange.min;
+            h.counts = this->counts;
+            h.proportions = h.datacount > 0u ? this->counts.template as<T>() / static_cast<T>(h.datacount)
+                                             : morph::vvec<T>(n, T{0});
+            return h;
+        }
+
+        //! The fixed data range that defines the bin edges
+        morph::range<H> datarange;
+        //! The actual range of the samples seen so far (including any out-of-range samples)
+        morph::range<H> observed;
+        //! The counts for each bin
+        morph::vvec<std::size_t> counts;
+        //! The total number of samples seen (including any out-of-range samples)
+        std::size_t datacount = 0u;
+        //! The number of samples that fell below datarange.min
+        std::size_t underflow = 0u;
+        //! The number of samples that fell above datarange.max
+        std::size_t overflow = 0u;
+    };
 }
@@ -92,6 +92,12 @@ typedef void (*FJCVFreeFn)(void* userctx, void* p);
 // Same as above, but allows the client to use a custom allocator
 extern void jcv_diagram_generate_useralloc( int num_points, const jcv_point* points, const jcv_rect* rect, const jcv_clipper* clipper, void* userallocctx, FJCVAllocFn allocfn, FJCVFreeFn freefn, jcv_diagram* diagram );
 
+// Same as above, but for points which the client has already sorted with jcv_point_cmp ordering
+// (ascending y, then x); the internal qsort is skipped. indices[i] gives the original index to
+// record in site i (so jcv_site::index can still refer to the caller's unsorted array); it may be
+// null, in which case sites are indexed by their position in points.
+extern void jcv_diagram_generate_useralloc_presorted( int num_points, const jcv_point* points, const int* indices, const jcv_rect* rect, const jcv_clipper* clipper, void* userallocctx, FJCVAllocFn allocfn, FJCVFreeFn freefn, jcv_diagram* diagram );
+
 // Uses free (or the registered custom free function)
 extern void jcv_diagram_free( jcv_diagram* diagram );
 
@@ -1512,7 +1518,19 @@ static jcv_context_internal* jcv_alloc_internal(int num_points, void* userallocc
     return internal;
 }
 
+static void jcv_diagram_generate_internal(int num_points, const jcv_point* points, const int* indices, int presorted, const jcv_rect* rect, const jcv_clipper* clipper, void* userallocctx, FJCVAllocFn allocfn, FJCVFreeFn freefn, jcv_diagram* d);
+
 void jcv_diagram_generate_useralloc(int num_points, const jcv_point* points, const jcv_rect* rect, const jcv_clipper* clipper, void* userallocctx, FJCVAllocFn allocfn, FJCVFreeFn freefn, jcv_diagram* d)
+{
+    jcv_diagram_generate_internal(num_points, points, 0, 0, rect, clipper, userallocctx, allocfn, freefn, d);
+}
+
+void jcv_diagram_generate_useralloc_presorted(int num_points, const jcv_point* points, const int* indices, const jcv_rect* rect, const jcv_clipper* clipper, void* userallocctx, FJCVAllocFn allocfn, FJCVFreeFn freefn, jcv_diagram* d)
+{
+    jcv_diagram_generate_internal(num_points, points, indices, 1, rect, clipper, userallocctx, allocfn, freefn, d);
+}
+
+static void jcv_diagram_generate_internal(int num_points, const jcv_point* points, const int* indices, int presorted, const jcv_rect* rect, const jcv_clipper* clipper, void* userallocctx, FJCVAllocFn allocfn, FJCVFreeFn freefn, jcv_diagram* d)
 {
     if( d->internal )
         jcv_diagram_free( d );
@@ -1539,10 +1557,11 @@ void jcv_diagram_generate_useralloc(int num_points, const jcv_point* points, con
     {
         sites[i].p        = points[i];
         sites[i].edges    = 0;
-        sites[i].index    = i;
+        sites[i].index    = indices ? indices[i] : i;
     }
 
-    qsort(sites, (size_t)num_points, sizeof(jcv_site), jcv_point_cmp);
+    if( !presorted )
+        qsort(sites, (size_t)num_points, sizeof(jcv_site), jcv_point_cmp);
 
     jcv_clipper box_clipper;
     if (clipper == 0) {
@@ -12,12 +12,66 @@
 #include <vector>
 #include <string>
 #include <cstddef>
+#include <span>
 #include <stdexcept>
 #include <morph/vec.h>
 #include <morph/vvec.h>
 
 namespace morph {
 
+    /*
+     * Decode the PNG at \a filename into an 8 bit RGBA buffer, placing the image size in \a
+     * dims and throwing a descriptive runtime_error (prefixed \a caller) on failure. This is
+     * the common first step of all the loadpng flavours.
+     */
+    static inline std::vector<unsigned char> loadpng_decode_rgba (const std::string& filename,
+                                                                  morph::vec<unsigned int, 2>& dims,
+                                                                  const std::string& caller)
+    {
+        std::vector<unsigned char> png;
+        // Assume RGBA and bit depth of 8
+        unsigned lprtn = lodepng::decode (png, dims[0], dims[1], filename, LCT_RGBA, 8);
+        if (lprtn != 0) {
+            std::string err = caller + ": lodepng::decode returned error code "
+            + std::to_string(lprtn) + std::string(": ") + std::string(lodepng_error_text (lprtn));
+            throw std::runtime_error (err);
+        }
+        if (png.size() % 4 != 0) {
+            throw std::runtime_error (caller + ": Expect png vector to have size divisible by 4.");
+        }
+        return png;
+    }
+
+    /*
+     * Streaming, row-callback PNG decode.
+     *
+     * The \a row_callback is invoked once per image row, top row first, with the row index and
+     * a span of the row's RGBA bytes (4 bytes per pixel). Each row can thus be converted
+     * directly into the caller's target format - float mono, RGB, whatever - without loadpng
+     * allocating a converted copy of the whole image first. For very large images this saves
+     * the biggest of the temporaries (the converted copy); the one remaining intermediate is
+     * the raw RGBA buffer that lodepng's decoder emits.
+     *
+     * Example, converting into a pre-sized vvec<float> bottom-row first (as loadpng's default
+     * flip does):
+     *
+     *   morph::loadpng_stream (fn, [&img, h, w] (unsigned int row, std::span<const unsigned char> rgba) {
+     *       float* out = img.data() + (h - row - 1) * w;
+     *       for (unsigned int r = 0; r < w; ++r) { out[r] = (rgba[4*r] + rgba[4*r+1] + rgba[4*r+2]) / 765.0f; }
+     *   });
+     */
+    template <typename F>
+    static morph::vec<unsigned int, 2> loadpng_stream (const std::string& filename, F&& row_callback)
+    {
+        morph::vec<unsigned int, 2> dims = { 0, 0 };
+        std::vector<unsigned char> png = loadpng_decode_rgba (filename, dims, "morph::loadpng_stream");
+        const std::size_t stride = 4U * dims[0];
+        for (unsigned int row = 0; row < dims[1]; ++row) {
+            row_callback (row, std::span<const unsigned char> (png.data() + row * stride, stride));
+        }
+        return dims;
+    }
+
     /*
      * Wrap lodepng::decode to load a PNG from file, placing the data into the
      * image_data array. Figure out based on the type of T, how to scale the numbers.
@@ -37,62 +91,37 @@ namespace morph {
     static morph::vec<unsigned int, 2> loadpng (const std::string& filename, morph::vvec<T>& image_data,
                                                 const morph::vec<bool,2> flip = {false, true})
     {
-        std::vector<unsigned char> png;
-        unsigned int w = 0;
-        unsigned int h = 0;
-        // Assume RGBA and bit depth of 8
-        unsigned lprtn = lodepng::decode (png, w, h, filename, LCT_RGBA, 8);
-        if (lprtn != 0) {
-            std::string err = "morph::loadpng: lodepng::decode returned error code "
-            + std::to_string(lprtn) + std::string(": ") + std::string(lodepng_error_text (lprtn));
-            throw std::runtime_error (err);
-        }
-        // For return:
-        morph::vec<unsigned int, 2> dims = {w, h};
+        morph::vec<unsigned int, 2> dims = { 0, 0 };
+        std::vector<unsigned char> png = loadpng_decode_rgba (filename, dims, "morph::loadpng");
 
         // Now convert out into a value placed in image_data
         // If T is float or double, then get mean RGB, convert to range 0 to 1
         // If T is of integer type, then get mean and encode in range 0-255
 
-        unsigned int vsz = png.size();
-        if (vsz % 4 != 0) {
-            throw std::runtime_error ("morph::loadpng: Expect png vector to have size divisible by 4.");
-        }
-
-        image_data.resize (vsz/4);
+        image_data.resize (png.size()/4);
 
+        // The conversion is done a row at a time, with the flip logic hoisted out of the inner
+        // loop so that the common no-horizontal-flip case is a simple sequential pass which the
+        // compiler can vectorize.
         for (unsigned int c = 0; c < dims[1]; ++c) {
+            // The row's pixels in the png buffer
+            const unsigned char* prow = png.data() + 4 * std::size_t{dims[0]} * c;
+            // The first element of the output row; flip[1]==true is a vertical flip
+            T* orow = image_data.data() + std::size_t{dims[0]} * (flip[1] == true ? (dims[1]-c-1) : c);
             for (unsigned int r = 0; r < dims[0]; ++r) {
-                // Offset into png
-                unsigned int i = 4*r + 4*dims[0]*c;
-                // Offset into image_data depends on what flips the caller wants
-                unsigned int idx = flip[0] == true ?
-                (flip[1]==true ? ((dims[0]-r-1) + dims[0]*(dims[1]-c-1)) : ((dims[0]-r-1) + dims[0]*c))
-                : (flip[1]==true ? (r + dims[0]*(dims[1]-c-1)) : (r + dims[0]*c));
-
-                // The above unpacks as:
-
-                // flip[0]==false and flip[1]==false: (no flipping)
-                // idx = r + dims[0]*c
-
-                // flip[0]==false and flip[1]==true: (vertical flip)
-                // idx = (r + dims[0]*(dims[1]-c-1))
-
-                // flip[0]==true and flip[1]==false: (horizontal flip)
-                // ((dims[0]-r-1) + dims[0]*c))
-
-                // flip[0]==true and flip[1]==true:  (v-h flip)
-                // ((dims[0]-r-1) + dims[0]*(dims[1]-c-1))
+                const unsigned char* px = prow + 4*r;
+                // flip[0]==true is a horizontal flip; reverse the output order within the row
+                T& out = orow[flip[0] == true ? (dims[0]-r-1) : r];
 
                 if constexpr (std::is_same<std::decay_t<T>, float>::value == true
                               || std::is_same<std::decay_t<T>, double>::value == true) {
                     // monochrome 0-1 values
-                    image_data[idx] = (static_cast<T>(png[i] + png[i+1] + png[i+2]))/T{765}; // 3*255
+                    out = (static_cast<T>(px[0] + px[1] + px[2]))/T{765}; // 3*255
 
                 } else if constexpr (std::is_same<std::decay_t<T>, unsigned int>::value == true
                                      || std::is_same<std::decay_t<T>, unsigned char>::value == true) {
                     // monochrome, 0-255 values
-                    image_data[idx] = (static_cast<T>(png[i] + png[i+1] + png[i+2]))/T{3};
+                    out = (static_cast<T>(px[0] + px[1] + px[2]))/T{3};
 
                 } else {
                     // C++-20 mechanism to trigger a compiler error for the else case. Not user friendly!
@@ -119,71 +148,52 @@ namespace morph {
                                                 morph::vvec<morph::vec<T, N>>& image_data,
                                                 const morph::vec<bool,2> flip = {false, true})
     {
-        std::vector<unsigned char> png;
-        unsigned int w = 0;
-        unsigned int h = 0;
-        // Assume RGBA and bit depth of 8
-        unsigned lprtn = lodepng::decode (png, w, h, filename, LCT_RGBA, 8);
-        if (lprtn != 0) {
-            std::string err = "morph::loadpng: lodepng::decode returned error code "
-            + std::to_string(lprtn) + std::string(": ") + std::string(lodepng_error_text (lprtn));
-            throw std::runtime_error (err);
-        }
-        // For return:
-        morph::vec<unsigned int, 2> dims = {w, h};
+        morph::vec<unsigned int, 2> dims = { 0, 0 };
+        std::vector<unsigned char> png = loadpng_decode_rgba (filename, dims, "morph::loadpng");
 
         // Now convert out into a value placed in image_data
         // If T is float or double, then get mean RGB, convert to range 0 to 1
         // If T is of integer type, then get mean and encode in range 0-255
 
-        unsigned int vsz = png.size();
-        if (vsz % 4 != 0) {
-            throw std::runtime_error ("morph::loadpng: Expect png vector to have size divisible by 4.");
-        }
-
-        image_data.resize (vsz/4);
+        image_data.resize (png.size()/4);
 
+        // Row at a time, with the flip logic hoisted out of the inner loop (see the mono
+        // overload, above)
         for (unsigned int c = 0; c < dims[1]; ++c) {
+            const unsigned char* prow = png.data() + 4 * std::size_t{dims[0]} * c;
+            morph::vec<T, N>* orow = image_data.data() + std::size_t{dims[0]} * (flip[1] == true ? (dims[1]-c-1) : c);
             for (unsigned int r = 0; r < dims[0]; ++r) {
-
-                // Offset into png
-                unsigned int i = 4*r + 4*dims[0]*c;
-                // Offset into image_data depends on what flips the caller wants
-                unsigned int idx = flip[0] == true ?
-                (flip[1]==true ? ((dims[0]-r-1) + dims[0]*(dims[1]-c-1)) : ((dims[0]-r-1) + dims[0]*c))
-                : (flip[1]==true ? (r + dims[0]*(dims[1]-c-1)) : (r + dims[0]*c));
+                const unsigned char* px = prow + 4*r;
+                morph::vec<T, N>& out = orow[flip[0] == true ? (dims[0]-r-1) : r];
 
                 if constexpr ((std::is_same<std::decay_t<T>, float>::value == true
                                || std::is_same<std::decay_t<T>, double>::value == true) && N==3) {
                     // RGB, 0-1 values
-                    unsigned char p0 = png[i];
-                    unsigned char p1 = png[i+1];
-                    unsigned char p2 = png[i+2];
-                    image_data[idx] = { static_cast<T>(p0), static_cast<T>(p1), static_cast<T>(p2) };
-                    image_data[idx] /= T{255};
+                    out = { static_cast<T>(px[0]), static_cast<T>(px[1]), static_cast<T>(px[2]) };
+                    out /= T{255};
 
                 } else if constexpr ((std::is_same<std::decay_t<T>, float>::value == true
                                       || std::is_same<std::decay_t<T>, double>::value == true) && N==4) {
                     // RGBA 0-1 values
-                    image_data[idx][0] = static_cast<T>(png[i]) / T{255};
-                    image_data[idx][1] = static_cast<T>(png[i+1]) / T{255};
-                    image_data[idx][2] = static_cast<T>(png[i+2]) / T{255};
-                    image_data[idx][3] = static_cast<T>(png[i+3]) / T{255};
+                    out[0] = static_cast<T>(px[0]) / T{255};
+                    out[1] = static_cast<T>(px[1]) / T{255};
+                    out[2] = static_cast<T>(px[2]) / T{255};
+                    out[3] = static_cast<T>(px[3]) / T{255};
 
                 } else if constexpr ((std::is_same<std::decay_t<T>, unsigned char>::value == true
                                       || std::is_same<std::decay_t<T>, unsigned int>::value == true) && N==3) {
                     // RGB, 0-255 values
-                    image_data[idx][0] = static_cast<T>(png[i]);
-                    image_data[idx][1] = static_cast<T>(png[i+1]);
-                    image_data[idx][2] = static_cast<T>(png[i+2]);
+                    out[0] = static_cast<T>(px[0]);
+                    out[1] = static_cast<T>(px[1]);
+                    out[2] = static_cast<T>(px[2]);
 
                 } else if constexpr ((std::is_same<std::decay_t<T>, unsigned char>::value == true
                                       || std::is_same<std::decay_t<T>, unsigned int>::value == true) && N==4) {
                     // RGBA, 0-255 values
-                    image_data[idx][0] = static_cast<T>(png[i]);
-                    image_data[idx][1] = static_cast<T>(png[i+1]);
-                    image_data[idx][2] = static_cast<T>(png[i+2]);
-                    image_data[idx][3] = static_cast<T>(png[i+3]);
+                    out[0] = static_cast<T>(px[0]);
+                    out[1] = static_cast<T>(px[1]);
+                    out[2] = static_cast<T>(px[2]);
+                    out[3] = static_cast<T>(px[3]);
 
                 } else {
                     // C++-20 mechanism to trigger a compiler error for the else case. Not user friendly!
@@ -201,29 +211,14 @@ namespace morph {
     static morph::vec<unsigned int, 2> loadpng_rgb (const std::string& filename, morph::vvec<T>& image_data,
                                                     const morph::vec<bool,2> flip = {false, true})
     {
-        std::vector<unsigned char> png;
-        unsigned int w = 0;
-        unsigned int h = 0;
-        // Assume RGBA and bit depth of 8
-        unsigned lprtn = lodepng::decode (png, w, h, filename, LCT_RGBA, 8);
-        if (lprtn != 0) {
-            std::string err = "morph::loadpng_rgb: lodepng::decode returned error code "
-            + std::to_string(lprtn) + std::string(": ") + std::string(lodepng_error_text (lprtn));
-            throw std::runtime_error (err);
-        }
-        // For return:
-        morph::vec<unsigned int, 2> dims = {w, h};
+        morph::vec<unsigned int, 2> dims = { 0, 0 };
+        std::vector<unsigned char> png = loadpng_decode_rgba (filename, dims, "morph::loadpng_rgb");
 
         // Now convert out into a value placed in image_data
         // If T is float or double, then for each in RGB, convert to range 0 to 1
         // If T is of integer type, then for each in RGB encode in range 0-255
 
-        unsigned int vsz = png.size();
-        if (vsz % 4 != 0) {
-            throw std::runtime_error ("morph::loadpng_rgb: Expect png vector to have size divisible by 4.");
-        }
-
-        image_data.resize (3*vsz/4);
+        image_data.resize (3*png.size()/4);
 
         for (unsigned int c = 0; c < dims[1]; ++c) {
             for (unsigned int r = 0; r < dims[0]; ++r) {
@@ -266,29 +261,14 @@ namespace morph {
     static morph::vec<unsigned int, 2> loadpng_rgba (const std::string& filename, morph::vvec<T>& image_data,
                                                      const morph::vec<bool,2> flip = {false, true})
     {
-        std::vector<unsigned char> png;
-        unsigned int w = 0;
-        unsigned int h = 0;
-        // Assume RGBA and bit depth of 8
-        unsigned lprtn = lodepng::decode (png, w, h, filename, LCT_RGBA, 8);
-        if (lprtn != 0) {
-            std::string err = "morph::loadpng_rgba: lodepng::decode returned error code "
-            + std::to_string(lprtn) + std::string(": ") + std::string(lodepng_error_text(lprtn));
-            throw std::runtime_error (err);
-        }
-        // For return:
-        morph::vec<unsigned int, 2> dims = {w, h};
+        morph::vec<unsigned int, 2> dims = { 0, 0 };
+        std::vector<unsigned char> png = loadpng_decode_rgba (filename, dims, "morph::loadpng_rgba");
 
         // Now convert out into a value placed in image_data
         // If T is float or double, then get mean RGB, convert to range 0 to 1
         // If T is of integer type, then get mean and encode in range 0-255
 
-        unsigned int vsz = png.size();
-        if (vsz % 4 != 0) {
-            throw std::runtime_error ("morph::loadpng_rgba: Expect png vector to have size divisible by 4.");
-        }
-
-        image_data.resize (vsz);
+        image_data.resize (png.size());
 
         for (unsigned int c = 0; c < dims[1]; ++c) {
             for (unsigned int r = 0; r < dims[0]; ++r) {
@@ -334,19 +314,9 @@ namespace morph {
     static morph::vec<unsigned int, 2> loadpng_rgba (const std::string& filename, morph::vec<T, 4*im_w*im_h>& image_data,
                                                      const morph::vec<bool,2> flip = {false, true})
     {
-        std::vector<unsigned char> png;
-        unsigned int w = 0;
-        unsigned int h = 0;
-        // Assume RGBA and bit depth of 8
-        unsigned lprtn = lodepng::decode (png, w, h, filename, LCT_RGBA, 8);
-        if (lprtn != 0) {
-            std::string err = "morph::loadpng_rgba: lodepng::decode returned error code "
-            + std::to_string(lprtn) + std::string(": ") + std::string(lodepng_error_text(lprtn));
-            throw std::runtime_error (err);
-        }
-        // For return:
-        morph::vec<unsigned int, 2> dims = {w, h};
-        if (w != im_w || h != im_h) {
+        morph::vec<unsigned int, 2> dims = { 0, 0 };
+        std::vector<unsigned char> png = loadpng_decode_rgba (filename, dims, "morph::loadpng_rgba");
+        if (dims[0] != im_w || dims[1] != im_h) {
             throw std::runtime_error ("morph::loadpng_rgba: Expect png to be the size specified in the template args.");
         }
 
@@ -354,11 +324,6 @@ namespace morph {
         // If T is float or double, then get mean RGB, convert to range 0 to 1
         // If T is of integer type, then get mean and encode in range 0-255
 
-        unsigned int vsz = png.size();
-        if (vsz % 4 != 0) {
-            throw std::runtime_error ("morph::loadpng_rgba: Expect png vector to have size divisible by 4.");
-        }
-
         for (unsigned int c = 0; c < dims[1]; ++c) {
             for (unsigned int r = 0; r < dims[0]; ++r) {
                 // Offset into png
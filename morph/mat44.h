@@ -12,7 +12,10 @@
 #include <morph/quaternion.h>
 #include <morph/vec.h>
 #include <morph/constexpr_math.h>
+#include <morph/simd.h>
 #include <array>
+#include <span>
+#include <stdexcept>
 #include <string>
 #include <sstream>
 #include <iostream>
@@ -565,6 +568,11 @@ namespace morph {
         //! Right-multiply this->mat with m2.
         constexpr void operator*= (const std::array<F, 16>& m2) noexcept
         {
+#ifdef MORPH_HAVE_STD_SIMD
+            if (std::is_constant_evaluated() == false) {
+                if constexpr (morph::simd::simdable<F>) { this->mat = this->mult_simd (m2).mat; return; }
+            }
+#endif
             std::array<F, 16> result;
             // Top row
             result[0] = this->mat[0] * m2[0]
@@ -644,6 +652,11 @@ namespace morph {
         //! Right-multiply this->mat with m2.mat.
         constexpr void operator*= (const mat44<F>& m2) noexcept
         {
+#ifdef MORPH_HAVE_STD_SIMD
+            if (std::is_constant_evaluated() == false) {
+                if constexpr (morph::simd::simdable<F>) { this->mat = this->mult_simd (m2.mat).mat; return; }
+            }
+#endif
             std::array<F, 16> result;
             // Top row
             result[0] = this->mat[0] * m2.mat[0]
@@ -722,6 +735,11 @@ namespace morph {
 
         constexpr mat44<F> operator* (const std::array<F, 16>& m2) const noexcept
         {
+#ifdef MORPH_HAVE_STD_SIMD
+            if (std::is_constant_evaluated() == false) {
+                if constexpr (morph::simd::simdable<F>) { return this->mult_simd (m2); }
+            }
+#endif
             mat44<F> result;
             // Top row
             result.mat[0] = this->mat[0] * m2[0]
@@ -798,9 +816,114 @@ namespace morph {
             return result;
         }
 
+#ifdef MORPH_HAVE_STD_SIMD
+        /*!
+         * Runtime SIMD specialization of the 4x4 multiply. The columns of this matrix are loaded
+         * into 4-wide batches once; each column of the result is then a sum of scaled column
+         * batches. Called from the constexpr operator* functions when they are not being
+         * constant-evaluated (SIMD loads/stores cannot run at compile time).
+         */
+        mat44<F> mult_simd (const std::array<F, 16>& m2) const noexcept
+        {
+            namespace stdx = std::experimental;
+            using batch = stdx::fixed_size_simd<F, 4>;
+            mat44<F> result;
+            const batch a0 (this->mat.data(),      stdx::element_aligned);
+            const batch a1 (this->mat.data() + 4,  stdx::element_aligned);
+            const batch a2 (this->mat.data() + 8,  stdx::element_aligned);
+            const batch a3 (this->mat.data() + 12, stdx::element_aligned);
+            for (unsigned int j = 0; j < 4; ++j) {
+                batch r = a0 * m2[4*j] + a1 * m2[4*j+1] + a2 * m2[4*j+2] + a3 * m2[4*j+3];
+                r.copy_to (result.mat.data() + 4*j, stdx::element_aligned);
+            }
+            return result;
+        }
+
+        //! Runtime SIMD mat * vector for the vector (x, y, z, w). See mult_simd.
+        vec<F, 4> transform_simd (const F x, const F y, const F z, const F w) const noexcept
+        {
+            namespace stdx = std::experimental;
+            using batch = stdx::fixed_size_simd<F, 4>;
+            const batch a0 (this->mat.data(),      stdx::element_aligned);
+            const batch a1 (this->mat.data() + 4,  stdx::element_aligned);
+            const batch a2 (this->mat.data() + 8,  stdx::element_aligned);
+            const batch a3 (this->mat.data() + 12, stdx::element_aligned);
+            batch r = a0 * x + a1 * y + a2 * z + a3 * w;
+            vec<F, 4> v;
+            r.copy_to (v.data(), stdx::element_aligned);
+            return v;
+        }
+#endif // MORPH_HAVE_STD_SIMD
+
+        /*!
+         * Batched transform. Apply this matrix to each of the n coordinates at in, writing the
+         * results to out (out may alias in). The matrix columns are loaded once for the whole
+         * batch, so this is substantially faster than calling operator* per point.
+         */
+        void transform (const vec<F, 4>* in, vec<F, 4>* out, const std::size_t n) const noexcept
+        {
+#ifdef MORPH_HAVE_STD_SIMD
+            if constexpr (morph::simd::simdable<F>) {
+                namespace stdx = std::experimental;
+                using batch = stdx::fixed_size_simd<F, 4>;
+                const batch a0 (this->mat.data(),      stdx::element_aligned);
+                const batch a1 (this->mat.data() + 4,  stdx::element_aligned);
+                const batch a2 (this->mat.data() + 8,  stdx::element_aligned);
+                const batch a3 (this->mat.data() + 12, stdx::element_aligned);
+                for (std::size_t i = 0; i < n; ++i) {
+                    batch r = a0 * in[i][0] + a1 * in[i][1] + a2 * in[i][2] + a3 * in[i][3];
+                    r.copy_to (out[i].data(), stdx::element_aligned);
+                }
+                return;
+            }
+#endif
+            for (std::size_t i = 0; i < n; ++i) { out[i] = (*this) * in[i]; }
+        }
+
+        //! Batched transform of 3D coordinates, which are treated as having w=1 (as in the
+        //! single-point operator* for vec<F, 3>). out may not alias in (element sizes differ).
+        void transform (const vec<F, 3>* in, vec<F, 4>* out, const std::size_t n) const noexcept
+        {
+#ifdef MORPH_HAVE_STD_SIMD
+            if constexpr (morph::simd::simdable<F>) {
+                namespace stdx = std::experimental;
+                using batch = stdx::fixed_size_simd<F, 4>;
+                const batch a0 (this->mat.data(),      stdx::element_aligned);
+                const batch a1 (this->mat.data() + 4,  stdx::element_aligned);
+                const batch a2 (this->mat.data() + 8,  stdx::element_aligned);
+                const batch a3 (this->mat.data() + 12, stdx::element_aligned);
+                for (std::size_t i = 0; i < n; ++i) {
+                    batch r = a0 * in[i][0] + a1 * in[i][1] + a2 * in[i][2] + a3;
+                    r.copy_to (out[i].data(), stdx::element_aligned);
+                }
+                return;
+            }
+#endif
+            for (std::size_t i = 0; i < n; ++i) { out[i] = (*this) * in[i]; }
+        }
+
+        //! Batched transform with span arguments. Throws if the spans differ in size.
+        void transform (std::span<const vec<F, 4>> in, std::span<vec<F, 4>> out) const
+        {
+            if (in.size() != out.size()) { throw std::runtime_error ("mat44::transform: in/out spans differ in size"); }
+            this->transform (in.data(), out.data(), in.size());
+        }
+
+        //! Batched transform of 3D coordinates with span arguments. Throws if the spans differ in size.
+        void transform (std::span<const vec<F, 3>> in, std::span<vec<F, 4>> out) const
+        {
+            if (in.size() != out.size()) { throw std::runtime_error ("mat44::transform: in/out spans differ in size"); }
+            this->transform (in.data(), out.data(), in.size());
+        }
+
         //! Right multiply this->mat with m2.mat.
         constexpr mat44<F> operator* (const mat44<F>& m2) const noexcept
         {
+#ifdef MORPH_HAVE_STD_SIMD
+            if (std::is_constant_evaluated() == false) {
+                if constexpr (morph::simd::simdable<F>) { return this->mult_simd (m2.mat); }
+            }
+#endif
             mat44<F> result;
             // Top row
             result.mat[0] = this->mat[0] * m2.mat[0]
@@ -880,6 +1003,14 @@ namespace morph {
         //! Do matrix times vector multiplication, v = mat * v1
         constexpr std::array<F, 4> operator* (const std::array<F, 4>& v1) const noexcept
         {
+#ifdef MORPH_HAVE_STD_SIMD
+            if (std::is_constant_evaluated() == false) {
+                if constexpr (morph::simd::simdable<F>) {
+                    vec<F, 4> r = this->transform_simd (v1[0], v1[1], v1[2], v1[3]);
+                    return { r[0], r[1], r[2], r[3] };
+                }
+            }
+#endif
             std::array<F, 4> v;
             v[0] = this->mat[0] * v1[0]
                 + this->mat[4] * v1[1]
@@ -903,6 +1034,11 @@ namespace morph {
         //! Do matrix times vector multiplication, v = mat * v1
         constexpr vec<F, 4> operator* (const vec<F, 4>& v1) const noexcept
         {
+#ifdef MORPH_HAVE_STD_SIMD
+            if (std::is_constant_evaluated() == false) {
+                if constexpr (morph::simd::simdable<F>) { return this->transform_simd (v1.x(), v1.y(), v1.z(), v1.w()); }
+            }
+#endif
             vec<F, 4> v;
             v[0] = this->mat[0] * v1.x()
                 + this->mat[4] * v1.y()
@@ -926,6 +1062,11 @@ namespace morph {
         //! Do matrix times vector multiplication, v = mat * v1.
         constexpr vec<F, 4> operator* (const vec<F, 3>& v1) const noexcept
         {
+#ifdef MORPH_HAVE_STD_SIMD
+            if (std::is_constant_evaluated() == false) {
+                if constexpr (morph::simd::simdable<F>) { return this->transform_simd (v1.x(), v1.y(), v1.z(), F{1}); }
+            }
+#endif
             vec<F, 4> v;
             v[0] = this->mat[0] * v1.x()
                 + this->mat[4] * v1.y()
@@ -1065,6 +1206,40 @@ namespace morph {
             (*this) *= persMat;
         }
 
+        /*!
+         * Make a fully general (off-axis) perspective frustum projection, a la
+         * glFrustum. Unlike perspective(), the viewing volume need not be centred on
+         * the z axis, which is what allows a scene to be rendered in tiles: each tile
+         * gets the sub-rectangle of the full film plane that it covers.
+         *
+         * \param left The left edge of the near clipping rectangle
+         * \param right The right edge of the near clipping rectangle
+         * \param bottom The bottom edge of the near clipping rectangle
+         * \param top The top edge of the near clipping rectangle
+         * \param zNear The near/projection plane
+         * \param zFar The far plane
+         */
+        constexpr void frustum (const F left, const F right, const F bottom, const F top,
+                                const F zNear, const F zFar) noexcept
+        {
+            if (zNear == zFar || left == right || bottom == top) { return; }
+
+            F clip = zFar - zNear;
+
+            // Frustum matrix to multiply self by
+            std::array<F, 16> frusMat;
+            frusMat.fill (F{0});
+            frusMat[0] = (F{2} * zNear)/(right-left);   //       2n/(r-l)
+            frusMat[5] = (F{2} * zNear)/(top-bottom);   //       2n/(t-b)
+            frusMat[8] = (right+left)/(right-left);     //    (r+l)/(r-l)
+            frusMat[9] = (top+bottom)/(top-bottom);     //    (t+b)/(t-b)
+            frusMat[10] = -(zNear+zFar)/clip;           //   -(f+n)/(f-n)
+            frusMat[11] = F{-1};
+            frusMat[14] = -(F{2} * zNear * zFar)/clip;  //    -2fn/(f-n)
+
+            (*this) *= frusMat;
+        }
+
         /*!
          * Make an orthographic projection
          *
@@ -14,6 +14,7 @@
 #include <list>
 #include <sstream>
 #include <iostream>
+#include <cmath>
 #include <morph/vvec.h>
 #include <morph/nn/FeedForwardConn.h>
 
@@ -24,8 +25,13 @@ namespace morph {
          * An Elman network, in which an input layer feeds forward to a hidden layer,
          * which feeds forward to an output layer, and also back to a context (or
          * memory) layer, which then feeds forward to the hidden layer.
+         *
+         * \tparam prec The precision policy for the transfer function, threaded
+         * through to each FeedForwardConn. morph::mathprec::fast evaluates each
+         * layer's activations with the vectorized sigmoid kernel in morph/fastmath.h;
+         * the default is exact (std::exp per neuron).
          */
-        template <typename T>
+        template <typename T, morph::mathprec prec = morph::mathprec::exact>
         struct ElmanNet
         {
             //! Constructor takes a vector specifying the number of neurons in each layer (\a
@@ -66,7 +72,7 @@ namespace morph {
                             //std::cout << " AND input " << *cl << std::endl;
                         } // just the one input (for the final layer)
 
-                        morph::nn::FeedForwardConn<T> c(_inputs, &*l);
+                        morph::nn::FeedForwardConn<T, prec> c(_inputs, &*l);
                         c.randomize();
 
                         this->connections.push_back (c);
@@ -173,20 +179,26 @@ namespace morph {
                 this->desiredOutput = theOutput;
             }
 
-            //! Compute the cost (and delta_out) for the current input and desired output
+            //! Compute the cost (and delta_out) for the current input and desired
+            //! output. Computed in place - this makes no allocations once delta_out
+            //! has its size (so it is cheap to call every timestep of a long sequence).
             T computeCost()
             {
-                // Here is where we compute delta_out:
-                this->delta_out = (this->neurons.back()-desiredOutput) * (this->connections.back().sigmoid_prime_z_lplus1());
-                // And the cost:
-                morph::vvec<T> prediction = this->neurons.back();
-                // Want the prediction error, which is either correct or incorrect.
-                for (auto& p : prediction) {
-                    p = p > T{0.5} ? T{1} : T{0};
+                const morph::vvec<T>& out = this->neurons.back();
+                this->delta_out.resize (out.size());
+                T esq = T{0};
+                for (unsigned int j = 0; j < out.size(); ++j) {
+                    // delta_out = (out - desired) hadamard sigmoid_prime_z_lplus1
+                    // (the sigmoid derivative of output a is a * (1-a)):
+                    this->delta_out[j] = (out[j] - this->desiredOutput[j]) * (out[j] * (T{1} - out[j]));
+                    // Want the prediction error, which is either correct or incorrect:
+                    T p = out[j] > T{0.5} ? T{1} : T{0};
+                    T diff = this->desiredOutput[j] - p;
+                    esq += diff * diff;
                 }
-                T e = (desiredOutput-prediction).length();
+                T e = std::sqrt (esq);
                 // Elman seems to use '0.5 * binary error squared' for the cost:
-                this->cost = morph::nn::ElmanNet<T>::costKernel (e);
+                this->cost = ElmanNet::costKernel (e);
                 return this->cost;
             }
 
@@ -206,7 +218,7 @@ namespace morph {
             std::list<morph::vvec<T>> contextNeurons;
 
             //! Connections. There should be neurons.size()-1 connection layers:
-            std::list<morph::nn::FeedForwardConn<T>> connections;
+            std::list<morph::nn::FeedForwardConn<T, prec>> connections;
 
             //! The error (dC/dz) of the output layer
             morph::vvec<T> delta_out;
@@ -215,8 +227,8 @@ namespace morph {
             morph::vvec<T> desiredOutput;
         };
 
-        template <typename T>
-        std::ostream& operator<< (std::ostream& os, const morph::nn::ElmanNet<T>& el)
+        template <typename T, morph::mathprec prec>
+        std::ostream& operator<< (std::ostream& os, const morph::nn::ElmanNet<T, prec>& el)
         {
             os << el.str();
             return os;
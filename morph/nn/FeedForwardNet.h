@@ -11,6 +11,7 @@
 
 #include <morph/nn/FeedForwardConn.h>
 #include <morph/vvec.h>
+#include <cmath>
 #include <iostream>
 #include <list>
 #include <vector>
@@ -26,8 +27,14 @@ namespace morph {
          * A feedforward network class which holds a runtime-selectable set of neuron
          * layers and the connections between the layers. Note that in this class, the
          * connections are always between adjacent layers; from layer l to layer l+1.
+         *
+         * \tparam prec The precision policy for the sigmoid transfer function,
+         * threaded through to each FeedForwardConn and to the batched feedforward in
+         * computeBatchGradients. morph::mathprec::fast evaluates activations with the
+         * vectorized sigmoid kernel in morph/fastmath.h; the default is exact
+         * (std::exp per neuron).
          */
-        template <typename T>
+        template <typename T, morph::mathprec prec = morph::mathprec::exact>
         struct FeedForwardNet
         {
             //! Constructor takes a vector specifying the number of neurons in each layer (\a
@@ -51,7 +58,7 @@ namespace morph {
                         --l;
                         auto lm1 = l;
                         --lm1;
-                        morph::nn::FeedForwardConn<T> c(&*lm1, &*l);
+                        morph::nn::FeedForwardConn<T, prec> c(&*lm1, &*l);
                         c.randomize();
                         this->connections.push_back (c);
                     }
@@ -156,6 +163,170 @@ namespace morph {
                 }
             }
 
+            /*!
+             * Train on one minibatch in a single pass. The batch of inputs is fed
+             * through the network as a sample-major activation matrix per layer, so
+             * that the per-sample matrix-vector products of feedforward/backprop
+             * become matrix-matrix work (see FeedForwardConn::w_times_X), then the
+             * gradients are accumulated across the batch and one gradient update
+             *
+             *   v -> v' = v - eta * mean_gradient
+             *
+             * is applied per connection, exactly as the conventional
+             * setInput/feedforward/computeCost/backprop/update loop over the batch
+             * members would do. On return, each connection's nabla_ws and nabla_b
+             * hold the gradients summed over the batch; the per-sample neuron
+             * activations, delta_out and cost attributes are not modified.
+             *
+             * \param batchIns The batch of input patterns
+             * \param batchOuts The corresponding desired output patterns
+             * \param eta The learning rate
+             *
+             * \return The mean cost across the minibatch
+             */
+            T trainMiniBatch (const std::vector<morph::vvec<T>>& batchIns,
+                              const std::vector<morph::vvec<T>>& batchOuts, const T eta)
+            {
+                const unsigned int nb = batchIns.size();
+                if (nb == 0 || batchOuts.size() != nb) {
+                    std::stringstream ee;
+                    ee << "trainMiniBatch: batch sizes: " << nb << " inputs and "
+                       << batchOuts.size() << " desired outputs";
+                    throw std::runtime_error (ee.str());
+                }
+                T costsum = this->computeBatchGradients (batchIns.data(), batchOuts.data(), nb);
+                this->applyGradients (eta / static_cast<T>(nb));
+                return costsum / static_cast<T>(nb);
+            }
+
+            /*!
+             * The gradient computation part of trainMiniBatch. Feed nb input patterns
+             * through the network as a batch and accumulate the cost gradients (summed,
+             * not averaged, across the batch) into each connection's nabla_ws and
+             * nabla_b. No weight update is made; apply one with applyGradients. For
+             * nb==0 the gradients are zeroed. \return the cost summed across the batch.
+             */
+            T computeBatchGradients (const morph::vvec<T>* batchIns,
+                                     const morph::vvec<T>* batchOuts, const unsigned int nb)
+            {
+                for (auto& c : this->connections) {
+                    if (c.ins.size() != 1) {
+                        throw std::runtime_error ("computeBatchGradients: batched training is implemented "
+                                                  "for connections with a single input population");
+                    }
+                }
+                if (nb == 0) {
+                    for (auto& c : this->connections) {
+                        c.nabla_ws[0].zero();
+                        c.nabla_b.zero();
+                    }
+                    return T{0};
+                }
+
+                // One sample-major activation matrix (nb rows) per layer of neurons
+                const unsigned int n_layers = this->neurons.size();
+                std::vector<morph::vvec<T>> A (n_layers);
+                const unsigned int in_size = this->neurons.front().size();
+                A[0].resize (nb * in_size);
+                for (unsigned int s = 0; s < nb; ++s) {
+                    if (batchIns[s].size() != in_size) {
+                        throw std::runtime_error ("computeBatchGradients: input size does not match the input layer");
+                    }
+                    std::copy (batchIns[s].begin(), batchIns[s].end(), A[0].begin() + s * in_size);
+                }
+
+                // Feed the batch forward: A[l] = sigmoid (A[l-1] * W^T + b)
+                unsigned int l = 1;
+                for (auto& c : this->connections) {
+                    const unsigned int m = c.ins[0]->size();
+                    A[l].resize (nb * c.N);
+                    A[l].zero();
+                    FeedForwardConn<T, prec>::w_times_X (c.ws[0].data(), A[l-1].data(), A[l].data(), nb, c.N, m);
+                    if constexpr (prec == morph::mathprec::fast && (std::is_same_v<T, float> || std::is_same_v<T, double>)) {
+                        for (unsigned int s = 0; s < nb; ++s) {
+                            T* zrow = A[l].data() + s * c.N;
+                            for (unsigned int j = 0; j < c.N; ++j) { zrow[j] += c.b[j]; }
+                        }
+                        // One vectorized sigmoid over the whole layer's batch
+                        morph::fastmath::sigmoid (A[l].data(), A[l].data(), nb * c.N);
+                    } else {
+                        for (unsigned int s = 0; s < nb; ++s) {
+                            T* zrow = A[l].data() + s * c.N;
+                            for (unsigned int j = 0; j < c.N; ++j) {
+                                zrow[j] = T{1} / (T{1} + std::exp (-(zrow[j] + c.b[j])));
+                            }
+                        }
+                    }
+                    ++l;
+                }
+
+                // Output layer deltas, D(s,:) = (a - y) * sigmoid_prime(z), and the summed cost
+                const unsigned int n_out = this->neurons.back().size();
+                morph::vvec<T> D (nb * n_out, T{0});
+                T costsum = T{0};
+                for (unsigned int s = 0; s < nb; ++s) {
+                    if (batchOuts[s].size() != n_out) {
+                        throw std::runtime_error ("computeBatchGradients: desired output size does not match the output layer");
+                    }
+                    const T* arow = A[n_layers-1].data() + s * n_out;
+                    T* drow = D.data() + s * n_out;
+                    T lsq = T{0};
+                    for (unsigned int j = 0; j < n_out; ++j) {
+                        T diff = arow[j] - batchOuts[s][j];
+                        lsq += diff * diff;
+                        drow[j] = diff * arow[j] * (T{1} - arow[j]);
+                    }
+                    costsum += T{0.5} * lsq;
+                }
+
+                // Backpropagate, accumulating gradients over the batch, then update
+                auto citer = this->connections.end();
+                l = n_layers - 1;
+                while (citer != this->connections.begin()) {
+                    --citer;
+                    const unsigned int m = citer->ins[0]->size();
+                    const unsigned int n = citer->N;
+                    citer->nabla_ws[0].zero();
+                    citer->nabla_b.zero();
+                    const bool have_prev = (citer != this->connections.begin());
+                    morph::vvec<T> Dprev;
+                    if (have_prev) { Dprev.resize (nb * m, T{0}); }
+                    for (unsigned int s = 0; s < nb; ++s) {
+                        const T* drow = D.data() + s * n;
+                        FeedForwardConn<T, prec>::d_outer_x_acc (A[l-1].data() + s * m, drow,
+                                                           citer->nabla_ws[0].data(), n, m);
+                        for (unsigned int j = 0; j < n; ++j) { citer->nabla_b[j] += drow[j]; }
+                        if (have_prev) {
+                            FeedForwardConn<T, prec>::wT_times_d (citer->ws[0].data(), drow,
+                                                            Dprev.data() + s * m, n, m);
+                        }
+                    }
+                    if (have_prev) {
+                        // Hadamard product with sigmoid_prime of the previous layer's activations
+                        for (unsigned int idx = 0; idx < nb * m; ++idx) {
+                            Dprev[idx] *= A[l-1][idx] * (T{1} - A[l-1][idx]);
+                        }
+                        std::swap (D, Dprev);
+                    }
+                    --l;
+                }
+
+                return costsum;
+            }
+
+            //! Apply one gradient update, v -> v' = v - gscale * nabla, to every
+            //! connection's weights and biases. gscale would typically be the learning
+            //! rate divided by the number of batch samples the gradients were summed over.
+            void applyGradients (const T gscale)
+            {
+                for (auto& c : this->connections) {
+                    for (unsigned int i = 0; i < c.ws.size(); ++i) {
+                        c.ws[i] -= c.nabla_ws[i] * gscale;
+                    }
+                    c.b -= c.nabla_b * gscale;
+                }
+            }
+
             //! Set up an input along with desired output
             void setInput (const morph::vvec<T>& theInput, const morph::vvec<T>& theOutput)
             {
@@ -200,15 +371,15 @@ namespace morph {
             //! A variable number of neuron layers, each of variable size.
             std::list<morph::vvec<T>> neurons;
             //! Connections. There should be neurons.size()-1 connection layers:
-            std::list<morph::nn::FeedForwardConn<T>> connections;
+            std::list<morph::nn::FeedForwardConn<T, prec>> connections;
             //! The error (dC/dz) of the output layer
             morph::vvec<T> delta_out;
             //! The desired output of the network
             morph::vvec<T> desiredOutput;
         };
 
-        template <typename T>
-        std::ostream& operator<< (std::ostream& os, const morph::nn::FeedForwardNet<T>& ff)
+        template <typename T, morph::mathprec prec>
+        std::ostream& operator<< (std::ostream& os, const morph::nn::FeedForwardNet<T, prec>& ff)
         {
             os << ff.str();
             return os;
@@ -0,0 +1,160 @@
+/*!
+ * \file
+ *
+ * Data-parallel, multi-threaded training driver for morph::nn::FeedForwardNet.
+ *
+ * \author Seb James
+ * \date August 2026
+ */
+#pragma once
+
+#include <morph/nn/FeedForwardNet.h>
+#include <morph/vvec.h>
+#include <vector>
+#include <thread>
+#include <exception>
+#include <stdexcept>
+
+namespace morph {
+    namespace nn {
+
+        /*!
+         * A data-parallel training driver. This holds n_threads replicas of a
+         * FeedForwardNet, all with identical weights. Each call to train_step shards
+         * the given minibatch across the replicas, computes the cost gradients for
+         * each shard concurrently (one std::thread per replica; each thread writes
+         * only into its own replica, so no locking is needed), reduces the per-shard
+         * gradient sums and applies a single averaged gradient update to every
+         * replica. The replicas therefore stay in lockstep and net() can be used at
+         * any time between steps for evaluation.
+         *
+         * \tparam prec The precision policy for the transfer function, passed on to
+         * the replica FeedForwardNets.
+         */
+        template <typename T, morph::mathprec prec = morph::mathprec::exact>
+        struct ParallelTrainer
+        {
+            //! Construct with the FeedForwardNet layer specification and the number
+            //! of worker threads (0 means use std::thread::hardware_concurrency()).
+            ParallelTrainer (const std::vector<unsigned int>& layer_spec, unsigned int n_threads = 0)
+            {
+                this->nt = n_threads > 0 ? n_threads : std::thread::hardware_concurrency();
+                if (this->nt == 0) { this->nt = 1; }
+                // Construct the replicas, then copy the (randomized) weights of the
+                // first into the others, so that all start identical. reserve() first:
+                // replicas must only ever be moved (never copied), as each replica's
+                // connections point into its own neurons list.
+                this->replicas.reserve (this->nt);
+                for (unsigned int w = 0; w < this->nt; ++w) {
+                    this->replicas.push_back (FeedForwardNet<T, prec> (layer_spec));
+                }
+                for (unsigned int w = 1; w < this->nt; ++w) {
+                    this->syncWeights (this->replicas[w]);
+                }
+            }
+
+            //! Access the master replica - for evaluation, saving, or setting weights.
+            //! If you modify its weights or biases, the other replicas follow on the
+            //! next train_step.
+            FeedForwardNet<T, prec>& net() { return this->replicas[0]; }
+
+            //! The number of worker threads (and network replicas)
+            unsigned int threads() const { return this->nt; }
+
+            /*!
+             * One data-parallel training step. The batch is divided into nt near-equal
+             * contiguous shards; replica w computes the gradient sums for shard w in
+             * its own thread and the shard sums are then reduced into one batch-mean
+             * gradient which updates all replicas identically (the update rule is
+             * v -> v' = v - eta * mean_gradient, as in
+             * FeedForwardNet::trainMiniBatch).
+             *
+             * \param batchIns The batch of input patterns (e.g. Mnist images as vvecs)
+             * \param batchOuts The corresponding desired outputs
+             * \param eta The learning rate
+             *
+             * \return The mean cost across the whole batch
+             */
+            T train_step (const std::vector<morph::vvec<T>>& batchIns,
+                          const std::vector<morph::vvec<T>>& batchOuts, const T eta)
+            {
+                const unsigned int nb = batchIns.size();
+                if (nb == 0 || batchOuts.size() != nb) {
+                    throw std::runtime_error ("train_step: batch input/output sizes must match and be >0");
+                }
+
+                // Weight changes made to the master replica between steps are carried
+                // over to the workers here (a no-op copy if nothing changed).
+                for (unsigned int w = 1; w < this->nt; ++w) { this->syncWeights (this->replicas[w]); }
+
+                // Shard the batch: the first (nb % nt) shards get one extra sample
+                const unsigned int per = nb / this->nt;
+                const unsigned int extra = nb % this->nt;
+                std::vector<T> costs (this->nt, T{0});
+                std::vector<std::exception_ptr> errors (this->nt, nullptr);
+
+                auto worker = [&] (unsigned int w, unsigned int s0, unsigned int ns) {
+                    try {
+                        costs[w] = this->replicas[w].computeBatchGradients (batchIns.data() + s0,
+                                                                            batchOuts.data() + s0, ns);
+                    } catch (...) {
+                        errors[w] = std::current_exception();
+                    }
+                };
+
+                std::vector<std::thread> threads;
+                unsigned int s0 = 0;
+                unsigned int ns0 = per + (0 < extra ? 1U : 0U); // Shard 0 runs on this thread
+                unsigned int snext = ns0;
+                for (unsigned int w = 1; w < this->nt; ++w) {
+                    const unsigned int ns = per + (w < extra ? 1U : 0U);
+                    threads.emplace_back (worker, w, snext, ns);
+                    snext += ns;
+                }
+                worker (0, s0, ns0);
+                for (auto& t : threads) { t.join(); }
+                for (auto& e : errors) { if (e) { std::rethrow_exception (e); } }
+
+                // Reduce the shard gradient sums into the master replica's nabla
+                // attributes, then apply the same mean-gradient update to every replica.
+                T costsum = costs[0];
+                auto c0 = this->replicas[0].connections.begin();
+                for (unsigned int w = 1; w < this->nt; ++w) {
+                    costsum += costs[w];
+                    auto cw = this->replicas[w].connections.begin();
+                    for (c0 = this->replicas[0].connections.begin();
+                         c0 != this->replicas[0].connections.end(); ++c0, ++cw) {
+                        for (unsigned int i = 0; i < c0->nabla_ws.size(); ++i) {
+                            c0->nabla_ws[i] += cw->nabla_ws[i];
+                        }
+                        c0->nabla_b += cw->nabla_b;
+                    }
+                }
+                const T gscale = eta / static_cast<T>(nb);
+                this->replicas[0].applyGradients (gscale);
+                for (unsigned int w = 1; w < this->nt; ++w) { this->syncWeights (this->replicas[w]); }
+
+                return costsum / static_cast<T>(nb);
+            }
+
+            //! The network replicas. replicas[0] is the master.
+            std::vector<FeedForwardNet<T, prec>> replicas;
+
+        private:
+            //! Copy the master replica's weights and biases into replica \a rep
+            void syncWeights (FeedForwardNet<T, prec>& rep)
+            {
+                auto c0 = this->replicas[0].connections.begin();
+                auto cw = rep.connections.begin();
+                for (; c0 != this->replicas[0].connections.end(); ++c0, ++cw) {
+                    cw->ws = c0->ws;
+                    cw->b = c0->b;
+                }
+            }
+
+            //! Number of worker threads/replicas
+            unsigned int nt = 1;
+        };
+
+    } // namespace nn
+} // namespace morph
@@ -0,0 +1,178 @@
+/*!
+ * \file
+ *
+ * Post-training int8 quantization of a trained FeedForwardNet, for inference on
+ * hardware where float arithmetic (or the memory footprint of float weights) is the
+ * bottleneck. The weights of each connection are stored as int8 with one scale per
+ * layer, inference runs an int8 matrix-vector product with int32 accumulation, and
+ * only the final add-bias-and-sigmoid per output neuron is done in float. Weight
+ * memory is a quarter of the float net's.
+ *
+ * \author Seb James
+ * \date August 2026
+ */
+#pragma once
+
+#include <morph/nn/FeedForwardNet.h>
+#include <morph/vvec.h>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <stdexcept>
+
+namespace morph {
+    namespace nn {
+
+        /*!
+         * An int8, inference-only copy of a trained FeedForwardNet.
+         *
+         * Quantization scheme: symmetric, per-layer. Each connection's weights are
+         * mapped to [-127, 127] with the scale w_scale = max|w| / 127; each layer's
+         * input activations are mapped with in_scale = max|a| / 127, where max|a| is
+         * measured by running the caller's calibration inputs through the float
+         * net. The integer dot product then recovers z = acc * w_scale * in_scale +
+         * b, and the sigmoid transfer is applied in float as usual.
+         *
+         * Only the forward pass is provided - train in float with FeedForwardNet,
+         * then construct one of these for deployment.
+         *
+         * \tparam T The float type of the source network.
+         */
+        template <typename T>
+        struct QuantizedFeedForwardNet
+        {
+            //! One quantized connection: int8 weights (row-major, as in
+            //! FeedForwardConn), float biases and the two scales.
+            struct QuantizedConn
+            {
+                //! Quantized weights, N rows of M, row-major
+                std::vector<std::int8_t> wq;
+                //! Output (N) and input (M) sizes
+                unsigned int N = 0U;
+                unsigned int M = 0U;
+                //! The weight scale: w approx= wq * w_scale
+                T w_scale = T{0};
+                //! The input activation scale: a approx= aq * in_scale
+                T in_scale = T{0};
+                //! Biases, kept in float. Size N.
+                morph::vvec<T> b;
+            };
+
+            /*!
+             * Construct from a trained float network, calibrating the activation
+             * scales with \a calibrationIns. The calibration set should span the
+             * inputs the deployed net will see; each input is fed through \a net
+             * (whose neuron activations are modified in the process) and the largest
+             * activation magnitude seen at each layer sets that layer's input scale.
+             */
+            template <morph::mathprec prec = morph::mathprec::exact>
+            QuantizedFeedForwardNet (morph::nn::FeedForwardNet<T, prec>& net,
+                                     const std::vector<morph::vvec<T>>& calibrationIns)
+            {
+                for (auto& c : net.connections) {
+                    if (c.ins.size() != 1) {
+                        throw std::runtime_error ("QuantizedFeedForwardNet: quantization is implemented "
+                                                  "for connections with a single input population");
+                    }
+                }
+                if (calibrationIns.empty()) {
+                    throw std::runtime_error ("QuantizedFeedForwardNet: need at least one calibration input");
+                }
+
+                const unsigned int n_conns = net.connections.size();
+
+                // Calibrate: the max abs input activation for each connection layer
+                std::vector<T> amax (n_conns, T{0});
+                morph::vvec<T> dummy_out (net.neurons.back().size(), T{0});
+                for (auto& ci : calibrationIns) {
+                    net.setInput (ci, dummy_out);
+                    net.feedforward();
+                    unsigned int l = 0;
+                    for (auto& c : net.connections) {
+                        const T m = c.ins[0]->abs().max();
+                        amax[l] = m > amax[l] ? m : amax[l];
+                        ++l;
+                    }
+                }
+
+                // Quantize each connection's weights
+                this->layers.resize (n_conns);
+                unsigned int l = 0;
+                for (auto& c : net.connections) {
+                    QuantizedConn& q = this->layers[l];
+                    q.N = c.N;
+                    q.M = c.ins[0]->size();
+                    q.b = c.b;
+                    const T wmax = c.ws[0].abs().max();
+                    q.w_scale = wmax > T{0} ? wmax / T{127} : T{1};
+                    q.in_scale = amax[l] > T{0} ? amax[l] / T{127} : T{1};
+                    q.wq.resize (static_cast<std::size_t>(q.N) * q.M);
+                    for (std::size_t i = 0; i < q.wq.size(); ++i) {
+                        q.wq[i] = QuantizedFeedForwardNet::quantize (c.ws[0][i], q.w_scale);
+                    }
+                    ++l;
+                }
+
+                // Workspace for the quantized input of the widest layer
+                std::size_t mmax = 0;
+                for (auto& q : this->layers) { mmax = q.M > mmax ? q.M : mmax; }
+                this->aq.resize (mmax, 0);
+                this->a.resize (net.neurons.front().size(), T{0});
+            }
+
+            //! Run the int8 forward pass on \a input. \return the output layer's
+            //! activations (in float, as from FeedForwardNet::feedforward).
+            morph::vvec<T> feedforward (const morph::vvec<T>& input)
+            {
+                if (input.size() != this->layers.front().M) {
+                    throw std::runtime_error ("QuantizedFeedForwardNet::feedforward: input size mismatch");
+                }
+                this->a = input;
+                for (auto& q : this->layers) {
+                    // Quantize this layer's input activations
+                    for (unsigned int i = 0; i < q.M; ++i) {
+                        this->aq[i] = QuantizedFeedForwardNet::quantize (this->a[i], q.in_scale);
+                    }
+                    // Integer GEMM rows, then dequantize, add bias and apply the sigmoid
+                    const T dq = q.w_scale * q.in_scale;
+                    morph::vvec<T> out (q.N, T{0});
+                    for (unsigned int j = 0; j < q.N; ++j) {
+                        const std::int8_t* wr = q.wq.data() + static_cast<std::size_t>(j) * q.M;
+                        std::int32_t acc = 0;
+                        for (unsigned int k = 0; k < q.M; ++k) {
+                            acc += static_cast<std::int32_t>(wr[k]) * static_cast<std::int32_t>(this->aq[k]);
+                        }
+                        const T z = static_cast<T>(acc) * dq + q.b[j];
+                        out[j] = T{1} / (T{1} + std::exp (-z));
+                    }
+                    this->a = out;
+                }
+                return this->a;
+            }
+
+            //! The quantized weight memory in bytes (cf. 4x this for float weights)
+            std::size_t weightBytes() const
+            {
+                std::size_t n = 0;
+                for (auto& q : this->layers) { n += q.wq.size(); }
+                return n;
+            }
+
+            //! The quantized connections, input side first
+            std::vector<QuantizedConn> layers;
+
+        private:
+            //! Quantize one value symmetrically: round(v/scale) clamped to [-127, 127]
+            static std::int8_t quantize (const T v, const T scale)
+            {
+                const T r = std::round (v / scale);
+                return static_cast<std::int8_t>(r > T{127} ? T{127} : (r < T{-127} ? T{-127} : r));
+            }
+
+            //! Workspace: the current layer's float input and its quantized form
+            morph::vvec<T> a;
+            std::vector<std::int8_t> aq;
+        };
+
+    } // namespace nn
+} // namespace morph
@@ -72,8 +72,11 @@ namespace morph {
                 // divergenceThreshold - threshold below which time-differences in total error signal convergence to a (point) attractor state
                 // Wptr - pointers into the weight vector W, useful for efficiently constructing an N x N sparse weight matrix, for convenient inspection / saving
 
+                // Xpre, Ypre - workspace buffers holding the previous step's X (or Y) in the
+                // convergence loops; allocated once in init and re-used every step
+
                 int N, Nweight, Nplus1, maxConvergenceSteps;
-                std::vector<double> W, X, Input, U, Wbest, Y, F, V, Fprime, J;
+                std::vector<double> W, X, Input, U, Wbest, Y, F, V, Fprime, J, Xpre, Ypre;
                 double dt, dtOverTauX, dtOverTauY, dtOverTauW;
                 std::vector<int> Pre, Post;
                 double zero, divergenceThreshold;
@@ -96,6 +99,8 @@ namespace morph {
                     F.resize(N,0.);
                     J.resize(N,0.);
                     Fprime.resize(N,0.);
+                    Xpre.resize(N,0.);
+                    Ypre.resize(N,0.);
                     Nplus1 = N; // overwrite if bias
                     this->divergenceThreshold= divergenceThreshold * N;
                     this->maxConvergenceSteps= maxConvergenceSteps;
@@ -285,11 +290,10 @@ namespace morph {
                 //! converged=true, else if ii) return converged=false
                 bool convergeForward(void){
 
-                    std::vector<double> Xpre(N,0.);
                     double total = N;
                     for(int t=0;t<maxConvergenceSteps;t++){
                         if(total>divergenceThreshold){
-                            Xpre=X;
+                            std::copy(X.begin(),X.begin()+N,Xpre.begin());
                             forward();
                             total = 0.0;
                             for(int i=0;i<N;i++){ total +=(X[i]-Xpre[i])*(X[i]-Xpre[i]); }
@@ -306,11 +310,10 @@ namespace morph {
                 //! converged=true, else if ii) return converged=false
                 bool convergeBackward(void){
 
-                    std::vector<double> Ypre(N,0.);
                     double total = N;
                     for(int t=0;t<maxConvergenceSteps;t++){
                         if(total>divergenceThreshold){
-                            Ypre=Y;
+                            std::copy(Y.begin(),Y.begin()+N,Ypre.begin());
                             backward();
                             total = 0.0;
                             for(int i=0;i<N;i++){ total +=(Y[i]-Ypre[i])*(Y[i]-Ypre[i]); }
@@ -0,0 +1,391 @@
+/*!
+ * \file
+ *
+ * \brief NumPy .npy/.npz saving and loading for vvec, vec arrays and Grid data
+ *
+ * HdfData is the full-featured save path, but when the downstream analysis is
+ * Python, a simple array costs an HDF5 open/create/close cycle per file. The .npy
+ * format (github.com/numpy/numpy/blob/main/doc/neps/nep-0001-npy-format.rst) is a
+ * fixed header plus the raw array bytes, so saving is header generation and one
+ * bulk write straight from the container's contiguous storage, and loading is one
+ * bulk read into it. morph::npy::save/load handle single arrays; morph::npy::zip
+ * batches several arrays into one .npz (a PKZIP archive of stored - uncompressed -
+ * .npy members, exactly what numpy.savez writes), one file per sweep run instead
+ * of one per array. numpy.load reads both; np.savez_compressed output is NOT
+ * readable here (deflate is out of scope).
+ *
+ * \author Seb James
+ * \date August 2026
+ */
+#pragma once
+
+#include <vector>
+#include <array>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <morph/vvec.h>
+#include <morph/vec.h>
+
+namespace morph {
+    namespace npy {
+
+        static_assert (std::endian::native == std::endian::little,
+                       "morph::npy writes little-endian ('<') dtypes from raw memory");
+
+        namespace detail {
+
+            //! The numpy dtype descr for T ('<' = little endian)
+            template <typename T>
+            constexpr const char* descr()
+            {
+                if constexpr (std::is_same_v<T, float>) { return "<f4"; }
+                else if constexpr (std::is_same_v<T, double>) { return "<f8"; }
+                else if constexpr (std::is_same_v<T, std::int8_t>) { return "|i1"; }
+                else if constexpr (std::is_same_v<T, std::uint8_t>) { return "|u1"; }
+                else if constexpr (std::is_same_v<T, std::int16_t>) { return "<i2"; }
+                else if constexpr (std::is_same_v<T, std::uint16_t>) { return "<u2"; }
+                else if constexpr (std::is_same_v<T, std::int32_t>) { return "<i4"; }
+                else if constexpr (std::is_same_v<T, std::uint32_t>) { return "<u4"; }
+                else if constexpr (std::is_same_v<T, std::int64_t>) { return "<i8"; }
+                else if constexpr (std::is_same_v<T, std::uint64_t>) { return "<u8"; }
+                else { static_assert (std::is_same_v<T, float>, "morph::npy: unsupported element type"); return ""; }
+            }
+
+            //! Build the .npy file contents preceding the data: magic, version 1.0,
+            //! and the header dict padded so the data begins on a 64 byte boundary
+            template <typename T>
+            std::string header (const std::vector<std::size_t>& shape)
+            {
+                std::stringstream dict;
+                dict << "{'descr': '" << descr<T>() << "', 'fortran_order': False, 'shape': (";
+                for (std::size_t i = 0; i < shape.size(); ++i) { dict << shape[i] << ", "; }
+                dict << "), }";
+                std::string d = dict.str();
+                // 10 bytes of magic/version/length, then the dict, padded with
+                // spaces and terminated with \n to a multiple of 64
+                std::size_t hlen = d.size() + 1;
+                const std::size_t total = ((10 + hlen + 63) / 64) * 64;
+                hlen = total - 10;
+                d.resize (hlen - 1, ' ');
+                d += '\n';
+
+                std::string out ("\x93NUMPY\x01\x00", 8);
+                out += static_cast<char>(hlen & 0xff);
+                out += static_cast<char>((hlen >> 8) & 0xff);
+                out += d;
+                return out;
+            }
+
+            //! Parse the .npy header from \a f (which should be positioned at the
+            //! magic). Fills \a shape; throws on format problems or if the dtype is
+            //! not T's (no conversions - load into the type you saved).
+            template <typename T>
+            void parse_header (std::istream& f, std::vector<std::size_t>& shape, const std::string& path)
+            {
+                char magic[8] = { 0 };
+                f.read (magic, 8);
+                if (!f || std::string (magic, 6) != std::string ("\x93NUMPY", 6)) {
+                    throw std::runtime_error ("morph::npy: " + path + " is not a .npy file");
+                }
+                // Header length: 2 bytes for version 1.x, 4 for 2.x+
+                std::size_t hlen = 0;
+                if (magic[6] == 1) {
+                    std::uint16_t h16 = 0;
+                    f.read (reinterpret_cast<char*>(&h16), 2);
+                    hlen = h16;
+                } else {
+                    std::uint32_t h32 = 0;
+                    f.read (reinterpret_cast<char*>(&h32), 4);
+                    hlen = h32;
+                }
+                std::string d (hlen, '\0');
+                f.read (d.data(), hlen);
+                if (!f) { throw std::runtime_error ("morph::npy: truncated header in " + path); }
+
+                if (d.find (std::string ("'") + descr<T>() + "'") == std::string::npos) {
+                    throw std::runtime_error ("morph::npy: dtype mismatch loading " + path
+                                              + " (expected " + descr<T>() + ")");
+                }
+                if (d.find ("'fortran_order': False") == std::string::npos) {
+                    throw std::runtime_error ("morph::npy: " + path + " is Fortran-ordered; C order required");
+                }
+                const std::size_t sh = d.find ("'shape':");
+                const std::size_t po = d.find ('(', sh);
+                const std::size_t pc = d.find (')', po);
+                if (sh == std::string::npos || po == std::string::npos || pc == std::string::npos) {
+                    throw std::runtime_error ("morph::npy: no shape in header of " + path);
+                }
+                shape.clear();
+                std::size_t p = po + 1;
+                while (p < pc) {
+                    while (p < pc && (d[p] == ' ' || d[p] == ',')) { ++p; }
+                    if (p >= pc) { break; }
+                    std::size_t dim = 0;
+                    while (p < pc && d[p] >= '0' && d[p] <= '9') { dim = dim * 10 + (d[p] - '0'); ++p; }
+                    shape.push_back (dim);
+                }
+            }
+
+            //! The number of elements implied by a shape (1 for a 0-d scalar)
+            inline std::size_t shape_size (const std::vector<std::size_t>& shape)
+            {
+                std::size_t n = 1;
+                for (auto s : shape) { n *= s; }
+                return n;
+            }
+
+            //! CRC-32 (the PKZIP/IEEE polynomial), for the .npz archive entries
+            inline std::uint32_t crc32 (const char* data, std::size_t n, std::uint32_t crc = 0)
+            {
+                crc = ~crc;
+                for (std::size_t i = 0; i < n; ++i) {
+                    crc ^= static_cast<std::uint8_t>(data[i]);
+                    for (int b = 0; b < 8; ++b) {
+                        crc = (crc >> 1) ^ (0xedb88320u & (0u - (crc & 1u)));
+                    }
+                }
+                return ~crc;
+            }
+
+            //! Append an integer to \a s as its little-endian bytes
+            template <typename U>
+            void put_le (std::string& s, const U v)
+            {
+                for (std::size_t i = 0; i < sizeof(U); ++i) {
+                    s += static_cast<char>((v >> (8 * i)) & 0xff);
+                }
+            }
+
+        } // namespace detail
+
+        //! Save \a n elements at \a data as \a path with the given \a shape, whose
+        //! dimensions must multiply to n. The core save; one header, one bulk write.
+        template <typename T>
+        void save (const std::string& path, const T* data, const std::size_t n,
+                   const std::vector<std::size_t>& shape)
+        {
+            if (detail::shape_size (shape) != n) {
+                throw std::runtime_error ("morph::npy::save: shape does not match the data size");
+            }
+            std::ofstream f (path, std::ios::binary | std::ios::trunc);
+            if (!f) { throw std::runtime_error ("morph::npy::save: failed to open " + path); }
+            const std::string hdr = detail::header<T> (shape);
+            f.write (hdr.data(), hdr.size());
+            f.write (reinterpret_cast<const char*>(data), n * sizeof(T));
+            if (!f) { throw std::runtime_error ("morph::npy::save: write to " + path + " failed"); }
+        }
+
+        //! Save a vvec (or any contiguous std::vector) as a 1-D array
+        template <typename T>
+        void save (const std::string& path, const std::vector<T>& data)
+        {
+            npy::save (path, data.data(), data.size(), { data.size() });
+        }
+
+        //! Save a vector of fixed-size vecs as a 2-D (n by N) array. morph::vec
+        //! derives from std::array, so the storage is contiguous.
+        template <typename T, std::size_t N>
+        void save (const std::string& path, const std::vector<morph::vec<T, N>>& data)
+        {
+            npy::save (path, data.empty() ? nullptr : data[0].data(), data.size() * N, { data.size(), N });
+        }
+
+        //! Save Grid-shaped (or other 2-D) data as a rows by cols array. Pass the
+        //! data in row-major order - e.g. a GridOrder::bottomleft_to_topright Grid's
+        //! data with rows = get_h() and cols = get_w().
+        template <typename T>
+        void save (const std::string& path, const std::vector<T>& data,
+                   const std::size_t rows, const std::size_t cols)
+        {
+            npy::save (path, data.data(), data.size(), { rows, cols });
+        }
+
+        //! Load \a path into \a data (resized to fit; multidimensional arrays arrive
+        //! flattened in C order). \return the array's shape.
+        template <typename T>
+        std::vector<std::size_t> load (const std::string& path, std::vector<T>& data)
+        {
+            std::ifstream f (path, std::ios::binary);
+            if (!f) { throw std::runtime_error ("morph::npy::load: failed to open " + path); }
+            std::vector<std::size_t> shape;
+            detail::parse_header<T> (f, shape, path);
+            data.resize (detail::shape_size (shape));
+            f.read (reinterpret_cast<char*>(data.data()), data.size() * sizeof(T));
+            if (!f) { throw std::runtime_error ("morph::npy::load: truncated data in " + path); }
+            return shape;
+        }
+
+        /*!
+         * A .npz writer: a PKZIP archive of stored (uncompressed) .npy members, as
+         * numpy.savez produces. add() arrays, then close() (or let the destructor do
+         * it). Load the result with numpy.load, or member by member with npz::load.
+         */
+        class zip
+        {
+        public:
+            explicit zip (const std::string& _path)
+                : path (_path)
+                , f (_path, std::ios::binary | std::ios::trunc)
+            {
+                if (!this->f) { throw std::runtime_error ("morph::npy::zip: failed to open " + _path); }
+            }
+
+            ~zip() { if (this->f.is_open()) { this->close(); } }
+
+            zip (const zip&) = delete;
+            zip& operator= (const zip&) = delete;
+
+            //! Add the array \a data of the given \a shape as member \a name (load
+            //! in Python as archive['name'])
+            template <typename T>
+            void add (const std::string& name, const T* data, const std::size_t n,
+                      const std::vector<std::size_t>& shape)
+            {
+                if (detail::shape_size (shape) != n) {
+                    throw std::runtime_error ("morph::npy::zip::add: shape does not match the data size");
+                }
+                const std::string member = name + ".npy";
+                const std::string hdr = detail::header<T> (shape);
+                const std::uint32_t usize = static_cast<std::uint32_t>(hdr.size() + n * sizeof(T));
+                std::uint32_t crc = detail::crc32 (hdr.data(), hdr.size());
+                crc = detail::crc32 (reinterpret_cast<const char*>(data), n * sizeof(T), crc);
+
+                // Local file header (store method; zeroed DOS timestamp)
+                const std::uint32_t offset = static_cast<std::uint32_t>(this->f.tellp());
+                std::string lfh;
+                detail::put_le<std::uint32_t> (lfh, 0x04034b50u);
+                detail::put_le<std::uint16_t> (lfh, 20);    // version needed
+                detail::put_le<std::uint16_t> (lfh, 0);     // flags
+                detail::put_le<std::uint16_t> (lfh, 0);     // method: stored
+                detail::put_le<std::uint32_t> (lfh, 0);     // mod time/date
+                detail::put_le<std::uint32_t> (lfh, crc);
+                detail::put_le<std::uint32_t> (lfh, usize); // compressed == uncompressed
+                detail::put_le<std::uint32_t> (lfh, usize);
+                detail::put_le<std::uint16_t> (lfh, static_cast<std::uint16_t>(member.size()));
+                detail::put_le<std::uint16_t> (lfh, 0);     // extra length
+                lfh += member;
+                this->f.write (lfh.data(), lfh.size());
+                this->f.write (hdr.data(), hdr.size());
+                this->f.write (reinterpret_cast<const char*>(data), n * sizeof(T));
+                if (!this->f) { throw std::runtime_error ("morph::npy::zip: write to " + this->path + " failed"); }
+
+                // The central directory entry, written at close()
+                std::string& cde = this->cdir.emplace_back();
+                detail::put_le<std::uint32_t> (cde, 0x02014b50u);
+                detail::put_le<std::uint16_t> (cde, 20);    // version made by
+                detail::put_le<std::uint16_t> (cde, 20);    // version needed
+                detail::put_le<std::uint16_t> (cde, 0);     // flags
+                detail::put_le<std::uint16_t> (cde, 0);     // method
+                detail::put_le<std::uint32_t> (cde, 0);     // mod time/date
+                detail::put_le<std::uint32_t> (cde, crc);
+                detail::put_le<std::uint32_t> (cde, usize);
+                detail::put_le<std::uint32_t> (cde, usize);
+                detail::put_le<std::uint16_t> (cde, static_cast<std::uint16_t>(member.size()));
+                detail::put_le<std::uint16_t> (cde, 0);     // extra
+                detail::put_le<std::uint16_t> (cde, 0);     // comment
+                detail::put_le<std::uint16_t> (cde, 0);     // disk
+                detail::put_le<std::uint16_t> (cde, 0);     // internal attrs
+                detail::put_le<std::uint32_t> (cde, 0);     // external attrs
+                detail::put_le<std::uint32_t> (cde, offset);
+                cde += member;
+            }
+
+            //! Add a vvec/std::vector as a 1-D member
+            template <typename T>
+            void add (const std::string& name, const std::vector<T>& data)
+            {
+                this->add (name, data.data(), data.size(), { data.size() });
+            }
+
+            //! Add 2-D (e.g. Grid-shaped, row-major) data as a rows by cols member
+            template <typename T>
+            void add (const std::string& name, const std::vector<T>& data,
+                      const std::size_t rows, const std::size_t cols)
+            {
+                this->add (name, data.data(), data.size(), { rows, cols });
+            }
+
+            //! Write the central directory and close the archive
+            void close()
+            {
+                const std::uint32_t cd_offset = static_cast<std::uint32_t>(this->f.tellp());
+                std::uint32_t cd_size = 0;
+                for (const auto& cde : this->cdir) {
+                    this->f.write (cde.data(), cde.size());
+                    cd_size += static_cast<std::uint32_t>(cde.size());
+                }
+                std::string eocd;
+                detail::put_le<std::uint32_t> (eocd, 0x06054b50u);
+                detail::put_le<std::uint16_t> (eocd, 0); // disk number
+                detail::put_le<std::uint16_t> (eocd, 0); // central dir disk
+                detail::put_le<std::uint16_t> (eocd, static_cast<std::uint16_t>(this->cdir.size()));
+                detail::put_le<std::uint16_t> (eocd, static_cast<std::uint16_t>(this->cdir.size()));
+                detail::put_le<std::uint32_t> (eocd, cd_size);
+                detail::put_le<std::uint32_t> (eocd, cd_offset);
+                detail::put_le<std::uint16_t> (eocd, 0); // comment length
+                this->f.write (eocd.data(), eocd.size());
+                if (!this->f) { throw std::runtime_error ("morph::npy::zip: write to " + this->path + " failed"); }
+                this->f.close();
+            }
+
+            /*!
+             * Load member \a name from the .npz at \a zpath into \a data. \return the
+             * array's shape. Only stored (uncompressed) members are supported - as
+             * written by this class or numpy.savez; np.savez_compressed members throw.
+             */
+            template <typename T>
+            static std::vector<std::size_t> load (const std::string& zpath, const std::string& name,
+                                                  std::vector<T>& data)
+            {
+                std::ifstream zf (zpath, std::ios::binary);
+                if (!zf) { throw std::runtime_error ("morph::npy::zip::load: failed to open " + zpath); }
+                const std::string member = name + ".npy";
+                for (;;) {
+                    std::uint32_t sig = 0;
+                    zf.read (reinterpret_cast<char*>(&sig), 4);
+                    if (!zf || sig != 0x04034b50u) { break; } // central directory (or junk): member not found
+                    char fixed[26]; // version..extra_len
+                    zf.read (fixed, 26);
+                    const std::uint16_t method = static_cast<std::uint8_t>(fixed[4])
+                        | (static_cast<std::uint16_t>(static_cast<std::uint8_t>(fixed[5])) << 8);
+                    std::uint32_t csize = 0;
+                    for (int i = 0; i < 4; ++i) { csize |= static_cast<std::uint32_t>(static_cast<std::uint8_t>(fixed[14 + i])) << (8 * i); }
+                    const std::uint16_t nlen = static_cast<std::uint8_t>(fixed[22])
+                        | (static_cast<std::uint16_t>(static_cast<std::uint8_t>(fixed[23])) << 8);
+                    const std::uint16_t elen = static_cast<std::uint8_t>(fixed[24])
+                        | (static_cast<std::uint16_t>(static_cast<std::uint8_t>(fixed[25])) << 8);
+                    std::string mname (nlen, '\0');
+                    zf.read (mname.data(), nlen);
+                    zf.seekg (elen, std::ios::cur);
+                    if (mname == member) {
+                        if (method != 0) {
+                            throw std::runtime_error ("morph::npy::zip::load: member " + name
+                                                      + " is compressed; only stored members are supported");
+                        }
+                        std::vector<std::size_t> shape;
+                        detail::parse_header<T> (zf, shape, zpath + ":" + member);
+                        data.resize (detail::shape_size (shape));
+                        zf.read (reinterpret_cast<char*>(data.data()), data.size() * sizeof(T));
+                        if (!zf) { throw std::runtime_error ("morph::npy::zip::load: truncated member " + name); }
+                        return shape;
+                    }
+                    zf.seekg (csize, std::ios::cur);
+                }
+                throw std::runtime_error ("morph::npy::zip::load: no member '" + name + "' in " + zpath);
+            }
+
+        private:
+            std::string path;
+            std::ofstream f;
+            //! One pre-built central directory entry per member
+            std::vector<std::string> cdir;
+        };
+
+    } // namespace npy
+} // namespace morph
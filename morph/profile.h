@@ -0,0 +1,181 @@
+/*!
+ * \file
+ *
+ * \brief Scoped tracing instrumentation emitting chrome://tracing JSON
+ *
+ * Answering "where does the time go?" across grid construction, visual finalization
+ * and HDF5 writes usually means sprinkling ad-hoc timers. This header provides
+ * library-wide tracepoints instead: the MORPH_PROFILE_SCOPE("name") macro records the
+ * wall-clock extent of the enclosing scope into a fixed-size ring buffer (a lock-free
+ * slot claim plus two clock reads per scope), and morph::profile::dump() writes the
+ * collected events as a chrome trace JSON file, viewable on the chrome://tracing or
+ * https://ui.perfetto.dev timeline. Tracepoints are pre-placed in morphologica's known
+ * hot paths (HexGrid::setBoundary, VisualModelBase::finalize, the Visual render loop,
+ * HdfData::add_contained_vals, RD_Base's integration helpers).
+ *
+ * The whole facility compiles away unless MORPH_PROFILE is defined - the macro expands
+ * to nothing, so an uninstrumented build pays nothing. In a -DMORPH_PROFILE build, a
+ * trace of the run is dumped at exit to morph_trace.json (override the path with the
+ * MORPH_PROFILE_FILE environment variable), so one compile flag yields a full
+ * timeline. Scope names must be string literals (or otherwise outlive the collector);
+ * only the pointer is stored. When the ring buffer fills, the oldest events are
+ * overwritten.
+ *
+ * \author Seb James
+ * \date August 2026
+ */
+#pragma once
+
+#include <string>
+
+#ifdef MORPH_PROFILE
+# include <algorithm>
+# include <atomic>
+# include <chrono>
+# include <cstddef>
+# include <cstdint>
+# include <cstdlib>
+# include <fstream>
+# include <stdexcept>
+# include <vector>
+#endif
+
+namespace morph::profile {
+
+#ifdef MORPH_PROFILE
+
+    //! One completed scope: a name, the thread it ran on and its extent in
+    //! nanoseconds (steady clock, relative to collector start)
+    struct event
+    {
+        const char* name = nullptr;
+        std::uint32_t tid = 0;
+        std::uint64_t t0_ns = 0;
+        std::uint64_t t1_ns = 0;
+    };
+
+    //! The process-wide ring buffer of events. Recording claims a slot with one
+    //! relaxed fetch_add; no locks, no allocation after construction.
+    class collector
+    {
+    public:
+        static collector& instance()
+        {
+            static collector c;
+            return c;
+        }
+
+        //! A small, per-thread integer id for the trace (thread 1 is the first
+        //! thread that records)
+        static std::uint32_t this_tid()
+        {
+            static std::atomic<std::uint32_t> next_tid = { 0 };
+            thread_local std::uint32_t tid = next_tid.fetch_add (1, std::memory_order_relaxed) + 1;
+            return tid;
+        }
+
+        //! Nanoseconds of steady clock since the collector was constructed
+        std::uint64_t now_ns() const
+        {
+            return static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - this->t_start).count());
+        }
+
+        void record (const char* name, const std::uint64_t t0_ns, const std::uint64_t t1_ns)
+        {
+            std::uint64_t slot = this->head.fetch_add (1, std::memory_order_relaxed);
+            this->ring[slot % this->ring.size()] = event { name, collector::this_tid(), t0_ns, t1_ns };
+        }
+
+        //! Write the collected events to \a path as chrome trace JSON. Throws
+        //! std::runtime_error if the file cannot be written.
+        void dump (const std::string& path) const
+        {
+            std::ofstream f (path, std::ios::out | std::ios::trunc);
+            if (!f.is_open()) {
+                throw std::runtime_error ("morph::profile: Failed to open trace file: " + path);
+            }
+            f << "{\"traceEvents\":[";
+            const std::uint64_t n = std::min (this->head.load (std::memory_order_relaxed),
+                                              static_cast<std::uint64_t>(this->ring.size()));
+            bool first = true;
+            for (std::uint64_t i = 0; i < n; ++i) {
+                const event& e = this->ring[i];
+                if (e.name == nullptr) { continue; }
+                if (first == false) { f << ","; }
+                first = false;
+                // chrome trace timestamps and durations are microseconds
+                f << "{\"name\":\"" << e.name << "\",\"ph\":\"X\",\"pid\":0"
+                  << ",\"tid\":" << e.tid
+                  << ",\"ts\":" << (static_cast<double>(e.t0_ns) / 1000.0)
+                  << ",\"dur\":" << (static_cast<double>(e.t1_ns - e.t0_ns) / 1000.0) << "}";
+            }
+            f << "],\"displayTimeUnit\":\"ms\"}\n";
+        }
+
+    private:
+        collector()
+            : t_start (std::chrono::steady_clock::now())
+        {
+            // Ring capacity in events; ~24 bytes each. MORPH_PROFILE_EVENTS overrides.
+            std::size_t cap = 1u << 20;
+            if (const char* ev = std::getenv ("MORPH_PROFILE_EVENTS")) {
+                const std::size_t reqd = static_cast<std::size_t>(std::atoll (ev));
+                if (reqd > 0) { cap = reqd; }
+            }
+            this->ring.resize (cap);
+        }
+
+        //! One flag, one timeline: the static collector dumps the trace as the
+        //! program exits. Scopes recorded after this (from destructors of other
+        //! static objects) are lost.
+        ~collector()
+        {
+            const char* fp = std::getenv ("MORPH_PROFILE_FILE");
+            try {
+                this->dump (fp != nullptr ? fp : "morph_trace.json");
+            } catch (const std::runtime_error&) {} // destructors must not throw
+        }
+
+        std::vector<event> ring;
+        std::atomic<std::uint64_t> head = { 0 };
+        std::chrono::steady_clock::time_point t_start;
+    };
+
+    //! The RAII tracepoint: records the extent of its enclosing scope on destruction.
+    //! Use via MORPH_PROFILE_SCOPE, which compiles away without MORPH_PROFILE.
+    struct scope
+    {
+        scope (const char* _name)
+            : name (_name)
+            , t0_ns (collector::instance().now_ns()) {}
+        ~scope()
+        {
+            collector& c = collector::instance();
+            c.record (this->name, this->t0_ns, c.now_ns());
+        }
+        const char* name;
+        std::uint64_t t0_ns;
+    };
+
+    //! Write the trace collected so far to \a path (also happens at exit)
+    inline void dump (const std::string& path) { collector::instance().dump (path); }
+
+#else // !MORPH_PROFILE
+
+    //! Without MORPH_PROFILE there is nothing to dump; client code need not be conditional
+    inline void dump (const std::string&) {}
+
+#endif // MORPH_PROFILE
+
+} // namespace morph::profile
+
+#ifdef MORPH_PROFILE
+# define MORPH_PROFILE_CAT2(a, b) a##b
+# define MORPH_PROFILE_CAT(a, b) MORPH_PROFILE_CAT2(a, b)
+//! Record the enclosing scope as a trace event called \a n (a string literal)
+# define MORPH_PROFILE_SCOPE(n) morph::profile::scope MORPH_PROFILE_CAT(morph_profile_scope_, __LINE__) (n)
+#else
+# define MORPH_PROFILE_SCOPE(n)
+#endif
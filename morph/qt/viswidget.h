@@ -2,6 +2,11 @@
 
 #include <iostream>
 #include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <memory>
 
 #include <QtWidgets/QOpenGLWidget>
 #include <QOpenGLFunctions_4_1_Core> // problem is that this loads GL headers, so we don't load glad, further on
@@ -40,6 +45,20 @@ namespace morph {
                 this->needs_reinit = reinit_required ? model_idx : -1;
             }
 
+            /*!
+             * If true, queued models which declare that their initializeVertices makes no
+             * OpenGL calls (VisualModel::threadsafe_vertex_init == true) have their
+             * vertices built on a background worker thread instead of inside paintGL, so
+             * the GUI stays responsive while big models build. paintGL does only the
+             * buffer upload when a model's vertices are ready (each completed build
+             * schedules a repaint). Models without threadsafe_vertex_init (those that
+             * create text labels, for example) are finalized on the GUI thread as
+             * before. Note that model_ptrs gains entries in the order models *join the
+             * scene*, which with background building is not necessarily the order they
+             * were pushed into newvisualmodels.
+             */
+            bool background_finalize = false;
+
             viswidget (QWidget* parent = 0) : QOpenGLWidget(parent)
             {
                 // You have to set the format in the constructor
@@ -54,8 +73,55 @@ namespace morph {
                 this->setFocusPolicy (Qt::StrongFocus); // ensure keyPressEvents reach us
             }
 
+            ~viswidget()
+            {
+                // Stop the background build worker, if it was ever started
+                {
+                    std::lock_guard<std::mutex> lk (this->build_mtx);
+                    this->build_finishing = true;
+                }
+                this->build_cv.notify_one();
+                if (this->build_thread.joinable()) { this->build_thread.join(); }
+            }
+
         protected:
 
+            // The queue of models awaiting vertex building on the worker thread
+            std::deque<std::unique_ptr<morph::VisualModel<gl_version>>> build_queue;
+            // Models whose vertices the worker has built, awaiting upload in paintGL
+            std::deque<std::unique_ptr<morph::VisualModel<gl_version>>> built_queue;
+            std::mutex build_mtx;
+            std::condition_variable build_cv;
+            std::thread build_thread;
+            bool build_finishing = false;
+
+            // The background builder's loop: take queued models in order and run the
+            // GL-free portion of VisualModel::finalize on them. A model's own
+            // initializeVertices may well be multithreaded (OpenMP) on top of this.
+            void build_loop()
+            {
+                for (;;) {
+                    std::unique_ptr<morph::VisualModel<gl_version>> m;
+                    {
+                        std::unique_lock<std::mutex> lk (this->build_mtx);
+                        this->build_cv.wait (lk, [this] { return !this->build_queue.empty() || this->build_finishing; });
+                        if (this->build_queue.empty()) { break; } // finishing
+                        m = std::move (this->build_queue.front());
+                        this->build_queue.pop_front();
+                    }
+                    m->reserve_predicted_vertices();
+                    m->initializeVertices();
+                    m->cacheModelExtents();
+                    m->postVertexInitRequired = true;
+                    {
+                        std::lock_guard<std::mutex> lk (this->build_mtx);
+                        this->built_queue.push_back (std::move (m));
+                    }
+                    // Schedule a repaint on the GUI thread, which uploads and draws
+                    QMetaObject::invokeMethod (this, [this] { this->update(); }, Qt::QueuedConnection);
+                }
+            }
+
             void initializeGL() override
             {
                 // Make sure we can call gl functions
@@ -78,11 +144,35 @@ namespace morph {
             {
                 if (!this->newvisualmodels.empty()) {
                     // Now we iterate through newvisualmodels, finalize them and add them to morph::Visual
+                    bool handed_to_worker = false;
                     for (unsigned int i = 0; i < newvisualmodels.size(); ++i) {
-                        this->newvisualmodels[i]->finalize();
-                        this->model_ptrs.push_back (this->v.addVisualModel (this->newvisualmodels[i]));
+                        if (this->background_finalize == true && this->newvisualmodels[i]->threadsafe_vertex_init == true) {
+                            // Vertex building happens on the worker; the model joins the
+                            // scene (and its buffers upload) in a later paintGL
+                            std::lock_guard<std::mutex> lk (this->build_mtx);
+                            this->build_queue.push_back (std::move (this->newvisualmodels[i]));
+                            handed_to_worker = true;
+                        } else {
+                            this->newvisualmodels[i]->finalize();
+                            this->model_ptrs.push_back (this->v.addVisualModel (this->newvisualmodels[i]));
+                        }
                     }
                     this->newvisualmodels.clear();
+                    if (handed_to_worker == true) {
+                        if (this->build_thread.joinable() == false) {
+                            this->build_thread = std::thread (&viswidget::build_loop, this);
+                        }
+                        this->build_cv.notify_one();
+                    }
+                }
+                // Adopt any models the background builder has completed. render() does
+                // the (GL thread only) buffer upload via postVertexInit.
+                {
+                    std::lock_guard<std::mutex> lk (this->build_mtx);
+                    while (!this->built_queue.empty()) {
+                        this->model_ptrs.push_back (this->v.addVisualModel (this->built_queue.front()));
+                        this->built_queue.pop_front();
+                    }
                 }
                 if (this->needs_reinit > -1) {
                     this->model_ptrs[this->needs_reinit]->reinit();
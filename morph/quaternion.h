@@ -9,11 +9,14 @@
 #include <morph/mathconst.h>
 #include <morph/constexpr_math.h>
 #include <morph/vec.h>
+#include <morph/simd.h>
 #include <limits>
 #include <cmath>
 #include <array>
 #include <iostream>
+#include <span>
 #include <sstream>
+#include <stdexcept>
 #include <type_traits>
 
 namespace morph {
@@ -362,6 +365,120 @@ namespace morph {
             return mat;
         }
 
+        /*!
+         * Batch rotation of a point cloud. Extracts the rotation matrix for this quaternion
+         * *once* and then applies it to each of the n 3D coordinates at vs, writing results to
+         * out. out may alias vs (rotate in place). This is much faster than rotating point by
+         * point with operator*, which re-derives the rotation matrix for every point.
+         */
+        void rotate_batch (const morph::vec<F, 3>* vs, morph::vec<F, 3>* out, const std::size_t n) const noexcept
+        {
+            const std::array<F, 16> rm = this->rotationMatrix();
+#ifdef MORPH_HAVE_STD_SIMD
+            if constexpr (morph::simd::simdable<F>) {
+                namespace stdx = std::experimental;
+                using batch = stdx::fixed_size_simd<F, 4>;
+                const batch c0 (rm.data(),     stdx::element_aligned);
+                const batch c1 (rm.data() + 4, stdx::element_aligned);
+                const batch c2 (rm.data() + 8, stdx::element_aligned);
+                for (std::size_t i = 0; i < n; ++i) {
+                    batch r = c0 * vs[i][0] + c1 * vs[i][1] + c2 * vs[i][2];
+                    // Store 4 lanes to a temporary; the output elements are packed vec<F, 3>
+                    std::array<F, 4> tmp;
+                    r.copy_to (tmp.data(), stdx::element_aligned);
+                    out[i][0] = tmp[0];
+                    out[i][1] = tmp[1];
+                    out[i][2] = tmp[2];
+                }
+                return;
+            }
+#endif
+            for (std::size_t i = 0; i < n; ++i) {
+                const F vx = vs[i][0];
+                const F vy = vs[i][1];
+                const F vz = vs[i][2];
+                out[i][0] = rm[0] * vx + rm[4] * vy + rm[8]  * vz;
+                out[i][1] = rm[1] * vx + rm[5] * vy + rm[9]  * vz;
+                out[i][2] = rm[2] * vx + rm[6] * vy + rm[10] * vz;
+            }
+        }
+
+        //! Batch rotation with span arguments. Throws if the spans differ in size.
+        void rotate_batch (std::span<const morph::vec<F, 3>> vs, std::span<morph::vec<F, 3>> out) const
+        {
+            if (vs.size() != out.size()) { throw std::runtime_error ("quaternion::rotate_batch: in/out spans differ in size"); }
+            this->rotate_batch (vs.data(), out.data(), vs.size());
+        }
+
+        //! In-place batch rotation of the coordinates in vs
+        void rotate_batch (std::span<morph::vec<F, 3>> vs) const noexcept
+        {
+            this->rotate_batch (vs.data(), vs.data(), vs.size());
+        }
+
+        /*!
+         * Spherical linear interpolation from this quaternion (at \a u = 0) to \a q
+         * (at \a u = 1), taking the shorter arc. Both quaternions should be unit
+         * quaternions. When the two are nearly parallel the spherical formula is
+         * ill-conditioned and a normalized linear interpolation is returned instead.
+         */
+        quaternion<F> slerp (const quaternion<F>& q, const F u) const noexcept
+        {
+            quaternion<F> q2 = q;
+            F cos_half = this->w * q.w + this->x * q.x + this->y * q.y + this->z * q.z;
+            if (cos_half < F{0}) { // -q is the same rotation; negate for the shorter arc
+                q2 = quaternion<F>(-q.w, -q.x, -q.y, -q.z);
+                cos_half = -cos_half;
+            }
+            if (cos_half > F{1} - std::numeric_limits<F>::epsilon() * F{100}) {
+                quaternion<F> lerped (this->w + (q2.w - this->w) * u, this->x + (q2.x - this->x) * u,
+                                      this->y + (q2.y - this->y) * u, this->z + (q2.z - this->z) * u);
+                lerped.renormalize();
+                return lerped;
+            }
+            const F half_angle = morph::math::acos (cos_half);
+            const F sin_half = morph::math::sqrt (F{1} - cos_half * cos_half);
+            const F c1 = morph::math::sin ((F{1} - u) * half_angle) / sin_half;
+            const F c2 = morph::math::sin (u * half_angle) / sin_half;
+            return quaternion<F>(c1 * this->w + c2 * q2.w, c1 * this->x + c2 * q2.x,
+                                 c1 * this->y + c2 * q2.y, c1 * this->z + c2 * q2.z);
+        }
+
+        /*!
+         * Batch slerp: fill \a out with out.size() evenly spaced interpolants from
+         * this quaternion (first element) to \a q (last element). The angle between
+         * the quaternions is derived *once*; each sample then costs only a pair of
+         * sin() calls, so this is the way to precompute an interpolation table.
+         */
+        void slerp_batch (const quaternion<F>& q, std::span<quaternion<F>> out) const noexcept
+        {
+            const std::size_t n = out.size();
+            if (n == 0) { return; }
+            if (n == 1) { out[0] = *this; return; }
+            quaternion<F> q2 = q;
+            F cos_half = this->w * q.w + this->x * q.x + this->y * q.y + this->z * q.z;
+            if (cos_half < F{0}) {
+                q2 = quaternion<F>(-q.w, -q.x, -q.y, -q.z);
+                cos_half = -cos_half;
+            }
+            const bool parallel = cos_half > F{1} - std::numeric_limits<F>::epsilon() * F{100};
+            const F half_angle = parallel ? F{0} : morph::math::acos (cos_half);
+            const F sin_half = parallel ? F{1} : morph::math::sqrt (F{1} - cos_half * cos_half);
+            for (std::size_t i = 0; i < n; ++i) {
+                const F u = static_cast<F>(i) / static_cast<F>(n - 1u);
+                if (parallel) {
+                    out[i] = quaternion<F>(this->w + (q2.w - this->w) * u, this->x + (q2.x - this->x) * u,
+                                           this->y + (q2.y - this->y) * u, this->z + (q2.z - this->z) * u);
+                    out[i].renormalize();
+                } else {
+                    const F c1 = morph::math::sin ((F{1} - u) * half_angle) / sin_half;
+                    const F c2 = morph::math::sin (u * half_angle) / sin_half;
+                    out[i] = quaternion<F>(c1 * this->w + c2 * q2.w, c1 * this->x + c2 * q2.x,
+                                           c1 * this->y + c2 * q2.y, c1 * this->z + c2 * q2.z);
+                }
+            }
+        }
+
         /*!
          * Fill the matrix \a mat with the values to represent the rotation that is
          * represented by this quaternion. This function *does not assume that the
@@ -8,10 +8,55 @@
 // Note how you can use defines to determine which of these classes to actually make use
 // of. See also rngs.h and rngd.h for including only randSingle or randDouble.
 //
+// The singletons share one engine with no locking, so they must not be called from
+// concurrent threads (an OpenMP loop body, for example). For parallel code there are
+// thread-local variants - randSingleTL()/randDoubleTL() - where each calling thread
+// lazily creates its own engine, seeded deterministically from a master seed
+// (settable with randSeed()) and a per-thread stream number. The bulk fill functions
+// - randSingleFill()/randDoubleFill() - fill a span from the calling thread's engine,
+// amortising the thread_local access over the whole span.
+//
 // Author: Seb James, August 2021.
 
 #pragma once
 #include <morph/Random.h>
+#include <span>
+#include <atomic>
+#include <cstdint>
+
+namespace morph {
+    namespace rng_detail {
+        // The master seed for the thread-local generators. Initialised randomly, so
+        // that the default behaviour matches RandUniform's; set it with
+        // morph::randSeed() for reproducible runs.
+        inline std::atomic<unsigned int> master_seed { std::random_device{}() };
+        // Stream numbers are handed out in first-use order, one per thread
+        inline std::atomic<unsigned int> next_stream { 0 };
+        // Derive a well-mixed seed for the next stream from the master seed
+        inline unsigned int stream_seed()
+        {
+            std::uint32_t z = master_seed.load() + next_stream.fetch_add (1) * 0x9e3779b9u;
+            z ^= z >> 16;
+            z *= 0x21f0aaadu;
+            z ^= z >> 15;
+            z *= 0x735a2d97u;
+            z ^= z >> 15;
+            return z;
+        }
+    }
+
+    // Set the master seed for the thread-local generators (and restart the stream
+    // numbering). Call before the threads create their engines - i.e. before the
+    // first randSingleTL/randDoubleTL/rand*Fill call on any thread - to make a
+    // parallel program's random sequences reproducible. Each thread's sequence is
+    // then determined by the master seed and the order in which the threads first
+    // call a generator (fixed, in practice, for static OpenMP schedules).
+    inline void randSeed (const unsigned int seed)
+    {
+        morph::rng_detail::master_seed = seed;
+        morph::rng_detail::next_stream = 0;
+    }
+}
 
 // #define NO_RANDSINGLE if you DON'T want a single precision rng
 #ifndef NO_RANDSINGLE
@@ -33,7 +78,23 @@ namespace morph {
         morph::RandUniform<float> rng;
     };
     srng* srng::pInstance_srng = 0;
-    static float randSingle() { return morph::srng::i()->get(); }
+    inline float randSingle() { return morph::srng::i()->get(); }
+
+    // The calling thread's own single precision engine (creating it, deterministically
+    // seeded, on the thread's first call)
+    inline morph::RandUniform<float>& srngTL()
+    {
+        thread_local morph::RandUniform<float> rng (morph::rng_detail::stream_seed());
+        return rng;
+    }
+    // As randSingle(), but from a thread-local engine: safe in parallel regions
+    inline float randSingleTL() { return morph::srngTL().get(); }
+    // Fill \a buf with uniform random singles in [0,1) from the calling thread's engine
+    inline void randSingleFill (std::span<float> buf)
+    {
+        morph::RandUniform<float>& rng = morph::srngTL();
+        for (auto& v : buf) { v = rng.get(); }
+    }
 }
 #endif
 
@@ -59,6 +120,22 @@ namespace morph {
     };
     // Globally initialise drng instance pointer to NULL.
     drng* drng::pInstance_drng = 0;
-    static double randDouble() { return morph::drng::i()->get(); }
+    inline double randDouble() { return morph::drng::i()->get(); }
+
+    // The calling thread's own double precision engine (creating it, deterministically
+    // seeded, on the thread's first call)
+    inline morph::RandUniform<double>& drngTL()
+    {
+        thread_local morph::RandUniform<double> rng (morph::rng_detail::stream_seed());
+        return rng;
+    }
+    // As randDouble(), but from a thread-local engine: safe in parallel regions
+    inline double randDoubleTL() { return morph::drngTL().get(); }
+    // Fill \a buf with uniform random doubles in [0,1) from the calling thread's engine
+    inline void randDoubleFill (std::span<double> buf)
+    {
+        morph::RandUniform<double>& rng = morph::drngTL();
+        for (auto& v : buf) { v = rng.get(); }
+    }
 }
 #endif
@@ -585,6 +585,68 @@ namespace morph {
         //! Reset the Scaling by emptying params
         void reset() { this->params.clear(); }
 
+        /*!
+         * \brief A compiled copy of a ready scaling
+         *
+         * The scaling parameters baked into a standalone functor: applying it involves no
+         * do_autoscale test, no params.size() check and no virtual dispatch, unlike
+         * transform_one(). Obtain one from scale_impl::compile() once the scaling is ready, then
+         * apply it per-element in your hot loop.
+         */
+        struct compiled_scale
+        {
+            S m = S{1};
+            S c = S{0};
+            bool is_log = false;
+            S operator() (const T datum) const noexcept
+            {
+                return this->is_log ? (static_cast<S>(std::log (datum)) * this->m + this->c)
+                                    : (static_cast<S>(datum) * this->m + this->c);
+            }
+        };
+
+        //! Bake the current scaling parameters into a compiled_scale. Throws if the scaling is
+        //! not ready (autoscale or setParams() first).
+        compiled_scale compile() const
+        {
+            if (!this->ready()) {
+                throw std::runtime_error ("scale_impl<1=scalar>::compile(): params not set (autoscale or call setParams() first)");
+            }
+            compiled_scale cs;
+            cs.m = this->params[0];
+            cs.c = this->params[1];
+            cs.is_log = (this->type == scaling_function::Logarithmic);
+            return cs;
+        }
+
+        //! The array overload of transform() below must not hide the container overload in the base class
+        using scale_impl_base<T, S>::transform;
+
+        /*!
+         * Array overload of transform(): scale n contiguous input values at data into output
+         * (which may alias data only if T and S are the same type). Autoscaling, if enabled and
+         * not yet computed, is computed from the n input values. The scaling parameters are baked
+         * into locals before the loop, so the inner loop is branch-free (for linear scalings) and
+         * auto-vectorizable.
+         */
+        void transform (const T* data, S* output, const std::size_t n)
+        {
+            if (this->do_autoscale == true && !this->ready()) {
+                morph::range<T> r;
+                r.search_init();
+                for (std::size_t i = 0; i < n; ++i) { r.update (data[i]); }
+                this->compute_scaling (r.min, r.max);
+            } else if (this->do_autoscale == false && !this->ready()) {
+                throw std::runtime_error ("scale_impl<1=scalar>::transform(array): Params are not set and do_autoscale is set false. Can't transform.");
+            }
+            const compiled_scale cs = this->compile();
+            if (cs.is_log) {
+                for (std::size_t i = 0; i < n; ++i) { output[i] = static_cast<S>(std::log (data[i])) * cs.m + cs.c; }
+            } else {
+                for (std::size_t i = 0; i < n; ++i) { output[i] = static_cast<S>(data[i]) * cs.m + cs.c; }
+            }
+        }
+
     protected:
         //! Linear transform for scalar type; y = mx + c
         S transform_one_linear (const T& datum) const
@@ -0,0 +1,199 @@
+/*!
+ * \file
+ *
+ * \brief Compile-time selected SIMD kernels for element-wise arithmetic and reductions
+ *
+ * This header provides a small set of kernels which operate on contiguous arrays of scalar
+ * elements. Where the compiler provides std::experimental::simd (libstdc++ from gcc-11, clang's
+ * libc++ from version 17 or so), the kernels process elements in batches of
+ * std::experimental::native_simd<S>::size() using whatever vector instruction set the translation
+ * unit is compiled for (SSE2/AVX2/AVX-512 on x86_64, NEON/SVE on aarch64 - choose with -march/-mcpu
+ * at compile time). Where <experimental/simd> is unavailable, or if you compile with
+ * -DMORPH_DISABLE_SIMD, the kernels reduce to plain loops which the optimizer can still
+ * auto-vectorize.
+ *
+ * The kernels are used by morph::vvec for its element-wise arithmetic operators and its heavy
+ * reductions (sum, sos, length, mean). They can equally be called on any raw, contiguous buffers.
+ *
+ * \author Seb James
+ * \date February 2025
+ */
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+#if !defined(MORPH_DISABLE_SIMD) && defined(__has_include)
+# if __has_include(<experimental/simd>)
+#  include <experimental/simd>
+#  define MORPH_HAVE_STD_SIMD 1
+# endif
+#endif
+
+namespace morph {
+    namespace simd {
+
+#ifdef MORPH_HAVE_STD_SIMD
+        namespace stdx = std::experimental;
+#endif
+
+        /*!
+         * Compile-time test of element type S: true if arrays of S can be processed by the SIMD
+         * kernels in this header. bool is excluded (no native_simd<bool>), as are non-arithmetic
+         * types such as morph::vec elements of a vvec-of-vecs. Client code (such as morph::vvec)
+         * uses this to decide, at compile time, whether to dispatch to these kernels or to fall
+         * back on its generic element-by-element code.
+         */
+        template <typename S>
+        inline constexpr bool simdable = std::is_arithmetic<std::decay_t<S>>::value
+                                         && !std::is_same<std::decay_t<S>, bool>::value;
+
+        namespace impl {
+
+            //! Apply the binary operation op element-wise: r[i] = op (a[i], b[i]). r may alias a or b.
+            template <typename S, typename Op>
+            inline void apply_vv (Op op, const S* a, const S* b, S* r, const std::size_t n)
+            {
+                std::size_t i = 0;
+#ifdef MORPH_HAVE_STD_SIMD
+                if constexpr (simdable<S>) {
+                    using batch = stdx::native_simd<S>;
+                    constexpr std::size_t w = batch::size();
+                    for (; i + w <= n; i += w) {
+                        batch ba (a + i, stdx::element_aligned);
+                        batch bb (b + i, stdx::element_aligned);
+                        op (ba, bb).copy_to (r + i, stdx::element_aligned);
+                    }
+                }
+#endif
+                for (; i < n; ++i) { r[i] = op (a[i], b[i]); }
+            }
+
+            //! Apply the binary operation op with a scalar rhs: r[i] = op (a[i], s). r may alias a.
+            template <typename S, typename Op>
+            inline void apply_vs (Op op, const S* a, const S s, S* r, const std::size_t n)
+            {
+                std::size_t i = 0;
+#ifdef MORPH_HAVE_STD_SIMD
+                if constexpr (simdable<S>) {
+                    using batch = stdx::native_simd<S>;
+                    constexpr std::size_t w = batch::size();
+                    const batch bs = s;
+                    for (; i + w <= n; i += w) {
+                        batch ba (a + i, stdx::element_aligned);
+                        op (ba, bs).copy_to (r + i, stdx::element_aligned);
+                    }
+                }
+#endif
+                for (; i < n; ++i) { r[i] = op (a[i], s); }
+            }
+        } // namespace impl
+
+        //! r[i] = a[i] + b[i] for i in [0,n). r may alias a or b.
+        template <typename S>
+        inline void add (const S* a, const S* b, S* r, const std::size_t n) { impl::apply_vv (std::plus<>{}, a, b, r, n); }
+        //! r[i] = a[i] - b[i] for i in [0,n). r may alias a or b.
+        template <typename S>
+        inline void subtract (const S* a, const S* b, S* r, const std::size_t n) { impl::apply_vv (std::minus<>{}, a, b, r, n); }
+        //! Hadamard product. r[i] = a[i] * b[i] for i in [0,n). r may alias a or b.
+        template <typename S>
+        inline void multiply (const S* a, const S* b, S* r, const std::size_t n) { impl::apply_vv (std::multiplies<>{}, a, b, r, n); }
+        //! Hadamard division. r[i] = a[i] / b[i] for i in [0,n). r may alias a or b.
+        template <typename S>
+        inline void divide (const S* a, const S* b, S* r, const std::size_t n) { impl::apply_vv (std::divides<>{}, a, b, r, n); }
+
+        //! r[i] = a[i] + s for i in [0,n). r may alias a.
+        template <typename S>
+        inline void add (const S* a, const S s, S* r, const std::size_t n) { impl::apply_vs (std::plus<>{}, a, s, r, n); }
+        //! r[i] = a[i] - s for i in [0,n). r may alias a.
+        template <typename S>
+        inline void subtract (const S* a, const S s, S* r, const std::size_t n) { impl::apply_vs (std::minus<>{}, a, s, r, n); }
+        //! r[i] = a[i] * s for i in [0,n). r may alias a.
+        template <typename S>
+        inline void multiply (const S* a, const S s, S* r, const std::size_t n) { impl::apply_vs (std::multiplies<>{}, a, s, r, n); }
+        //! r[i] = a[i] / s for i in [0,n). r may alias a.
+        template <typename S>
+        inline void divide (const S* a, const S s, S* r, const std::size_t n) { impl::apply_vs (std::divides<>{}, a, s, r, n); }
+
+        /*!
+         * \return the sum of the n elements of a. Note that for floating point S, the SIMD path
+         * sums in batch-width partial sums, so the result may differ from a strictly sequential
+         * std::accumulate in the last ulps.
+         */
+        template <typename S>
+        inline S sum (const S* a, const std::size_t n)
+        {
+            S rtn = S{0};
+            std::size_t i = 0;
+#ifdef MORPH_HAVE_STD_SIMD
+            if constexpr (simdable<S>) {
+                using batch = stdx::native_simd<S>;
+                constexpr std::size_t w = batch::size();
+                if (n >= w) {
+                    batch acc = S{0};
+                    for (; i + w <= n; i += w) {
+                        batch ba (a + i, stdx::element_aligned);
+                        acc += ba;
+                    }
+                    rtn = stdx::reduce (acc);
+                }
+            }
+#endif
+            for (; i < n; ++i) { rtn += a[i]; }
+            return rtn;
+        }
+
+        //! \return the sum of the squares of the n elements of a. See morph::simd::sum re. the
+        //! floating point summation order.
+        template <typename S>
+        inline S sos (const S* a, const std::size_t n)
+        {
+            S rtn = S{0};
+            std::size_t i = 0;
+#ifdef MORPH_HAVE_STD_SIMD
+            if constexpr (simdable<S>) {
+                using batch = stdx::native_simd<S>;
+                constexpr std::size_t w = batch::size();
+                if (n >= w) {
+                    batch acc = S{0};
+                    for (; i + w <= n; i += w) {
+                        batch ba (a + i, stdx::element_aligned);
+                        acc += ba * ba;
+                    }
+                    rtn = stdx::reduce (acc);
+                }
+            }
+#endif
+            for (; i < n; ++i) { rtn += a[i] * a[i]; }
+            return rtn;
+        }
+
+        //! \return the scalar (dot) product of the n-element arrays a and b. See morph::simd::sum
+        //! re. the floating point summation order.
+        template <typename S>
+        inline S dot (const S* a, const S* b, const std::size_t n)
+        {
+            S rtn = S{0};
+            std::size_t i = 0;
+#ifdef MORPH_HAVE_STD_SIMD
+            if constexpr (simdable<S>) {
+                using batch = stdx::native_simd<S>;
+                constexpr std::size_t w = batch::size();
+                if (n >= w) {
+                    batch acc = S{0};
+                    for (; i + w <= n; i += w) {
+                        batch ba (a + i, stdx::element_aligned);
+                        batch bb (b + i, stdx::element_aligned);
+                        acc += ba * bb;
+                    }
+                    rtn = stdx::reduce (acc);
+                }
+            }
+#endif
+            for (; i < n; ++i) { rtn += a[i] * b[i]; }
+            return rtn;
+        }
+
+    } // namespace simd
+} // namespace morph
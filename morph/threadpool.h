@@ -0,0 +1,243 @@
+/*!
+ * \file
+ *
+ * \brief A work-stealing thread pool and parallel_for, shared by parallel features
+ *
+ * morphologica's parallel utilities (morph::nn::ParallelTrainer,
+ * morph::bn::PopulationFitness) each spawn their own std::threads, and each new
+ * parallel feature would do the same - so composing them oversubscribes the
+ * machine. morph::threadpool is one set of long-lived workers that such features
+ * (and client code) can share. Each worker owns a deque; it pops its own work LIFO
+ * and steals FIFO from the other workers when its deque runs dry, so an uneven
+ * task mix still keeps every core busy. parallel_for carves an index range into
+ * chunks (with a grain-size control for when the per-index work is tiny) and the
+ * calling thread works through chunks alongside the pool, which also makes nested
+ * parallel_for calls deadlock-free. threadpool::global() provides a lazily
+ * constructed process-wide instance so that independent callers share one set of
+ * workers.
+ *
+ * \author Seb James
+ * \date August 2026
+ */
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <atomic>
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+
+namespace morph {
+
+    class threadpool
+    {
+    public:
+        //! Construct with \a n_threads workers; 0 means use
+        //! std::thread::hardware_concurrency().
+        explicit threadpool (unsigned int n_threads = 0)
+        {
+            unsigned int nt = n_threads > 0 ? n_threads : std::thread::hardware_concurrency();
+            if (nt == 0) { nt = 1; }
+            this->queues.reserve (nt);
+            for (unsigned int i = 0; i < nt; ++i) {
+                this->queues.push_back (std::make_unique<workqueue>());
+            }
+            this->workers.reserve (nt);
+            for (unsigned int i = 0; i < nt; ++i) {
+                this->workers.emplace_back (&threadpool::worker_loop, this, static_cast<std::size_t>(i));
+            }
+        }
+
+        //! The destructor lets the workers drain any remaining tasks, then joins them
+        ~threadpool()
+        {
+            this->stopping.store (true);
+            {
+                std::lock_guard<std::mutex> lk (this->sleep_mtx);
+                this->sleep_cv.notify_all();
+            }
+            for (auto& w : this->workers) { w.join(); }
+        }
+
+        //! One set of workers; copying would duplicate them
+        threadpool (const threadpool&) = delete;
+        threadpool& operator= (const threadpool&) = delete;
+
+        //! The number of worker threads
+        std::size_t size() const { return this->workers.size(); }
+
+        //! The process-wide pool, constructed (with hardware_concurrency workers) on
+        //! first use. Parallel features should prefer this over private pools so that
+        //! composed workloads share one set of workers.
+        static threadpool& global()
+        {
+            static threadpool tp;
+            return tp;
+        }
+
+        //! Submit one task for asynchronous execution. Tasks are distributed
+        //! round-robin across the worker deques (idle workers steal, so the
+        //! distribution only sets where each task starts out).
+        void run (std::function<void()> task)
+        {
+            if (this->stopping.load()) {
+                throw std::runtime_error ("threadpool::run: pool is shutting down");
+            }
+            const std::size_t qi = this->next_queue.fetch_add (1) % this->queues.size();
+            this->n_tasks.fetch_add (1);
+            {
+                std::lock_guard<std::mutex> lk (this->queues[qi]->mtx);
+                this->queues[qi]->tasks.push_back (std::move (task));
+            }
+            {
+                std::lock_guard<std::mutex> lk (this->sleep_mtx);
+                this->sleep_cv.notify_one();
+            }
+        }
+
+        /*!
+         * Apply \a func to each index in [first, last), in parallel. The range is
+         * split into chunks of \a grain indices (grain 0 selects 8 chunks per worker,
+         * a reasonable default when the per-index cost is roughly uniform; pass a
+         * larger grain when per-index work is tiny, to amortize the chunk-claiming
+         * overhead). The calling thread participates, and the call returns when the
+         * whole range is done. An exception thrown by func is rethrown here (one of
+         * them, if several chunks throw).
+         */
+        template <typename F>
+        void parallel_for (const std::size_t first, const std::size_t last, F&& func, const std::size_t grain = 0)
+        {
+            this->parallel_for_chunked (first, last, [&func] (std::size_t b, const std::size_t e) {
+                for (; b < e; ++b) { func (b); }
+            }, grain);
+        }
+
+        //! As parallel_for, but \a func is called once per chunk with the chunk's
+        //! [begin, end) indices - use this to hoist per-thread setup (scratch
+        //! allocations, etc.) out of the inner loop.
+        template <typename F>
+        void parallel_for_chunked (const std::size_t first, const std::size_t last, F&& func, const std::size_t grain = 0)
+        {
+            if (last <= first) { return; }
+            const std::size_t n = last - first;
+            const std::size_t nw = this->workers.size();
+            std::size_t g = grain > 0 ? grain : (n + 8 * nw - 1) / (8 * nw);
+            if (g < 1) { g = 1; }
+            const std::size_t nchunks = (n + g - 1) / g;
+            if (nchunks == 1) { func (first, last); return; }
+
+            // Shared by the drivers; shared_ptr so that a driver task which wakes
+            // after completion (having no chunk to claim) finds valid state
+            auto st = std::make_shared<pf_state>();
+
+            auto drive = [st, first, last, g, nchunks, &func]() {
+                for (;;) {
+                    const std::size_t c = st->next_chunk.fetch_add (1);
+                    if (c >= nchunks) { break; }
+                    const std::size_t b = first + c * g;
+                    const std::size_t e = std::min (b + g, last);
+                    try {
+                        func (b, e);
+                    } catch (...) {
+                        std::lock_guard<std::mutex> lk (st->mtx);
+                        if (!st->eptr) { st->eptr = std::current_exception(); }
+                    }
+                    if (st->n_done.fetch_add (1) + 1 == nchunks) {
+                        std::lock_guard<std::mutex> lk (st->mtx);
+                        st->cv.notify_all();
+                    }
+                }
+            };
+
+            // One driver task per worker (no more than there are chunks for), then
+            // the calling thread drives too - so progress is guaranteed even when
+            // every worker is busy (e.g. a parallel_for inside a pool task)
+            const std::size_t ndrivers = std::min (nw, nchunks - 1);
+            for (std::size_t i = 0; i < ndrivers; ++i) { this->run (drive); }
+            drive();
+
+            std::unique_lock<std::mutex> lk (st->mtx);
+            st->cv.wait (lk, [&st, nchunks] { return st->n_done.load() >= nchunks; });
+            if (st->eptr) { std::rethrow_exception (st->eptr); }
+        }
+
+    private:
+        //! One worker's deque of tasks and the mutex protecting it
+        struct workqueue
+        {
+            std::mutex mtx;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        //! The state shared by one parallel_for call's drivers
+        struct pf_state
+        {
+            std::atomic<std::size_t> next_chunk = 0;
+            std::atomic<std::size_t> n_done = 0;
+            std::mutex mtx;
+            std::condition_variable cv;
+            std::exception_ptr eptr = nullptr;
+        };
+
+        //! The worker thread function: pop own deque from the back (LIFO - the most
+        //! recently pushed task is the cache-warmest), steal from other deques from
+        //! the front (FIFO - take the task its owner would reach last), sleep when
+        //! there is nothing to do anywhere.
+        void worker_loop (const std::size_t me)
+        {
+            const std::size_t nq = this->queues.size();
+            for (;;) {
+                std::function<void()> task;
+                {
+                    std::lock_guard<std::mutex> lk (this->queues[me]->mtx);
+                    if (!this->queues[me]->tasks.empty()) {
+                        task = std::move (this->queues[me]->tasks.back());
+                        this->queues[me]->tasks.pop_back();
+                    }
+                }
+                if (!task) {
+                    for (std::size_t off = 1; off < nq && !task; ++off) {
+                        workqueue* victim = this->queues[(me + off) % nq].get();
+                        std::lock_guard<std::mutex> lk (victim->mtx);
+                        if (!victim->tasks.empty()) {
+                            task = std::move (victim->tasks.front());
+                            victim->tasks.pop_front();
+                        }
+                    }
+                }
+                if (task) {
+                    this->n_tasks.fetch_sub (1);
+                    task();
+                    continue;
+                }
+                std::unique_lock<std::mutex> lk (this->sleep_mtx);
+                this->sleep_cv.wait (lk, [this] {
+                    return this->stopping.load() || this->n_tasks.load() > 0;
+                });
+                if (this->stopping.load() && this->n_tasks.load() == 0) { return; }
+            }
+        }
+
+        //! The per-worker task deques
+        std::vector<std::unique_ptr<workqueue>> queues;
+        //! The worker threads
+        std::vector<std::thread> workers;
+        //! Round-robin index for distributing submitted tasks
+        std::atomic<std::size_t> next_queue = 0;
+        //! Count of submitted-but-not-yet-claimed tasks, across all deques
+        std::atomic<std::size_t> n_tasks = 0;
+        //! Set by the destructor; workers drain their deques and exit
+        std::atomic<bool> stopping = false;
+        //! Workers sleep here when all deques are empty
+        std::mutex sleep_mtx;
+        std::condition_variable sleep_cv;
+    };
+
+} // namespace morph
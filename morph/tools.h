@@ -342,13 +342,30 @@ namespace morph
          */
         void copyFileToString (std::istream& from, std::string& to)
         {
-            char buf[64];
+            char buf[16384];
             while (!from.eof()) {
-                from.read (buf, 63);
+                from.read (buf, 16383);
                 to.append (buf, from.gcount());
             }
         }
 
+        /*!
+         * Read the whole of the file at \a path into the returned string with one bulk read
+         * (no line-by-line or small-buffer copying). Throws if the file can't be opened.
+         */
+        std::string readFileToString (const std::string& path)
+        {
+            std::ifstream f (path, std::ios::in | std::ios::binary);
+            if (!f.is_open()) {
+                std::stringstream ee;
+                ee << "Failed to open file '" << path << "' for reading";
+                throw std::runtime_error (ee.str());
+            }
+            std::string rtn (std::filesystem::file_size (path), '\0');
+            f.read (rtn.data(), rtn.size());
+            return rtn;
+        }
+
         /*!
          * Copy a string fromstr to a file named to
          */
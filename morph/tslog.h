@@ -0,0 +1,335 @@
+/*!
+ * \file
+ *
+ * \brief An mmap-backed, append-only time-series log for high-rate telemetry
+ *
+ * HdfData is the right container for end-of-run results, but logging a handful of
+ * scalars *every step* through it costs an open/write/close cycle per step. A
+ * morph::tslog_writer maps a binary log file into memory and appends fixed-stride
+ * records with a memcpy plus one atomic store - the kernel writes pages back in the
+ * background, so the simulation loop never blocks on I/O. The record count in the
+ * file header is published with release ordering only after the record's bytes are
+ * in place, making the log crash-safe (a record is either fully present and
+ * counted, or absent) and allowing a lock-free single-writer/many-reader setup: a
+ * morph::tslog_reader in the same or another process can tail() the live file, so
+ * a GraphVisual can plot a running simulation's telemetry as it is produced:
+ *
+ * \code
+ *   // Simulation side: three columns per step
+ *   morph::tslog_writer<double> log ("energies.tsl", 3);
+ *   log.append ({ t, E_kinetic, E_potential });
+ *   // Viewer side, each frame:
+ *   morph::tslog_reader<double> tail ("energies.tsl");
+ *   for (auto rec : tail.tail (n_seen)) { graph->append (rec[0], rec[1], "Ek"); }
+ *   n_seen = tail.n_records();
+ * \endcode
+ *
+ * POSIX only, like morph::MappedFile and morph::Process.
+ *
+ * \author Seb James
+ * \date August 2026
+ */
+#pragma once
+
+#include <vector>
+#include <string>
+#include <span>
+#include <atomic>
+#include <stdexcept>
+#include <algorithm>
+#include <initializer_list>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace morph {
+
+    namespace tslog {
+        //! The on-disk file header, one 64 byte block before the records. n_records
+        //! is written last (release) and read first (acquire), so a reader never
+        //! sees a record which is not fully on the page.
+        struct header
+        {
+            char magic[8];             // "morphTSL"
+            std::uint32_t version;     // format version, currently 1
+            std::uint32_t elem_size;   // sizeof the element type
+            std::uint32_t ncols;       // elements per record
+            std::uint32_t reserved;
+            std::uint64_t n_records;   // the published record count
+            char pad[32];              // zeroes, reserving space in the 64 byte block
+        };
+        static_assert (sizeof(header) == 64);
+        constexpr char magic[8] = { 'm','o','r','p','h','T','S','L' };
+    }
+
+    /*!
+     * The writing side of a time-series log: appends fixed-stride records of \a
+     * ncols elements of type T to an mmapped file. Strictly single-writer; appends
+     * are lock-free. Opening an existing log appends to it (the element size and
+     * column count must match).
+     */
+    template <typename T>
+    class tslog_writer
+    {
+    public:
+        //! Open (creating if necessary) the log at \a path for records of \a ncols
+        //! elements, pre-mapping room for \a capacity_hint records
+        tslog_writer (const std::string& path, const std::size_t ncols,
+                      const std::size_t capacity_hint = 4096)
+            : filepath (path)
+            , stride (ncols * sizeof(T))
+        {
+            if (ncols == 0) { throw std::runtime_error ("tslog_writer: ncols must be > 0"); }
+            this->fd = ::open (path.c_str(), O_RDWR | O_CREAT, 0644);
+            if (this->fd == -1) {
+                throw std::runtime_error ("tslog_writer: failed to open " + path + " for writing");
+            }
+            struct stat sb;
+            if (fstat (this->fd, &sb) == -1) {
+                ::close (this->fd);
+                throw std::runtime_error ("tslog_writer: failed to stat " + path);
+            }
+            const bool fresh = (sb.st_size == 0);
+            std::size_t cap = std::max (capacity_hint, std::size_t{64});
+            if (!fresh) {
+                // An existing log: validate its header before appending, and map at
+                // least what is already there
+                tslog::header h;
+                if (::read (this->fd, &h, sizeof(h)) != static_cast<ssize_t>(sizeof(h))
+                    || std::memcmp (h.magic, tslog::magic, 8) != 0 || h.version != 1) {
+                    ::close (this->fd);
+                    throw std::runtime_error ("tslog_writer: " + path + " is not a morph::tslog file");
+                }
+                if (h.elem_size != sizeof(T) || h.ncols != ncols) {
+                    ::close (this->fd);
+                    throw std::runtime_error ("tslog_writer: " + path + " has a different record layout");
+                }
+                cap = std::max (cap, static_cast<std::size_t>(h.n_records) * 2);
+            }
+            this->remap (cap);
+            if (fresh) {
+                tslog::header h = {};
+                std::memcpy (h.magic, tslog::magic, 8);
+                h.version = 1;
+                h.elem_size = sizeof(T);
+                h.ncols = static_cast<std::uint32_t>(ncols);
+                h.n_records = 0;
+                std::memcpy (this->map, &h, sizeof(h));
+            }
+        }
+
+        ~tslog_writer()
+        {
+            if (this->map != nullptr) {
+                // Trim the preallocation so the file ends at the last record
+                const std::size_t used = sizeof(tslog::header) + this->n_records() * this->stride;
+                munmap (this->map, this->mapped_sz);
+                this->map = nullptr;
+                if (ftruncate (this->fd, static_cast<off_t>(used)) == -1) { /* best effort */ }
+            }
+            if (this->fd != -1) { ::close (this->fd); }
+        }
+
+        //! No copying (the mapping is owned) and no moving either - a tslog_writer
+        //! lives where the logging happens
+        tslog_writer (const tslog_writer&) = delete;
+        tslog_writer& operator= (const tslog_writer&) = delete;
+
+        //! Append one record from \a vals, which must hold ncols() elements. The
+        //! hot path: a memcpy onto the mapping and one release store.
+        void append (const T* vals)
+        {
+            const std::uint64_t n = this->count_ref().load (std::memory_order_relaxed);
+            const std::size_t need = sizeof(tslog::header) + (n + 1) * this->stride;
+            if (need > this->mapped_sz) { this->remap (static_cast<std::size_t>(n) * 2); }
+            std::memcpy (static_cast<char*>(this->map) + sizeof(tslog::header) + n * this->stride,
+                         vals, this->stride);
+            this->count_ref().store (n + 1, std::memory_order_release);
+        }
+
+        //! Append one record from a vector (or vvec), size-checked
+        void append (const std::vector<T>& vals)
+        {
+            if (vals.size() != this->ncols()) {
+                throw std::runtime_error ("tslog_writer::append: record has wrong number of columns");
+            }
+            this->append (vals.data());
+        }
+
+        //! Append one record from a braced list: log.append ({ t, x, y });
+        void append (std::initializer_list<T> vals)
+        {
+            if (vals.size() != this->ncols()) {
+                throw std::runtime_error ("tslog_writer::append: record has wrong number of columns");
+            }
+            this->append (vals.begin());
+        }
+
+        //! Ask the kernel to start writing dirty pages back now (asynchronous;
+        //! appends continue unimpeded). Data durability for readers needs nothing -
+        //! they see appends immediately via the shared mapping.
+        void sync() { msync (this->map, this->mapped_sz, MS_ASYNC); }
+
+        //! The number of records appended so far
+        std::size_t n_records() const { return this->count_ref().load (std::memory_order_relaxed); }
+
+        //! Elements per record
+        std::size_t ncols() const { return this->stride / sizeof(T); }
+
+    private:
+        //! An atomic view of the header's record count, on the mapped page
+        std::atomic_ref<std::uint64_t> count_ref() const
+        {
+            return std::atomic_ref<std::uint64_t> (reinterpret_cast<tslog::header*>(this->map)->n_records);
+        }
+
+        //! Grow the file to hold \a cap records and (re)establish the mapping
+        void remap (std::size_t cap)
+        {
+            cap = std::max (cap, std::size_t{64});
+            const std::size_t sz = sizeof(tslog::header) + cap * this->stride;
+            if (ftruncate (this->fd, static_cast<off_t>(sz)) == -1) {
+                throw std::runtime_error ("tslog_writer: failed to grow " + this->filepath);
+            }
+            if (this->map != nullptr) { munmap (this->map, this->mapped_sz); }
+            this->map = mmap (nullptr, sz, PROT_READ | PROT_WRITE, MAP_SHARED, this->fd, 0);
+            if (this->map == MAP_FAILED) {
+                this->map = nullptr;
+                throw std::runtime_error ("tslog_writer: mmap failed for " + this->filepath);
+            }
+            this->mapped_sz = sz;
+        }
+
+        std::string filepath;
+        //! Bytes per record
+        std::size_t stride;
+        int fd = -1;
+        void* map = nullptr;
+        std::size_t mapped_sz = 0;
+    };
+
+    /*!
+     * The reading side: a read-only mapping of a (possibly still growing) log.
+     * n_records() and tail() see the writer's appends as they are published;
+     * refresh() extends the mapping when the writer has grown the file.
+     */
+    template <typename T>
+    class tslog_reader
+    {
+    public:
+        explicit tslog_reader (const std::string& path)
+            : filepath (path)
+        {
+            this->fd = ::open (path.c_str(), O_RDONLY);
+            if (this->fd == -1) {
+                throw std::runtime_error ("tslog_reader: failed to open " + path);
+            }
+            this->remap();
+            const tslog::header* h = static_cast<const tslog::header*>(this->map);
+            if (this->mapped_sz < sizeof(tslog::header)
+                || std::memcmp (h->magic, tslog::magic, 8) != 0 || h->version != 1) {
+                munmap (this->map, this->mapped_sz);
+                ::close (this->fd);
+                this->map = nullptr;
+                throw std::runtime_error ("tslog_reader: " + path + " is not a morph::tslog file");
+            }
+            if (h->elem_size != sizeof(T)) {
+                munmap (this->map, this->mapped_sz);
+                ::close (this->fd);
+                this->map = nullptr;
+                throw std::runtime_error ("tslog_reader: " + path + " holds a different element type");
+            }
+            this->stride = h->ncols * sizeof(T);
+        }
+
+        ~tslog_reader()
+        {
+            if (this->map != nullptr) { munmap (this->map, this->mapped_sz); }
+            if (this->fd != -1) { ::close (this->fd); }
+        }
+
+        tslog_reader (const tslog_reader&) = delete;
+        tslog_reader& operator= (const tslog_reader&) = delete;
+
+        //! The number of complete records currently in the log. Extends the mapping
+        //! first if the writer has grown the file.
+        std::size_t n_records()
+        {
+            std::uint64_t n = this->count_ref().load (std::memory_order_acquire);
+            if (sizeof(tslog::header) + n * this->stride > this->mapped_sz) {
+                this->remap();
+                n = this->count_ref().load (std::memory_order_acquire);
+                // Never report records beyond the mapping (the writer may have
+                // appended again between our fstat and this load)
+                n = std::min (n, static_cast<std::uint64_t>((this->mapped_sz - sizeof(tslog::header)) / this->stride));
+            }
+            return static_cast<std::size_t>(n);
+        }
+
+        //! Record \a i as a span of ncols() elements. No bounds check beyond the
+        //! caller staying below n_records().
+        std::span<const T> record (const std::size_t i) const
+        {
+            const char* p = static_cast<const char*>(this->map) + sizeof(tslog::header) + i * this->stride;
+            return std::span<const T> (reinterpret_cast<const T*>(p), this->stride / sizeof(T));
+        }
+
+        /*!
+         * The records from index \a from (typically how many you had consumed last
+         * time) up to the current count, flat in a single span of
+         * (n_records()-from)*ncols() elements - use record() or step by ncols() to
+         * walk them. Empty if nothing new has arrived.
+         */
+        std::span<const T> tail (const std::size_t from)
+        {
+            const std::size_t n = this->n_records();
+            if (from >= n) { return std::span<const T>{}; }
+            const char* p = static_cast<const char*>(this->map) + sizeof(tslog::header) + from * this->stride;
+            return std::span<const T> (reinterpret_cast<const T*>(p), (n - from) * this->stride / sizeof(T));
+        }
+
+        //! Elements per record
+        std::size_t ncols() const { return this->stride / sizeof(T); }
+
+    private:
+        std::atomic_ref<std::uint64_t> count_ref() const
+        {
+            // const_cast: atomic_ref wants a mutable ref, but we only load
+            return std::atomic_ref<std::uint64_t> (const_cast<tslog::header*>(static_cast<const tslog::header*>(this->map))->n_records);
+        }
+
+        //! (Re)map the file at its current size
+        void remap()
+        {
+            struct stat sb;
+            if (fstat (this->fd, &sb) == -1) {
+                throw std::runtime_error ("tslog_reader: failed to stat " + this->filepath);
+            }
+            const std::size_t sz = static_cast<std::size_t>(sb.st_size);
+            if (sz < sizeof(tslog::header)) {
+                throw std::runtime_error ("tslog_reader: " + this->filepath + " is too short to be a morph::tslog file");
+            }
+            if (this->map != nullptr) {
+                if (sz == this->mapped_sz) { return; }
+                munmap (this->map, this->mapped_sz);
+            }
+            this->map = mmap (nullptr, sz, PROT_READ, MAP_SHARED, this->fd, 0);
+            if (this->map == MAP_FAILED) {
+                this->map = nullptr;
+                throw std::runtime_error ("tslog_reader: mmap failed for " + this->filepath);
+            }
+            this->mapped_sz = sz;
+        }
+
+        std::string filepath;
+        std::size_t stride = 0;
+        int fd = -1;
+        void* map = nullptr;
+        std::size_t mapped_sz = 0;
+    };
+
+} // namespace morph
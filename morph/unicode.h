@@ -10,6 +10,8 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace morph {
 
@@ -156,12 +158,30 @@ namespace morph {
         static constexpr char32_t lessthanapproxeq = 0x2272;
         static constexpr char32_t greaterthanapproxeq = 0x2273;
 
+        //! \return true if no byte of \a input has its top bit set, i.e. the string is
+        //! pure 7 bit ASCII and needs no UTF-8 decoding
+        static bool isAscii (const std::string& input) noexcept
+        {
+            for (const char c : input) { if (c & 0x80) { return false; } }
+            return true;
+        }
+
         //! Convert an input 8 bit string encoded in UTF-8 (or ASCII) format into an
         //! output string of unicode characters.
         static std::basic_string<char32_t> fromUtf8 (const std::string& input)
         {
             std::basic_string<char32_t> utxt;
 
+            // Fast path: most strings passed for text layout (tick labels, axis
+            // labels) are plain ASCII, which widens byte-for-byte with no decoding
+            if (unicode::isAscii (input)) {
+                utxt.resize (input.size());
+                for (std::string::size_type i = 0; i < input.size(); ++i) {
+                    utxt[i] = static_cast<char32_t>(static_cast<unsigned char>(input[i]));
+                }
+                return utxt;
+            }
+
             // Fix this so that it *interprets* _txt as unicode and builds up utxt
             // accordingly. Then I only have to have char32_t here.
             char32_t uc = 0;
@@ -217,6 +237,45 @@ namespace morph {
             return utxt;
         }
 
+        /*!
+         * As fromUtf8, but interning the result: the decoded codepoint sequence for
+         * each distinct input is cached (per thread) and returned by const reference on
+         * subsequent calls. Text layout re-decodes identical strings - the same axis
+         * and tick labels - thousands of times per session, so repeat lookups become a
+         * hash table probe instead of a decode plus an allocation. Pure-ASCII inputs
+         * skip decoding either way, so the cache only holds strings with multibyte
+         * sequences. The cache is cleared if it grows past 4096 entries; the reference
+         * is invalidated by the next fromUtf8_cached call, so copy it (or use it
+         * immediately) rather than storing it.
+         */
+        static const std::basic_string<char32_t>& fromUtf8_cached (const std::string& input)
+        {
+            static thread_local std::unordered_map<std::string, std::basic_string<char32_t>> cache;
+            static thread_local std::basic_string<char32_t> ascii_scratch;
+            if (unicode::isAscii (input)) {
+                ascii_scratch.resize (input.size());
+                for (std::string::size_type i = 0; i < input.size(); ++i) {
+                    ascii_scratch[i] = static_cast<char32_t>(static_cast<unsigned char>(input[i]));
+                }
+                return ascii_scratch;
+            }
+            auto it = cache.find (input);
+            if (it == cache.end()) {
+                if (cache.size() >= 4096u) { cache.clear(); }
+                it = cache.emplace (input, unicode::fromUtf8 (input)).first;
+            }
+            return it->second;
+        }
+
+        //! Bulk conversion of many UTF-8 strings (such as a full set of tick labels)
+        //! into codepoint sequences, going via the thread-local cache
+        static std::vector<std::basic_string<char32_t>> fromUtf8_bulk (const std::vector<std::string>& inputs)
+        {
+            std::vector<std::basic_string<char32_t>> utxts (inputs.size());
+            for (std::size_t i = 0; i < inputs.size(); ++i) { utxts[i] = unicode::fromUtf8_cached (inputs[i]); }
+            return utxts;
+        }
+
         // Convert the Unicode char32_t c into a std::string containing the
         // corrresponding UTF-8 character code sequence.
         static std::string toUtf8 (const char32_t c)
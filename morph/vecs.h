@@ -0,0 +1,176 @@
+/*!
+ * \file
+ *
+ * \brief A structure-of-arrays companion to std::vector<morph::vec<S, N>>
+ *
+ * Point clouds in morphologica are usually held as std::vector<morph::vec<float, 3>>,
+ * which interleaves x/y/z in memory. That layout is right for per-point work (handing a
+ * coordinate to computeSphere, say) but defeats vectorization of bulk transforms: a
+ * loop adding an offset to every point strides through memory touching one lane in
+ * three. morph::vecs<S, N> stores the same points as N separate morph::vvec<S>
+ * components, so bulk add/scale/length run as contiguous vvec arithmetic that the
+ * compiler auto-vectorizes, while operator[] still reads or writes whole points as
+ * morph::vec<S, N> (writes via a proxy). Convert to/from the interleaved form with the
+ * std::vector<vec> constructor, set_from() and to_aos().
+ *
+ * \author Seb James
+ * \date August 2026
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+#include <morph/vec.h>
+#include <morph/vvec.h>
+
+namespace morph {
+
+    //! A fixed-dimension point cloud in structure-of-arrays layout: component j of
+    //! point i is comp[j][i]. S is the scalar type, N the dimensionality.
+    template <typename S = float, std::size_t N = 3>
+    struct vecs
+    {
+        //! The component arrays. Public, like the data in the containers this
+        //! complements; comp[0] is all the x values, and so on.
+        std::array<morph::vvec<S>, N> comps;
+
+        vecs() = default;
+        //! Construct with \a n zeroed points
+        explicit vecs (const std::size_t n) { this->resize (n); }
+        //! Construct from interleaved (array-of-structures) points
+        vecs (const std::vector<morph::vec<S, N>>& aos) { this->set_from (aos); }
+
+        //! Gather-read point \a i as a morph::vec
+        morph::vec<S, N> operator[] (const std::size_t i) const
+        {
+            morph::vec<S, N> v;
+            for (std::size_t j = 0; j < N; ++j) { v[j] = this->comps[j][i]; }
+            return v;
+        }
+
+        //! A proxy for one point of a non-const vecs: converts to morph::vec on read
+        //! and scatters a morph::vec across the component arrays on assignment
+        struct point_proxy
+        {
+            vecs<S, N>& vs;
+            std::size_t i;
+            operator morph::vec<S, N>() const
+            {
+                morph::vec<S, N> v;
+                for (std::size_t j = 0; j < N; ++j) { v[j] = vs.comps[j][i]; }
+                return v;
+            }
+            point_proxy& operator= (const morph::vec<S, N>& v)
+            {
+                for (std::size_t j = 0; j < N; ++j) { vs.comps[j][i] = v[j]; }
+                return *this;
+            }
+            // vec's comparisons are templates, so the implicit conversion above won't
+            // be found for proxy == vec; provide the comparison directly
+            bool operator== (const morph::vec<S, N>& v) const
+            {
+                return static_cast<morph::vec<S, N>>(*this) == v;
+            }
+            bool operator!= (const morph::vec<S, N>& v) const { return !(*this == v); }
+        };
+        point_proxy operator[] (const std::size_t i) { return point_proxy{ *this, i }; }
+
+        //! The x component array (and y and z, where the dimensionality has them)
+        morph::vvec<S>& x() { return this->comps[0]; }
+        const morph::vvec<S>& x() const { return this->comps[0]; }
+        morph::vvec<S>& y() requires (N > 1) { return this->comps[1]; }
+        const morph::vvec<S>& y() const requires (N > 1) { return this->comps[1]; }
+        morph::vvec<S>& z() requires (N > 2) { return this->comps[2]; }
+        const morph::vvec<S>& z() const requires (N > 2) { return this->comps[2]; }
+
+        std::size_t size() const { return this->comps[0].size(); }
+        bool empty() const { return this->comps[0].empty(); }
+        void resize (const std::size_t n)
+        {
+            for (std::size_t j = 0; j < N; ++j) { this->comps[j].resize (n, S{0}); }
+        }
+        void reserve (const std::size_t n)
+        {
+            for (std::size_t j = 0; j < N; ++j) { this->comps[j].reserve (n); }
+        }
+        void clear() { for (std::size_t j = 0; j < N; ++j) { this->comps[j].clear(); } }
+        void push_back (const morph::vec<S, N>& v)
+        {
+            for (std::size_t j = 0; j < N; ++j) { this->comps[j].push_back (v[j]); }
+        }
+
+        //! Replace the contents with the points of the interleaved \a aos
+        void set_from (const std::vector<morph::vec<S, N>>& aos)
+        {
+            const std::size_t n = aos.size();
+            this->resize (n);
+            for (std::size_t j = 0; j < N; ++j) {
+                morph::vvec<S>& cj = this->comps[j];
+                for (std::size_t i = 0; i < n; ++i) { cj[i] = aos[i][j]; }
+            }
+        }
+
+        //! \return the points in interleaved (array-of-structures) form
+        std::vector<morph::vec<S, N>> to_aos() const
+        {
+            const std::size_t n = this->size();
+            std::vector<morph::vec<S, N>> aos (n);
+            for (std::size_t j = 0; j < N; ++j) {
+                const morph::vvec<S>& cj = this->comps[j];
+                for (std::size_t i = 0; i < n; ++i) { aos[i][j] = cj[i]; }
+            }
+            return aos;
+        }
+
+        /*
+         * Bulk arithmetic. Each runs as N contiguous vvec operations, one component
+         * array at a time - the loops the SoA layout exists to make vectorizable.
+         */
+
+        //! Translate every point by \a v
+        vecs<S, N>& operator+= (const morph::vec<S, N>& v)
+        {
+            for (std::size_t j = 0; j < N; ++j) { this->comps[j] += v[j]; }
+            return *this;
+        }
+        vecs<S, N>& operator-= (const morph::vec<S, N>& v)
+        {
+            for (std::size_t j = 0; j < N; ++j) { this->comps[j] -= v[j]; }
+            return *this;
+        }
+        //! Scale every point by \a s
+        vecs<S, N>& operator*= (const S& s)
+        {
+            for (std::size_t j = 0; j < N; ++j) { this->comps[j] *= s; }
+            return *this;
+        }
+        vecs<S, N>& operator/= (const S& s)
+        {
+            for (std::size_t j = 0; j < N; ++j) { this->comps[j] /= s; }
+            return *this;
+        }
+        //! Pointwise addition of an equal-sized cloud (e.g. displacements)
+        vecs<S, N>& operator+= (const vecs<S, N>& other)
+        {
+            for (std::size_t j = 0; j < N; ++j) { this->comps[j] += other.comps[j]; }
+            return *this;
+        }
+        vecs<S, N>& operator-= (const vecs<S, N>& other)
+        {
+            for (std::size_t j = 0; j < N; ++j) { this->comps[j] -= other.comps[j]; }
+            return *this;
+        }
+
+        //! \return the squared length of every point
+        morph::vvec<S> lengths_sq() const
+        {
+            morph::vvec<S> lsq (this->size(), S{0});
+            for (std::size_t j = 0; j < N; ++j) { lsq += this->comps[j] * this->comps[j]; }
+            return lsq;
+        }
+        //! \return the length of every point
+        morph::vvec<S> lengths() const { return this->lengths_sq().sqrt(); }
+    };
+
+} // namespace morph
@@ -20,8 +20,12 @@
 #include <algorithm>
 #include <functional>
 #include <cstddef>
+#include <array>
+#include <morph/AllocationStats.h>
+#include <morph/fastmath.h>
 #include <morph/Random.h>
 #include <morph/range.h>
+#include <morph/simd.h>
 #include <morph/trait_tests.h>
 
 namespace morph {
@@ -60,7 +64,9 @@ namespace morph {
      */
     template <typename S, typename Al> std::ostream& operator<< (std::ostream&, const vvec<S, Al>&);
 
-    template <typename S=float, typename Al=std::allocator<S>>
+    // vvec's default allocator is std::allocator, unless this is a MORPH_ALLOC_STATS
+    // build, in which case allocations are counted (see morph/AllocationStats.h)
+    template <typename S=float, typename Al=morph::vvec_allocator<S>>
     struct vvec : public std::vector<S, Al>
     {
         //! We inherit std::vector's constructors like this:
@@ -544,12 +550,20 @@ namespace morph {
         template <typename Sy=S>
         Sy length() const noexcept
         {
-            auto add_squared = [](Sy a, S b) { return a + b * b; };
-            // Add check on whether return type Sy is integral or float. If integral, then std::round then cast the result of std::sqrt()
-            if constexpr (std::is_integral<std::decay_t<Sy>>::value == true) {
-                return static_cast<Sy>(std::round(std::sqrt(std::accumulate(this->begin(), this->end(), Sy{0}, add_squared))));
+            if constexpr (morph::simd::simdable<S> && std::is_same<std::decay_t<Sy>, S>::value) {
+                // Add check on whether return type Sy is integral or float. If integral, then std::round then cast the result of std::sqrt()
+                if constexpr (std::is_integral<std::decay_t<Sy>>::value == true) {
+                    return static_cast<Sy>(std::round (std::sqrt (morph::simd::sos (this->data(), this->size()))));
+                } else {
+                    return std::sqrt (morph::simd::sos (this->data(), this->size()));
+                }
             } else {
-                return std::sqrt(std::accumulate(this->begin(), this->end(), Sy{0}, add_squared));
+                auto add_squared = [](Sy a, S b) { return a + b * b; };
+                if constexpr (std::is_integral<std::decay_t<Sy>>::value == true) {
+                    return static_cast<Sy>(std::round(std::sqrt(std::accumulate(this->begin(), this->end(), Sy{0}, add_squared))));
+                } else {
+                    return std::sqrt(std::accumulate(this->begin(), this->end(), Sy{0}, add_squared));
+                }
             }
         }
 
@@ -634,8 +648,12 @@ namespace morph {
         template <typename Sy=S>
         Sy sos() const noexcept
         {
-            auto add_squared = [](Sy a, S b) { return a + b * b; };
-            return std::accumulate (this->begin(), this->end(), Sy{0}, add_squared);
+            if constexpr (morph::simd::simdable<S> && std::is_same<std::decay_t<Sy>, S>::value) {
+                return morph::simd::sos (this->data(), this->size());
+            } else {
+                auto add_squared = [](Sy a, S b) { return a + b * b; };
+                return std::accumulate (this->begin(), this->end(), Sy{0}, add_squared);
+            }
         }
 
         //! \return the value of the longest component of the vector.
@@ -1087,7 +1105,7 @@ namespace morph {
         template<typename Sy=S>
         Sy mean() const noexcept
         {
-            const Sy sum = std::accumulate (this->begin(), this->end(), Sy{0});
+            const Sy sum = this->template sum<Sy>();
             return sum / this->size();
         }
 
@@ -1119,7 +1137,11 @@ namespace morph {
         template<typename Sy=S>
         Sy sum() const noexcept
         {
-            return std::accumulate (this->begin(), this->end(), Sy{0});
+            if constexpr (morph::simd::simdable<S> && std::is_same<std::decay_t<Sy>, S>::value) {
+                return morph::simd::sum (this->data(), this->size());
+            } else {
+                return std::accumulate (this->begin(), this->end(), Sy{0});
+            }
         }
 
         //! \return the product of the elements. If elements are of a constrained type, you can call
@@ -1133,6 +1155,218 @@ namespace morph {
             return std::accumulate (this->begin(), this->end(), Sy{0}, _product);
         }
 
+        /*!
+         * Fused, variadic zip/map transform. Set each element of *this from the
+         * corresponding elements of any number of same-sized input containers:
+         *
+         *   (*this)[i] = f (v1[i], v2[i], ...)
+         *
+         * for every i, in one loop - no temporaries, so multi-input element-wise
+         * updates like dst[i] = a[i]*k + b[i]*c[i] become
+         *
+         *   dst.zip_map ([k](float a, float b, float c){ return a*k + b*c; }, a, b, c);
+         *
+         * where chained vvec operators would allocate a vvec per operation. *this is
+         * resized to match the inputs, and *this may itself be one of the inputs - the
+         * update is element-wise at a single index, so in-place use is safe. The
+         * inputs need only provide operator[] and size() (vvec, vec, std::vector and
+         * std::array all qualify). Throws std::runtime_error if the input sizes
+         * differ. The loop body is a single expression over contiguous arrays, so the
+         * compiler can vectorize it; for large vvecs there is zip_map_par().
+         */
+        template <typename F, typename... Vs>
+        void zip_map (F&& f, const Vs&... vs)
+        {
+            static_assert (sizeof...(Vs) > 0, "zip_map: pass at least one input container");
+            const std::size_t n = vvec::zip_size (vs...);
+            this->resize (n);
+            for (std::size_t i = 0; i < n; ++i) { (*this)[i] = f (vs[i]...); }
+        }
+
+        //! Parallel (OpenMP) version of zip_map(): the fused loop is spread across
+        //! cores. Worth calling on large (say, >100k element) vvecs; f must be safe to
+        //! call concurrently for distinct indices.
+        template <typename F, typename... Vs>
+        void zip_map_par (F&& f, const Vs&... vs)
+        {
+            static_assert (sizeof...(Vs) > 0, "zip_map_par: pass at least one input container");
+            const std::size_t n = vvec::zip_size (vs...);
+            this->resize (n);
+#pragma omp parallel for
+            for (std::size_t i = 0; i < n; ++i) { (*this)[i] = f (vs[i]...); }
+        }
+
+        //! The common size of the containers \a vs, for zip_map(). Throws
+        //! std::runtime_error unless all sizes are equal.
+        template <typename... Vs>
+        static std::size_t zip_size (const Vs&... vs)
+        {
+            const std::array<std::size_t, sizeof...(Vs)> szs = { vs.size()... };
+            for (const std::size_t& sz : szs) {
+                if (sz != szs[0]) { throw std::runtime_error ("zip_map: input containers must all be the same size"); }
+            }
+            return szs[0];
+        }
+
+        /*
+         * Parallel variants of the heavy reductions and transforms. These use OpenMP to spread
+         * the work over all cores and are worth calling on large (say, >100k element)
+         * vvecs. Compiled without OpenMP, the pragmas are ignored and these all reduce to the
+         * serial algorithm, so they remain safe to call unconditionally.
+         */
+
+        //! Parallel (OpenMP) version of sum(). For floating point S the summation order differs
+        //! from sum(), so expect last-ulp differences.
+        template<typename Sy=S, std::enable_if_t<std::is_arithmetic<std::decay_t<Sy>>::value, int> = 0 >
+        Sy sum_par() const noexcept
+        {
+            Sy rtn = Sy{0};
+#pragma omp parallel for reduction(+:rtn)
+            for (std::size_t i = 0; i < this->size(); ++i) { rtn += static_cast<Sy>((*this)[i]); }
+            return rtn;
+        }
+
+        //! Parallel (OpenMP) version of max() for scalar element types
+        template <typename Sy=S, std::enable_if_t<std::is_arithmetic<std::decay_t<Sy>>::value, int> = 0 >
+        S max_par() const noexcept
+        {
+            if (this->empty()) { return S{0}; }
+            S m = std::numeric_limits<S>::lowest();
+#pragma omp parallel for reduction(max:m)
+            for (std::size_t i = 0; i < this->size(); ++i) { m = (*this)[i] > m ? (*this)[i] : m; }
+            return m;
+        }
+
+        //! Parallel (OpenMP) version of min() for scalar element types
+        template <typename Sy=S, std::enable_if_t<std::is_arithmetic<std::decay_t<Sy>>::value, int> = 0 >
+        S min_par() const noexcept
+        {
+            if (this->empty()) { return S{0}; }
+            S m = std::numeric_limits<S>::max();
+#pragma omp parallel for reduction(min:m)
+            for (std::size_t i = 0; i < this->size(); ++i) { m = (*this)[i] < m ? (*this)[i] : m; }
+            return m;
+        }
+
+        //! Parallel (OpenMP) version of argmax(). Ties break towards the lowest index, matching
+        //! the behaviour of the serial argmax().
+        template <typename Sy=S, std::enable_if_t<std::is_arithmetic<std::decay_t<Sy>>::value, int> = 0 >
+        std::size_t argmax_par() const noexcept
+        {
+            std::size_t idx = 0;
+            S maxv = std::numeric_limits<S>::lowest();
+#pragma omp parallel
+            {
+                std::size_t local_idx = 0;
+                S local_max = std::numeric_limits<S>::lowest();
+#pragma omp for nowait
+                for (std::size_t i = 0; i < this->size(); ++i) {
+                    if ((*this)[i] > local_max) { local_max = (*this)[i]; local_idx = i; }
+                }
+#pragma omp critical (vvec_argmax_par)
+                {
+                    if (local_max > maxv || (local_max == maxv && local_idx < idx)) { maxv = local_max; idx = local_idx; }
+                }
+            }
+            return idx;
+        }
+
+        //! Parallel (OpenMP) version of argmin(). Ties break towards the lowest index.
+        template <typename Sy=S, std::enable_if_t<std::is_arithmetic<std::decay_t<Sy>>::value, int> = 0 >
+        std::size_t argmin_par() const noexcept
+        {
+            std::size_t idx = 0;
+            S minv = std::numeric_limits<S>::max();
+#pragma omp parallel
+            {
+                std::size_t local_idx = 0;
+                S local_min = std::numeric_limits<S>::max();
+#pragma omp for nowait
+                for (std::size_t i = 0; i < this->size(); ++i) {
+                    if ((*this)[i] < local_min) { local_min = (*this)[i]; local_idx = i; }
+                }
+#pragma omp critical (vvec_argmin_par)
+                {
+                    if (local_min < minv || (local_min == minv && local_idx < idx)) { minv = local_min; idx = local_idx; }
+                }
+            }
+            return idx;
+        }
+
+        //! Parallel (OpenMP) version of shortest() for scalar element types: the element of
+        //! smallest magnitude.
+        template <typename Sy=S, std::enable_if_t<std::is_arithmetic<std::decay_t<Sy>>::value, int> = 0 >
+        S shortest_par() const noexcept
+        {
+            if (this->empty()) { return S{0}; }
+            S shrt = (*this)[0];
+#pragma omp parallel
+            {
+                S local_shrt = (*this)[0];
+#pragma omp for nowait
+                for (std::size_t i = 0; i < this->size(); ++i) {
+                    if (std::abs ((*this)[i]) < std::abs (local_shrt)) { local_shrt = (*this)[i]; }
+                }
+#pragma omp critical (vvec_shortest_par)
+                {
+                    if (std::abs (local_shrt) < std::abs (shrt)) { shrt = local_shrt; }
+                }
+            }
+            return shrt;
+        }
+
+        //! Parallel (OpenMP) version of rescale(): rescale elements so that the minimum maps to 0
+        //! and the maximum to 1
+        template <typename Sy=S, std::enable_if_t<!std::is_integral<std::decay_t<Sy>>::value, int> = 0 >
+        void rescale_par() noexcept
+        {
+            morph::range<S> r { this->min_par(), this->max_par() };
+            S m = r.max - r.min;
+            S g = r.min;
+#pragma omp parallel for
+            for (std::size_t i = 0; i < this->size(); ++i) { (*this)[i] = ((*this)[i] - g) / m; }
+        }
+
+        //! Parallel (OpenMP) version of convolve(): the outer loop over the data is spread across
+        //! cores; each output element is computed exactly as in convolve().
+        vvec<S> convolve_par (const vvec<S>& kernel, const wrapdata wrap = wrapdata::none) const
+        {
+            const int _n = this->size();
+            vvec<S> rtn(_n);
+            const int kw = kernel.size(); // kernel width
+            const int khw = kw/2;  // kernel half width
+            const int khwr = kw%2; // kernel half width remainder
+            const int zki = khwr ? khw : khw-1; // zero of the kernel index
+#pragma omp parallel for
+            for (int i = 0; i < _n; ++i) {
+                // For each element, i, compute the convolution sum
+                S sum = S{0};
+                for (int j = 0; j<kw; ++j) {
+                    // ii is the index into the data by which kernel[j] should be multiplied
+                    int ii = i+j-zki;
+                    // Handle wrapping around the data with these two ternaries
+                    ii += ii < 0 && wrap==wrapdata::wrap ? _n : 0;
+                    ii -= ii >= _n && wrap==wrapdata::wrap ? _n : 0;
+                    if (ii < 0 || ii >= _n) { continue; }
+                    sum += (*this)[ii] * kernel[j];
+                }
+                rtn[i] = sum;
+            }
+            return rtn;
+        }
+
+        //! Parallel (OpenMP) version of smooth_gauss(): Gaussian smoothing via convolve_par()
+        vvec<S> smooth_gauss_par (const S sigma, const unsigned int n_sigma, const wrapdata wrap = wrapdata::none) const
+        {
+            morph::vvec<S> filter;
+            S hw = std::round(sigma*n_sigma);
+            std::size_t elements = static_cast<std::size_t>(2*hw) + 1;
+            filter.linspace (-hw, hw, elements);
+            filter.gauss_inplace (sigma);
+            filter /= filter.sum();
+            return this->convolve_par (filter, wrap);
+        }
+
         /*!
          * Compute the element-wise pth power of the vector
          *
@@ -1310,17 +1544,35 @@ namespace morph {
         /*!
          * Compute the element-wise natural logarithm of the vector
          *
+         * The template argument selects the precision policy: the default goes to
+         * std::log per element; morph::mathprec::fast uses the vectorized polynomial
+         * kernel in morph/fastmath.h (float/double only - other types always get
+         * std::log). See fastmath.h for the fast kernels' accuracy and domain.
+         *
          * \return a vvec whose elements have been logged
          */
+        template <morph::mathprec prec = morph::mathprec::exact>
         vvec<S> log() const
         {
             vvec<S> rtn(this->size());
-            auto log_element = [](S elmnt) { return std::log(elmnt); };
-            std::transform (this->begin(), this->end(), rtn.begin(), log_element);
+            if constexpr (prec == morph::mathprec::fast && (std::is_same_v<S, float> || std::is_same_v<S, double>)) {
+                morph::fastmath::log (this->data(), rtn.data(), this->size());
+            } else {
+                auto log_element = [](S elmnt) { return std::log(elmnt); };
+                std::transform (this->begin(), this->end(), rtn.begin(), log_element);
+            }
             return rtn;
         }
         //! Replace each element with its own log
-        void log_inplace() { for (auto& i : *this) { i = std::log(i); } }
+        template <morph::mathprec prec = morph::mathprec::exact>
+        void log_inplace()
+        {
+            if constexpr (prec == morph::mathprec::fast && (std::is_same_v<S, float> || std::is_same_v<S, double>)) {
+                morph::fastmath::log (this->data(), this->data(), this->size());
+            } else {
+                for (auto& i : *this) { i = std::log(i); }
+            }
+        }
 
         /*!
          * Compute the element-wise logarithm-to-base-10 of the vector
@@ -1337,16 +1589,29 @@ namespace morph {
         //! Replace each element with its own log
         void log10_inplace() { for (auto& i : *this) { i = std::log10(i); } }
 
-        //! Sine
+        //! Sine. The template argument selects the precision policy, as for log()
+        template <morph::mathprec prec = morph::mathprec::exact>
         vvec<S> sin() const
         {
             vvec<S> rtn(this->size());
-            auto sin_element = [](S elmnt) { return std::sin(elmnt); };
-            std::transform (this->begin(), this->end(), rtn.begin(), sin_element);
+            if constexpr (prec == morph::mathprec::fast && (std::is_same_v<S, float> || std::is_same_v<S, double>)) {
+                morph::fastmath::sin (this->data(), rtn.data(), this->size());
+            } else {
+                auto sin_element = [](S elmnt) { return std::sin(elmnt); };
+                std::transform (this->begin(), this->end(), rtn.begin(), sin_element);
+            }
             return rtn;
         }
         //! Replace each element with its own sine
-        void sin_inplace() { for (auto& i : *this) { i = std::sin(i); } }
+        template <morph::mathprec prec = morph::mathprec::exact>
+        void sin_inplace()
+        {
+            if constexpr (prec == morph::mathprec::fast && (std::is_same_v<S, float> || std::is_same_v<S, double>)) {
+                morph::fastmath::sin (this->data(), this->data(), this->size());
+            } else {
+                for (auto& i : *this) { i = std::sin(i); }
+            }
+        }
 
         //! Cosine
         vvec<S> cos() const
@@ -1362,17 +1627,57 @@ namespace morph {
         /*!
          * Compute the element-wise natural exponential of the vector
          *
+         * The template argument selects the precision policy, as for log()
+         *
          * \return a vvec whose elements have been exponentiate
          */
+        template <morph::mathprec prec = morph::mathprec::exact>
         vvec<S> exp() const
         {
             vvec<S> rtn(this->size());
-            auto exp_element = [](S elmnt) { return std::exp(elmnt); };
-            std::transform (this->begin(), this->end(), rtn.begin(), exp_element);
+            if constexpr (prec == morph::mathprec::fast && (std::is_same_v<S, float> || std::is_same_v<S, double>)) {
+                morph::fastmath::exp (this->data(), rtn.data(), this->size());
+            } else {
+                auto exp_element = [](S elmnt) { return std::exp(elmnt); };
+                std::transform (this->begin(), this->end(), rtn.begin(), exp_element);
+            }
             return rtn;
         }
         //! Replace each element with its own exp
-        void exp_inplace() { for (auto& i : *this) { i = std::exp(i); } }
+        template <morph::mathprec prec = morph::mathprec::exact>
+        void exp_inplace()
+        {
+            if constexpr (prec == morph::mathprec::fast && (std::is_same_v<S, float> || std::is_same_v<S, double>)) {
+                morph::fastmath::exp (this->data(), this->data(), this->size());
+            } else {
+                for (auto& i : *this) { i = std::exp(i); }
+            }
+        }
+
+        //! Hyperbolic tangent. The template argument selects the precision policy, as
+        //! for log()
+        template <morph::mathprec prec = morph::mathprec::exact>
+        vvec<S> tanh() const
+        {
+            vvec<S> rtn(this->size());
+            if constexpr (prec == morph::mathprec::fast && (std::is_same_v<S, float> || std::is_same_v<S, double>)) {
+                morph::fastmath::tanh (this->data(), rtn.data(), this->size());
+            } else {
+                auto tanh_element = [](S elmnt) { return std::tanh(elmnt); };
+                std::transform (this->begin(), this->end(), rtn.begin(), tanh_element);
+            }
+            return rtn;
+        }
+        //! Replace each element with its own tanh
+        template <morph::mathprec prec = morph::mathprec::exact>
+        void tanh_inplace()
+        {
+            if constexpr (prec == morph::mathprec::fast && (std::is_same_v<S, float> || std::is_same_v<S, double>)) {
+                morph::fastmath::tanh (this->data(), this->data(), this->size());
+            } else {
+                for (auto& i : *this) { i = std::tanh(i); }
+            }
+        }
 
         /*!
          * Compute the element-wise absolute values of the vector
@@ -1791,16 +2096,20 @@ namespace morph {
          *
          * \return scalar product
          */
-        template<typename Sy=S>
-        S dot (const vvec<Sy>& v) const
+        template<typename Sy=S, typename AlY=std::allocator<Sy>>
+        S dot (const vvec<Sy, AlY>& v) const
         {
             if (this->size() != v.size()) {
                 throw std::runtime_error ("vvec::dot(): vectors must have equal size");
             }
-            auto vi = v.begin();
-            auto dot_product = [vi](S a, Sy b) mutable -> S { return a + static_cast<S>(b) * static_cast<S>(*vi++); };
-            const S rtn = std::accumulate (this->begin(), this->end(), S{0}, dot_product);
-            return rtn;
+            if constexpr (morph::simd::simdable<S> && std::is_same<std::decay_t<Sy>, S>::value) {
+                return morph::simd::dot (this->data(), v.data(), this->size());
+            } else {
+                auto vi = v.begin();
+                auto dot_product = [vi](S a, Sy b) mutable -> S { return a + static_cast<S>(b) * static_cast<S>(*vi++); };
+                const S rtn = std::accumulate (this->begin(), this->end(), S{0}, dot_product);
+                return rtn;
+            }
         }
 
         /*!
@@ -1810,8 +2119,8 @@ namespace morph {
          * higher dimensions, its more complicated to define what the cross product is,
          * and I'm unlikely to need anything other than the plain old 3D cross product.
          */
-        template<typename Sy=S>
-        vvec<S, Al> cross (const vvec<Sy>& v) const
+        template<typename Sy=S, typename AlY=std::allocator<Sy>>
+        vvec<S, Al> cross (const vvec<Sy, AlY>& v) const
         {
             vvec<S, Al> vrtn;
             if (this->size() == 3 && v.size() == 3) {
@@ -1835,8 +2144,12 @@ namespace morph {
         vvec<S> operator* (const Sy& s) const
         {
             vvec<S> rtn(this->size());
-            auto mult_by_s = [s](S elmnt) -> S { return elmnt * s; };
-            std::transform (this->begin(), this->end(), rtn.begin(), mult_by_s);
+            if constexpr (morph::simd::simdable<S> && std::is_same<std::decay_t<Sy>, S>::value) {
+                morph::simd::multiply (this->data(), s, rtn.data(), this->size());
+            } else {
+                auto mult_by_s = [s](S elmnt) -> S { return elmnt * s; };
+                std::transform (this->begin(), this->end(), rtn.begin(), mult_by_s);
+            }
             return rtn;
         }
 
@@ -1848,17 +2161,21 @@ namespace morph {
          *
          * \return Hadamard product of left hand size (*this) and right hand size (\a v)
          */
-        template<typename Sy=S>
-        vvec<S, Al> operator* (const vvec<Sy>& v) const
+        template<typename Sy=S, typename AlY=std::allocator<Sy>>
+        vvec<S, Al> operator* (const vvec<Sy, AlY>& v) const
         {
             if (v.size() != this->size()) {
                 throw std::runtime_error ("vvec::operator*: Hadamard product is defined here for vectors of same dimensionality only");
             }
             vvec<S, Al> rtn(this->size(), S{0});
-            auto vi = v.begin();
-            // Visual Studio may complain about there being no static_cast<S> of (*vi++), here
-            auto mult_by_s = [vi](S lhs) mutable -> S { return lhs * (*vi++); };
-            std::transform (this->begin(), this->end(), rtn.begin(), mult_by_s);
+            if constexpr (morph::simd::simdable<S> && std::is_same<std::decay_t<Sy>, S>::value) {
+                morph::simd::multiply (this->data(), v.data(), rtn.data(), this->size());
+            } else {
+                auto vi = v.begin();
+                // Visual Studio may complain about there being no static_cast<S> of (*vi++), here
+                auto mult_by_s = [vi](S lhs) mutable -> S { return lhs * (*vi++); };
+                std::transform (this->begin(), this->end(), rtn.begin(), mult_by_s);
+            }
             return rtn;
         }
 
@@ -1871,8 +2188,12 @@ namespace morph {
         template <typename Sy=S, std::enable_if_t<std::is_scalar<std::decay_t<Sy>>::value || morph::is_copyable_fixedsize<std::decay_t<Sy>>::value, int> = 0 >
         void operator*= (const Sy& s) noexcept
         {
-            auto mult_by_s = [s](S elmnt) -> S { return elmnt * s; };
-            std::transform (this->begin(), this->end(), this->begin(), mult_by_s);
+            if constexpr (morph::simd::simdable<S> && std::is_same<std::decay_t<Sy>, S>::value) {
+                morph::simd::multiply (this->data(), s, this->data(), this->size());
+            } else {
+                auto mult_by_s = [s](S elmnt) -> S { return elmnt * s; };
+                std::transform (this->begin(), this->end(), this->begin(), mult_by_s);
+            }
         }
 
         /*!
@@ -1881,13 +2202,17 @@ namespace morph {
          * Hadamard product. Multiply *this vector with \a v, elementwise. If \a v has a
          * different number of elements to *this, then an exception is thrown.
          */
-        template <typename Sy=S>
-        void operator*= (const vvec<Sy>& v)
+        template <typename Sy=S, typename AlY=std::allocator<Sy>>
+        void operator*= (const vvec<Sy, AlY>& v)
         {
             if (v.size() == this->size()) {
-                auto vi = v.begin();
-                auto mult_by_s = [vi](S lhs) mutable -> S { return lhs * (*vi++); };
-                std::transform (this->begin(), this->end(), this->begin(), mult_by_s);
+                if constexpr (morph::simd::simdable<S> && std::is_same<std::decay_t<Sy>, S>::value) {
+                    morph::simd::multiply (this->data(), v.data(), this->data(), this->size());
+                } else {
+                    auto vi = v.begin();
+                    auto mult_by_s = [vi](S lhs) mutable -> S { return lhs * (*vi++); };
+                    std::transform (this->begin(), this->end(), this->begin(), mult_by_s);
+                }
             } else {
                 throw std::runtime_error ("vvec::operator*=: Hadamard product is defined here for vectors of same dimensionality only");
             }
@@ -1898,8 +2223,12 @@ namespace morph {
         vvec<S> operator/ (const Sy& s) const noexcept
         {
             vvec<S> rtn(this->size());
-            auto div_by_s = [s](S elmnt) -> S { return elmnt / s; };
-            std::transform (this->begin(), this->end(), rtn.begin(), div_by_s);
+            if constexpr (morph::simd::simdable<S> && std::is_same<std::decay_t<Sy>, S>::value) {
+                morph::simd::divide (this->data(), s, rtn.data(), this->size());
+            } else {
+                auto div_by_s = [s](S elmnt) -> S { return elmnt / s; };
+                std::transform (this->begin(), this->end(), rtn.begin(), div_by_s);
+            }
             return rtn;
         }
 
@@ -1911,16 +2240,20 @@ namespace morph {
          *
          * \return Hadamard division of left hand size (*this) by right hand size (\a v)
          */
-        template<typename Sy=S>
-        vvec<S, Al> operator/ (const vvec<Sy>& v) const
+        template<typename Sy=S, typename AlY=std::allocator<Sy>>
+        vvec<S, Al> operator/ (const vvec<Sy, AlY>& v) const
         {
             if (v.size() != this->size()) {
                 throw std::runtime_error ("vvec::operator/: Hadamard division is defined here for vectors of same dimensionality only");
             }
             vvec<S, Al> rtn(this->size(), S{0});
-            auto vi = v.begin();
-            auto div_by_s = [vi](S lhs) mutable -> S { return lhs / (*vi++); };
-            std::transform (this->begin(), this->end(), rtn.begin(), div_by_s);
+            if constexpr (morph::simd::simdable<S> && std::is_same<std::decay_t<Sy>, S>::value) {
+                morph::simd::divide (this->data(), v.data(), rtn.data(), this->size());
+            } else {
+                auto vi = v.begin();
+                auto div_by_s = [vi](S lhs) mutable -> S { return lhs / (*vi++); };
+                std::transform (this->begin(), this->end(), rtn.begin(), div_by_s);
+            }
             return rtn;
         }
 
@@ -1928,8 +2261,12 @@ namespace morph {
         template <typename Sy=S, std::enable_if_t<std::is_scalar<std::decay_t<Sy>>::value || morph::is_copyable_fixedsize<std::decay_t<Sy>>::value, int> = 0 >
         void operator/= (const Sy& s)
         {
-            auto div_by_s = [s](S elmnt) -> S { return elmnt / s; };
-            std::transform (this->begin(), this->end(), this->begin(), div_by_s);
+            if constexpr (morph::simd::simdable<S> && std::is_same<std::decay_t<Sy>, S>::value) {
+                morph::simd::divide (this->data(), s, this->data(), this->size());
+            } else {
+                auto div_by_s = [s](S elmnt) -> S { return elmnt / s; };
+                std::transform (this->begin(), this->end(), this->begin(), div_by_s);
+            }
         }
 
         /*!
@@ -1938,13 +2275,17 @@ namespace morph {
          * Hadamard division. Divide *this vector by \a v, elementwise. If \a v has a
          * different number of elements to *this, then an exception is thrown.
          */
-        template <typename Sy=S>
-        void operator/= (const vvec<Sy>& v)
+        template <typename Sy=S, typename AlY=std::allocator<Sy>>
+        void operator/= (const vvec<Sy, AlY>& v)
         {
             if (v.size() == this->size()) {
-                auto vi = v.begin();
-                auto div_by_s = [vi](S lhs) mutable -> S { return lhs / (*vi++); };
-                std::transform (this->begin(), this->end(), this->begin(), div_by_s);
+                if constexpr (morph::simd::simdable<S> && std::is_same<std::decay_t<Sy>, S>::value) {
+                    morph::simd::divide (this->data(), v.data(), this->data(), this->size());
+                } else {
+                    auto vi = v.begin();
+                    auto div_by_s = [vi](S lhs) mutable -> S { return lhs / (*vi++); };
+                    std::transform (this->begin(), this->end(), this->begin(), div_by_s);
+                }
             } else {
                 throw std::runtime_error ("vvec::operator/=: Hadamard division is defined here for vectors of same dimensionality only");
             }
@@ -1955,8 +2296,12 @@ namespace morph {
         vvec<S> operator+ (const Sy& s) const
         {
             vvec<S> rtn(this->size());
-            auto add_s = [s](S elmnt) -> S { return elmnt + s; };
-            std::transform (this->begin(), this->end(), rtn.begin(), add_s);
+            if constexpr (morph::simd::simdable<S> && std::is_same<std::decay_t<Sy>, S>::value) {
+                morph::simd::add (this->data(), s, rtn.data(), this->size());
+            } else {
+                auto add_s = [s](S elmnt) -> S { return elmnt + s; };
+                std::transform (this->begin(), this->end(), rtn.begin(), add_s);
+            }
             return rtn;
         }
 
@@ -1964,23 +2309,31 @@ namespace morph {
         vvec<S> operator+ (const S& s) const
         {
             vvec<S> rtn(this->size());
-            auto add_s = [s](S elmnt) -> S { return elmnt + s; };
-            std::transform (this->begin(), this->end(), rtn.begin(), add_s);
+            if constexpr (morph::simd::simdable<S>) {
+                morph::simd::add (this->data(), s, rtn.data(), this->size());
+            } else {
+                auto add_s = [s](S elmnt) -> S { return elmnt + s; };
+                std::transform (this->begin(), this->end(), rtn.begin(), add_s);
+            }
             return rtn;
         }
 
         //! vvec addition operator
-        template<typename Sy=S>
-        vvec<S> operator+ (const vvec<Sy>& v) const
+        template<typename Sy=S, typename AlY=std::allocator<Sy>>
+        vvec<S> operator+ (const vvec<Sy, AlY>& v) const
         {
             if (v.size() != this->size()) {
                 throw std::runtime_error ("vvec::operator+: adding vvecs of different dimensionality is suppressed");
             }
             vvec<S> vrtn(this->size());
-            auto vi = v.begin();
-            // Static cast is encouraged by Visual Studio, but it prevents addition of vvec of vecs and vvec of scalars
-            auto add_v = [vi](S a) mutable -> S { return a + /* static_cast<S> */(*vi++); };
-            std::transform (this->begin(), this->end(), vrtn.begin(), add_v);
+            if constexpr (morph::simd::simdable<S> && std::is_same<std::decay_t<Sy>, S>::value) {
+                morph::simd::add (this->data(), v.data(), vrtn.data(), this->size());
+            } else {
+                auto vi = v.begin();
+                // Static cast is encouraged by Visual Studio, but it prevents addition of vvec of vecs and vvec of scalars
+                auto add_v = [vi](S a) mutable -> S { return a + /* static_cast<S> */(*vi++); };
+                std::transform (this->begin(), this->end(), vrtn.begin(), add_v);
+            }
             return vrtn;
         }
 
@@ -1988,18 +2341,26 @@ namespace morph {
         template <typename Sy=S, std::enable_if_t<std::is_scalar<std::decay_t<Sy>>::value || morph::is_copyable_fixedsize<std::decay_t<Sy>>::value, int> = 0 >
         void operator+= (const Sy& s) noexcept
         {
-            auto add_s = [s](S elmnt) -> S { return elmnt + s; };
-            std::transform (this->begin(), this->end(), this->begin(), add_s);
+            if constexpr (morph::simd::simdable<S> && std::is_same<std::decay_t<Sy>, S>::value) {
+                morph::simd::add (this->data(), s, this->data(), this->size());
+            } else {
+                auto add_s = [s](S elmnt) -> S { return elmnt + s; };
+                std::transform (this->begin(), this->end(), this->begin(), add_s);
+            }
         }
 
         //! vvec addition operator
-        template<typename Sy=S>
-        void operator+= (const vvec<Sy>& v)
+        template<typename Sy=S, typename AlY=std::allocator<Sy>>
+        void operator+= (const vvec<Sy, AlY>& v)
         {
             if (v.size() == this->size()) {
-                auto vi = v.begin();
-                auto add_v = [vi](S a) mutable -> S { return a + /* static_cast<S> */(*vi++); };
-                std::transform (this->begin(), this->end(), this->begin(), add_v);
+                if constexpr (morph::simd::simdable<S> && std::is_same<std::decay_t<Sy>, S>::value) {
+                    morph::simd::add (this->data(), v.data(), this->data(), this->size());
+                } else {
+                    auto vi = v.begin();
+                    auto add_v = [vi](S a) mutable -> S { return a + /* static_cast<S> */(*vi++); };
+                    std::transform (this->begin(), this->end(), this->begin(), add_v);
+                }
             } else {
                 throw std::runtime_error ("vvec::operator+=: adding vvecs of different dimensionality is suppressed");
             }
@@ -2017,8 +2378,12 @@ namespace morph {
         vvec<S> operator- (const Sy& s) const
         {
             vvec<S> rtn(this->size());
-            auto subtract_s = [s](S elmnt) -> S { return elmnt - s; };
-            std::transform (this->begin(), this->end(), rtn.begin(), subtract_s);
+            if constexpr (morph::simd::simdable<S> && std::is_same<std::decay_t<Sy>, S>::value) {
+                morph::simd::subtract (this->data(), s, rtn.data(), this->size());
+            } else {
+                auto subtract_s = [s](S elmnt) -> S { return elmnt - s; };
+                std::transform (this->begin(), this->end(), rtn.begin(), subtract_s);
+            }
             return rtn;
         }
 
@@ -2026,22 +2391,30 @@ namespace morph {
         vvec<S> operator- (const S& s) const
         {
             vvec<S> rtn(this->size());
-            auto subtract_s = [s](S elmnt) -> S { return elmnt - s; };
-            std::transform (this->begin(), this->end(), rtn.begin(), subtract_s);
+            if constexpr (morph::simd::simdable<S>) {
+                morph::simd::subtract (this->data(), s, rtn.data(), this->size());
+            } else {
+                auto subtract_s = [s](S elmnt) -> S { return elmnt - s; };
+                std::transform (this->begin(), this->end(), rtn.begin(), subtract_s);
+            }
             return rtn;
         }
 
         //! A vvec subtraction operator
-        template<typename Sy=S>
-        vvec<S> operator- (const vvec<Sy>& v) const
+        template<typename Sy=S, typename AlY=std::allocator<Sy>>
+        vvec<S> operator- (const vvec<Sy, AlY>& v) const
         {
             if (v.size() != this->size()) {
                 throw std::runtime_error ("vvec::operator-: subtracting vvecs of different dimensionality is suppressed");
             }
             vvec<S> vrtn(this->size());
-            auto vi = v.begin();
-            auto subtract_v = [vi](S a) mutable -> S { return a - (*vi++); };
-            std::transform (this->begin(), this->end(), vrtn.begin(), subtract_v);
+            if constexpr (morph::simd::simdable<S> && std::is_same<std::decay_t<Sy>, S>::value) {
+                morph::simd::subtract (this->data(), v.data(), vrtn.data(), this->size());
+            } else {
+                auto vi = v.begin();
+                auto subtract_v = [vi](S a) mutable -> S { return a - (*vi++); };
+                std::transform (this->begin(), this->end(), vrtn.begin(), subtract_v);
+            }
             return vrtn;
         }
 
@@ -2049,18 +2422,26 @@ namespace morph {
         template <typename Sy=S, std::enable_if_t<std::is_scalar<std::decay_t<Sy>>::value || morph::is_copyable_fixedsize<std::decay_t<Sy>>::value, int> = 0 >
         void operator-= (const Sy& s) noexcept
         {
-            auto subtract_s = [s](S elmnt) -> S { return elmnt - s; };
-            std::transform (this->begin(), this->end(), this->begin(), subtract_s);
+            if constexpr (morph::simd::simdable<S> && std::is_same<std::decay_t<Sy>, S>::value) {
+                morph::simd::subtract (this->data(), s, this->data(), this->size());
+            } else {
+                auto subtract_s = [s](S elmnt) -> S { return elmnt - s; };
+                std::transform (this->begin(), this->end(), this->begin(), subtract_s);
+            }
         }
 
         //! A vvec subtraction operator
-        template<typename Sy=S>
-        void operator-= (const vvec<Sy>& v)
+        template<typename Sy=S, typename AlY=std::allocator<Sy>>
+        void operator-= (const vvec<Sy, AlY>& v)
         {
             if (v.size() == this->size()) {
-                auto vi = v.begin();
-                auto subtract_v = [vi](S a) mutable -> S { return a - (*vi++); };
-                std::transform (this->begin(), this->end(), this->begin(), subtract_v);
+                if constexpr (morph::simd::simdable<S> && std::is_same<std::decay_t<Sy>, S>::value) {
+                    morph::simd::subtract (this->data(), v.data(), this->data(), this->size());
+                } else {
+                    auto vi = v.begin();
+                    auto subtract_v = [vi](S a) mutable -> S { return a - (*vi++); };
+                    std::transform (this->begin(), this->end(), this->begin(), subtract_v);
+                }
             } else {
                 throw std::runtime_error ("vvec::operator-=: subtracting vvecs of different dimensionality is suppressed");
             }
@@ -2087,7 +2468,7 @@ namespace morph {
         friend std::ostream& operator<< <S> (std::ostream& os, const vvec<S>& v);
     };
 
-    template <typename S=float, typename Al=std::allocator<S>>
+    template <typename S=float, typename Al=morph::vvec_allocator<S>>
     std::ostream& operator<< (std::ostream& os, const vvec<S, Al>& v)
     {
         os << v.str();
@@ -2125,4 +2506,109 @@ namespace morph {
         return subtraction;
     }
 
+    /*!
+     * \brief A precomputed plan for repeated 1-D convolutions
+     *
+     * vvec::convolve() re-derives its wrapping/clipping logic for every element on every
+     * call. When the same kernel is applied to same-sized data over and over (smoothing a state
+     * vector on each step of a simulation, say) that work can be done once, up front. A conv_plan
+     * is built from the data size, the kernel and the wrapping mode. It precomputes the interior
+     * region - where the kernel never runs off the end of the data and a branch-free inner loop
+     * can be used - along with explicit (data index, kernel index) tables for the boundary
+     * elements, honouring vvec's wrapdata::wrap boundary handling. apply() then writes into a
+     * caller-provided result vvec and apply_inplace() convolves in place via an internal
+     * workspace, so neither performs any per-call heap allocation once buffers are warm.
+     *
+     * The results are identical to vvec::convolve() with the same kernel and wrap mode.
+     */
+    template <typename S = float>
+    struct conv_plan
+    {
+        using wrapdata = typename vvec<S>::wrapdata;
+
+        conv_plan (const std::size_t data_n, const vvec<S>& _kernel, const wrapdata wrap = wrapdata::none)
+            : kernel(_kernel)
+            , n(static_cast<int>(data_n))
+        {
+            const int kw = this->kernel.size(); // kernel width
+            const int khw = kw/2;               // kernel half width
+            const int khwr = kw%2;              // kernel half width remainder
+            this->zki = khwr ? khw : khw-1;     // zero of the kernel index
+            // The interior is the range of output indices for which every data index i+j-zki
+            // falls within [0,n), so no wrapping or clipping tests are needed
+            this->interior_lo = std::min (this->zki, this->n);
+            this->interior_hi = std::max (std::min (this->n - (kw - 1 - this->zki), this->n), this->interior_lo);
+            // Tabulate (data index, kernel index) pairs for each boundary output element
+            this->b_begin.push_back (0);
+            for (int i = 0; i < this->n; ++i) {
+                if (i == this->interior_lo) { i = this->interior_hi; if (i >= this->n) { break; } }
+                this->b_out.push_back (i);
+                for (int j = 0; j < kw; ++j) {
+                    int ii = i+j-this->zki;
+                    ii += ii < 0 && wrap==wrapdata::wrap ? this->n : 0;
+                    ii -= ii >= this->n && wrap==wrapdata::wrap ? this->n : 0;
+                    if (ii < 0 || ii >= this->n) { continue; }
+                    this->b_src.push_back (ii);
+                    this->b_kidx.push_back (j);
+                }
+                this->b_begin.push_back (static_cast<int>(this->b_src.size()));
+            }
+        }
+
+        //! Apply the planned convolution to data, writing into result (which is resized if
+        //! necessary). data.size() must match the size the plan was built for.
+        void apply (const vvec<S>& data, vvec<S>& result) const
+        {
+            if (static_cast<int>(data.size()) != this->n) {
+                throw std::runtime_error ("conv_plan::apply: data size does not match the planned size");
+            }
+            if (static_cast<int>(result.size()) != this->n) { result.resize (this->n); }
+            const int kw = this->kernel.size();
+            // Interior: branch-free inner loop
+            for (int i = this->interior_lo; i < this->interior_hi; ++i) {
+                S sum = S{0};
+                for (int j = 0; j < kw; ++j) { sum += data[i+j-this->zki] * this->kernel[j]; }
+                result[i] = sum;
+            }
+            // Boundary: tabulated (data index, kernel index) pairs
+            for (std::size_t b = 0; b < this->b_out.size(); ++b) {
+                S sum = S{0};
+                for (int p = this->b_begin[b]; p < this->b_begin[b+1]; ++p) {
+                    sum += data[this->b_src[p]] * this->kernel[this->b_kidx[p]];
+                }
+                result[this->b_out[b]] = sum;
+            }
+        }
+
+        //! Apply the planned convolution to data in place, using the plan's workspace to hold the
+        //! unconvolved copy of the data
+        void apply_inplace (vvec<S>& data)
+        {
+            this->workspace.resize (data.size());
+            this->apply (data, this->workspace);
+            data.swap (this->workspace);
+        }
+
+    private:
+        //! A copy of the kernel the plan was built with
+        vvec<S> kernel;
+        //! The data size the plan was built for
+        int n = 0;
+        //! The index of the kernel's zero/centre element
+        int zki = 0;
+        //! Output indices [interior_lo, interior_hi) need no boundary handling
+        int interior_lo = 0;
+        int interior_hi = 0;
+        //! Output index of each boundary element
+        std::vector<int> b_out;
+        //! For boundary element b, pairs [b_begin[b], b_begin[b+1]) of b_src/b_kidx apply
+        std::vector<int> b_begin;
+        //! Tabulated data indices for the boundary elements (wrapping already applied)
+        std::vector<int> b_src;
+        //! Tabulated kernel indices for the boundary elements
+        std::vector<int> b_kidx;
+        //! Workspace for apply_inplace()
+        vvec<S> workspace;
+    };
+
 } // namespace morph
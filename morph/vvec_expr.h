@@ -0,0 +1,206 @@
+/*!
+ * \file
+ *
+ * \brief An expression-template layer for morph::vvec arithmetic
+ *
+ * Chained vvec arithmetic such as
+ *
+ *\code{.cpp}
+ * morph::vvec<float> r = a * k + b.pow(2) - c;
+ *\endcode
+ *
+ * allocates a fresh vector for every intermediate operator result. For code which evaluates such
+ * expressions millions of times (reaction-diffusion loops and the like) the allocation churn and
+ * the repeated passes over memory dominate. This header provides an opt-in, lazy alternative:
+ * wrap the operands with morph::lazy() and the whole expression fuses into a single loop when it
+ * is evaluated:
+ *
+ *\code{.cpp}
+ * morph::vvec<float> r (a.size());
+ * (morph::lazy(a) * k + morph::lazy(b).pow(2.0f) - morph::lazy(c)).eval_into (r);
+ *\endcode
+ *
+ * No intermediate vvecs are created; eval_into() performs zero heap allocations if the target is
+ * already the right size. The expression objects hold const references to the wrapped vvecs, so
+ * the vvecs must outlive the expression (which they trivially do in the usual
+ * build-and-evaluate-on-one-line usage).
+ *
+ * \author Seb James
+ * \date February 2025
+ */
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <morph/vvec.h>
+
+namespace morph {
+
+    namespace expr {
+
+        /*!
+         * CRTP base class for vvec expression nodes. Derived classes implement operator[] and
+         * size(). The base provides evaluation into a vvec and the lazy element-wise member
+         * functions (pow, sqrt, abs, exp, log).
+         */
+        template <typename D>
+        struct expression
+        {
+            const D& derived() const noexcept { return static_cast<const D&>(*this); }
+
+            //! Evaluate the expression into a freshly allocated vvec in a single fused loop
+            auto eval() const
+            {
+                using T = typename D::value_type;
+                morph::vvec<T> rtn (this->derived().size());
+                for (std::size_t i = 0; i < rtn.size(); ++i) { rtn[i] = this->derived()[i]; }
+                return rtn;
+            }
+
+            //! Evaluate the expression into the client-provided target, resizing it only if
+            //! necessary. With a correctly sized target this performs no heap allocations.
+            template <typename S, typename Al>
+            void eval_into (morph::vvec<S, Al>& target) const
+            {
+                if (target.size() != this->derived().size()) { target.resize (this->derived().size()); }
+                for (std::size_t i = 0; i < target.size(); ++i) { target[i] = static_cast<S>(this->derived()[i]); }
+            }
+
+            // Lazy element-wise functions, mirroring the eager vvec member functions
+            template <typename T> auto pow (const T p) const;
+            auto sqrt() const;
+            auto abs() const;
+            auto exp() const;
+            auto log() const;
+        };
+
+        //! Leaf node: a const reference to a vvec
+        template <typename S, typename Al>
+        struct vv_ref : public expression<vv_ref<S, Al>>
+        {
+            using value_type = S;
+            explicit vv_ref (const morph::vvec<S, Al>& _v) noexcept : v(_v) {}
+            const morph::vvec<S, Al>& v;
+            S operator[] (const std::size_t i) const { return this->v[i]; }
+            std::size_t size() const noexcept { return this->v.size(); }
+        };
+
+        //! Binary node combining two sub-expressions element-wise with Op
+        template <typename L, typename R, typename Op>
+        struct binop : public expression<binop<L, R, Op>>
+        {
+            using value_type = decltype (Op{} (std::declval<typename L::value_type>(), std::declval<typename R::value_type>()));
+            binop (const L& _l, const R& _r) : l(_l), r(_r) {}
+            L l;
+            R r;
+            value_type operator[] (const std::size_t i) const { return Op{} (this->l[i], this->r[i]); }
+            std::size_t size() const noexcept { return this->l.size(); }
+        };
+
+        //! Binary node combining a sub-expression with a scalar. If flipped is true, the scalar is
+        //! the left hand operand (for expressions like k - a).
+        template <typename E, typename T, typename Op, bool flipped = false>
+        struct sbinop : public expression<sbinop<E, T, Op, flipped>>
+        {
+            using value_type = decltype (Op{} (std::declval<typename E::value_type>(), std::declval<T>()));
+            sbinop (const E& _e, const T _s) : e(_e), s(_s) {}
+            E e;
+            T s;
+            value_type operator[] (const std::size_t i) const
+            {
+                if constexpr (flipped) { return Op{} (this->s, this->e[i]); } else { return Op{} (this->e[i], this->s); }
+            }
+            std::size_t size() const noexcept { return this->e.size(); }
+        };
+
+        //! Unary node applying the callable Op to each element of a sub-expression
+        template <typename E, typename Op>
+        struct unop : public expression<unop<E, Op>>
+        {
+            using value_type = typename E::value_type;
+            unop (const E& _e, Op _op) : e(_e), op(_op) {}
+            E e;
+            Op op;
+            value_type operator[] (const std::size_t i) const { return this->op (this->e[i]); }
+            std::size_t size() const noexcept { return this->e.size(); }
+        };
+
+        // Expression (+,-,*,/) expression
+        template <typename L, typename R>
+        auto operator+ (const expression<L>& l, const expression<R>& r) { return binop<L, R, std::plus<>> (l.derived(), r.derived()); }
+        template <typename L, typename R>
+        auto operator- (const expression<L>& l, const expression<R>& r) { return binop<L, R, std::minus<>> (l.derived(), r.derived()); }
+        template <typename L, typename R>
+        auto operator* (const expression<L>& l, const expression<R>& r) { return binop<L, R, std::multiplies<>> (l.derived(), r.derived()); }
+        template <typename L, typename R>
+        auto operator/ (const expression<L>& l, const expression<R>& r) { return binop<L, R, std::divides<>> (l.derived(), r.derived()); }
+
+        // Expression (+,-,*,/) scalar and scalar (+,-,*,/) expression
+        template <typename E, typename T> requires std::is_arithmetic_v<T>
+        auto operator+ (const expression<E>& e, const T s) { return sbinop<E, T, std::plus<>> (e.derived(), s); }
+        template <typename E, typename T> requires std::is_arithmetic_v<T>
+        auto operator+ (const T s, const expression<E>& e) { return sbinop<E, T, std::plus<>, true> (e.derived(), s); }
+        template <typename E, typename T> requires std::is_arithmetic_v<T>
+        auto operator- (const expression<E>& e, const T s) { return sbinop<E, T, std::minus<>> (e.derived(), s); }
+        template <typename E, typename T> requires std::is_arithmetic_v<T>
+        auto operator- (const T s, const expression<E>& e) { return sbinop<E, T, std::minus<>, true> (e.derived(), s); }
+        template <typename E, typename T> requires std::is_arithmetic_v<T>
+        auto operator* (const expression<E>& e, const T s) { return sbinop<E, T, std::multiplies<>> (e.derived(), s); }
+        template <typename E, typename T> requires std::is_arithmetic_v<T>
+        auto operator* (const T s, const expression<E>& e) { return sbinop<E, T, std::multiplies<>, true> (e.derived(), s); }
+        template <typename E, typename T> requires std::is_arithmetic_v<T>
+        auto operator/ (const expression<E>& e, const T s) { return sbinop<E, T, std::divides<>> (e.derived(), s); }
+        template <typename E, typename T> requires std::is_arithmetic_v<T>
+        auto operator/ (const T s, const expression<E>& e) { return sbinop<E, T, std::divides<>, true> (e.derived(), s); }
+
+        //! Unary negation of an expression
+        template <typename E>
+        auto operator- (const expression<E>& e)
+        {
+            auto neg = [](typename E::value_type a) { return -a; };
+            return unop<E, decltype(neg)> (e.derived(), neg);
+        }
+
+        // The lazy element-wise member functions. Defined outside the class as they return unop
+        // objects whose type depends on a local lambda.
+        template <typename D> template <typename T>
+        auto expression<D>::pow (const T p) const
+        {
+            auto op = [p](typename D::value_type a) { return static_cast<typename D::value_type>(std::pow (a, p)); };
+            return unop<D, decltype(op)> (this->derived(), op);
+        }
+        template <typename D>
+        auto expression<D>::sqrt() const
+        {
+            auto op = [](typename D::value_type a) { return static_cast<typename D::value_type>(std::sqrt (a)); };
+            return unop<D, decltype(op)> (this->derived(), op);
+        }
+        template <typename D>
+        auto expression<D>::abs() const
+        {
+            auto op = [](typename D::value_type a) { return std::abs (a); };
+            return unop<D, decltype(op)> (this->derived(), op);
+        }
+        template <typename D>
+        auto expression<D>::exp() const
+        {
+            auto op = [](typename D::value_type a) { return static_cast<typename D::value_type>(std::exp (a)); };
+            return unop<D, decltype(op)> (this->derived(), op);
+        }
+        template <typename D>
+        auto expression<D>::log() const
+        {
+            auto op = [](typename D::value_type a) { return static_cast<typename D::value_type>(std::log (a)); };
+            return unop<D, decltype(op)> (this->derived(), op);
+        }
+
+    } // namespace expr
+
+    //! Wrap a vvec for use in a lazy, fused expression. See the file documentation in
+    //! morph/vvec_expr.h for usage.
+    template <typename S, typename Al>
+    expr::vv_ref<S, Al> lazy (const morph::vvec<S, Al>& v) noexcept { return expr::vv_ref<S, Al> (v); }
+
+} // namespace morph
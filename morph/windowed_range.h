@@ -0,0 +1,88 @@
+#pragma once
+
+/*
+ * A windowed range tracker. Where morph::range::update accumulates the min and max of
+ * everything it has ever seen, morph::windowed_range tracks the min and max of the most
+ * recent 'window' values pushed into it, in amortized O(1) time per push (the standard
+ * monotonic deque technique). Useful for auto-rescaling a graph of scrolling data,
+ * where re-scanning the window on every append would be O(window).
+ *
+ * This lives in its own header (rather than in morph/range.h) because it needs <deque>,
+ * and range.h is kept include-light for use in morph::vec/morph::vvec.
+ *
+ * Author: Seb James
+ * Date: 2025.
+ */
+
+#include <deque>
+#include <utility>
+#include <cstdint>
+#include <morph/range.h>
+
+namespace morph {
+
+    template <typename T>
+    struct windowed_range
+    {
+        windowed_range() {}
+        //! Construct with a window size. 0 means unbounded - the tracker then behaves
+        //! like accumulating morph::range::update calls.
+        windowed_range (const uint64_t _window) : window(_window) {}
+
+        //! The number of most-recently pushed values over which min/max are reported. May
+        //! be changed at any time; a reduced window takes effect on the next push.
+        uint64_t window = 0;
+
+        //! Push the next value. Values older than the window no longer contribute to the
+        //! range. Amortized O(1): each value enters and leaves each deque at most once.
+        void push (const T& d)
+        {
+            while (!this->minq.empty() && !(this->minq.back().second < d)) { this->minq.pop_back(); }
+            this->minq.emplace_back (this->n, d);
+            while (!this->maxq.empty() && !(d < this->maxq.back().second)) { this->maxq.pop_back(); }
+            this->maxq.emplace_back (this->n, d);
+            ++this->n;
+            if (this->window > 0) {
+                // Valid indices are [n - window, n - 1]
+                while (this->minq.front().first + this->window < this->n) { this->minq.pop_front(); }
+                while (this->maxq.front().first + this->window < this->n) { this->maxq.pop_front(); }
+            }
+        }
+
+        //! The range of the values currently in the window. If nothing has been pushed,
+        //! return a range initialized for search (as if no data had been seen).
+        morph::range<T> range() const
+        {
+            if (this->minq.empty()) { return morph::range<T> (morph::range_init::for_search); }
+            return morph::range<T> (this->minq.front().second, this->maxq.front().second);
+        }
+
+        //! The minimum of the values currently in the window (undefined if empty() is true)
+        T min() const { return this->minq.front().second; }
+        //! The maximum of the values currently in the window (undefined if empty() is true)
+        T max() const { return this->maxq.front().second; }
+
+        //! Have any values been pushed?
+        bool empty() const { return this->minq.empty(); }
+
+        //! The total number of values pushed (not the number in the window)
+        uint64_t count() const { return this->n; }
+
+        //! Forget everything that has been pushed, keeping the window size
+        void reset()
+        {
+            this->minq.clear();
+            this->maxq.clear();
+            this->n = 0;
+        }
+
+    private:
+        //! Count of values pushed; used to expire (index, value) entries from the deques
+        uint64_t n = 0;
+        //! Monotonically non-decreasing values; the front is the window minimum
+        std::deque<std::pair<uint64_t, T>> minq;
+        //! Monotonically non-increasing values; the front is the window maximum
+        std::deque<std::pair<uint64_t, T>> maxq;
+    };
+
+} // namespace morph
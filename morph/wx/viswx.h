@@ -6,6 +6,7 @@
 #include <memory>
 #include <vector>
 #include <sstream>
+#include <algorithm>
 #include <wx/wx.h>
 
 #include <wx/glcanvas.h>
@@ -90,12 +91,62 @@ namespace morph {
                 return this->glInitialized;
             }
 
+            /*!
+             * Record that \a model_idx (an index into model_ptrs) has changed on screen -
+             * its data was rebound, its colours reinitialized, it was shown or hidden -
+             * and schedule a repaint. With v.render_on_demand set true, frames are then
+             * drawn only when something is damaged; with scissor_damage also true, only
+             * the damaged models' screen rectangles are rasterized.
+             */
+            void damage_model (int model_idx)
+            {
+                this->damaged_models.push_back (model_idx);
+                this->v.signal_needs_render();
+                Refresh (false);
+            }
+
+            //! Declare whole-window damage (changed background, lighting, many models...)
+            //! and schedule a repaint
+            void damage_all()
+            {
+                this->full_damage = true;
+                this->v.signal_needs_render();
+                Refresh (false);
+            }
+
+            /*!
+             * If true, a paint whose only cause is damage_model calls renders with a
+             * scissor rectangle around the union of the damaged models' screen bounds, so
+             * clear and rasterization touch only the changed pixels. The undamaged region
+             * shows the previous frame's pixels, so this needs a GL configuration that
+             * preserves the back buffer across SwapBuffers (common, but not guaranteed) -
+             * leave it false if you see stale or flickering regions. Repaints caused by
+             * anything else (camera interaction, resizes, new models) are always
+             * full-window.
+             */
+            bool scissor_damage = false;
+
             // Check if any of the VisualModels in the Visual need a reinit and then call Visual::render
             void OnPaint ([[maybe_unused]] wxPaintEvent &event)
             {
                 wxPaintDC dc(this);
                 if (!this->glInitialized) { return; }
+
+                // In render-on-demand mode, skip the repaint entirely (no GL work, no
+                // buffer swap) when nothing has been damaged or signalled
+                if (this->v.render_on_demand == true && this->v.render_required == false
+                    && this->newvisualmodels.empty() && this->needs_reinit == -1
+                    && this->damaged_models.empty() && this->full_damage == false) {
+                    return;
+                }
+
                 SetCurrent(*this->glContext.get());
+
+                // The scissored path applies only when the *only* changes since the last
+                // frame are damage_model calls and reinits; anything else that signalled
+                // a render (camera interaction, resize) needs the whole window
+                bool only_model_damage = (this->v.render_required == false) && (this->full_damage == false);
+
                 if (!this->newvisualmodels.empty()) {
                     // Now we iterate through newvisualmodels, finalize them and add them to morph::Visual
                     for (unsigned int i = 0; i < newvisualmodels.size(); ++i) {
@@ -103,11 +154,60 @@ namespace morph {
                         this->model_ptrs.push_back (this->v.addVisualModel (this->newvisualmodels[i]));
                     }
                     this->newvisualmodels.clear();
+                    only_model_damage = false;
                 }
+
+                // Accumulate the union of the damaged models' screen rectangles ({x, y,
+                // w, h}, origin bottom left). damage_known goes false if any bounds can't
+                // be determined, in which case the whole window is treated as damaged.
+                morph::vec<int, 4> damage = { 0, 0, 0, 0 };
+                bool damage_known = true;
+                auto grow_damage = [&damage] (const morph::vec<int, 4>& r)
+                {
+                    if (r[2] == 0 || r[3] == 0) { return; } // r is empty (model off screen)
+                    if (damage[2] == 0 || damage[3] == 0) { damage = r; return; }
+                    int x1 = std::max (damage[0] + damage[2], r[0] + r[2]);
+                    int y1 = std::max (damage[1] + damage[3], r[1] + r[3]);
+                    damage[0] = std::min (damage[0], r[0]);
+                    damage[1] = std::min (damage[1], r[1]);
+                    damage[2] = x1 - damage[0];
+                    damage[3] = y1 - damage[1];
+                };
+
                 if (this->needs_reinit > -1) {
+                    // The region the model occupied *before* the reinit is damaged too
+                    morph::vec<int, 4> r;
+                    if (this->v.modelScreenBounds (this->model_ptrs[this->needs_reinit], r)) { grow_damage (r); }
+                    else { damage_known = false; }
                     this->model_ptrs[this->needs_reinit]->reinit();
+                    this->damaged_models.push_back (this->needs_reinit);
                     this->needs_reinit = -1;
                 }
+                for (int mi : this->damaged_models) {
+                    morph::vec<int, 4> r;
+                    if (mi >= 0 && mi < static_cast<int>(this->model_ptrs.size())
+                        && this->v.modelScreenBounds (this->model_ptrs[mi], r)) {
+                        grow_damage (r);
+                    } else {
+                        damage_known = false;
+                    }
+                }
+                this->damaged_models.clear();
+                this->full_damage = false;
+
+                if (this->scissor_damage == true && only_model_damage == true && damage_known == true) {
+                    if (damage[2] > 0 && damage[3] > 0) {
+                        glEnable (GL_SCISSOR_TEST);
+                        glScissor (damage[0], damage[1], damage[2], damage[3]);
+                        this->v.signal_needs_render(); // damage implies a draw, even on-demand
+                        v.render();
+                        glDisable (GL_SCISSOR_TEST);
+                        SwapBuffers();
+                    } // else: all the damaged models are off screen; nothing to redraw
+                    return;
+                }
+
+                this->v.signal_needs_render(); // damage implies a draw, even on-demand
                 v.render();
                 SwapBuffers();
             }
@@ -214,6 +314,10 @@ namespace morph {
         private:
             std::unique_ptr<wxGLContext> glContext;
             bool glInitialized = false;
+            // Models marked changed by damage_model, awaiting the next OnPaint
+            std::vector<int> damaged_models;
+            // Whole-window damage has been declared (damage_all, or new models added)
+            bool full_damage = false;
         };
 
         // morph::wx::Frame is to be extended. Note that a default GL version of 4.1 is given here.
@@ -0,0 +1,79 @@
+/*
+ * Test QuantizedFeedForwardNet: quantize a float FeedForwardNet to int8 and check that
+ * the quantized forward pass tracks the float one closely, and that the weight memory
+ * is a quarter of the float net's.
+ *
+ * \author Seb James
+ * \date August 2026
+ */
+
+#include <morph/nn/FeedForwardNet.h>
+#include <morph/nn/QuantizedFeedForwardNet.h>
+#include <morph/vvec.h>
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+int main()
+{
+    int rtn = 0;
+
+    std::vector<unsigned int> layer_spec = {8, 12, 6, 3};
+    morph::nn::FeedForwardNet<float> ff (layer_spec);
+
+    // A calibration set of random inputs spanning [-1, 1]
+    std::vector<morph::vvec<float>> calib (32);
+    for (auto& ci : calib) {
+        ci.resize (layer_spec.front());
+        ci.randomize (-1.0f, 1.0f);
+    }
+
+    morph::nn::QuantizedFeedForwardNet<float> qff (ff, calib);
+
+    // Weight memory should be exactly one int8 per float weight
+    std::size_t float_weights = 0;
+    for (auto& c : ff.connections) { float_weights += c.ws[0].size(); }
+    if (qff.weightBytes() != float_weights) {
+        std::cout << "weightBytes " << qff.weightBytes() << " != weight count " << float_weights << std::endl;
+        --rtn;
+    }
+
+    // The quantized forward pass should track the float one closely. Per-layer int8
+    // quantization of weights and activations costs up to a percent or so on sigmoid
+    // outputs; check against a tolerance well above float error but well below the
+    // useful signal range.
+    float worst = 0.0f;
+    morph::vvec<float> dummy_out (layer_spec.back(), 0.0f);
+    for (unsigned int t = 0; t < 100; ++t) {
+        morph::vvec<float> in (layer_spec.front());
+        in.randomize (-1.0f, 1.0f);
+        ff.setInput (in, dummy_out);
+        ff.feedforward();
+        morph::vvec<float> qout = qff.feedforward (in);
+        const float err = (ff.neurons.back() - qout).abs().max();
+        worst = err > worst ? err : worst;
+        if (ff.neurons.back().argmax() != qout.argmax()) {
+            std::cout << "Quantized argmax disagrees with float at trial " << t << std::endl;
+            --rtn;
+        }
+    }
+    std::cout << "Worst quantized output error: " << worst << std::endl;
+    if (worst > 0.02f) {
+        std::cout << "Quantized output error too large" << std::endl;
+        --rtn;
+    }
+
+    // A mis-sized input must throw
+    bool threw = false;
+    try {
+        morph::vvec<float> bad (layer_spec.front() + 1, 0.0f);
+        qff.feedforward (bad);
+    } catch (const std::runtime_error&) { threw = true; }
+    if (!threw) {
+        std::cout << "Mis-sized input should throw" << std::endl;
+        --rtn;
+    }
+
+    std::cout << "rtn = " << rtn << std::endl;
+    return rtn;
+}
@@ -0,0 +1,89 @@
+/*
+ * Test the parallel BasinFinder against a simple serial enumeration of the basins of
+ * attraction (and against AllBasins) for random genomes.
+ */
+
+#include <morph/bn/Genome.h>
+#include <morph/bn/GeneNet.h>
+#include <morph/bn/Basins.h>
+#include <morph/bn/Random.h>
+#include <iostream>
+#include <algorithm>
+#include <map>
+
+using std::endl;
+using std::cout;
+
+const size_t n = 5;
+const size_t k = 5;
+// Globally initialise Random instance pointer - necessary for all progs using Genome
+template<> morph::bn::Random<n,k>* morph::bn::Random<n,k>::pInstance = 0;
+
+int main()
+{
+    using GN = morph::bn::GeneNet<n,k>;
+    int rtn = 0;
+
+    for (int trial = 0; trial < 20; ++trial) {
+        morph::bn::Genome<n,k> g;
+        g.randomize();
+
+        // Serial reference: walk each state's trajectory with a visited sequence
+        std::map<morph::bn::state_t, unsigned int> ref_counts; // attractor min state -> basin size
+        std::map<morph::bn::state_t, unsigned int> ref_lens;   // attractor min state -> attractor length
+        for (unsigned int s0 = 0; s0 < (1u<<n); ++s0) {
+            std::vector<morph::bn::state_t> seq;
+            std::set<morph::bn::state_t> seen;
+            morph::bn::state_t s = static_cast<morph::bn::state_t>(s0);
+            while (seen.count (s) == 0) {
+                seen.insert (s);
+                seq.push_back (s);
+                GN::develop (s, g);
+            }
+            // s is now the first repeated state, so the cycle runs from its first
+            // occurrence in seq to the end of seq
+            auto ci = std::find (seq.begin(), seq.end(), s);
+            morph::bn::state_t mn = *std::min_element (ci, seq.end());
+            ref_counts[mn]++;
+            ref_lens[mn] = static_cast<unsigned int>(seq.end() - ci);
+        }
+
+        // The parallel enumeration should find exactly the same basins
+        std::vector<morph::bn::BasinStats> stats = morph::bn::BasinFinder<n,k>::find (g, 4);
+        if (stats.size() != ref_counts.size()) {
+            cout << "Number of basins mismatch: " << stats.size() << " vs " << ref_counts.size() << endl;
+            --rtn;
+        }
+        unsigned int total = 0;
+        for (const morph::bn::BasinStats& bs : stats) {
+            total += bs.basin_size;
+            if (ref_counts.count (bs.attractor_min) == 0
+                || ref_counts[bs.attractor_min] != bs.basin_size
+                || ref_lens[bs.attractor_min] != bs.attractor_length) {
+                cout << "Stats mismatch for the attractor containing state "
+                     << GN::state_str (bs.attractor_min) << endl;
+                --rtn;
+            }
+        }
+        if (total != (1u<<n)) {
+            cout << "Basin sizes sum to " << total << " not 2^N" << endl;
+            --rtn;
+        }
+
+        // AllBasins (which builds the full state graph) should agree on the count
+        morph::bn::AllBasins<n,k> ab (g);
+        if (ab.getNumBasins() != stats.size()) {
+            cout << "AllBasins finds " << ab.getNumBasins() << " basins, BasinFinder "
+                 << stats.size() << endl;
+            --rtn;
+        }
+    }
+
+    cout << (rtn == 0 ? "Test success" : "Test failed") << endl;
+
+    // Not absolutely necessary, but this call cleans up singleton memory for valgrind
+    // memcheck.
+    morph::bn::Random<n,k>::i_deconstruct();
+
+    return rtn;
+}
@@ -0,0 +1,65 @@
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include "morph/colour.h"
+
+int main ()
+{
+    int rtn = 0;
+
+    // The exact transfer functions should be mutual inverses
+    for (int i = 0; i <= 100; ++i) {
+        float s = static_cast<float>(i) / 100.0f;
+        float back = morph::colour::linear_to_srgb (morph::colour::srgb_to_linear (s));
+        if (std::abs (back - s) > 1e-5f) {
+            std::cout << "srgb roundtrip fail at " << s << ": " << back << std::endl;
+            --rtn;
+        }
+    }
+
+    // The 256-entry table is exact for 8 bit inputs
+    for (int i = 0; i < 256; ++i) {
+        float lut = morph::colour::srgb_to_linear_lut (static_cast<uint8_t>(i));
+        float exact = morph::colour::srgb_to_linear (static_cast<float>(i) / 255.0f);
+        if (lut != exact) {
+            std::cout << "srgb_to_linear_lut fail at " << i << std::endl;
+            --rtn;
+        }
+    }
+
+    // The 1024-entry linear_to_srgb table should be within one 8 bit step of exact
+    for (int i = 0; i <= 1000; ++i) {
+        float l = static_cast<float>(i) / 1000.0f;
+        float err = std::abs (morph::colour::linear_to_srgb_lut (l) - morph::colour::linear_to_srgb (l));
+        if (err > 1.0f / 255.0f) {
+            std::cout << "linear_to_srgb_lut error " << err << " at " << l << std::endl;
+            --rtn;
+        }
+    }
+    // ...and clamp out-of-range inputs
+    if (morph::colour::linear_to_srgb_lut (-0.5f) != morph::colour::linear_to_srgb_lut (0.0f)) { --rtn; }
+    if (morph::colour::linear_to_srgb_lut (1.5f) != morph::colour::linear_to_srgb_lut (1.0f)) { --rtn; }
+
+    // Batch conversions match the element-wise LUT calls
+    uint8_t pix[4] = { 0, 64, 128, 255 };
+    float lin[4] = { 0.0f };
+    morph::colour::srgb_to_linear_array (pix, lin, 4);
+    for (int i = 0; i < 4; ++i) {
+        if (lin[i] != morph::colour::srgb_to_linear_lut (pix[i])) {
+            std::cout << "srgb_to_linear_array fail at " << i << std::endl;
+            --rtn;
+        }
+    }
+    float enc[4] = { 0.0f };
+    morph::colour::linear_to_srgb_array (lin, enc, 4);
+    for (int i = 0; i < 4; ++i) {
+        if (enc[i] != morph::colour::linear_to_srgb_lut (lin[i])) {
+            std::cout << "linear_to_srgb_array fail at " << i << std::endl;
+            --rtn;
+        }
+    }
+
+    std::cout << "rtn: " << rtn << std::endl;
+    return rtn;
+}
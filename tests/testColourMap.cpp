@@ -81,5 +81,34 @@ int main ()
     if (c != mid_jet) { --rtn; std::cout << "ulli fail\n"; }
     std::cout << "(unsigned long long int) Colour: " << c[0] << "," << c[1] << ","<< c[2] << std::endl;
 
+    // The look-up-table accelerated path should reproduce the directly computed colour
+    cmf.enableLut();
+    c = cmf.convert(0.5f);
+    std::cout << "(float, lut) Colour (0.5): " << c[0] << "," << c[1] << ","<< c[2] << std::endl;
+    if (c != mid_jet) { --rtn; std::cout << "lut fail\n"; }
+
+    // makeLut's endpoints should be the map's endpoint colours
+    std::vector<std::array<float, 3>> lut = cmf.makeLut (256);
+    if (lut.front() != cmf.convert(0.0f) || lut.back() != cmf.convert(1.0f)) {
+        --rtn; std::cout << "makeLut fail\n";
+    }
+
+    // ...and disableLut should restore the direct computation
+    cmf.disableLut();
+    c = cmf.convert(0.5f);
+    if (c != mid_jet) { --rtn; std::cout << "disableLut fail\n"; }
+
+    // convert_array should match per-element convert for a table-based map like Jet
+    std::vector<float> data_in = { 0.0f, 0.25f, 0.5f, 0.75f, 1.0f,
+                                   std::numeric_limits<float>::quiet_NaN() };
+    std::vector<float> rgb_out (3u * data_in.size(), 0.0f);
+    cmf.convert_array (data_in.data(), rgb_out.data(), data_in.size());
+    for (std::size_t i = 0; i < data_in.size(); ++i) {
+        c = cmf.convert (data_in[i]);
+        if (c[0] != rgb_out[3*i] || c[1] != rgb_out[3*i+1] || c[2] != rgb_out[3*i+2]) {
+            --rtn; std::cout << "convert_array fail at " << i << "\n";
+        }
+    }
+
     return rtn;
 }
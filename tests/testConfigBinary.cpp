@@ -0,0 +1,76 @@
+// Test morph::Config's binary (CBOR/MessagePack) format and lazy parsing
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "morph/Config.h"
+
+int main()
+{
+    int rtn = 0;
+
+    std::string jsonfile ("./testConfigBinary.json");
+
+    std::ofstream f;
+    f.open (jsonfile, std::ios::out | std::ios::trunc);
+    if (!f.is_open()) {
+        std::cerr << "Failed to open a file to write the config JSON into\n";
+        return -1;
+    }
+    f << "{\n"
+      << "\"testbool\" : true,\n"
+      << "\"testint\" : 27,\n"
+      << "\"testfloat\" : 7.63,\n"
+      << "\"testarray\" : [1.0, 2.0, 3.0]\n"
+      << "}\n";
+    f.close();
+
+    // Convert the text JSON into each binary format
+    morph::Config::convert (jsonfile, "./testConfigBinary.cbor");
+    morph::Config::convert (jsonfile, "./testConfigBinary.mpk");
+
+    // The binary copies should read back just like the original
+    for (const std::string& cfile : { std::string("./testConfigBinary.cbor"),
+                                      std::string("./testConfigBinary.mpk") }) {
+        morph::Config config(cfile);
+        if (!config.ready) {
+            std::cout << "Config not ready for " << cfile << "\n";
+            rtn -= 1;
+            continue;
+        }
+        const bool testbool = config.getBool ("testbool", false);
+        const int testint = config.getInt ("testint", 3);
+        const float testfloat = config.getFloat ("testfloat", 9.8f);
+        morph::vvec<float> testarray = config.getvvec<float> ("testarray");
+        if (testbool != true || testint != 27 || testfloat != 7.63f
+            || testarray.size() != 3 || testarray[2] != 3.0f) {
+            std::cout << "Bad values read from " << cfile << "\n";
+            rtn -= 1;
+        }
+    }
+
+    // Lazy parsing: nothing is parsed until the first getter is used
+    {
+        morph::Config config("./testConfigBinary.cbor", true);
+        if (!config.ready) { std::cout << "Lazy Config not ready\n"; rtn -= 1; }
+        if (config.getInt ("testint", 3) != 27) { std::cout << "Lazy getInt fail\n"; rtn -= 1; }
+        // Direct access to root after ensure_parsed() should see the parsed content
+        config.ensure_parsed();
+        if (!config.root.contains ("testfloat")) { std::cout << "Lazy root access fail\n"; rtn -= 1; }
+    }
+
+    // A config modified and written out as binary should round-trip
+    {
+        morph::Config config(jsonfile);
+        config.set ("extra", 12);
+        config.write ("./testConfigBinary2.cbor");
+        morph::Config config2("./testConfigBinary2.cbor");
+        if (config2.getInt ("extra", 0) != 12 || config2.getInt ("testint", 0) != 27) {
+            std::cout << "Binary write round-trip fail\n";
+            rtn -= 1;
+        }
+    }
+
+    std::cout << "Returning " << rtn << std::endl;
+    return rtn;
+}
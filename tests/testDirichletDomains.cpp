@@ -0,0 +1,108 @@
+//
+// Test ShapeAnalysis::dirichlet_domains - the parallel connected-component labelling of
+// an identity map over a HexGrid's d_ vectors - against a serial flood fill, and check
+// that dirichlet_vertices gives identical results with a pool-allocated vertex list.
+//
+
+#include <iostream>
+#include <vector>
+#include <list>
+#include <deque>
+#include <cmath>
+#include <morph/HexGrid.h>
+#include <morph/ShapeAnalysis.h>
+
+int main()
+{
+    int rtn = 0;
+
+    // A grid with an identity map of horizontal stripes. Stripes with the same ID are
+    // disconnected from one another, so there are more domains than IDs.
+    morph::HexGrid hg (0.05f, 2.0f, 0.0f);
+    hg.setBoundaryOnOuterEdge();
+    unsigned int nhex = hg.num();
+    std::cout << "Number of hexes in grid:" << nhex << std::endl;
+
+    std::vector<float> f (nhex, 0.0f);
+    for (unsigned int i = 0; i < nhex; ++i) {
+        int stripe = static_cast<int>(std::floor (hg.d_y[i] / 0.3f));
+        f[i] = (((stripe % 2) + 2) % 2 == 0) ? 0.25f : 0.75f;
+        // An interior blob, away from the grid boundary, so that dirichlet_vertices can
+        // walk at least one complete domain outline
+        if (hg.d_x[i]*hg.d_x[i] + hg.d_y[i]*hg.d_y[i] < 0.04f) { f[i] = 0.5f; }
+    }
+
+    unsigned int n_domains = 0;
+    std::vector<int> labels = morph::ShapeAnalysis<float>::dirichlet_domains (&hg, f, n_domains);
+    std::cout << "dirichlet_domains found " << n_domains << " domains" << std::endl;
+
+    // Serial reference: flood fill over the same d_ neighbour vectors
+    const std::vector<int>* nbrs[6] = {
+        &hg.d_ne, &hg.d_nne, &hg.d_nnw, &hg.d_nw, &hg.d_nsw, &hg.d_nse
+    };
+    std::vector<int> ref (nhex, -1);
+    int ref_n = 0;
+    for (unsigned int s = 0; s < nhex; ++s) {
+        if (ref[s] != -1) { continue; }
+        std::deque<unsigned int> q;
+        q.push_back (s);
+        ref[s] = ref_n;
+        while (!q.empty()) {
+            unsigned int i = q.front();
+            q.pop_front();
+            for (unsigned int ni = 0; ni < 6; ++ni) {
+                int nb = (*nbrs[ni])[i];
+                if (nb >= 0 && f[nb] == f[i] && ref[nb] == -1) {
+                    ref[nb] = ref_n;
+                    q.push_back (static_cast<unsigned int>(nb));
+                }
+            }
+        }
+        ++ref_n;
+    }
+    std::cout << "Serial flood fill found " << ref_n << " domains" << std::endl;
+
+    if (n_domains != static_cast<unsigned int>(ref_n)) { rtn -= 1; }
+    if (n_domains < 3) { rtn -= 1; } // the stripes should make several domains
+
+    // Both methods fill labels in hex index order, so the labellings should be identical
+    for (unsigned int i = 0; i < nhex; ++i) {
+        if (labels[i] != ref[i]) {
+            std::cout << "Label mismatch at hex " << i << ": "
+                      << labels[i] << " vs " << ref[i] << std::endl;
+            rtn -= 1;
+            break;
+        }
+    }
+
+    // dirichlet_vertices should give the same answer whether the working vertex list
+    // uses the default allocator or the pool allocator
+    std::list<morph::DirichVtx<float>> vertices;
+    std::list<morph::DirichDom<float>> domains =
+        morph::ShapeAnalysis<float>::dirichlet_vertices (&hg, f, vertices);
+
+    morph::ShapeAnalysis<float>::dirichvtx_list pool_vertices;
+    std::list<morph::DirichDom<float>> pool_domains =
+        morph::ShapeAnalysis<float>::dirichlet_vertices (&hg, f, pool_vertices);
+
+    std::cout << "dirichlet_vertices: " << vertices.size() << " vertices, "
+              << domains.size() << " domains (pooled: " << pool_vertices.size()
+              << " vertices, " << pool_domains.size() << " domains)" << std::endl;
+
+    if (vertices.size() != pool_vertices.size()) { rtn -= 1; }
+    if (domains.size() != pool_domains.size()) { rtn -= 1; }
+    auto di = domains.begin();
+    auto pdi = pool_domains.begin();
+    while (di != domains.end() && pdi != pool_domains.end()) {
+        if (di->f != pdi->f || di->vertices.size() != pdi->vertices.size()
+            || di->area != pdi->area) {
+            std::cout << "Domain mismatch between plain and pooled runs" << std::endl;
+            rtn -= 1;
+            break;
+        }
+        ++di; ++pdi;
+    }
+
+    std::cout << (rtn == 0 ? "Test success" : "Test failed") << std::endl;
+    return rtn;
+}
@@ -0,0 +1,84 @@
+/*
+ * Test morph::filter_plan: the separable, cached-kernel Gaussian smooth against a brute-force 2D
+ * convolution, and the summed-area-table box filter against a brute-force box mean. Both use
+ * clamp-to-edge boundary handling.
+ */
+
+#include <morph/MathAlgo.h>
+#include <morph/vvec.h>
+#include <morph/Random.h>
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+int main()
+{
+    int rtn = 0;
+
+    constexpr int w = 37;
+    constexpr int h = 23;
+    morph::vvec<double> img (w * h);
+    morph::RandUniform<double> rng (0.0, 1.0, 5000);
+    for (auto& p : img) { p = rng.get(); }
+
+    morph::filter_plan<double> plan (w, h);
+
+    // Gaussian smoothing vs brute force separable convolution with the same kernel
+    for (double sigma : { 0.8, 2.5 }) {
+        const morph::vvec<double>& kern = plan.gauss_kernel (sigma);
+        if (std::abs (kern.sum() - 1.0) > 1e-12) { std::cout << "kernel not normalized\n"; --rtn; }
+        // The cache should return the identical object on a second call
+        if (&plan.gauss_kernel (sigma) != &kern) { std::cout << "kernel not cached\n"; --rtn; }
+
+        morph::vvec<double> smoothed (w * h, 0.0);
+        plan.smooth_gauss (img, smoothed, sigma);
+
+        const int hw = (static_cast<int>(kern.size()) - 1) / 2;
+        double maxerr = 0.0;
+        for (int y = 0; y < h; ++y) {
+            for (int x = 0; x < w; ++x) {
+                double acc = 0.0;
+                for (int j = -hw; j <= hw; ++j) {
+                    for (int i = -hw; i <= hw; ++i) {
+                        int yi = std::clamp (y + j, 0, h - 1);
+                        int xi = std::clamp (x + i, 0, w - 1);
+                        acc += kern[j + hw] * kern[i + hw] * img[yi * w + xi];
+                    }
+                }
+                maxerr = std::max (maxerr, std::abs (acc - smoothed[y * w + x]));
+            }
+        }
+        if (maxerr > 1e-12) {
+            std::cout << "smooth_gauss error " << maxerr << " for sigma " << sigma << std::endl;
+            --rtn;
+        }
+    }
+
+    // In-place SAT box filter vs brute force clipped box mean
+    for (int boxside : { 3, 9 }) {
+        morph::vvec<double> boxed = img;
+        plan.boxfilter_sat (boxed, boxside);
+        const int hb = boxside / 2;
+        double maxerr = 0.0;
+        for (int y = 0; y < h; ++y) {
+            for (int x = 0; x < w; ++x) {
+                double acc = 0.0;
+                int n = 0;
+                for (int j = std::max (0, y - hb); j <= std::min (h - 1, y + hb); ++j) {
+                    for (int i = std::max (0, x - hb); i <= std::min (w - 1, x + hb); ++i) {
+                        acc += img[j * w + i];
+                        ++n;
+                    }
+                }
+                maxerr = std::max (maxerr, std::abs (acc / n - boxed[y * w + x]));
+            }
+        }
+        if (maxerr > 1e-12) {
+            std::cout << "boxfilter_sat error " << maxerr << " for boxside " << boxside << std::endl;
+            --rtn;
+        }
+    }
+
+    std::cout << (rtn == 0 ? "Test success" : "Test failed") << std::endl;
+    return rtn;
+}
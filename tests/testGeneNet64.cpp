@@ -0,0 +1,77 @@
+/*
+ * Test the bit-sliced, word-parallel GeneNet::develop64 against the one-state-at-a-time
+ * GeneNet::develop, for every state and a selection of random genomes.
+ */
+
+#include <morph/bn/Genome.h>
+#include <morph/bn/GeneNet.h>
+#include <morph/bn/Random.h>
+#include <iostream>
+
+using std::endl;
+using std::cout;
+
+const size_t n = 5;
+const size_t k = 5;
+// Globally initialise Random instance pointer - necessary for all progs using Genome
+template<> morph::bn::Random<n,k>* morph::bn::Random<n,k>::pInstance = 0;
+// The K=N-1 case exercises the masked input wiring
+template<> morph::bn::Random<n,k-1>* morph::bn::Random<n,k-1>::pInstance = 0;
+
+template <size_t N, size_t K>
+int compare_develops()
+{
+    using GN = morph::bn::GeneNet<N,K>;
+    int fails = 0;
+    for (int trial = 0; trial < 10; ++trial) {
+        morph::bn::Genome<N,K> g;
+        g.randomize();
+        // Work through all 2^N states, 64 lanes at a time (lanes wrap around)
+        for (unsigned int base = 0; base < (1u<<N); base += 64) {
+            std::array<morph::bn::state_t, 64> states;
+            for (unsigned int l = 0; l < 64; ++l) { states[l] = (base + l) % (1u<<N); }
+
+            // Check the pack/unpack round trip
+            std::array<typename GN::state64_t, N> planes = GN::pack64 (states);
+            if (GN::unpack64 (planes) != states) {
+                cout << "pack64/unpack64 round trip failed" << endl;
+                ++fails;
+            }
+
+            // One word-parallel development of all 64 lanes
+            GN::develop64 (planes, g);
+            std::array<morph::bn::state_t, 64> developed = GN::unpack64 (planes);
+
+            // ...should match 64 individual developments
+            for (unsigned int l = 0; l < 64; ++l) {
+                morph::bn::state_t s = states[l];
+                GN::develop (s, g);
+                if (s != developed[l]) {
+                    cout << "N=" << N << ", K=" << K << ": for state "
+                         << GN::state_str (states[l]) << "develop gives "
+                         << GN::state_str (s) << "but develop64 gives "
+                         << GN::state_str (developed[l]) << endl;
+                    ++fails;
+                }
+            }
+        }
+    }
+    return fails;
+}
+
+int main()
+{
+    cout << "N=" << n << ", K=" << k << endl;
+    int rtn = compare_develops<n, k>();
+    cout << "N=" << n << ", K=" << (k-1) << endl;
+    rtn += compare_develops<n, k-1>();
+
+    cout << (rtn == 0 ? "Test success" : "Test failed") << endl;
+
+    // Not absolutely necessary, but this call cleans up singleton memory for valgrind
+    // memcheck.
+    morph::bn::Random<n,k>::i_deconstruct();
+    morph::bn::Random<n,k-1>::i_deconstruct();
+
+    return rtn;
+}
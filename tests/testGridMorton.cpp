@@ -0,0 +1,117 @@
+#include "morph/Grid.h"
+#include <iostream>
+#include <limits>
+
+int main()
+{
+    int rtn = 0;
+
+    constexpr int imax = std::numeric_limits<int>::max();
+    morph::vec<float, 2> dx = { 1, 1 };
+    morph::vec<float, 2> offset = { 0, 0 };
+
+    // A 4 x 4 Morton grid looks like this (bottom left origin):
+    //
+    // 10 11 14 15
+    //  8  9 12 13
+    //  2  3  6  7
+    //  0  1  4  5
+
+    //
+    // Encode/decode round trip
+    //
+    for (std::uint64_t y = 0; y < 16; ++y) {
+        for (std::uint64_t x = 0; x < 16; ++x) {
+            std::uint64_t z = morph::morton::encode (x, y);
+            if (morph::morton::decode_x (z) != x || morph::morton::decode_y (z) != y) {
+                --rtn; std::cout << "encode/decode round trip fails for (" << x << "," << y << ")\n";
+            }
+        }
+    }
+
+    //
+    // row()/col()
+    //
+    {
+        morph::Grid<int, float> g(4, 4, dx, offset, morph::GridDomainWrap::None, morph::GridOrder::morton);
+        if (g.col(0) != 0 || g.row(0) != 0) { --rtn; std::cout << "morton row/col(0) fails\n"; }
+        if (g.col(1) != 1 || g.row(1) != 0) { --rtn; std::cout << "morton row/col(1) fails\n"; }
+        if (g.col(2) != 0 || g.row(2) != 1) { --rtn; std::cout << "morton row/col(2) fails\n"; }
+        if (g.col(7) != 3 || g.row(7) != 1) { --rtn; std::cout << "morton row/col(7) fails\n"; }
+        if (g.col(12) != 2 || g.row(12) != 2) { --rtn; std::cout << "morton row/col(12) fails\n"; }
+        if (g.col(15) != 3 || g.row(15) != 3) { --rtn; std::cout << "morton row/col(15) fails\n"; }
+
+        // coord() should agree with row/col
+        for (int i = 0; i < 16; ++i) {
+            morph::vec<float, 2> c = g[i];
+            if (c[0] != static_cast<float>(g.col(i)) || c[1] != static_cast<float>(g.row(i))) {
+                --rtn; std::cout << "morton coord(" << i << ") fails\n";
+            }
+        }
+
+        // index_lookup and index_of are the encode direction
+        if (g.index_lookup (morph::vec<float, 2>{ 2, 1 }) != 6) { --rtn; std::cout << "morton index_lookup fails\n"; }
+        if (g.index_of (3, 2) != 13) { --rtn; std::cout << "morton index_of fails\n"; }
+
+        // Extents are those of a 4 x 4 unit grid
+        if (g.extents() != morph::vec<float, 4>{ 0, 3, 0, 3 }) { --rtn; std::cout << "morton extents fails\n"; }
+    }
+
+    //
+    // Neighbours, no wrapping
+    //
+    {
+        morph::Grid<int, float> g(4, 4, dx, offset, morph::GridDomainWrap::None, morph::GridOrder::morton);
+        // Element 3 is at (1, 1); its neighbours are 6 (E), 9 (N), 2 (W), 1 (S)
+        if (g.index_ne(3) != 6) { --rtn; std::cout << "morton index_ne(3) fails\n"; }
+        if (g.index_nn(3) != 9) { --rtn; std::cout << "morton index_nn(3) fails\n"; }
+        if (g.index_nw(3) != 2) { --rtn; std::cout << "morton index_nw(3) fails\n"; }
+        if (g.index_ns(3) != 1) { --rtn; std::cout << "morton index_ns(3) fails\n"; }
+        if (g.index_nne(3) != 12) { --rtn; std::cout << "morton index_nne(3) fails\n"; }
+        if (g.index_nsw(3) != 0) { --rtn; std::cout << "morton index_nsw(3) fails\n"; }
+        // Element 13 is at (3, 2): no east neighbour; element 10 is at (0, 3): no north/west
+        if (g.index_ne(13) != imax) { --rtn; std::cout << "morton index_ne(13) fails\n"; }
+        if (g.index_nn(10) != imax) { --rtn; std::cout << "morton index_nn(10) fails\n"; }
+        if (g.index_nw(10) != imax) { --rtn; std::cout << "morton index_nw(10) fails\n"; }
+        if (g.index_ns(0) != imax) { --rtn; std::cout << "morton index_ns(0) fails\n"; }
+    }
+
+    //
+    // Neighbours with wrapping
+    //
+    {
+        morph::Grid<int, float> g(4, 4, dx, offset, morph::GridDomainWrap::Both, morph::GridOrder::morton);
+        // Element 13 is at (3, 2); east wraps to (0, 2) = 8
+        if (g.index_ne(13) != 8) { --rtn; std::cout << "morton wrapped index_ne(13) fails\n"; }
+        // Element 10 is at (0, 3); north wraps to (0, 0) = 0, west wraps to (3, 3) = 15
+        if (g.index_nn(10) != 0) { --rtn; std::cout << "morton wrapped index_nn(10) fails\n"; }
+        if (g.index_nw(10) != 15) { --rtn; std::cout << "morton wrapped index_nw(10) fails\n"; }
+        // Element 4 is at (2, 0); south wraps to (2, 3) = 14
+        if (g.index_ns(4) != 14) { --rtn; std::cout << "morton wrapped index_ns(4) fails\n"; }
+    }
+
+    //
+    // A non-square (or non-power-of-two) Morton grid should throw
+    //
+    {
+        bool threw = false;
+        try {
+            morph::Grid<int, float> g(4, 2, dx, offset, morph::GridDomainWrap::None, morph::GridOrder::morton);
+        } catch (const std::runtime_error&) { threw = true; }
+        if (threw == false) { --rtn; std::cout << "4x2 morton Grid should throw\n"; }
+
+        threw = false;
+        try {
+            morph::Grid<int, float> g(3, 3, dx, offset, morph::GridDomainWrap::None, morph::GridOrder::morton);
+        } catch (const std::runtime_error&) { threw = true; }
+        if (threw == false) { --rtn; std::cout << "3x3 morton Grid should throw\n"; }
+    }
+
+    if (rtn == 0) {
+        std::cout << "All tests passed\n";
+    } else {
+        std::cout << "Some tests failed; rtn = " << rtn << "\n";
+    }
+
+    return rtn;
+}
@@ -0,0 +1,60 @@
+/*
+ * Test morph::Grid::subgrid (the rectangular sub-region view). The view's index conversion
+ * must agree with index_of, for_each must touch exactly the viewed elements, stencil_apply
+ * must see the true grid neighbourhood, and out-of-range requests must clip to the grid.
+ */
+
+#include "morph/Grid.h"
+#include <iostream>
+#include <limits>
+#include <vector>
+#include <atomic>
+
+int main()
+{
+    int rtn = 0;
+
+    morph::Grid<unsigned int, float> g (8, 6);
+
+    auto sv = g.subgrid (2, 1, 3, 4);
+    if (sv.n() != 12u) { std::cout << "subgrid n() fail\n"; --rtn; }
+    // View-local 0 is (col 2, row 1); view-local 5 is (col 4, row 2)
+    if (sv.index (0) != g.index_of (2, 1)) { std::cout << "index(0) fail\n"; --rtn; }
+    if (sv.index (5) != g.index_of (4, 2)) { std::cout << "index(5) fail\n"; --rtn; }
+
+    // for_each should touch each viewed element exactly once and nothing else
+    std::vector<int> touched (g.n(), 0);
+    std::atomic<int> count{0};
+    sv.for_each ([&] (unsigned int gi) { touched[gi] += 1; ++count; });
+    if (count != 12) { std::cout << "for_each count fail\n"; --rtn; }
+    for (unsigned int r = 0; r < 6u; ++r) {
+        for (unsigned int c = 0; c < 8u; ++c) {
+            int expected = (c >= 2u && c < 5u && r >= 1u && r < 5u) ? 1 : 0;
+            if (touched[g.index_of (c, r)] != expected) {
+                std::cout << "for_each touched (" << c << "," << r << ") wrongly\n";
+                --rtn;
+            }
+        }
+    }
+
+    // A Laplacian of a uniform field is zero; the stencil sees neighbours outside the view
+    std::vector<float> f (g.n(), 1.0f);
+    std::vector<float> lap (g.n(), -99.0f);
+    sv.stencil_apply ([&] (unsigned int gi, const unsigned int* nb) {
+        float sum = 0.0f;
+        unsigned int cnt = 0;
+        for (int j = 0; j < 4; ++j) {
+            if (nb[j] != std::numeric_limits<unsigned int>::max()) { sum += f[nb[j]]; ++cnt; }
+        }
+        lap[gi] = sum - cnt * f[gi];
+    });
+    if (lap[sv.index (0)] != 0.0f) { std::cout << "stencil_apply fail\n"; --rtn; }
+    if (lap[g.index_of (0, 0)] != -99.0f) { std::cout << "stencil_apply overreach\n"; --rtn; }
+
+    // Requests reaching past the grid edge clip
+    auto sv2 = g.subgrid (6, 4, 10, 10);
+    if (sv2.vw != 2u || sv2.vh != 2u) { std::cout << "clip fail\n"; --rtn; }
+
+    std::cout << "rtn: " << rtn << std::endl;
+    return rtn;
+}
@@ -0,0 +1,74 @@
+/*
+ * Test Gridct::stencil_apply against a naive per-element implementation built on the index_n*()
+ * methods, for each wrap mode and both grid orders.
+ */
+
+#include "morph/Gridct.h"
+#include "morph/vvec.h"
+#include <iostream>
+#include <limits>
+
+template <typename G>
+int test_grid (const G& g, const char* tag)
+{
+    int rtn = 0;
+    constexpr int n = G::n;
+
+    morph::vvec<float> data (n);
+    for (int i = 0; i < n; ++i) { data[i] = 0.01f * i * i - 0.3f * i; }
+
+    // A discrete Laplacian as the stencil function
+    auto lapl = [](float c, float e, float w, float nn, float s) { return e + w + nn + s - 4.0f * c; };
+
+    morph::vvec<float> result (n, 0.0f);
+    g.stencil_apply (data, result, lapl);
+
+    // Naive version: use the index_n* methods for every element, substituting the centre value
+    // for missing neighbours as stencil_apply documents
+    for (int i = 0; i < n; ++i) {
+        int e = g.index_ne (i);
+        int w = g.index_nw (i);
+        int nn = g.index_nn (i);
+        int s = g.index_ns (i);
+        float expected = lapl (data[i],
+                               e < n ? data[e] : data[i], w < n ? data[w] : data[i],
+                               nn < n ? data[nn] : data[i], s < n ? data[s] : data[i]);
+        if (result[i] != expected) {
+            std::cout << tag << ": stencil_apply mismatch at index " << i
+                      << ": " << result[i] << " vs " << expected << std::endl;
+            --rtn;
+            break;
+        }
+    }
+    return rtn;
+}
+
+int main()
+{
+    int rtn = 0;
+
+    constexpr morph::vec<float, 2> dx = { 1, 1 };
+    constexpr morph::vec<float, 2> offset = { 0, 0 };
+
+    using G_none = morph::Gridct<int, float, 8, 6, dx, offset, true, morph::GridDomainWrap::None, morph::GridOrder::bottomleft_to_topright>;
+    using G_horz = morph::Gridct<int, float, 8, 6, dx, offset, true, morph::GridDomainWrap::Horizontal, morph::GridOrder::bottomleft_to_topright>;
+    using G_vert = morph::Gridct<int, float, 8, 6, dx, offset, true, morph::GridDomainWrap::Vertical, morph::GridOrder::bottomleft_to_topright>;
+    using G_both = morph::Gridct<int, float, 8, 6, dx, offset, true, morph::GridDomainWrap::Both, morph::GridOrder::topleft_to_bottomright>;
+    using G_tiny = morph::Gridct<int, float, 2, 2, dx, offset, true, morph::GridDomainWrap::None, morph::GridOrder::bottomleft_to_topright>;
+
+    // The interior offsets resolve at compile time
+    static_assert (G_none::interior_offset_ne == 1);
+    static_assert (G_none::interior_offset_nw == -1);
+    static_assert (G_none::interior_offset_nn == 8);
+    static_assert (G_none::interior_offset_ns == -8);
+    static_assert (G_both::interior_offset_nn == -8); // topleft_to_bottomright order
+
+    rtn += test_grid (G_none(), "wrap None");
+    rtn += test_grid (G_horz(), "wrap Horizontal");
+    rtn += test_grid (G_vert(), "wrap Vertical");
+    rtn += test_grid (G_both(), "wrap Both, tlbr order");
+    rtn += test_grid (G_tiny(), "degenerate 2x2");
+
+    std::cout << (rtn == 0 ? "Test success" : "Test failed") << std::endl;
+    return rtn;
+}
@@ -0,0 +1,103 @@
+/*
+ * Test the bulk HEALPix conversions against their single-pixel counterparts and check
+ * the NEST-ordered map resampling utility.
+ */
+
+#include <morph/healpix/healpix_bare.hpp>
+#include <morph/healpix/healpix_resample.hpp>
+#include <morph/vvec.h>
+#include <iostream>
+#include <cstdint>
+
+int main()
+{
+    int rtn = 0;
+
+    for (int64_t nside : { int64_t{4}, int64_t{64} }) {
+        int64_t npix = hp::nside2npix (nside);
+
+        // Bulk pixel -> angle / vector conversions should agree exactly with the
+        // per-pixel functions
+        morph::vvec<double> theta (npix), phi (npix), x (npix), y (npix), z (npix);
+        hp::nest2ang_bulk (nside, npix, theta.data(), phi.data());
+        hp::nest2vec_bulk (nside, npix, x.data(), y.data(), z.data());
+        for (int64_t p = 0; p < npix; ++p) {
+            hp::t_ang a = hp::nest2ang (nside, p);
+            hp::t_vec v = hp::nest2vec (nside, p);
+            if (theta[p] != a.theta || phi[p] != a.phi
+                || x[p] != v.x || y[p] != v.y || z[p] != v.z) {
+                std::cout << "NEST bulk mismatch at pixel " << p << std::endl;
+                --rtn;
+                break;
+            }
+        }
+        hp::ring2ang_bulk (nside, npix, theta.data(), phi.data());
+        hp::ring2vec_bulk (nside, npix, x.data(), y.data(), z.data());
+        for (int64_t p = 0; p < npix; ++p) {
+            hp::t_ang a = hp::ring2ang (nside, p);
+            hp::t_vec v = hp::ring2vec (nside, p);
+            if (theta[p] != a.theta || phi[p] != a.phi
+                || x[p] != v.x || y[p] != v.y || z[p] != v.z) {
+                std::cout << "RING bulk mismatch at pixel " << p << std::endl;
+                --rtn;
+                break;
+            }
+        }
+
+        // Bulk angle -> pixel conversions (using each pixel's centre, so the round trip
+        // must return the pixel itself)
+        hp::nest2ang_bulk (nside, npix, theta.data(), phi.data());
+        morph::vvec<int64_t> ipix (npix);
+        hp::ang2nest_bulk (nside, npix, theta.data(), phi.data(), ipix.data());
+        for (int64_t p = 0; p < npix; ++p) {
+            if (ipix[p] != p) {
+                std::cout << "ang2nest_bulk round trip failed at pixel " << p << std::endl;
+                --rtn;
+                break;
+            }
+        }
+        hp::ring2ang_bulk (nside, npix, theta.data(), phi.data());
+        hp::ang2ring_bulk (nside, npix, theta.data(), phi.data(), ipix.data());
+        for (int64_t p = 0; p < npix; ++p) {
+            if (ipix[p] != p) {
+                std::cout << "ang2ring_bulk round trip failed at pixel " << p << std::endl;
+                --rtn;
+                break;
+            }
+        }
+    }
+
+    // Map resampling. An upgrade followed by a downgrade must return the original map
+    {
+        int64_t nside = 8;
+        int64_t npix = hp::nside2npix (nside);
+        morph::vvec<double> map (npix);
+        for (int64_t p = 0; p < npix; ++p) { map[p] = static_cast<double>(p % 17); }
+
+        morph::vvec<double> up = hp::map_resample_nest (map, nside, nside * 4);
+        if (up.size() != static_cast<std::size_t>(hp::nside2npix (nside * 4))) { --rtn; }
+        // Each upgraded pixel should hold its ancestor's value
+        for (int64_t p = 0; p < static_cast<int64_t>(up.size()); ++p) {
+            if (up[p] != map[p / 16]) { --rtn; break; }
+        }
+        morph::vvec<double> down = hp::map_resample_nest (up, nside * 4, nside);
+        if ((down - map).abs().max() != 0.0) {
+            std::cout << "up/downgrade round trip failed" << std::endl;
+            --rtn;
+        }
+
+        // A downgrade should average each pixel's 4 children
+        morph::vvec<double> d2 = hp::map_resample_nest (map, nside, nside / 2);
+        for (int64_t p = 0; p < static_cast<int64_t>(d2.size()); ++p) {
+            double mean = (map[4*p] + map[4*p+1] + map[4*p+2] + map[4*p+3]) / 4.0;
+            if (d2[p] != mean) {
+                std::cout << "downgrade mean incorrect at pixel " << p << std::endl;
+                --rtn;
+                break;
+            }
+        }
+    }
+
+    std::cout << (rtn == 0 ? "Test success" : "Test failed") << std::endl;
+    return rtn;
+}
@@ -0,0 +1,62 @@
+/*
+ * Test HexGrid::for_each_flagged, the word-at-a-time scan over the packed flag
+ * words, against a naive scan of d_flags.
+ */
+#include "morph/HexGrid.h"
+#include "morph/Hex.h"
+#include <iostream>
+#include <vector>
+
+int main()
+{
+    int rtn = 0;
+
+    morph::HexGrid hg (0.02f, 3.0f, 0.0f);
+    hg.setCircularBoundary (0.6f);
+    std::cout << "HexGrid with " << hg.num() << " hexes\n";
+
+    // Reference: naive scan of d_flags
+    auto naive_scan = [&hg] (unsigned int mask) {
+        std::vector<unsigned int> idxs;
+        for (unsigned int i = 0; i < hg.d_flags.size(); ++i) {
+            if (hg.d_flags[i] & mask) { idxs.push_back (i); }
+        }
+        return idxs;
+    };
+
+    for (unsigned int mask : { static_cast<unsigned int>(HEX_IS_BOUNDARY),
+                               static_cast<unsigned int>(HEX_INSIDE_BOUNDARY),
+                               static_cast<unsigned int>(HEX_HAS_NE | HEX_HAS_NW) }) {
+        std::vector<unsigned int> expected = naive_scan (mask);
+        std::vector<unsigned int> got;
+        hg.for_each_flagged (mask, [&got] (unsigned int i) { got.push_back (i); });
+        std::cout << "mask 0x" << std::hex << mask << std::dec << ": expected "
+                  << expected.size() << " hexes, got " << got.size() << std::endl;
+        if (got != expected) { rtn -= 1; }
+        if (mask == HEX_IS_BOUNDARY && expected.empty()) {
+            // A circular boundary should have flagged some hexes
+            rtn -= 1;
+        }
+    }
+
+    // After a forced re-pack, results should be unchanged
+    hg.clear_flag_words();
+    std::vector<unsigned int> got2;
+    hg.for_each_flagged (HEX_IS_BOUNDARY, [&got2] (unsigned int i) { got2.push_back (i); });
+    if (got2 != naive_scan (HEX_IS_BOUNDARY)) { rtn -= 1; }
+
+    // Changing the boundary rebuilds the d_ vectors, which must invalidate the
+    // packed words (for_each_flagged re-packs on the size change)
+    hg.setCircularBoundary (0.4f);
+    std::vector<unsigned int> got3;
+    hg.for_each_flagged (HEX_IS_BOUNDARY, [&got3] (unsigned int i) { got3.push_back (i); });
+    std::cout << "After boundary change: " << got3.size() << " boundary hexes\n";
+    if (got3 != naive_scan (HEX_IS_BOUNDARY)) { rtn -= 1; }
+
+    if (rtn == 0) {
+        std::cout << "All tests passed" << std::endl;
+    } else {
+        std::cout << "Some tests failed" << std::endl;
+    }
+    return rtn;
+}
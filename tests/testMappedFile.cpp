@@ -0,0 +1,58 @@
+// Test morph::MappedFile and the bulk file-reading helpers
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "morph/MappedFile.h"
+#include "morph/AllocAndRead.h"
+#include "morph/tools.h"
+
+int main()
+{
+    int rtn = 0;
+
+    // Write a file of known content, including a non-newline final byte
+    std::string content;
+    for (int i = 0; i < 1000; ++i) { content += "line " + std::to_string (i) + "\n"; }
+    content += "no trailing newline";
+    morph::tools::copyStringToFile (content, "./testMappedFile.txt");
+
+    // MappedFile should present the bytes zero-copy
+    {
+        morph::MappedFile mf ("./testMappedFile.txt");
+        if (mf.size() != content.size()) { std::cout << "MappedFile size fail\n"; rtn -= 1; }
+        if (mf.view() != content) { std::cout << "MappedFile view fail\n"; rtn -= 1; }
+        if (mf.bytes()[0] != 'l') { std::cout << "MappedFile bytes fail\n"; rtn -= 1; }
+        // Move the mapping
+        morph::MappedFile mf2 (std::move (mf));
+        if (mf2.view() != content || mf.size() != 0) { std::cout << "MappedFile move fail\n"; rtn -= 1; }
+    }
+
+    // The random-access hint maps the same content
+    {
+        morph::MappedFile mf ("./testMappedFile.txt", morph::MappedFileAccess::random);
+        if (mf.view() != content) { std::cout << "MappedFile hint fail\n"; rtn -= 1; }
+    }
+
+    // A missing file should throw
+    bool threw = false;
+    try {
+        morph::MappedFile mf ("./testMappedFile_nonexistent.txt");
+    } catch (const std::exception&) { threw = true; }
+    if (!threw) { std::cout << "MappedFile missing-file fail\n"; rtn -= 1; }
+
+    // tools::readFileToString reads the exact bytes
+    if (morph::tools::readFileToString ("./testMappedFile.txt") != content) {
+        std::cout << "readFileToString fail\n"; rtn -= 1;
+    }
+
+    // AllocAndRead's bulk read preserves the file byte-for-byte (and null terminates)
+    {
+        morph::AllocAndRead aar ("./testMappedFile.txt");
+        if (aar.getsize() != content.size() + 1) { std::cout << "AllocAndRead size fail\n"; rtn -= 1; }
+        if (std::string (aar.data()) != content) { std::cout << "AllocAndRead content fail\n"; rtn -= 1; }
+    }
+
+    std::cout << "Returning " << rtn << std::endl;
+    return rtn;
+}
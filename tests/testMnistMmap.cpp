@@ -0,0 +1,87 @@
+// Test morph::MnistMmap against morph::Mnist on a small, synthetic idx dataset
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "morph/Mnist.h"
+
+// Write a tiny idx image/label file pair with n examples; pixel value = (id + pixel index) % 256
+void write_idx (const std::string& tag, int n)
+{
+    auto put32 = [] (std::ofstream& f, std::uint32_t v) {
+        char b[4] = { static_cast<char>(v >> 24), static_cast<char>(v >> 16),
+                      static_cast<char>(v >> 8), static_cast<char>(v) };
+        f.write (b, 4);
+    };
+    std::ofstream img ("./" + tag + "-images-idx3-ubyte", std::ios::out | std::ios::trunc | std::ios::binary);
+    std::ofstream lbl ("./" + tag + "-labels-idx1-ubyte", std::ios::out | std::ios::trunc | std::ios::binary);
+    put32 (img, 2051);
+    put32 (img, n);
+    put32 (img, 28);
+    put32 (img, 28);
+    put32 (lbl, 2049);
+    put32 (lbl, n);
+    for (int i = 0; i < n; ++i) {
+        lbl.put (static_cast<char>(i % 10));
+        for (int p = 0; p < morph::mnlen; ++p) { img.put (static_cast<char>((i + p) % 256)); }
+    }
+}
+
+int main()
+{
+    int rtn = 0;
+
+    write_idx ("train", 20);
+    write_idx ("t10k", 7);
+
+    morph::Mnist mni ("./");
+    morph::MnistMmap mmp ("./");
+
+    if (mmp.num_training() != mni.num_training() || mmp.num_training() != 20) {
+        std::cout << "num_training fail\n"; rtn -= 1;
+    }
+    if (mmp.num_test() != mni.num_test() || mmp.num_test() != 7) {
+        std::cout << "num_test fail\n"; rtn -= 1;
+    }
+
+    // Converted images and labels should match Mnist's exactly
+    for (int id = 0; id < 20; ++id) {
+        auto [mid, mlbl, mimg] = mni.training_example (id);
+        if (mmp.training.label (id) != mlbl) { std::cout << "label fail for ID " << id << "\n"; rtn -= 1; }
+        if (mmp.training.image_f (id) != mimg) { std::cout << "image_f fail for ID " << id << "\n"; rtn -= 1; }
+    }
+
+    // The raw span is the file's bytes, zero-copy
+    std::span<const std::uint8_t> raw = mmp.test.image (3);
+    if (raw.size() != morph::mnlen || raw[0] != 3 || raw[100] != 103) {
+        std::cout << "raw span fail\n"; rtn -= 1;
+    }
+
+    // Batch conversion into a caller buffer
+    std::vector<float> batch (5 * morph::mnlen, 0.0f);
+    mmp.training.extract_batch (10, 5, batch.data());
+    for (int i = 0; i < 5; ++i) {
+        auto [mid, mlbl, mimg] = mni.training_example (10 + i);
+        for (int p = 0; p < morph::mnlen; ++p) {
+            if (batch[i * morph::mnlen + p] != mimg[p]) {
+                std::cout << "batch fail for image " << i << "\n"; rtn -= 1;
+                break;
+            }
+        }
+    }
+
+    // The iterator yields (id, label, pixels) without copying
+    int count = 0;
+    for (auto ex : mmp.test) {
+        if (ex.id != count || ex.label != count % 10 || ex.pixels[0] != count % 256) {
+            std::cout << "iterator fail at " << count << "\n"; rtn -= 1;
+        }
+        ++count;
+    }
+    if (count != 7) { std::cout << "iterator count fail\n"; rtn -= 1; }
+
+    std::cout << "Returning " << rtn << std::endl;
+    return rtn;
+}
@@ -0,0 +1,76 @@
+/*
+ * Test the speculative (batched candidate evaluation) mode of the Nelder Mead Simplex
+ * algorithm on the Rosenbrock banana function, checking that it visits exactly the same
+ * simplexes as the serial mode.
+ */
+
+#include "morph/NM_Simplex.h"
+#include "morph/vvec.h"
+#include <iostream>
+#include <cmath>
+
+int main()
+{
+    // Initialise the vertices
+    morph::vvec<morph::vvec<FLT>> i_vertices = {
+        { 0.7, 0.0 },
+        { 0.0, 0.6 },
+        { -0.6, -1.0 }
+    };
+    // Define your Rosenbrock Banana objective function
+    auto banana = [](const morph::vvec<FLT>& point) {
+        FLT x = point[0];
+        FLT y = point[1];
+        constexpr FLT a = FLT{1};
+        constexpr FLT b = FLT{100};
+        FLT rtn = ((a-x)*(a-x)) + (b * (y-(x*x)) * (y-(x*x)));
+        return rtn;
+    };
+
+    // First run the serial mode for reference
+    morph::NM_Simplex<FLT> simp(i_vertices);
+    simp.objective = banana;
+    simp.termination_threshold = std::numeric_limits<FLT>::epsilon();
+    if (!simp.run()) { std::cerr << "Objective was not set\n"; return -1; }
+    morph::vvec<FLT> serial_best = simp.best_vertex();
+    FLT serial_value = simp.best_value();
+
+    // Now run the speculative mode, driving the state machine as client code which
+    // farms the batch out would (here, the 'farm' is a simple loop)
+    morph::NM_Simplex<FLT> simp_s(i_vertices);
+    simp_s.speculative = true;
+    simp_s.termination_threshold = std::numeric_limits<FLT>::epsilon();
+    while (simp_s.state != morph::NM_Simplex_State::ReadyToStop) {
+        if (simp_s.state == morph::NM_Simplex_State::NeedToComputeThenOrder) {
+            simp_s.speculate_initial();
+        }
+        if (simp_s.state == morph::NM_Simplex_State::NeedToComputeSpeculative) {
+            // Each of these evaluations could run on its own thread/process
+            for (unsigned int i = 0; i < simp_s.x_spec.size(); ++i) {
+                simp_s.f_x_spec[i] = banana (simp_s.x_spec[i]);
+            }
+            simp_s.apply_speculative();
+        } else {
+            std::cerr << "Unexpected state in speculative mode\n";
+            return -1;
+        }
+    }
+    if (simp_s.stopreason != morph::NM_Simplex_Stop_Reason::TerminationThreshold) {
+        std::cerr << "The speculative optimization stopped for the wrong reason\n";
+        return -1;
+    }
+
+    // The speculative mode consumes the same values at the same decision points, so it
+    // should arrive at *exactly* the serial mode's result, in the same number of
+    // simplex operations
+    morph::vvec<FLT> spec_best = simp_s.best_vertex();
+    std::cout << "FINISHED! Speculative best approximation: (" << spec_best
+              << ") has value " << simp_s.best_value() << std::endl;
+    if (spec_best == serial_best && simp_s.best_value() == serial_value
+        && simp_s.operation_count == simp.operation_count) {
+        std::cout << "Test success" << std::endl;
+        return 0;
+    }
+    std::cout << "Test failure" << std::endl;
+    return -1;
+}
@@ -0,0 +1,95 @@
+/*
+ * Test that the multi-threaded PopulationFitness engine computes exactly the fitnesses
+ * that serial calls to GeneNetDual::evaluate_fitness would.
+ */
+
+#include <morph/bn/Genome.h>
+#include <morph/bn/GeneNetDual.h>
+#include <morph/bn/PopulationFitness.h>
+#include <morph/bn/Random.h>
+#include <iostream>
+
+using std::endl;
+using std::cout;
+
+const size_t n = 5;
+const size_t k = 5;
+// Globally initialise Random instance pointer - necessary for all progs using Genome
+template<> morph::bn::Random<n,k>* morph::bn::Random<n,k>::pInstance = 0;
+
+int main()
+{
+    int rtn = 0;
+
+    // A population of random genomes
+    std::vector<morph::bn::Genome<n,k>> population (200);
+    for (auto& g : population) { g.randomize(); }
+
+    // Score the population with 4 worker threads
+    std::vector<double> fitnesses =
+    morph::bn::PopulationFitness<n,k>::evaluate (population, 0x15, 0xa, 4);
+
+    // ...and serially, for comparison
+    morph::bn::GeneNetDual<n,k> gn;
+    gn.target_ant = 0x15;
+    gn.target_pos = 0xa;
+    for (size_t i = 0; i < population.size(); ++i) {
+        double f = gn.evaluate_fitness (population[i]);
+        if (f != fitnesses[i]) {
+            cout << "Fitness mismatch for genome " << i << ": serial " << f
+                 << " vs parallel " << fitnesses[i] << endl;
+            --rtn;
+        }
+    }
+
+    // The result should not depend on the thread count
+    std::vector<double> fitnesses1 =
+    morph::bn::PopulationFitness<n,k>::evaluate (population, 0x15, 0xa, 1);
+    if (fitnesses1 != fitnesses) {
+        cout << "1 thread and 4 thread evaluations disagree" << endl;
+        --rtn;
+    }
+
+    // The diversity metrics. total_pairwise_hamming's one-pass bit-count method
+    // must agree with explicit pairwise Genome::hamming calls.
+    unsigned long long int total_ref = 0;
+    for (size_t i = 0; i < population.size(); ++i) {
+        for (size_t j = i + 1; j < population.size(); ++j) {
+            total_ref += population[i].hamming (population[j]);
+        }
+    }
+    unsigned long long int total = morph::bn::PopulationFitness<n,k>::total_pairwise_hamming (population);
+    if (total != total_ref) {
+        cout << "total_pairwise_hamming " << total << " != pairwise reference " << total_ref << endl;
+        --rtn;
+    }
+    double npairs = 0.5 * population.size() * (population.size() - 1);
+    double mean = morph::bn::PopulationFitness<n,k>::mean_pairwise_hamming (population);
+    if (mean != static_cast<double>(total_ref) / npairs) {
+        cout << "mean_pairwise_hamming mismatch" << endl;
+        --rtn;
+    }
+
+    // hamming_to: distance to a reference genome, and 0 for the reference itself
+    std::vector<unsigned int> dists =
+    morph::bn::PopulationFitness<n,k>::hamming_to (population, population[0]);
+    if (dists[0] != 0 || dists[1] != population[1].hamming (population[0])) {
+        cout << "hamming_to mismatch" << endl;
+        --rtn;
+    }
+
+    // An identical population has zero diversity
+    std::vector<morph::bn::Genome<n,k>> clones (10, population[0]);
+    if (morph::bn::PopulationFitness<n,k>::mean_pairwise_hamming (clones) != 0.0) {
+        cout << "clone population should have zero diversity" << endl;
+        --rtn;
+    }
+
+    cout << (rtn == 0 ? "Test success" : "Test failed") << endl;
+
+    // Not absolutely necessary, but this call cleans up singleton memory for valgrind
+    // memcheck.
+    morph::bn::Random<n,k>::i_deconstruct();
+
+    return rtn;
+}
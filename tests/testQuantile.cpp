@@ -0,0 +1,113 @@
+/*
+ * Test MathAlgo's nth_element-based median/quantile against a full-sort reference, and
+ * the streaming QuantileP2 estimator against exact quantiles of the same stream.
+ */
+
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <morph/MathAlgo.h>
+#include <morph/QuantileP2.h>
+#include <morph/Random.h>
+#include <morph/vvec.h>
+
+//! Exact p quantile by full sort, R-7 interpolation
+double quantile_by_sort (std::vector<double> v, const double p)
+{
+    std::sort (v.begin(), v.end());
+    const double h = p * static_cast<double>(v.size() - 1);
+    const std::size_t lo = static_cast<std::size_t>(h);
+    const double frac = h - static_cast<double>(lo);
+    if (frac == 0.0) { return v[lo]; }
+    return v[lo] + frac * (v[lo + 1] - v[lo]);
+}
+
+int main()
+{
+    int rtn = 0;
+
+    // Odd and even counts, small enough to check by hand
+    std::vector<double> odd = { 5.0, 1.0, 3.0, 2.0, 4.0 };
+    if (morph::MathAlgo::median (odd) != 3.0) {
+        std::cerr << "median of odd count is wrong" << std::endl;
+        rtn -= 1;
+    }
+    std::vector<double> even = { 4.0, 1.0, 3.0, 2.0 };
+    if (morph::MathAlgo::median (even) != 2.5) {
+        std::cerr << "median of even count is wrong" << std::endl;
+        rtn -= 1;
+    }
+    // The copying overload must leave its input untouched
+    if (even != std::vector<double>({ 4.0, 1.0, 3.0, 2.0 })) {
+        std::cerr << "median() reordered its input" << std::endl;
+        rtn -= 1;
+    }
+
+    // quantile endpoints are min and max
+    if (morph::MathAlgo::quantile (odd, 0.0) != 1.0 || morph::MathAlgo::quantile (odd, 1.0) != 5.0) {
+        std::cerr << "quantile endpoints are wrong" << std::endl;
+        rtn -= 1;
+    }
+
+    // Against the full-sort reference on random data (vvec is a copyable container)
+    morph::RandNormal<double, std::mt19937_64> rn (1.0, 3.0, 11u);
+    morph::vvec<double> data;
+    data.set_from (rn.get (100001));
+    for (const double p : { 0.01, 0.25, 0.5, 0.75, 0.9, 0.99 }) {
+        const double qn = morph::MathAlgo::quantile (data, p);
+        const double qs = quantile_by_sort (std::vector<double>(data.begin(), data.end()), p);
+        if (std::abs (qn - qs) > 1e-12) {
+            std::cerr << "quantile(p=" << p << ") = " << qn << " but full sort gives " << qs << std::endl;
+            rtn -= 1;
+        }
+    }
+    if (morph::MathAlgo::median (data) != morph::MathAlgo::quantile (data, 0.5)) {
+        std::cerr << "median disagrees with quantile(0.5)" << std::endl;
+        rtn -= 1;
+    }
+
+    // The in-place version agrees and avoids the copy
+    std::vector<double> work (data.begin(), data.end());
+    const double q9_ref = morph::MathAlgo::quantile (data, 0.9);
+    if (morph::MathAlgo::quantile_inplace (std::span<double>{work}, 0.9) != q9_ref) {
+        std::cerr << "quantile_inplace disagrees with quantile" << std::endl;
+        rtn -= 1;
+    }
+
+    // Streaming P2 estimates over the same stream. P2 is approximate; for 10^5 normal
+    // samples the estimate should land within a few hundredths of an sd of the truth
+    for (const double p : { 0.5, 0.95 }) {
+        morph::QuantileP2<double> qp2 (p);
+        for (const double x : data) { qp2.update (x); }
+        const double exact = morph::MathAlgo::quantile (data, p);
+        const double err = std::abs (qp2.get() - exact);
+        std::cout << "P2 p=" << p << ": estimate " << qp2.get() << ", exact " << exact
+                  << ", error " << err << std::endl;
+        if (err > 0.1) {
+            std::cerr << "P2 estimate too far from the exact quantile" << std::endl;
+            rtn -= 1;
+        }
+        if (qp2.count() != data.size()) {
+            std::cerr << "P2 count is wrong" << std::endl;
+            rtn -= 1;
+        }
+    }
+
+    // P2 before five observations gives the exact quantile of those seen
+    morph::QuantileP2<float> early (0.5);
+    early.update (2.0f);
+    early.update (1.0f);
+    early.update (3.0f);
+    if (early.get() != 2.0f) {
+        std::cerr << "P2 early-stream median is wrong" << std::endl;
+        rtn -= 1;
+    }
+
+    if (rtn == 0) {
+        std::cout << "All tests passed" << std::endl;
+    } else {
+        std::cout << "Some tests failed" << std::endl;
+    }
+    return rtn;
+}
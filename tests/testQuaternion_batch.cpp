@@ -0,0 +1,34 @@
+/*
+ * Test quaternion::rotate_batch against single-point rotation with operator*.
+ */
+
+#include <iostream>
+#include <vector>
+#include <morph/quaternion.h>
+
+int main()
+{
+    int rtn = 0;
+    morph::vec<float, 3> axis = {0.3f, 0.5f, 0.81f};
+    axis.renormalize();
+    morph::quaternion<float> q (axis, 1.234f);
+    constexpr std::size_t n = 777;
+    std::vector<morph::vec<float, 3>> pts (n);
+    for (std::size_t i = 0; i < n; ++i) {
+        pts[i] = { 0.01f * i, 1.0f - 0.002f * i, -0.5f + 0.001f * i };
+    }
+    std::vector<morph::vec<float, 3>> out (n);
+    q.rotate_batch (std::span<const morph::vec<float,3>>(pts), std::span<morph::vec<float,3>>(out));
+    for (std::size_t i = 0; i < n; ++i) {
+        morph::vec<float, 3> expct = q * pts[i];
+        if ((out[i] - expct).abs().max() > 1e-5f) { std::cerr << "mismatch at " << i << std::endl; rtn -= 1; break; }
+    }
+    // in place
+    std::vector<morph::vec<float, 3>> inplace = pts;
+    q.rotate_batch (std::span<morph::vec<float,3>>(inplace));
+    for (std::size_t i = 0; i < n; ++i) {
+        if ((inplace[i] - out[i]).abs().max() > 0.0f) { std::cerr << "inplace mismatch at " << i << std::endl; rtn -= 1; break; }
+    }
+    std::cout << (rtn == 0 ? "All tests passed" : "Some tests failed") << std::endl;
+    return rtn;
+}
@@ -0,0 +1,97 @@
+/*
+ * Test the packed-bitset Quine64 minimizer against morph::bn::Quine: the prime
+ * implicant sets should be identical and the minimal covers the same size, for every
+ * 3 variable function and a selection of random 4 and 5 variable functions.
+ */
+
+#include <morph/bn/Quine.h>
+#include <iostream>
+#include <set>
+#include <utility>
+#include <random>
+
+using std::endl;
+using std::cout;
+using morph::bn::Quine;
+using morph::bn::Quine64;
+
+int compare (int vars, std::uint64_t table)
+{
+    int rtn = 0;
+
+    Quine64 q64 (vars);
+    q64.setTable (table);
+    if (table == 0) {
+        q64.go (2);
+        if (!q64.primes.empty() || !q64.cover.empty() || q64.min() != "F = 0") {
+            cout << "F = 0 case failed" << endl;
+            --rtn;
+        }
+        return rtn;
+    }
+
+    Quine q (vars);
+    for (int m = 0; m < (1 << vars); ++m) {
+        if (table & (std::uint64_t{1} << m)) { q.addMinterm (m); }
+    }
+    q.go();
+    q64.go (2);
+
+    // The prime implicant sets should be identical
+    std::set<std::pair<unsigned int, unsigned int>> qprimes, q64primes;
+    for (morph::bn::Implicant& im : q.primes) {
+        qprimes.insert ({ static_cast<unsigned int>(im.implicant), static_cast<unsigned int>(im.mask) });
+    }
+    for (const Quine64::Term& t : q64.primes) { q64primes.insert ({ t.value, t.mask }); }
+    if (qprimes != q64primes) {
+        cout << "Prime implicant mismatch for vars=" << vars << ", table=0x"
+             << std::hex << table << std::dec << endl;
+        --rtn;
+    }
+
+    // The cover should cover exactly the function's minterms...
+    std::uint64_t covered = 0;
+    for (const Quine64::Term& t : q64.cover) {
+        for (int m = 0; m < (1 << vars); ++m) {
+            if (Quine64::covers (t, m)) {
+                if (!(table & (std::uint64_t{1} << m))) {
+                    cout << "Cover term includes a non-minterm" << endl;
+                    --rtn;
+                }
+                covered |= (std::uint64_t{1} << m);
+            }
+        }
+    }
+    if (covered != table) {
+        cout << "Cover does not cover the whole function" << endl;
+        --rtn;
+    }
+
+    // ...and be exactly as small as Quine's Petrick solution
+    unsigned int qn = 0;
+    for (std::size_t i = 0; i < q.primes.size(); ++i) {
+        if (q.M0[q.ind] & (std::size_t{1} << i)) { ++qn; }
+    }
+    if (qn != q64.cover.size()) {
+        cout << "Cover size mismatch: " << qn << " vs " << q64.cover.size() << endl;
+        --rtn;
+    }
+
+    return rtn;
+}
+
+int main()
+{
+    int rtn = 0;
+
+    // Every 3 variable function
+    for (std::uint64_t t = 0; t < 256; ++t) { rtn += compare (3, t); }
+
+    // Random 4 and 5 variable functions
+    std::mt19937_64 rng (42);
+    for (int i = 0; i < 100; ++i) { rtn += compare (4, rng() & 0xffffu); }
+    for (int i = 0; i < 50; ++i) { rtn += compare (5, rng() & 0xffffffffu); }
+
+    cout << (rtn == 0 ? "Test success" : "Test failed") << endl;
+    return rtn;
+}
@@ -0,0 +1,79 @@
+/*
+ * Test RandPoisson::get_bulk (Knuth's method below mean 10, Hoermann's PTRD above) and
+ * RandLogNormal::get_bulk (block Box-Muller plus vectorized exp): sample statistics
+ * must match the requested distributions on both sides of the Poisson cutover, and
+ * same-seeded generators must agree.
+ */
+
+#include <iostream>
+#include <cmath>
+#include <morph/Random.h>
+
+// Check the sample mean and variance of Poisson bulk samples against lambda
+template <typename E>
+int check_poisson (const double lambda, const double tol)
+{
+    constexpr std::size_t n = 1000000;
+    morph::RandPoisson<int, E> rp (static_cast<int>(lambda), 2000u);
+    rp.param (typename std::poisson_distribution<int>::param_type (lambda));
+    std::vector<int> samples = rp.get_bulk (n);
+
+    double sum = 0.0;
+    for (auto s : samples) {
+        if (s < 0) { std::cerr << "negative Poisson sample!" << std::endl; return -1; }
+        sum += s;
+    }
+    const double mean = sum / static_cast<double>(n);
+    double sumsq = 0.0;
+    for (auto s : samples) { sumsq += (s - mean) * (s - mean); }
+    const double var = sumsq / static_cast<double>(n);
+    std::cout << "lambda " << lambda << ": bulk mean = " << mean << ", variance = " << var << std::endl;
+
+    int rtn = 0;
+    if (std::abs (mean - lambda) > tol) { std::cerr << "bulk mean is off" << std::endl; rtn -= 1; }
+    if (std::abs (var - lambda) > 10.0 * tol) { std::cerr << "bulk variance is off" << std::endl; rtn -= 1; }
+    return rtn;
+}
+
+int main()
+{
+    int rtn = 0;
+
+    // Below and above the PTRD cutover at lambda = 10, and well above it
+    rtn += check_poisson<std::mt19937> (0.8, 0.01);
+    rtn += check_poisson<std::mt19937> (4.0, 0.02);
+    rtn += check_poisson<std::mt19937> (30.0, 0.05);
+    rtn += check_poisson<std::mt19937_64> (800.0, 0.5);
+
+    // Same seed must give the same bulk sequence
+    morph::RandPoisson<int, std::mt19937> p1 (50, 42u);
+    morph::RandPoisson<int, std::mt19937> p2 (50, 42u);
+    std::vector<int> b1 = p1.get_bulk (1000);
+    std::vector<int> b2 (1000, 0);
+    p2.get_bulk (b2.data(), b2.size());
+    if (b1 != b2) { std::cerr << "same-seed Poisson bulk sequences differ" << std::endl; rtn -= 1; }
+
+    // Log-normal: mean of the samples' logs should be mu, sd of the logs sigma
+    constexpr std::size_t n = 1000001; // odd, to exercise the tail element
+    morph::RandLogNormal<double, std::mt19937_64> rln (0.5, 0.25, 3000u);
+    std::vector<double> ln_samples = rln.get_bulk (n);
+    double logsum = 0.0;
+    for (auto s : ln_samples) {
+        if (s <= 0.0 || !std::isfinite (s)) { std::cerr << "non-positive log-normal sample!" << std::endl; rtn -= 1; break; }
+        logsum += std::log (s);
+    }
+    const double logmean = logsum / static_cast<double>(n);
+    double logsumsq = 0.0;
+    for (auto s : ln_samples) { logsumsq += (std::log (s) - logmean) * (std::log (s) - logmean); }
+    const double logsd = std::sqrt (logsumsq / static_cast<double>(n));
+    std::cout << "log-normal: mean of logs = " << logmean << ", sd of logs = " << logsd << std::endl;
+    if (std::abs (logmean - 0.5) > 0.005) { std::cerr << "log-normal mu is off" << std::endl; rtn -= 1; }
+    if (std::abs (logsd - 0.25) > 0.005) { std::cerr << "log-normal sigma is off" << std::endl; rtn -= 1; }
+
+    if (rtn == 0) {
+        std::cout << "All tests passed" << std::endl;
+    } else {
+        std::cout << "Some tests failed" << std::endl;
+    }
+    return rtn;
+}
@@ -0,0 +1,75 @@
+/*
+ * Test morph::philox_engine: known-answer vector, determinism, stream independence, O(1)
+ * discard() and use as the engine parameter of the Rand* wrapper classes.
+ */
+
+#include <iostream>
+#include <morph/Random.h>
+
+int main()
+{
+    int rtn = 0;
+
+    // Known-answer test from the Random123 reference implementation: philox4x32-10 with
+    // counter = {0,0,0,0} and key = {0,0} produces these four words
+    morph::philox_engine kat (0, 0);
+    const std::array<std::uint32_t, 4> expct = { 0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u };
+    for (unsigned int i = 0; i < 4; ++i) {
+        std::uint32_t got = kat();
+        if (got != expct[i]) {
+            std::cerr << "Philox KAT failed at word " << i << ": got " << std::hex << got
+                      << " expected " << expct[i] << std::dec << std::endl;
+            rtn -= 1;
+        }
+    }
+
+    // Same seed gives the same sequence
+    morph::philox_engine e1 (12345u);
+    morph::philox_engine e2 (12345u);
+    for (int i = 0; i < 100; ++i) {
+        if (e1() != e2()) { std::cerr << "Same-seed sequences differ" << std::endl; rtn -= 1; break; }
+    }
+
+    // Different streams with the same seed give different sequences
+    morph::philox_engine s0 (999u, 0);
+    morph::philox_engine s1 (999u, 1);
+    int ndiff = 0;
+    for (int i = 0; i < 100; ++i) { if (s0() != s1()) { ++ndiff; } }
+    if (ndiff < 90) { std::cerr << "Streams 0 and 1 are suspiciously similar" << std::endl; rtn -= 1; }
+
+    // discard(z) must be equivalent to drawing z values, for offsets that do and don't
+    // cross block boundaries
+    for (unsigned long long z : { 1ull, 3ull, 4ull, 5ull, 1000ull, 1000003ull }) {
+        morph::philox_engine ea (42u);
+        morph::philox_engine eb (42u);
+        ea(); ea(); // part-use a block first
+        eb(); eb();
+        for (unsigned long long i = 0; i < z; ++i) { ea(); }
+        eb.discard (z);
+        if (ea() != eb()) {
+            std::cerr << "discard(" << z << ") not equivalent to drawing" << std::endl;
+            rtn -= 1;
+        }
+    }
+
+    // Use as the engine of the wrapper classes
+    morph::RandUniform<float, morph::philox_engine> ru (0.0f, 1.0f, 2023u);
+    for (int i = 0; i < 1000; ++i) {
+        float f = ru.get();
+        if (f < 0.0f || f >= 1.0f) { std::cerr << "RandUniform<philox> out of range" << std::endl; rtn -= 1; break; }
+    }
+    morph::RandNormal<double, morph::philox_engine> rn (0.0, 1.0);
+    double sum = 0.0;
+    for (int i = 0; i < 10000; ++i) { sum += rn.get(); }
+    if (std::abs (sum / 10000.0) > 0.1) {
+        std::cerr << "RandNormal<philox> mean is off: " << (sum / 10000.0) << std::endl;
+        rtn -= 1;
+    }
+
+    if (rtn == 0) {
+        std::cout << "All tests passed" << std::endl;
+    } else {
+        std::cout << "Some tests failed" << std::endl;
+    }
+    return rtn;
+}
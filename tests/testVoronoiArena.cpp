@@ -0,0 +1,112 @@
+/*
+ * Test morph::voronoi_generate (arena-backed, parallel-presorted diagram generation)
+ * against plain jcv_diagram_generate: the diagrams should be identical, site indices
+ * should refer to the caller's point order, and the arena should stop growing after the
+ * first generation.
+ */
+
+#include <morph/voronoi.h>
+#include <morph/vec.h>
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cstring>
+
+// Count a site's edges and sum its vertex coordinates, as a cheap cell fingerprint
+static void cell_fingerprint (const jcv_site* site, unsigned int& n_edges, double& possum)
+{
+    n_edges = 0;
+    possum = 0.0;
+    for (const jcv_graphedge* e = site->edges; e != nullptr; e = e->next) {
+        ++n_edges;
+        possum += e->pos[0][0] + e->pos[0][1] + e->pos[1][0] + e->pos[1][1];
+    }
+}
+
+int main()
+{
+    int rtn = 0;
+    std::mt19937 rng (2025);
+    std::uniform_real_distribution<float> unif (0.0f, 1.0f);
+
+    morph::voronoi_arena arena;
+    std::size_t cap_after_first = 0;
+
+    for (int trial = 0; trial < 4; ++trial) {
+        int np = 5000 + 1000 * trial;
+        std::vector<jcv_point> points (np);
+        for (int i = 0; i < np; ++i) { points[i] = jcv_point{ unif (rng), unif (rng), unif (rng) }; }
+
+        jcv_rect domain = { jcv_point{-0.1f, -0.1f, 0.0f}, jcv_point{1.1f, 1.1f, 0.0f} };
+
+        // Reference: the original single-threaded, malloc-backed generation
+        jcv_diagram ref_diagram;
+        std::memset (&ref_diagram, 0, sizeof(jcv_diagram));
+        jcv_diagram_generate (np, points.data(), &domain, 0, &ref_diagram);
+
+        // The wrapper, with 4 sorting threads
+        jcv_diagram diagram;
+        morph::voronoi_generate (np, points.data(), &domain, arena, &diagram, 4);
+
+        if (diagram.numsites != ref_diagram.numsites) {
+            std::cout << "numsites mismatch: " << diagram.numsites
+                      << " vs " << ref_diagram.numsites << std::endl;
+            --rtn;
+        }
+
+        // Index every reference cell fingerprint by site index, then compare
+        const jcv_site* ref_sites = jcv_diagram_get_sites (&ref_diagram);
+        const jcv_site* sites = jcv_diagram_get_sites (&diagram);
+        std::vector<unsigned int> ref_nedges (np, 0u);
+        std::vector<double> ref_possum (np, 0.0);
+        for (int i = 0; i < ref_diagram.numsites; ++i) {
+            cell_fingerprint (&ref_sites[i], ref_nedges[ref_sites[i].index], ref_possum[ref_sites[i].index]);
+        }
+        for (int i = 0; i < diagram.numsites; ++i) {
+            const jcv_site* site = &sites[i];
+            if (points[site->index] != site->p) {
+                std::cout << "Site " << i << " index does not refer to the caller's points" << std::endl;
+                --rtn;
+                break;
+            }
+            unsigned int n_edges = 0;
+            double possum = 0.0;
+            cell_fingerprint (site, n_edges, possum);
+            if (n_edges != ref_nedges[site->index] || possum != ref_possum[site->index]) {
+                std::cout << "Cell mismatch for site index " << site->index << std::endl;
+                --rtn;
+                break;
+            }
+        }
+
+        jcv_diagram_free (&ref_diagram);
+        jcv_diagram_free (&diagram); // no-op for arena-backed diagrams
+
+        if (trial == 0) {
+            cap_after_first = arena.capacity();
+            std::cout << "Arena capacity after first diagram: " << cap_after_first << " bytes" << std::endl;
+        }
+    }
+
+    if (cap_after_first == 0) { --rtn; } // the first diagram must have drawn from the arena
+
+    // Regenerating at the same size must reuse the retained blocks, not grow the arena
+    {
+        int np = 8000;
+        std::vector<jcv_point> points (np);
+        for (int i = 0; i < np; ++i) { points[i] = jcv_point{ unif (rng), unif (rng), unif (rng) }; }
+        jcv_diagram diagram;
+        morph::voronoi_generate (np, points.data(), nullptr, arena, &diagram, 4);
+        std::size_t cap_first = arena.capacity();
+        morph::voronoi_generate (np, points.data(), nullptr, arena, &diagram, 1);
+        if (diagram.numsites != np) { --rtn; }
+        if (arena.capacity() != cap_first) {
+            std::cout << "Arena grew on a same-sized regeneration" << std::endl;
+            --rtn;
+        }
+    }
+    std::cout << "Arena capacity finally: " << arena.capacity() << " bytes" << std::endl;
+
+    std::cout << (rtn == 0 ? "Test success" : "Test failed") << std::endl;
+    return rtn;
+}
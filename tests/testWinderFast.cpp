@@ -0,0 +1,87 @@
+/*
+ * Test morph::Winder's preprocessed crossing-number path (wind_fast/wind_batch). For a
+ * star-shaped boundary r(theta), a point's insideness is known analytically, so wind_fast can
+ * be checked against ground truth (the angle-accumulating wind() is only reliable for
+ * anti-clockwise paths with small per-segment angle steps, so it is compared on a square).
+ */
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include "morph/Winder.h"
+#include "morph/vec.h"
+#include "morph/vvec.h"
+#include "morph/Random.h"
+#include "morph/mathconst.h"
+
+int main()
+{
+    int rtn = 0;
+
+    // A wiggly, star-like closed boundary, anti-clockwise
+    auto bradius = [](float theta) { return 1.0f + 0.4f * std::sin (7.0f * theta); };
+    std::vector<morph::vec<float, 2>> boundary;
+    constexpr int nb = 257;
+    for (int i = 0; i < nb; ++i) {
+        float theta = morph::mathconst<float>::two_pi * i / nb;
+        boundary.push_back ({ bradius (theta) * std::cos (theta), bradius (theta) * std::sin (theta) });
+    }
+    boundary.push_back (boundary.front());
+
+    morph::Winder w (boundary);
+
+    // Random query points, some inside, some outside, some beyond the bounding box
+    morph::RandUniform<float> rng (-2.5f, 2.5f, 4000);
+    morph::vvec<morph::vec<float, 2>> queries (3000);
+    for (auto& q : queries) { q = { rng.get(), rng.get() }; }
+
+    std::vector<int> wns = w.wind_batch (queries);
+    for (std::size_t i = 0; i < queries.size(); ++i) {
+        float qr = queries[i].length();
+        float br = bradius (std::atan2 (queries[i][1], queries[i][0]));
+        if (std::abs (qr - br) < 0.08f) { continue; } // too close to the boundary to judge
+        int expected = qr < br ? 1 : 0;
+        if (wns[i] != expected || w.wind_fast (queries[i]) != expected) {
+            std::cout << "Winding number wrong at " << queries[i]
+                      << ": " << wns[i] << " vs expected " << expected << std::endl;
+            --rtn;
+            break;
+        }
+    }
+
+    // On an anti-clockwise square, wind_fast should agree with the original wind()
+    std::vector<morph::vec<float, 2>> ccwsquare = {
+        {0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}, {0.0f, 0.0f}
+    };
+    morph::Winder wccw (ccwsquare);
+    for (morph::vec<float, 2> q : { morph::vec<float, 2>{0.5f, 0.5f}, morph::vec<float, 2>{0.9f, 0.1f},
+                                    morph::vec<float, 2>{0.1f, 0.8f} }) {
+        if (wccw.wind_fast (q) != wccw.wind (q)) {
+            std::cout << "wind_fast disagrees with wind at " << q << std::endl;
+            --rtn;
+        }
+    }
+    for (morph::vec<float, 2> q : { morph::vec<float, 2>{1.5f, 0.5f}, morph::vec<float, 2>{-0.2f, 0.5f} }) {
+        if (wccw.wind_fast (q) != 0) {
+            std::cout << "Outside point has non-zero winding number at " << q << std::endl;
+            --rtn;
+        }
+    }
+
+    // A clockwise boundary should give winding number -1 inside
+    std::vector<morph::vec<float, 2>> cwsquare = {
+        {0.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 1.0f}, {1.0f, 0.0f}, {0.0f, 0.0f}
+    };
+    morph::Winder wcw (cwsquare);
+    if (wcw.wind_fast (morph::vec<float, 2>{0.5f, 0.5f}) != -1) {
+        std::cout << "Clockwise winding number wrong" << std::endl;
+        --rtn;
+    }
+    if (wcw.wind_fast (morph::vec<float, 2>{1.5f, 0.5f}) != 0) {
+        std::cout << "Outside point has non-zero winding number" << std::endl;
+        --rtn;
+    }
+
+    std::cout << (rtn == 0 ? "Test success" : "Test failed") << std::endl;
+    return rtn;
+}
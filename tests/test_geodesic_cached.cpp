@@ -0,0 +1,46 @@
+/*
+ * Test morph::geometry::icosahedral_geodesic_cached against a fresh make_icosahedral_geodesic.
+ */
+
+#include <morph/geometry.h>
+#include <iostream>
+
+int main()
+{
+    int rtn = 0;
+
+    for (int iterations = 0; iterations < 4; ++iterations) {
+        const morph::geometry::icosahedral_geodesic<float>& cached =
+            morph::geometry::icosahedral_geodesic_cached<float> (iterations);
+        morph::geometry::icosahedral_geodesic<float> fresh =
+            morph::geometry::make_icosahedral_geodesic<float> (iterations);
+
+        morph::geometry::icosahedral_geodesic_info gi (iterations);
+        if (static_cast<int>(cached.poly.vertices.size()) != gi.n_vertices
+            || static_cast<int>(cached.poly.faces.size()) != gi.n_faces) {
+            std::cout << "Cached mesh has wrong size for iterations " << iterations << std::endl;
+            --rtn;
+        }
+        if (cached.poly.vertices != fresh.poly.vertices) {
+            std::cout << "Cached vertices differ for iterations " << iterations << std::endl;
+            --rtn;
+        }
+        if (cached.poly.faces != fresh.poly.faces) {
+            std::cout << "Cached faces differ for iterations " << iterations << std::endl;
+            --rtn;
+        }
+        if (cached.fivefold_vertices != fresh.fivefold_vertices) {
+            std::cout << "Cached fivefold vertices differ for iterations " << iterations << std::endl;
+            --rtn;
+        }
+
+        // A second request should return the same statically held object
+        if (&morph::geometry::icosahedral_geodesic_cached<float> (iterations) != &cached) {
+            std::cout << "Cache failed to return the same mesh for iterations " << iterations << std::endl;
+            --rtn;
+        }
+    }
+
+    std::cout << (rtn == 0 ? "Test success" : "Test failed") << std::endl;
+    return rtn;
+}
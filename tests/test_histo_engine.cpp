@@ -0,0 +1,60 @@
+/*
+ * Test morph::histo_engine against morph::histo, including chunked (streaming) addition of
+ * samples and the out-of-range counters.
+ */
+
+#include <morph/histo.h>
+#include <morph/Random.h>
+#include <iostream>
+
+int main()
+{
+    int rtn = 0;
+
+    // A largeish random dataset
+    morph::vvec<float> data (100000);
+    morph::RandUniform<float> rng (-2.0f, 3.0f, 3000);
+    for (auto& d : data) { d = rng.get(); }
+
+    constexpr std::size_t nbins = 32;
+    morph::range<float> r (-2.0f, 3.0f);
+    morph::histo<float, float> h (data, nbins, r);
+
+    // One-shot engine use should reproduce morph::histo exactly
+    morph::histo_engine<float, float> he (nbins, r);
+    he.add_samples (data);
+    morph::histo<float, float> hr = he.get();
+    if (hr.counts != h.counts) { std::cout << "counts mismatch\n"; --rtn; }
+    if (hr.bins != h.bins || hr.binedges != h.binedges || hr.binwidth != h.binwidth) {
+        std::cout << "bin locations mismatch\n"; --rtn;
+    }
+    if (hr.datacount != h.datacount || hr.proportions != h.proportions) {
+        std::cout << "datacount/proportions mismatch\n"; --rtn;
+    }
+    if (he.observed.min != data.min() || he.observed.max != data.max()) {
+        std::cout << "observed range mismatch\n"; --rtn;
+    }
+    if (he.underflow != 0u || he.overflow != 0u) { std::cout << "spurious out-of-range counts\n"; --rtn; }
+
+    // Streaming the same data in awkwardly sized chunks should give the same result
+    morph::histo_engine<float, float> hc (nbins, r);
+    std::size_t offs = 0u;
+    for (std::size_t chunk : { std::size_t{1}, std::size_t{17}, std::size_t{10000} }) {
+        hc.add_samples (data.data() + offs, chunk);
+        offs += chunk;
+    }
+    hc.add_samples (data.data() + offs, data.size() - offs);
+    if (hc.get().counts != h.counts) { std::cout << "chunked counts mismatch\n"; --rtn; }
+
+    // Out-of-range samples go into underflow/overflow, not the bins
+    morph::histo_engine<float, float> ho (nbins, r);
+    ho.add_samples (data);
+    morph::vvec<float> outliers = { -10.0f, -2.5f, 3.5f };
+    ho.add_samples (outliers);
+    if (ho.underflow != 2u || ho.overflow != 1u) { std::cout << "out-of-range counts wrong\n"; --rtn; }
+    if (ho.get().counts != h.counts) { std::cout << "outliers leaked into bins\n"; --rtn; }
+    if (ho.observed.min != -10.0f || ho.observed.max != 3.5f) { std::cout << "observed range missed outliers\n"; --rtn; }
+
+    if (rtn == 0) { std::cout << "Test SUCCESS\n"; } else { std::cout << "Test FAIL\n"; }
+    return rtn;
+}
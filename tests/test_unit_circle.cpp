@@ -0,0 +1,46 @@
+/*
+ * Test the compile-time trig tables in morph::math::unit_circle against libm.
+ */
+
+#include <morph/constexpr_math.h>
+#include <morph/mathconst.h>
+#include <iostream>
+#include <cmath>
+
+// The tables are usable in constant expressions
+static_assert (morph::math::unit_circle<double, 12>::sines[0] == 0.0);
+static_assert (morph::math::unit_circle<double, 12>::cosines[0] == 1.0);
+static_assert (morph::math::unit_circle<double, 12>::sines[3] == 1.0);  // sin(pi/2)
+static_assert (morph::math::unit_circle<float, 8>::sines.size() == 8u);
+
+template <typename T, int N>
+int check_table (const double tol)
+{
+    int rtn = 0;
+    for (int j = 0; j < N; ++j) {
+        double t = static_cast<double>(j) * morph::mathconst<double>::two_pi / N;
+        double es = std::sin (t);
+        double ec = std::cos (t);
+        if (std::abs (static_cast<double>(morph::math::unit_circle<T, N>::sines[j]) - es) > tol
+            || std::abs (static_cast<double>(morph::math::unit_circle<T, N>::cosines[j]) - ec) > tol) {
+            std::cout << "Table entry " << j << " of " << N << " out of tolerance" << std::endl;
+            --rtn;
+        }
+    }
+    return rtn;
+}
+
+int main()
+{
+    int rtn = 0;
+
+    rtn += check_table<double, 12> (1e-12);
+    rtn += check_table<double, 128> (1e-12);
+    rtn += check_table<float, 8> (1e-6);
+    rtn += check_table<float, 12> (1e-6);
+    rtn += check_table<float, 128> (1e-6);
+    rtn += check_table<float, 60> (1e-6); // a non-standard count, as user code might request
+
+    std::cout << (rtn == 0 ? "Test success" : "Test failed") << std::endl;
+    return rtn;
+}
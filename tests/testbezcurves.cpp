@@ -49,5 +49,29 @@ int main()
         rtn = 0;
     }
 
+    // Arc-length LUT. Bulk samples evenly spaced in arc length should run from the
+    // start of the curve to its end, and their polyline length should be close to
+    // (and not more than) the curve's arc length.
+    float clen = cc3.arcLength();
+    morph::vec<float, 2> samples[11];
+    cc3.computePointsAtLengths (samples, 11);
+    if (samples[0] != cc3.computePoint (0.0f).coord || samples[10] != cc3.computePoint (1.0f).coord) {
+        cout << "Bulk sample endpoints wrong" << endl;
+        rtn -= 1;
+    }
+    float slen = 0.0f;
+    for (int si = 1; si < 11; ++si) { slen += (samples[si] - samples[si-1]).length(); }
+    cout << "Curve length " << clen << "; 10 segment polyline length " << slen << endl;
+    if (slen > clen || slen < 0.98f * clen) {
+        cout << "Polyline length should be slightly less than the arc length" << endl;
+        rtn -= 1;
+    }
+    // The point half way along the curve (by arc length) has t inside (0,1)
+    BezCoord<float> half = cc3.computePointAtLength (clen/2.0f);
+    if (half.t() <= 0.0f || half.t() >= 1.0f) {
+        cout << "Bad t for half-way point: " << half.t() << endl;
+        rtn -= 1;
+    }
+
     return rtn;
 }
@@ -70,6 +70,31 @@ int main()
     morph::range<double> r = non_sig_diffs.minmax();
     std::cout << "Range of significance levels for non different distributions was " << r << std::endl;
 
+    // Test the parallel resampling engine. It should agree statistically with the serial
+    // engine, and be deterministic for a given seed, however many threads run it.
+    double eom_par = morph::bootstrap<double>::error_of_mean_par (normally_distributed, 100000, 0xb001u);
+    double eom_par2 = morph::bootstrap<double>::error_of_mean_par (normally_distributed, 100000, 0xb001u);
+    std::cout << "Parallel error_of_mean: " << eom_par
+              << " cf. expectation " << (normally_distributed.std()/std::sqrt(normally_distributed.size())) << std::endl;
+    if (eom_par != eom_par2) {
+        std::cerr << "The parallel engine is not deterministic for a fixed seed\n";
+        --rtn;
+    }
+    if (std::abs (eom_par - normally_distributed.std()/std::sqrt(normally_distributed.size())) > 0.005) {
+        std::cerr << "Test of error_of_mean_par failed\n";
+        --rtn;
+    }
+
+    morph::RandNormal<double, std::mt19937_64> rnorm_sigdiff (5.5, 1);
+    morph::vvec<double> dist_sigdiff;
+    dist_sigdiff.set_from (rnorm_sigdiff.get(num_samples));
+    morph::vec<double,2> asl_par = morph::bootstrap<double>::ttest_equalityofmeans_par (normally_distributed, dist_sigdiff, num_bootstraps);
+    std::cout << "Parallel ASL for different dist: " << asl_par[0] << " (with minasl: " << asl_par[1] << ")\n";
+    if (asl_par[0] > asl_par[1]) {
+        std::cerr << "ttest_equalityofmeans_par gave ASL = " << asl_par[0] << " for distributions with different means - TOO BIG.\n";
+        --rtn;
+    }
+
     // Statistical variability seems to allow quite a few unexpected results. Pass the
     // test as long as we have less than 10% fails in both types of test
     if (sig_diff_fails < 10 && not_sig_diff_fails < 10) {
@@ -0,0 +1,144 @@
+/*
+ * Test quaternion::slerp/slerp_batch and morph::CameraPath: slerp must hit its
+ * endpoints, follow the shorter arc and agree with the batch version; a compiled
+ * camera path must reproduce its keyframe poses and interpolate smoothly between
+ * them, wrapping when asked to loop.
+ */
+
+#include <morph/quaternion.h>
+#include <morph/CameraPath.h>
+#include <morph/vec.h>
+#include <morph/mathconst.h>
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+// The absolute angle (radians) between two unit quaternions
+static float quat_angle (const morph::quaternion<float>& a, const morph::quaternion<float>& b)
+{
+    float d = std::abs (a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z);
+    return 2.0f * std::acos (std::min (d, 1.0f));
+}
+
+// Component-wise comparison (up to sign, as q and -q are the same rotation). More
+// precise than quat_angle for near-identical quaternions, where acos is ill-conditioned
+static bool quat_close (const morph::quaternion<float>& a, const morph::quaternion<float>& b, const float tol)
+{
+    float sgn = (a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z) < 0.0f ? -1.0f : 1.0f;
+    return std::abs (a.w - sgn * b.w) < tol && std::abs (a.x - sgn * b.x) < tol
+        && std::abs (a.y - sgn * b.y) < tol && std::abs (a.z - sgn * b.z) < tol;
+}
+
+int main()
+{
+    int rtn = 0;
+
+    using mc = morph::mathconst<float>;
+    const morph::vec<float, 3> zaxis = { 0.0f, 0.0f, 1.0f };
+
+    // slerp endpoints and midpoint for a 90 degree rotation about z
+    {
+        morph::quaternion<float> qa; // identity
+        morph::quaternion<float> qb (zaxis, mc::pi_over_2);
+        if (quat_close (qa.slerp (qb, 0.0f), qa, 1e-6f) == false) { std::cout << "slerp(0) != start\n"; --rtn; }
+        if (quat_close (qa.slerp (qb, 1.0f), qb, 1e-6f) == false) { std::cout << "slerp(1) != end\n"; --rtn; }
+        morph::quaternion<float> qmid (zaxis, mc::pi_over_4);
+        if (quat_close (qa.slerp (qb, 0.5f), qmid, 1e-5f) == false) { std::cout << "slerp(0.5) wrong\n"; --rtn; }
+        // Constant angular velocity: equal steps in u are equal angles
+        float a1 = quat_angle (qa.slerp (qb, 0.25f), qa.slerp (qb, 0.5f));
+        float a2 = quat_angle (qa.slerp (qb, 0.5f), qa.slerp (qb, 0.75f));
+        if (std::abs (a1 - a2) > 1e-5f) { std::cout << "slerp angular velocity not constant\n"; --rtn; }
+    }
+
+    // The shorter arc: 350 degrees one way is 10 degrees the other
+    {
+        morph::quaternion<float> qa;
+        morph::quaternion<float> qb (zaxis, 350.0f * mc::deg2rad);
+        if (quat_angle (qa, qa.slerp (qb, 0.5f)) > 6.0f * mc::deg2rad) {
+            std::cout << "slerp took the long way round\n";
+            --rtn;
+        }
+    }
+
+    // Nearly parallel quaternions must not blow up
+    {
+        morph::quaternion<float> qa;
+        morph::quaternion<float> qb (zaxis, 1e-7f);
+        morph::quaternion<float> qm = qa.slerp (qb, 0.5f);
+        if (std::abs (qm.norm() - 1.0f) > 1e-5f) { std::cout << "parallel slerp not unit\n"; --rtn; }
+    }
+
+    // slerp_batch agrees with pointwise slerp
+    {
+        morph::quaternion<float> qa (morph::vec<float, 3>({ 1.0f, 0.0f, 0.0f }), 0.3f);
+        morph::quaternion<float> qb (morph::vec<float, 3>({ 0.0f, 1.0f, 0.0f }), 2.1f);
+        std::vector<morph::quaternion<float>> table (33);
+        qa.slerp_batch (qb, table);
+        for (std::size_t i = 0; i < table.size(); ++i) {
+            float u = static_cast<float>(i) / static_cast<float>(table.size() - 1u);
+            if (quat_close (table[i], qa.slerp (qb, u), 1e-5f) == false) {
+                std::cout << "slerp_batch[" << i << "] disagrees with slerp\n";
+                --rtn;
+                break;
+            }
+        }
+    }
+
+    // A camera path through three keyframes
+    {
+        morph::CameraPath cp;
+        morph::quaternion<float> q0;
+        morph::quaternion<float> q1 (zaxis, mc::pi_over_2);
+        morph::quaternion<float> q2 (zaxis, mc::pi);
+        cp.addKeyframe (0.0f, q0, { 0.0f, 0.0f, -5.0f });
+        cp.addKeyframe (2.0f, q1, { 1.0f, 0.0f, -5.0f });
+        cp.addKeyframe (4.0f, q2, { 1.0f, 1.0f, -5.0f });
+        if (cp.duration() != 4.0f) { std::cout << "duration wrong\n"; --rtn; }
+        cp.compile (100);
+        if (cp.compiled() == false) { std::cout << "not compiled\n"; --rtn; }
+
+        morph::quaternion<float> rotn;
+        morph::vec<float, 3> trans;
+        // Keyframe poses are reproduced
+        cp.eval (0.0f, rotn, trans);
+        if (quat_angle (rotn, q0) > 1e-4f || (trans - morph::vec<float, 3>({ 0, 0, -5 })).length() > 1e-4f) {
+            std::cout << "keyframe 0 not reproduced\n";
+            --rtn;
+        }
+        cp.eval (2.0f, rotn, trans);
+        if (quat_angle (rotn, q1) > 1e-3f || (trans - morph::vec<float, 3>({ 1, 0, -5 })).length() > 1e-3f) {
+            std::cout << "keyframe 1 not reproduced\n";
+            --rtn;
+        }
+        cp.eval (4.0f, rotn, trans);
+        if (quat_angle (rotn, q2) > 1e-3f) { std::cout << "keyframe 2 not reproduced\n"; --rtn; }
+        // Halfway through the first segment: about 45 degrees of rotation
+        cp.eval (1.0f, rotn, trans);
+        if (std::abs (quat_angle (rotn, q0) - mc::pi_over_4) > 0.02f) {
+            std::cout << "mid-segment rotation wrong\n";
+            --rtn;
+        }
+        // Past the end: clamped without wrap, wrapped with
+        cp.eval (5.0f, rotn, trans);
+        if (quat_angle (rotn, q2) > 1e-3f) { std::cout << "clamp past end failed\n"; --rtn; }
+        cp.eval (5.0f, rotn, trans, true);
+        if (quat_angle (rotn, q2) < 0.1f) { std::cout << "wrap past end failed\n"; --rtn; }
+    }
+
+    // Error cases
+    {
+        morph::CameraPath cp;
+        bool threw = false;
+        try { cp.compile(); } catch (const std::runtime_error&) { threw = true; }
+        if (threw == false) { std::cout << "compile with no keyframes should throw\n"; --rtn; }
+        cp.addKeyframe (0.0f, morph::quaternion<float>(), { 0, 0, -5 });
+        morph::quaternion<float> rotn;
+        morph::vec<float, 3> trans;
+        threw = false;
+        try { cp.eval (0.0f, rotn, trans); } catch (const std::runtime_error&) { threw = true; }
+        if (threw == false) { std::cout << "eval before compile should throw\n"; --rtn; }
+    }
+
+    std::cout << (rtn == 0 ? "Test success" : "Test failed") << std::endl;
+    return rtn;
+}
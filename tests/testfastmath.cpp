@@ -0,0 +1,141 @@
+/*
+ * Test the vectorized transcendental kernels in morph/fastmath.h against libm, and the
+ * precision-policy knob on vvec's exp/log/sin/tanh.
+ */
+
+#include <iostream>
+#include <cmath>
+#include <morph/fastmath.h>
+#include <morph/vvec.h>
+#include <morph/nn/FeedForwardNet.h>
+
+//! Max |fast - exact| / max(|exact|, 1) of fn over n points spanning [lo, hi]
+template <typename S, typename FastFn, typename ExactFn>
+double max_err (FastFn fast, ExactFn exact, const double lo, const double hi, const std::size_t n)
+{
+    morph::vvec<S> x;
+    x.linspace (static_cast<S>(lo), static_cast<S>(hi), n);
+    morph::vvec<S> y (n, S{0});
+    fast (x.data(), y.data(), n);
+    double worst = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const double ref = exact (static_cast<double>(x[i]));
+        const double denom = std::abs (ref) > 1.0 ? std::abs (ref) : 1.0;
+        const double err = std::abs (static_cast<double>(y[i]) - ref) / denom;
+        worst = err > worst ? err : worst;
+    }
+    return worst;
+}
+
+template <typename S>
+int check_kernels (const double tol_exp, const double tol_log, const double tol_sin, const double tol_tanh)
+{
+    // sigmoid is built on the exp kernel, so it shares exp's tolerance
+    const double tol_sig = tol_exp;
+    int rtn = 0;
+    constexpr std::size_t n = 100001;
+    const double expmax = std::is_same_v<S, float> ? 80.0 : 690.0;
+
+    double e = max_err<S> (morph::fastmath::exp<S>, [](double v){ return std::exp(v); }, -expmax, expmax, n);
+    std::cout << "exp err: " << e << std::endl;
+    if (e > tol_exp) { std::cerr << "fast exp error " << e << " > " << tol_exp << std::endl; rtn -= 1; }
+
+    e = max_err<S> (morph::fastmath::log<S>, [](double v){ return std::log(v); }, 1e-20, 1e20, n);
+    std::cout << "log err: " << e << std::endl;
+    if (e > tol_log) { std::cerr << "fast log error " << e << " > " << tol_log << std::endl; rtn -= 1; }
+
+    e = max_err<S> (morph::fastmath::sin<S>, [](double v){ return std::sin(v); }, -100.0, 100.0, n);
+    std::cout << "sin err: " << e << std::endl;
+    if (e > tol_sin) { std::cerr << "fast sin error " << e << " > " << tol_sin << std::endl; rtn -= 1; }
+
+    e = max_err<S> (morph::fastmath::tanh<S>, [](double v){ return std::tanh(v); }, -20.0, 20.0, n);
+    std::cout << "tanh err: " << e << std::endl;
+    if (e > tol_tanh) { std::cerr << "fast tanh error " << e << " > " << tol_tanh << std::endl; rtn -= 1; }
+
+    e = max_err<S> (morph::fastmath::sigmoid<S>, [](double v){ return 1.0 / (1.0 + std::exp(-v)); }, -30.0, 30.0, n);
+    std::cout << "sigmoid err: " << e << std::endl;
+    if (e > tol_sig) { std::cerr << "fast sigmoid error " << e << " > " << tol_sig << std::endl; rtn -= 1; }
+
+    return rtn;
+}
+
+int main()
+{
+    int rtn = 0;
+
+    std::cout << "float kernels:" << std::endl;
+    rtn += check_kernels<float> (4e-7, 4e-7, 2e-6, 4e-7);
+    std::cout << "double kernels:" << std::endl;
+    rtn += check_kernels<double> (2e-14, 2e-14, 1e-11, 2e-14);
+
+    // The vvec methods: default policy still matches libm exactly; fast policy
+    // matches the kernels exactly
+    morph::vvec<double> v;
+    v.linspace (-5.0, 5.0, 1001);
+    morph::vvec<double> ex = v.exp();
+    morph::vvec<double> exf = v.exp<morph::mathprec::fast>();
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        if (ex[i] != std::exp (v[i])) {
+            std::cerr << "default-policy exp no longer matches std::exp" << std::endl;
+            rtn -= 1;
+            break;
+        }
+    }
+    morph::vvec<double> exf2 (v.size(), 0.0);
+    morph::fastmath::exp (v.data(), exf2.data(), v.size());
+    if (exf != exf2) {
+        std::cerr << "vvec fast exp disagrees with the fastmath kernel" << std::endl;
+        rtn -= 1;
+    }
+
+    // tanh is new to vvec; the in-place fast version must match the returning one
+    morph::vvec<float> t;
+    t.linspace (-4.0f, 4.0f, 501);
+    morph::vvec<float> th = t.tanh<morph::mathprec::fast>();
+    t.tanh_inplace<morph::mathprec::fast>();
+    if (t != th) {
+        std::cerr << "tanh_inplace disagrees with tanh" << std::endl;
+        rtn -= 1;
+    }
+    for (std::size_t i = 0; i < t.size(); ++i) {
+        if (t[i] < -1.0f || t[i] > 1.0f) {
+            std::cerr << "fast tanh left [-1,1]" << std::endl;
+            rtn -= 1;
+            break;
+        }
+    }
+
+    // A fast-policy FeedForwardNet must produce the same activations as the exact
+    // one to within the sigmoid kernel's tolerance
+    {
+        morph::nn::FeedForwardNet<float> ffe ({ 4, 8, 2 });
+        morph::nn::FeedForwardNet<float, morph::mathprec::fast> fff ({ 4, 8, 2 });
+        // Copy ffe's (randomized) weights into fff
+        auto ce = ffe.connections.begin();
+        for (auto& cf : fff.connections) {
+            cf.ws = ce->ws;
+            cf.b = ce->b;
+            ++ce;
+        }
+        morph::vvec<float> in = { 0.1f, -0.6f, 0.9f, 0.3f };
+        morph::vvec<float> desired = { 0.0f, 1.0f };
+        ffe.setInput (in, desired);
+        fff.setInput (in, desired);
+        ffe.feedforward();
+        fff.feedforward();
+        for (std::size_t j = 0; j < ffe.neurons.back().size(); ++j) {
+            if (std::abs (ffe.neurons.back()[j] - fff.neurons.back()[j]) > 1e-6f) {
+                std::cerr << "fast-policy FeedForwardNet output differs from exact" << std::endl;
+                rtn -= 1;
+                break;
+            }
+        }
+    }
+
+    if (rtn == 0) {
+        std::cout << "All tests passed" << std::endl;
+    } else {
+        std::cout << "Some tests failed" << std::endl;
+    }
+    return rtn;
+}
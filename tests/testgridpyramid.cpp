@@ -0,0 +1,115 @@
+/*
+ * Test morph::GridPyramid: level shapes and coordinates, 2x2 box-reduced values
+ * (including ragged edges on odd dimensions), incremental refresh_region against a full
+ * refresh, column-major ordering and the morton-order rejection.
+ */
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <morph/Grid.h>
+#include <morph/GridPyramid.h>
+
+int main()
+{
+    int rtn = 0;
+
+    // An 8x6 grid; data value = index
+    {
+        morph::Grid<unsigned int, float> g (8, 6, { 0.5f, 0.5f }, { -1.0f, -2.0f });
+        std::vector<float> data (g.n());
+        for (unsigned int i = 0; i < g.n(); ++i) { data[i] = static_cast<float>(i); }
+        morph::GridPyramid<float> py (&g, data);
+
+        // 8x6 -> 4x3 -> 2x2 -> 1x1
+        if (py.n_levels() != 4) { std::cerr << "Wrong number of levels" << std::endl; rtn -= 1; }
+        if (py.grid (1)->get_w() != 4 || py.grid (1)->get_h() != 3) {
+            std::cerr << "Level 1 has the wrong shape" << std::endl;
+            rtn -= 1;
+        }
+        if (py.grid (0) != &g || py.data (0).data() != data.data()) {
+            std::cerr << "Level 0 should reference the base grid and data" << std::endl;
+            rtn -= 1;
+        }
+
+        // Coarse cell (0,0) averages fine cells 0, 1, 8, 9
+        if (std::abs (py.data (1)[0] - (0.0f + 1.0f + 8.0f + 9.0f) / 4.0f) > 1e-6f) {
+            std::cerr << "Level 1 cell (0,0) has the wrong mean" << std::endl;
+            rtn -= 1;
+        }
+        // Coarse cell (2,1) averages fine cells (4,2),(5,2),(4,3),(5,3) = 20, 21, 28, 29
+        if (std::abs (py.data (1)[1 * 4 + 2] - (20.0f + 21.0f + 28.0f + 29.0f) / 4.0f) > 1e-6f) {
+            std::cerr << "Level 1 cell (2,1) has the wrong mean" << std::endl;
+            rtn -= 1;
+        }
+        // Each coarse pixel sits at the centroid of its 2x2 fine pixels
+        morph::vec<float, 2> expected_c = ((*py.grid (0))[0] + (*py.grid (0))[1]
+                                           + (*py.grid (0))[8] + (*py.grid (0))[9]) / 4.0f;
+        if (((*py.grid (1))[0] - expected_c).length() > 1e-6f) {
+            std::cerr << "Level 1 pixel (0,0) is not at the fine-pixel centroid" << std::endl;
+            rtn -= 1;
+        }
+
+        // Change one base pixel; refresh_region must match a full refresh
+        data[9] = 1000.0f;
+        py.refresh_region (1, 1, 1, 1);
+        std::vector<float> incremental (py.data (1).begin(), py.data (1).end());
+        std::vector<float> incremental2 (py.data (2).begin(), py.data (2).end());
+        py.refresh();
+        if (incremental != std::vector<float> (py.data (1).begin(), py.data (1).end())
+            || incremental2 != std::vector<float> (py.data (2).begin(), py.data (2).end())) {
+            std::cerr << "refresh_region disagrees with a full refresh" << std::endl;
+            rtn -= 1;
+        }
+    }
+
+    // Odd dimensions: a 5x5 grid reduces to 3x3, edge cells averaging fewer pixels
+    {
+        morph::Grid<unsigned int, float> g (5, 5);
+        std::vector<float> data (g.n(), 2.0f);
+        morph::GridPyramid<float> py (&g, data);
+        if (py.grid (1)->get_w() != 3 || py.grid (1)->get_h() != 3) {
+            std::cerr << "Odd-dimension level has the wrong shape" << std::endl;
+            rtn -= 1;
+        }
+        // Constant data stays constant at every level, whatever each cell covers
+        for (unsigned int l = 1; l < py.n_levels(); ++l) {
+            for (const float v : py.data (l)) {
+                if (std::abs (v - 2.0f) > 1e-6f) {
+                    std::cerr << "Constant field not preserved at level " << l << std::endl;
+                    rtn -= 1;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Column-major order: index = y + x * h
+    {
+        morph::Grid<unsigned int, float> g (4, 4, { 1.0f, 1.0f }, { 0.0f, 0.0f },
+                                            morph::GridDomainWrap::None,
+                                            morph::GridOrder::bottomleft_to_topright_colmaj);
+        std::vector<float> data (g.n());
+        for (unsigned int i = 0; i < g.n(); ++i) { data[i] = static_cast<float>(i); }
+        morph::GridPyramid<float> py (&g, data);
+        // Coarse cell (0,0): fine (0,0)=0, (0,1)=1, (1,0)=4, (1,1)=5
+        if (std::abs (py.data (1)[0] - (0.0f + 1.0f + 4.0f + 5.0f) / 4.0f) > 1e-6f) {
+            std::cerr << "Column-major reduction wrong" << std::endl;
+            rtn -= 1;
+        }
+    }
+
+    // Morton order is rejected
+    {
+        morph::Grid<unsigned int, float> g (4, 4, { 1.0f, 1.0f }, { 0.0f, 0.0f },
+                                            morph::GridDomainWrap::None, morph::GridOrder::morton);
+        std::vector<float> data (g.n(), 0.0f);
+        bool threw = false;
+        try {
+            morph::GridPyramid<float> py (&g, data);
+        } catch (const std::runtime_error&) { threw = true; }
+        if (threw == false) { std::cerr << "Morton order not rejected" << std::endl; rtn -= 1; }
+    }
+
+    std::cout << (rtn == 0 ? "Test success" : "Test failed") << std::endl;
+    return rtn;
+}
@@ -0,0 +1,62 @@
+// Test the extendable time-series dataset API: HdfData::append_row/read_rows
+#include "morph/HdfData.h"
+#include <morph/vvec.h>
+#include <iostream>
+#include <vector>
+#include <array>
+
+using namespace std;
+using morph::HdfData;
+
+int main()
+{
+    int rtn = 0;
+
+    constexpr size_t statesz = 5;
+    constexpr size_t nsteps = 100;
+
+    // Log a state vector per 'timestep' into one extendable dataset
+    {
+        HdfData data("test6.h5");
+        data.dataset_options.deflate_level = 1; // compression applies to appended rows too
+        morph::vvec<float> state (statesz);
+        for (size_t t = 0; t < nsteps; ++t) {
+            for (size_t i = 0; i < statesz; ++i) { state[i] = static_cast<float>(t * 10 + i); }
+            data.append_row ("/log/state", state);
+        }
+        // A second, integer time series in the same file
+        vector<int> counts = { 1, 2, 3 };
+        data.append_row ("/log/counts", counts);
+        data.append_row ("/log/counts", counts);
+    }
+
+    // Read back with read_rows (runtime shape)...
+    {
+        HdfData data("test6.h5", morph::FileAccess::ReadOnly);
+        vector<float> flat;
+        hsize_t nrows = 0, ncols = 0;
+        data.read_rows ("/log/state", flat, nrows, ncols);
+        if (nrows != nsteps || ncols != statesz) { cout << "shape fail\n"; rtn -= 1; }
+        for (size_t t = 0; t < nsteps && rtn == 0; ++t) {
+            for (size_t i = 0; i < statesz; ++i) {
+                if (flat[t * statesz + i] != static_cast<float>(t * 10 + i)) {
+                    cout << "value fail at row " << t << "\n"; rtn -= 1; break;
+                }
+            }
+        }
+        vector<int> iflat;
+        data.read_rows ("/log/counts", iflat, nrows, ncols);
+        if (nrows != 2 || ncols != 3 || iflat[5] != 3) { cout << "counts fail\n"; rtn -= 1; }
+    }
+
+    // ...and with read_contained_vals when the row size is known at compile time
+    {
+        HdfData data("test6.h5", morph::FileAccess::ReadOnly);
+        vector<array<float, statesz>> rows;
+        data.read_contained_vals ("/log/state", rows);
+        if (rows.size() != nsteps || rows[3][4] != 34.0f) { cout << "vecarray fail\n"; rtn -= 1; }
+    }
+
+    cout << "Returning " << rtn << endl;
+    return rtn;
+}
@@ -0,0 +1,56 @@
+// Test the background-thread writer, HdfDataAsync
+#include "morph/HdfDataAsync.h"
+#include <morph/vvec.h>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using morph::HdfData;
+using morph::HdfDataAsync;
+
+int main()
+{
+    int rtn = 0;
+
+    constexpr size_t fieldsz = 10000;
+    constexpr size_t nsteps = 50;
+
+    {
+        HdfDataAsync data("test7.h5");
+        // Checkpoint-style: hand off moved snapshots; the simulation thread keeps going
+        for (size_t t = 0; t < nsteps; ++t) {
+            morph::vvec<float> snapshot (fieldsz);
+            snapshot.set_from (static_cast<float>(t));
+            data.append_row ("/log/field", std::move (snapshot));
+        }
+        // A named dataset via the generic job interface
+        data.enqueue ([] (HdfData& d) { d.add_val ("/params/dt", 0.001); });
+        // And one via the add_contained_vals overload
+        data.add_contained_vals ("/final", morph::vvec<float>(3, 7.0f));
+        data.flush(); // all writes complete (and would rethrow any write error)
+        if (data.queued() != 0) { cout << "queue not empty after flush\n"; rtn -= 1; }
+    } // destructor joins the writer thread and closes the file
+
+    // Verify synchronously
+    {
+        HdfData data("test7.h5", morph::FileAccess::ReadOnly);
+        vector<float> flat;
+        hsize_t nrows = 0, ncols = 0;
+        data.read_rows ("/log/field", flat, nrows, ncols);
+        if (nrows != nsteps || ncols != fieldsz) { cout << "shape fail\n"; rtn -= 1; }
+        for (size_t t = 0; t < nsteps && rtn == 0; ++t) {
+            if (flat[t * fieldsz] != static_cast<float>(t) || flat[t * fieldsz + fieldsz - 1] != static_cast<float>(t)) {
+                cout << "row " << t << " fail\n"; rtn -= 1;
+            }
+        }
+        double dt = 0.0;
+        data.read_val ("/params/dt", dt);
+        if (dt != 0.001) { cout << "dt fail\n"; rtn -= 1; }
+        morph::vvec<float> fin;
+        data.read_contained_vals ("/final", fin);
+        if (fin.size() != 3 || fin[2] != 7.0f) { cout << "final fail\n"; rtn -= 1; }
+    }
+
+    cout << "Returning " << rtn << endl;
+    return rtn;
+}
@@ -0,0 +1,72 @@
+/*
+ * Test computeDistanceToBoundaryFast (multi-source propagation over the d_ vectors)
+ * against the all-pairs computeDistanceToBoundary on a circular boundary. The candidate
+ * relay is documented to be accurate to within a fraction of the hex spacing d, so the
+ * fields must agree to better than d/2 everywhere (and never undershoot).
+ */
+
+#include "morph/HexGrid.h"
+#include <iostream>
+#include <cmath>
+#include <vector>
+
+int main()
+{
+    int rtn = 0;
+
+    morph::HexGrid hg (0.02f, 3.0f, 0.0f);
+    hg.setCircularBoundary (0.8f);
+    std::cout << "Number of hexes in grid: " << hg.num() << std::endl;
+
+    // Reference: the all-pairs computation, into the hexes
+    hg.computeDistanceToBoundary();
+    std::vector<float> ref (hg.num(), 0.0f);
+    for (auto& h : hg.hexen) { ref[h.di] = h.distToBoundary; }
+
+    // The propagation-based computation fills d_distToBoundary and the hexes
+    hg.computeDistanceToBoundaryFast();
+
+    if (hg.d_distToBoundary.size() != ref.size()) {
+        std::cerr << "d_distToBoundary has the wrong size" << std::endl;
+        return -1;
+    }
+
+    float maxerr = 0.0f;
+    for (unsigned int i = 0; i < ref.size(); ++i) {
+        float err = hg.d_distToBoundary[i] - ref[i];
+        if (err < -1e-6f) {
+            // The fast field is a min over a subset of the boundary hexes, so it can
+            // never be less than the all-pairs minimum
+            std::cerr << "fast distance undershoots the all-pairs minimum at hex " << i << std::endl;
+            rtn -= 1;
+            break;
+        }
+        maxerr = err > maxerr ? err : maxerr;
+    }
+    std::cout << "Max (fast - all-pairs) over " << ref.size() << " hexes: " << maxerr << std::endl;
+    if (maxerr > 0.5f * hg.getd()) {
+        std::cerr << "fast distance field disagrees with computeDistanceToBoundary by more than d/2" << std::endl;
+        rtn -= 1;
+    }
+
+    // Boundary hexes are at distance 0 and the hexen copies match the d_ vector
+    for (auto& h : hg.hexen) {
+        if (h.boundaryHex() && h.distToBoundary != 0.0f) {
+            std::cerr << "boundary hex " << h.vi << " has nonzero distance" << std::endl;
+            rtn -= 1;
+            break;
+        }
+        if (h.distToBoundary != hg.d_distToBoundary[h.di]) {
+            std::cerr << "hex " << h.vi << " disagrees with d_distToBoundary" << std::endl;
+            rtn -= 1;
+            break;
+        }
+    }
+
+    if (rtn == 0) {
+        std::cout << "All tests passed" << std::endl;
+    } else {
+        std::cout << "Some tests failed" << std::endl;
+    }
+    return rtn;
+}
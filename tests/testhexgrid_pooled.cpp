@@ -0,0 +1,67 @@
+/*
+ * Test pooled Hex storage. This translation unit is compiled with MORPH_POOLED_HEXEN
+ * (see CMakeLists.txt), so HexGrid::hexen is a morph::hexlist backed by
+ * morph::chunk_allocator: list nodes come from contiguous chunks instead of one heap
+ * allocation per hex. Grid construction, boundary setting (which erases many hexes,
+ * exercising the free list) and neighbour iteration must behave exactly as for the
+ * default allocator.
+ */
+
+#include <iostream>
+#include <list>
+#include <morph/HexGrid.h>
+
+int main()
+{
+    int rtn = 0;
+
+    morph::HexGrid hg (0.02f, 2.0f, 0.0f);
+    hg.setCircularBoundary (0.5f);
+    std::cout << "Grid of " << hg.num() << " hexes after setCircularBoundary\n";
+
+    if (hg.num() != hg.hexen.size() || hg.num() != hg.d_x.size()) {
+        std::cerr << "num()/hexen/d_x size mismatch" << std::endl;
+        rtn -= 1;
+    }
+
+    // Neighbour iterators must agree with the d_ index vectors
+    for (auto hi = hg.hexen.begin(); hi != hg.hexen.end(); ++hi) {
+        if (hi->has_ne() != (hg.d_ne[hi->di] > -1)) {
+            std::cerr << "has_ne() disagrees with d_ne at hex " << hi->vi << std::endl;
+            rtn -= 1;
+            break;
+        }
+        if (hi->has_ne() && hi->ne->di != static_cast<unsigned int>(hg.d_ne[hi->di])) {
+            std::cerr << "ne iterator disagrees with d_ne at hex " << hi->vi << std::endl;
+            rtn -= 1;
+            break;
+        }
+    }
+
+    // The chunk_allocator itself: lists sharing a pool, erase/reuse via the free list
+    morph::chunk_allocator<int> ca;
+    {
+        std::list<int, morph::chunk_allocator<int>> li (ca);
+        for (int i = 0; i < 10000; ++i) { li.push_back (i); }
+        std::size_t cap_full = ca.capacity_bytes();
+        if (cap_full == 0u) {
+            std::cerr << "chunk_allocator obtained no chunk storage" << std::endl;
+            rtn -= 1;
+        }
+        li.erase (li.begin(), std::next (li.begin(), 5000));
+        for (int i = 0; i < 5000; ++i) { li.push_back (i); }
+        if (ca.capacity_bytes() != cap_full) {
+            std::cerr << "freed nodes were not reused from the free list" << std::endl;
+            rtn -= 1;
+        }
+        long sum = 0;
+        for (int i : li) { sum += i; }
+        if (li.size() != 10000u || sum == 0) {
+            std::cerr << "list contents wrong after erase/refill" << std::endl;
+            rtn -= 1;
+        }
+    }
+
+    std::cout << "rtn: " << rtn << std::endl;
+    return rtn;
+}
@@ -0,0 +1,81 @@
+/*
+ * Test structure-of-arrays HexGrid construction (hexgridbuild::soa): the d_ vectors must match
+ * those produced by the original std::list<Hex> based construction, and lazy materialization of
+ * hexen must permit the usual boundary-setting methods.
+ */
+
+#include <iostream>
+#include <morph/HexGrid.h>
+
+int main()
+{
+    int rtn = 0;
+
+    // Classic list-based construction; populate_d_vectors to fill the d_ arrays
+    morph::HexGrid hg_list (0.02f, 1.0f, 0.0f);
+    hg_list.populate_d_vectors();
+
+    // Structure-of-arrays construction fills the d_ arrays directly
+    morph::HexGrid hg_soa (0.02f, 1.0f, 0.0f, morph::hexgridbuild::soa);
+
+    std::cout << "list build: " << hg_list.num() << " hexes; soa build: " << hg_soa.num() << " hexes\n";
+    if (hg_list.num() != hg_soa.num()) {
+        std::cerr << "Hex counts differ between construction modes" << std::endl;
+        rtn -= 1;
+    }
+
+    if (hg_soa.d_ri != hg_list.d_ri || hg_soa.d_gi != hg_list.d_gi || hg_soa.d_bi != hg_list.d_bi) {
+        std::cerr << "d_ri/d_gi/d_bi differ between construction modes" << std::endl;
+        rtn -= 1;
+    }
+    if (hg_soa.d_x != hg_list.d_x || hg_soa.d_y != hg_list.d_y) {
+        std::cerr << "d_x/d_y differ between construction modes" << std::endl;
+        rtn -= 1;
+    }
+    if (hg_soa.d_ne != hg_list.d_ne || hg_soa.d_nne != hg_list.d_nne || hg_soa.d_nnw != hg_list.d_nnw
+        || hg_soa.d_nw != hg_list.d_nw || hg_soa.d_nsw != hg_list.d_nsw || hg_soa.d_nse != hg_list.d_nse) {
+        std::cerr << "Neighbour index vectors differ between construction modes" << std::endl;
+        rtn -= 1;
+    }
+    if (hg_soa.d_flags != hg_list.d_flags) {
+        std::cerr << "d_flags differ between construction modes" << std::endl;
+        rtn -= 1;
+    }
+
+    // Setting a boundary must work on the soa-built grid (hexen is materialized lazily) and
+    // produce the same domain as on the list-built grid
+    hg_list.setCircularBoundary (0.3f);
+    hg_soa.setCircularBoundary (0.3f);
+    std::cout << "after boundary, list build: " << hg_list.num() << " hexes; soa build: " << hg_soa.num() << " hexes\n";
+    if (hg_list.num() != hg_soa.num()) {
+        std::cerr << "Hex counts differ after setCircularBoundary" << std::endl;
+        rtn -= 1;
+    }
+    if (hg_soa.d_ri != hg_list.d_ri || hg_soa.d_gi != hg_list.d_gi
+        || hg_soa.d_x != hg_list.d_x || hg_soa.d_y != hg_list.d_y
+        || hg_soa.d_ne != hg_list.d_ne || hg_soa.d_nsw != hg_list.d_nsw) {
+        std::cerr << "d_ vectors differ after setCircularBoundary" << std::endl;
+        rtn -= 1;
+    }
+
+    // Explicit materialization on a fresh soa grid should give a usable hexen list
+    morph::HexGrid hg_soa2 (0.05f, 0.6f, 0.0f, morph::hexgridbuild::soa);
+    unsigned int n_before = hg_soa2.num();
+    hg_soa2.materialize_hexen();
+    if (hg_soa2.hexen.size() != n_before) {
+        std::cerr << "materialize_hexen produced wrong number of hexes" << std::endl;
+        rtn -= 1;
+    }
+    // The central hex has all 6 neighbours
+    if (hg_soa2.hexen.begin()->getFlags() != HEX_HAS_NEIGHB_ALL) {
+        std::cerr << "central hex should have all neighbours after materialize_hexen" << std::endl;
+        rtn -= 1;
+    }
+
+    if (rtn == 0) {
+        std::cout << "All tests passed" << std::endl;
+    } else {
+        std::cout << "Some tests failed" << std::endl;
+    }
+    return rtn;
+}
@@ -0,0 +1,112 @@
+/*
+ * Test morph::kdtree: nearest, ball and box queries must agree exactly with linear
+ * scans over the same point cloud, for large random clouds, tiny clouds and the
+ * empty tree, in both 2 and 3 dimensions.
+ */
+
+#include <morph/kdtree.h>
+#include <morph/vec.h>
+#include <morph/Random.h>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+// Compare kdtree query results with linear scans for a cloud of n random points
+template <std::size_t N>
+int check_cloud (const std::size_t n, const unsigned int seed)
+{
+    int rtn = 0;
+
+    morph::RandUniform<float> rng (0.0f, 1.0f, seed);
+    std::vector<morph::vec<float, N>> points (n);
+    for (auto& p : points) { for (std::size_t d = 0; d < N; ++d) { p[d] = rng.get(); } }
+
+    morph::kdtree<float, N> tree (points);
+    if (tree.size() != n) { std::cout << "tree.size() wrong\n"; --rtn; }
+
+    for (unsigned int q = 0; q < 100; ++q) {
+        morph::vec<float, N> query;
+        for (std::size_t d = 0; d < N; ++d) { query[d] = rng.get() * 1.4f - 0.2f; } // some queries outside the cloud
+
+        // nearest() against a scan
+        std::size_t lin_best = 0;
+        float lin_sq = std::numeric_limits<float>::max();
+        for (std::size_t i = 0; i < n; ++i) {
+            float d_sq = (points[i] - query).length_sq();
+            if (d_sq < lin_sq) { lin_sq = d_sq; lin_best = i; }
+        }
+        float dist = 0.0f;
+        std::size_t got = tree.nearest (query, &dist);
+        if (got != lin_best || std::abs (dist - std::sqrt (lin_sq)) > 1e-6f) {
+            std::cout << "nearest() disagrees with the scan\n";
+            --rtn;
+        }
+
+        // within_ball() against a scan
+        const float radius = 0.1f;
+        std::vector<std::size_t> lin_ball;
+        for (std::size_t i = 0; i < n; ++i) {
+            if ((points[i] - query).length_sq() <= radius * radius) { lin_ball.push_back (i); }
+        }
+        std::vector<std::size_t> got_ball = tree.within_ball (query, radius);
+        std::sort (got_ball.begin(), got_ball.end());
+        if (got_ball != lin_ball) { std::cout << "within_ball() disagrees with the scan\n"; --rtn; }
+
+        // within_box() against a scan
+        morph::vec<float, N> lo = query;
+        morph::vec<float, N> hi = query;
+        for (std::size_t d = 0; d < N; ++d) { hi[d] += 0.15f; }
+        std::vector<std::size_t> lin_box;
+        for (std::size_t i = 0; i < n; ++i) {
+            bool in = true;
+            for (std::size_t d = 0; d < N; ++d) { in = in && points[i][d] >= lo[d] && points[i][d] <= hi[d]; }
+            if (in) { lin_box.push_back (i); }
+        }
+        std::vector<std::size_t> got_box = tree.within_box (lo, hi);
+        std::sort (got_box.begin(), got_box.end());
+        if (got_box != lin_box) { std::cout << "within_box() disagrees with the scan\n"; --rtn; }
+    }
+
+    return rtn;
+}
+
+int main()
+{
+    int rtn = 0;
+
+    // A cloud large enough to exercise the parallel build, and small clouds down to
+    // single-leaf and single-point trees
+    rtn += check_cloud<3> (20000, 100);
+    rtn += check_cloud<3> (9, 200); // just over one leaf
+    rtn += check_cloud<3> (1, 300);
+    rtn += check_cloud<2> (5000, 400);
+
+    // The empty tree
+    {
+        std::vector<morph::vec<float, 3>> nopoints;
+        morph::kdtree<float, 3> tree (nopoints);
+        float dist = -1.0f;
+        if (tree.nearest ({ 0, 0, 0 }, &dist) != morph::kdtree<float, 3>::npos) {
+            std::cout << "empty tree nearest() should be npos\n";
+            --rtn;
+        }
+        if (tree.within_ball ({ 0, 0, 0 }, 1.0f).empty() == false) { --rtn; }
+        if (tree.within_box ({ 0, 0, 0 }, { 1, 1, 1 }).empty() == false) { --rtn; }
+    }
+
+    // Duplicate points must all be found by a ball query on their location
+    {
+        std::vector<morph::vec<float, 3>> points (100, morph::vec<float, 3>{ 0.5f, 0.5f, 0.5f });
+        points.push_back ({ 0.9f, 0.9f, 0.9f });
+        morph::kdtree<float, 3> tree (points);
+        if (tree.within_ball ({ 0.5f, 0.5f, 0.5f }, 0.01f).size() != 100) {
+            std::cout << "duplicate points missed\n";
+            --rtn;
+        }
+    }
+
+    std::cout << (rtn == 0 ? "Test success" : "Test failed") << std::endl;
+    return rtn;
+}
@@ -17,6 +17,29 @@ int main()
         --rtn;
     }
 
+    // The row-callback streaming decode should visit every row and match loadpng's conversion
+    try {
+        morph::vvec<float> streamed (image_data.size(), 0.0f);
+        morph::vec<unsigned int, 2> dims = morph::loadpng_stream (fn,
+            [&streamed] (unsigned int row, std::span<const unsigned char> rgba) {
+                unsigned int w = rgba.size() / 4;
+                unsigned int h = streamed.size() / w;
+                // Fill bottom row first, as loadpng's default flip does
+                float* out = streamed.data() + (h - row - 1) * w;
+                for (unsigned int r = 0; r < w; ++r) {
+                    out[r] = (rgba[4*r] + rgba[4*r+1] + rgba[4*r+2]) / 765.0f;
+                }
+            });
+        std::cout << "Streamed image dims: " << dims << std::endl;
+        if (streamed != image_data) {
+            std::cerr << "loadpng_stream conversion didn't match loadpng\n";
+            --rtn;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to loadpng_stream\n";
+        --rtn;
+    }
+
     fn = "examples/bad_name.png"; // known bad
     try {
         morph::vec<unsigned int, 2> dims = morph::loadpng (fn, image_data);
@@ -0,0 +1,61 @@
+/*
+ * Test the batched transform API of morph::mat44 against the single-point operator*.
+ */
+
+#include <iostream>
+#include <vector>
+#include <morph/mat44.h>
+
+int main()
+{
+    int rtn = 0;
+
+    morph::mat44<float> m;
+    m.rotate (morph::vec<float, 3>{ 0.0f, 0.0f, 1.0f }, morph::mathconst<float>::pi_over_4);
+    m.translate (morph::vec<float, 3>{ 1.0f, -2.0f, 0.5f });
+
+    constexpr std::size_t n = 1001;
+    std::vector<morph::vec<float, 4>> pts4 (n);
+    std::vector<morph::vec<float, 3>> pts3 (n);
+    for (std::size_t i = 0; i < n; ++i) {
+        float f = static_cast<float>(i);
+        pts4[i] = { f * 0.01f, 1.0f - f * 0.02f, f * 0.001f, 1.0f };
+        pts3[i] = { f * 0.01f, 1.0f - f * 0.02f, f * 0.001f };
+    }
+
+    std::vector<morph::vec<float, 4>> out (n);
+    m.transform (std::span<const morph::vec<float, 4>>(pts4), std::span<morph::vec<float, 4>>(out));
+    for (std::size_t i = 0; i < n; ++i) {
+        morph::vec<float, 4> expct = m * pts4[i];
+        if ((out[i] - expct).abs().max() > 1e-6f) {
+            std::cerr << "batched 4D transform mismatch at i=" << i << std::endl;
+            rtn -= 1;
+            break;
+        }
+    }
+
+    m.transform (std::span<const morph::vec<float, 3>>(pts3), std::span<morph::vec<float, 4>>(out));
+    for (std::size_t i = 0; i < n; ++i) {
+        morph::vec<float, 4> expct = m * pts3[i];
+        if ((out[i] - expct).abs().max() > 1e-6f) {
+            std::cerr << "batched 3D transform mismatch at i=" << i << std::endl;
+            rtn -= 1;
+            break;
+        }
+    }
+
+    // Mismatched span sizes should throw
+    bool threw = false;
+    try {
+        std::vector<morph::vec<float, 4>> shortout (n - 1);
+        m.transform (std::span<const morph::vec<float, 4>>(pts4), std::span<morph::vec<float, 4>>(shortout));
+    } catch (const std::runtime_error&) { threw = true; }
+    if (!threw) { std::cerr << "size mismatch did not throw" << std::endl; rtn -= 1; }
+
+    if (rtn == 0) {
+        std::cout << "All tests passed" << std::endl;
+    } else {
+        std::cout << "Some tests failed" << std::endl;
+    }
+    return rtn;
+}
@@ -0,0 +1,145 @@
+/*
+ * Test morph::npy: .npy round trips for vvec, std::vector, vector<vec> and
+ * Grid-shaped 2-D data; the header byte layout; error detection (dtype mismatch,
+ * non-npy input); and .npz round trips via morph::npy::zip.
+ */
+
+#include <morph/npy.h>
+#include <morph/vvec.h>
+#include <morph/vec.h>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+
+int main()
+{
+    int rtn = 0;
+
+    // A vvec<double> round trip
+    {
+        morph::vvec<double> v = { 1.5, -2.25, 3.0, 1e-9, 1e9 };
+        morph::npy::save ("testnpy_v.npy", v);
+        morph::vvec<double> v2;
+        std::vector<std::size_t> shape = morph::npy::load ("testnpy_v.npy", v2);
+        if (shape != std::vector<std::size_t>{ 5 } || v2 != v) {
+            std::cout << "vvec<double> round trip failed\n";
+            --rtn;
+        }
+    }
+
+    // The header must follow the format spec: magic, version 1.0, and a dict padded
+    // so the data starts at a multiple of 64 bytes
+    {
+        std::ifstream f ("testnpy_v.npy", std::ios::binary);
+        char magic[10] = { 0 };
+        f.read (magic, 10);
+        if (std::string (magic, 6) != std::string ("\x93NUMPY", 6) || magic[6] != 1 || magic[7] != 0) {
+            std::cout << "bad magic/version\n";
+            --rtn;
+        }
+        const std::uint16_t hlen = static_cast<std::uint8_t>(magic[8])
+            | (static_cast<std::uint16_t>(static_cast<std::uint8_t>(magic[9])) << 8);
+        if ((10 + hlen) % 64 != 0) { std::cout << "data not 64-byte aligned\n"; --rtn; }
+        std::string d (hlen, '\0');
+        f.read (d.data(), hlen);
+        if (d.back() != '\n'
+            || d.find ("{'descr': '<f8', 'fortran_order': False, 'shape': (5, ), }") != 0) {
+            std::cout << "bad header dict: " << d << "\n";
+            --rtn;
+        }
+    }
+
+    // Integer types carry their own descr
+    {
+        std::vector<std::int32_t> v = { -7, 0, 1 << 20 };
+        morph::npy::save ("testnpy_i.npy", v);
+        std::vector<std::int32_t> v2;
+        morph::npy::load ("testnpy_i.npy", v2);
+        if (v2 != v) { std::cout << "int32 round trip failed\n"; --rtn; }
+        // ...so loading as the wrong type must throw, not misinterpret bytes
+        bool threw = false;
+        std::vector<float> wrong;
+        try { morph::npy::load ("testnpy_i.npy", wrong); }
+        catch (const std::runtime_error&) { threw = true; }
+        if (!threw) { std::cout << "dtype mismatch not detected\n"; --rtn; }
+    }
+
+    // A non-npy file must be rejected
+    {
+        std::ofstream f ("testnpy_junk.npy", std::ios::binary | std::ios::trunc);
+        f << "this is not a numpy file";
+        f.close();
+        bool threw = false;
+        std::vector<double> v;
+        try { morph::npy::load ("testnpy_junk.npy", v); }
+        catch (const std::runtime_error&) { threw = true; }
+        if (!threw) { std::cout << "junk input not detected\n"; --rtn; }
+    }
+
+    // A vector of vec<float, 3> saves as an n by 3 array
+    {
+        std::vector<morph::vec<float, 3>> pts = { { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 }, { 10, 11, 12 } };
+        morph::npy::save ("testnpy_pts.npy", pts);
+        std::vector<float> flat;
+        std::vector<std::size_t> shape = morph::npy::load ("testnpy_pts.npy", flat);
+        if (shape != std::vector<std::size_t>{ 4, 3 } || flat.size() != 12
+            || flat[0] != 1.0f || flat[5] != 6.0f || flat[11] != 12.0f) {
+            std::cout << "vector<vec> round trip failed\n";
+            --rtn;
+        }
+    }
+
+    // Grid-shaped data: rows by cols, with a size check
+    {
+        std::vector<float> grid (6 * 4);
+        for (std::size_t i = 0; i < grid.size(); ++i) { grid[i] = 0.5f * i; }
+        morph::npy::save ("testnpy_grid.npy", grid, 6, 4);
+        std::vector<float> g2;
+        std::vector<std::size_t> shape = morph::npy::load ("testnpy_grid.npy", g2);
+        if (shape != std::vector<std::size_t>{ 6, 4 } || g2 != grid) {
+            std::cout << "grid round trip failed\n";
+            --rtn;
+        }
+        bool threw = false;
+        try { morph::npy::save ("testnpy_bad.npy", grid, 5, 4); }
+        catch (const std::runtime_error&) { threw = true; }
+        if (!threw) { std::cout << "rows*cols size mismatch not detected\n"; --rtn; }
+    }
+
+    // An .npz batches several arrays into one archive
+    {
+        morph::vvec<double> a = { 0.25, 0.5, 0.75 };
+        std::vector<std::int64_t> b = { 100, -200, 300, -400 };
+        std::vector<float> c (3 * 5);
+        for (std::size_t i = 0; i < c.size(); ++i) { c[i] = static_cast<float>(i); }
+        {
+            morph::npy::zip z ("testnpy_batch.npz");
+            z.add ("a", a);
+            z.add ("b", b);
+            z.add ("c", c, 3, 5);
+            z.close();
+        }
+        morph::vvec<double> a2;
+        std::vector<std::int64_t> b2;
+        std::vector<float> c2;
+        morph::npy::zip::load ("testnpy_batch.npz", "a", a2);
+        morph::npy::zip::load ("testnpy_batch.npz", "b", b2);
+        std::vector<std::size_t> cshape = morph::npy::zip::load ("testnpy_batch.npz", "c", c2);
+        if (a2 != a || b2 != b || c2 != c || cshape != std::vector<std::size_t>{ 3, 5 }) {
+            std::cout << "npz round trip failed\n";
+            --rtn;
+        }
+        // A missing member must throw
+        bool threw = false;
+        try { morph::npy::zip::load ("testnpy_batch.npz", "nosuch", a2); }
+        catch (const std::runtime_error&) { threw = true; }
+        if (!threw) { std::cout << "missing npz member not detected\n"; --rtn; }
+    }
+
+    std::cout << (rtn == 0 ? "Test success" : "Test failed") << std::endl;
+    return rtn;
+}
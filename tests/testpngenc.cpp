@@ -0,0 +1,98 @@
+/*
+ * Test morph::pngenc by decoding its output with lodepng: the pixels must round
+ * trip exactly for compressible (gradient/solid) and incompressible (random)
+ * images, for sizes small and large enough to exercise the parallel deflate's
+ * multi-chunk splicing, and via both the memory and file APIs.
+ */
+
+#include <morph/pngenc.h>
+#include <morph/lodepng.h>
+#include <morph/Random.h>
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdio>
+
+// Encode with pngenc, decode with lodepng, compare
+static int roundtrip (const std::vector<unsigned char>& rgba,
+                      const unsigned int w, const unsigned int h, const char* what)
+{
+    std::vector<std::uint8_t> png = morph::pngenc::encode_memory (rgba.data(), w, h);
+    std::vector<unsigned char> back;
+    unsigned int dw = 0, dh = 0;
+    unsigned int error = lodepng::decode (back, dw, dh, png.data(), png.size());
+    if (error != 0) {
+        std::cout << what << ": lodepng could not decode pngenc output: "
+                  << lodepng_error_text (error) << "\n";
+        return -1;
+    }
+    if (dw != w || dh != h || back != rgba) {
+        std::cout << what << ": decoded pixels differ\n";
+        return -1;
+    }
+    return 0;
+}
+
+int main()
+{
+    int rtn = 0;
+
+    // A smooth gradient (the typical screenshot-like, compressible case), large
+    // enough that the filtered stream spans several deflate chunks
+    {
+        constexpr unsigned int w = 613, h = 601;
+        std::vector<unsigned char> rgba (static_cast<std::size_t>(w) * h * 4);
+        for (unsigned int y = 0; y < h; ++y) {
+            for (unsigned int x = 0; x < w; ++x) {
+                const std::size_t i = (static_cast<std::size_t>(y) * w + x) * 4;
+                rgba[i] = static_cast<unsigned char>(x & 0xff);
+                rgba[i + 1] = static_cast<unsigned char>(y & 0xff);
+                rgba[i + 2] = static_cast<unsigned char>((x + y) & 0xff);
+                rgba[i + 3] = 255;
+            }
+        }
+        rtn += roundtrip (rgba, w, h, "gradient");
+        // A screenshot-like image should actually compress
+        std::vector<std::uint8_t> png = morph::pngenc::encode_memory (rgba.data(), w, h);
+        if (png.size() >= rgba.size() / 2) {
+            std::cout << "gradient compressed poorly: " << png.size() << " of " << rgba.size() << " bytes\n";
+            --rtn;
+        }
+    }
+
+    // Incompressible random pixels: fixed Huffman expands these slightly, but the
+    // round trip must still be exact
+    {
+        constexpr unsigned int w = 257, h = 131;
+        morph::RandUniform<unsigned short> randval (0, 255);
+        std::vector<unsigned char> rgba (static_cast<std::size_t>(w) * h * 4);
+        for (auto& v : rgba) { v = static_cast<unsigned char>(randval.get()); }
+        rtn += roundtrip (rgba, w, h, "random");
+    }
+
+    // Degenerate sizes
+    {
+        std::vector<unsigned char> px = { 10, 20, 30, 255 };
+        rtn += roundtrip (px, 1, 1, "1x1");
+        std::vector<unsigned char> row (300 * 4, 77);
+        rtn += roundtrip (row, 300, 1, "300x1");
+        rtn += roundtrip (row, 1, 300, "1x300");
+    }
+
+    // The file API
+    {
+        constexpr unsigned int w = 64, h = 48;
+        std::vector<unsigned char> rgba (static_cast<std::size_t>(w) * h * 4, 128);
+        morph::pngenc::encode ("testpngenc.png", rgba.data(), w, h);
+        std::vector<unsigned char> back;
+        unsigned int dw = 0, dh = 0;
+        if (lodepng::decode (back, dw, dh, "testpngenc.png") != 0 || dw != w || dh != h || back != rgba) {
+            std::cout << "file round trip failed\n";
+            --rtn;
+        }
+        std::remove ("testpngenc.png");
+    }
+
+    std::cout << (rtn == 0 ? "Test success" : "Test failed") << std::endl;
+    return rtn;
+}
@@ -0,0 +1,93 @@
+/*
+ * Test morph::profile (built with MORPH_PROFILE defined; see CMakeLists.txt). Scoped
+ * tracepoints from several threads must appear in the dumped chrome trace JSON with
+ * sane timestamps, and dump() must produce a parseable structure.
+ */
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <morph/profile.h>
+
+void traced_work (const int reps)
+{
+    for (int i = 0; i < reps; ++i) {
+        MORPH_PROFILE_SCOPE ("traced_work");
+        std::this_thread::sleep_for (std::chrono::milliseconds (1));
+    }
+}
+
+int main()
+{
+    int rtn = 0;
+    const std::string trace = "./testprofile_trace.json";
+    std::remove (trace.c_str());
+#ifndef _WIN32
+    // Send the automatic at-exit dump to the same file, so the test leaves only one artifact
+    setenv ("MORPH_PROFILE_FILE", trace.c_str(), 1);
+#endif
+
+    {
+        MORPH_PROFILE_SCOPE ("main_section");
+        std::vector<std::thread> workers;
+        for (int t = 0; t < 3; ++t) { workers.emplace_back (traced_work, 5); }
+        for (std::thread& w : workers) { w.join(); }
+        {
+            MORPH_PROFILE_SCOPE ("nested");
+            traced_work (2);
+        }
+    }
+
+    morph::profile::dump (trace);
+
+    std::ifstream f (trace);
+    if (!f.is_open()) {
+        std::cerr << "Trace file was not written" << std::endl;
+        rtn -= 1;
+    } else {
+        std::stringstream ss;
+        ss << f.rdbuf();
+        const std::string j = ss.str();
+
+        if (j.find ("\"traceEvents\":[") == std::string::npos) {
+            std::cerr << "Trace is missing the traceEvents array" << std::endl;
+            rtn -= 1;
+        }
+        for (const char* name : { "main_section", "nested", "traced_work" }) {
+            if (j.find (std::string ("\"name\":\"") + name + "\"") == std::string::npos) {
+                std::cerr << "Trace is missing events named " << name << std::endl;
+                rtn -= 1;
+            }
+        }
+        // 17 traced_work events, one nested, one main_section
+        std::size_t n_events = 0;
+        for (std::string::size_type p = j.find ("\"ph\":\"X\""); p != std::string::npos;
+             p = j.find ("\"ph\":\"X\"", p + 1)) { ++n_events; }
+        if (n_events != 19) {
+            std::cerr << "Expected 19 events, found " << n_events << std::endl;
+            rtn -= 1;
+        }
+        // Balanced braces/brackets is a cheap well-formedness check (no strings in
+        // the output contain braces)
+        long depth = 0;
+        bool neg = false;
+        for (const char c : j) {
+            if (c == '{' || c == '[') { ++depth; }
+            if (c == '}' || c == ']') { --depth; }
+            if (depth < 0) { neg = true; }
+        }
+        if (depth != 0 || neg == true) {
+            std::cerr << "Trace JSON braces are unbalanced" << std::endl;
+            rtn -= 1;
+        }
+    }
+
+    std::cout << (rtn == 0 ? "Test success" : "Test failed") << std::endl;
+    return rtn;
+}
@@ -0,0 +1,114 @@
+/*
+ * Test the parsed-boundary binary cache in morph::ReadCurves. A cached construction
+ * must reproduce the curves (and the optionally cached point set) of a plain parse; a
+ * second construction must load from the cache; a changed SVG or a corrupted cache
+ * file must fall back to parsing.
+ */
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cmath>
+#include <vector>
+
+#include "morph/ReadCurves.h"
+#include "morph/BezCoord.h"
+#include "morph/BezCurvePath.h"
+
+// Copy the repo's trial.svg into the working directory, so the cache file lands here too
+void copy_svg (const std::string& dest, const std::string& extra = "")
+{
+    std::ifstream fin ("../../tests/trial.svg", std::ios::in | std::ios::binary);
+    std::stringstream ss;
+    ss << fin.rdbuf();
+    std::ofstream fout (dest, std::ios::out | std::ios::trunc | std::ios::binary);
+    fout << ss.str() << extra;
+}
+
+int main()
+{
+    int rtn = 0;
+    const std::string svg = "./trial_cached.svg";
+    const std::string cache = svg + ".curves.bin";
+
+    try {
+        copy_svg (svg);
+        std::remove (cache.c_str());
+
+        // Plain parse for reference
+        morph::ReadCurves ref ("../../tests/trial.svg");
+        morph::BezCurvePath<float> refpath = ref.getCorticalPath();
+        refpath.computePoints (0.01f);
+        std::vector<morph::BezCoord<float>> refpts = refpath.getPoints();
+
+        // First cached construction parses and writes the cache (with sampled points)
+        morph::ReadCurves r1 (svg, true, 0.01f);
+        {
+            std::ifstream f (cache, std::ios::in | std::ios::binary);
+            if (!f.is_open()) { std::cerr << "Cache file was not written" << std::endl; rtn -= 1; }
+        }
+
+        // Second construction loads from the cache; curves and points must match the parse
+        morph::ReadCurves r2 (svg, true, 0.01f);
+        morph::BezCurvePath<float> p2 = r2.getCorticalPath();
+        if (p2.curves.size() != refpath.curves.size()) {
+            std::cerr << "Curve count differs after cache load" << std::endl;
+            rtn -= 1;
+        }
+        if (std::abs (r2.getScale_mmpersvg() - ref.getScale_mmpersvg()) > 1e-6f) {
+            std::cerr << "Scale differs after cache load" << std::endl;
+            rtn -= 1;
+        }
+        std::vector<morph::BezCoord<float>> pts2 = p2.getPoints();
+        if (pts2.size() != refpts.size()) {
+            std::cerr << "Cached point set has the wrong size" << std::endl;
+            rtn -= 1;
+        } else {
+            for (std::size_t i = 0; i < pts2.size(); ++i) {
+                if (std::abs (pts2[i].x() - refpts[i].x()) > 1e-6f
+                    || std::abs (pts2[i].y() - refpts[i].y()) > 1e-6f) {
+                    std::cerr << "Cached point " << i << " differs" << std::endl;
+                    rtn -= 1;
+                    break;
+                }
+            }
+        }
+        // Recompute from the cached curves; same result as the cached point set
+        p2.computePoints (0.01f);
+        std::vector<morph::BezCoord<float>> pts2r = p2.getPoints();
+        if (pts2r.size() != refpts.size()) {
+            std::cerr << "Recomputed point set has the wrong size" << std::endl;
+            rtn -= 1;
+        }
+
+        // A changed SVG must invalidate the cache (the content hash differs)
+        copy_svg (svg, "<!-- changed -->");
+        morph::ReadCurves r3 (svg, true);
+        if (r3.getCorticalPath().curves.size() != refpath.curves.size()) {
+            std::cerr << "Re-parse after SVG change failed" << std::endl;
+            rtn -= 1;
+        }
+
+        // A corrupted cache must fall back to parsing
+        {
+            std::fstream f (cache, std::ios::in | std::ios::out | std::ios::binary);
+            f.seekp (40);
+            char byte = 0x5a;
+            f.write (&byte, 1);
+        }
+        morph::ReadCurves r4 (svg, true);
+        if (r4.getCorticalPath().curves.size() != refpath.curves.size()) {
+            std::cerr << "Fallback from corrupt cache failed" << std::endl;
+            rtn -= 1;
+        }
+
+    } catch (const std::exception& e) {
+        std::cerr << "Caught exception: " << e.what() << std::endl;
+        rtn -= 1;
+    }
+
+    std::remove (cache.c_str());
+    std::remove (svg.c_str());
+    std::cout << (rtn == 0 ? "Test success" : "Test failed") << std::endl;
+    return rtn;
+}
@@ -0,0 +1,162 @@
+/*
+ * Test the shared morph::snapshot format directly (writer/reader round trip, content
+ * tag/version checks, checksum detection of corruption) and through the CartGrid and
+ * Grid save_snapshot/load_snapshot methods. A loaded CartGrid must reproduce the d_
+ * vectors exactly without rebuilding the rects list, and must still support lazy
+ * materialization afterwards.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <vector>
+#include <morph/snapshot.h>
+#include <morph/CartGrid.h>
+#include <morph/Grid.h>
+
+int main()
+{
+    int rtn = 0;
+
+    constexpr std::uint32_t tag = morph::crc32 ("testsnapshot");
+
+    // Raw writer/reader round trip
+    {
+        const std::string snap = "./testsnapshot_raw.bin";
+        std::vector<double> arr = { 1.5, -2.25, 1e9, 0.0 };
+        {
+            morph::snapshot::writer w (snap, tag, 3);
+            w.add_value ("answer", 42);
+            w.add_array ("arr", arr);
+            w.finish();
+        }
+        morph::snapshot::reader r (snap, tag, 3);
+        int answer = 0;
+        r.value ("answer", answer);
+        if (answer != 42) { std::cerr << "Scalar not preserved" << std::endl; rtn -= 1; }
+        std::vector<double> arr2;
+        r.fill ("arr", arr2);
+        if (arr2 != arr) { std::cerr << "Array not preserved" << std::endl; rtn -= 1; }
+        if (r.has ("nonexistent") == true) { std::cerr << "has() found a missing section" << std::endl; rtn -= 1; }
+        // Payloads must be 8-byte aligned for in-place access
+        auto v = r.view<double> ("arr");
+        if (reinterpret_cast<std::uintptr_t>(v.data()) % 8u != 0) {
+            std::cerr << "Section payload not 8-byte aligned" << std::endl;
+            rtn -= 1;
+        }
+
+        // Wrong content tag and wrong content version must both be rejected
+        try {
+            morph::snapshot::reader r2 (snap, tag + 1u, 3);
+            std::cerr << "Tag mismatch not rejected" << std::endl;
+            rtn -= 1;
+        } catch (const std::runtime_error&) {}
+        try {
+            morph::snapshot::reader r3 (snap, tag, 2);
+            std::cerr << "Version mismatch not rejected" << std::endl;
+            rtn -= 1;
+        } catch (const std::runtime_error&) {}
+        std::remove (snap.c_str());
+    }
+
+    // A flipped payload byte must fail the section checksum
+    {
+        const std::string snap = "./testsnapshot_corrupt.bin";
+        std::vector<float> arr (64, 7.0f);
+        {
+            morph::snapshot::writer w (snap, tag, 1);
+            w.add_array ("arr", arr);
+            w.finish();
+        }
+        {
+            std::fstream f (snap, std::ios::in | std::ios::out | std::ios::binary);
+            f.seekp (24 + 32 + 100); // past the header and section sub-header, into the payload
+            char byte = 0x5a;
+            f.write (&byte, 1);
+        }
+        try {
+            morph::snapshot::reader r (snap, tag, 1);
+            std::cerr << "Corruption not detected" << std::endl;
+            rtn -= 1;
+        } catch (const std::runtime_error&) {}
+        std::remove (snap.c_str());
+    }
+
+    // A file that isn't a snapshot at all
+    {
+        const std::string snap = "./testsnapshot_bad.bin";
+        std::ofstream f (snap, std::ios::out | std::ios::binary);
+        f << "This is certainly not a snapshot file, no sir";
+        f.close();
+        try {
+            morph::snapshot::reader r (snap, tag, 1);
+            std::cerr << "Bad magic not rejected" << std::endl;
+            rtn -= 1;
+        } catch (const std::runtime_error&) {}
+        std::remove (snap.c_str());
+    }
+
+    // CartGrid round trip
+    {
+        const std::string snap = "./testsnapshot_cg.bin";
+        morph::CartGrid cg (0.05f, 1.0f);
+        cg.setBoundaryOnOuterEdge();
+        cg.save_snapshot (snap);
+
+        morph::CartGrid cg2;
+        cg2.load_snapshot (snap);
+        std::cout << "saved grid: " << cg.num() << " rects; loaded grid: " << cg2.num() << " rects\n";
+        if (cg.num() != cg2.num()) { std::cerr << "Rect count not preserved" << std::endl; rtn -= 1; }
+        if (cg2.d_x != cg.d_x || cg2.d_y != cg.d_y || cg2.d_xi != cg.d_xi || cg2.d_yi != cg.d_yi) {
+            std::cerr << "Position vectors not preserved" << std::endl;
+            rtn -= 1;
+        }
+        if (cg2.d_ne != cg.d_ne || cg2.d_nne != cg.d_nne || cg2.d_nn != cg.d_nn || cg2.d_nnw != cg.d_nnw
+            || cg2.d_nw != cg.d_nw || cg2.d_nsw != cg.d_nsw || cg2.d_ns != cg.d_ns || cg2.d_nse != cg.d_nse) {
+            std::cerr << "Neighbour vectors not preserved" << std::endl;
+            rtn -= 1;
+        }
+        if (cg2.d_flags != cg.d_flags) { std::cerr << "Flags not preserved" << std::endl; rtn -= 1; }
+
+        // The rects list is not rebuilt on load, but can be materialized
+        morph::CartGrid cg3;
+        cg3.load_snapshot (snap);
+        cg3.materialize_rects();
+        if (cg3.num() != cg.num()) { std::cerr << "materialize_rects made the wrong number of rects" << std::endl; rtn -= 1; }
+        // An interior rect has all eight neighbours hooked up again
+        bool found_interior = false;
+        for (auto ri = cg3.rects.begin(); ri != cg3.rects.end(); ++ri) {
+            if (ri->has_ne() && ri->has_nw() && ri->has_nn() && ri->has_ns()
+                && ri->has_nne() && ri->has_nnw() && ri->has_nse() && ri->has_nsw()) {
+                if (ri->ne->xi != ri->xi + 1 || ri->nn->yi != ri->yi + 1) {
+                    std::cerr << "Materialized neighbours point to the wrong rects" << std::endl;
+                    rtn -= 1;
+                }
+                found_interior = true;
+                break;
+            }
+        }
+        if (found_interior == false) { std::cerr << "No fully-connected interior rect found" << std::endl; rtn -= 1; }
+        std::remove (snap.c_str());
+    }
+
+    // Grid round trip
+    {
+        const std::string snap = "./testsnapshot_grid.bin";
+        morph::Grid<unsigned int, float> g (8, 5, { 0.25f, 0.5f }, { -1.0f, -1.25f });
+        g.save_snapshot (snap);
+
+        morph::Grid<unsigned int, float> g2 (1, 1); // to be overwritten by the load
+        g2.load_snapshot (snap);
+        if (g2.n() != g.n() || g2.get_w() != g.get_w() || g2.get_h() != g.get_h()
+            || g2.get_dx() != g.get_dx() || g2.get_offset() != g.get_offset()) {
+            std::cerr << "Grid parameters not preserved" << std::endl;
+            rtn -= 1;
+        }
+        if (g2.v_c != g.v_c) { std::cerr << "Grid coordinates not preserved" << std::endl; rtn -= 1; }
+        std::remove (snap.c_str());
+    }
+
+    std::cout << (rtn == 0 ? "Test success" : "Test failed") << std::endl;
+    return rtn;
+}
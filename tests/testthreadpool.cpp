@@ -0,0 +1,108 @@
+/*
+ * Test morph::threadpool: parallel_for correctness vs a serial loop, grain control,
+ * per-chunk dispatch, task submission with run(), exception propagation, nested
+ * parallel_for and the global instance.
+ */
+
+#include <morph/threadpool.h>
+#include <iostream>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <cstddef>
+
+int main()
+{
+    int rtn = 0;
+
+    constexpr std::size_t n = 100000;
+
+    // parallel_for fills each slot exactly once, whatever the grain
+    {
+        morph::threadpool tp (4);
+        if (tp.size() != 4) { std::cout << "size() != 4\n"; --rtn; }
+        for (std::size_t grain : { std::size_t{0}, std::size_t{1}, std::size_t{1000}, n * 2 }) {
+            std::vector<std::size_t> out (n, 0);
+            tp.parallel_for (0, n, [&out] (std::size_t i) { out[i] += i * i; }, grain);
+            for (std::size_t i = 0; i < n; ++i) {
+                if (out[i] != i * i) {
+                    std::cout << "parallel_for (grain " << grain << ") wrong at " << i << "\n";
+                    --rtn;
+                    break;
+                }
+            }
+        }
+        // An empty range is a no-op
+        tp.parallel_for (5, 5, [&rtn] (std::size_t) { --rtn; });
+    }
+
+    // parallel_for_chunked covers the range in disjoint chunks of the given grain
+    {
+        morph::threadpool tp (4);
+        std::vector<int> cover (n, 0);
+        std::atomic<std::size_t> nchunks{0};
+        tp.parallel_for_chunked (0, n, [&cover, &nchunks] (std::size_t b, std::size_t e) {
+            ++nchunks;
+            if (e - b > 64) { throw std::runtime_error ("chunk larger than grain"); }
+            for (; b < e; ++b) { ++cover[b]; }
+        }, 64);
+        for (std::size_t i = 0; i < n; ++i) {
+            if (cover[i] != 1) { std::cout << "chunked cover wrong at " << i << "\n"; --rtn; break; }
+        }
+        if (nchunks.load() != (n + 63) / 64) {
+            std::cout << "wrong chunk count " << nchunks.load() << "\n";
+            --rtn;
+        }
+    }
+
+    // run() executes every submitted task
+    {
+        morph::threadpool tp (3);
+        std::atomic<unsigned int> count{0};
+        for (unsigned int i = 0; i < 100; ++i) { tp.run ([&count] { ++count; }); }
+        // The destructor drains the deques, so after scope exit all tasks have run
+        auto t0 = std::chrono::steady_clock::now();
+        while (count.load() < 100
+               && std::chrono::steady_clock::now() - t0 < std::chrono::seconds(10)) {
+            std::this_thread::yield();
+        }
+        if (count.load() != 100) { std::cout << "run() lost tasks\n"; --rtn; }
+    }
+
+    // An exception from the loop body propagates to the caller
+    {
+        morph::threadpool tp (2);
+        bool threw = false;
+        try {
+            tp.parallel_for (0, n, [] (std::size_t i) {
+                if (i == n / 2) { throw std::runtime_error ("boom"); }
+            });
+        } catch (const std::runtime_error&) { threw = true; }
+        if (!threw) { std::cout << "exception was not propagated\n"; --rtn; }
+    }
+
+    // A nested parallel_for must not deadlock (the calling thread participates)
+    {
+        morph::threadpool tp (2);
+        std::atomic<std::size_t> total{0};
+        tp.parallel_for (0, 8, [&tp, &total] (std::size_t) {
+            tp.parallel_for (0, 100, [&total] (std::size_t) { ++total; }, 10);
+        });
+        if (total.load() != 800) { std::cout << "nested total " << total.load() << " != 800\n"; --rtn; }
+    }
+
+    // The global pool is a single instance and works like any other
+    {
+        if (&morph::threadpool::global() != &morph::threadpool::global()) {
+            std::cout << "global() not a single instance\n";
+            --rtn;
+        }
+        std::atomic<std::size_t> total{0};
+        morph::threadpool::global().parallel_for (0, n, [&total] (std::size_t i) { total += i; });
+        if (total.load() != (n * (n - 1)) / 2) { std::cout << "global pool sum wrong\n"; --rtn; }
+    }
+
+    std::cout << (rtn == 0 ? "Test success" : "Test failed") << std::endl;
+    return rtn;
+}
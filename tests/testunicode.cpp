@@ -0,0 +1,92 @@
+/*
+ * Test morph::unicode: UTF-8 decoding (including the pure-ASCII fast path),
+ * round-tripping through toUtf8, the interning cache and the bulk conversion API.
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <morph/unicode.h>
+
+int main()
+{
+    int rtn = 0;
+
+    using morph::unicode;
+
+    // ASCII detection
+    if (!unicode::isAscii ("Time (s)") || !unicode::isAscii ("")) {
+        std::cerr << "isAscii failed on plain ASCII" << std::endl;
+        rtn -= 1;
+    }
+    if (unicode::isAscii (unicode::toUtf8 (unicode::alpha))) {
+        std::cerr << "isAscii failed on a multibyte sequence" << std::endl;
+        rtn -= 1;
+    }
+
+    // The ASCII fast path must widen byte-for-byte
+    std::string ascii ("0.125");
+    std::basic_string<char32_t> uascii = unicode::fromUtf8 (ascii);
+    if (uascii.size() != ascii.size()) {
+        std::cerr << "ASCII decode changed the length" << std::endl;
+        rtn -= 1;
+    }
+    for (std::size_t i = 0; i < ascii.size(); ++i) {
+        if (uascii[i] != static_cast<char32_t>(ascii[i])) {
+            std::cerr << "ASCII decode changed a character" << std::endl;
+            rtn -= 1;
+            break;
+        }
+    }
+
+    // Round trip 2, 3 and 4 byte sequences mixed with ASCII
+    std::string mixed ("x = ");
+    unicode::append (mixed, unicode::alpha);          // 2 bytes
+    unicode::append (mixed, unicode::sigmasum);       // 3 bytes
+    unicode::append (mixed, unicode::rightarrow2);    // 4 bytes
+    mixed += " end";
+    std::basic_string<char32_t> umixed = unicode::fromUtf8 (mixed);
+    if (umixed.size() != 11u || umixed[4] != unicode::alpha
+        || umixed[5] != unicode::sigmasum || umixed[6] != unicode::rightarrow2) {
+        std::cerr << "mixed UTF-8 decode is wrong" << std::endl;
+        rtn -= 1;
+    }
+    std::string reenc ("");
+    for (const char32_t c : umixed) { reenc += unicode::toUtf8 (c); }
+    if (reenc != mixed) {
+        std::cerr << "UTF-8 round trip failed" << std::endl;
+        rtn -= 1;
+    }
+
+    // The cached decode must agree with the uncached one, for ASCII and not
+    if (unicode::fromUtf8_cached (mixed) != umixed || unicode::fromUtf8_cached (mixed) != umixed) {
+        std::cerr << "fromUtf8_cached disagrees with fromUtf8" << std::endl;
+        rtn -= 1;
+    }
+    if (unicode::fromUtf8_cached (ascii) != uascii) {
+        std::cerr << "fromUtf8_cached disagrees on ASCII" << std::endl;
+        rtn -= 1;
+    }
+
+    // Bulk conversion
+    std::vector<std::string> labels = { "0", "0.5", "1", mixed, mixed };
+    std::vector<std::basic_string<char32_t>> ulabels = unicode::fromUtf8_bulk (labels);
+    if (ulabels.size() != labels.size()) {
+        std::cerr << "fromUtf8_bulk returned the wrong count" << std::endl;
+        rtn -= 1;
+    } else {
+        for (std::size_t i = 0; i < labels.size(); ++i) {
+            if (ulabels[i] != unicode::fromUtf8 (labels[i])) {
+                std::cerr << "fromUtf8_bulk element " << i << " is wrong" << std::endl;
+                rtn -= 1;
+            }
+        }
+    }
+
+    if (rtn == 0) {
+        std::cout << "All tests passed" << std::endl;
+    } else {
+        std::cout << "Some tests failed" << std::endl;
+    }
+    return rtn;
+}
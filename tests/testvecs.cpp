@@ -0,0 +1,110 @@
+/*
+ * Test morph::vecs, the structure-of-arrays companion to std::vector<morph::vec>:
+ * AoS round trips, element proxies and the bulk operations against per-point
+ * references.
+ */
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <morph/vec.h>
+#include <morph/vecs.h>
+
+int main()
+{
+    int rtn = 0;
+
+    // Round trip from interleaved points and back
+    std::vector<morph::vec<float, 3>> aos = {
+        { 1.0f, 2.0f, 3.0f }, { 4.0f, 5.0f, 6.0f }, { -1.0f, 0.5f, -2.0f }
+    };
+    morph::vecs<float, 3> soa (aos);
+    if (soa.size() != aos.size() || soa.empty()) {
+        std::cerr << "size is wrong after set_from" << std::endl;
+        rtn -= 1;
+    }
+    if (soa.to_aos() != aos) {
+        std::cerr << "AoS round trip failed" << std::endl;
+        rtn -= 1;
+    }
+    if (soa.x()[1] != 4.0f || soa.y()[1] != 5.0f || soa.z()[1] != 6.0f) {
+        std::cerr << "component arrays are wrong" << std::endl;
+        rtn -= 1;
+    }
+
+    // Element proxies: gather-read and scatter-write whole points
+    morph::vec<float, 3> p1 = soa[1];
+    if (p1 != aos[1]) {
+        std::cerr << "proxy read is wrong" << std::endl;
+        rtn -= 1;
+    }
+    soa[1] = morph::vec<float, 3>{ 7.0f, 8.0f, 9.0f };
+    if (soa.x()[1] != 7.0f || soa.y()[1] != 8.0f || soa.z()[1] != 9.0f) {
+        std::cerr << "proxy write is wrong" << std::endl;
+        rtn -= 1;
+    }
+    soa[1] = p1; // restore
+
+    // push_back grows all components together
+    soa.push_back (morph::vec<float, 3>{ 2.0f, -2.0f, 1.0f });
+    aos.push_back (morph::vec<float, 3>{ 2.0f, -2.0f, 1.0f });
+    if (soa.size() != 4u || soa.to_aos() != aos) {
+        std::cerr << "push_back is wrong" << std::endl;
+        rtn -= 1;
+    }
+
+    // Bulk translate/scale must match per-point vec arithmetic
+    const morph::vec<float, 3> off = { 0.5f, -1.0f, 2.0f };
+    soa += off;
+    soa *= 2.0f;
+    for (std::size_t i = 0; i < aos.size(); ++i) {
+        if (soa[i] != (aos[i] + off) * 2.0f) {
+            std::cerr << "bulk translate/scale disagrees with vec arithmetic at point " << i << std::endl;
+            rtn -= 1;
+            break;
+        }
+    }
+    soa /= 2.0f;
+    soa -= off;
+
+    // Pointwise addition of a displacement cloud
+    morph::vecs<float, 3> disp (soa.size());
+    for (std::size_t i = 0; i < disp.size(); ++i) {
+        disp[i] = morph::vec<float, 3>{ static_cast<float>(i), 0.0f, -static_cast<float>(i) };
+    }
+    soa += disp;
+    for (std::size_t i = 0; i < aos.size(); ++i) {
+        morph::vec<float, 3> expct = aos[i] + morph::vec<float, 3>{ static_cast<float>(i), 0.0f, -static_cast<float>(i) };
+        if (soa[i] != expct) {
+            std::cerr << "pointwise addition is wrong at point " << i << std::endl;
+            rtn -= 1;
+            break;
+        }
+    }
+    soa -= disp;
+
+    // lengths() must match vec::length()
+    morph::vvec<float> lens = soa.lengths();
+    for (std::size_t i = 0; i < aos.size(); ++i) {
+        if (std::abs (lens[i] - aos[i].length()) > 1e-6f) {
+            std::cerr << "lengths() disagrees with vec::length at point " << i << std::endl;
+            rtn -= 1;
+            break;
+        }
+    }
+
+    // A 2D cloud compiles and works (no z() for N == 2)
+    morph::vecs<double, 2> flat;
+    flat.push_back (morph::vec<double, 2>{ 3.0, 4.0 });
+    if (flat.lengths()[0] != 5.0) {
+        std::cerr << "2D lengths are wrong" << std::endl;
+        rtn -= 1;
+    }
+
+    if (rtn == 0) {
+        std::cout << "All tests passed" << std::endl;
+    } else {
+        std::cout << "Some tests failed" << std::endl;
+    }
+    return rtn;
+}
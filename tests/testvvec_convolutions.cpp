@@ -23,5 +23,39 @@ int main()
     if (r1 != r1expct) { rtn -= 1; }
     if (r2 != r2expct) { rtn -= 1; }
 
+    // Test that a conv_plan reproduces convolve() exactly
+    morph::conv_plan<float> plan_nowrap (a.size(), b);
+    morph::conv_plan<float> plan_wrap (a.size(), b, morph::vvec<float>::wrapdata::wrap);
+    morph::vvec<float> rp;
+    plan_nowrap.apply (a, rp);
+    std::cout << a << " * " << b << " = " << rp  << " (conv_plan, no wrap, expect " << r1expct << ")" << std::endl;
+    if (rp != r1expct) { rtn -= 1; }
+    plan_wrap.apply (a, rp);
+    std::cout << a << " * " << b << " = " << rp  << " (conv_plan, wrap, expect " << r2expct << ")" << std::endl;
+    if (rp != r2expct) { rtn -= 1; }
+
+    // conv_plan apply_inplace
+    r1 = a;
+    r2 = a;
+    plan_nowrap.apply_inplace (r1);
+    plan_wrap.apply_inplace (r2);
+    if (r1 != r1expct) { rtn -= 1; }
+    if (r2 != r2expct) { rtn -= 1; }
+
+    // A larger example with an even-width kernel, plan vs convolve
+    morph::vvec<float> big (1000);
+    big.randomize (-1.0f, 1.0f);
+    morph::vvec<float> kern = { 0.125f, 0.25f, 0.375f, 0.25f };
+    for (auto wrap : { morph::vvec<float>::wrapdata::none, morph::vvec<float>::wrapdata::wrap }) {
+        morph::conv_plan<float> plan (big.size(), kern, wrap);
+        morph::vvec<float> planned;
+        plan.apply (big, planned);
+        if (planned != big.convolve (kern, wrap)) {
+            std::cout << "conv_plan does not match convolve() for wrap mode "
+                      << (wrap == morph::vvec<float>::wrapdata::wrap ? "wrap" : "none") << std::endl;
+            rtn -= 1;
+        }
+    }
+
     return rtn;
 }
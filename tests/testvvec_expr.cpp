@@ -0,0 +1,71 @@
+/*
+ * Test the lazy expression-template layer for vvec arithmetic (morph/vvec_expr.h), comparing
+ * fused expression results with the eager vvec operator results.
+ */
+
+#include <iostream>
+#include <morph/vvec.h>
+#include <morph/vvec_expr.h>
+
+int main()
+{
+    int rtn = 0;
+
+    constexpr std::size_t n = 257;
+    morph::vvec<float> a (n);
+    morph::vvec<float> b (n);
+    morph::vvec<float> c (n);
+    for (std::size_t i = 0; i < n; ++i) {
+        a[i] = 0.1f * static_cast<float>(i);
+        b[i] = 1.0f + 0.01f * static_cast<float>(i);
+        c[i] = 2.0f - 0.05f * static_cast<float>(i);
+    }
+    float k = 3.5f;
+
+    // The expression from the motivating use case: a * k + b.pow(2) - c
+    morph::vvec<float> eager = a * k + b.pow (2.0f) - c;
+    morph::vvec<float> fused = (morph::lazy(a) * k + morph::lazy(b).pow (2.0f) - morph::lazy(c)).eval();
+    for (std::size_t i = 0; i < n; ++i) {
+        if (std::abs (fused[i] - eager[i]) > 1e-5f) {
+            std::cerr << "fused vs eager mismatch at i=" << i << ": " << fused[i] << " vs " << eager[i] << std::endl;
+            rtn -= 1;
+            break;
+        }
+    }
+
+    // eval_into() a presized target should not resize it
+    morph::vvec<float> target (n, 0.0f);
+    (morph::lazy(a) + morph::lazy(b)).eval_into (target);
+    if (target.size() != n) { std::cerr << "eval_into resized a correctly sized target" << std::endl; rtn -= 1; }
+    for (std::size_t i = 0; i < n; ++i) {
+        if (target[i] != a[i] + b[i]) { std::cerr << "eval_into wrong at i=" << i << std::endl; rtn -= 1; break; }
+    }
+
+    // Scalar on the left; unary functions; division
+    morph::vvec<float> eager2 = (1.0f / b) - a.sqrt() * 2.0f;
+    morph::vvec<float> fused2 = (1.0f / morph::lazy(b) - morph::lazy(a).sqrt() * 2.0f).eval();
+    for (std::size_t i = 0; i < n; ++i) {
+        if (std::abs (fused2[i] - eager2[i]) > 1e-5f) {
+            std::cerr << "fused2 vs eager2 mismatch at i=" << i << std::endl;
+            rtn -= 1;
+            break;
+        }
+    }
+
+    // Unary negation and exp/log round trip
+    morph::vvec<float> fused3 = (-(morph::lazy(b).log().exp())).eval();
+    for (std::size_t i = 0; i < n; ++i) {
+        if (std::abs (fused3[i] + b[i]) > 1e-4f) {
+            std::cerr << "neg/exp/log mismatch at i=" << i << std::endl;
+            rtn -= 1;
+            break;
+        }
+    }
+
+    if (rtn == 0) {
+        std::cout << "All tests passed" << std::endl;
+    } else {
+        std::cout << "Some tests failed" << std::endl;
+    }
+    return rtn;
+}
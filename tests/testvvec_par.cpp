@@ -0,0 +1,61 @@
+/*
+ * Test the OpenMP-parallel variants of vvec's reductions and transforms against their serial
+ * counterparts. Compiled without OpenMP these run serially, so the test is valid either way.
+ */
+
+#include <iostream>
+#include <morph/vvec.h>
+
+int main()
+{
+    int rtn = 0;
+
+    constexpr std::size_t n = 100000;
+    morph::vvec<float> v (n);
+    v.randomize (-100.0f, 100.0f);
+    // Plant an unambiguous max, min and shortest
+    v[n/3] = 1000.0f;
+    v[2*n/3] = -1000.0f;
+    v[n/2] = 0.0001f;
+
+    if (std::abs (v.sum_par() - v.sum()) > 0.5f) {
+        std::cerr << "sum_par: " << v.sum_par() << " vs sum: " << v.sum() << std::endl;
+        rtn -= 1;
+    }
+    if (v.max_par() != v.max()) { std::cerr << "max_par fails" << std::endl; rtn -= 1; }
+    if (v.min_par() != v.min()) { std::cerr << "min_par fails" << std::endl; rtn -= 1; }
+    if (v.argmax_par() != v.argmax()) { std::cerr << "argmax_par fails" << std::endl; rtn -= 1; }
+    if (v.argmin_par() != v.argmin()) { std::cerr << "argmin_par fails" << std::endl; rtn -= 1; }
+    if (v.shortest_par() != v.shortest()) { std::cerr << "shortest_par fails" << std::endl; rtn -= 1; }
+
+    // rescale_par against rescale
+    morph::vvec<float> v1 = v;
+    morph::vvec<float> v2 = v;
+    v1.rescale();
+    v2.rescale_par();
+    for (std::size_t i = 0; i < n; ++i) {
+        if (std::abs (v1[i] - v2[i]) > 1e-6f) { std::cerr << "rescale_par fails at i=" << i << std::endl; rtn -= 1; break; }
+    }
+
+    // convolve_par and smooth_gauss_par against the serial versions, both wrap modes
+    morph::vvec<float> kern = { 0.1f, 0.2f, 0.4f, 0.2f, 0.1f };
+    for (auto wrap : { morph::vvec<float>::wrapdata::none, morph::vvec<float>::wrapdata::wrap }) {
+        morph::vvec<float> c1 = v.convolve (kern, wrap);
+        morph::vvec<float> c2 = v.convolve_par (kern, wrap);
+        for (std::size_t i = 0; i < n; ++i) {
+            if (c1[i] != c2[i]) { std::cerr << "convolve_par fails at i=" << i << std::endl; rtn -= 1; break; }
+        }
+        morph::vvec<float> s1 = v.smooth_gauss (2.0f, 3u, wrap);
+        morph::vvec<float> s2 = v.smooth_gauss_par (2.0f, 3u, wrap);
+        for (std::size_t i = 0; i < n; ++i) {
+            if (s1[i] != s2[i]) { std::cerr << "smooth_gauss_par fails at i=" << i << std::endl; rtn -= 1; break; }
+        }
+    }
+
+    if (rtn == 0) {
+        std::cout << "All tests passed" << std::endl;
+    } else {
+        std::cout << "Some tests failed" << std::endl;
+    }
+    return rtn;
+}
@@ -0,0 +1,58 @@
+/*
+ * Test morph::pool_allocator and the morph::vvec_pool alias: correctness of vvec operations on
+ * pool-backed storage, and that repeated short-lived allocations are served from the pool.
+ */
+
+#include <iostream>
+#include <morph/vvec.h>
+#include <morph/pool_allocator.h>
+
+int main()
+{
+    int rtn = 0;
+
+    // Basic correctness on pool-backed storage
+    morph::vvec_pool<float> a = { 1.0f, 2.0f, 3.0f, 4.0f };
+    morph::vvec_pool<float> b = { 4.0f, 3.0f, 2.0f, 1.0f };
+    if (a.sum() != 10.0f) { std::cerr << "sum on vvec_pool fails" << std::endl; rtn -= 1; }
+    if (a.dot (b) != 20.0f) { std::cerr << "dot on vvec_pool fails" << std::endl; rtn -= 1; }
+    a += b;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i] != 5.0f) { std::cerr << "operator+= on vvec_pool fails" << std::endl; rtn -= 1; break; }
+    }
+
+    // Resizing, push_back, swap
+    morph::vvec_pool<int> c;
+    for (int i = 0; i < 1000; ++i) { c.push_back (i); }
+    if (c.sum() != 999 * 1000 / 2) { std::cerr << "push_back/sum on vvec_pool fails" << std::endl; rtn -= 1; }
+    morph::vvec_pool<int> d (10, 7);
+    c.swap (d);
+    if (c.size() != 10 || d.size() != 1000) { std::cerr << "swap on vvec_pool fails" << std::endl; rtn -= 1; }
+
+    // After a warm-up allocation/deallocation, same-sized temporaries should be pool hits
+    {
+        morph::vvec_pool<double> warmup (256);
+        warmup.zero();
+    }
+    std::size_t hits_before = morph::pool::lists().n_hits;
+    for (int i = 0; i < 100; ++i) {
+        morph::vvec_pool<double> tmp (256);
+        tmp[0] = static_cast<double>(i);
+    }
+    std::size_t hits_after = morph::pool::lists().n_hits;
+    if (hits_after < hits_before + 100) {
+        std::cerr << "expected >=100 pool hits, got " << (hits_after - hits_before) << std::endl;
+        rtn -= 1;
+    }
+
+    // Very large allocations bypass the pool but must still work
+    morph::vvec_pool<double> big (4 * 1024 * 1024, 1.0);
+    if (big.sum() != 4.0 * 1024.0 * 1024.0) { std::cerr << "large vvec_pool fails" << std::endl; rtn -= 1; }
+
+    if (rtn == 0) {
+        std::cout << "All tests passed" << std::endl;
+    } else {
+        std::cout << "Some tests failed" << std::endl;
+    }
+    return rtn;
+}
@@ -0,0 +1,99 @@
+/*
+ * Test that the morph::simd kernels used by vvec's element-wise arithmetic and reductions give
+ * the same answers as hand-computed element-by-element code, including on array sizes that are
+ * not a multiple of the SIMD batch width (to exercise the tail loops).
+ */
+
+#include <iostream>
+#include <morph/vvec.h>
+
+int main()
+{
+    int rtn = 0;
+
+    // Use an awkward, prime size so that any SIMD batch width leaves a tail
+    constexpr std::size_t n = 1031;
+
+    morph::vvec<float> a (n);
+    morph::vvec<float> b (n);
+    for (std::size_t i = 0; i < n; ++i) {
+        a[i] = 0.5f * static_cast<float>(i) - 100.0f;
+        b[i] = 1.0f + 0.25f * static_cast<float>(i % 17);
+    }
+
+    // Element-wise operators against hand-computed results
+    morph::vvec<float> sum_ab = a + b;
+    morph::vvec<float> diff_ab = a - b;
+    morph::vvec<float> prod_ab = a * b;
+    morph::vvec<float> quot_ab = a / b;
+    morph::vvec<float> scaled = a * 3.0f;
+    morph::vvec<float> shifted = a + 7.0f;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (sum_ab[i] != a[i] + b[i]) { std::cerr << "operator+ fails at i=" << i << std::endl; rtn -= 1; break; }
+        if (diff_ab[i] != a[i] - b[i]) { std::cerr << "operator- fails at i=" << i << std::endl; rtn -= 1; break; }
+        if (prod_ab[i] != a[i] * b[i]) { std::cerr << "operator* fails at i=" << i << std::endl; rtn -= 1; break; }
+        if (quot_ab[i] != a[i] / b[i]) { std::cerr << "operator/ fails at i=" << i << std::endl; rtn -= 1; break; }
+        if (scaled[i] != a[i] * 3.0f) { std::cerr << "operator* (scalar) fails at i=" << i << std::endl; rtn -= 1; break; }
+        if (shifted[i] != a[i] + 7.0f) { std::cerr << "operator+ (scalar) fails at i=" << i << std::endl; rtn -= 1; break; }
+    }
+
+    // In-place operators
+    morph::vvec<float> c = a;
+    c += b;
+    c -= b;
+    c *= b;
+    c /= b;
+    // After += b, -= b, *= b, /= b, c should be close to a again
+    for (std::size_t i = 0; i < n; ++i) {
+        if (std::abs (c[i] - a[i]) > 1e-3f) {
+            std::cerr << "in-place operator round trip fails at i=" << i << std::endl;
+            rtn -= 1;
+            break;
+        }
+    }
+
+    // Reductions against sequential double-precision accumulation
+    double sum_seq = 0.0;
+    double sos_seq = 0.0;
+    double dot_seq = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        sum_seq += a[i];
+        sos_seq += a[i] * a[i];
+        dot_seq += a[i] * b[i];
+    }
+    if (std::abs (a.sum() - static_cast<float>(sum_seq)) > 0.1f) {
+        std::cerr << "sum() fails: " << a.sum() << " vs " << sum_seq << std::endl;
+        rtn -= 1;
+    }
+    if (std::abs (a.sos() - static_cast<float>(sos_seq)) / static_cast<float>(sos_seq) > 1e-5f) {
+        std::cerr << "sos() fails: " << a.sos() << " vs " << sos_seq << std::endl;
+        rtn -= 1;
+    }
+    if (std::abs (a.dot (b) - static_cast<float>(dot_seq)) / std::abs (static_cast<float>(dot_seq)) > 1e-5f) {
+        std::cerr << "dot() fails: " << a.dot (b) << " vs " << dot_seq << std::endl;
+        rtn -= 1;
+    }
+    float len_expected = std::sqrt (static_cast<float>(sos_seq));
+    if (std::abs (a.length() - len_expected) / len_expected > 1e-5f) {
+        std::cerr << "length() fails: " << a.length() << " vs " << len_expected << std::endl;
+        rtn -= 1;
+    }
+    float mean_expected = static_cast<float>(sum_seq) / static_cast<float>(n);
+    if (std::abs (a.mean() - mean_expected) > 1e-3f) {
+        std::cerr << "mean() fails: " << a.mean() << " vs " << mean_expected << std::endl;
+        rtn -= 1;
+    }
+
+    // The kernels should also work for integer element types
+    morph::vvec<int> ia (n, 3);
+    morph::vvec<int> ib (n, 4);
+    if ((ia + ib).sum() != static_cast<int>(n) * 7) { std::cerr << "int operator+/sum fails" << std::endl; rtn -= 1; }
+    if (ia.dot (ib) != static_cast<int>(n) * 12) { std::cerr << "int dot fails" << std::endl; rtn -= 1; }
+
+    if (rtn == 0) {
+        std::cout << "All tests passed" << std::endl;
+    } else {
+        std::cout << "Some tests failed" << std::endl;
+    }
+    return rtn;
+}
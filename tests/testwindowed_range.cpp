@@ -0,0 +1,68 @@
+/*
+ * Test morph::windowed_range against a brute-force re-scan of the window.
+ */
+
+#include <morph/windowed_range.h>
+#include <morph/range.h>
+#include <morph/Random.h>
+#include <morph/vvec.h>
+#include <iostream>
+#include <algorithm>
+
+int main()
+{
+    int rtn = 0;
+
+    morph::vvec<double> data (5000);
+    morph::RandUniform<double> rng (-10.0, 10.0, 2000);
+    for (auto& d : data) { d = rng.get(); }
+
+    for (uint64_t window : { uint64_t{1}, uint64_t{2}, uint64_t{7}, uint64_t{100}, uint64_t{5000} }) {
+        morph::windowed_range<double> wr (window);
+        for (uint64_t i = 0; i < data.size(); ++i) {
+            wr.push (data[i]);
+            // Brute force: re-scan the last 'window' values
+            morph::range<double> brute (morph::range_init::for_search);
+            uint64_t start = (i + 1 > window) ? (i + 1 - window) : 0;
+            for (uint64_t j = start; j <= i; ++j) { brute.update (data[j]); }
+            morph::range<double> r = wr.range();
+            if (r.min != brute.min || r.max != brute.max || wr.min() != brute.min || wr.max() != brute.max) {
+                std::cout << "windowed_range mismatch at i=" << i << " window=" << window
+                          << ": " << r << " vs " << brute << std::endl;
+                --rtn;
+                break;
+            }
+        }
+    }
+
+    // window == 0 should accumulate like range::update
+    {
+        morph::windowed_range<double> wr;
+        morph::range<double> acc (morph::range_init::for_search);
+        for (auto d : data) {
+            wr.push (d);
+            acc.update (d);
+        }
+        if (wr.min() != acc.min || wr.max() != acc.max) {
+            std::cout << "unbounded windowed_range disagrees with range::update" << std::endl;
+            --rtn;
+        }
+    }
+
+    // An empty tracker reports a search-initialized range, and reset() empties it
+    {
+        morph::windowed_range<float> wr (4);
+        if (!wr.empty()) { --rtn; }
+        morph::range<float> r = wr.range();
+        morph::range<float> sr (morph::range_init::for_search);
+        if (r.min != sr.min || r.max != sr.max) { --rtn; }
+        wr.push (1.0f);
+        wr.push (2.0f);
+        if (wr.empty() || wr.count() != 2 || wr.min() != 1.0f || wr.max() != 2.0f) { --rtn; }
+        wr.reset();
+        if (!wr.empty() || wr.count() != 0) { --rtn; }
+    }
+
+    std::cout << (rtn == 0 ? "Test success" : "Test failed") << std::endl;
+    return rtn;
+}